@@ -0,0 +1,1655 @@
+/*
+   Copyright (c) 2026, MariaDB
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1335  USA
+*/
+
+/*
+  mariadb-bench - multi-threaded OLTP benchmark driver.
+
+  Usage: mariadb-bench [OPTIONS] prepare|run|cleanup
+
+  Workloads:
+    point_select, read_only, read_write, insert
+                       sysbench-like workloads on --tables tables of
+                       --table-size rows
+    tpcc               TPC-C-like workload on --warehouses warehouses.
+                       It follows the TPC-C schema and transaction mix,
+                       but is not a compliant implementation: there are
+                       no keying or think times, amounts are stored in
+                       cents, and a customer selected by last name is
+                       the first match.
+
+  Every worker thread borrows a connection from a pool of --connections
+  connections for each transaction. Statements are executed as server
+  side prepared statements, unless --skip-prepared is given. At the end
+  of the run, throughput and latency percentiles are reported, as text
+  or, with --json, as a JSON document.
+*/
+
+#define VER "1.0"
+
+#include "client_priv.h"
+#include <my_sys.h>
+#include <my_bit.h>
+#include "mysql_version.h"
+#include <mysqld_error.h>
+#include <welcome_copyright_notice.h>   /* ORACLE_WELCOME_COPYRIGHT_NOTICE */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+static my_bool tty_password= 0, opt_prepared= 1, opt_json= 0,
+               opt_silent= 0, opt_compress= 0;
+static my_bool debug_info_flag= 0, debug_check_flag= 0;
+static uint my_end_arg= 0;
+static char *opt_password= 0, *current_user= 0, *current_host= 0,
+            *opt_database= (char*) "bench", *opt_engine= (char*) "InnoDB";
+static uint opt_mysql_port= 0, opt_protocol= 0;
+static char *opt_mysql_unix_port= 0;
+static char *opt_plugin_dir= 0, *opt_default_auth= 0;
+static uint opt_threads, opt_connections, opt_time, opt_report_interval;
+static uint opt_tables, opt_warehouses;
+static ulong opt_table_size, opt_seed;
+static ulong opt_workload;
+
+#include <sslopt-vars.h>
+
+enum workload_type
+{
+  WORKLOAD_POINT_SELECT, WORKLOAD_READ_ONLY, WORKLOAD_READ_WRITE,
+  WORKLOAD_INSERT, WORKLOAD_TPCC
+};
+
+static const char *workload_names[]=
+{ "point_select", "read_only", "read_write", "insert", "tpcc", NullS };
+static TYPELIB workload_typelib= CREATE_TYPELIB_FOR(workload_names);
+
+static struct my_option my_long_options[] =
+{
+  {"help", '?', "Display this help and exit.", 0, 0, 0, GET_NO_ARG, NO_ARG,
+   0, 0, 0, 0, 0, 0},
+  {"compress", 'C', "Use compression in server/client protocol.",
+   &opt_compress, &opt_compress, 0, GET_BOOL, NO_ARG, 0, 0, 0, 0, 0, 0},
+  {"connections", 'c',
+   "Size of the connection pool shared by the worker threads. "
+   "0 means one connection per thread.",
+   &opt_connections, &opt_connections, 0, GET_UINT, REQUIRED_ARG,
+   0, 0, 1024, 0, 0, 0},
+  {"database", 'D', "Database that holds the benchmark tables.",
+   &opt_database, &opt_database, 0, GET_STR, REQUIRED_ARG, 0, 0, 0, 0, 0, 0},
+  {"debug-check", 0, "Check memory and open file usage at exit.",
+   &debug_check_flag, &debug_check_flag, 0,
+   GET_BOOL, NO_ARG, 0, 0, 0, 0, 0, 0},
+  {"debug-info", 0, "Print some debug info at exit.", &debug_info_flag,
+   &debug_info_flag, 0, GET_BOOL, NO_ARG, 0, 0, 0, 0, 0, 0},
+  {"default_auth", 0,
+   "Default authentication client-side plugin to use.",
+   &opt_default_auth, &opt_default_auth, 0,
+   GET_STR, REQUIRED_ARG, 0, 0, 0, 0, 0, 0},
+  {"engine", 'e', "Storage engine of the benchmark tables.",
+   &opt_engine, &opt_engine, 0, GET_STR, REQUIRED_ARG, 0, 0, 0, 0, 0, 0},
+  {"host", 'h', "Connect to host.", &current_host,
+   &current_host, 0, GET_STR, REQUIRED_ARG, 0, 0, 0, 0, 0, 0},
+  {"json", 0, "Print the results as a JSON document.",
+   &opt_json, &opt_json, 0, GET_BOOL, NO_ARG, 0, 0, 0, 0, 0, 0},
+  {"password", 'p',
+   "Password to use when connecting to server. If password is not given it's asked from the tty.",
+   0, 0, 0, GET_STR, OPT_ARG, 0, 0, 0, 0, 0, 0},
+#ifdef _WIN32
+  {"pipe", 'W', "Use named pipes to connect to server.", 0, 0, 0, GET_NO_ARG,
+   NO_ARG, 0, 0, 0, 0, 0, 0},
+#endif
+  {"plugin_dir", 0, "Directory for client-side plugins.",
+   &opt_plugin_dir, &opt_plugin_dir, 0,
+   GET_STR, REQUIRED_ARG, 0, 0, 0, 0, 0, 0},
+  {"port", 'P', "Port number to use for connection or 0 for default to, in "
+   "order of preference, my.cnf, $MYSQL_TCP_PORT, "
+#if MYSQL_PORT_DEFAULT == 0
+   "/etc/services, "
+#endif
+   "built-in default (" STRINGIFY_ARG(MYSQL_PORT) ").",
+   &opt_mysql_port,
+   &opt_mysql_port, 0, GET_UINT, REQUIRED_ARG, 0, 0, 0, 0, 0,
+   0},
+  {"prepared", 0,
+   "Execute the statements as server side prepared statements. "
+   "Use --skip-prepared to send them as text.",
+   &opt_prepared, &opt_prepared, 0, GET_BOOL, NO_ARG, 1, 0, 0, 0, 0, 0},
+  {"protocol", OPT_MYSQL_PROTOCOL, "The protocol to use for connection (tcp, socket, pipe).",
+   0, 0, 0, GET_STR, REQUIRED_ARG, 0, 0, 0, 0, 0, 0},
+  {"rand-seed", 0, "Seed of the random number generators.",
+   &opt_seed, &opt_seed, 0, GET_ULONG, REQUIRED_ARG, 1, 0, 0, 0, 0, 0},
+  {"report-interval", 'i',
+   "Print the throughput every this many seconds during the run. "
+   "0 disables intermediate reports.",
+   &opt_report_interval, &opt_report_interval, 0, GET_UINT, REQUIRED_ARG,
+   0, 0, 3600, 0, 0, 0},
+  {"silent", 's', "Print nothing but errors.", &opt_silent, &opt_silent, 0,
+   GET_BOOL, NO_ARG, 0, 0, 0, 0, 0, 0},
+  {"socket", 'S', "The socket file to use for connection.",
+   &opt_mysql_unix_port, &opt_mysql_unix_port, 0, GET_STR,
+   REQUIRED_ARG, 0, 0, 0, 0, 0, 0},
+#include <sslopt-longopts.h>
+  {"table-size", 0, "Number of rows per table of the sysbench-like workloads.",
+   &opt_table_size, &opt_table_size, 0, GET_ULONG, REQUIRED_ARG,
+   100000, 1, 1000000000, 0, 0, 0},
+  {"tables", 0, "Number of tables of the sysbench-like workloads.",
+   &opt_tables, &opt_tables, 0, GET_UINT, REQUIRED_ARG, 4, 1, 1024, 0, 0, 0},
+  {"threads", 't', "Number of worker threads.",
+   &opt_threads, &opt_threads, 0, GET_UINT, REQUIRED_ARG, 8, 1, 1024, 0, 0, 0},
+  {"time", 'T', "Duration of the run, in seconds.",
+   &opt_time, &opt_time, 0, GET_UINT, REQUIRED_ARG, 60, 1, 0, 0, 0, 0},
+#ifndef DONT_ALLOW_USER_CHANGE
+  {"user", 'u', "User for login if not current user.", &current_user,
+   &current_user, 0, GET_STR, REQUIRED_ARG, 0, 0, 0, 0, 0, 0},
+#endif
+  {"version", 'V', "Output version information and exit.", 0, 0, 0, GET_NO_ARG,
+   NO_ARG, 0, 0, 0, 0, 0, 0},
+  {"warehouses", 'w', "Number of warehouses of the tpcc workload.",
+   &opt_warehouses, &opt_warehouses, 0, GET_UINT, REQUIRED_ARG,
+   1, 1, 100000, 0, 0, 0},
+  {"workload", 0, "Workload to prepare, run or clean up: "
+   "point_select, read_only, read_write, insert or tpcc.",
+   &opt_workload, &opt_workload, &workload_typelib, GET_ENUM, REQUIRED_ARG,
+   WORKLOAD_READ_WRITE, 0, 0, 0, 0, 0},
+  { 0, 0, 0, 0, 0, 0, GET_NO_ARG, NO_ARG, 0, 0, 0, 0, 0, 0}
+};
+
+
+static const char *load_default_groups[]=
+{ "mariadb-bench", "client", "client-server", "client-mariadb", 0 };
+
+
+static void usage(void)
+{
+  print_version();
+  puts(ORACLE_WELCOME_COPYRIGHT_NOTICE("2026"));
+  printf("\
+Runs sysbench-like and TPC-C-like OLTP workloads with many threads,\n\
+and reports throughput and latency percentiles.\n");
+  printf("\nUsage: %s [OPTIONS] prepare|run|cleanup\n", my_progname);
+  print_defaults("my", load_default_groups);
+  puts("");
+  my_print_help(my_long_options);
+  my_print_variables(my_long_options);
+}
+
+
+static my_bool
+get_one_option(const struct my_option *opt, const char *argument,
+               const char *filename)
+{
+  switch(opt->id) {
+  case 'p':
+    if (argument == disabled_my_option)
+      argument= (char*) "";                     /* Don't require password */
+    if (argument)
+    {
+      char *start= (char*) argument;
+      my_free(opt_password);
+      opt_password= my_strdup(PSI_NOT_INSTRUMENTED, argument, MYF(MY_FAE));
+      while (*argument)
+        *(char*) argument++= 'x';               /* Destroy argument */
+      if (*start)
+        start[1]= 0;                            /* Cut length of argument */
+      tty_password= 0;
+    }
+    else
+      tty_password= 1;
+    break;
+#ifdef _WIN32
+  case 'W':
+    opt_protocol= MYSQL_PROTOCOL_PIPE;
+    break;
+#endif
+  case OPT_MYSQL_PROTOCOL:
+    if ((opt_protocol= find_type_with_warning(argument, &sql_protocol_typelib,
+                                              opt->name)) <= 0)
+    {
+      sf_leaking_memory= 1; /* no memory leak reports here */
+      exit(1);
+    }
+    break;
+  case 'P':
+    if (filename[0] == '\0')
+    {
+      /* Port given on command line, switch protocol to use TCP */
+      opt_protocol= MYSQL_PROTOCOL_TCP;
+    }
+    break;
+  case 'S':
+    if (filename[0] == '\0')
+    {
+      /* Socket given on command line, switch protocol to use SOCKET */
+      if (opt_protocol != MYSQL_PROTOCOL_PIPE)
+        opt_protocol= MYSQL_PROTOCOL_SOCKET;
+    }
+    break;
+#include <sslopt-case.h>
+  case 'V': print_version(); exit(0);
+  case 'I':
+  case '?':
+    usage();
+    exit(0);
+  }
+  return 0;
+}
+
+
+static void fatal_error(const char *format, ...)
+{
+  va_list args;
+  va_start(args, format);
+  fprintf(stderr, "%s: ", my_progname);
+  vfprintf(stderr, format, args);
+  fputc('\n', stderr);
+  va_end(args);
+  fflush(stderr);
+  exit(1);
+}
+
+
+static MYSQL *db_connect(const char *database)
+{
+  MYSQL *mysql= mysql_init(NULL);
+  if (!mysql)
+    fatal_error("out of memory");
+  if (opt_compress)
+    mysql_options(mysql, MYSQL_OPT_COMPRESS, NullS);
+  SET_SSL_OPTS(mysql);
+  if (opt_protocol)
+    mysql_options(mysql, MYSQL_OPT_PROTOCOL, (char*) &opt_protocol);
+  if (opt_plugin_dir && *opt_plugin_dir)
+    mysql_options(mysql, MYSQL_PLUGIN_DIR, opt_plugin_dir);
+  if (opt_default_auth && *opt_default_auth)
+    mysql_options(mysql, MYSQL_DEFAULT_AUTH, opt_default_auth);
+  mysql_options(mysql, MYSQL_SET_CHARSET_NAME, "utf8mb4");
+  mysql_options(mysql, MYSQL_OPT_CONNECT_ATTR_RESET, 0);
+  mysql_options4(mysql, MYSQL_OPT_CONNECT_ATTR_ADD,
+                 "program_name", "mariadb-bench");
+  if (!mysql_real_connect(mysql, current_host, current_user, opt_password,
+                          database, opt_mysql_port, opt_mysql_unix_port, 0))
+    fatal_error("Got error: %d: %s when trying to connect",
+                mysql_errno(mysql), mysql_error(mysql));
+  return mysql;
+}
+
+
+static void db_query(MYSQL *mysql, const std::string &query)
+{
+  if (mysql_real_query(mysql, query.data(), (ulong) query.length()))
+    fatal_error("Got error: %d: %s when executing '%.200s'",
+                mysql_errno(mysql), mysql_error(mysql), query.c_str());
+  if (MYSQL_RES *res= mysql_store_result(mysql))
+    mysql_free_result(res);
+}
+
+
+/**
+  Log-bucketed latency histogram, in microseconds.
+  Each power of two is split in 4 linear sub-buckets, so that a reported
+  percentile is at most 25% above the exact value.
+*/
+class Latency_histogram
+{
+  static const uint SUB_BITS= 2;
+  static const uint SUB= 1U << SUB_BITS;
+  static const uint MAX_POWER= 40;
+  static const uint BUCKETS= (MAX_POWER - SUB_BITS + 2) * SUB;
+  ulonglong buckets[BUCKETS];
+  ulonglong max_value;
+  double sum;
+
+  static uint index(ulonglong value)
+  {
+    if (value < SUB)
+      return (uint) value;
+    uint power= my_bit_log2_uint64(value);
+    if (power > MAX_POWER)
+      return BUCKETS - 1;
+    uint shift= power - SUB_BITS;
+    return (shift + 1) * SUB + (uint) ((value >> shift) & (SUB - 1));
+  }
+
+  static ulonglong limit(uint i)
+  {
+    if (i < SUB)
+      return i + 1;
+    return (ulonglong) (SUB + i % SUB + 1) << (i / SUB - 1);
+  }
+
+public:
+  ulonglong count;
+
+  Latency_histogram() { reset(); }
+
+  void reset()
+  {
+    memset(buckets, 0, sizeof buckets);
+    max_value= count= 0;
+    sum= 0;
+  }
+
+  void add(ulonglong value)
+  {
+    buckets[index(value)]++;
+    count++;
+    sum+= (double) value;
+    if (value > max_value)
+      max_value= value;
+  }
+
+  void merge(const Latency_histogram &h)
+  {
+    for (uint i= 0; i < BUCKETS; i++)
+      buckets[i]+= h.buckets[i];
+    count+= h.count;
+    sum+= h.sum;
+    max_value= std::max(max_value, h.max_value);
+  }
+
+  ulonglong max() const { return max_value; }
+  double avg() const { return count ? sum / count : 0; }
+
+  /** @return estimated percentile, never above the largest value seen */
+  ulonglong percentile(double p) const
+  {
+    if (!count)
+      return 0;
+    ulonglong rank= (ulonglong) (count * p / 100.0 + 0.5);
+    ulonglong seen= 0;
+    rank= std::max(rank, 1ULL);
+    for (uint i= 0; i < BUCKETS; i++)
+      if ((seen+= buckets[i]) >= rank)
+        return std::min(limit(i), max_value);
+    return max_value;
+  }
+};
+
+
+/** A statement parameter */
+struct Param
+{
+  longlong i;
+  std::string s;
+  bool is_string;
+  Param(longlong v) : i(v), is_string(false) {}
+  Param(int v) : i(v), is_string(false) {}
+  Param(uint v) : i(v), is_string(false) {}
+  Param(std::string v) : i(0), s(std::move(v)), is_string(true) {}
+};
+
+
+/** Return value of Connection::execute() when a row was expected */
+static const int NOT_FOUND= -1;
+
+/**
+  A connection, with the statements of the workload prepared on demand.
+*/
+class Connection
+{
+  const std::vector<std::string> &statements;
+  std::vector<MYSQL_STMT*> stmts;
+  std::string query;
+
+  int stmt_error(MYSQL_STMT *stmt)
+  {
+    error_message= mysql_stmt_error(stmt);
+    return (int) mysql_stmt_errno(stmt);
+  }
+
+  int mysql_failed()
+  {
+    error_message= mysql_error(mysql);
+    return (int) mysql_errno(mysql);
+  }
+
+  int execute_prepared(uint id, std::initializer_list<Param> params,
+                       longlong *out, uint n_out)
+  {
+    MYSQL_STMT *stmt= stmts[id];
+    if (!stmt)
+    {
+      const std::string &sql= statements[id];
+      stmt= mysql_stmt_init(mysql);
+      if (!stmt)
+        return CR_OUT_OF_MEMORY;
+      if (mysql_stmt_prepare(stmt, sql.data(), (ulong) sql.length()))
+      {
+        int error= stmt_error(stmt);
+        mysql_stmt_close(stmt);
+        return error;
+      }
+      stmts[id]= stmt;
+    }
+
+    MYSQL_BIND bind[16];
+    DBUG_ASSERT(params.size() <= array_elements(bind));
+    memset(bind, 0, sizeof bind);
+    uint n= 0;
+    for (const Param &p : params)
+    {
+      if (p.is_string)
+      {
+        bind[n].buffer_type= MYSQL_TYPE_STRING;
+        bind[n].buffer= (void*) p.s.data();
+        bind[n].buffer_length= (ulong) p.s.length();
+      }
+      else
+      {
+        bind[n].buffer_type= MYSQL_TYPE_LONGLONG;
+        bind[n].buffer= (void*) &p.i;
+      }
+      n++;
+    }
+    if ((n && mysql_stmt_bind_param(stmt, bind)) || mysql_stmt_execute(stmt))
+      return stmt_error(stmt);
+
+    if (!mysql_stmt_field_count(stmt))
+      return 0;
+
+    MYSQL_BIND result[4];
+    my_bool is_null[4];
+    DBUG_ASSERT(n_out <= array_elements(result));
+    DBUG_ASSERT(!n_out || mysql_stmt_field_count(stmt) == n_out);
+    if (n_out)
+    {
+      memset(result, 0, sizeof result);
+      for (uint i= 0; i < n_out; i++)
+      {
+        out[i]= 0;
+        result[i].buffer_type= MYSQL_TYPE_LONGLONG;
+        result[i].buffer= &out[i];
+        result[i].is_null= &is_null[i];
+      }
+      mysql_stmt_bind_result(stmt, result);
+    }
+    if (mysql_stmt_store_result(stmt))
+      return stmt_error(stmt);
+    int res= 0;
+    if (n_out)
+    {
+      res= mysql_stmt_fetch(stmt);
+      if (res == MYSQL_NO_DATA)
+        res= NOT_FOUND;
+      else if (res == MYSQL_DATA_TRUNCATED)
+        res= 0;
+      else if (res)
+        res= stmt_error(stmt);
+      for (uint i= 0; i < n_out; i++)
+        if (is_null[i])
+          out[i]= 0;
+    }
+    mysql_stmt_free_result(stmt);
+    return res;
+  }
+
+  int execute_text(uint id, std::initializer_list<Param> params,
+                   longlong *out, uint n_out)
+  {
+    const std::string &sql= statements[id];
+    const Param *p= params.begin();
+    query.clear();
+    for (char c : sql)
+    {
+      if (c != '?')
+        query+= c;
+      else if (!p->is_string)
+        query+= std::to_string(p++->i);
+      else
+      {
+        size_t offset= query.length();
+        query.resize(offset + p->s.length() * 2 + 3);
+        query[offset]= '\'';
+        ulong length= mysql_real_escape_string(mysql, &query[offset + 1],
+                                               p->s.data(),
+                                               (ulong) p->s.length());
+        query.resize(offset + 1 + length);
+        query+= '\'';
+        p++;
+      }
+    }
+    return query_result(query.data(), query.length(), out, n_out);
+  }
+
+public:
+  MYSQL *mysql;
+  /** Message of the last error */
+  std::string error_message;
+
+  Connection(const std::vector<std::string> &statements)
+    : statements(statements), stmts(statements.size()),
+      mysql(db_connect(opt_database)) {}
+
+  ~Connection()
+  {
+    for (MYSQL_STMT *stmt : stmts)
+      if (stmt)
+        mysql_stmt_close(stmt);
+    mysql_close(mysql);
+  }
+
+  /**
+    Execute a workload statement.
+    @param id     index of the statement
+    @param params values of the statement parameters
+    @param out    where to store the columns of the first row
+    @param n_out  number of columns to store
+    @retval 0 on success
+    @retval NOT_FOUND if n_out > 0 and the statement returned no row
+    @return the error number otherwise
+  */
+  int execute(uint id, std::initializer_list<Param> params,
+              longlong *out= nullptr, uint n_out= 0)
+  {
+    return opt_prepared ? execute_prepared(id, params, out, n_out)
+                        : execute_text(id, params, out, n_out);
+  }
+
+  /** Execute a text query and store the first row like execute() */
+  int query_result(const char *q, size_t length,
+                   longlong *out= nullptr, uint n_out= 0)
+  {
+    if (mysql_real_query(mysql, q, (ulong) length))
+      return mysql_failed();
+    MYSQL_RES *res= mysql_store_result(mysql);
+    if (!res)
+      return mysql_field_count(mysql) ? mysql_failed() : 0;
+    int error= 0;
+    if (n_out)
+    {
+      DBUG_ASSERT(mysql_num_fields(res) == n_out);
+      if (MYSQL_ROW row= mysql_fetch_row(res))
+      {
+        for (uint i= 0; i < n_out; i++)
+          out[i]= row[i] ? strtoll(row[i], NULL, 10) : 0;
+      }
+      else
+        error= NOT_FOUND;
+    }
+    mysql_free_result(res);
+    return error;
+  }
+
+  int begin() { return query_result(C_STRING_WITH_LEN("BEGIN")); }
+  int commit() { return mysql_commit(mysql) ? mysql_failed() : 0; }
+  void rollback() { mysql_rollback(mysql); }
+};
+
+
+/**
+  Connections shared by the worker threads. When there are fewer
+  connections than threads, a thread waits for a free connection, like
+  an application server would.
+*/
+class Connection_pool
+{
+  std::vector<Connection*> all;
+  std::vector<Connection*> free_list;
+  std::mutex mutex;
+  std::condition_variable cond;
+
+public:
+  void init(const std::vector<std::string> &statements, uint n)
+  {
+    for (uint i= 0; i < n; i++)
+      all.push_back(new Connection(statements));
+    free_list= all;
+  }
+
+  ~Connection_pool()
+  {
+    for (Connection *c : all)
+      delete c;
+  }
+
+  Connection *get()
+  {
+    std::unique_lock<std::mutex> lk(mutex);
+    cond.wait(lk, [this]{ return !free_list.empty(); });
+    Connection *c= free_list.back();
+    free_list.pop_back();
+    return c;
+  }
+
+  void put(Connection *c)
+  {
+    {
+      std::lock_guard<std::mutex> lk(mutex);
+      free_list.push_back(c);
+    }
+    cond.notify_one();
+  }
+};
+
+
+/** Per thread state and statistics */
+struct Worker
+{
+  std::mt19937_64 rng;
+  Connection *con;
+  std::vector<Latency_histogram> latency;
+  /** Counters read by the reporting thread */
+  std::atomic<ulonglong> transactions, queries, retries;
+
+  Worker(uint seed, size_t n_types)
+    : rng(seed), con(nullptr), latency(n_types),
+      transactions(0), queries(0), retries(0) {}
+
+  /** @return uniformly distributed number in [lo, hi] */
+  longlong rand(longlong lo, longlong hi)
+  {
+    return std::uniform_int_distribution<longlong>(lo, hi)(rng);
+  }
+
+  /** TPC-C non uniform random number */
+  longlong nurand(longlong a, longlong lo, longlong hi, longlong c)
+  {
+    return (((rand(0, a) | rand(lo, hi)) + c) % (hi - lo + 1)) + lo;
+  }
+
+  std::string rand_string(size_t min_length, size_t max_length)
+  {
+    static const char chars[]=
+      "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+    size_t length= (size_t) rand(min_length, max_length);
+    std::string s(length, ' ');
+    for (size_t i= 0; i < length; i++)
+      s[i]= chars[rand(0, sizeof chars - 2)];
+    return s;
+  }
+
+  /** sysbench style string of groups of 11 digits separated by '-' */
+  std::string rand_digits(uint groups)
+  {
+    std::string s;
+    for (uint g= 0; g < groups; g++)
+    {
+      if (g)
+        s+= '-';
+      for (uint i= 0; i < 11; i++)
+        s+= (char) ('0' + rand(0, 9));
+    }
+    return s;
+  }
+
+  int execute(uint id, std::initializer_list<Param> params,
+              longlong *out= nullptr, uint n_out= 0)
+  {
+    queries.fetch_add(1, std::memory_order_relaxed);
+    return con->execute(id, params, out, n_out);
+  }
+
+  int begin()
+  {
+    queries.fetch_add(1, std::memory_order_relaxed);
+    return con->begin();
+  }
+
+  int commit()
+  {
+    queries.fetch_add(1, std::memory_order_relaxed);
+    return con->commit();
+  }
+};
+
+
+/** Accumulates the rows of a multi-row INSERT used to load the tables */
+class Batch_insert
+{
+  MYSQL *mysql;
+  std::string prefix, query;
+  bool empty;
+
+public:
+  Batch_insert(MYSQL *mysql, const std::string &prefix)
+    : mysql(mysql), prefix(prefix), query(prefix), empty(true) {}
+  ~Batch_insert() { flush(); }
+
+  void add(const std::string &row)
+  {
+    if (!empty)
+      query+= ',';
+    query+= '(';
+    query+= row;
+    query+= ')';
+    empty= false;
+    if (query.length() > 256 * 1024)
+      flush();
+  }
+
+  void flush()
+  {
+    if (empty)
+      return;
+    db_query(mysql, query);
+    query= prefix;
+    empty= true;
+  }
+};
+
+
+static std::string quote(const std::string &s)
+{
+  return "'" + s + "'";
+}
+
+
+/** Interface of the workloads */
+class Workload
+{
+public:
+  /** Statements executed by the transactions, prepared on demand */
+  std::vector<std::string> statements;
+
+  virtual ~Workload() {}
+  virtual std::vector<const char*> transaction_names() const= 0;
+  /** Create the tables */
+  virtual void create(MYSQL *mysql)= 0;
+  /** @return number of units the load is split in for parallel loading */
+  virtual uint load_units() const= 0;
+  virtual void load(MYSQL *mysql, Worker *w, uint unit)= 0;
+  virtual void cleanup(MYSQL *mysql)= 0;
+  /**
+    Execute one transaction.
+    @param w    worker thread state, with a connection
+    @param type set to the transaction type
+    @return 0 or error number
+  */
+  virtual int transaction(Worker *w, uint *type)= 0;
+
+protected:
+  uint add(const std::string &sql)
+  {
+    statements.push_back(sql);
+    return (uint) statements.size() - 1;
+  }
+};
+
+
+/** sysbench-like workloads on tables sbtest1 ... sbtestN */
+class Sysbench_workload : public Workload
+{
+  enum stmt_kind
+  {
+    POINT, SIMPLE_RANGE, SUM_RANGE, ORDER_RANGE, DISTINCT_RANGE,
+    UPDATE_INDEX, UPDATE_NON_INDEX, DELETE, INSERT, INSERT_AUTO, N_KINDS
+  };
+  static const uint RANGE_SIZE= 100;
+  static const uint POINT_SELECTS= 10;
+  workload_type type;
+
+  uint stmt(stmt_kind kind, uint table) const
+  {
+    return kind * opt_tables + table;
+  }
+
+  static std::string table_name(uint table)
+  {
+    return "sbtest" + std::to_string(table + 1);
+  }
+
+public:
+  Sysbench_workload(workload_type type) : type(type)
+  {
+    static const char *sql[N_KINDS]=
+    {
+      "SELECT c FROM %s WHERE id=?",
+      "SELECT c FROM %s WHERE id BETWEEN ? AND ?",
+      "SELECT SUM(k) FROM %s WHERE id BETWEEN ? AND ?",
+      "SELECT c FROM %s WHERE id BETWEEN ? AND ? ORDER BY c",
+      "SELECT DISTINCT c FROM %s WHERE id BETWEEN ? AND ? ORDER BY c",
+      "UPDATE %s SET k=k+1 WHERE id=?",
+      "UPDATE %s SET c=? WHERE id=?",
+      "DELETE FROM %s WHERE id=?",
+      "INSERT INTO %s (id, k, c, pad) VALUES (?, ?, ?, ?)",
+      "INSERT INTO %s (k, c, pad) VALUES (?, ?, ?)"
+    };
+    for (uint kind= 0; kind < N_KINDS; kind++)
+      for (uint t= 0; t < opt_tables; t++)
+      {
+        char buf[128];
+        snprintf(buf, sizeof buf, sql[kind], table_name(t).c_str());
+        add(buf);
+      }
+  }
+
+  std::vector<const char*> transaction_names() const override
+  {
+    return {workload_names[type]};
+  }
+
+  void create(MYSQL *mysql) override
+  {
+    for (uint t= 0; t < opt_tables; t++)
+      db_query(mysql, "CREATE TABLE IF NOT EXISTS " + table_name(t) +
+               " (id INT NOT NULL AUTO_INCREMENT,"
+               " k INT NOT NULL DEFAULT 0,"
+               " c CHAR(120) NOT NULL DEFAULT '',"
+               " pad CHAR(60) NOT NULL DEFAULT '',"
+               " PRIMARY KEY (id), KEY k_1 (k)) ENGINE=" + opt_engine);
+  }
+
+  uint load_units() const override { return opt_tables; }
+
+  void load(MYSQL *mysql, Worker *w, uint table) override
+  {
+    Batch_insert batch(mysql, "INSERT INTO " + table_name(table) +
+                       " (id, k, c, pad) VALUES ");
+    for (ulong id= 1; id <= opt_table_size; id++)
+      batch.add(std::to_string(id) + "," +
+                std::to_string(w->rand(1, opt_table_size)) + "," +
+                quote(w->rand_digits(10)) + "," + quote(w->rand_digits(5)));
+  }
+
+  void cleanup(MYSQL *mysql) override
+  {
+    for (uint t= 0; t < opt_tables; t++)
+      db_query(mysql, "DROP TABLE IF EXISTS " + table_name(t));
+  }
+
+  int transaction(Worker *w, uint *txn_type) override
+  {
+    const uint t= (uint) w->rand(0, opt_tables - 1);
+    const longlong size= (longlong) opt_table_size;
+    int error;
+    *txn_type= 0;
+
+    switch (type) {
+    case WORKLOAD_POINT_SELECT:
+      return w->execute(stmt(POINT, t), {w->rand(1, size)});
+    case WORKLOAD_INSERT:
+      return w->execute(stmt(INSERT_AUTO, t),
+                        {w->rand(1, size), w->rand_digits(10),
+                         w->rand_digits(5)});
+    default:
+      break;
+    }
+
+    if ((error= w->begin()))
+      return error;
+    for (uint i= 0; i < POINT_SELECTS; i++)
+      if ((error= w->execute(stmt(POINT, t), {w->rand(1, size)})))
+        return error;
+    static const stmt_kind ranges[]=
+    { SIMPLE_RANGE, SUM_RANGE, ORDER_RANGE, DISTINCT_RANGE };
+    for (stmt_kind kind : ranges)
+    {
+      longlong from= w->rand(1, size);
+      if ((error= w->execute(stmt(kind, t), {from, from + RANGE_SIZE - 1})))
+        return error;
+    }
+    if (type == WORKLOAD_READ_WRITE)
+    {
+      longlong id= w->rand(1, size);
+      if ((error= w->execute(stmt(UPDATE_INDEX, t), {w->rand(1, size)})) ||
+          (error= w->execute(stmt(UPDATE_NON_INDEX, t),
+                             {w->rand_digits(10), w->rand(1, size)})) ||
+          (error= w->execute(stmt(DELETE, t), {id})) ||
+          (error= w->execute(stmt(INSERT, t),
+                             {id, w->rand(1, size), w->rand_digits(10),
+                              w->rand_digits(5)})))
+        return error;
+    }
+    return w->commit();
+  }
+};
+
+
+/**
+  TPC-C-like workload.
+  Amounts are stored in cents and tax rates in basis points.
+*/
+class Tpcc_workload : public Workload
+{
+  static const uint DISTRICTS= 10;
+  static const uint CUSTOMERS= 3000;
+  static const uint ITEMS= 100000;
+  static const uint ORDERS= 3000;
+  /** Initial orders without delivery */
+  static const uint NEW_ORDERS= 900;
+  /** Constants of NURand */
+  static const uint C_LAST= 123, C_ID= 259, OL_I_ID= 7911;
+
+  enum txn { NEW_ORDER, PAYMENT, ORDER_STATUS, DELIVERY, STOCK_LEVEL };
+
+  uint s_warehouse_tax, s_district_for_update, s_district_next_o_id,
+       s_customer_discount, s_insert_order, s_insert_new_order, s_item_price,
+       s_stock_for_update, s_update_stock, s_insert_order_line,
+       s_warehouse_ytd, s_district_ytd, s_customer_by_name,
+       s_customer_for_update, s_customer_payment, s_customer_bad_credit,
+       s_insert_history, s_customer_balance, s_last_order, s_order_lines,
+       s_oldest_new_order, s_delete_new_order, s_order_customer,
+       s_order_carrier, s_order_line_delivery, s_order_amount,
+       s_customer_delivery, s_district_next, s_stock_level;
+
+  static std::string last_name(uint n)
+  {
+    static const char *syllables[]=
+    { "BAR", "OUGHT", "ABLE", "PRI", "PRES", "ESE", "ANTI", "CALLY",
+      "ATION", "EING" };
+    return std::string(syllables[n / 100]) + syllables[n / 10 % 10] +
+           syllables[n % 10];
+  }
+
+  static std::string date() { return "NOW()"; }
+
+  /** @return a customer selected by last name (60%) or by id (40%) */
+  int customer(Worker *w, longlong c_w_id, longlong c_d_id, longlong *c_id)
+  {
+    if (w->rand(1, 100) > 60)
+    {
+      *c_id= w->nurand(1023, 1, CUSTOMERS, C_ID);
+      return 0;
+    }
+    std::string name= last_name((uint) w->nurand(255, 0, 999, C_LAST));
+    return w->execute(s_customer_by_name, {c_w_id, c_d_id, name}, c_id, 1);
+  }
+
+  int new_order(Worker *w, longlong w_id)
+  {
+    longlong d_id= w->rand(1, DISTRICTS);
+    longlong c_id= w->nurand(1023, 1, CUSTOMERS, C_ID);
+    longlong ol_cnt= w->rand(5, 15);
+    /* 1% of the transactions use an invalid item and roll back */
+    bool rollback= w->rand(1, 100) == 1;
+    longlong lines[15][3];      /* item, supplying warehouse, quantity */
+    longlong all_local= 1;
+    for (longlong i= 0; i < ol_cnt; i++)
+    {
+      lines[i][0]= w->nurand(8191, 1, ITEMS, OL_I_ID);
+      lines[i][1]= w_id;
+      if (opt_warehouses > 1 && w->rand(1, 100) == 1)
+      {
+        while ((lines[i][1]= w->rand(1, opt_warehouses)) == w_id) {}
+        all_local= 0;
+      }
+      lines[i][2]= w->rand(1, 10);
+    }
+    if (rollback)
+      lines[ol_cnt - 1][0]= ITEMS + 1;
+
+    longlong w_tax, d[2], c_discount;
+    int error;
+    if ((error= w->begin()) ||
+        (error= w->execute(s_warehouse_tax, {w_id}, &w_tax, 1)) ||
+        (error= w->execute(s_district_for_update, {w_id, d_id}, d, 2)) ||
+        (error= w->execute(s_district_next_o_id, {w_id, d_id})) ||
+        (error= w->execute(s_customer_discount, {w_id, d_id, c_id},
+                           &c_discount, 1)) ||
+        (error= w->execute(s_insert_order, {w_id, d_id, d[1], c_id, ol_cnt,
+                                            all_local})) ||
+        (error= w->execute(s_insert_new_order, {w_id, d_id, d[1]})))
+      return error;
+
+    for (longlong i= 0; i < ol_cnt; i++)
+    {
+      longlong price, quantity;
+      if ((error= w->execute(s_item_price, {lines[i][0]}, &price, 1)))
+      {
+        if (error == NOT_FOUND)
+        {
+          /* The expected rollback of an invalid item */
+          w->con->rollback();
+          return 0;
+        }
+        return error;
+      }
+      if ((error= w->execute(s_stock_for_update, {lines[i][1], lines[i][0]},
+                             &quantity, 1)))
+        return error;
+      quantity-= lines[i][2];
+      if (quantity < 10)
+        quantity+= 91;
+      longlong amount= lines[i][2] * price;
+      if ((error= w->execute(s_update_stock,
+                             {quantity, lines[i][2],
+                              longlong(lines[i][1] != w_id),
+                              lines[i][1], lines[i][0]})) ||
+          (error= w->execute(s_insert_order_line,
+                             {w_id, d_id, d[1], i + 1, lines[i][0],
+                              lines[i][1], lines[i][2], amount,
+                              w->rand_string(24, 24)})))
+        return error;
+    }
+    return w->commit();
+  }
+
+  int payment(Worker *w, longlong w_id)
+  {
+    longlong d_id= w->rand(1, DISTRICTS);
+    longlong c_w_id= w_id, c_d_id= d_id, c_id;
+    longlong amount= w->rand(100, 500000);
+    if (opt_warehouses > 1 && w->rand(1, 100) > 85)
+    {
+      while ((c_w_id= w->rand(1, opt_warehouses)) == w_id) {}
+      c_d_id= w->rand(1, DISTRICTS);
+    }
+    longlong c[2];              /* balance, bad credit */
+    int error;
+    if ((error= w->begin()) ||
+        (error= w->execute(s_warehouse_ytd, {amount, w_id})) ||
+        (error= w->execute(s_district_ytd, {amount, w_id, d_id})) ||
+        (error= customer(w, c_w_id, c_d_id, &c_id)) ||
+        (error= w->execute(s_customer_for_update, {c_w_id, c_d_id, c_id},
+                           c, 2)) ||
+        (error= w->execute(s_customer_payment,
+                           {amount, amount, c_w_id, c_d_id, c_id})))
+      return error;
+    if (c[1] &&
+        (error= w->execute(s_customer_bad_credit,
+                           {std::to_string(c_id) + " " +
+                            std::to_string(c_d_id) + " " +
+                            std::to_string(c_w_id) + " " +
+                            std::to_string(amount),
+                            c_w_id, c_d_id, c_id})))
+      return error;
+    if ((error= w->execute(s_insert_history,
+                           {c_id, c_d_id, c_w_id, d_id, w_id, amount,
+                            w->rand_string(12, 24)})))
+      return error;
+    return w->commit();
+  }
+
+  int order_status(Worker *w, longlong w_id)
+  {
+    longlong d_id= w->rand(1, DISTRICTS), c_id, balance, o_id;
+    int error;
+    if ((error= w->begin()) ||
+        (error= customer(w, w_id, d_id, &c_id)) ||
+        (error= w->execute(s_customer_balance, {w_id, d_id, c_id},
+                           &balance, 1)))
+      return error;
+    error= w->execute(s_last_order, {w_id, d_id, c_id}, &o_id, 1);
+    if (!error)
+      error= w->execute(s_order_lines, {w_id, d_id, o_id});
+    if (error && error != NOT_FOUND)
+      return error;
+    return w->commit();
+  }
+
+  int delivery(Worker *w, longlong w_id)
+  {
+    longlong carrier= w->rand(1, 10);
+    int error;
+    if ((error= w->begin()))
+      return error;
+    for (longlong d_id= 1; d_id <= DISTRICTS; d_id++)
+    {
+      longlong o_id, c_id, amount;
+      error= w->execute(s_oldest_new_order, {w_id, d_id}, &o_id, 1);
+      if (error == NOT_FOUND)
+        continue;
+      if (error ||
+          (error= w->execute(s_delete_new_order, {w_id, d_id, o_id})) ||
+          (error= w->execute(s_order_customer, {w_id, d_id, o_id},
+                             &c_id, 1)) ||
+          (error= w->execute(s_order_carrier, {carrier, w_id, d_id, o_id})) ||
+          (error= w->execute(s_order_line_delivery, {w_id, d_id, o_id})) ||
+          (error= w->execute(s_order_amount, {w_id, d_id, o_id},
+                             &amount, 1)) ||
+          (error= w->execute(s_customer_delivery,
+                             {amount, w_id, d_id, c_id})))
+        return error;
+    }
+    return w->commit();
+  }
+
+  int stock_level(Worker *w, longlong w_id)
+  {
+    longlong d_id= w->rand(1, DISTRICTS), next_o_id, low_stock;
+    int error;
+    if ((error= w->begin()) ||
+        (error= w->execute(s_district_next, {w_id, d_id}, &next_o_id, 1)) ||
+        (error= w->execute(s_stock_level,
+                           {w_id, d_id, next_o_id, next_o_id - 20, w_id,
+                            w->rand(10, 20)}, &low_stock, 1)))
+      return error;
+    return w->commit();
+  }
+
+  void load_items(MYSQL *mysql, Worker *w)
+  {
+    Batch_insert batch(mysql, "INSERT INTO item VALUES ");
+    for (uint i= 1; i <= ITEMS; i++)
+    {
+      std::string data= w->rand_string(26, 50);
+      if (w->rand(1, 10) == 1)
+        data.replace((size_t) w->rand(0, data.length() - 8), 8, "ORIGINAL");
+      batch.add(std::to_string(i) + "," + quote(w->rand_string(14, 24)) +
+                "," + std::to_string(w->rand(100, 10000)) + "," +
+                quote(data));
+    }
+  }
+
+  void load_warehouse(MYSQL *mysql, Worker *w, uint w_id)
+  {
+    db_query(mysql, "INSERT INTO warehouse VALUES (" + std::to_string(w_id) +
+             "," + quote(w->rand_string(6, 10)) + "," +
+             std::to_string(w->rand(0, 2000)) + ",30000000)");
+    {
+      Batch_insert batch(mysql, "INSERT INTO stock VALUES ");
+      for (uint i= 1; i <= ITEMS; i++)
+        batch.add(std::to_string(w_id) + "," + std::to_string(i) + "," +
+                  std::to_string(w->rand(10, 100)) + ",0,0,0," +
+                  quote(w->rand_string(26, 50)));
+    }
+    for (uint d_id= 1; d_id <= DISTRICTS; d_id++)
+    {
+      const std::string wd= std::to_string(w_id) + "," + std::to_string(d_id);
+      db_query(mysql, "INSERT INTO district VALUES (" + wd + "," +
+               quote(w->rand_string(6, 10)) + "," +
+               std::to_string(w->rand(0, 2000)) + ",3000000," +
+               std::to_string(ORDERS + 1) + ")");
+      {
+        Batch_insert customers(mysql, "INSERT INTO customer VALUES ");
+        for (uint c_id= 1; c_id <= CUSTOMERS; c_id++)
+        {
+          uint name= c_id <= 1000 ? c_id - 1
+                                  : (uint) w->nurand(255, 0, 999, C_LAST);
+          customers.add(wd + "," + std::to_string(c_id) + "," +
+                        quote(last_name(name)) + "," +
+                        quote(w->rand_string(8, 16)) + "," +
+                        quote(w->rand(1, 10) == 1 ? "BC" : "GC") + "," +
+                        std::to_string(w->rand(0, 5000)) +
+                        ",-1000,1000,1,0," + quote(w->rand_string(300, 500)));
+        }
+      }
+      /* Orders are for a random permutation of the customers */
+      std::vector<uint> customers(CUSTOMERS);
+      for (uint i= 0; i < CUSTOMERS; i++)
+        customers[i]= i + 1;
+      std::shuffle(customers.begin(), customers.end(), w->rng);
+      Batch_insert orders(mysql, "INSERT INTO orders VALUES ");
+      Batch_insert lines(mysql, "INSERT INTO order_line VALUES ");
+      Batch_insert new_orders(mysql, "INSERT INTO new_orders VALUES ");
+      for (uint o_id= 1; o_id <= ORDERS; o_id++)
+      {
+        const bool delivered= o_id <= ORDERS - NEW_ORDERS;
+        const std::string wdo= wd + "," + std::to_string(o_id);
+        longlong ol_cnt= w->rand(5, 15);
+        orders.add(wdo + "," + std::to_string(customers[o_id - 1]) +
+                   "," + date() + "," +
+                   (delivered ? std::to_string(w->rand(1, 10)) : "NULL") +
+                   "," + std::to_string(ol_cnt) + ",1");
+        for (longlong l= 1; l <= ol_cnt; l++)
+          lines.add(wdo + "," + std::to_string(l) + "," +
+                    std::to_string(w->rand(1, ITEMS)) + "," +
+                    std::to_string(w_id) + "," +
+                    (delivered ? date() : "NULL") + ",5," +
+                    (delivered ? "0" : std::to_string(w->rand(1, 999999))) +
+                    "," + quote(w->rand_string(24, 24)));
+        if (!delivered)
+          new_orders.add(wdo);
+      }
+    }
+  }
+
+public:
+  Tpcc_workload()
+  {
+    s_warehouse_tax= add("SELECT w_tax FROM warehouse WHERE w_id=?");
+    s_district_for_update= add("SELECT d_tax, d_next_o_id FROM district"
+                               " WHERE d_w_id=? AND d_id=? FOR UPDATE");
+    s_district_next_o_id= add("UPDATE district SET d_next_o_id=d_next_o_id+1"
+                              " WHERE d_w_id=? AND d_id=?");
+    s_customer_discount= add("SELECT c_discount FROM customer"
+                             " WHERE c_w_id=? AND c_d_id=? AND c_id=?");
+    s_insert_order= add("INSERT INTO orders (o_w_id, o_d_id, o_id, o_c_id,"
+                        " o_entry_d, o_ol_cnt, o_all_local)"
+                        " VALUES (?, ?, ?, ?, NOW(), ?, ?)");
+    s_insert_new_order= add("INSERT INTO new_orders VALUES (?, ?, ?)");
+    s_item_price= add("SELECT i_price FROM item WHERE i_id=?");
+    s_stock_for_update= add("SELECT s_quantity FROM stock"
+                            " WHERE s_w_id=? AND s_i_id=? FOR UPDATE");
+    s_update_stock= add("UPDATE stock SET s_quantity=?, s_ytd=s_ytd+?,"
+                        " s_order_cnt=s_order_cnt+1,"
+                        " s_remote_cnt=s_remote_cnt+?"
+                        " WHERE s_w_id=? AND s_i_id=?");
+    s_insert_order_line= add("INSERT INTO order_line (ol_w_id, ol_d_id,"
+                             " ol_o_id, ol_number, ol_i_id, ol_supply_w_id,"
+                             " ol_quantity, ol_amount, ol_dist_info)"
+                             " VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?)");
+    s_warehouse_ytd= add("UPDATE warehouse SET w_ytd=w_ytd+? WHERE w_id=?");
+    s_district_ytd= add("UPDATE district SET d_ytd=d_ytd+?"
+                        " WHERE d_w_id=? AND d_id=?");
+    s_customer_by_name= add("SELECT c_id FROM customer"
+                            " WHERE c_w_id=? AND c_d_id=? AND c_last=?"
+                            " ORDER BY c_first LIMIT 1");
+    s_customer_for_update= add("SELECT c_balance, c_credit='BC' FROM customer"
+                               " WHERE c_w_id=? AND c_d_id=? AND c_id=?"
+                               " FOR UPDATE");
+    s_customer_payment= add("UPDATE customer SET c_balance=c_balance-?,"
+                            " c_ytd_payment=c_ytd_payment+?,"
+                            " c_payment_cnt=c_payment_cnt+1"
+                            " WHERE c_w_id=? AND c_d_id=? AND c_id=?");
+    s_customer_bad_credit= add("UPDATE customer"
+                               " SET c_data=LEFT(CONCAT(?, ' ', c_data), 500)"
+                               " WHERE c_w_id=? AND c_d_id=? AND c_id=?");
+    s_insert_history= add("INSERT INTO history (h_c_id, h_c_d_id, h_c_w_id,"
+                          " h_d_id, h_w_id, h_date, h_amount, h_data)"
+                          " VALUES (?, ?, ?, ?, ?, NOW(), ?, ?)");
+    s_customer_balance= add("SELECT c_balance FROM customer"
+                            " WHERE c_w_id=? AND c_d_id=? AND c_id=?");
+    s_last_order= add("SELECT o_id FROM orders"
+                      " WHERE o_w_id=? AND o_d_id=? AND o_c_id=?"
+                      " ORDER BY o_id DESC LIMIT 1");
+    s_order_lines= add("SELECT ol_i_id, ol_supply_w_id, ol_quantity,"
+                       " ol_amount, ol_delivery_d FROM order_line"
+                       " WHERE ol_w_id=? AND ol_d_id=? AND ol_o_id=?");
+    s_oldest_new_order= add("SELECT no_o_id FROM new_orders"
+                            " WHERE no_w_id=? AND no_d_id=?"
+                            " ORDER BY no_o_id LIMIT 1 FOR UPDATE");
+    s_delete_new_order= add("DELETE FROM new_orders"
+                            " WHERE no_w_id=? AND no_d_id=? AND no_o_id=?");
+    s_order_customer= add("SELECT o_c_id FROM orders"
+                          " WHERE o_w_id=? AND o_d_id=? AND o_id=?");
+    s_order_carrier= add("UPDATE orders SET o_carrier_id=?"
+                         " WHERE o_w_id=? AND o_d_id=? AND o_id=?");
+    s_order_line_delivery= add("UPDATE order_line SET ol_delivery_d=NOW()"
+                               " WHERE ol_w_id=? AND ol_d_id=? AND ol_o_id=?");
+    s_order_amount= add("SELECT SUM(ol_amount) FROM order_line"
+                        " WHERE ol_w_id=? AND ol_d_id=? AND ol_o_id=?");
+    s_customer_delivery= add("UPDATE customer SET c_balance=c_balance+?,"
+                             " c_delivery_cnt=c_delivery_cnt+1"
+                             " WHERE c_w_id=? AND c_d_id=? AND c_id=?");
+    s_district_next= add("SELECT d_next_o_id FROM district"
+                         " WHERE d_w_id=? AND d_id=?");
+    s_stock_level= add("SELECT COUNT(DISTINCT s_i_id)"
+                       " FROM order_line JOIN stock ON s_i_id=ol_i_id"
+                       " WHERE ol_w_id=? AND ol_d_id=?"
+                       " AND ol_o_id<? AND ol_o_id>=?"
+                       " AND s_w_id=? AND s_quantity<?");
+  }
+
+  std::vector<const char*> transaction_names() const override
+  {
+    return {"new_order", "payment", "order_status", "delivery",
+            "stock_level"};
+  }
+
+  void create(MYSQL *mysql) override
+  {
+    static const char *tables[]=
+    {
+      "warehouse (w_id INT NOT NULL, w_name VARCHAR(10) NOT NULL,"
+      " w_tax INT NOT NULL, w_ytd BIGINT NOT NULL, PRIMARY KEY (w_id))",
+      "district (d_w_id INT NOT NULL, d_id TINYINT NOT NULL,"
+      " d_name VARCHAR(10) NOT NULL, d_tax INT NOT NULL,"
+      " d_ytd BIGINT NOT NULL, d_next_o_id INT NOT NULL,"
+      " PRIMARY KEY (d_w_id, d_id))",
+      "customer (c_w_id INT NOT NULL, c_d_id TINYINT NOT NULL,"
+      " c_id INT NOT NULL, c_last VARCHAR(16) NOT NULL,"
+      " c_first VARCHAR(16) NOT NULL, c_credit CHAR(2) NOT NULL,"
+      " c_discount INT NOT NULL, c_balance BIGINT NOT NULL,"
+      " c_ytd_payment BIGINT NOT NULL, c_payment_cnt INT NOT NULL,"
+      " c_delivery_cnt INT NOT NULL, c_data VARCHAR(500) NOT NULL,"
+      " PRIMARY KEY (c_w_id, c_d_id, c_id),"
+      " KEY (c_w_id, c_d_id, c_last, c_first))",
+      "history (h_id BIGINT NOT NULL AUTO_INCREMENT, h_c_id INT NOT NULL,"
+      " h_c_d_id TINYINT NOT NULL, h_c_w_id INT NOT NULL,"
+      " h_d_id TINYINT NOT NULL, h_w_id INT NOT NULL,"
+      " h_date DATETIME NOT NULL, h_amount BIGINT NOT NULL,"
+      " h_data VARCHAR(24) NOT NULL, PRIMARY KEY (h_id))",
+      "item (i_id INT NOT NULL, i_name VARCHAR(24) NOT NULL,"
+      " i_price BIGINT NOT NULL, i_data VARCHAR(50) NOT NULL,"
+      " PRIMARY KEY (i_id))",
+      "stock (s_w_id INT NOT NULL, s_i_id INT NOT NULL,"
+      " s_quantity INT NOT NULL, s_ytd BIGINT NOT NULL,"
+      " s_order_cnt INT NOT NULL, s_remote_cnt INT NOT NULL,"
+      " s_data VARCHAR(50) NOT NULL, PRIMARY KEY (s_w_id, s_i_id))",
+      "orders (o_w_id INT NOT NULL, o_d_id TINYINT NOT NULL,"
+      " o_id INT NOT NULL, o_c_id INT NOT NULL, o_entry_d DATETIME NOT NULL,"
+      " o_carrier_id TINYINT, o_ol_cnt TINYINT NOT NULL,"
+      " o_all_local TINYINT NOT NULL, PRIMARY KEY (o_w_id, o_d_id, o_id),"
+      " KEY (o_w_id, o_d_id, o_c_id, o_id))",
+      "new_orders (no_w_id INT NOT NULL, no_d_id TINYINT NOT NULL,"
+      " no_o_id INT NOT NULL, PRIMARY KEY (no_w_id, no_d_id, no_o_id))",
+      "order_line (ol_w_id INT NOT NULL, ol_d_id TINYINT NOT NULL,"
+      " ol_o_id INT NOT NULL, ol_number TINYINT NOT NULL,"
+      " ol_i_id INT NOT NULL, ol_supply_w_id INT NOT NULL,"
+      " ol_delivery_d DATETIME, ol_quantity TINYINT NOT NULL,"
+      " ol_amount BIGINT NOT NULL, ol_dist_info CHAR(24) NOT NULL,"
+      " PRIMARY KEY (ol_w_id, ol_d_id, ol_o_id, ol_number))"
+    };
+    for (const char *table : tables)
+      db_query(mysql, std::string("CREATE TABLE IF NOT EXISTS ") + table +
+               " ENGINE=" + opt_engine);
+  }
+
+  uint load_units() const override { return opt_warehouses + 1; }
+
+  void load(MYSQL *mysql, Worker *w, uint unit) override
+  {
+    if (unit)
+      load_warehouse(mysql, w, unit);
+    else
+      load_items(mysql, w);
+  }
+
+  void cleanup(MYSQL *mysql) override
+  {
+    db_query(mysql, "DROP TABLE IF EXISTS warehouse, district, customer,"
+             " history, item, stock, orders, new_orders, order_line");
+  }
+
+  int transaction(Worker *w, uint *type) override
+  {
+    longlong w_id= w->rand(1, opt_warehouses);
+    longlong n= w->rand(1, 100);
+    if (n <= 45)
+      return *type= NEW_ORDER, new_order(w, w_id);
+    if (n <= 88)
+      return *type= PAYMENT, payment(w, w_id);
+    if (n <= 92)
+      return *type= ORDER_STATUS, order_status(w, w_id);
+    if (n <= 96)
+      return *type= DELIVERY, delivery(w, w_id);
+    return *type= STOCK_LEVEL, stock_level(w, w_id);
+  }
+};
+
+
+static std::atomic<bool> stop_run{false};
+static std::atomic<int> run_error{0};
+
+/** @return whether a transaction that failed with error can be retried */
+static bool is_retryable(int error)
+{
+  return error == ER_LOCK_DEADLOCK || error == ER_LOCK_WAIT_TIMEOUT ||
+         error == ER_DUP_ENTRY;
+}
+
+
+static void worker_thread(Workload *workload, Connection_pool *pool,
+                          Worker *w)
+{
+  mysql_thread_init();
+  while (!stop_run)
+  {
+    const auto start= std::chrono::steady_clock::now();
+    uint type= 0;
+    int error;
+    w->con= pool->get();
+    while ((error= workload->transaction(w, &type)))
+    {
+      w->con->rollback();
+      if (!is_retryable(error) || stop_run)
+        break;
+      w->retries.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (error && !is_retryable(error))
+    {
+      int expected= 0;
+      if (run_error.compare_exchange_strong(expected, error))
+        fprintf(stderr, "%s: Got error: %d: %s\n", my_progname, error,
+                error == NOT_FOUND ? "unexpected empty result"
+                                   : w->con->error_message.c_str());
+      stop_run= true;
+    }
+    pool->put(w->con);
+    w->con= nullptr;
+    if (error)
+      break;
+    const auto elapsed= std::chrono::steady_clock::now() - start;
+    w->latency[type].add((ulonglong) std::chrono::duration_cast
+                         <std::chrono::microseconds>(elapsed).count());
+    w->transactions.fetch_add(1, std::memory_order_relaxed);
+  }
+  mysql_thread_end();
+}
+
+
+static void prepare(Workload *workload)
+{
+  MYSQL *mysql= db_connect(NULL);
+  db_query(mysql, std::string("CREATE DATABASE IF NOT EXISTS `") +
+           opt_database + "`");
+  if (mysql_select_db(mysql, opt_database))
+    fatal_error("Got error: %d: %s when selecting the database",
+                mysql_errno(mysql), mysql_error(mysql));
+  workload->create(mysql);
+  mysql_close(mysql);
+
+  /* Load the units in parallel, each thread with its own connection */
+  std::atomic<uint> next_unit{0};
+  const uint n_units= workload->load_units();
+  std::vector<std::thread> threads;
+  for (uint i= 0; i < std::min(opt_threads, n_units); i++)
+    threads.push_back(std::thread([&, i]() {
+      mysql_thread_init();
+      MYSQL *mysql= db_connect(opt_database);
+      Worker w((uint) opt_seed + i, 0);
+      for (uint unit; (unit= next_unit++) < n_units; )
+      {
+        if (!opt_silent)
+          fprintf(stderr, "Loading %u of %u\n", unit + 1, n_units);
+        workload->load(mysql, &w, unit);
+      }
+      mysql_close(mysql);
+      mysql_thread_end();
+    }));
+  for (std::thread &t : threads)
+    t.join();
+}
+
+
+static void cleanup(Workload *workload)
+{
+  MYSQL *mysql= db_connect(opt_database);
+  workload->cleanup(mysql);
+  mysql_close(mysql);
+}
+
+
+static void print_latency(const Latency_histogram &h, const char *indent)
+{
+  if (opt_json)
+    printf("{\"avg\":%.3f,\"p50\":%.3f,\"p95\":%.3f,\"p99\":%.3f,"
+           "\"max\":%.3f}",
+           h.avg() / 1000, h.percentile(50) / 1000.0,
+           h.percentile(95) / 1000.0, h.percentile(99) / 1000.0,
+           h.max() / 1000.0);
+  else
+    printf("%slatency (ms): avg %.3f  p50 %.3f  p95 %.3f  p99 %.3f"
+           "  max %.3f\n", indent,
+           h.avg() / 1000, h.percentile(50) / 1000.0,
+           h.percentile(95) / 1000.0, h.percentile(99) / 1000.0,
+           h.max() / 1000.0);
+}
+
+
+static int run(Workload *workload)
+{
+  const std::vector<const char*> names= workload->transaction_names();
+  const uint n_connections= opt_connections ? opt_connections : opt_threads;
+  Connection_pool pool;
+  pool.init(workload->statements, n_connections);
+
+  std::string server_version;
+  {
+    Connection *c= pool.get();
+    server_version= mysql_get_server_info(c->mysql);
+    pool.put(c);
+  }
+
+  std::vector<Worker*> workers;
+  std::vector<std::thread> threads;
+  for (uint i= 0; i < opt_threads; i++)
+    workers.push_back(new Worker((uint) opt_seed + i, names.size()));
+
+  const auto start= std::chrono::steady_clock::now();
+  for (Worker *w : workers)
+    threads.push_back(std::thread(worker_thread, workload, &pool, w));
+
+  ulonglong last_transactions= 0, last_queries= 0, last_retries= 0;
+  for (uint second= 1; second <= opt_time && !stop_run; second++)
+  {
+    std::this_thread::sleep_until(start + std::chrono::seconds(second));
+    if (!opt_report_interval || second % opt_report_interval || opt_silent)
+      continue;
+    ulonglong transactions= 0, queries= 0, retries= 0;
+    for (Worker *w : workers)
+    {
+      transactions+= w->transactions.load(std::memory_order_relaxed);
+      queries+= w->queries.load(std::memory_order_relaxed);
+      retries+= w->retries.load(std::memory_order_relaxed);
+    }
+    fprintf(stderr, "[ %us ] tps: %.2f qps: %.2f retries/s: %.2f\n", second,
+            (double) (transactions - last_transactions) / opt_report_interval,
+            (double) (queries - last_queries) / opt_report_interval,
+            (double) (retries - last_retries) / opt_report_interval);
+    last_transactions= transactions;
+    last_queries= queries;
+    last_retries= retries;
+  }
+  stop_run= true;
+  for (std::thread &t : threads)
+    t.join();
+  const double seconds= std::chrono::duration<double>
+    (std::chrono::steady_clock::now() - start).count();
+
+  Latency_histogram total;
+  std::vector<Latency_histogram> by_type(names.size());
+  ulonglong queries= 0, retries= 0;
+  for (Worker *w : workers)
+  {
+    for (size_t t= 0; t < names.size(); t++)
+    {
+      by_type[t].merge(w->latency[t]);
+      total.merge(w->latency[t]);
+    }
+    queries+= w->queries;
+    retries+= w->retries;
+    delete w;
+  }
+
+  if (opt_silent)
+    return run_error != 0;
+
+  if (opt_json)
+  {
+    printf("{\"workload\":\"%s\",\"server_version\":\"%s\","
+           "\"threads\":%u,\"connections\":%u,\"prepared\":%s,"
+           "\"time\":%.3f,\"transactions\":%llu,\"tps\":%.2f,"
+           "\"queries\":%llu,\"qps\":%.2f,\"retries\":%llu,\"latency_ms\":",
+           workload_names[opt_workload], server_version.c_str(),
+           opt_threads, n_connections, opt_prepared ? "true" : "false",
+           seconds, total.count, total.count / seconds,
+           queries, queries / seconds, retries);
+    print_latency(total, "");
+    if (names.size() > 1)
+    {
+      printf(",\"transaction_types\":{");
+      for (size_t t= 0; t < names.size(); t++)
+      {
+        printf("%s\"%s\":{\"transactions\":%llu,\"latency_ms\":",
+               t ? "," : "", names[t], by_type[t].count);
+        print_latency(by_type[t], "");
+        printf("}");
+      }
+      printf("}");
+    }
+    printf("}\n");
+  }
+  else
+  {
+    printf("Workload:      %s\n"
+           "Server:        %s\n"
+           "Threads:       %u\n"
+           "Connections:   %u\n"
+           "Prepared:      %s\n"
+           "Time:          %.3f s\n"
+           "Transactions:  %llu (%.2f per second)\n"
+           "Queries:       %llu (%.2f per second)\n"
+           "Retries:       %llu\n",
+           workload_names[opt_workload], server_version.c_str(),
+           opt_threads, n_connections, opt_prepared ? "yes" : "no",
+           seconds, total.count, total.count / seconds,
+           queries, queries / seconds, retries);
+    print_latency(total, "");
+    if (names.size() > 1)
+      for (size_t t= 0; t < names.size(); t++)
+      {
+        printf("%s: %llu transactions\n", names[t], by_type[t].count);
+        print_latency(by_type[t], "  ");
+      }
+  }
+  return run_error != 0;
+}
+
+
+int main(int argc, char **argv)
+{
+  int ho_error, error= 0;
+  char **argv_to_free;
+
+  MY_INIT(argv[0]);
+  sf_leaking_memory= 1; /* don't report memory leaks on early exits */
+
+  /* We need to know if protocol-related options originate from CLI args */
+  my_defaults_mark_files= TRUE;
+  load_defaults_or_exit("my", load_default_groups, &argc, &argv);
+  /* argv is changed in the program */
+  argv_to_free= argv;
+  if (current_host == NULL)
+    current_host= getenv("MARIADB_HOST");
+  if ((ho_error= handle_options(&argc, &argv, my_long_options,
+                                get_one_option)))
+    exit(ho_error);
+  if (debug_info_flag)
+    my_end_arg= MY_CHECK_ERROR | MY_GIVE_INFO;
+  if (debug_check_flag)
+    my_end_arg= MY_CHECK_ERROR;
+  if (argc != 1)
+  {
+    usage();
+    exit(1);
+  }
+  if (tty_password)
+    opt_password= my_get_tty_password(NullS);
+  mysql_library_init(-1, 0, 0);
+  sf_leaking_memory= 0; /* from now on we cleanup properly */
+
+  Workload *workload;
+  if (opt_workload == WORKLOAD_TPCC)
+    workload= new Tpcc_workload();
+  else
+    workload= new Sysbench_workload((workload_type) opt_workload);
+
+  if (!strcmp(argv[0], "prepare"))
+    prepare(workload);
+  else if (!strcmp(argv[0], "run"))
+    error= run(workload);
+  else if (!strcmp(argv[0], "cleanup"))
+    cleanup(workload);
+  else
+    fatal_error("Unknown command '%s', expected prepare, run or cleanup",
+                argv[0]);
+
+  delete workload;
+  mysql_library_end();
+  free_defaults(argv_to_free);
+  my_free(opt_password);
+  my_end(my_end_arg);
+  return error;
+}
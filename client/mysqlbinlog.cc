@@ -96,6 +96,8 @@ ulonglong test_flags = 0;
 ulong opt_binlog_rows_event_max_encoded_size= MAX_MAX_ALLOWED_PACKET;
 static uint opt_protocol= 0;
 static FILE *result_file;
+/* Output is flushed in large chunks, see process_event() */
+#define RESULT_FILE_BUFFER_SIZE (256*1024)
 static char *result_file_name= 0;
 static const char *output_prefix= "";
 static char **defaults_argv= 0;
@@ -1402,7 +1404,14 @@ Exit_status process_event(PRINT_EVENT_INFO *print_event_info, Log_event *ev,
       {
         my_fwrite(result_file, (const uchar *) tmp_str.str, tmp_str.length,
                   MYF(MY_NABP));
-        fflush(result_file);
+        /*
+          Flushing every event makes the output one write() per event,
+          which dominates piping a large binlog into the mysql client.
+          Only do it when there may be a long wait for the next event.
+          Anything printed to stderr flushes the result file first.
+        */
+        if (opt_stop_never)
+          fflush(result_file);
         my_free(tmp_str.str);
       }
     }
@@ -3319,6 +3328,7 @@ int main(int argc, char** argv)
     }
     else
       result_file= stdout;
+    setvbuf(result_file, NULL, _IOFBF, RESULT_FILE_BUFFER_SIZE);
   }
 
   MY_TMPDIR tmpdir;
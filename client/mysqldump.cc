@@ -192,6 +192,7 @@ static uint opt_protocol= 0;
 static char *opt_plugin_dir= 0, *opt_default_auth= 0;
 static uint opt_parallel= 0;
 static char *opt_dir;
+static ulonglong opt_chunk_rows= 0;
 
 /**
  A flag to indicate that backup uses multiple files for output.
@@ -292,6 +293,13 @@ static struct my_option my_long_options[] =
   {"character-sets-dir", 0,
    "Directory for character set files.", (char **)&charsets_dir,
    (char **)&charsets_dir, 0, GET_STR, REQUIRED_ARG, 0, 0, 0, 0, 0, 0},
+  {"chunk-rows", 0,
+   "Only with --dir and --parallel. Split the data of a table that has more "
+   "rows than this and an integer primary key into files of about this many "
+   "rows, by ranges of the primary key. The files are dumped in parallel. "
+   "0 means no splitting.",
+   &opt_chunk_rows, &opt_chunk_rows, 0, GET_ULL, REQUIRED_ARG,
+   0, 0, ULONGLONG_MAX, 0, 0, 0},
   {"comments", 'i', "Write additional information.",
    &opt_comments, &opt_comments, 0, GET_BOOL, NO_ARG,
    1, 0, 0, 0, 0, 0},
@@ -530,7 +538,7 @@ static struct my_option my_long_options[] =
   {"password", 'p',
    "Password to use when connecting to server. If password is not given it's solicited on the tty.",
    0, 0, 0, GET_STR, OPT_ARG, 0, 0, 0, 0, 0, 0},
-  {"parallel", 'j', "Number of dump table jobs executed in parallel (only with --tab option)",
+  {"parallel", 'j', "Number of dump table jobs executed in parallel (only with --tab or --dir option)",
    &opt_parallel, &opt_parallel, 0, GET_UINT, REQUIRED_ARG, 0, 0, 0, 0, 0, 0},
 #ifdef _WIN32
   {"pipe", 'W', "Use named pipes to connect to server.", 0, 0, 0, GET_NO_ARG,
@@ -1276,6 +1284,13 @@ static int get_options(int *argc, char ***argv)
 
   multi_file_output= path != 0 || opt_dir != 0;
 
+  if (opt_chunk_rows && (!opt_dir || !opt_parallel))
+  {
+    fprintf(stderr, "%s: Option --chunk-rows requires --dir and --parallel\n",
+            my_progname_short);
+    return(EX_USAGE);
+  }
+
   if (multi_file_output)
   {
     const char *outdir= path ? path : opt_dir;
@@ -4165,6 +4180,125 @@ static void send_query_completion_func(MYSQL* mysql, const char* query,
       mysql_error(mysql));
 }
 
+
+#define MAX_CHUNKS_PER_TABLE 10000
+
+/*
+  Split the data of a table by ranges of its primary key, for --chunk-rows
+
+  SYNOPSIS
+    get_chunk_conditions()
+    table         table name
+    db            database name
+    result_table  quoted table name
+    chunks        WHERE conditions, one for each file to dump
+
+  DESCRIPTION
+    The table is split if the server estimates more than --chunk-rows rows
+    and the first column of the primary key is an integer. The ranges are
+    of equal width between the smallest and the largest value; the first
+    and the last one are open, so that every row is in one of them.
+
+    Failures are not fatal: the table is dumped into one file then.
+*/
+
+static void get_chunk_conditions(const char *table, const char *db,
+                                 const char *result_table,
+                                 std::vector<std::string> &chunks)
+{
+  char query_buff[QUERY_LENGTH + NAME_LEN * 4];
+  char escaped_db[NAME_LEN * 2 + 1], escaped_table[NAME_LEN * 2 + 1];
+  char quoted_db[NAME_LEN * 2 + 3], column[NAME_LEN * 2 + 3];
+  MYSQL_RES *res;
+  MYSQL_ROW row;
+  MYSQL_FIELD *field;
+  ulonglong rows= 0;
+
+  mysql_real_escape_string(mysql, escaped_db, db, (ulong) strlen(db));
+  mysql_real_escape_string(mysql, escaped_table, table, (ulong) strlen(table));
+  my_snprintf(query_buff, sizeof(query_buff),
+              "SELECT TABLE_ROWS FROM INFORMATION_SCHEMA.TABLES "
+              "WHERE TABLE_SCHEMA='%s' AND TABLE_NAME='%s'",
+              escaped_db, escaped_table);
+  if (mysql_query(mysql, query_buff) || !(res= mysql_store_result(mysql)))
+    goto err;
+  if ((row= mysql_fetch_row(res)) && row[0])
+    rows= strtoull(row[0], NULL, 10);
+  mysql_free_result(res);
+  if (rows <= opt_chunk_rows)
+    return;
+
+  /* SHOW KEYS always returns the PRIMARY KEY first */
+  my_snprintf(query_buff, sizeof(query_buff), "SHOW KEYS FROM %s.%s",
+              quote_name(db, quoted_db, 1), result_table);
+  if (mysql_query(mysql, query_buff) || !(res= mysql_store_result(mysql)))
+    goto err;
+  row= mysql_fetch_row(res);
+  if (!row || strcmp(row[2], "PRIMARY"))
+  {
+    mysql_free_result(res);
+    return;
+  }
+  quote_name(row[4], column, 1);
+  mysql_free_result(res);
+
+  my_snprintf(query_buff, sizeof(query_buff),
+              "SELECT MIN(%s), MAX(%s) FROM %s.%s",
+              column, column, quoted_db, result_table);
+  if (mysql_query(mysql, query_buff) || !(res= mysql_store_result(mysql)))
+    goto err;
+  field= mysql_fetch_field(res);
+  row= mysql_fetch_row(res);
+  if (row && row[0] && row[1] &&
+      (field->type == MYSQL_TYPE_TINY || field->type == MYSQL_TYPE_SHORT ||
+       field->type == MYSQL_TYPE_INT24 || field->type == MYSQL_TYPE_LONG ||
+       field->type == MYSQL_TYPE_LONGLONG))
+  {
+    const bool is_unsigned= field->flags & UNSIGNED_FLAG;
+    /* Unsigned arithmetic on the offsets from min works for both */
+    const ulonglong min= is_unsigned ? strtoull(row[0], NULL, 10)
+                                     : (ulonglong) strtoll(row[0], NULL, 10);
+    const ulonglong max= is_unsigned ? strtoull(row[1], NULL, 10)
+                                     : (ulonglong) strtoll(row[1], NULL, 10);
+    const ulonglong width= max - min;
+    const ulonglong n= MY_MIN(rows / opt_chunk_rows + 1, MAX_CHUNKS_PER_TABLE);
+    const ulonglong step= width / n + 1;
+    std::vector<std::string> bounds;
+
+    for (ulonglong i= 1; i < n && i <= width / step; i++)
+    {
+      char bound[22];
+      const ulonglong value= min + step * i;
+      if (is_unsigned)
+        my_snprintf(bound, sizeof(bound), "%llu", value);
+      else
+        my_snprintf(bound, sizeof(bound), "%lld", (longlong) value);
+      bounds.push_back(bound);
+    }
+
+    for (size_t i= 0; !bounds.empty() && i <= bounds.size(); i++)
+    {
+      std::string condition;
+      if (i)
+        condition.append(column).append(">=").append(bounds[i - 1]);
+      if (i && i < bounds.size())
+        condition.append(" AND ");
+      if (i < bounds.size())
+        condition.append(column).append("<").append(bounds[i]);
+      chunks.push_back(condition);
+    }
+  }
+  mysql_free_result(res);
+  if (!chunks.empty())
+    verbose_msg("-- Splitting the data of table %s into %zu files\n",
+                result_table, chunks.size());
+  return;
+
+err:
+  fprintf(stderr, "-- Warning: Couldn't split the data of table %s (%s)\n",
+          result_table, mysql_error(mysql));
+}
+
 /*
 
  SYNOPSIS
@@ -4284,91 +4418,120 @@ static void dump_table(const char *table, const char *db, const uchar *hash_key,
     */
     convert_dirname(tmp_path,out_dir,NullS);
     my_load_path(tmp_path, tmp_path, NULL);
-    fn_format(filename, table, tmp_path, ".txt", MYF(MY_UNPACK_FILENAME));
 
-    /* Must delete the file that 'INTO OUTFILE' will write to */
-    my_delete(filename, MYF(0));
+    /* With --chunk-rows, one file per range of the primary key */
+    std::vector<std::string> chunks;
+    if (opt_chunk_rows)
+      get_chunk_conditions(table, db, result_table, chunks);
+    const size_t n_files= chunks.empty() ? 1 : chunks.size();
 
-    /* convert to a unix path name to stick into the query */
-    to_unix_path(filename);
+    for (size_t chunk= 0; chunk < n_files; chunk++)
+    {
+      if (chunk == 0)
+        fn_format(filename, table, tmp_path, ".txt", MYF(MY_UNPACK_FILENAME));
+      else
+      {
+        char chunk_name[FN_REFLEN];
+        my_snprintf(chunk_name, sizeof(chunk_name), "%s.%zu.txt", table, chunk);
+        fn_format(filename, chunk_name, tmp_path, "", MYF(MY_UNPACK_FILENAME));
+      }
 
-    /* now build the query string */
+      /* Must delete the file that 'INTO OUTFILE' will write to */
+      my_delete(filename, MYF(0));
 
-    dynstr_append_checked(&query_string, "SELECT /*!40001 SQL_NO_CACHE */ ");
-    dynstr_append_checked(&query_string, select_field_names.str);
-    dynstr_append_checked(&query_string, " INTO OUTFILE '");
-    dynstr_append_checked(&query_string, filename);
-    dynstr_append_checked(&query_string, "'");
+      /* convert to a unix path name to stick into the query */
+      to_unix_path(filename);
 
-    dynstr_append_checked(&query_string, " /*!50138 CHARACTER SET ");
-    dynstr_append_checked(&query_string, default_charset == mysql_universal_client_charset ?
-                                         my_charset_bin.coll_name.str : /* backward compatibility */
-                                         default_charset);
-    dynstr_append_checked(&query_string, " */");
+      /* now build the query string */
 
-    if (fields_terminated || enclosed || opt_enclosed || escaped)
-      dynstr_append_checked(&query_string, " FIELDS");
+      dynstr_set_checked(&query_string, "SELECT /*!40001 SQL_NO_CACHE */ ");
+      dynstr_append_checked(&query_string, select_field_names.str);
+      dynstr_append_checked(&query_string, " INTO OUTFILE '");
+      dynstr_append_checked(&query_string, filename);
+      dynstr_append_checked(&query_string, "'");
 
-    add_load_option(&query_string, " TERMINATED BY ", fields_terminated);
-    add_load_option(&query_string, " ENCLOSED BY ", enclosed);
-    add_load_option(&query_string, " OPTIONALLY ENCLOSED BY ", opt_enclosed);
-    add_load_option(&query_string, " ESCAPED BY ", escaped);
-    add_load_option(&query_string, " LINES TERMINATED BY ", lines_terminated);
+      dynstr_append_checked(&query_string, " /*!50138 CHARACTER SET ");
+      dynstr_append_checked(&query_string, default_charset == mysql_universal_client_charset ?
+                                           my_charset_bin.coll_name.str : /* backward compatibility */
+                                           default_charset);
+      dynstr_append_checked(&query_string, " */");
 
-    if (opt_header)
-    {
-      dynstr_append_checked(&query_string, " FROM ( SELECT ");
-      if (order_by)
-        dynstr_append_checked(&query_string, " 0 AS `_$is_data_row$_`,");
-      dynstr_append_checked(&query_string, select_field_names_for_header.str);
-      dynstr_append_checked(&query_string, " UNION ALL SELECT ");
-      if (order_by)
-        dynstr_append_checked(&query_string, "1 AS `_$is_data_row$_`,");
-      dynstr_append_checked(&query_string, select_field_names.str);
-    }
-    dynstr_append_checked(&query_string, " FROM ");
-    char quoted_db_buf[NAME_LEN * 2 + 3];
-    char *qdatabase= quote_name(db, quoted_db_buf, opt_quoted);
-    dynstr_append_checked(&query_string, qdatabase);
-    dynstr_append_checked(&query_string, ".");
-    dynstr_append_checked(&query_string, result_table);
+      if (fields_terminated || enclosed || opt_enclosed || escaped)
+        dynstr_append_checked(&query_string, " FIELDS");
 
-    if (versioned)
-      vers_append_system_time(&query_string);
+      add_load_option(&query_string, " TERMINATED BY ", fields_terminated);
+      add_load_option(&query_string, " ENCLOSED BY ", enclosed);
+      add_load_option(&query_string, " OPTIONALLY ENCLOSED BY ", opt_enclosed);
+      add_load_option(&query_string, " ESCAPED BY ", escaped);
+      add_load_option(&query_string, " LINES TERMINATED BY ", lines_terminated);
 
-    if (where)
-    {
-      dynstr_append_checked(&query_string, " WHERE ");
-      dynstr_append_checked(&query_string, where);
-    }
-    if (opt_header)
-      dynstr_append_checked(&query_string, ") s");
+      if (opt_header)
+      {
+        dynstr_append_checked(&query_string, " FROM ( SELECT ");
+        if (order_by)
+          dynstr_append_checked(&query_string, " 0 AS `_$is_data_row$_`,");
+        dynstr_append_checked(&query_string, select_field_names_for_header.str);
+        dynstr_append_checked(&query_string, " UNION ALL SELECT ");
+        if (order_by)
+          dynstr_append_checked(&query_string, "1 AS `_$is_data_row$_`,");
+        dynstr_append_checked(&query_string, select_field_names.str);
+      }
+      dynstr_append_checked(&query_string, " FROM ");
+      char quoted_db_buf[NAME_LEN * 2 + 3];
+      char *qdatabase= quote_name(db, quoted_db_buf, opt_quoted);
+      dynstr_append_checked(&query_string, qdatabase);
+      dynstr_append_checked(&query_string, ".");
+      dynstr_append_checked(&query_string, result_table);
 
-    if (order_by)
-    {
+      if (versioned)
+        vers_append_system_time(&query_string);
+
+      if (where && !chunks.empty())
+      {
+        dynstr_append_checked(&query_string, " WHERE (");
+        dynstr_append_checked(&query_string, where);
+        dynstr_append_checked(&query_string, ") AND ");
+        dynstr_append_checked(&query_string, chunks[chunk].c_str());
+      }
+      else if (where)
+      {
+        dynstr_append_checked(&query_string, " WHERE ");
+        dynstr_append_checked(&query_string, where);
+      }
+      else if (!chunks.empty())
+      {
+        dynstr_append_checked(&query_string, " WHERE ");
+        dynstr_append_checked(&query_string, chunks[chunk].c_str());
+      }
       if (opt_header)
-        dynstr_append_checked(&query_string, " ORDER BY `_$is_data_row$_`,");
-      else
-        dynstr_append_checked(&query_string, " ORDER BY ");
-      dynstr_append_checked(&query_string, order_by);
-      my_free(order_by);
-      order_by= 0;
-    }
-    if (opt_parallel)
-    {
-      if (connection_pool.execute_async(query_string.str,send_query_completion_func,nullptr,true))
+        dynstr_append_checked(&query_string, ") s");
+
+      if (order_by)
+      {
+        if (opt_header)
+          dynstr_append_checked(&query_string, " ORDER BY `_$is_data_row$_`,");
+        else
+          dynstr_append_checked(&query_string, " ORDER BY ");
+        dynstr_append_checked(&query_string, order_by);
+      }
+      if (opt_parallel)
+      {
+        if (connection_pool.execute_async(query_string.str,send_query_completion_func,nullptr,true))
+        {
+          dynstr_free(&query_string);
+          DB_error(mysql, "when executing send_query 'SELECT INTO OUTFILE'");
+          DBUG_VOID_RETURN;
+        }
+      }
+      else if (mysql_real_query(mysql, query_string.str, (ulong)query_string.length))
       {
         dynstr_free(&query_string);
-        DB_error(mysql, "when executing send_query 'SELECT INTO OUTFILE'");
+        DB_error(mysql, "when executing 'SELECT INTO OUTFILE'");
         DBUG_VOID_RETURN;
       }
     }
-    else if (mysql_real_query(mysql, query_string.str, (ulong)query_string.length))
-    {
-      dynstr_free(&query_string);
-      DB_error(mysql, "when executing 'SELECT INTO OUTFILE'");
-      DBUG_VOID_RETURN;
-    }
+    my_free(order_by);
+    order_by= 0;
   }
   else
   {
@@ -6632,6 +6795,37 @@ static int do_unlock_tables(MYSQL *mysql_con)
   return mysql_query_with_error_report(mysql_con, 0, "UNLOCK TABLES");
 }
 
+
+/*
+  Block commits with BACKUP STAGE, which unlike FLUSH TABLES WITH READ LOCK
+  does not wait for running statements.
+
+  RETURN
+    1 if commits are blocked, 0 if not (old server or missing privilege)
+*/
+
+static my_bool do_block_commit(MYSQL *mysql_con)
+{
+  if (mysql_get_server_version(mysql_con) < 100401)
+    return 0;
+  if (mysql_query(mysql_con, "BACKUP STAGE START") ||
+      mysql_query(mysql_con, "BACKUP STAGE BLOCK_COMMIT"))
+  {
+    fprintf(stderr, "-- Warning: Couldn't block commits (%s), the parallel "
+            "connections may not see the same snapshot\n",
+            mysql_error(mysql_con));
+    mysql_query(mysql_con, "BACKUP STAGE END");
+    return 0;
+  }
+  return 1;
+}
+
+
+static int do_unblock_commit(MYSQL *mysql_con)
+{
+  return mysql_query_with_error_report(mysql_con, 0, "BACKUP STAGE END");
+}
+
 static int get_bin_log_name(MYSQL *mysql_con,
                             char* buff_log_name, uint buff_len)
 {
@@ -7314,6 +7508,7 @@ int main(int argc, char **argv)
   int exit_code;
   int consistent_binlog_pos= 0;
   int have_mariadb_gtid= 0;
+  my_bool tables_read_locked= 0;
   /*
     to hold SET @@global.gtid_slave_pos which is deferred to print
     until the function epilogue.
@@ -7384,10 +7579,13 @@ int main(int argc, char **argv)
     consistent_binlog_pos= check_consistent_binlog_pos(NULL, NULL);
   }
 
-  if ((opt_lock_all_tables || (opt_master_data && !consistent_binlog_pos) ||
-       (opt_single_transaction && flush_logs)) &&
-      do_flush_tables_read_lock(mysql))
-    goto err;
+  if (opt_lock_all_tables || (opt_master_data && !consistent_binlog_pos) ||
+      (opt_single_transaction && flush_logs))
+  {
+    if (do_flush_tables_read_lock(mysql))
+      goto err;
+    tables_read_locked= 1;
+  }
 
   /*
     Flush logs before starting transaction since
@@ -7421,12 +7619,20 @@ int main(int argc, char **argv)
 
   if (opt_single_transaction)
   {
+    /*
+      The parallel connections must all see the same snapshot. Without the
+      read lock, block commits while their transactions are started.
+    */
+    my_bool commits_blocked= opt_parallel && !tables_read_locked &&
+                             do_block_commit(mysql);
     if (start_transaction(mysql))
       goto err;
     connection_pool.for_each_connection([](MYSQL *c) {
       if (start_transaction(c))
         maybe_die(EX_MYSQLERR, "Failed to start transaction on connection ID %lu", mysql->thread_id);
     });
+    if (commits_blocked && do_unblock_commit(mysql))
+      goto err;
   }
 
   /* Add 'STOP SLAVE to beginning of dump */
@@ -42,6 +42,9 @@
 #include <tpool.h>
 #include <vector>
 #include <unordered_set>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
 #include <my_dir.h>
 
 tpool::thread_pool *thread_pool;
@@ -49,7 +52,7 @@ static std::vector<MYSQL *> all_tp_connections;
 std::atomic<bool> aborting{false};
 static void kill_tp_connections(MYSQL *mysql);
 
-static void db_error_with_table(MYSQL *mysql, char *table);
+static void db_error_with_table(MYSQL *mysql, const char *table);
 static void db_error(MYSQL *mysql);
 static char *field_escape(char *to,const char *from,uint length);
 static char *add_load_option(char *ptr,const char *object,
@@ -69,6 +72,7 @@ static uint     opt_mysql_port= 0, opt_protocol= 0;
 static char * opt_mysql_unix_port=0;
 static char *opt_plugin_dir= 0, *opt_default_auth= 0;
 static longlong opt_ignore_lines= -1;
+static ulonglong opt_split_size;
 static char *opt_dir;
 
 #include <sslopt-vars.h>
@@ -85,6 +89,8 @@ struct table_load_params
   std::string tablename; /* name of the table */
   std::string dbname;    /* name of the database */
   ulonglong size= 0;     /* size of the data file */
+  std::vector<std::string> chunk_files; /* more data files of the table,
+                                           written by --chunk-rows */
 };
 
 std::unordered_set<std::string> ignore_databases;
@@ -216,6 +222,13 @@ static struct my_option my_long_options[] =
   {"socket", 'S', "The socket file to use for connection.",
    &opt_mysql_unix_port, &opt_mysql_unix_port, 0, GET_STR,
    REQUIRED_ARG, 0, 0, 0, 0, 0, 0},
+  {"split-size", 0,
+   "With --parallel and --local, divide data files that are larger than "
+   "this at line boundaries, and load the pieces concurrently. Only files "
+   "with the default line terminator and escape character, without field "
+   "enclosure and without --ignore-lines are divided. 0 disables.",
+   &opt_split_size, &opt_split_size, 0, GET_ULL, REQUIRED_ARG, 0, 0,
+   ULONGLONG_MAX, 0, 0, 0},
   {"table", OPT_TABLES,
    "Restore the specified table ignoring others. Use --table=dbname.tablename with this option. "
    "To specify more than one table to include, use the directive multiple times, once for each "
@@ -388,6 +401,11 @@ static int get_options(int *argc, char ***argv)
     fprintf(stderr, "You can't use --ignore (-i) and --replace (-r) at the same time.\n");
     return(1);
   }
+  if (opt_split_size && !opt_local_file)
+  {
+    fprintf(stderr, "Option --split-size requires --local.\n");
+    return(1);
+  }
   if (*argc < 2 && !opt_dir)
   {
     usage();
@@ -584,86 +602,173 @@ static int create_db_if_not_exists(MYSQL *mysql, const char *dbname)
   return 0;
 }
 
-static int handle_one_table(const table_load_params *params, MYSQL *mysql)
+/** A piece of a data file that is loaded with one LOAD DATA statement */
+struct load_part
 {
-  char tablename[FN_REFLEN], hard_path[FN_REFLEN],
-       escaped_name[FN_REFLEN * 2 + 1],
-       sql_statement[FN_REFLEN*16+256], *end;
-  DBUG_ENTER("handle_one_table");
-  DBUG_PRINT("enter",("datafile: %s",params->data_file.c_str()));
+  std::string file; /* name of the data file */
+  my_off_t start;   /* offset of the first line */
+  my_off_t end;     /* offset after the last line, or 0 for the whole file */
+};
 
-  if (aborting)
-    return 1;
-  if (verbose && !params->sql_file.empty())
+/** State of the LOCAL INFILE handler that reads a load_part */
+struct part_infile
+{
+  File fd;
+  my_off_t remaining;
+  int error;
+};
+
+static int part_infile_init(void **ptr, const char *filename, void *userdata)
+{
+  const load_part *part= static_cast<const load_part*>(userdata);
+  part_infile *f= new part_infile{-1, part->end - part->start, 0};
+  *ptr= f;
+  if ((f->fd= my_open(filename, O_RDONLY | O_BINARY, MYF(0))) < 0 ||
+      my_seek(f->fd, part->start, MY_SEEK_SET, MYF(0)) != part->start)
   {
-    fprintf(stdout, "Executing SQL script %s\n", params->sql_file.c_str());
+    f->error= my_errno;
+    return 1;
   }
+  return 0;
+}
 
-  if (!params->dbname.empty())
+static int part_infile_read(void *ptr, char *buf, unsigned int len)
+{
+  part_infile *f= static_cast<part_infile*>(ptr);
+  if (len > f->remaining)
+    len= uint(f->remaining);
+  if (!len)
+    return 0;
+  size_t n= my_read(f->fd, (uchar*) buf, len, MYF(0));
+  if (n == MY_FILE_ERROR)
   {
-    if (mysql_select_db(mysql, params->dbname.c_str()))
-    {
-      if (create_db_if_not_exists(mysql, params->dbname.c_str()))
-        DBUG_RETURN(1);
-      if (mysql_select_db(mysql, params->dbname.c_str()))
-          db_error(mysql);
-    }
+    f->error= my_errno;
+    return -1;
   }
+  f->remaining-= n;
+  return int(n);
+}
 
-  const char *filename= params->data_file.c_str();
-  if (!filename[0])
-    filename= params->sql_file.c_str();
+static void part_infile_end(void *ptr)
+{
+  part_infile *f= static_cast<part_infile*>(ptr);
+  if (!f)
+    return;
+  if (f->fd >= 0)
+    my_close(f->fd, MYF(0));
+  delete f;
+}
 
-  fn_format(tablename, filename, "", "", 1 | 2); /* removes path & ext. */
+static int part_infile_error(void *ptr, char *msg, unsigned int len)
+{
+  part_infile *f= static_cast<part_infile*>(ptr);
+  my_snprintf(msg, len, "Error %d when reading the data file",
+              f ? f->error : 0);
+  return CR_UNKNOWN_ERROR;
+}
 
-  const char *db= current_db ? current_db : params->dbname.c_str();
-  std::string full_tablename= quote_identifier(db);
-  full_tablename+= ".";
-  full_tablename+= quote_identifier(tablename);
+/**
+  Find the start of the next line in a data file that uses the default
+  LINES TERMINATED BY '\n' and FIELDS ESCAPED BY '\\'. A newline that
+  follows an odd number of escape characters is part of a field.
 
-  bool tz_utc= false;
-  std::string engine;
-  std::vector<std::string> triggers;
-  if (!params->sql_file.empty())
+  @param fd    data file
+  @param pos   offset to start the search at
+  @param size  size of the file
+
+  @return offset after a line terminator, or size if there is none
+*/
+static my_off_t next_line_start(File fd, my_off_t pos, my_off_t size)
+{
+  uchar buf[65536];
+  while (pos < size)
   {
-    std::string sql_text= parse_sql_script(params->sql_file.c_str(), &tz_utc, &triggers,&engine);
-    if (execute_sql_batch(mysql, sql_text.c_str(),params->sql_file.c_str()))
-      DBUG_RETURN(1);
-    if (params->data_file.empty())
+    size_t n= my_pread(fd, buf, sizeof buf, pos, MYF(0));
+    if (n == MY_FILE_ERROR || !n)
+      break;
+    for (size_t i= 0; i < n; i++)
     {
-      /*
-        We only use .sql extension for VIEWs, so we're done
-        with this file, there is no data to load.
-      */
-      DBUG_RETURN(0);
+      if (buf[i] != '\n')
+        continue;
+      size_t e= i;
+      while (e && buf[e - 1] == '\\')
+        e--;
+      /* If the escape characters may continue before buf, look further */
+      if (e && !((i - e) & 1))
+        return pos + i + 1;
     }
-    if (tz_utc && exec_sql(mysql, "SET TIME_ZONE='+00:00';"))
-      DBUG_RETURN(1);
-    if (exec_sql(mysql, std::string("ALTER TABLE ") + full_tablename + " DISABLE KEYS"))
-      DBUG_RETURN(1);
+    pos+= n;
+  }
+  return size;
+}
+
+/**
+  Add the pieces of a data file to load. With --split-size, a larger file
+  is divided at line boundaries, so that the pieces can be loaded by
+  concurrent LOAD DATA LOCAL INFILE statements.
+
+  @param file   data file
+  @param split  whether the file may be divided
+  @param parts  where to append the pieces
+*/
+static void add_load_parts(const std::string &file, bool split,
+                           std::vector<load_part> &parts)
+{
+  MY_STAT st;
+  File fd;
+  if (!split || !my_stat(file.c_str(), &st, MYF(0)) ||
+      ulonglong(st.st_size) <= opt_split_size ||
+      (fd= my_open(file.c_str(), O_RDONLY | O_BINARY, MYF(0))) < 0)
+  {
+    parts.push_back({file, 0, 0});
+    return;
+  }
+  const my_off_t size= st.st_size;
+  for (my_off_t start= 0; start < size; )
+  {
+    my_off_t end= size - start > opt_split_size
+      ? next_line_start(fd, start + opt_split_size, size)
+      : size;
+    parts.push_back({file, start, end});
+    start= end;
   }
+  my_close(fd, MYF(0));
+}
+
+/**
+  Load (a piece of) a data file into a table with LOAD DATA INFILE
+
+  @param mysql           connection
+  @param part            data file, and the range of it to load
+  @param db              database of the table
+  @param tablename       table name, for messages
+  @param full_tablename  quoted db.table
+
+  @return 0 on success
+*/
+static int load_data_file(MYSQL *mysql, const load_part &part, const char *db,
+                          const char *tablename,
+                          const std::string &full_tablename)
+{
+  char hard_path[FN_REFLEN], escaped_name[FN_REFLEN * 2 + 1],
+       sql_statement[FN_REFLEN*16+256], *end;
+  const char *filename= part.file.c_str();
+
   if (!opt_local_file)
     strmov(hard_path,filename);
   else
     my_load_path(hard_path, filename, NULL); /* filename includes the path */
 
-  if (opt_delete)
-  {
-    if (verbose)
-      fprintf(stdout, "Deleting the old data from table %s\n", tablename);
-    snprintf(sql_statement, FN_REFLEN * 16 + 256, "DELETE FROM %s",
-             full_tablename.c_str());
-    if (exec_sql(mysql, sql_statement))
-      DBUG_RETURN(1);
-  }
-  if (exec_sql(mysql, "SET collation_database=binary"))
-    DBUG_RETURN(1);
-
   to_unix_path(hard_path);
   if (verbose)
   {
-    fprintf(stdout, "Loading data from %s file: %s into %s\n",
-           (opt_local_file) ? "LOCAL" : "SERVER", hard_path, tablename);
+    if (part.end)
+      fprintf(stdout, "Loading data from LOCAL file: %s bytes %llu-%llu"
+              " into %s\n", hard_path, (ulonglong) part.start,
+              (ulonglong) part.end, tablename);
+    else
+      fprintf(stdout, "Loading data from %s file: %s into %s\n",
+              (opt_local_file) ? "LOCAL" : "SERVER", hard_path, tablename);
   }
   mysql_real_escape_string(mysql, escaped_name, hard_path,
                            (unsigned long) strlen(hard_path));
@@ -688,17 +793,24 @@ static int handle_one_table(const table_load_params *params, MYSQL *mysql)
 		       " OPTIONALLY ENCLOSED BY");
   end= add_load_option(end, escaped, " ESCAPED BY");
   end= add_load_option(end, lines_terminated, " LINES TERMINATED BY");
-  if (opt_ignore_lines >= 0)
+  if (opt_ignore_lines >= 0 && !part.start)
     end= strmov(longlong10_to_str(opt_ignore_lines, 
 				  strmov(end, " IGNORE "),10), " LINES");
   if (opt_columns)
     end= strmov(strmov(strmov(end, " ("), opt_columns), ")");
   *end= '\0';
 
-  if (mysql_query(mysql, sql_statement))
+  if (part.end)
+    mysql_set_local_infile_handler(mysql, part_infile_init, part_infile_read,
+                                   part_infile_end, part_infile_error,
+                                   (void*) &part);
+  int error= mysql_query(mysql, sql_statement);
+  if (part.end)
+    mysql_set_local_infile_default(mysql);
+  if (error)
   {
     db_error_with_table(mysql, tablename);
-    DBUG_RETURN(1);
+    return 1;
   }
   if (!silent)
   {
@@ -706,36 +818,183 @@ static int handle_one_table(const table_load_params *params, MYSQL *mysql)
     if (info) /* If NULL-pointer, print nothing */
       fprintf(stdout, "%s.%s: %s\n", db, tablename, info);
   }
+  return 0;
+}
+
+/** What is known about a table after its .sql file was executed */
+struct table_load_state
+{
+  char tablename[FN_REFLEN];
+  const char *db;
+  std::string full_tablename;
+  bool tz_utc= false;
+  std::string engine;
+  std::vector<std::string> triggers;
+};
+
+/**
+  Create the table from its .sql file and prepare it for loading the data
+
+  @param params  table to load
+  @param mysql   connection
+  @param state   filled with what the data loading needs
+
+  @return 0 on success
+*/
+static int prepare_table(const table_load_params *params, MYSQL *mysql,
+                         table_load_state *state)
+{
+  char sql_statement[FN_REFLEN*16+256];
+  DBUG_ENTER("prepare_table");
+  DBUG_PRINT("enter",("datafile: %s",params->data_file.c_str()));
+
+  if (aborting)
+    return 1;
+  if (verbose && !params->sql_file.empty())
+  {
+    fprintf(stdout, "Executing SQL script %s\n", params->sql_file.c_str());
+  }
+
+  if (!params->dbname.empty())
+  {
+    if (mysql_select_db(mysql, params->dbname.c_str()))
+    {
+      if (create_db_if_not_exists(mysql, params->dbname.c_str()))
+        DBUG_RETURN(1);
+      if (mysql_select_db(mysql, params->dbname.c_str()))
+          db_error(mysql);
+    }
+  }
+
+  const char *filename= params->data_file.c_str();
+  if (!filename[0])
+    filename= params->sql_file.c_str();
+
+  fn_format(state->tablename, filename, "", "", 1 | 2); /* removes path & ext. */
 
+  state->db= current_db ? current_db : params->dbname.c_str();
+  state->full_tablename= quote_identifier(state->db);
+  state->full_tablename+= ".";
+  state->full_tablename+= quote_identifier(state->tablename);
+
+  if (!params->sql_file.empty())
+  {
+    std::string sql_text= parse_sql_script(params->sql_file.c_str(),
+                                           &state->tz_utc, &state->triggers,
+                                           &state->engine);
+    if (execute_sql_batch(mysql, sql_text.c_str(),params->sql_file.c_str()))
+      DBUG_RETURN(1);
+    if (params->data_file.empty())
+    {
+      /*
+        We only use .sql extension for VIEWs, so we're done
+        with this file, there is no data to load.
+      */
+      DBUG_RETURN(0);
+    }
+    if (exec_sql(mysql, std::string("ALTER TABLE ") + state->full_tablename + " DISABLE KEYS"))
+      DBUG_RETURN(1);
+  }
+  if (opt_delete)
+  {
+    if (verbose)
+      fprintf(stdout, "Deleting the old data from table %s\n",
+              state->tablename);
+    snprintf(sql_statement, FN_REFLEN * 16 + 256, "DELETE FROM %s",
+             state->full_tablename.c_str());
+    if (exec_sql(mysql, sql_statement))
+      DBUG_RETURN(1);
+  }
+  DBUG_RETURN(0);
+}
+
+/**
+  Load a piece of the data of a table. The session settings are
+  made here, because the pieces may be loaded by different connections.
+
+  @return 0 on success
+*/
+static int load_table_part(MYSQL *mysql, const table_load_state &state,
+                           const load_part &part)
+{
+  if (aborting)
+    return 1;
+  if (exec_sql(mysql, "SET collation_database=binary"))
+    return 1;
+  if (state.tz_utc && exec_sql(mysql, "SET TIME_ZONE='+00:00';"))
+    return 1;
+  if (load_data_file(mysql, part, state.db, state.tablename,
+                     state.full_tablename))
+    return 1;
+  if (state.tz_utc && exec_sql(mysql, "SET TIME_ZONE=@save_tz;"))
+    return 1;
+  return 0;
+}
+
+/**
+  Create the triggers and enable the keys after all data was loaded
+
+  @return 0 on success
+*/
+static int finish_table(const table_load_params *params, MYSQL *mysql,
+                        const table_load_state &state)
+{
   /* Create triggers after loading data */
-  for (const auto &trigger: triggers)
+  for (const auto &trigger: state.triggers)
   {
     if (mysql_query(mysql,trigger.c_str()))
     {
-      db_error_with_table(mysql, tablename);
-      DBUG_RETURN(1);
+      db_error_with_table(mysql, state.tablename);
+      return 1;
     }
   }
 
   if (!params->sql_file.empty())
   {
-    if (exec_sql(mysql, std::string("ALTER TABLE ") + full_tablename + " ENABLE KEYS;"))
-        DBUG_RETURN(1);
+    if (exec_sql(mysql, std::string("ALTER TABLE ") + state.full_tablename + " ENABLE KEYS;"))
+        return 1;
 
-    if (engine == "MyISAM" || engine == "Aria")
+    if (state.engine == "MyISAM" || state.engine == "Aria")
     {
       /* Avoid "table was not properly closed" warnings */
-      if (exec_sql(mysql, std::string("FLUSH TABLE ").append(full_tablename).c_str()))
-        DBUG_RETURN(1);
+      if (exec_sql(mysql, std::string("FLUSH TABLE ").append(state.full_tablename).c_str()))
+        return 1;
     }
   }
+  return 0;
+}
 
-  if (tz_utc)
-  {
-    if (exec_sql(mysql, "SET TIME_ZONE=@save_tz;"))
-      DBUG_RETURN(1);
-  }
-  DBUG_RETURN(0);
+/**
+  Collect the pieces of the data of a table
+
+  @param params  table to load
+  @param split   whether large files may be divided
+  @param parts   the data files, or ranges of them
+*/
+static void table_load_parts(const table_load_params *params, bool split,
+                             std::vector<load_part> &parts)
+{
+  if (params->data_file.empty())
+    return;
+  add_load_parts(params->data_file, split, parts);
+  for (const auto &chunk_file: params->chunk_files)
+    add_load_parts(chunk_file, split, parts);
+}
+
+static int handle_one_table(const table_load_params *params, MYSQL *mysql)
+{
+  table_load_state state;
+  std::vector<load_part> parts;
+  table_load_parts(params, false, parts);
+
+  if (prepare_table(params, mysql, &state))
+    return 1;
+  if (parts.empty())
+    return 0;
+  for (const auto &part: parts)
+    if (load_table_part(mysql, state, part))
+      return 1;
+  return finish_table(params, mysql, state);
 }
 
 
@@ -880,7 +1139,7 @@ static void safe_exit(int error, MYSQL *mysql)
 
 
 
-static void db_error_with_table(MYSQL *mysql, char *table)
+static void db_error_with_table(MYSQL *mysql, const char *table)
 {
   if (aborting)
     return;
@@ -971,11 +1230,68 @@ void set_exitcode(int code)
 static thread_local MYSQL *thread_local_mysql;
 
 
+/**
+  A table that is loaded on the thread pool. After the table was created,
+  its pieces are submitted as separate tasks, and the task that loads the
+  last piece creates the triggers and enables the keys.
+*/
+struct table_job
+{
+  const table_load_params *params;
+  table_load_state state;
+  std::vector<load_part> parts;
+  tpool::task prepare_task;
+  std::vector<tpool::task> part_tasks;
+  /** index of the next piece to load */
+  std::atomic<size_t> next_part{0};
+  /** number of pieces that are not loaded yet */
+  std::atomic<size_t> pending_parts{0};
+  std::atomic<bool> failed{false};
+};
+
+static std::mutex table_jobs_mutex;
+static std::condition_variable table_jobs_cv;
+static size_t table_jobs_pending;
+
+static void table_job_done()
+{
+  std::unique_lock<std::mutex> lk(table_jobs_mutex);
+  if (!--table_jobs_pending)
+    table_jobs_cv.notify_all();
+}
+
+static void load_table_part_task(void *arg)
+{
+  table_job *job= static_cast<table_job*>(arg);
+  const load_part &part= job->parts[job->next_part++];
+  int error;
+  if (!job->failed &&
+      (error= load_table_part(thread_local_mysql, job->state, part)))
+  {
+    job->failed= true;
+    set_exitcode(error);
+  }
+  if (--job->pending_parts)
+    return;
+  if (!job->failed &&
+      (error= finish_table(job->params, thread_local_mysql, job->state)))
+    set_exitcode(error);
+  table_job_done();
+}
+
 void load_single_table(void *arg)
 {
+  table_job *job= static_cast<table_job*>(arg);
   int error;
-  if((error= handle_one_table((const table_load_params *) arg, thread_local_mysql)))
+  if ((error= prepare_table(job->params, thread_local_mysql, &job->state)))
     set_exitcode(error);
+  else if (!job->parts.empty())
+  {
+    for (auto &t: job->part_tasks)
+      thread_pool->submit_task(&t);
+    return;
+  }
+  table_job_done();
 }
 
 static void init_tp_connections(size_t n)
@@ -1023,11 +1339,49 @@ static void tpool_thread_exit(void)
   mysql_thread_end();
 }
 
+/**
+  Check whether a file is a chunk of table data, written by
+  mariadb-dump --chunk-rows as <table>.<n>.txt next to <table>.sql
+
+  @param dir   directory of the file
+  @param name  file name
+
+  @return length of <table> in name, or 0 if it is not a chunk
+*/
+static size_t chunk_base_length(const std::string &dir, const char *name)
+{
+  if (!has_extension(name, ".txt"))
+    return 0;
+  size_t len= strlen(name) - 4;
+  size_t dot= len;
+  while (dot > 0 && my_isdigit(&my_charset_latin1, name[dot - 1]))
+    dot--;
+  if (dot == len || dot < 2 || name[dot - 1] != '.')
+    return 0;
+  /* A table whose name ends with .<n> has its own .sql file */
+  std::string path= dir + "/" + std::string(name, len) + ".sql";
+  if (!access(path.c_str(), F_OK))
+    return 0;
+  path= dir + "/" + std::string(name, dot - 1) + ".sql";
+  if (access(path.c_str(), F_OK))
+    return 0;
+  return dot - 1;
+}
+
+struct chunk_file
+{
+  std::string data_file; /* the first data file of the table */
+  ulonglong number;
+  std::string file;
+  ulonglong size;
+};
+
 /**
   Get files to load, for --dir case
   Enumerates all files in the subdirectories, and returns only *.txt files
   (table data files),  or .sql files,  there is no corresponding .txt file
-  (view definitions)
+  (view definitions). The chunks of table data are attached to the
+  load parameters of their table.
 
   @param dir - directory to scan
   @param files - vector to store the files
@@ -1078,16 +1432,21 @@ static void scan_backup_dir(const char *dir,
       fatal_error("Can't read directory %s , error %d", subdir.c_str(), errno);
       return;
     }
+    std::vector<chunk_file> chunks;
+    const size_t first_file= files.size();
     for (size_t j= 0; j < dir_info2->number_of_files; j++)
     {
       table_load_params par;
       par.dbname= dbname;
       fi= &dir_info2->dir_entry[j];
+      const size_t chunk_base= chunk_base_length(subdir, fi->name);
       if (has_extension(fi->name, ".sql") || has_extension(fi->name, ".txt"))
       {
         std::string full_table_name=
             std::string(dbname) + "." + std::string(fi->name);
-        full_table_name.resize(full_table_name.size() - 4);
+        full_table_name.resize(strlen(dbname) + 1 +
+                               (chunk_base ? chunk_base
+                                           : strlen(fi->name) - 4));
         if (ignore_tables.find(full_table_name) != ignore_tables.end())
         {
           continue;
@@ -1106,7 +1465,17 @@ static void scan_backup_dir(const char *dir,
       if (!MY_S_ISDIR(fi->mystat->st_mode))
       {
         /* test file*/
-        if (has_extension(fi->name, ".txt"))
+        if (chunk_base)
+        {
+          chunk_file chunk;
+          chunk.data_file= subdir + "/" + std::string(fi->name, chunk_base) +
+                           ".txt";
+          chunk.number= strtoull(fi->name + chunk_base + 1, NULL, 10);
+          chunk.file= file;
+          chunk.size= fi->mystat->st_size;
+          chunks.push_back(chunk);
+        }
+        else if (has_extension(fi->name, ".txt"))
         {
           par.data_file= file;
           par.size= fi->mystat->st_size;
@@ -1138,6 +1507,27 @@ static void scan_backup_dir(const char *dir,
       }
     }
     my_dirend(dir_info2);
+
+    std::sort(chunks.begin(), chunks.end(),
+              [](const chunk_file &a, const chunk_file &b) -> bool
+              {
+                if (a.data_file != b.data_file)
+                  return a.data_file < b.data_file;
+                return a.number < b.number;
+              });
+    for (const auto &chunk: chunks)
+    {
+      auto it= std::find_if(files.begin() + first_file, files.end(),
+                            [&chunk](const table_load_params &f) -> bool
+                            { return f.data_file == chunk.data_file; });
+      if (it == files.end())
+      {
+        fatal_error("Expected file '%s' is missing", chunk.data_file.c_str());
+        continue;
+      }
+      it->chunk_files.push_back(chunk.file);
+      it->size+= chunk.size;
+    }
   }
   my_dirend(dir_info);
 
@@ -1211,12 +1601,30 @@ int main(int argc, char **argv)
     thread_pool= tpool::create_thread_pool_generic(opt_use_threads,opt_use_threads);
     thread_pool->set_thread_callbacks(tpool_thread_init,tpool_thread_exit);
 
-    std::vector<tpool::task> all_tasks;
+    const bool split= opt_split_size && !lines_terminated && !escaped &&
+      !enclosed && !opt_enclosed && opt_ignore_lines <= 0;
+    std::vector<std::unique_ptr<table_job>> all_jobs;
     for (const auto &f: files_to_load)
-      all_tasks.push_back(tpool::task(load_single_table, (void *)&f));
+    {
+      table_job *job= new table_job;
+      all_jobs.emplace_back(job);
+      job->params= &f;
+      table_load_parts(&f, split, job->parts);
+      job->pending_parts= job->parts.size();
+      job->prepare_task= tpool::task(load_single_table, job);
+      job->part_tasks.assign(job->parts.size(),
+                             tpool::task(load_table_part_task, job));
+    }
 
-    for (auto &t: all_tasks)
-      thread_pool->submit_task(&t);
+    table_jobs_pending= all_jobs.size();
+    for (auto &job: all_jobs)
+      thread_pool->submit_task(&job->prepare_task);
+
+    {
+      std::unique_lock<std::mutex> lk(table_jobs_mutex);
+      while (table_jobs_pending)
+        table_jobs_cv.wait(lk);
+    }
 
     delete thread_pool;
     close_tp_connections();
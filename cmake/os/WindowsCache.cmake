@@ -117,6 +117,7 @@ SET(HAVE_PAM_APPL_H CACHE INTERNAL "")
 SET(HAVE_POLL_H CACHE  INTERNAL "")
 SET(HAVE_POPEN CACHE  INTERNAL "")
 SET(HAVE_POLL CACHE INTERNAL "")
+SET(HAVE_POSIX_FADVISE CACHE  INTERNAL "")
 SET(HAVE_POSIX_FALLOCATE CACHE  INTERNAL "")
 SET(HAVE_POSIX_SIGNALS CACHE  INTERNAL "")
 SET(HAVE_PREAD CACHE  INTERNAL "")
@@ -1809,7 +1809,7 @@ copy_back()
 			MB_METADATA_FILENAME,
 			XTRABACKUP_BINLOG_INFO,
 			XTRABACKUP_METADATA_FILENAME,
-			".qp", ".pmap", ".tmp",
+			".qp", ".zst", ".pmap", ".tmp",
 			NULL};
 		const char *filename;
 		char c_tmp;
@@ -1937,6 +1937,12 @@ decrypt_decompress_file(const char *filepath, uint thread_n)
  		}
  		message << "decompressing";
  		needs_action = true;
+ 	} else if (opt_decompress
+ 		   && ends_with(filepath, ".zst")) {
+ 		cmd << " | zstd -dcq ";
+ 		dest_filepath[strlen(dest_filepath) - 4] = 0;
+ 		message << "decompressing";
+ 		needs_action = true;
  	}
 
  	cmd << " > " << dest_filepath;
@@ -1977,7 +1983,8 @@ static void decrypt_decompress_thread_func(datadir_thread_ctxt_t *ctxt)
 			continue;
 		}
 
-		if (!ends_with(node.filepath, ".qp")) {
+		if (!ends_with(node.filepath, ".qp")
+		    && !ends_with(node.filepath, ".zst")) {
 			continue;
 		}
 
@@ -28,6 +28,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1335  USA
 #include "ds_stdout.h"
 #include "ds_tmpfile.h"
 #include "ds_buffer.h"
+#include "ds_zstd.h"
 
 /************************************************************************
 Create a datasink of the specified type */
@@ -61,6 +62,11 @@ ds_create(const char *root, ds_type_t type)
 	case DS_TYPE_BUFFER:
 		ds = &datasink_buffer;
 		break;
+#ifdef HAVE_ZSTD
+	case DS_TYPE_ZSTD:
+		ds = &datasink_zstd;
+		break;
+#endif
 	default:
 		msg("Unknown datasink type: %d", type);
 		xb_ad(0);
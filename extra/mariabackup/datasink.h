@@ -103,7 +103,8 @@ typedef enum {
 	DS_TYPE_ENCRYPT,
 	DS_TYPE_DECRYPT,
 	DS_TYPE_TMPFILE,
-	DS_TYPE_BUFFER
+	DS_TYPE_BUFFER,
+	DS_TYPE_ZSTD
 } ds_type_t;
 
 /************************************************************************
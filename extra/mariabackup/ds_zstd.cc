@@ -0,0 +1,208 @@
+/******************************************************
+Copyright (c) 2026, MariaDB plc.
+
+Zstandard compressing datasink implementation for mariabackup.
+
+Every file is compressed by its own streaming context in the thread that
+writes the file, so that the copy threads compress in parallel. The
+output is a regular .zst file that can be decompressed with zstd -d.
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; version 2 of the License.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1335  USA
+
+*******************************************************/
+
+#include <my_global.h>
+#include <my_base.h>
+#include <zstd.h>
+#include "common.h"
+#include "datasink.h"
+#include "ds_zstd.h"
+
+typedef struct {
+	ds_file_t		*dest_file;
+	ZSTD_CCtx		*cctx;
+	char			*out;
+	size_t			out_size;
+} ds_zstd_file_t;
+
+/* Compression options */
+extern uint		xtrabackup_compress_threads;
+extern int		xtrabackup_compress_level;
+
+static ds_ctxt_t *zstd_init(const char *root);
+static ds_file_t *zstd_open(ds_ctxt_t *ctxt, const char *path,
+			    const MY_STAT *mystat, bool rewrite);
+static int zstd_write(ds_file_t *file, const uchar *buf, size_t len);
+static int zstd_close(ds_file_t *file);
+static void zstd_deinit(ds_ctxt_t *ctxt);
+
+datasink_t datasink_zstd = {
+	&zstd_init,
+	&zstd_open,
+	&zstd_write,
+	nullptr,
+	&zstd_close,
+	&dummy_remove,
+	nullptr,
+	nullptr,
+	&zstd_deinit
+};
+
+static
+ds_ctxt_t *
+zstd_init(const char *root)
+{
+	ds_ctxt_t	*ctxt;
+
+	ctxt = (ds_ctxt_t *) my_malloc(PSI_NOT_INSTRUMENTED,
+				       sizeof(ds_ctxt_t), MYF(MY_FAE));
+	ctxt->ptr = NULL;
+	ctxt->root = my_strdup(PSI_NOT_INSTRUMENTED, root, MYF(MY_FAE));
+
+	return ctxt;
+}
+
+static
+ds_file_t *
+zstd_open(ds_ctxt_t *ctxt, const char *path,
+	  const MY_STAT *mystat, bool rewrite)
+{
+	DBUG_ASSERT(rewrite == false);
+	ds_file_t		*dest_file;
+	char			new_name[FN_REFLEN];
+	ds_file_t		*file;
+	ds_zstd_file_t		*zstd_file;
+	ZSTD_CCtx		*cctx;
+
+	xb_ad(ctxt->pipe_ctxt != NULL);
+
+	cctx = ZSTD_createCCtx();
+	if (cctx == NULL) {
+		msg("zstd: ZSTD_createCCtx() failed.");
+		return NULL;
+	}
+
+	ZSTD_CCtx_setParameter(cctx, ZSTD_c_compressionLevel,
+			       xtrabackup_compress_level);
+	ZSTD_CCtx_setParameter(cctx, ZSTD_c_checksumFlag, 1);
+	if (xtrabackup_compress_threads > 1) {
+		/* This fails if the library was built without
+		multithreading; then the file is compressed by the calling
+		thread only. */
+		ZSTD_CCtx_setParameter(cctx, ZSTD_c_nbWorkers,
+				       int(xtrabackup_compress_threads));
+	}
+
+	/* Append the .zst extension to the filename */
+	fn_format(new_name, path, "", ".zst", MYF(MY_APPEND_EXT));
+
+	dest_file = ds_open(ctxt->pipe_ctxt, new_name, mystat);
+	if (dest_file == NULL) {
+		ZSTD_freeCCtx(cctx);
+		return NULL;
+	}
+
+	file = (ds_file_t *) my_malloc(PSI_NOT_INSTRUMENTED,
+				       sizeof(ds_file_t) +
+				       sizeof(ds_zstd_file_t),
+				       MYF(MY_FAE));
+	zstd_file = (ds_zstd_file_t *) (file + 1);
+	zstd_file->dest_file = dest_file;
+	zstd_file->cctx = cctx;
+	zstd_file->out_size = ZSTD_CStreamOutSize();
+	zstd_file->out = (char *) my_malloc(PSI_NOT_INSTRUMENTED,
+					    zstd_file->out_size,
+					    MYF(MY_FAE));
+
+	file->ptr = zstd_file;
+	file->path = dest_file->path;
+
+	return file;
+}
+
+/************************************************************************
+Feed data to the compressor and write out what it produced.
+@return 0 on success, 1 on error */
+static
+int
+zstd_compress(ds_zstd_file_t *zstd_file, const uchar *buf, size_t len,
+	      ZSTD_EndDirective directive)
+{
+	ZSTD_inBuffer	in = {buf, len, 0};
+
+	for (;;) {
+		ZSTD_outBuffer	out = {zstd_file->out,
+				       zstd_file->out_size, 0};
+		size_t		remaining = ZSTD_compressStream2(
+			zstd_file->cctx, &out, &in, directive);
+
+		if (ZSTD_isError(remaining)) {
+			msg("zstd: compression failed: %s",
+			    ZSTD_getErrorName(remaining));
+			return 1;
+		}
+
+		if (out.pos && ds_write(zstd_file->dest_file,
+					zstd_file->out, out.pos)) {
+			msg("zstd: write to the destination stream "
+			    "failed.");
+			return 1;
+		}
+
+		if (directive == ZSTD_e_end
+		    ? remaining == 0 : in.pos == in.size) {
+			return 0;
+		}
+	}
+}
+
+static
+int
+zstd_write(ds_file_t *file, const uchar *buf, size_t len)
+{
+	return zstd_compress((ds_zstd_file_t *) file->ptr, buf, len,
+			     ZSTD_e_continue);
+}
+
+static
+int
+zstd_close(ds_file_t *file)
+{
+	ds_zstd_file_t	*zstd_file;
+	int		rc;
+
+	zstd_file = (ds_zstd_file_t *) file->ptr;
+
+	rc = zstd_compress(zstd_file, NULL, 0, ZSTD_e_end);
+
+	if (ds_close(zstd_file->dest_file)) {
+		rc = 1;
+	}
+
+	ZSTD_freeCCtx(zstd_file->cctx);
+	my_free(zstd_file->out);
+	my_free(file);
+
+	return rc;
+}
+
+static
+void
+zstd_deinit(ds_ctxt_t *ctxt)
+{
+	xb_ad(ctxt->pipe_ctxt != NULL);
+
+	my_free(ctxt->root);
+	my_free(ctxt);
+}
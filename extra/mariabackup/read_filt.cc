@@ -26,6 +26,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1335  USA
 #include "common.h"
 #include "fil_cur.h"
 #include "xtrabackup.h"
+#include <algorithm>
 
 /****************************************************************//**
 Perform read filter context initialization that is common to all read
@@ -39,6 +40,8 @@ rf_pass_through_init(
 	ctxt->offset = 0;
 	ctxt->data_file_size = cursor->statinfo.st_size;
 	ctxt->buffer_capacity = cursor->buf_size;
+	ctxt->page_size = cursor->page_size;
+	ctxt->page = ctxt->page_end = NULL;
 }
 
 /****************************************************************//**
@@ -71,3 +74,103 @@ xb_read_filt_t rf_pass_through = {
 	&rf_pass_through_init,
 	&rf_pass_through_get_next_batch,
 };
+
+/****************************************************************//**
+Initialize the changed page read filter. The system and undo tablespaces,
+whose page numbers do not match the file offsets or whose files may be
+shrunk, and the tablespaces that were written outside the buffer pool
+are read in full.  */
+static
+void
+rf_changed_pages_init(
+	xb_read_filt_ctxt_t*	ctxt,	/*!<in/out: read filter context */
+	const xb_fil_cur_t*	cursor)	/*!<in: file cursor */
+{
+	rf_pass_through_init(ctxt, cursor);
+
+	if (cursor->is_system()) {
+		return;
+	}
+
+	const page_id_t* first = changed_pages.data();
+	const page_id_t* last = first + changed_pages.size();
+	first = std::lower_bound(first, last,
+				 page_id_t(cursor->space_id, 0));
+	last = std::upper_bound(first, last,
+				page_id_t(cursor->space_id, FIL_NULL));
+
+	if (first != last && last[-1].page_no() == FIL_NULL) {
+		return;
+	}
+
+	ctxt->page = first;
+	ctxt->page_end = last;
+}
+
+/****************************************************************//**
+Get the next run of consecutive changed pages. Page 0 is always read,
+because it carries the size of the tablespace.  */
+static
+void
+rf_changed_pages_get_next_batch(
+	xb_read_filt_ctxt_t*	ctxt,			/*!<in/out: read filter
+							context */
+	int64_t*		read_batch_start,	/*!<out: starting read
+							offset in bytes for the
+							next batch of pages */
+	int64_t*		read_batch_len)		/*!<out: length in
+							bytes of the next batch
+							of pages */
+{
+	if (!ctxt->page) {
+		rf_pass_through_get_next_batch(ctxt, read_batch_start,
+					       read_batch_len);
+		return;
+	}
+
+	const int64_t	page_size = int64_t(ctxt->page_size);
+	const int64_t	max_len = int64_t(ctxt->buffer_capacity)
+		/ page_size * page_size;
+	int64_t		start = ctxt->offset;
+
+	while (ctxt->page != ctxt->page_end
+	       && ctxt->page->page_no() * page_size < start) {
+		ctxt->page++;
+	}
+
+	if (start) {
+		if (ctxt->page == ctxt->page_end) {
+			*read_batch_start = start;
+			*read_batch_len = 0;
+			return;
+		}
+		start = ctxt->page->page_no() * page_size;
+	}
+
+	int64_t	end = start + page_size;
+
+	while (ctxt->page != ctxt->page_end && end - start < max_len) {
+		const int64_t offset = ctxt->page->page_no() * page_size;
+		if (offset > end) {
+			break;
+		}
+		if (offset == end) {
+			end += page_size;
+		}
+		ctxt->page++;
+	}
+
+	if (end > ctxt->data_file_size) {
+		end = ctxt->data_file_size;
+	}
+
+	*read_batch_start = start;
+	*read_batch_len = end > start ? end - start : 0;
+	ctxt->offset = end;
+}
+
+/* The changed page read filter */
+xb_read_filt_t rf_changed_pages = {
+	&rf_changed_pages_init,
+	&rf_changed_pages_get_next_batch,
+};
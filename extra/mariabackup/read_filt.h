@@ -29,12 +29,17 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1335  USA
 #include <cstddef>
 
 struct xb_fil_cur_t;
+class page_id_t;
 
 /* The read filter context */
 struct xb_read_filt_ctxt_t {
 	int64_t		offset;		/*!< current file offset */
 	int64_t		data_file_size;	/*!< data file size */
 	size_t		buffer_capacity;/*!< read buffer capacity */
+	size_t		page_size;	/*!< physical page size */
+	const page_id_t*	page;	/*!< next changed page, or NULL
+					to read all pages */
+	const page_id_t*	page_end;/*!< end of the changed pages */
 };
 
 /* The read filter */
@@ -47,5 +52,6 @@ struct xb_read_filt_t {
 };
 
 extern xb_read_filt_t rf_pass_through;
+extern xb_read_filt_t rf_changed_pages;
 
 #endif
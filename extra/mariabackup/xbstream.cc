@@ -45,6 +45,7 @@ datasink_t datasink_archive;
 datasink_t datasink_xbstream;
 datasink_t datasink_compress;
 datasink_t datasink_tmpfile;
+datasink_t datasink_zstd;
 
 static run_mode_t	opt_mode;
 static char *		opt_directory = NULL;
@@ -28,6 +28,11 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1335  USA
 /* Group writes smaller than this into a single chunk */
 #define XB_STREAM_MIN_CHUNK_SIZE (10 * 1024 * 1024)
 
+/* Chunk magic + flags + chunk type + path_len + path + len + offset +
+checksum */
+#define XB_STREAM_CHUNK_HEADER_MAX (sizeof(XB_STREAM_CHUNK_MAGIC) - 1 + \
+				    1 + 1 + 4 + FN_REFLEN + 8 + 8 + 4)
+
 struct xb_wstream_struct {
 	pthread_mutex_t	mutex;
 	xb_stream_write_callback *write;
@@ -38,6 +43,9 @@ struct xb_wstream_file_struct {
 	xb_wstream_t	*stream;
 	char		*path;
 	size_t		path_len;
+	/* room for the header of the chunk, so that a buffered chunk is
+	written to the stream at once */
+	char		chunk_header[XB_STREAM_CHUNK_HEADER_MAX];
 	char		chunk[XB_STREAM_MIN_CHUNK_SIZE];
 	char		*chunk_ptr;
 	size_t		chunk_free;
@@ -45,6 +53,11 @@ struct xb_wstream_file_struct {
   bool rewrite;
 };
 
+static_assert(offsetof(xb_wstream_file_struct, chunk)
+	      == offsetof(xb_wstream_file_struct, chunk_header)
+	      + XB_STREAM_CHUNK_HEADER_MAX,
+	      "the chunk header must precede the chunk");
+
 static int xb_stream_flush(xb_wstream_file_t *file);
 static int xb_stream_write_chunk(xb_wstream_file_t *file,
 				 const void *buf, size_t len);
@@ -190,13 +203,11 @@ static
 int
 xb_stream_write_chunk(xb_wstream_file_t *file, const void *buf, size_t len)
 {
-	/* Chunk magic + flags + chunk type + path_len + path + len + offset +
-	checksum */
-	uchar		tmpbuf[sizeof(XB_STREAM_CHUNK_MAGIC) - 1 + 1 + 1 + 4 +
-			       FN_REFLEN + 8 + 8 + 4];
+	uchar		tmpbuf[XB_STREAM_CHUNK_HEADER_MAX];
 	uchar		*ptr;
 	xb_wstream_t	*stream = file->stream;
 	ulong		checksum;
+	size_t		header_len;
 
 	/* Write xbstream header */
 	ptr = tmpbuf;
@@ -221,8 +232,7 @@ xb_stream_write_chunk(xb_wstream_file_t *file, const void *buf, size_t len)
 
 	checksum = my_checksum(0, buf, len);
 
-	pthread_mutex_lock(&stream->mutex);
-
+	/* The offset is only changed by the thread that writes the file */
 	int8store(ptr, file->offset);            /* Payload offset */
 	ptr += 8;
 
@@ -230,18 +240,31 @@ xb_stream_write_chunk(xb_wstream_file_t *file, const void *buf, size_t len)
 	ptr += 4;
 
 	xb_ad(ptr <= tmpbuf + sizeof(tmpbuf));
+	header_len = ptr - tmpbuf;
+
+	if (buf == file->chunk) {
+		/* Put the header in front of the buffered payload */
+		ptr = (uchar *) file->chunk - header_len;
+		memcpy(ptr, tmpbuf, header_len);
+
+		pthread_mutex_lock(&stream->mutex);
+		if (stream->write(stream->user_data, ptr,
+				  header_len + len) == -1)
+			goto err;
+	} else {
+		pthread_mutex_lock(&stream->mutex);
+		if (stream->write(stream->user_data, tmpbuf,
+				  header_len) == -1)
+			goto err;
+
+		if (stream->write(stream->user_data, buf, len) == -1)
+			goto err;                /* Payload */
+	}
 
-	if (stream->write(stream->user_data, tmpbuf, ptr-tmpbuf) == -1)
-		goto err;
-
-
-	if (stream->write(stream->user_data, buf, len) == -1) /* Payload */
-		goto err;
+	pthread_mutex_unlock(&stream->mutex);
 
 	file->offset+= len;
 
-	pthread_mutex_unlock(&stream->mutex);
-
 	return 0;
 
 err:
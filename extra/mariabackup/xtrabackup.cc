@@ -81,6 +81,7 @@ Street, Fifth Floor, Boston, MA 02110-1335 USA
 #include "trx0sys.h"
 #include <buf0dblwr.h>
 #include <buf0flu.h>
+#include <buf0track.h>
 #include "ha_innodb.h"
 #include "fts0types.h"
 
@@ -100,6 +101,7 @@ Street, Fifth Floor, Boston, MA 02110-1335 USA
 #include "write_filt.h"
 #include "ds_buffer.h"
 #include "ds_tmpfile.h"
+#include "ds_zstd.h"
 #include "xbstream.h"
 #include "read_filt.h"
 #include "backup_wsrep.h"
@@ -160,6 +162,8 @@ static mysql_cond_t log_copying_stop;
 
 char *xtrabackup_incremental;
 lsn_t incremental_lsn;
+std::vector<page_id_t> changed_pages;
+bool changed_pages_valid;
 lsn_t incremental_to_lsn;
 lsn_t incremental_last_lsn;
 
@@ -218,6 +222,7 @@ const char *xtrabackup_compress_alg = NULL;
 uint xtrabackup_compress = FALSE;
 uint xtrabackup_compress_threads;
 ulonglong xtrabackup_compress_chunk_size = 0;
+int xtrabackup_compress_level;
 
 /* sleep interval beetween log copy iterations in log copying thread
 in milliseconds (default is 1 second) */
@@ -1300,6 +1305,7 @@ enum options_xtrabackup
   OPT_XTRA_COMPRESS,
   OPT_XTRA_COMPRESS_THREADS,
   OPT_XTRA_COMPRESS_CHUNK_SIZE,
+  OPT_XTRA_COMPRESS_LEVEL,
   OPT_LOG,
   OPT_INNODB,
   OPT_INNODB_DATA_FILE_PATH,
@@ -1320,6 +1326,7 @@ enum options_xtrabackup
   OPT_INNODB_IO_CAPACITY,
   OPT_INNODB_READ_IO_THREADS,
   OPT_INNODB_WRITE_IO_THREADS,
+  OPT_INNODB_RECOVERY_APPLY_THREADS,
   OPT_INNODB_USE_NATIVE_AIO,
   OPT_INNODB_PAGE_SIZE,
   OPT_INNODB_BUFFER_POOL_FILENAME,
@@ -1493,16 +1500,16 @@ struct my_option xb_client_options[]= {
 
     {"compress", OPT_XTRA_COMPRESS,
      "Compress individual backup files using the "
-     "specified compression algorithm. It uses no longer maintained QuickLZ "
-     "library hence this option was deprecated with MariaDB 10.1.31 and 10.2.13.",
+     "specified compression algorithm: quicklz (the default) or zstd. "
+     "quicklz uses the no longer maintained QuickLZ library and was "
+     "deprecated with MariaDB 10.1.31 and 10.2.13.",
      (G_PTR *) &xtrabackup_compress_alg, (G_PTR *) &xtrabackup_compress_alg, 0,
      GET_STR, OPT_ARG, 0, 0, 0, 0, 0, 0},
 
     {"compress-threads", OPT_XTRA_COMPRESS_THREADS,
      "Number of threads for parallel data compression. The default value is "
-     "1. "
-     "This option was deprecated as it relies on the no longer "
-     "maintained QuickLZ library.",
+     "1. With --compress=zstd, this is the number of threads that compress "
+     "each file, in addition to the threads that copy the files.",
      (G_PTR *) &xtrabackup_compress_threads,
      (G_PTR *) &xtrabackup_compress_threads, 0, GET_UINT, REQUIRED_ARG, 1, 1,
      UINT_MAX, 0, 0, 0},
@@ -1516,6 +1523,12 @@ struct my_option xb_client_options[]= {
      (G_PTR *) &xtrabackup_compress_chunk_size, 0, GET_ULL, REQUIRED_ARG,
      (1 << 16), 1024, ULONGLONG_MAX, 0, 0, 0},
 
+    {"compress-level", OPT_XTRA_COMPRESS_LEVEL,
+     "Compression level for --compress=zstd.",
+     (G_PTR *) &xtrabackup_compress_level,
+     (G_PTR *) &xtrabackup_compress_level, 0, GET_INT, REQUIRED_ARG,
+     3, 1, 22, 0, 0, 0},
+
     {"incremental-force-scan", OPT_XTRA_INCREMENTAL_FORCE_SCAN,
      "Perform a full-scan incremental backup even in the presence of changed "
      "page bitmap data",
@@ -1622,10 +1635,9 @@ struct my_option xb_client_options[]= {
      NO_ARG, 0, 0, 0, 0, 0, 0},
 
     {"decompress", OPT_DECOMPRESS,
-     "Decompresses all files with the .qp "
+     "Decompresses all files with the .qp or .zst "
      "extension in a backup previously made with the --compress option. "
-     "This option was deprecated as it relies on the no longer "
-     "maintained QuickLZ library.",
+     "The qpress or zstd utility must be installed.",
      (uchar *) &opt_decompress, (uchar *) &opt_decompress, 0, GET_BOOL, NO_ARG,
      0, 0, 0, 0, 0, 0},
 
@@ -1693,7 +1705,7 @@ struct my_option xb_client_options[]= {
      0, 0, 0, 0},
 
     {"remove-original", OPT_REMOVE_ORIGINAL,
-     "Remove .qp files after decompression.", (uchar *) &opt_remove_original,
+     "Remove .qp and .zst files after decompression.", (uchar *) &opt_remove_original,
      (uchar *) &opt_remove_original, 0, GET_BOOL, NO_ARG, 0, 0, 0, 0, 0, 0},
 
     {"ftwrl-wait-query-type", OPT_LOCK_WAIT_QUERY_TYPE,
@@ -1874,6 +1886,12 @@ struct my_option xb_server_options[] =
    "Number of background write I/O threads in InnoDB.", (G_PTR*) &innobase_write_io_threads,
    (G_PTR*) &innobase_write_io_threads, 0, GET_LONG, REQUIRED_ARG, 4, 1, 64, 0,
    1, 0},
+  {"innodb_recovery_apply_threads", OPT_INNODB_RECOVERY_APPLY_THREADS,
+   "Maximum number of threads that apply redo log records to pages"
+   " during --prepare (0=number of processors).",
+   (G_PTR*) &srv_n_recovery_apply_threads,
+   (G_PTR*) &srv_n_recovery_apply_threads, 0, GET_UINT, REQUIRED_ARG,
+   0, 0, 256, 0, 1, 0},
   {"innodb_file_per_table", OPT_INNODB_FILE_PER_TABLE,
    "Stores each InnoDB table to an .ibd file in the database dir.",
    (G_PTR*) &srv_file_per_table,
@@ -2315,6 +2333,10 @@ xb_get_one_option(const struct my_option *opt,
   case OPT_XTRA_COMPRESS:
     if (argument == NULL)
       xtrabackup_compress_alg = "quicklz";
+#ifdef HAVE_ZSTD
+    else if (!strcasecmp(argument, "zstd"))
+      xtrabackup_compress_alg = "zstd";
+#endif
     else if (strcasecmp(argument, "quicklz"))
     {
       msg("Invalid --compress argument: %s", argument);
@@ -2503,6 +2525,9 @@ static bool innodb_init_param()
 
 	srv_n_read_io_threads = (uint) innobase_read_io_threads;
 	srv_n_write_io_threads = (uint) innobase_write_io_threads;
+	if (!srv_n_recovery_apply_threads) {
+		srv_n_recovery_apply_threads = std::min(uint(my_getncpus()), 256U);
+	}
 
 	srv_max_n_open_files = ULINT_UNDEFINED - 5;
 
@@ -3283,7 +3308,8 @@ static my_bool xtrabackup_copy_datafile(ds_ctxt *ds_data,
 		goto skip;
 	}
 
-	read_filter = &rf_pass_through;
+	read_filter = changed_pages_valid && &write_filter == &wf_incremental
+		? &rf_changed_pages : &rf_pass_through;
 
 	res = xb_fil_cur_open(&cursor, read_filter, node, thread_n, ULLONG_MAX);
 	if (res == XB_FIL_CUR_SKIP) {
@@ -3824,12 +3850,15 @@ void Backup_datasinks::init()
 			m_redo = m_data = ds;
 		}
 
-		ds = ds_create(xtrabackup_target_dir, DS_TYPE_COMPRESS);
+		const ds_type_t type =
+			strcasecmp(xtrabackup_compress_alg, "zstd")
+			? DS_TYPE_COMPRESS : DS_TYPE_ZSTD;
+		ds = ds_create(xtrabackup_target_dir, type);
 		add_datasink_to_destroy(ds);
 		ds_set_pipe(ds, m_data);
 		if (m_data != m_redo) {
 			m_data = ds;
-			ds = ds_create(xtrabackup_target_dir, DS_TYPE_COMPRESS);
+			ds = ds_create(xtrabackup_target_dir, type);
 			add_datasink_to_destroy(ds);
 			ds_set_pipe(ds, m_redo);
 			m_redo = ds;
@@ -5271,6 +5300,15 @@ class BackupStages {
 				return false;
 			}
 
+			// Transactional Aria tables are still written while the
+			// offline tables are being copied. Copy that log now, so that
+			// only the log of the last transactions is left for
+			// BLOCK_COMMIT.
+			if (!m_aria_backup.copy_log_tail()) {
+				msg("Error on Aria log tail copy");
+				return false;
+			}
+
 			ddl_log::backup(fil_path_to_mysql_datadir,
 			                backup_datasinks.m_data, m_tables);
 
@@ -5285,6 +5323,7 @@ class BackupStages {
 				msg("Error on BACKUP STAGE BLOCK_COMMIT query execution");
 				return false;
 			}
+			m_block_commit_start = my_interval_timer();
 
 			// Copy log tables tail
 			if (!m_common_backup.copy_log_tables(true) ||
@@ -5392,6 +5431,9 @@ class BackupStages {
 			if (!opt_no_lock) {
 				unlock_all(m_bs_con);
 				history_lock_time = 0;
+				msg("BACKUP STAGE BLOCK_COMMIT was held for %llu ms",
+				    (my_interval_timer() - m_block_commit_start)
+				    / 1000000);
 			} else {
 				history_lock_time = time(NULL) - history_lock_time;
 			}
@@ -5427,6 +5469,8 @@ class BackupStages {
 		aria::Backup m_aria_backup;
 		common_engine::Backup m_common_backup;
 		std::unordered_set<table_key_t> m_copied_common_tables;
+		/** when BACKUP STAGE BLOCK_COMMIT was acquired */
+		ulonglong m_block_commit_start = 0;
 };
 
 /** Implement --backup
@@ -5583,6 +5627,20 @@ static bool xtrabackup_backup_func()
 		std::thread(io_watching_thread).detach();
 	}
 
+	/* Each checkpoint is preceded by a record of the written pages.
+	If the records reach back to incremental_lsn, pages that are not
+	in them do not need to be read. */
+	if (xtrabackup_incremental && !xtrabackup_incremental_force_scan) {
+		changed_pages_valid = buf_track_t::read(
+			incremental_lsn, log_sys.next_checkpoint_lsn,
+			changed_pages);
+		if (changed_pages_valid) {
+			msg("Reading only the changed pages after LSN " LSN_PF
+			    " from %s", incremental_lsn,
+			    buf_track_t::FILE_NAME);
+		}
+	}
+
 	/* Populate fil_system with tablespaces to copy */
 	if (dberr_t err = xb_load_tablespaces()) {
 		msg("merror: xb_load_tablespaces() failed with"
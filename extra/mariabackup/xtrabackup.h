@@ -93,6 +93,10 @@ extern uint		opt_protocol;
 
 extern char		*xtrabackup_incremental;
 extern my_bool		xtrabackup_incremental_force_scan;
+/* pages written after incremental_lsn, from ib_changed_pages */
+extern std::vector<page_id_t>	changed_pages;
+/* whether changed_pages covers all pages written after incremental_lsn */
+extern bool		changed_pages_valid;
 
 extern lsn_t		metadata_to_lsn;
 
@@ -109,6 +109,19 @@ typedef struct st_heap_block
 
 struct st_heap_info;			/* For reference */
 
+/*
+  A blob column. The record only holds packlength bytes of length and a
+  pointer, the data itself is in a separate allocation owned by the table.
+*/
+
+typedef struct st_hp_blob_desc
+{
+  uint offset;				/* Position of the blob in record */
+  uint packlength;			/* Length of the blob length */
+  uint null_pos;
+  uint8 null_bit;			/* 0 if the blob can't be null */
+} HP_BLOB_DESC;
+
 typedef struct st_hp_keydef		/* Key definition with open */
 {
   uint flag;				/* HA_NOSAME | HA_NULL_PART_KEY */
@@ -158,6 +171,8 @@ typedef struct st_heap_share
   LIST open_list;
   uint auto_key;
   uint auto_key_type;			/* real type of the auto key segment */
+  uint blobs;				/* Number of blob columns */
+  HP_BLOB_DESC *blob_descs;
 } HP_SHARE;
 
 struct st_hp_hash_info;
@@ -173,6 +188,7 @@ typedef struct st_heap_info
   uint opt_flag,update;
   uchar *lastkey;			/* Last used key with rkey */
   uchar *recbuf;                         /* Record buffer for rb-tree keys */
+  uchar **blob_data;                    /* Blob copies for write/update */
   enum ha_rkey_function last_find_flag;
   TREE_ELEMENT *parents[MAX_TREE_HEIGHT+1];
   TREE_ELEMENT **last_pos;
@@ -192,6 +208,8 @@ typedef struct st_heap_create_info
   uint auto_key_type;
   uint keys;
   uint reclength;
+  uint blobs;
+  HP_BLOB_DESC *blob_descs;
   ulong max_records;
   ulong min_records;
   ulonglong max_table_size;
@@ -429,6 +429,12 @@ int json_get_path_start(json_engine_t *je, CHARSET_INFO *i_cs,
 
 int json_get_path_next(json_engine_t *je, json_path_t *p);
 
+/*
+  Same as json_get_path_next(), but don't return the paths inside
+  the object or array json_get_path_next() stopped at.
+*/
+int json_skip_path_next(json_engine_t *je, json_path_t *p);
+
 int json_path_compare(const json_path_t *a, const json_path_t *b,
                       enum json_value_types vt, const int* array_size_counter);
 
@@ -147,6 +147,7 @@ typedef struct st_key_cache
   ulonglong param_block_size;    /* size of the blocks in the key cache      */
   ulonglong param_division_limit;/* min. percentage of warm blocks           */
   ulonglong param_age_threshold; /* determines when hot block is downgraded  */
+  ulonglong param_scan_resistance; /* 1 if first hits don't age hot blocks */
   ulonglong param_partitions;    /* number of the key cache partitions       */
   ulonglong changed_blocks_hash_size; /* number of hash buckets for changed files */
   my_bool key_cache_inited;      /* <=> key cache has been created           */
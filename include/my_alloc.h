@@ -60,6 +60,19 @@ typedef struct st_mem_root
   PSI_memory_key psi_key;
 } MEM_ROOT;
 
+/*
+  Freed blocks of thread specific memory roots, by size class, kept for
+  reuse by the next roots. See set_root_block_cache().
+*/
+#define ROOT_BLOCK_CACHE_CLASSES 8
+
+typedef struct st_root_block_cache
+{
+  USED_MEM *blocks[ROOT_BLOCK_CACHE_CLASSES];
+  size_t size;                     /* total size of the cached blocks */
+  size_t max_size;                 /* don't cache more than this */
+} ROOT_BLOCK_CACHE;
+
 typedef struct st_mem_root_savepoint
 {
   MEM_ROOT *root;
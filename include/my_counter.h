@@ -46,4 +46,73 @@ template <typename Type> class Atomic_counter
   Type operator=(const Type val)
   { m_counter.store(val, std::memory_order_relaxed); return val; }
 };
+
+
+/**
+  @return a small number that identifies the calling thread, for picking
+  a shard of a Sharded_counter. Numbers are handed out round-robin on the
+  first call in each thread, so concurrently active threads tend to use
+  different shards.
+*/
+inline unsigned my_counter_shard_index()
+{
+  static std::atomic<unsigned> next_index;
+  static thread_local unsigned index=
+    next_index.fetch_add(1, std::memory_order_relaxed);
+  return index;
+}
+
+
+/**
+  Counter that is frequently updated from many threads and rarely read.
+
+  Every shard occupies its own cache line, and a thread always updates the
+  same shard, so that concurrent updates do not contend for one cache line.
+  Reading the value has to sum up all shards; the result is exact only if
+  there are no concurrent updates.
+
+  @tparam Type  integer type
+  @tparam N     number of shards
+*/
+template <typename Type, unsigned N= 64> class Sharded_counter
+{
+  struct alignas(CPU_LEVEL1_DCACHE_LINESIZE) shard
+  {
+    std::atomic<Type> value;
+  };
+  shard m_shards[N];
+
+public:
+  Sharded_counter()
+  {
+    for (auto &s : m_shards)
+      s.value.store(0, std::memory_order_relaxed);
+  }
+
+  void add(Type i)
+  {
+    m_shards[my_counter_shard_index() % N].value.
+      fetch_add(i, std::memory_order_relaxed);
+  }
+  void operator+=(const Type i) { add(i); }
+  void operator-=(const Type i) { add(static_cast<Type>(0 - i)); }
+  void operator++() { add(1); }
+  void operator--() { add(static_cast<Type>(-1)); }
+
+  Type load() const
+  {
+    Type total= 0;
+    for (const auto &s : m_shards)
+      total+= s.value.load(std::memory_order_relaxed);
+    return total;
+  }
+  operator Type() const { return load(); }
+
+  /** Reset to 0; must not be invoked concurrently with updates */
+  void reset()
+  {
+    for (auto &s : m_shards)
+      s.value.store(0, std::memory_order_relaxed);
+  }
+};
 #endif /* MY_COUNTER_H_INCLUDED */
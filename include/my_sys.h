@@ -62,6 +62,7 @@ C_MODE_START
 #define MY_NOSYMLINKS  512U     /* my_open(): don't follow symlinks */
 #define MY_FULL_IO     512U     /* my_read(): loop until I/O is complete */
 #define MY_DONT_CHECK_FILESIZE 128U /* Option to init_io_cache() */
+#define MY_READ_AHEAD 0x200000U /* init_io_cache(): prefetch next block */
 #define MY_LINK_WARNING 32U	/* my_redel() gives warning if links */
 #define MY_COPYTIME	64U	/* my_redel() copies time */
 #define MY_DELETE_OLD	256U	/* my_create_with_symlink() */
@@ -199,9 +200,11 @@ void my_init_atomic_write(void);
 #ifdef __linux__
 my_bool my_test_if_atomic_write(File handle, int pagesize);
 my_bool my_test_if_thinly_provisioned(File handle);
+my_bool my_test_if_untorn_write(File handle, int pagesize);
 #else
 # define my_test_if_atomic_write(A, B)      0
 # define my_test_if_thinly_provisioned(A)   0
+# define my_test_if_untorn_write(A, B)      0
 #endif /* __linux__ */
 extern my_bool my_may_have_atomic_write;
 
@@ -630,6 +633,7 @@ int my_b_copy_all_to_cache(IO_CACHE *from_cache, IO_CACHE *to_cache);
 my_off_t my_b_append_tell(IO_CACHE* info);
 my_off_t my_b_safe_tell(IO_CACHE* info); /* picks the correct tell() */
 int my_b_pread(IO_CACHE *info, uchar *Buffer, size_t Count, my_off_t pos);
+void my_b_prefetch(IO_CACHE *info, my_off_t pos, size_t Count);
 
 typedef uint32 ha_checksum;
 
@@ -919,6 +923,9 @@ extern void init_alloc_root(PSI_memory_key key, MEM_ROOT *mem_root,
 extern void *alloc_root(MEM_ROOT *mem_root, size_t Size);
 extern void *multi_alloc_root(MEM_ROOT *mem_root, ...);
 extern void free_root(MEM_ROOT *root, myf MyFLAGS);
+extern size_t free_root_retain(MEM_ROOT *root, size_t retain_size);
+extern void set_root_block_cache(ROOT_BLOCK_CACHE *cache);
+extern void free_root_block_cache(ROOT_BLOCK_CACHE *cache);
 extern void move_root(MEM_ROOT *to, MEM_ROOT *from);
 extern void set_prealloc_root(MEM_ROOT *root, char *ptr);
 extern void reset_root_defaults(MEM_ROOT *mem_root, size_t block_size,
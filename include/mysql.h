@@ -191,7 +191,9 @@ enum mysql_option
   /* MariaDB options */
   MYSQL_PROGRESS_CALLBACK=5999,
   MYSQL_OPT_NONBLOCK,
-  MYSQL_OPT_USE_THREAD_SPECIFIC_MEMORY
+  MYSQL_OPT_USE_THREAD_SPECIFIC_MEMORY,
+  MYSQL_OPT_COMPRESSION_ALGORITHM,
+  MYSQL_OPT_ZSTD_COMPRESSION_LEVEL
 };
 
 /**
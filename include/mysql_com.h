@@ -292,6 +292,18 @@ enum enum_indicator_type
 /* permit sending unit result-set for BULK commands */
 #define MARIADB_CLIENT_BULK_UNIT_RESULTS (1ULL << 37)
 
+/* compressed protocol payload can be in Zstandard format */
+#define MARIADB_CLIENT_COMPRESS_ZSTD (1ULL << 38)
+
+/* compressed protocol payload can be in LZ4 format */
+#define MARIADB_CLIENT_COMPRESS_LZ4 (1ULL << 39)
+
+/*
+  client may send further commands before reading the replies to the earlier
+  ones, and accepts that the server coalesces those replies into one write
+*/
+#define MARIADB_CLIENT_PIPELINE (1ULL << 40)
+
 #ifdef HAVE_COMPRESS
 #define CAN_CLIENT_COMPRESS CLIENT_COMPRESS
 #else
@@ -333,14 +345,19 @@ enum enum_indicator_type
                            MARIADB_CLIENT_EXTENDED_METADATA|\
                            MARIADB_CLIENT_CACHE_METADATA |\
                            CLIENT_CAN_HANDLE_EXPIRED_PASSWORDS |\
-                           MARIADB_CLIENT_BULK_UNIT_RESULTS)
+                           MARIADB_CLIENT_BULK_UNIT_RESULTS |\
+                           MARIADB_CLIENT_COMPRESS_ZSTD |\
+                           MARIADB_CLIENT_COMPRESS_LZ4 |\
+                           MARIADB_CLIENT_PIPELINE)
 /*
   Switch off the flags that are optional and depending on build flags
   If any of the optional flags is supported by the build it will be switched
   on before sending to the client during the connection handshake.
 */
 #define CLIENT_BASIC_FLAGS ((CLIENT_ALL_FLAGS & ~CLIENT_SSL) \
-                                               & ~CLIENT_COMPRESS)
+                                               & ~CLIENT_COMPRESS \
+                                               & ~MARIADB_CLIENT_COMPRESS_ZSTD \
+                                               & ~MARIADB_CLIENT_COMPRESS_LZ4)
 
 enum mariadb_field_attr_t
 {
@@ -432,6 +449,19 @@ enum mariadb_field_attr_t
 struct st_vio;					/* Only C */
 typedef struct st_vio Vio;
 
+/*
+  Payload format of the compressed protocol. Anything but zlib is only
+  used if both sides announce the matching MARIADB_CLIENT_COMPRESS_* flag.
+*/
+enum enum_net_compression
+{
+  NET_COMPRESSION_ZLIB= 0,
+  NET_COMPRESSION_ZSTD= 1,
+  NET_COMPRESSION_LZ4= 2
+};
+
+#define NET_COMPRESSION_ZSTD_DEFAULT_LEVEL 3
+
 #define MAX_TINYINT_WIDTH       3       /* Max width for a TINY w.o. sign */
 #define MAX_SMALLINT_WIDTH      5       /* Max width for a SHORT w.o. sign */
 #define MAX_MEDIUMINT_WIDTH     8       /* Max width for a INT24 w.o. sign */
@@ -471,8 +501,10 @@ typedef struct st_net {
   void *thd; 	   /* Used by MariaDB server to avoid calling current_thd */
   unsigned int last_errno;
   unsigned char error; 
-  my_bool unused4; /* Please remove with the next incompatible ABI change. */
-  my_bool unused5; /* Please remove with the next incompatible ABI change. */
+  /* enum enum_net_compression; format of the compressed packet payload */
+  unsigned char compress_algorithm;
+  /* Zstandard level used for the packets that are sent */
+  unsigned char compress_level;
   /** Client library error message buffer. Actually belongs to struct MYSQL. */
   char last_error[MYSQL_ERRMSG_SIZE];
   /** Client library sqlstate buffer. Set along with the error message. */
@@ -42,6 +42,9 @@ struct st_mysql_options_extention {
   HASH connection_attributes;
   size_t connection_attributes_length;
   my_bool tls_allow_invalid_server_cert;
+  /* enum enum_net_compression requested with CLIENT_COMPRESS */
+  unsigned int compression_algorithm;
+  unsigned int zstd_compression_level;
 };
 
 typedef struct st_mysql_methods
@@ -93,7 +93,10 @@ my_bool vio_reset(Vio* vio, enum enum_vio_type type,
                   my_socket sd, void *ssl, uint flags);
 size_t	vio_read(Vio *vio, uchar *	buf, size_t size);
 size_t  vio_read_buff(Vio *vio, uchar * buf, size_t size);
+my_bool vio_enable_buffered_read(Vio *vio);
 size_t	vio_write(Vio *vio, const uchar * buf, size_t size);
+size_t	vio_write_gather(Vio *vio, const uchar *buf1, size_t size1,
+                         const uchar *buf2, size_t size2);
 int	vio_blocking(Vio *vio, my_bool onoff, my_bool *old_mode);
 my_bool	vio_is_blocking(Vio *vio);
 /* setsockopt TCP_NODELAY at IPPROTO_TCP level, when possible */
@@ -191,7 +194,8 @@ struct st_VioSSLFd
 		      const char *ca_file,const char *ca_path,
 		      const char *cipher, enum enum_ssl_init_error *error,
 		      const char *crl_file, const char *crl_path,
-		      ulonglong tls_version);
+		      ulonglong tls_version, uint session_cache_size,
+		      my_bool ktls);
 void free_vio_ssl_acceptor_fd(struct st_VioSSLFd *fd);
 #endif /* HAVE_OPENSSL */
 
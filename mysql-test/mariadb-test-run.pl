@@ -2214,6 +2214,7 @@ sub environment_setup {
   $ENV{'MYSQL_DUMP'}=               mysqldump_arguments(".1");
   $ENV{'MYSQL_DUMP_SLAVE'}=         mysqldump_arguments(".2");
   $ENV{'MYSQL_SLAP'}=               mysqlslap_arguments();
+  $ENV{'MARIADB_BENCH'}=            client_arguments("mariadb-bench");
   $ENV{'MYSQL_IMPORT'}=             client_arguments("mariadb-import");
   $ENV{'MYSQL_SHOW'}=               client_arguments("mariadb-show");
   $ENV{'MYSQL_BINLOG'}=             mysqlbinlog_arguments();
@@ -10,11 +10,14 @@ return "Not run for embedded server" if $::opt_embedded_server;
 return "No mariabackup" unless $ENV{XTRABACKUP};
 
 my $have_qpress = index(`qpress 2>&1`,"Compression") > 0;
+my $have_zstd = index(`zstd -V 2>&1`,"Zstandard") >= 0 &&
+                index(`$ENV{XTRABACKUP} --help 2>&1`,"zstd") > 0;
 
 sub skip_combinations {
   my %skip;
   $skip{'include/have_file_key_management.inc'} = 'needs file_key_management plugin'  unless $ENV{FILE_KEY_MANAGEMENT_SO};
   $skip{'compress_qpress.test'}= 'needs qpress executable in PATH' unless $have_qpress;
+  $skip{'compress_zstd.test'}= 'needs zstd support and executable in PATH' unless $have_zstd;
   %skip;
 }
 
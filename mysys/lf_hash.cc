@@ -213,9 +213,7 @@ static LF_SLIST *l_insert(LF_SLIST **head, CHARSET_INFO *cs,
   lf_unpin(pins, 2);
   /*
     Note that cursor.curr is not pinned here and the pointer is unreliable,
-    the object may disappear anytime. But if it points to a dummy node, the
-    pointer is safe, because dummy nodes are never freed - initialize_bucket()
-    uses this fact.
+    the object may disappear anytime.
   */
   return res ? 0 : cursor.curr;
 }
@@ -331,7 +329,7 @@ static inline my_hash_value_type calc_hash(CHARSET_INFO *cs,
 
 #define MAX_LOAD 1.0    /* average number of elements in a bucket */
 
-static int initialize_bucket(LF_HASH *, LF_SLIST **, uint, LF_PINS *);
+static LF_SLIST **get_bucket(LF_HASH *, uint, LF_PINS *);
 
 static void default_initializer(LF_HASH *hash, void *dst, const void *src)
 {
@@ -360,7 +358,7 @@ void lf_hash_init(LF_HASH *hash, uint element_size, uint flags,
 {
   lf_alloc_init(&hash->alloc, sizeof(LF_SLIST)+element_size,
                 offsetof(LF_SLIST, key));
-  lf_dynarray_init(&hash->array, sizeof(LF_SLIST *));
+  lf_dynarray_init(&hash->array, sizeof(LF_SLIST));
   hash->size= 1;
   hash->count= 0;
   hash->element_size= element_size;
@@ -376,18 +374,17 @@ void lf_hash_init(LF_HASH *hash, uint element_size, uint flags,
 
 void lf_hash_destroy(LF_HASH *hash)
 {
-  LF_SLIST *el, **head= (LF_SLIST **)lf_dynarray_value(&hash->array, 0);
+  LF_SLIST *el, *head= (LF_SLIST *)lf_dynarray_value(&hash->array, 0);
 
   if (head)
   {
-    el= *head;
+    el= (LF_SLIST *)head->link;
     while (el)
     {
       intptr next= el->link;
+      /* dummy nodes are freed together with the array */
       if (el->hashnr & 1)
         lf_alloc_direct_free(&hash->alloc, el); /* normal node */
-      else
-        my_free(el); /* dummy node */
       el= (LF_SLIST *)next;
     }
   }
@@ -420,11 +417,12 @@ int lf_hash_insert(LF_HASH *hash, LF_PINS *pins, const void *data)
   node->key= hash_key(hash, (uchar *)(node+1), &node->keylen);
   hashnr= hash->hash_function(hash->charset, node->key, node->keylen) & INT_MAX32;
   bucket= hashnr % hash->size;
-  el= (LF_SLIST **)lf_dynarray_lvalue(&hash->array, bucket);
+  el= get_bucket(hash, bucket, pins);
   if (unlikely(!el))
+  {
+    lf_alloc_free(pins, node);
     return -1;
-  if (*el == NULL && unlikely(initialize_bucket(hash, el, bucket, pins)))
-    return -1;
+  }
   node->hashnr= my_reverse_bits(hashnr) | 1; /* normal node */
   if (l_insert(el, hash->charset, node, pins, hash->flags))
   {
@@ -451,19 +449,14 @@ int lf_hash_insert(LF_HASH *hash, LF_PINS *pins, const void *data)
 int lf_hash_delete(LF_HASH *hash, LF_PINS *pins, const void *key, uint keylen)
 {
   LF_SLIST **el;
-  uint bucket, hashnr;
+  uint hashnr;
 
   hashnr= hash->hash_function(hash->charset, (uchar *)key, keylen) & INT_MAX32;
 
   /* hide OOM errors - if we cannot initialize a bucket, try the previous one */
-  for (bucket= hashnr % hash->size; ;bucket= my_clear_highest_bit(bucket))
-  {
-    el= (LF_SLIST **)lf_dynarray_lvalue(&hash->array, bucket);
-    if (el && (*el || initialize_bucket(hash, el, bucket, pins) == 0))
-      break;
-    if (unlikely(bucket == 0))
-      return 1; /* if there's no bucket==0, the hash is empty */
-  }
+  el= get_bucket(hash, hashnr % hash->size, pins);
+  if (unlikely(!el))
+    return 1; /* if there's no bucket==0, the hash is empty */
   if (l_delete(el, hash->charset, my_reverse_bits(hashnr) | 1,
               (uchar *)key, keylen, pins))
   {
@@ -487,17 +480,11 @@ void *lf_hash_search_using_hash_value(LF_HASH *hash, LF_PINS *pins,
                                       const void *key, uint keylen)
 {
   LF_SLIST **el, *found;
-  uint bucket;
 
   /* hide OOM errors - if we cannot initialize a bucket, try the previous one */
-  for (bucket= hashnr % hash->size; ;bucket= my_clear_highest_bit(bucket))
-  {
-    el= (LF_SLIST **)lf_dynarray_lvalue(&hash->array, bucket);
-    if (el && (*el || initialize_bucket(hash, el, bucket, pins) == 0))
-      break;
-    if (unlikely(bucket == 0))
-      return 0; /* if there's no bucket==0, the hash is empty */
-  }
+  el= get_bucket(hash, hashnr % hash->size, pins);
+  if (unlikely(!el))
+    return 0; /* if there's no bucket==0, the hash is empty */
   found= l_search(el, hash->charset, my_reverse_bits(hashnr) | 1,
                  (uchar *)key, keylen, pins);
   return found ? found+1 : 0;
@@ -518,15 +505,12 @@ int lf_hash_iterate(LF_HASH *hash, LF_PINS *pins,
                     my_hash_walk_action action, void *argument)
 {
   CURSOR cursor;
-  uint bucket= 0;
   int res;
   LF_SLIST **el;
 
-  el= (LF_SLIST **)lf_dynarray_lvalue(&hash->array, bucket);
+  el= get_bucket(hash, 0, pins);
   if (unlikely(!el))
     return 0; /* if there's no bucket==0, the hash is empty */
-  if (*el == NULL && unlikely(initialize_bucket(hash, el, bucket, pins)))
-    return 0; /* if there's no bucket==0, the hash is empty */
 
   res= l_find(el, 0, 0, (uchar*)argument, 0, &cursor, pins, action);
 
@@ -546,46 +530,91 @@ void *lf_hash_search(LF_HASH *hash, LF_PINS *pins, const void *key, uint keylen)
 }
 
 static const uchar *dummy_key= (uchar*)"";
+static const uchar *claimed_key= (uchar*)"-";
 
 /*
+  The dummy node of a bucket is stored in the bucket array itself, so
+  that a search gets from the bucket straight into the list, without
+  following a pointer to a separately allocated dummy node.
+
+  LF_SLIST::key of the dummy node tells the state of the bucket:
+  NULL (not initialized), claimed_key (being initialized by some thread)
+  or dummy_key (in the list). Only the thread that claimed the dummy node
+  inserts it into the list.
+
   RETURN
     0 - ok
-   -1 - out of memory
+   -1 - the bucket cannot be used now (out of memory, or another
+        thread is initializing it)
 */
-static int initialize_bucket(LF_HASH *hash, LF_SLIST **node,
-                              uint bucket, LF_PINS *pins)
+static int initialize_bucket(LF_HASH *hash, LF_SLIST *dummy,
+                             uint bucket, LF_PINS *pins)
 {
-  uint parent= my_clear_highest_bit(bucket);
-  LF_SLIST *dummy= (LF_SLIST *)my_malloc(key_memory_lf_slist,
-                                         sizeof(LF_SLIST), MYF(MY_WME));
-  LF_SLIST **tmp= 0, *cur;
-  LF_SLIST **el= (LF_SLIST **)lf_dynarray_lvalue(&hash->array, parent);
-  if (unlikely(!el || !dummy))
-    return -1;
-  if (*el == NULL && bucket &&
-      unlikely(initialize_bucket(hash, el, parent, pins)))
+  LF_SLIST **el;
+  const uchar *key= NULL;
+
+  if (!my_atomic_casptr((void **) &dummy->key, (void **) &key,
+                        (void *) claimed_key))
+    return key == dummy_key ? 0 : -1;
+  if (bucket)
   {
-    my_free(dummy);
-    return -1;
+    LF_SLIST *dup __attribute__((unused));
+    el= get_bucket(hash, my_clear_highest_bit(bucket), pins);
+    if (unlikely(!el))
+    {
+      my_atomic_storeptr((void **) &dummy->key, NULL);
+      return -1;
+    }
+    dummy->hashnr= my_reverse_bits(bucket) | 0; /* dummy node */
+    dummy->keylen= 0;
+    dup= l_insert(el, hash->charset, dummy, pins, LF_HASH_UNIQUE);
+    DBUG_ASSERT(!dup);
   }
-  dummy->hashnr= my_reverse_bits(bucket) | 0; /* dummy node */
-  dummy->key= dummy_key;
-  dummy->keylen= 0;
-  if ((cur= l_insert(el, hash->charset, dummy, pins, LF_HASH_UNIQUE)))
+  /* else: the dummy node of the bucket 0 is the head of the list */
+  my_atomic_storeptr_explicit((void **) &dummy->key, (void *) dummy_key,
+                              MY_MEMORY_ORDER_RELEASE);
+  return 0;
+}
+
+/*
+  Find the dummy node to start a search in the given bucket from.
+
+  If the bucket cannot be initialized right now, the search starts from
+  its parent: the list is sorted, and the dummy node of the parent
+  precedes all elements of the bucket.
+
+  RETURN
+    0 - out of memory (there is no bucket 0)
+    the dummy node, to pass as 'head' to l_find() and friends
+*/
+static LF_SLIST **get_bucket(LF_HASH *hash, uint bucket, LF_PINS *pins)
+{
+  for (;;)
   {
-    my_free(dummy);
-    dummy= cur;
+    LF_SLIST *dummy= (LF_SLIST *) lf_dynarray_lvalue(&hash->array, bucket);
+    if (likely(dummy != NULL))
+    {
+      const uchar *key=
+        (const uchar *) my_atomic_loadptr_explicit((void **) &dummy->key,
+                                                   MY_MEMORY_ORDER_ACQUIRE);
+      if (key == dummy_key ||
+          (!key && initialize_bucket(hash, dummy, bucket, pins) == 0))
+        return (LF_SLIST **) dummy;
+      if (!bucket)
+      {
+        /* there is nowhere to fall back, wait for the other thread */
+        do
+          key= (const uchar *) my_atomic_loadptr_explicit(
+                 (void **) &dummy->key, MY_MEMORY_ORDER_ACQUIRE);
+        while (key == claimed_key && LF_BACKOFF());
+        if (key == dummy_key)
+          return (LF_SLIST **) dummy;
+      }
+    }
+    if (unlikely(bucket == 0))
+      return 0;
+    bucket= my_clear_highest_bit(bucket);
   }
-  my_atomic_casptr((void **)node, (void **)(char*) &tmp, dummy);
-  /*
-    note that if the CAS above failed (after l_insert() succeeded),
-    it would mean that some other thread has executed l_insert() for
-    the same dummy node, its l_insert() failed, it picked up our
-    dummy node (in "dummy= cur") and executed the same CAS as above.
-    Which means that even if CAS above failed we don't need to retry,
-    and we should not free(dummy) - there's no memory leak here
-  */
-  return 0;
 }
 
 C_MODE_END
@@ -195,7 +195,7 @@ init_functions(IO_CACHE* info)
     use_async_io	Set to 1 of we should use async_io (if available)
     cache_myflags	Bitmap of different flags
 			MY_WME | MY_FAE | MY_NABP | MY_FNABP |
-			MY_DONT_CHECK_FILESIZE
+			MY_DONT_CHECK_FILESIZE | MY_READ_AHEAD
     file_key           Instrumented file key for temporary cache file
 
   RETURN
@@ -849,6 +849,12 @@ int _my_b_cache_read(IO_CACHE *info, uchar *Buffer, size_t Count)
   info->pos_in_file=pos_in_file;
   if (Count)
     memcpy(Buffer, info->buffer, Count);
+  /*
+    Let the next block be read while this one is consumed, so that a
+    sequential reader does not wait for the disk on every refill.
+  */
+  if ((info->myflags & MY_READ_AHEAD) && length)
+    my_b_prefetch(info, pos_in_file + length, info->read_length);
   DBUG_RETURN(0);
 }
 
@@ -235,6 +235,24 @@ int my_b_pread(IO_CACHE *info, uchar *Buffer, size_t Count, my_off_t pos)
   return 0;
 }
 
+/*
+  Tell the operating system that a part of the file will be read soon,
+  so that it can be read in the background while the caller is busy
+  with data that it already has.
+*/
+
+void my_b_prefetch(IO_CACHE *info, my_off_t pos, size_t Count)
+{
+#ifdef HAVE_POSIX_FADVISE
+  if (info->file >= 0 && Count && pos < info->end_of_file)
+    (void) posix_fadvise(info->file, (off_t) pos,
+                         (off_t) MY_MIN(Count, info->end_of_file - pos),
+                         POSIX_FADV_WILLNEED);
+#else
+  (void) info; (void) pos; (void) Count;
+#endif
+}
+
 /*
   Read a string ended by '\n' into a buffer of 'max_length' size.
   Returns number of characters read, 0 on error.
@@ -167,6 +167,7 @@ typedef struct st_simple_key_cache_cb
   size_t min_warm_blocks;        /* min number of warm blocks;               */
   size_t age_threshold;          /* age threshold for hot blocks             */
   ulonglong keycache_time;       /* total number of block link operations    */
+  my_bool scan_resistant;        /* first hits don't age hot blocks          */
   uint hash_entries;             /* max number of entries in the hash table  */
   uint changed_blocks_hash_size;	 /* Number of hash buckets for file blocks   */
   int hash_links;                /* max number of hash links                 */
@@ -311,7 +312,7 @@ struct st_block_link
   uint status;            /* state of the block                              */
   enum BLOCK_TEMPERATURE temperature; /* block temperature: cold, warm, hot */
   uint hits_left;         /* number of hits left until promotion             */
-  ulonglong last_hit_time; /* timestamp of the last hit                      */
+  ulonglong last_hit_time; /* timestamp of the last hit, 0 if none since read */
   KEYCACHE_CONDVAR *condvar; /* condition variable for 'no readers' event    */
 };
 
@@ -596,7 +597,12 @@ int init_simple_key_cache(SIMPLE_KEY_CACHE_CB *keycache,
     keycache->used_last= NULL;
     keycache->used_ins= NULL;
     keycache->free_block_list= NULL;
-    keycache->keycache_time= 0;
+    /*
+      Start at 1, because last_hit_time == 0 means that the block has not
+      been hit since it was read in (see unreg_request())
+    */
+    keycache->keycache_time= 1;
+    keycache->scan_resistant= 0;
     keycache->warm_blocks= 0;
     keycache->min_warm_blocks= (division_limit ?
 				blocks * division_limit / 100 + 1 :
@@ -1565,6 +1571,10 @@ static void reg_requests(SIMPLE_KEY_CACHE_CB *keycache,
     At the same time  the block at the very beginning of the hot subchain
     might be moved to the beginning of the warm subchain if it stays untouched
     for a too long time (this time is determined by parameter age_threshold).
+    If the key cache is scan resistant, the first hit on a block after it
+    was read in does not count as time passing for the hot blocks, like
+    the A1 queue of the 2Q algorithm. A scan that touches every block once
+    then can't push the working set out of the hot sub-chain.
 
     It is also possible that the block is selected for eviction and thus
     not linked in the LRU ring.
@@ -1586,6 +1596,7 @@ static void unreg_request(SIMPLE_KEY_CACHE_CB *keycache,
   if (!--block->requests && !(block->status & BLOCK_ERROR))
   {
     my_bool hot;
+    my_bool first_hit= !block->last_hit_time;
     if (block->hits_left)
       block->hits_left--;
     hot= !block->hits_left && at_end &&
@@ -1600,7 +1611,8 @@ static void unreg_request(SIMPLE_KEY_CACHE_CB *keycache,
     }
     link_block(keycache, block, hot, (my_bool)at_end);
     block->last_hit_time= keycache->keycache_time;
-    keycache->keycache_time++;
+    if (!first_hit || !keycache->scan_resistant)
+      keycache->keycache_time++;
     /*
       At this place, the block might be in the LRU ring or not. If an
       evicter was waiting for a block, it was selected for eviction and
@@ -5892,6 +5904,32 @@ int repartition_key_cache_internal(KEY_CACHE *keycache,
     for the control block of the key cache has been already allocated.
 */
 
+/*
+  Pass the scan resistance setting of a key cache to its control blocks
+*/
+
+static void set_key_cache_scan_resistance(KEY_CACHE *keycache)
+{
+  my_bool scan_resistant= keycache->param_scan_resistance != 0;
+  if (keycache->key_cache_type == PARTITIONED_KEY_CACHE)
+  {
+    PARTITIONED_KEY_CACHE_CB *cb=
+      (PARTITIONED_KEY_CACHE_CB *) keycache->keycache_cb;
+    uint i;
+    if (!cb->key_cache_inited || !cb->partition_array)
+      return;
+    for (i= 0; i < cb->partitions; i++)
+    {
+      if (cb->partition_array[i])
+        cb->partition_array[i]->scan_resistant= scan_resistant;
+    }
+  }
+  else
+    ((SIMPLE_KEY_CACHE_CB *) keycache->keycache_cb)->scan_resistant=
+      scan_resistant;
+}
+
+
 static
 int init_key_cache_internal(KEY_CACHE *keycache, uint key_cache_block_size,
 		            size_t use_mem, uint division_limit,
@@ -5959,7 +5997,10 @@ int init_key_cache_internal(KEY_CACHE *keycache, uint key_cache_block_size,
     ((PARTITIONED_KEY_CACHE_CB *) keycache_cb)->key_cache_mem_size :
     ((SIMPLE_KEY_CACHE_CB *) keycache_cb)->key_cache_mem_size;
   if (blocks > 0)
+  {
+    set_key_cache_scan_resistance(keycache);
     keycache->can_be_used= 1;
+  }
   if (use_op_lock)
     pthread_mutex_unlock(&keycache->op_lock);
   return blocks;
@@ -6080,6 +6121,8 @@ int resize_key_cache(KEY_CACHE *keycache, uint key_cache_block_size,
     ((PARTITIONED_KEY_CACHE_CB *)(keycache->keycache_cb))->key_cache_mem_size :
     ((SIMPLE_KEY_CACHE_CB *)(keycache->keycache_cb))->key_cache_mem_size;
 
+    if (blocks > 0)
+      set_key_cache_scan_resistance(keycache);
     keycache->can_be_used= (blocks >= 0);
     pthread_mutex_unlock(&keycache->op_lock);
   } 
@@ -6119,6 +6162,7 @@ void change_key_cache_param(KEY_CACHE *keycache, uint division_limit,
     keycache->interface_funcs->change_param(keycache->keycache_cb,
                                             division_limit,
                                             age_threshold);    
+    set_key_cache_scan_resistance(keycache);
     pthread_mutex_unlock(&keycache->op_lock);
   }
 }
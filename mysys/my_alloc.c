@@ -42,6 +42,122 @@
 #define TRASH_MEM(X) TRASH_FREE(((char*)(X) + ((X)->size-(X)->left)), (X)->left)
 
 
+/*
+  Block cache of the current thread, see set_root_block_cache().
+  Class n of the cache holds blocks of size [1K << n, 1K << (n + 1)).
+*/
+
+#define ROOT_CACHE_MIN_SHIFT 10
+/* How many blocks of a class to look at for a matching one */
+#define ROOT_CACHE_MAX_SEARCH 8
+
+#if !(defined(HAVE_valgrind) && defined(EXTRA_DEBUG))
+static MY_THREAD_LOCAL ROOT_BLOCK_CACHE *root_block_cache;
+
+static inline int root_cache_class(size_t size)
+{
+  uint cls;
+  if (size < ((size_t) 1 << ROOT_CACHE_MIN_SHIFT))
+    return -1;
+  cls= my_bit_log2_size_t(size) - ROOT_CACHE_MIN_SHIFT;
+  return cls < ROOT_BLOCK_CACHE_CLASSES ? (int) cls : -1;
+}
+
+
+/*
+  Take a block of at least 'size' bytes, freed by a root with the same
+  psi_key, from the cache. While a block is in the cache, USED_MEM::left
+  holds the psi_key.
+*/
+
+static USED_MEM *root_cache_get(ROOT_BLOCK_CACHE *cache, size_t size,
+                                PSI_memory_key key)
+{
+  int cls= root_cache_class(size), end;
+  if (cls < 0)
+    return 0;
+  /* Any block in the next class is big enough */
+  for (end= MY_MIN(cls + 2, ROOT_BLOCK_CACHE_CLASSES); cls < end; cls++)
+  {
+    USED_MEM **prev= &cache->blocks[cls], *mem;
+    uint i;
+    for (i= 0; (mem= *prev) && i < ROOT_CACHE_MAX_SEARCH;
+         i++, prev= &mem->next)
+    {
+      if (mem->size >= size && mem->left == (size_t) key)
+      {
+        *prev= mem->next;
+        cache->size-= mem->size;
+        return mem;
+      }
+    }
+  }
+  return 0;
+}
+
+
+/* Put a block of a thread specific root into the cache, if it fits */
+
+static my_bool root_cache_put(ROOT_BLOCK_CACHE *cache, MEM_ROOT *root,
+                              USED_MEM *mem, size_t size)
+{
+  int cls;
+  if (cache->size + size > cache->max_size ||
+      (cls= root_cache_class(size)) < 0)
+    return FALSE;
+  TRASH_FREE((char*) mem + ALIGN_SIZE(sizeof(USED_MEM)),
+             size - ALIGN_SIZE(sizeof(USED_MEM)));
+  mem->size= size;
+  mem->left= (size_t) root->psi_key;
+  mem->next= cache->blocks[cls];
+  cache->blocks[cls]= mem;
+  cache->size+= size;
+  return TRUE;
+}
+#endif
+
+
+/**
+  Set the block cache for the thread specific memory roots of the
+  current thread.
+
+  Blocks freed by such roots are kept in the cache (up to
+  cache->max_size bytes) and reused by the next roots, instead of going
+  through my_free() and my_malloc() again. The cached blocks stay
+  thread specific memory.
+
+  @param cache  Cache to use, or NULL for no cache. The cache must be
+                freed with free_root_block_cache() by its owner.
+*/
+
+void set_root_block_cache(ROOT_BLOCK_CACHE *cache)
+{
+#if !(defined(HAVE_valgrind) && defined(EXTRA_DEBUG))
+  /* Reused blocks would hide use of freed memory from valgrind */
+  root_block_cache= cache;
+#endif
+}
+
+
+/** Free all blocks in a ROOT_BLOCK_CACHE */
+
+void free_root_block_cache(ROOT_BLOCK_CACHE *cache)
+{
+  uint i;
+  for (i= 0; i < ROOT_BLOCK_CACHE_CLASSES; i++)
+  {
+    USED_MEM *mem, *next;
+    for (mem= cache->blocks[i]; mem; mem= next)
+    {
+      next= mem->next;
+      my_free(mem);
+    }
+    cache->blocks[i]= 0;
+  }
+  cache->size= 0;
+}
+
+
 /*
   Alloc memory through either my_malloc or mmap()
 */
@@ -50,6 +166,18 @@ static void *root_alloc(MEM_ROOT *root, size_t size, size_t *alloced_size,
 			myf my_flags)
 {
   *alloced_size= size;
+#if !(defined(HAVE_valgrind) && defined(EXTRA_DEBUG))
+  if ((root->flags & ROOT_FLAG_THREAD_SPECIFIC) && root_block_cache &&
+      root_block_cache->size)
+  {
+    USED_MEM *mem= root_cache_get(root_block_cache, size, root->psi_key);
+    if (mem)
+    {
+      *alloced_size= mem->size;
+      return mem;
+    }
+  }
+#endif
 #if defined(HAVE_MMAP) && defined(HAVE_MPROTECT) && defined(MAP_ANONYMOUS)
   if (root->flags & ROOT_FLAG_MPROTECT)
   {
@@ -69,6 +197,11 @@ static void *root_alloc(MEM_ROOT *root, size_t size, size_t *alloced_size,
 
 static void root_free(MEM_ROOT *root, void *ptr, size_t size)
 {
+#if !(defined(HAVE_valgrind) && defined(EXTRA_DEBUG))
+  if ((root->flags & ROOT_FLAG_THREAD_SPECIFIC) && root_block_cache &&
+      root_cache_put(root_block_cache, root, (USED_MEM*) ptr, size))
+    return;
+#endif
 #if defined(HAVE_MMAP) && defined(HAVE_MPROTECT) && defined(MAP_ANONYMOUS)
   if (root->flags & ROOT_FLAG_MPROTECT)
     my_munmap(ptr, size);
@@ -521,6 +654,76 @@ void free_root(MEM_ROOT *root, myf MyFlags)
 }
 
 
+/*
+  Deallocate everything used by alloc_root, but keep the preallocated
+  block and some other blocks for reuse
+
+  SYNOPSIS
+    free_root_retain()
+      root		Memory root
+      retain_size	Max total size of blocks to keep, not counting
+			the preallocated block
+
+  NOTES
+    Works as free_root(root, MYF(MY_KEEP_PREALLOC)), except that blocks
+    fitting into retain_size are moved to the free list instead of being
+    freed. This saves malloc()/free() calls for roots that are freed and
+    filled again over and over, like the root of a connection.
+
+  RETURN
+    Total size of the kept blocks, not counting the preallocated block
+*/
+
+size_t free_root_retain(MEM_ROOT *root, size_t retain_size)
+{
+  USED_MEM *next, *old, *kept= 0;
+  USED_MEM *lists[2];
+  size_t kept_size= 0;
+  uint i;
+  DBUG_ENTER("free_root_retain");
+  DBUG_PRINT("enter",("root: %p  retain_size: %zu", root, retain_size));
+
+#if defined(HAVE_valgrind) && defined(EXTRA_DEBUG)
+  /* Kept blocks would hide use of freed memory from valgrind */
+  retain_size= 0;
+#endif
+
+  lists[0]= root->used;
+  lists[1]= root->free;
+  for (i= 0; i < 2; i++)
+  {
+    for (next= lists[i]; next ;)
+    {
+      old= next; next= next->next;
+      if (old == root->pre_alloc)
+        continue;
+      if (old->size <= retain_size - kept_size)
+      {
+        kept_size+= old->size;
+        old->left= old->size - ALIGN_SIZE(sizeof(USED_MEM));
+        TRASH_MEM(old);
+        old->next= kept;
+        kept= old;
+      }
+      else
+        root_free(root, old, old->size);
+    }
+  }
+  root->used= 0;
+  root->free= kept;
+  if (root->pre_alloc)
+  {
+    root->pre_alloc->left= root->pre_alloc->size-ALIGN_SIZE(sizeof(USED_MEM));
+    TRASH_MEM(root->pre_alloc);
+    root->pre_alloc->next= kept;
+    root->free= root->pre_alloc;
+  }
+  root->block_num= 4;
+  root->first_block_usage= 0;
+  DBUG_RETURN(kept_size);
+}
+
+
 /*
   Find block that contains an object and set the pre_alloc to it
 */
@@ -24,6 +24,8 @@ my_bool has_shannon_atomic_write, has_fusion_io_atomic_write,
 my_bool has_sfx_card;
 
 #include <sys/ioctl.h>
+#include <sys/stat.h>
+#include <fcntl.h>
 
 /* Linux seems to allow up to 15 partitions per block device.
 Partition number 0 is the whole block device. */
@@ -429,6 +431,54 @@ static my_bool sfx_could_disable_punch_hole(File file)
   return 0;
 }
 
+/***********************************************************************
+  Linux untorn writes (statx STATX_WRITE_ATOMIC, pwritev2 RWF_ATOMIC)
+************************************************************************/
+
+#ifdef STATX_WRITE_ATOMIC
+/**
+  Check if writes of page_size bytes to a file can be submitted
+  with RWF_ATOMIC. The kernel only supports this for O_DIRECT.
+
+  @return TRUE   Writes of page_size with RWF_ATOMIC will not be torn
+*/
+
+static my_bool statx_has_atomic_write(File file, int page_size)
+{
+  struct statx stx;
+  int flags= fcntl(file, F_GETFL);
+
+  if (flags == -1 || !(flags & O_DIRECT))
+    return 0;
+  if (statx(file, "", AT_EMPTY_PATH, STATX_WRITE_ATOMIC, &stx) ||
+      !(stx.stx_mask & STATX_WRITE_ATOMIC) ||
+      !(stx.stx_attributes & STATX_ATTR_WRITE_ATOMIC))
+    return 0;
+  return stx.stx_atomic_write_unit_min <= (uint) page_size &&
+    stx.stx_atomic_write_unit_max >= (uint) page_size;
+}
+#endif
+
+/**
+  Check if a file supports untorn writes that must be requested
+  with RWF_ATOMIC (see my_test_if_atomic_write() for devices
+  where every aligned write of a page is atomic)
+
+  @return FALSE   No untorn write support
+          TRUE    Writes of page_size bytes with RWF_ATOMIC are untorn
+*/
+
+my_bool my_test_if_untorn_write(File handle, int page_size)
+{
+#ifdef STATX_WRITE_ATOMIC
+  return statx_has_atomic_write(handle, page_size);
+#else
+  (void) handle;
+  (void) page_size;
+  return 0;
+#endif
+}
+
 /***********************************************************************
   Generic atomic write code
 ************************************************************************/
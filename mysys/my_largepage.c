@@ -283,6 +283,9 @@ MAP_ANON but MAP_ANONYMOUS is marked "for compatibility" */
 #else
 #error unsupported mmap - no MAP_ANON{YMOUS}
 #endif
+
+/** Minimum mapping size that is advised to use transparent huge pages */
+#define MY_TRANSPARENT_HUGE_PAGE_MIN (2U << 20)
 #endif /* HAVE_MMAP && !_WIN32 */
 
 /**
@@ -290,6 +293,15 @@ MAP_ANON but MAP_ANONYMOUS is marked "for compatibility" */
   Tries to allocate memory from large pages pool and falls back to
   my_malloc_lock() in case of failure.
   Every implementation returns a zero filled buffer here.
+
+  This is meant for long-lived big buffers (caches, log buffers, hash
+  tables). If explicit large pages are not enabled or not available, a
+  mapping of at least 2MiB is marked eligible for transparent huge pages,
+  which reduces TLB misses on randomly accessed hash arrays when the kernel
+  is configured with transparent_hugepage=madvise.
+
+  @param size   requested size; on return, the size that must be passed
+                to my_large_free()
 */
 uchar *my_large_malloc(size_t *size, myf my_flags)
 {
@@ -406,6 +418,10 @@ uchar *my_large_malloc(size_t *size, myf my_flags)
         */
         *size= aligned_size;
       }
+#if defined(HAVE_MADVISE) && defined(MADV_HUGEPAGE)
+      else if (aligned_size >= MY_TRANSPARENT_HUGE_PAGE_MIN)
+        madvise(ptr, aligned_size, MADV_HUGEPAGE);
+#endif
       break;
     }
     if (large_page_size == 0)
@@ -48,7 +48,8 @@ extern PSI_mutex_key key_BITMAP_mutex, key_IO_CACHE_append_buffer_lock,
   key_THR_LOCK_lock, key_THR_LOCK_malloc,
   key_THR_LOCK_mutex, key_THR_LOCK_myisam, key_THR_LOCK_net,
   key_THR_LOCK_open, key_THR_LOCK_threads, key_LOCK_uuid_generator,
-  key_TMPDIR_mutex, key_THR_LOCK_myisam_mmap, key_LOCK_timer;
+  key_TMPDIR_mutex, key_THR_LOCK_myisam_mmap, key_LOCK_timer,
+  key_LOCK_timer_partition;
 
 extern PSI_cond_key key_COND_timer, key_IO_CACHE_SHARE_cond,
   key_IO_CACHE_SHARE_cond_writer, key_my_thread_var_suspend,
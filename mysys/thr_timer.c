@@ -23,16 +23,44 @@
 #include "thr_timer.h"
 #include <m_string.h>
 #include <queues.h>
+#include <my_atomic.h>
 #ifdef HAVE_TIMER_CREATE
 #include <sys/syscall.h>
 #endif
 
-struct timespec next_timer_expire_time;
+/*
+  Timers are spread over several partitions, each with its own mutex and
+  priority queue, so that connections arming and removing their statement
+  timers do not all serialize on one mutex. The partition of a timer is
+  given by its address, so a timer always stays in the same partition.
+
+  LOCK_timer and COND_timer are only used by the timer thread to wait for
+  the next timeout, and by thr_timer_settime() when it has to wake up the
+  timer thread because the new timer expires before anything else.
+*/
+
+#define TIMER_PARTITIONS 8
+
+typedef struct st_timer_partition
+{
+  mysql_mutex_t lock;
+  QUEUE queue;
+  /* Dummy element with max time, to simplify usage */
+  thr_timer_t max_timer_data;
+  char pad[CPU_LEVEL1_DCACHE_LINESIZE];
+} TIMER_PARTITION;
+
+static TIMER_PARTITION timer_partitions[TIMER_PARTITIONS];
+
+/*
+  Time (in nanoseconds) the timer thread is sleeping until, or 0 while
+  the timer thread is looking at the partitions.
+*/
+static int64 volatile next_timer_expire;
 
 static my_bool thr_timer_inited= 0;
 static mysql_mutex_t LOCK_timer;
 static mysql_cond_t  COND_timer;
-static QUEUE timer_queue;
 pthread_t timer_thread;
 
 #if SIZEOF_VOIDP == 4
@@ -47,6 +75,17 @@ pthread_t timer_thread;
 
 static void *timer_handler(void *arg __attribute__((unused)));
 
+static inline TIMER_PARTITION *timer_partition(thr_timer_t *timer_data)
+{
+  ulonglong hash= (ulonglong) (size_t) timer_data * 0x9E3779B97F4A7C15ULL;
+  return &timer_partitions[(hash >> 32) % TIMER_PARTITIONS];
+}
+
+static inline int64 timespec_to_nsec(const struct timespec *ts)
+{
+  return (int64) ts->MY_tv_sec * 1000000000LL + ts->MY_tv_nsec;
+}
+
 /*
   Compare two timespecs
 */
@@ -68,25 +107,42 @@ static int compare_timespec(void *not_used __attribute__((unused)),
   @return 1 error; Can't create thread
 */
 
-static thr_timer_t max_timer_data;
+static void end_timer_partitions(void)
+{
+  uint i;
+  for (i= 0; i < TIMER_PARTITIONS; i++)
+  {
+    mysql_mutex_destroy(&timer_partitions[i].lock);
+    delete_queue(&timer_partitions[i].queue);
+  }
+}
 
 my_bool init_thr_timer(uint alloc_timers)
 {
   pthread_attr_t thr_attr;
   my_bool res= 0;
+  uint i;
   DBUG_ENTER("init_thr_timer");
 
-  init_queue(&timer_queue, alloc_timers+2, offsetof(thr_timer_t,expire_time),
-             0, compare_timespec, NullS,
-             offsetof(thr_timer_t, index_in_queue)+1, 1);
+  for (i= 0; i < TIMER_PARTITIONS; i++)
+  {
+    TIMER_PARTITION *part= &timer_partitions[i];
+    init_queue(&part->queue, alloc_timers / TIMER_PARTITIONS + 2,
+               offsetof(thr_timer_t,expire_time),
+               0, compare_timespec, NullS,
+               offsetof(thr_timer_t, index_in_queue)+1, 16);
+    mysql_mutex_init(key_LOCK_timer_partition, &part->lock,
+                     MY_MUTEX_INIT_FAST);
+
+    /* Set dummy element with max time into the queue to simplify usage */
+    bzero(&part->max_timer_data, sizeof(part->max_timer_data));
+    set_max_time(&part->max_timer_data.expire_time);
+    queue_insert(&part->queue, (uchar*) &part->max_timer_data);
+  }
   mysql_mutex_init(key_LOCK_timer, &LOCK_timer, MY_MUTEX_INIT_FAST);
   mysql_cond_init(key_COND_timer, &COND_timer, NULL);
-
-  /* Set dummy element with max time into the queue to simplify usage */
-  bzero(&max_timer_data, sizeof(max_timer_data));
-  set_max_time(&max_timer_data.expire_time);
-  queue_insert(&timer_queue, (uchar*) &max_timer_data);
-  next_timer_expire_time= max_timer_data.expire_time;
+  next_timer_expire=
+    timespec_to_nsec(&timer_partitions[0].max_timer_data.expire_time);
 
   /* Create a thread to handle timers */
   pthread_attr_init(&thr_attr);
@@ -100,7 +156,7 @@ my_bool init_thr_timer(uint alloc_timers)
     res= 1;
     mysql_mutex_destroy(&LOCK_timer);
     mysql_cond_destroy(&COND_timer);
-    delete_queue(&timer_queue);
+    end_timer_partitions();
   }
   pthread_attr_destroy(&thr_attr);
 
@@ -123,7 +179,7 @@ void end_thr_timer(void)
 
   mysql_mutex_destroy(&LOCK_timer);
   mysql_cond_destroy(&COND_timer);
-  delete_queue(&timer_queue);
+  end_timer_partitions();
   DBUG_VOID_RETURN;
 }
 
@@ -178,7 +234,8 @@ void thr_timer_set_period(thr_timer_t* timer_data, ulonglong micro_seconds)
 
 my_bool thr_timer_settime(thr_timer_t *timer_data, ulonglong micro_seconds)
 {
-  int reschedule;
+  TIMER_PARTITION *part= timer_partition(timer_data);
+  int64 expire, next_expire;
   DBUG_ENTER("thr_timer_settime");
   DBUG_PRINT("enter",("thread: %s  micro_seconds: %llu",my_thread_name(),
                       micro_seconds));
@@ -186,28 +243,39 @@ my_bool thr_timer_settime(thr_timer_t *timer_data, ulonglong micro_seconds)
   DBUG_ASSERT(timer_data->expired == 1);
 
   set_timespec_nsec(timer_data->expire_time, micro_seconds*1000);
+  expire= timespec_to_nsec(&timer_data->expire_time);
   timer_data->expired= 0;
 
-  mysql_mutex_lock(&LOCK_timer);        /* Lock from threads & timers */
-  if (queue_insert_safe(&timer_queue,(uchar*) timer_data))
+  mysql_mutex_lock(&part->lock);        /* Lock from threads & timers */
+  if (queue_insert_safe(&part->queue,(uchar*) timer_data))
   {
     DBUG_PRINT("info", ("timer queue full"));
     fprintf(stderr,"Warning: thr_timer queue is full\n");
     timer_data->expired= 1;
-    mysql_mutex_unlock(&LOCK_timer);
+    mysql_mutex_unlock(&part->lock);
     DBUG_RETURN(1);
   }    
-
-  /* Reschedule timer if the current one has more time left than new one */
-  reschedule= cmp_timespec(next_timer_expire_time, timer_data->expire_time);
-  mysql_mutex_unlock(&LOCK_timer);
-  if (reschedule > 0)
+  mysql_mutex_unlock(&part->lock);
+
+  /*
+    Reschedule timer if the current one has more time left than new one,
+    or if the timer thread is just now looking at the partitions (it may
+    already have passed this one).
+  */
+  next_expire= my_atomic_load64(&next_timer_expire);
+  if (!next_expire || next_expire > expire)
   {
 #if defined(MAIN)
   printf("reschedule\n"); fflush(stdout);
 #endif
     DBUG_PRINT("info", ("reschedule"));
+    /*
+      Taking LOCK_timer ensures that the timer thread is waiting on
+      COND_timer, so that the signal is not lost.
+    */
+    mysql_mutex_lock(&LOCK_timer);
     mysql_cond_signal(&COND_timer);
+    mysql_mutex_unlock(&LOCK_timer);
   }
 
   DBUG_RETURN(0);
@@ -222,19 +290,20 @@ my_bool thr_timer_settime(thr_timer_t *timer_data, ulonglong micro_seconds)
 
 void thr_timer_end(thr_timer_t *timer_data)
 {
+  TIMER_PARTITION *part= timer_partition(timer_data);
   DBUG_ENTER("thr_timer_end");
 
-  mysql_mutex_lock(&LOCK_timer);
+  mysql_mutex_lock(&part->lock);
   if (!timer_data->expired)
   {
     DBUG_ASSERT(timer_data->index_in_queue != 0);
-    DBUG_ASSERT(queue_element(&timer_queue, timer_data->index_in_queue) ==
+    DBUG_ASSERT(queue_element(&part->queue, timer_data->index_in_queue) ==
                 (uchar*) timer_data);
-    queue_remove(&timer_queue, timer_data->index_in_queue);
+    queue_remove(&part->queue, timer_data->index_in_queue);
     /* Mark as expired for asserts to work */
     timer_data->expired= 1;
   }
-  mysql_mutex_unlock(&LOCK_timer);
+  mysql_mutex_unlock(&part->lock);
   DBUG_VOID_RETURN;
 }
 
@@ -243,11 +312,12 @@ void thr_timer_end(thr_timer_t *timer_data)
   Come here when some timer in queue is due.
 */
 
-static sig_handler process_timers(struct timespec *now)
+static sig_handler process_timers(TIMER_PARTITION *part,
+                                  struct timespec *now)
 {
   thr_timer_t *timer_data;
   DBUG_ENTER("process_timers");
-  DBUG_PRINT("info",("active timers: %d", timer_queue.elements - 1));
+  DBUG_PRINT("info",("active timers: %d", part->queue.elements - 1));
 
 #if defined(MAIN)
   printf("process_timer\n"); fflush(stdout);
@@ -260,7 +330,7 @@ static sig_handler process_timers(struct timespec *now)
     void *func_arg;
     my_bool is_periodic;
 
-    timer_data= (thr_timer_t*) queue_top(&timer_queue);
+    timer_data= (thr_timer_t*) queue_top(&part->queue);
     function=   timer_data->func;
     func_arg=   timer_data->func_arg;
     is_periodic= timer_data->period != 0;
@@ -273,7 +343,7 @@ static sig_handler process_timers(struct timespec *now)
       for periodic timers, they need to be removed from
       queue prior to destroying timer_data.
     */
-    queue_remove_top(&timer_queue);		/* Remove timer */
+    queue_remove_top(&part->queue);		/* Remove timer */
     (*function)(func_arg);                      /* Inform thread of timeout */
 
     /*
@@ -284,11 +354,11 @@ static sig_handler process_timers(struct timespec *now)
     {
       set_timespec_nsec(timer_data->expire_time, timer_data->period * 1000);
       timer_data->expired= 0;
-      queue_insert(&timer_queue, (uchar*)timer_data);
+      queue_insert(&part->queue, (uchar*)timer_data);
     }
 
     /* Check if next one has also expired */
-    timer_data= (thr_timer_t*) queue_top(&timer_queue);
+    timer_data= (thr_timer_t*) queue_top(&part->queue);
     if (cmp_timespec(timer_data->expire_time, (*now)) > 0)
       break;                                    /* All data processed */
   }
@@ -310,21 +380,33 @@ static void *timer_handler(void *arg __attribute__((unused)))
   while (likely(thr_timer_inited))
   {
     int error;
-    struct timespec *top_time;
+    uint i;
     struct timespec now, abstime;
 
     set_timespec(now, 0);
 
-    top_time= &(((thr_timer_t*) queue_top(&timer_queue))->expire_time);
-
-    if (cmp_timespec((*top_time), now) <= 0)
+    /* Make thr_timer_settime() signal us while we look at the partitions */
+    my_atomic_store64(&next_timer_expire, 0);
+    set_max_time(&abstime);
+    for (i= 0; i < TIMER_PARTITIONS; i++)
     {
-      process_timers(&now);
-      top_time= &(((thr_timer_t*) queue_top(&timer_queue))->expire_time);
+      TIMER_PARTITION *part= &timer_partitions[i];
+      struct timespec *top_time;
+
+      mysql_mutex_lock(&part->lock);
+      top_time= &(((thr_timer_t*) queue_top(&part->queue))->expire_time);
+
+      if (cmp_timespec((*top_time), now) <= 0)
+      {
+        process_timers(part, &now);
+        top_time= &(((thr_timer_t*) queue_top(&part->queue))->expire_time);
+      }
+      if (cmp_timespec((*top_time), abstime) < 0)
+        abstime= *top_time;
+      mysql_mutex_unlock(&part->lock);
     }
 
-    abstime= *top_time;
-    next_timer_expire_time= *top_time;
+    my_atomic_store64(&next_timer_expire, timespec_to_nsec(&abstime));
     if ((error= mysql_cond_timedwait(&COND_timer, &LOCK_timer, &abstime)) &&
         error != ETIME && error != ETIMEDOUT)
     {
@@ -566,7 +648,11 @@ static void run_test()
     mysql_cond_wait(&COND_thread_count, &LOCK_thread_count);
   }
   mysql_mutex_unlock(&LOCK_thread_count);
-  DBUG_ASSERT(timer_queue.elements == 1);
+  {
+    uint i;
+    for (i= 0; i < TIMER_PARTITIONS; i++)
+      DBUG_ASSERT(timer_partitions[i].queue.elements == 1);
+  }
   end_thr_timer();
   printf("Test succeeded\n");
   DBUG_VOID_RETURN;
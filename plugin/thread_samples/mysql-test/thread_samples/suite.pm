@@ -0,0 +1,11 @@
+package My::Suite::Thread_samples;
+
+@ISA = qw(My::Suite);
+
+return "No THREAD_SAMPLES plugin" unless $ENV{THREAD_SAMPLES_SO};
+
+return "Not run for embedded server" if $::opt_embedded_server;
+
+sub is_default { 1 }
+
+bless { };
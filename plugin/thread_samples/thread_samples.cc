@@ -0,0 +1,429 @@
+/* Copyright (C) 2026 MariaDB Foundation
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335 USA */
+
+/*
+  Sampling profiler of server threads.
+
+  A background thread wakes up thread_samples_frequency times per second
+  and records, for every connection that is not idle, the command, the
+  stage (as in SHOW PROCESSLIST State), the wait in progress (as reported
+  via thd_wait_begin()) and the beginning of the query text into a ring
+  buffer of thread_samples_buffer_size entries.
+
+  The sampled threads do not execute any code for this: all the work is
+  done by the sampler thread, which only reads THD members that
+  SHOW PROCESSLIST also reads, and which skips the query text of a thread
+  whose LOCK_thd_data is busy.
+
+  INFORMATION_SCHEMA.THREAD_SAMPLES shows the raw samples.
+  INFORMATION_SCHEMA.THREAD_SAMPLES_FOLDED aggregates them into
+  "command;state;wait" stacks that can be fed to flame graph tools:
+
+    SELECT CONCAT(STACK, ' ', SAMPLES)
+    FROM INFORMATION_SCHEMA.THREAD_SAMPLES_FOLDED;
+*/
+
+#define MYSQL_SERVER
+#include <my_global.h>
+#include <sql_class.h>
+#include <sql_i_s.h>
+#include <sql_show.h>
+#include <sql_parse.h>
+#include <tztime.h>
+#include <string>
+#include <unordered_map>
+
+namespace Show {
+
+static ST_FIELD_INFO samples_fields_info[]=
+{
+  Column("SAMPLE_TIME", Datetime(6),  NOT_NULL),
+  Column("THREAD_ID",   ULonglong(),  NOT_NULL),
+  Column("QUERY_ID",    SLonglong(),  NOT_NULL),
+  Column("COMMAND",     Varchar(32),  NOT_NULL),
+  Column("STATE",       Varchar(64),  NOT_NULL),
+  Column("WAIT",        Varchar(16),  NOT_NULL),
+  Column("QUERY",       Varchar(128), NOT_NULL),
+  CEnd()
+};
+
+static ST_FIELD_INFO folded_fields_info[]=
+{
+  Column("STACK",   Varchar(128), NOT_NULL),
+  Column("SAMPLES", ULonglong(),  NOT_NULL),
+  CEnd()
+};
+
+} // namespace Show
+
+
+namespace thread_samples {
+
+static uint frequency= 100;
+static uint buffer_size= 16384;
+
+/** One sample of one thread */
+struct sample
+{
+  my_hrtime_t time;
+  my_thread_id thread_id;
+  query_id_t query_id;
+  enum enum_server_command command;
+  int wait;
+  CHARSET_INFO *query_charset;
+  char state[64];
+  char query[128];
+};
+
+/** Ring buffer of samples, protected by LOCK_samples */
+static sample *samples;
+/** Total number of samples taken, protected by LOCK_samples */
+static ulonglong samples_taken;
+
+static mysql_mutex_t LOCK_samples;
+static mysql_cond_t COND_sampler;
+static bool shutdown_sampler;
+static pthread_t sampler_thread;
+
+#ifdef HAVE_PSI_INTERFACE
+static PSI_mutex_key key_LOCK_samples;
+static PSI_mutex_info mutex_list[]=
+{{ &key_LOCK_samples, "LOCK_samples", PSI_FLAG_GLOBAL}};
+
+static PSI_cond_key key_COND_sampler;
+static PSI_cond_info cond_list[]=
+{{ &key_COND_sampler, "COND_sampler", PSI_FLAG_GLOBAL}};
+#endif
+
+static const LEX_CSTRING wait_names[THD_WAIT_LAST]=
+{
+  { STRING_WITH_LEN("") },
+  { STRING_WITH_LEN("sleep") },
+  { STRING_WITH_LEN("diskio") },
+  { STRING_WITH_LEN("row_lock") },
+  { STRING_WITH_LEN("global_lock") },
+  { STRING_WITH_LEN("meta_data_lock") },
+  { STRING_WITH_LEN("table_lock") },
+  { STRING_WITH_LEN("user_lock") },
+  { STRING_WITH_LEN("binlog") },
+  { STRING_WITH_LEN("group_commit") },
+  { STRING_WITH_LEN("sync") },
+  { STRING_WITH_LEN("net") }
+};
+
+
+static const LEX_CSTRING &wait_name(int wait)
+{
+  return wait_names[wait > 0 && wait < THD_WAIT_LAST ? wait : 0];
+}
+
+
+/**
+  Record a sample of one thread.
+
+  @pre LOCK_samples is locked
+*/
+
+static my_bool sample_thread(THD *thd, my_hrtime_t *now)
+{
+  enum enum_server_command command= thd->get_command();
+  if (command == COM_SLEEP || command == COM_DAEMON)
+    return 0;
+
+  sample *s= &samples[samples_taken++ % buffer_size];
+  s->time= *now;
+  s->thread_id= thd->thread_id;
+  s->query_id= thd->query_id;
+  s->command= command;
+  s->wait= thd->wait_profile.current;
+  const char *state= thd->proc_info;
+  strmake_buf(s->state, state ? state : "");
+  s->query[0]= 0;
+  s->query_charset= &my_charset_bin;
+  if (!mysql_mutex_trylock(&thd->LOCK_thd_data))
+  {
+    if (thd->query())
+    {
+      strmake(s->query, thd->query(),
+              MY_MIN(thd->query_length(), sizeof s->query - 1));
+      s->query_charset= thd->query_charset();
+    }
+    mysql_mutex_unlock(&thd->LOCK_thd_data);
+  }
+  return 0;
+}
+
+
+static void *sampler(void *)
+{
+  if (my_thread_init())
+    return 0;
+
+  mysql_mutex_lock(&LOCK_samples);
+  while (!shutdown_sampler)
+  {
+    uint hz= frequency;
+    if (hz)
+    {
+      my_hrtime_t now= my_hrtime();
+      server_threads.iterate(sample_thread, &now);
+    }
+    struct timespec abstime;
+    set_timespec_nsec(abstime, 1000000000ULL / (hz ? hz : 1));
+    mysql_cond_timedwait(&COND_sampler, &LOCK_samples, &abstime);
+  }
+  mysql_mutex_unlock(&LOCK_samples);
+
+  my_thread_end();
+  return 0;
+}
+
+
+/**
+  Copy the ring buffer, oldest sample first.
+
+  @param[out] n  number of samples copied
+  @return the samples, to be freed with my_free(), or nullptr
+*/
+
+static sample *copy_samples(size_t *n)
+{
+  mysql_mutex_lock(&LOCK_samples);
+  *n= size_t(MY_MIN(samples_taken, ulonglong{buffer_size}));
+  sample *copy= *n ? static_cast<sample*>(my_malloc(PSI_NOT_INSTRUMENTED,
+                                                   *n * sizeof *copy,
+                                                   MYF(MY_WME)))
+                   : nullptr;
+  if (copy)
+  {
+    size_t first= size_t(samples_taken % buffer_size);
+    if (*n < buffer_size)
+      first= 0;
+    size_t tail= *n - first;
+    memcpy(copy, samples + first, tail * sizeof *copy);
+    memcpy(copy + tail, samples, first * sizeof *copy);
+  }
+  mysql_mutex_unlock(&LOCK_samples);
+  return copy;
+}
+
+
+static int samples_fill(THD *thd, TABLE_LIST *tables, COND *)
+{
+  TABLE *table= tables->table;
+  Field **field= table->field;
+  size_t n;
+  sample *copy= copy_samples(&n);
+  int res= 0;
+
+  for (size_t i= 0; i < n && !res; i++)
+  {
+    const sample &s= copy[i];
+    MYSQL_TIME time;
+    thd->variables.time_zone->gmt_sec_to_TIME(&time,
+                                              (my_time_t)
+                                              hrtime_to_time(s.time));
+    time.second_part= hrtime_sec_part(s.time);
+    field[0]->store_time_dec(&time, 6);
+    field[1]->store(s.thread_id, true);
+    field[2]->store(s.query_id, false);
+    field[3]->store(command_name[s.command].str, command_name[s.command].length,
+                    system_charset_info);
+    field[4]->store(s.state, strlen(s.state), system_charset_info);
+    const LEX_CSTRING &wait= wait_name(s.wait);
+    field[5]->store(wait.str, wait.length, system_charset_info);
+    field[6]->store(s.query, strlen(s.query), s.query_charset);
+    res= schema_table_store_record(thd, table);
+  }
+
+  my_free(copy);
+  return res;
+}
+
+
+static int folded_fill(THD *thd, TABLE_LIST *tables, COND *)
+{
+  TABLE *table= tables->table;
+  Field **field= table->field;
+  size_t n;
+  sample *copy= copy_samples(&n);
+  std::unordered_map<std::string, ulonglong> stacks;
+  int res= 0;
+
+  for (size_t i= 0; i < n; i++)
+  {
+    const sample &s= copy[i];
+    std::string stack(command_name[s.command].str,
+                      command_name[s.command].length);
+    if (*s.state)
+      stack.append(";").append(s.state);
+    const LEX_CSTRING &wait= wait_name(s.wait);
+    if (wait.length)
+      stack.append(";").append(wait.str, wait.length);
+    stacks[stack]++;
+  }
+  my_free(copy);
+
+  for (const auto &stack : stacks)
+  {
+    field[0]->store(stack.first.data(), stack.first.length(),
+                    system_charset_info);
+    field[1]->store(stack.second, true);
+    if ((res= schema_table_store_record(thd, table)))
+      break;
+  }
+  return res;
+}
+
+
+static uint plugins_inited;
+
+static int init()
+{
+  if (plugins_inited++)
+    return 0;
+
+#ifdef HAVE_PSI_INTERFACE
+  if (PSI_server)
+  {
+    PSI_server->register_mutex("thread_samples", mutex_list,
+                               array_elements(mutex_list));
+    PSI_server->register_cond("thread_samples", cond_list,
+                              array_elements(cond_list));
+  }
+#endif
+
+  if (!(samples= static_cast<sample*>(my_malloc(PSI_NOT_INSTRUMENTED,
+                                                buffer_size * sizeof *samples,
+                                                MYF(MY_WME)))))
+  {
+    plugins_inited--;
+    return 1;
+  }
+  samples_taken= 0;
+  shutdown_sampler= false;
+  mysql_mutex_init(key_LOCK_samples, &LOCK_samples, MY_MUTEX_INIT_FAST);
+  mysql_cond_init(key_COND_sampler, &COND_sampler, 0);
+
+  pthread_attr_t attr;
+  pthread_attr_init(&attr);
+  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
+  if (pthread_create(&sampler_thread, &attr, sampler, 0))
+  {
+    sql_print_error("thread_samples plugin: failed to start a background "
+                    "thread");
+    mysql_cond_destroy(&COND_sampler);
+    mysql_mutex_destroy(&LOCK_samples);
+    my_free(samples);
+    plugins_inited--;
+    return 1;
+  }
+  return 0;
+}
+
+
+static int deinit(void *)
+{
+  if (--plugins_inited)
+    return 0;
+
+  mysql_mutex_lock(&LOCK_samples);
+  shutdown_sampler= true;
+  mysql_cond_signal(&COND_sampler);
+  mysql_mutex_unlock(&LOCK_samples);
+  pthread_join(sampler_thread, NULL);
+
+  mysql_cond_destroy(&COND_sampler);
+  mysql_mutex_destroy(&LOCK_samples);
+  my_free(samples);
+  samples= nullptr;
+  return 0;
+}
+
+
+static int samples_init(void *p)
+{
+  ST_SCHEMA_TABLE *is= static_cast<ST_SCHEMA_TABLE*>(p);
+  is->fields_info= Show::samples_fields_info;
+  is->fill_table= samples_fill;
+  return init();
+}
+
+
+static int folded_init(void *p)
+{
+  ST_SCHEMA_TABLE *is= static_cast<ST_SCHEMA_TABLE*>(p);
+  is->fields_info= Show::folded_fields_info;
+  is->fill_table= folded_fill;
+  return init();
+}
+
+
+static MYSQL_SYSVAR_UINT(frequency, frequency, PLUGIN_VAR_RQCMDARG,
+       "Number of times per second each active thread is sampled; "
+       "0 disables sampling",
+       NULL, NULL, 100, 0, 1000, 0);
+
+static MYSQL_SYSVAR_UINT(buffer_size, buffer_size,
+       PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
+       "Number of most recent samples that are kept",
+       NULL, NULL, 16384, 1024, 1024 * 1024, 0);
+
+static struct st_mysql_sys_var *system_variables[]=
+{
+  MYSQL_SYSVAR(frequency),
+  MYSQL_SYSVAR(buffer_size),
+  NULL
+};
+
+} // namespace thread_samples
+
+
+static struct st_mysql_information_schema thread_samples_descriptor=
+{ MYSQL_INFORMATION_SCHEMA_INTERFACE_VERSION };
+
+
+maria_declare_plugin(thread_samples)
+{
+  MYSQL_INFORMATION_SCHEMA_PLUGIN,
+  &thread_samples_descriptor,
+  "THREAD_SAMPLES",
+  "MariaDB Foundation",
+  "Sampling profiler of server threads",
+  PLUGIN_LICENSE_GPL,
+  thread_samples::samples_init,
+  thread_samples::deinit,
+  0x0100,
+  NULL,
+  thread_samples::system_variables,
+  "1.0",
+  MariaDB_PLUGIN_MATURITY_EXPERIMENTAL
+},
+{
+  MYSQL_INFORMATION_SCHEMA_PLUGIN,
+  &thread_samples_descriptor,
+  "THREAD_SAMPLES_FOLDED",
+  "MariaDB Foundation",
+  "Flame graph friendly aggregation of THREAD_SAMPLES",
+  PLUGIN_LICENSE_GPL,
+  thread_samples::folded_init,
+  thread_samples::deinit,
+  0x0100,
+  NULL,
+  NULL,
+  "1.0",
+  MariaDB_PLUGIN_MATURITY_EXPERIMENTAL
+}
+maria_declare_plugin_end;
@@ -29,6 +29,7 @@ static ST_FIELD_INFO client_stats_fields[]=
   Column("EMPTY_QUERIES",            SLonglong(), NOT_NULL, "Empty_queries"),
   Column("TOTAL_SSL_CONNECTIONS",    ULonglong(), NOT_NULL, "Total_ssl_connections"),
   Column("MAX_STATEMENT_TIME_EXCEEDED", SLonglong(), NOT_NULL, "Max_statement_time_exceeded"),
+  Column("MEMORY_ALLOCATED",         ULonglong(), NOT_NULL, "Memory_allocated"),
   CEnd()
 };
 
@@ -70,6 +71,7 @@ static int send_user_stats(THD* thd, HASH *all_user_stats, TABLE *table)
     table->field[j++]->store((longlong)user_stats->empty_queries, TRUE);
     table->field[j++]->store((longlong)user_stats->total_ssl_connections, TRUE);
     table->field[j++]->store((longlong)user_stats->max_statement_time_exceeded, TRUE);
+    table->field[j++]->store((longlong)user_stats->memory_allocated, TRUE);
     if (schema_table_store_record(thd, table))
     {
       mysql_mutex_unlock(&LOCK_global_user_client_stats);
@@ -29,6 +29,7 @@ static ST_FIELD_INFO user_stats_fields[]=
   Column("EMPTY_QUERIES",        SLonglong(), NOT_NULL, "Empty_queries"),
   Column("TOTAL_SSL_CONNECTIONS",ULonglong(), NOT_NULL, "Total_ssl_connections"),
   Column("MAX_STATEMENT_TIME_EXCEEDED",SLonglong(),NOT_NULL, "Max_statement_time_exceeded"),
+  Column("MEMORY_ALLOCATED",     ULonglong(), NOT_NULL, "Memory_allocated"),
   CEnd()
 };
 
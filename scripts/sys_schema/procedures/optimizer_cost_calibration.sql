@@ -0,0 +1,113 @@
+--  Copyright (C) 2026, MariaDB
+--
+--  This program is free software; you can redistribute it and/or modify
+--  it under the terms of the GNU General Public License as published by
+--  the Free Software Foundation; version 2 of the License.
+--
+--  This program is distributed in the hope that it will be useful,
+--  but WITHOUT ANY WARRANTY; without even the implied warranty of
+--  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+--  GNU General Public License for more details.
+--
+--  You should have received a copy of the GNU General Public License
+--  along with this program; if not, write to the Free Software
+--  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+DROP PROCEDURE IF EXISTS optimizer_cost_calibration;
+DELIMITER $$
+
+--
+-- Suggest optimizer cost variables from INFORMATION_SCHEMA.OPTIMIZER_COST_FEEDBACK
+--
+-- The feedback is filled by ANALYZE statements run with
+-- optimizer_cost_feedback=ON. For every engine the accesses are grouped by
+-- the cost variables that dominate their estimate:
+--   ALL                       full table scans
+--   index, range, index_merge index scans
+--   ref, eq_ref, ref_or_null  key lookups
+-- and the variables of each group are scaled by measured/estimated time.
+-- optimizer_disk_read_cost is the measured time of reading an IO_SIZE
+-- (4096 bytes) block and optimizer_disk_read_ratio the measured fraction
+-- of page accesses that had to read the page.
+--
+-- Nothing is changed, the result has the SET statements to use.
+--
+
+CREATE DEFINER='mariadb.sys'@'localhost' PROCEDURE optimizer_cost_calibration()
+COMMENT 'suggest optimizer cost variables from information_schema.optimizer_cost_feedback'
+SQL SECURITY INVOKER
+NOT DETERMINISTIC
+READS SQL DATA
+BEGIN
+  SELECT s.engine, s.variable, s.current_value, s.suggested_value, s.samples,
+         CONCAT('SET GLOBAL ', LOWER(s.engine), '.', s.variable, '=',
+                s.suggested_value) AS statement
+  FROM
+  (
+    SELECT f.engine, v.variable, v.current_value,
+           ROUND(v.current_value * f.ratio, 6) AS suggested_value, f.samples
+    FROM
+      (SELECT ENGINE AS engine,
+              CASE WHEN ACCESS_TYPE = 'ALL' THEN 'scan'
+                   WHEN ACCESS_TYPE IN ('index', 'range', 'index_merge')
+                     THEN 'index'
+                   ELSE 'lookup' END AS access_class,
+              SUM(R_TIME_MS) / SUM(EST_COST) AS ratio,
+              COUNT(*) AS samples
+       FROM information_schema.OPTIMIZER_COST_FEEDBACK
+       WHERE EST_COST > 0 AND R_TIME_MS > 0 AND
+             ACCESS_TYPE IN ('ALL', 'index', 'range', 'index_merge',
+                             'ref', 'eq_ref', 'ref_or_null')
+       GROUP BY 1, 2) f
+    JOIN
+      (SELECT ENGINE, 'scan' AS access_class,
+              'optimizer_row_next_find_cost' AS variable,
+              OPTIMIZER_ROW_NEXT_FIND_COST AS current_value
+       FROM information_schema.OPTIMIZER_COSTS
+       UNION ALL
+       SELECT ENGINE, 'scan', 'optimizer_row_copy_cost',
+              OPTIMIZER_ROW_COPY_COST
+       FROM information_schema.OPTIMIZER_COSTS
+       UNION ALL
+       SELECT ENGINE, 'index', 'optimizer_key_next_find_cost',
+              OPTIMIZER_KEY_NEXT_FIND_COST
+       FROM information_schema.OPTIMIZER_COSTS
+       UNION ALL
+       SELECT ENGINE, 'index', 'optimizer_key_copy_cost',
+              OPTIMIZER_KEY_COPY_COST
+       FROM information_schema.OPTIMIZER_COSTS
+       UNION ALL
+       SELECT ENGINE, 'index', 'optimizer_index_block_copy_cost',
+              OPTIMIZER_INDEX_BLOCK_COPY_COST
+       FROM information_schema.OPTIMIZER_COSTS
+       UNION ALL
+       SELECT ENGINE, 'lookup', 'optimizer_key_lookup_cost',
+              OPTIMIZER_KEY_LOOKUP_COST
+       FROM information_schema.OPTIMIZER_COSTS
+       UNION ALL
+       SELECT ENGINE, 'lookup', 'optimizer_row_lookup_cost',
+              OPTIMIZER_ROW_LOOKUP_COST
+       FROM information_schema.OPTIMIZER_COSTS) v
+    ON v.ENGINE = f.engine AND v.access_class = f.access_class
+    UNION ALL
+    SELECT f.ENGINE, 'optimizer_disk_read_cost', c.OPTIMIZER_DISK_READ_COST,
+           ROUND(SUM(f.R_PAGES_READ_TIME_MS) * 1000 /
+                 SUM(f.R_PAGES_READ * f.PAGE_SIZE / 4096), 6),
+           COUNT(*)
+    FROM information_schema.OPTIMIZER_COST_FEEDBACK f
+    JOIN information_schema.OPTIMIZER_COSTS c ON c.ENGINE = f.ENGINE
+    WHERE f.R_PAGES_READ > 0 AND f.PAGE_SIZE > 0
+    GROUP BY f.ENGINE, c.OPTIMIZER_DISK_READ_COST
+    UNION ALL
+    SELECT f.ENGINE, 'optimizer_disk_read_ratio', c.OPTIMIZER_DISK_READ_RATIO,
+           ROUND(LEAST(SUM(f.R_PAGES_READ) / SUM(f.R_PAGES_ACCESSED), 1), 6),
+           COUNT(*)
+    FROM information_schema.OPTIMIZER_COST_FEEDBACK f
+    JOIN information_schema.OPTIMIZER_COSTS c ON c.ENGINE = f.ENGINE
+    WHERE f.R_PAGES_ACCESSED > 0
+    GROUP BY f.ENGINE, c.OPTIMIZER_DISK_READ_RATIO
+  ) s
+  ORDER BY s.engine, s.variable;
+END$$
+
+DELIMITER ;
@@ -451,10 +451,19 @@ EOF
             cd "$OLD_PWD"
         fi
 
-        # Use deltaxfer only for WAN:
+        # Use deltaxfer only for WAN or when requested with the
+        # 'delta-transfer' option. A joiner whose data files are only
+        # somewhat behind the donor then receives just the changed blocks
+        # of each file instead of the whole dataset:
         WHOLE_FILE_OPT=""
         if [ "${WSREP_METHOD%_wan}" = "$WSREP_METHOD" ]; then
-            WHOLE_FILE_OPT='--whole-file'
+            deltaxfer=$(parse_cnf sst 'delta-transfer' 0)
+            if [ "$deltaxfer" = '1' ]; then
+                wsrep_log_info "Transferring only the changed blocks" \
+                               "of the data files"
+            else
+                WHOLE_FILE_OPT='--whole-file'
+            fi
         fi
 
 # Old filter - include everything except selected
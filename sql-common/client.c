@@ -100,6 +100,8 @@ my_bool	net_flush(NET *net);
 #include <ssl_compat.h>
 #include <sql_common.h>
 #include <mysql/client_plugin.h>
+#include <providers/lz4.h>
+#include <providers/zstd.h>
 
 typedef enum {
   ALWAYS_ACCEPT,       /* heuristics is disabled, use CLIENT_LOCAL_FILES */
@@ -2079,6 +2081,17 @@ static int send_client_reply_packet(MCPVIO_EXT *mpvio,
   mysql->client_flag&= ~CLIENT_COMPRESS;
 #endif
 
+  /*
+    net->compress_algorithm was set from the server greeting. Another
+    payload format than zlib is requested in the MariaDB extended
+    capabilities, which the server only reads without CLIENT_MYSQL.
+  */
+  if (!(mysql->client_flag & CLIENT_COMPRESS) ||
+      !(mysql->client_flag & CLIENT_PROTOCOL_41))
+    net->compress_algorithm= NET_COMPRESSION_ZLIB;
+  else if (net->compress_algorithm != NET_COMPRESSION_ZLIB)
+    mysql->client_flag&= ~CLIENT_MYSQL;
+
   if (mysql->client_flag & CLIENT_PROTOCOL_41)
   {
     /* 4.1 server and 4.1 client has a 32 byte option flag */
@@ -2086,6 +2099,10 @@ static int send_client_reply_packet(MCPVIO_EXT *mpvio,
     int4store(buff+4, net->max_packet_size);
     buff[8]= (char) mysql->charset->number;
     bzero(buff+9, 32-9);
+    if (net->compress_algorithm != NET_COMPRESSION_ZLIB)
+      int4store(buff+28, (net->compress_algorithm == NET_COMPRESSION_ZSTD
+                          ? MARIADB_CLIENT_COMPRESS_ZSTD
+                          : MARIADB_CLIENT_COMPRESS_LZ4) >> 32);
     end= buff+32;
   }
   else
@@ -3053,6 +3070,29 @@ CLI_MYSQL_REAL_CONNECT(MYSQL *mysql,const char *host, const char *user,
     mysql->server_language=end[2];
     mysql->server_status=uint2korr(end+3);
     mysql->server_capabilities|= ((unsigned) uint2korr(end+5)) << 16;
+    /*
+      MariaDB servers send their extended capabilities in the filler.
+      Only ask for a format that the local provider can decompress.
+    */
+    if (!(mysql->server_capabilities & CLIENT_MYSQL) &&
+        mysql->options.extension &&
+        mysql->options.extension->compression_algorithm !=
+        NET_COMPRESSION_ZLIB &&
+        (mysql->options.extension->compression_algorithm ==
+         NET_COMPRESSION_ZSTD ? provider_service_zstd->is_loaded
+                              : provider_service_lz4->is_loaded))
+    {
+      ulonglong ext_capabilities= ((ulonglong) uint4korr(end+14)) << 32;
+      uint algorithm= mysql->options.extension->compression_algorithm;
+      if (ext_capabilities & (algorithm == NET_COMPRESSION_ZSTD
+                              ? MARIADB_CLIENT_COMPRESS_ZSTD
+                              : MARIADB_CLIENT_COMPRESS_LZ4))
+      {
+        net->compress_algorithm= (uchar) algorithm;
+        net->compress_level= (uchar)
+          mysql->options.extension->zstd_compression_level;
+      }
+    }
     pkt_scramble_len= end[7];
     if (pkt_scramble_len < 0)
     {
@@ -3841,6 +3881,21 @@ mysql_options(MYSQL *mysql,enum mysql_option option, const void *arg)
   case MYSQL_OPT_USE_THREAD_SPECIFIC_MEMORY:
     mysql->options.use_thread_specific_memory= *(my_bool *) arg;
     break;
+  case MYSQL_OPT_COMPRESSION_ALGORITHM:
+    if (*(uint *) arg > NET_COMPRESSION_LZ4)
+      DBUG_RETURN(1);
+    ENSURE_EXTENSIONS_PRESENT(&mysql->options);
+    mysql->options.extension->compression_algorithm= *(uint *) arg;
+    if (!mysql->options.extension->zstd_compression_level)
+      mysql->options.extension->zstd_compression_level=
+        NET_COMPRESSION_ZSTD_DEFAULT_LEVEL;
+    break;
+  case MYSQL_OPT_ZSTD_COMPRESSION_LEVEL:
+    if (*(uint *) arg < 1 || *(uint *) arg > 22)
+      DBUG_RETURN(1);
+    ENSURE_EXTENSIONS_PRESENT(&mysql->options);
+    mysql->options.extension->zstd_compression_level= *(uint *) arg;
+    break;
   case MYSQL_OPT_SSL_VERIFY_SERVER_CERT:
     if (!mysql->options.extension)
       mysql->options.extension= (struct st_mysql_options_extention *)
@@ -38,6 +38,10 @@ SOFTWARE.
 #endif
 #endif
 #endif
+#ifdef __aarch64__
+#include <arm_neon.h>
+#define NEON_IMPLEMENTATION
+#endif
 #ifndef DEFAULT_IMPLEMENTATION
 #define DEFAULT_IMPLEMENTATION
 #endif
@@ -314,6 +314,7 @@ SORT_INFO *filesort(THD *thd, TABLE *table, Filesort *filesort,
 
   param.set_all_read_bits= filesort->set_all_read_bits;
   param.unpack= filesort->unpack;
+  param.sort_threads= (uint) thd->variables.max_sort_threads;
 
   sort->addon_fields=  param.addon_fields;
   sort->sort_keys= param.sort_keys;
@@ -615,6 +616,102 @@ void Filesort::cleanup()
     select->cleanup();
     select= NULL;
   }
+  delete top_n;
+  top_n= NULL;
+}
+
+
+/**
+  Allocate the key buffers when the first record is offered.
+
+  The ORDER BY list is resolved with the ref array of the temporary
+  table, as create_sort_index() will do once the table has been filled.
+  The filter is disabled if the sort keys are not all columns of the
+  temporary table, or if the keys would not fit in the sort buffer.
+*/
+
+void Filesort_top_n::init(JOIN_TAB *tab)
+{
+  JOIN *join= tab->join;
+  THD *thd= join->thd;
+  Sort_keys *sort_keys;
+  bool allow_packing_for_sortkeys;
+
+  state= DISABLED;
+
+  Ref_ptr_array save_ref_ptrs= join->current_ref_ptrs;
+  join->set_items_ref_array(*tab->ref_array);
+  sort_keys= tab->filesort->make_sortorder(thd, join, tab->table->map);
+  join->set_items_ref_array(save_ref_ptrs);
+  if (!sort_keys)
+    return;
+
+  for (SORT_FIELD *pos= sort_keys->begin(); pos != sort_keys->end(); pos++)
+  {
+    if (!pos->field || pos->field->table != tab->table)
+      return;
+  }
+
+  sort_length= sortlength(thd, sort_keys, &allow_packing_for_sortkeys);
+  if (limit >= UINT_MAX - 1 ||
+      (limit + 1) * (sort_length + sizeof(uchar*)) >
+      thd->variables.sortbuff_size)
+    return;
+
+  if (!(key_ptrs= (uchar**) my_malloc(PSI_INSTRUMENT_ME,
+                                      limit * sizeof(uchar*) +
+                                      (limit + 1) * sort_length,
+                                      MYF(MY_THREAD_SPECIFIC))))
+    return;
+  uchar *key= (uchar*) (key_ptrs + limit);
+  for (ha_rows i= 0; i < limit; i++, key+= sort_length)
+    key_ptrs[i]= key;
+  new_key= key;
+
+  if (!(param= new Sort_param) ||
+      queue.init((uint) limit, true,
+                 (decltype(queue)::Queue_compare)get_ptr_compare(sort_length),
+                 &sort_length))
+    return;
+  param->local_sortorder=
+    Bounds_checked_array<SORT_FIELD>(tab->filesort->sortorder,
+                                     sort_keys->size());
+  param->sort_length= (uint) sort_length;
+  state= ACTIVE;
+}
+
+
+bool Filesort_top_n::is_worse(JOIN_TAB *tab)
+{
+  if (unlikely(state == UNINITED))
+    init(tab);
+  if (state != ACTIVE)
+    return false;
+
+  make_sortkey(param, new_key);
+  offered++;
+  if (!queue.is_full())
+  {
+    uchar **slot= key_ptrs + queue.elements();
+    std::swap(*slot, new_key);
+    queue.push(slot);
+    return false;
+  }
+  uchar **top= queue.top();
+  if (memcmp(new_key, *top, sort_length) > 0)
+    return offered > MIN_ROWS;
+  std::swap(*top, new_key);
+  queue.propagate_top();
+  return false;
+}
+
+
+void Filesort_top_n::cleanup()
+{
+  delete param;
+  param= NULL;
+  my_free(key_ptrs);
+  key_ptrs= NULL;
 }
 
 
@@ -1153,7 +1250,8 @@ write_keys(Sort_param *param,  SORT_INFO *fs_info, uint count,
   Merge_chunk buffpek;
   DBUG_ENTER("write_keys");
 
-  fs_info->sort_buffer(param, count);
+  if (fs_info->sort_buffer(param, count))
+    DBUG_RETURN(1);
 
   if (!my_b_inited(tempfile) &&
       open_cached_file(tempfile, mysql_tmpdir, TEMP_PREFIX, DISK_CHUNK_SIZE,
@@ -1558,7 +1656,8 @@ static bool save_index(Sort_param *param, uint count, SORT_INFO *table_sort)
   DBUG_ENTER("save_index");
   DBUG_ASSERT(table_sort->record_pointers == 0);
 
-  table_sort->sort_buffer(param, count);
+  if (table_sort->sort_buffer(param, count))
+    DBUG_RETURN(1);
 
   if (param->using_addon_fields())
   {
@@ -1721,6 +1820,16 @@ ulong read_to_buffer(IO_CACHE *fromfile, Merge_chunk *buffpek,
     buffpek->advance_file_position(num_bytes_read);    /* New filepos */
     buffpek->decrement_rowcount(count);
     buffpek->set_mem_count(count);
+    /*
+      The merge will come back for the next block of this chunk once the
+      records that were just read have been consumed. Let it be read in
+      the background meanwhile.
+    */
+    if (buffpek->rowcount())
+      my_b_prefetch(fromfile, buffpek->file_position(),
+                    packed_format ? buffpek->buffer_size() :
+                    rec_length * static_cast<size_t>
+                    (MY_MIN(buffpek->max_keys(), buffpek->rowcount())));
     return (ulong) num_bytes_read;
   }
   return 0;
@@ -19,6 +19,7 @@
 #include "my_base.h"                            /* ha_rows */
 #include "sql_alloc.h"
 #include "filesort_utils.h"
+#include "sql_queue.h"
 
 class SQL_SELECT;
 class THD;
@@ -30,6 +31,56 @@ typedef struct st_order ORDER;
 class JOIN;
 class Addon_fields;
 class Sort_keys;
+class Sort_param;
+struct st_join_table;
+
+
+/**
+  Pre-filter for ORDER BY ... LIMIT N over a temporary table.
+
+  Keeps the sort keys of the best N records written to the temporary
+  table so far. A record that sorts after all of them can not be among
+  the first N rows of the result, so it does not need to be written.
+*/
+class Filesort_top_n: public Sql_alloc
+{
+public:
+  explicit Filesort_top_n(ha_rows limit_arg)
+    : limit(limit_arg), offered(0), state(UNINITED), sort_length(0),
+      key_ptrs(NULL),
+      new_key(NULL), param(NULL)
+  {}
+  ~Filesort_top_n() { cleanup(); }
+  /*
+    Offer the record in tab->table->record[0].
+    @return true  the record sorts after the best N records seen so far
+  */
+  bool is_worse(struct st_join_table *tab);
+  /* Forget the keys of a previous execution */
+  void reset() { queue.clear(); offered= 0; }
+
+private:
+  void init(struct st_join_table *tab);
+  void cleanup();
+
+  /*
+    Nothing is discarded before this many records were offered: for small
+    results the saving is negligible, and filesort then sees the same rows
+    as without the filter, so the choice between equal rows is unchanged.
+  */
+  static const ha_rows MIN_ROWS= 1000;
+
+  ha_rows limit;
+  ha_rows offered;
+  enum { UNINITED, ACTIVE, DISABLED } state;
+  size_t sort_length;
+  /* The queue elements, followed by limit + 1 keys of sort_length bytes */
+  uchar **key_ptrs;
+  /* The key that is not in the queue */
+  uchar *new_key;
+  Sort_param *param;
+  Queue<uchar*, size_t> queue;
+};
 
 
 /**
@@ -72,6 +123,8 @@ class Filesort: public Sql_alloc
 
   Filesort_tracker *tracker;
   Sort_keys *sort_keys;
+  /* Set if rows that can not be among the first 'limit' can be discarded */
+  Filesort_top_n *top_n;
 
   /* Unpack temp table columns to base table columns*/
   void (*unpack)(TABLE *);
@@ -88,6 +141,7 @@ class Filesort: public Sql_alloc
     sort_positions(sort_positions_arg),
     set_all_read_bits(false),
     sort_keys(NULL),
+    top_n(NULL),
     unpack(NULL)
   {
     DBUG_ASSERT(order);
@@ -164,8 +218,8 @@ class SORT_INFO
   ha_rows   found_rows;         /* How many rows was accepted */
 
   /** Sort filesort_buffer */
-  void sort_buffer(Sort_param *param, uint count)
-  { filesort_buffer.sort_buffer(param, count); }
+  bool sort_buffer(Sort_param *param, uint count)
+  { return filesort_buffer.sort_buffer(param, count); }
 
   uchar **get_sort_keys()
   { return filesort_buffer.get_sort_keys(); }
@@ -20,8 +20,12 @@
 #include "sql_sort.h"
 #include "table.h"
 #include "optimizer_defaults.h"
+#include "sql_class.h"
+#include <algorithm>
+#include <atomic>
 
 PSI_memory_key key_memory_Filesort_buffer_sort_keys;
+extern PSI_thread_key key_thread_parallel_sort;
 
 const LEX_CSTRING filesort_names[]=
 {
@@ -383,13 +387,175 @@ void Filesort_buffer::free_sort_buffer()
 }
 
 
-void Filesort_buffer::sort_buffer(const Sort_param *param, uint count)
+/** Minimum number of records for each thread of parallel_sort() */
+static const uint PARALLEL_SORT_MIN_RECORDS= 32768;
+
+/**
+  Number of parallel_sort() helper threads that are reserved by all
+  connections together; it is kept below the number of CPUs, so that
+  many concurrent sorts cannot start several hundred threads each.
+*/
+static std::atomic<uint> parallel_sort_helpers;
+
+/**
+  Reserve up to wanted helper threads for parallel_sort()
+  @return the number of reserved helper threads, to be passed to
+          parallel_sort_release()
+*/
+static uint parallel_sort_reserve(uint wanted)
+{
+  const uint limit= (uint) MY_MAX(my_getncpus(), 1) - 1;
+  uint used= parallel_sort_helpers.load(std::memory_order_relaxed);
+  uint n;
+  do
+  {
+    n= used < limit ? MY_MIN(wanted, limit - used) : 0;
+    if (!n)
+      return 0;
+  }
+  while (!parallel_sort_helpers.compare_exchange_weak(used, used + n));
+  return n;
+}
+
+static void parallel_sort_release(uint n)
+{
+  parallel_sort_helpers.fetch_sub(n, std::memory_order_relaxed);
+}
+
+/** A slice of the array to sort (middle == NULL) or two slices to merge */
+struct Parallel_sort_job
+{
+  uchar **first, **middle, **last;
+  qsort2_cmp cmp;
+  void *arg;
+  pthread_t thread;
+  bool started;
+
+  void run()
+  {
+    if (!middle)
+      my_qsort2(first, (size_t) (last - first), sizeof(uchar*), cmp, arg);
+    else
+    {
+      const qsort2_cmp c= cmp;
+      void *const a= arg;
+      std::inplace_merge(first, middle, last,
+                         [c, a](uchar *x, uchar *y)
+                         { return c(a, &x, &y) < 0; });
+    }
+  }
+
+  static void *run_thread(void *arg)
+  {
+    my_thread_init();
+    static_cast<Parallel_sort_job*>(arg)->run();
+    my_thread_end();
+    return NULL;
+  }
+};
+
+/**
+  Run jobs[0..n-1]: jobs[0] in the calling thread and each other one in a
+  helper thread, or in the calling thread if the helper cannot be started.
+*/
+static void parallel_sort_run(Parallel_sort_job *jobs, uint n)
+{
+  for (uint i= 1; i < n; i++)
+  {
+    jobs[i].started= false;
+    DBUG_EXECUTE_IF("parallel_sort_no_thread", continue;);
+    jobs[i].started=
+      !mysql_thread_create(key_thread_parallel_sort, &jobs[i].thread, NULL,
+                           Parallel_sort_job::run_thread, &jobs[i]);
+  }
+  jobs[0].run();
+  for (uint i= 1; i < n; i++)
+  {
+    if (jobs[i].started)
+      pthread_join(jobs[i].thread, NULL);
+    else
+      jobs[i].run();
+  }
+}
+
+/**
+  Sort an array of record pointers by several threads: each sorts a slice
+  of the array with my_qsort2(), and then pairs of adjacent sorted slices
+  are merged concurrently, until one sorted sequence remains.
+
+  At most threads-1 helper threads are used, fewer if parallel_sort_reserve()
+  cannot grant them; without any, the array is sorted by my_qsort2().
+
+  @param thd      the connection that is sorting
+  @param keys     array of record pointers
+  @param count    number of elements in keys
+  @param threads  maximum number of slices
+  @param cmp      comparison function
+  @param arg      argument of cmp
+
+  @retval false   keys sorted
+  @retval true    the statement was killed; keys are not sorted
+*/
+static bool parallel_sort(THD *thd, uchar **keys, uint count, uint threads,
+                          qsort2_cmp cmp, void *arg)
+{
+  Parallel_sort_job *jobs;
+  DBUG_EXECUTE_IF("parallel_sort_kill", thd->set_killed(KILL_QUERY););
+  if (thd->check_killed())
+    return true;
+  const uint helpers= parallel_sort_reserve(threads - 1);
+  threads= helpers + 1;
+  if (threads < 2 ||
+      !(jobs= (Parallel_sort_job*) my_malloc(PSI_INSTRUMENT_ME,
+                                             threads * sizeof *jobs,
+                                             MYF(MY_THREAD_SPECIFIC))))
+  {
+    parallel_sort_release(helpers);
+    my_qsort2(keys, count, sizeof(uchar*), cmp, arg);
+    return false;
+  }
+
+  for (uint i= 0; i < threads; i++)
+  {
+    jobs[i].first= keys + (ulonglong) count * i / threads;
+    jobs[i].middle= NULL;
+    jobs[i].last= keys + (ulonglong) count * (i + 1) / threads;
+    jobs[i].cmp= cmp;
+    jobs[i].arg= arg;
+  }
+  parallel_sort_run(jobs, threads);
+
+  /* jobs[i] keeps covering slice i, while the slices are merged */
+  bool killed= false;
+  for (uint width= 1; width < threads; width*= 2)
+  {
+    if ((killed= thd->check_killed()))
+      break;
+    uint n= 0;
+    for (uint i= 0; i + width < threads; i+= 2 * width)
+    {
+      Parallel_sort_job &job= jobs[n++];
+      job.first= keys + (ulonglong) count * i / threads;
+      job.middle= keys + (ulonglong) count * (i + width) / threads;
+      job.last= keys + (ulonglong) count *
+        std::min(i + 2 * width, threads) / threads;
+    }
+    parallel_sort_run(jobs, n);
+  }
+
+  my_free(jobs);
+  parallel_sort_release(helpers);
+  return killed;
+}
+
+
+bool Filesort_buffer::sort_buffer(const Sort_param *param, uint count)
 {
   size_t size= param->sort_length;
   m_sort_keys= get_sort_keys();
 
   if (count <= 1 || size == 0)
-    return;
+    return false;
 
   // don't reverse for PQ, it is already done
   if (!param->using_pq)
@@ -403,12 +569,20 @@ void Filesort_buffer::sort_buffer(const Sort_param *param, uint count)
   {
     radixsort_for_str_ptr(m_sort_keys, count, param->sort_length, buffer);
     my_free(buffer);
-    return;
+    return false;
   }
 
+  uint threads= std::min(param->sort_threads,
+                         count / PARALLEL_SORT_MIN_RECORDS);
+  if (threads > 1)
+    return parallel_sort(current_thd, m_sort_keys, count, threads,
+                         param->get_compare_function(),
+                         param->get_compare_argument(&size));
+
   my_qsort2(m_sort_keys, count, sizeof(uchar*),
             param->get_compare_function(),
             param->get_compare_argument(&size));
+  return false;
 }
 
 
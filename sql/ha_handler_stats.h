@@ -44,6 +44,9 @@ class ha_handler_stats
   /* Time spent in engine, in timer_tracker_frequency() units */
   ulonglong engine_time;
 
+  /* Time spent waiting for row locks, in timer_tracker_frequency() units */
+  ulonglong lock_wait_time;
+
   /*
     Index Condition Pushdown: number of times condition was checked for index
     tuple
@@ -79,7 +79,8 @@
 #define PARTITION_DISABLED_TABLE_FLAGS (HA_DUPLICATE_POS | \
                                         HA_CAN_INSERT_DELAYED | \
                                         HA_READ_BEFORE_WRITE_REMOVAL |\
-                                        HA_CAN_TABLES_WITHOUT_ROLLBACK)
+                                        HA_CAN_TABLES_WITHOUT_ROLLBACK |\
+                                        HA_CAN_WRITE_ROWS)
 
 static const char *ha_par_ext= PAR_EXT;
 
@@ -261,6 +262,11 @@ bool Partition_share::init(uint num_parts)
   {
     DBUG_RETURN(true);
   }
+  partition_stats= new ha_statistics[num_parts];
+  if (!partition_stats)
+    DBUG_RETURN(true);
+  for (uint i= 0; i < num_parts; i++)
+    partition_stats[i].records= HA_POS_ERROR;
   DBUG_RETURN(false);
 }
 
@@ -449,6 +455,7 @@ void ha_partition::init_handler_variables()
   part_share= NULL;
   m_new_partitions_share_refs.empty();
   m_part_ids_sorted_by_num_of_records= NULL;
+  m_use_cached_stats= FALSE;
   m_partitions_to_open= NULL;
 
   m_range_info= NULL;
@@ -3990,7 +3997,16 @@ int ha_partition::open(const char *name, int mode, uint test_if_locked)
                             m_part_info->part_expr->get_monotonicity_info();
   else if (m_part_info->list_of_part_fields)
     m_part_func_monotonicity_info= MONOTONIC_STRICT_INCREASING;
-  if ((error= info(HA_STATUS_VARIABLE | HA_STATUS_CONST | HA_STATUS_OPEN)))
+  /*
+    With many partitions, asking each of them for its statistics would
+    dominate the cost of the open. The statistics that were collected by
+    other handlers of the table are good enough until the first statement
+    calls info() for the partitions that it uses.
+  */
+  m_use_cached_stats= TRUE;
+  error= info(HA_STATUS_VARIABLE | HA_STATUS_CONST | HA_STATUS_OPEN);
+  m_use_cached_stats= FALSE;
+  if (error)
     goto err_handler;
   DBUG_RETURN(0);
 
@@ -8532,6 +8548,55 @@ int ha_partition::compare_number_of_records(ha_partition *me,
 }
 
 
+/**
+  Get the HA_STATUS_VARIABLE statistics of a partition into its stats.
+
+  @param part_id  partition
+  @param flag     HA_STATUS_NO_LOCK and HA_STATUS_VARIABLE_EXTRA flags
+
+  @return Operation status
+*/
+
+int ha_partition::partition_info_variable(uint part_id, uint flag)
+{
+  handler *file= m_file[part_id];
+
+  if (!part_share || part_id >= part_share->partitions_share_refs.num_parts)
+    return file->info(HA_STATUS_VARIABLE | flag);
+
+  ha_statistics *cached= &part_share->partition_stats[part_id];
+
+  if (m_use_cached_stats && !(flag & HA_STATUS_VARIABLE_EXTRA))
+  {
+    bool found;
+    lock_shared_ha_data();
+    if ((found= cached->records != HA_POS_ERROR))
+    {
+      file->stats.records= cached->records;
+      file->stats.deleted= cached->deleted;
+      file->stats.data_file_length= cached->data_file_length;
+      file->stats.index_file_length= cached->index_file_length;
+      file->stats.delete_length= cached->delete_length;
+      file->stats.mean_rec_length= cached->mean_rec_length;
+      file->stats.check_time= cached->check_time;
+      file->stats.checksum= cached->checksum;
+      file->stats.checksum_null= cached->checksum_null;
+    }
+    unlock_shared_ha_data();
+    if (found)
+      return 0;
+  }
+
+  if (int error= file->info(HA_STATUS_VARIABLE | flag))
+    return error;
+
+  lock_shared_ha_data();
+  *cached= file->stats;
+  unlock_shared_ha_data();
+  return 0;
+}
+
+
 /*
   General method to gather info from handler
 
@@ -8713,7 +8778,7 @@ int ha_partition::info(uint flag)
          i= bitmap_get_next_set(&m_part_info->read_partitions, i))
     {
       file= m_file[i];
-      if ((error= file->info(HA_STATUS_VARIABLE | no_lock_flag | extra_var_flag)))
+      if ((error= partition_info_variable(i, no_lock_flag | extra_var_flag)))
         DBUG_RETURN(error);
       stats.records+= file->stats.records;
       stats.deleted+= file->stats.deleted;
@@ -8803,7 +8868,8 @@ int ha_partition::info(uint flag)
         if (!(flag & HA_STATUS_VARIABLE) ||
             !bitmap_is_set(&(m_part_info->read_partitions),
                            (uint) (file_array - m_file)))
-          if ((error= file->info(HA_STATUS_VARIABLE | no_lock_flag | extra_var_flag)))
+          if ((error= partition_info_variable((uint) (file_array - m_file),
+                                              no_lock_flag | extra_var_flag)))
             DBUG_RETURN(error);
         if (file->stats.records > max_records || !handler_instance_set)
         {
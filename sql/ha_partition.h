@@ -112,11 +112,18 @@ class Partition_share : public Handler_share
   const char *partition_engine_name;
   /** Storage for each partitions Handler_share */
   Parts_share_refs partitions_share_refs;
+  /**
+    HA_STATUS_VARIABLE statistics of each partition, as last reported to
+    any handler of the table. records is HA_POS_ERROR until it is known.
+    Protected by TABLE_SHARE::LOCK_ha_data.
+  */
+  ha_statistics *partition_stats;
   Partition_share()
     : auto_inc_initialized(false),
     next_auto_inc_val(0),
     partition_name_hash_initialized(false),
     partition_engine_name(NULL),
+    partition_stats(NULL),
     partition_names(NULL)
   {
     mysql_mutex_init(key_partition_auto_inc_mutex,
@@ -127,6 +134,7 @@ class Partition_share : public Handler_share
   ~Partition_share()
   {
     mysql_mutex_destroy(&auto_inc_mutex);
+    delete[] partition_stats;
     if (partition_names)
     {
       my_free(partition_names);
@@ -452,6 +460,12 @@ class ha_partition final :public handler
   static int compare_number_of_records(ha_partition *me,
                                        const uint32 *a,
                                        const uint32 *b);
+  int partition_info_variable(uint part_id, uint flag);
+  /**
+    Whether info() may use the statistics that other handlers of the
+    table collected, instead of asking every partition. Set in open().
+  */
+  bool m_use_cached_stats;
   /** keep track of partitions to call ha_reset */
   MY_BITMAP m_partitions_to_reset;
   /** partitions that returned HA_ERR_KEY_NOT_FOUND. */
@@ -7596,12 +7596,14 @@ static int binlog_log_row_to_binlog(TABLE* table,
   if (thd->variables.option_bits & OPTION_GTID_BEGIN)
     has_trans= 1;
 
-  auto *cache= binlog_get_cache_data(cache_mngr,
-                                     use_trans_cache(thd, has_trans));
+  const bool trans_cache= use_trans_cache(thd, has_trans);
+  auto *cache= binlog_get_cache_data(cache_mngr, trans_cache);
 
     error= (*log_func)(thd, table, mysql_bin_log.as_event_log(), cache,
                        has_trans, thd->variables.binlog_row_image,
                        before_record, after_record);
+  if (!error && opt_binlog_writeset_max_keys && trans_cache)
+    binlog_add_writeset(thd, table, before_record, after_record);
   DBUG_RETURN(error ? HA_ERR_RBR_LOGGING_FAILED : 0);
 }
 
@@ -8216,6 +8218,66 @@ int handler::ha_write_row(const uchar *buf)
 }
 
 
+int handler::write_rows(const uchar *rows, ha_rows n, ha_rows *written)
+{
+  const size_t length= table->s->rec_buff_length;
+  for (*written= 0; *written < n; ++*written)
+  {
+    memcpy(table->record[0], rows + *written * length, table->s->reclength);
+    if (int error= write_row(table->record[0]))
+      return error;
+  }
+  return 0;
+}
+
+
+/**
+  Write a batch of rows that were prepared by the caller.
+
+  Unlike ha_write_row(), this does not check WITHOUT OVERLAPS or long
+  unique keys, and does not update high-level indexes, so the caller
+  must not use it for such tables. On error, the failed row is copied
+  to record[0] so that print_error() can report its key.
+*/
+
+int handler::ha_write_rows(const uchar *rows, ha_rows n, ha_rows *written)
+{
+  int error;
+  DBUG_ASSERT(table_share->tmp_table != NO_TMP_TABLE || m_lock_type == F_WRLCK);
+  DBUG_ASSERT(ha_table_flags() & HA_CAN_WRITE_ROWS);
+  DBUG_ASSERT(!table->s->long_unique_table);
+  DBUG_ASSERT(!table->s->period.unique_keys);
+  DBUG_ENTER("handler::ha_write_rows");
+
+  *written= 0;
+  MYSQL_INSERT_ROW_START(table_share->db.str, table_share->table_name.str);
+  mark_trx_read_write();
+  table->in_use->status_var.ha_write_count+= n;
+  table->in_use->check_limit_rows_examined();
+
+  TABLE_IO_WAIT(tracker, PSI_TABLE_WRITE_ROW, MAX_KEY, error,
+                      { error= write_rows(rows, n, written); })
+
+  MYSQL_INSERT_ROW_DONE(error);
+  const size_t length= table->s->rec_buff_length;
+  Log_func *log_func= Write_rows_log_event::binlog_row_logging_function;
+  for (ha_rows i= 0; i < *written; i++)
+  {
+    rows_stats.inserted++;
+    if (int err= binlog_log_row(0, rows + i * length, log_func))
+    {
+      *written= i;
+      error= err;
+      break;
+    }
+  }
+
+  if (error)
+    memcpy(table->record[0], rows + *written * length, table->s->reclength);
+  DBUG_RETURN(error);
+}
+
+
 int handler::ha_update_row(const uchar *old_data, const uchar *new_data)
 {
   int error;
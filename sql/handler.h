@@ -387,7 +387,13 @@ enum chf_create_flags {
 /* This engine is not compatible with Online ALTER TABLE */
 #define HA_NO_ONLINE_ALTER  (1ULL << 62)
 
-#define HA_LAST_TABLE_FLAG HA_NO_ONLINE_ALTER
+/*
+  write_rows() is implemented and accepts rows that are not in record[0],
+  see handler::ha_write_rows()
+*/
+#define HA_CAN_WRITE_ROWS   (1ULL << 63)
+
+#define HA_LAST_TABLE_FLAG HA_CAN_WRITE_ROWS
 
 
 /* bits in index_flags(index_number) for what you can do with index */
@@ -1083,6 +1089,7 @@ enum enum_schema_tables
   SCH_KEY_PERIOD_USAGE,
   SCH_OPEN_TABLES,
   SCH_OPTIMIZER_COSTS,
+  SCH_OPTIMIZER_COST_FEEDBACK,
   SCH_OPT_TRACE,
   SCH_PARAMETERS,
   SCH_PERIODS,
@@ -3573,7 +3580,7 @@ class handler :public Sql_alloc
   */
   Table_flags ha_table_flags() const
   {
-    DBUG_ASSERT(cached_table_flags < (HA_LAST_TABLE_FLAG << 1));
+    DBUG_ASSERT(cached_table_flags <= (HA_LAST_TABLE_FLAG << 1) - 1);
     return cached_table_flags;
   }
   /**
@@ -3585,6 +3592,7 @@ class handler :public Sql_alloc
   int ha_external_lock(THD *thd, int lock_type);
   int ha_external_unlock(THD *thd) { return ha_external_lock(thd, F_UNLCK); }
   int ha_write_row(const uchar * buf);
+  int ha_write_rows(const uchar *rows, ha_rows n, ha_rows *written);
   int ha_update_row(const uchar * old_data, const uchar * new_data);
   int ha_delete_row(const uchar * buf);
   void ha_release_auto_increment();
@@ -4338,6 +4346,14 @@ class handler :public Sql_alloc
   virtual int pre_ft_end() { return 0; }
   virtual FT_INFO *ft_init_ext(uint flags, uint inx,String *key)
     { return NULL; }
+  /**
+    Start a full-text search of which only the limit rows of the highest
+    relevance will be read, in the order of decreasing relevance.
+    An engine may stop returning rows after them.
+  */
+  virtual FT_INFO *ft_init_ext_with_limit(uint flags, uint inx, String *key,
+                                          ha_rows limit)
+    { return ft_init_ext(flags, inx, key); }
 public:
   virtual int ft_read(uchar *buf) { return HA_ERR_WRONG_COMMAND; }
   virtual int rnd_next(uchar *buf)=0;
@@ -4381,10 +4397,39 @@ class handler :public Sql_alloc
   virtual int restart_rnd_next(uchar *buf)
     { return HA_ERR_WRONG_COMMAND; }
 
+  /**
+    Read a random sample of about *fraction of the rows of the table,
+    for collecting engine-independent statistics. The engine is free to
+    return whole blocks of adjacent rows, so that it does not have to read
+    the rest of the table, and stores in *fraction the part of the table
+    that it is going to read. sample_init() returns HA_ERR_WRONG_COMMAND if
+    the engine cannot sample; the caller then scans the table with
+    rnd_next(). sample_next() returns HA_ERR_END_OF_FILE after the last
+    sampled row, and sample_end() must be called after a
+    successful sample_init().
+  */
+  virtual int sample_init(double *fraction)
+    { return HA_ERR_WRONG_COMMAND; }
+  virtual int sample_next(uchar *buf)
+    { return HA_ERR_WRONG_COMMAND; }
+  virtual int sample_end()
+    { return 0; }
+
   virtual ha_rows records_in_range(uint inx, const key_range *min_key,
                                    const key_range *max_key,
                                    page_range *res)
     { return (ha_rows) 10; }
+  /*
+    Estimate the number of rows in n_ranges ranges of the same index, as
+    records_in_range() would do for each of them. min_keys[i] and
+    max_keys[i] may be NULL. Engines can override this to share work
+    between the ranges; the default calls records_in_range() in order
+    and stops after the first range for which it returned HA_POS_ERROR.
+  */
+  virtual void records_in_ranges(uint inx, uint n_ranges,
+                                 key_range *const *min_keys,
+                                 key_range *const *max_keys,
+                                 page_range *pages, ha_rows *rows);
   /*
     If HA_PRIMARY_KEY_REQUIRED_FOR_POSITION is set, then it sets ref
     (reference to the row, aka position, with the primary key given in
@@ -5227,6 +5272,18 @@ class handler :public Sql_alloc
     return HA_ERR_WRONG_COMMAND;
   }
 
+  /**
+    Write consecutive rows of table->s->rec_buff_length bytes each.
+    Only invoked if HA_CAN_WRITE_ROWS is set.
+
+    @param rows     the first row
+    @param n        number of rows
+    @param written  number of rows that were written
+
+    @return 0 or the error of the row after the written ones
+  */
+  virtual int write_rows(const uchar *rows, ha_rows n, ha_rows *written);
+
   /**
     Update a single row.
 
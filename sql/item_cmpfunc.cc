@@ -6119,6 +6119,66 @@ void Regexp_processor_pcre::cleanup()
   pcre2_match_data_free(m_pcre_match_data);
   pcre2_code_free(m_pcre);
   reset();
+  for (uint i= 0; i < m_cache_elements; i++)
+  {
+    pcre2_match_data_free(m_cache[i].match_data);
+    pcre2_code_free(m_cache[i].pcre);
+  }
+  m_cache_elements= 0;
+}
+
+
+/**
+  Make the cache entry n the most recently used one, swapping it with
+  the current pattern.
+*/
+void Regexp_processor_pcre::swap_with_cached(uint n)
+{
+  Cached_pattern *c= &m_cache[n];
+  swap_variables(pcre2_code *, m_pcre, c->pcre);
+  swap_variables(pcre2_match_data *, m_pcre_match_data, c->match_data);
+  m_prev_pattern.swap(c->pattern);
+  for ( ; n > 0; n--, c--)
+  {
+    swap_variables(pcre2_code *, c->pcre, c[-1].pcre);
+    swap_variables(pcre2_match_data *, c->match_data, c[-1].match_data);
+    c->pattern.swap(c[-1].pattern);
+  }
+}
+
+
+/**
+  Make a previously compiled pattern the current one.
+
+  @retval    true   found, the old current pattern was put in the cache
+  @retval    false  not found, the old current pattern was put in the
+                    cache and the current one is not compiled
+*/
+bool Regexp_processor_pcre::use_cached(const String *pattern)
+{
+  uint i;
+  DBUG_ASSERT(is_compiled());
+  for (i= 0; i < m_cache_elements; i++)
+  {
+    if (!stringcmp(pattern, &m_cache[i].pattern))
+    {
+      swap_with_cached(i);
+      return true;
+    }
+  }
+  if (m_cache_elements < CACHE_SIZE)
+    i= m_cache_elements++;
+  else
+  {
+    /* Evict the least recently used pattern */
+    i= CACHE_SIZE - 1;
+    pcre2_match_data_free(m_cache[i].match_data);
+    pcre2_code_free(m_cache[i].pcre);
+  }
+  m_cache[i].pcre= NULL;
+  m_cache[i].match_data= NULL;
+  swap_with_cached(i);
+  return false;
 }
 
 void Regexp_processor_pcre::init(CHARSET_INFO *data_charset, int extra_flags)
@@ -6174,9 +6234,9 @@ bool Regexp_processor_pcre::compile(String *pattern, bool send_error)
 
   if (is_compiled())
   {
-    if (!stringcmp(pattern, &m_prev_pattern))
+    if (!stringcmp(pattern, &m_prev_pattern) || use_cached(pattern))
       return false;
-    cleanup();
+    DBUG_ASSERT(!is_compiled());
   }
   m_prev_pattern.copy(*pattern);
 
@@ -3047,6 +3047,22 @@ class Regexp_processor_pcre
   String m_prev_pattern;
   int m_pcre_exec_rc;
   PCRE2_SIZE *m_SubStrVec;
+  /*
+    Patterns compiled before the current one, most recently used first.
+    A non-constant pattern that comes back (e.g. REGEXP against a column
+    of patterns) is taken from here instead of being compiled again.
+  */
+  static const uint CACHE_SIZE= 8;
+  struct Cached_pattern
+  {
+    pcre2_code *pcre;
+    pcre2_match_data *match_data;
+    String pattern;
+  };
+  Cached_pattern m_cache[CACHE_SIZE];
+  uint m_cache_elements;
+  void swap_with_cached(uint n);
+  bool use_cached(const String *pattern);
   void pcre_exec_warn(int rc) const;
   int pcre_exec_with_warn(const pcre2_code *code,
                           pcre2_match_data *data,
@@ -3061,7 +3077,8 @@ class Regexp_processor_pcre
     m_pcre(NULL), m_pcre_match_data(NULL),
     m_conversion_is_needed(true), m_is_const(0),
     m_library_flags(0),
-    m_library_charset(&my_charset_utf8mb4_general_ci)
+    m_library_charset(&my_charset_utf8mb4_general_ci),
+    m_cache_elements(0)
   {}
   int default_regex_flags();
   void init(CHARSET_INFO *data_charset, int extra_flags);
@@ -182,6 +182,19 @@ class Create_func_kdf : public Create_native_func
 };
 
 
+class Create_func_approx_count_distinct : public Create_func_arg1
+{
+public:
+  Item *create_1_arg(THD *thd, Item *arg1) override;
+
+  static Create_func_approx_count_distinct s_singleton;
+
+protected:
+  Create_func_approx_count_distinct() = default;
+  ~Create_func_approx_count_distinct() override = default;
+};
+
+
 class Create_func_asin : public Create_func_arg1
 {
 public:
@@ -3260,6 +3273,16 @@ Create_func_kdf::create_native(THD *thd, const LEX_CSTRING *name,
 }
 
 
+Create_func_approx_count_distinct
+  Create_func_approx_count_distinct::s_singleton;
+
+Item*
+Create_func_approx_count_distinct::create_1_arg(THD *thd, Item *arg1)
+{
+  return new (thd->mem_root) Item_sum_approx_count_distinct(thd, arg1);
+}
+
+
 Create_func_asin Create_func_asin::s_singleton;
 
 Item*
@@ -6320,6 +6343,8 @@ const Native_func_registry func_array[] =
   { { STRING_WITH_LEN("ADD_MONTHS") }, BUILDER(Create_func_addmonths)},
   { { STRING_WITH_LEN("AES_DECRYPT") }, BUILDER(Create_func_aes_decrypt)},
   { { STRING_WITH_LEN("AES_ENCRYPT") }, BUILDER(Create_func_aes_encrypt)},
+  { { STRING_WITH_LEN("APPROX_COUNT_DISTINCT") },
+      BUILDER(Create_func_approx_count_distinct)},
   { { STRING_WITH_LEN("ASIN") }, BUILDER(Create_func_asin)},
   { { STRING_WITH_LEN("ATAN") }, BUILDER(Create_func_atan)},
   { { STRING_WITH_LEN("ATAN2") }, BUILDER(Create_func_atan)},
@@ -6225,7 +6225,8 @@ bool Item_func_match::init_search(THD *thd, bool no_order)
   if (key != NO_SUCH_KEY)
     THD_STAGE_INFO(table->in_use, stage_fulltext_initialization);
 
-  ft_handler= table->file->ft_init_ext(match_flags, key, ft_tmp);
+  ft_handler= table->file->ft_init_ext_with_limit(match_flags, key, ft_tmp,
+                                                  ft_limit);
 
   if (!ft_handler)
     DBUG_RETURN(1);
@@ -7092,7 +7093,7 @@ longlong Item_func_nextval::val_int()
     }
   }
   entry->null_value= null_value= 0;
-  value= table->s->sequence->next_value(table, 0, &error);
+  value= entry->next_value(table, &error);
   entry->value= value;
   entry->set_version(table);
 
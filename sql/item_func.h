@@ -3710,13 +3710,14 @@ class Item_func_match :public Item_real_func
   FT_INFO *ft_handler;
   TABLE *table;
   Item_func_match *master;   // for master-slave optimization
+  ha_rows ft_limit;          // rows that are read, see set_fulltext_limit()
   Item *concat_ws;           // Item_func_concat_ws
   String value;              // value of concat_ws
   String search_value;       // key_item()'s value converted to cmp_collation
 
   Item_func_match(THD *thd, List<Item> &a, uint b):
     Item_real_func(thd, a), key(0), match_flags(b), join_key(0), ft_handler(0),
-    table(0), master(0), concat_ws(0) { }
+    table(0), master(0), ft_limit(HA_POS_ERROR), concat_ws(0) { }
   void cleanup() override
   {
     DBUG_ENTER("Item_func_match::cleanup");
@@ -3724,6 +3725,7 @@ class Item_func_match :public Item_real_func
     if (!master && ft_handler)
       ft_handler->please->close_search(ft_handler);
     ft_handler= 0;
+    ft_limit= HA_POS_ERROR;
     concat_ws= 0;
     table= 0;           // required by Item_func_match::eq()
     DBUG_VOID_RETURN;
@@ -1357,6 +1357,121 @@ class Geometry_ptr_with_buffer_and_mbr
 };
 
 
+int Item_func_spatial_precise_rel::Polygon_edges::add_point(double x, double y)
+{
+  bool res= false;
+  if (ring_started)
+  {
+    Edge e= {prev_x, prev_y, x, y};
+    res= m_edges.append(e);
+  }
+  else
+  {
+    first_x= x;
+    first_y= y;
+    ring_started= true;
+  }
+  prev_x= x;
+  prev_y= y;
+  return res;
+}
+
+
+int Item_func_spatial_precise_rel::Polygon_edges::complete_ring()
+{
+  if (!ring_started || (prev_x == first_x && prev_y == first_y))
+    return 0;
+  Edge e= {prev_x, prev_y, first_x, first_y};
+  /* Gis_polygon::store_shapes() does not check the result. */
+  return oom|= m_edges.append(e);
+}
+
+
+/**
+  Locate a point against the polygons with the crossing number test.
+
+  @return 1 if the point is in the interior of a polygon,
+          0 if it is in the exterior of all of them,
+         -1 if it is within 'tolerance' of an edge; the exact
+            computation must decide where it is then.
+*/
+
+int Item_func_spatial_precise_rel::Polygon_edges::locate(double x, double y,
+                                                        double tolerance) const
+{
+  const double sq_tolerance= tolerance * tolerance;
+  bool inside= false;
+  size_t e= 0;
+
+  for (size_t p= 0; p < m_poly_ends.elements(); p++)
+  {
+    bool odd= false;
+    for (const size_t end= m_poly_ends.at(p); e < end; e++)
+    {
+      const Edge &edge= m_edges.at(e);
+      const double ex= edge.x2 - edge.x1, ey= edge.y2 - edge.y1;
+      const double vx= x - edge.x1, vy= y - edge.y1;
+      const double sqlen= ex * ex + ey * ey;
+      double t= sqlen > 0 ? (ex * vx + ey * vy) / sqlen : 0;
+      t= t < 0 ? 0 : t > 1 ? 1 : t;
+      const double dx= vx - t * ex, dy= vy - t * ey;
+      if (dx * dx + dy * dy <= sq_tolerance)
+        return -1;
+      if ((edge.y1 > y) != (edge.y2 > y) && vx < ex * vy / ey)
+        odd= !odd;
+    }
+    inside|= odd;
+  }
+  return inside;
+}
+
+
+/**
+  Locate a point against a polygon or a multipolygon without the
+  slice scan. The edges of a constant polygon are collected once
+  for the statement.
+
+  @return the result of Polygon_edges::locate(), or
+          -1 if the arguments are not a point and a polygon
+*/
+
+int Item_func_spatial_precise_rel::point_polygon_rel(uint polygon_arg,
+                                                     Geometry *point,
+                                                     Geometry *polygon,
+                                                     const MBR &polygon_mbr)
+{
+  const int type= polygon->get_class_info()->m_type_id;
+  double x, y;
+
+  if (point->get_class_info()->m_type_id != Geometry::wkb_point ||
+      (type != Geometry::wkb_polygon && type != Geometry::wkb_multipolygon) ||
+      ((Gis_point *) point)->get_xy(&x, &y))
+    return -1;
+
+  const double extent= MY_MAX(MY_MAX(fabs(polygon_mbr.xmin),
+                                     fabs(polygon_mbr.xmax)),
+                              MY_MAX(fabs(polygon_mbr.ymin),
+                                     fabs(polygon_mbr.ymax)));
+  const double tolerance= MY_MAX(extent, MY_MAX(fabs(x), fabs(y))) * 1e-10 +
+                          GIS_ZERO;
+
+  if (x < polygon_mbr.xmin - tolerance || x > polygon_mbr.xmax + tolerance ||
+      y < polygon_mbr.ymin - tolerance || y > polygon_mbr.ymax + tolerance)
+    return 0;
+
+  if (edges_item != args[polygon_arg])
+  {
+    edges_item= NULL;
+    edges.reset();
+    if (polygon->store_shapes(&edges) || edges.oom)
+      return -1;
+    if (args[polygon_arg]->const_item())
+      edges_item= args[polygon_arg];
+  }
+  return edges.locate(x, y, tolerance);
+}
+
+
 bool Item_func_spatial_relate::val_bool()
 {
   DBUG_ENTER("Item_func_spatial_relate::val_int");
@@ -1412,6 +1527,34 @@ bool Item_func_spatial_precise_rel::val_bool()
   MBR umbr(g1.mbr, g2.mbr);
   collector.set_extent(umbr.xmin, umbr.xmax, umbr.ymin, umbr.ymax);
 
+  /* A point against a polygon, e.g. for geofencing, is decided directly. */
+  {
+    int loc= -1;
+    switch (spatial_rel) {
+      case SP_CONTAINS_FUNC:
+        loc= point_polygon_rel(0, g2.geom, g1.geom, g1.mbr);
+        break;
+      case SP_WITHIN_FUNC:
+        loc= point_polygon_rel(1, g1.geom, g2.geom, g2.mbr);
+        break;
+      case SP_DISJOINT_FUNC:
+      case SP_INTERSECTS_FUNC:
+      case SP_TOUCHES_FUNC:
+        if ((loc= point_polygon_rel(0, g2.geom, g1.geom, g1.mbr)) < 0)
+          loc= point_polygon_rel(1, g1.geom, g2.geom, g2.mbr);
+        break;
+      default:
+        break;
+    }
+    if (loc >= 0)
+    {
+      /* The point is not on the boundary, so it never touches. */
+      result= spatial_rel == SP_DISJOINT_FUNC ? !loc :
+              spatial_rel == SP_TOUCHES_FUNC ? 0 : loc;
+      goto exit;
+    }
+  }
+
   g1.mbr.buffer(1e-5);
 
   switch (spatial_rel) {
@@ -1442,6 +1585,11 @@ bool Item_func_spatial_precise_rel::val_bool()
       null_value= g1.store_shapes(&trn) || g2.store_shapes(&trn);
       break;
     case SP_DISJOINT_FUNC:
+      if (!g1.mbr.intersects(&g2.mbr))
+      {
+        result= 1;
+        goto exit;
+      }
       func.add_operation(Gcalc_function::v_find_f |
                          Gcalc_function::op_not |
                          Gcalc_function::op_intersection, 2);
@@ -1456,6 +1604,8 @@ bool Item_func_spatial_precise_rel::val_bool()
       break;
     case SP_OVERLAPS_FUNC:
     case SP_CROSSES_FUNC:
+      if (!g1.mbr.intersects(&g2.mbr))
+        goto exit;
       func.add_operation(Gcalc_function::op_intersection, 2);
       if (func.reserve_op_buffer(3))
         break;
@@ -1480,6 +1630,8 @@ bool Item_func_spatial_precise_rel::val_bool()
       func.repeat_expression(shape_a);
       break;
     case SP_TOUCHES_FUNC:
+      if (!g1.mbr.intersects(&g2.mbr))
+        goto exit;
       if (func.reserve_op_buffer(5))
         break;
       func.add_operation(Gcalc_function::op_intersection, 2);
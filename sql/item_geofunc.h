@@ -795,13 +795,66 @@ class Item_func_spatial_mbr_rel: public Item_func_spatial_rel
 
 class Item_func_spatial_precise_rel: public Item_func_spatial_rel
 {
+  /* The edges of the rings of a polygon or a multipolygon */
+  class Polygon_edges : public Gcalc_shape_transporter
+  {
+    struct Edge
+    {
+      double x1, y1, x2, y2;
+    };
+    Dynamic_array<Edge> m_edges;
+    /* The end of the edges of each polygon in m_edges */
+    Dynamic_array<size_t> m_poly_ends;
+    double first_x, first_y, prev_x, prev_y;
+    bool ring_started;
+  public:
+    /* Set when an edge could not be stored by complete_ring() */
+    bool oom;
+    Polygon_edges() :
+      Gcalc_shape_transporter(NULL),
+      m_edges(PSI_INSTRUMENT_MEM, 0), m_poly_ends(PSI_INSTRUMENT_MEM, 0),
+      oom(false)
+    {}
+    void reset()
+    {
+      m_edges.clear();
+      m_poly_ends.clear();
+      oom= false;
+    }
+    int locate(double x, double y, double tolerance) const;
+
+    int single_point(double x, double y) override { return 1; }
+    int start_line() override { return 1; }
+    int complete_line() override { return 1; }
+    int start_poly() override { return 0; }
+    int complete_poly() override
+    { return m_poly_ends.append(m_edges.elements()); }
+    int start_ring() override
+    {
+      ring_started= false;
+      return 0;
+    }
+    int complete_ring() override;
+    int add_point(double x, double y) override;
+  };
+
   Gcalc_heap collector;
   Gcalc_scan_iterator scan_it;
   Gcalc_function func;
+  Polygon_edges edges;
+  /* The constant argument whose edges are in 'edges', or NULL */
+  const Item *edges_item;
+  int point_polygon_rel(uint polygon_arg, Geometry *point, Geometry *polygon,
+                        const MBR &polygon_mbr);
 public:
   Item_func_spatial_precise_rel(THD *thd, Item *a, Item *b, enum Functype sp_rel):
-    Item_func_spatial_rel(thd, a, b, sp_rel), collector()
+    Item_func_spatial_rel(thd, a, b, sp_rel), collector(), edges_item(NULL)
   { }
+  void cleanup() override
+  {
+    edges_item= NULL;
+    Item_func_spatial_rel::cleanup();
+  }
   bool val_bool() override;
   LEX_CSTRING func_name_cstring() const override;
   Item *do_get_copy(THD *thd) const override
@@ -1019,16 +1019,30 @@ bool Item_func_json_extract::fix_length_and_dec(THD *thd)
 }
 
 
+/*
+  Count the paths that match p exactly. If skip_value isn't NULL, it's
+  set if p is an object or array where a step of every path failed, so
+  nothing inside can match. That's only true for paths without '**'
+  and negative indexes.
+*/
+
 static int path_exact(const json_path_with_flags *paths_list, int n_paths,
                        const json_path_t *p, json_value_types vt,
-                       const int *array_size_counter)
+                       const int *array_size_counter, int *skip_value)
 {
   int count_path= 0;
+  bool all_failed= true;
   for (; n_paths > 0; n_paths--, paths_list++)
   {
-    if (json_path_compare(&paths_list->p, p, vt, array_size_counter) == 0)
+    int res= json_path_compare(&paths_list->p, p, vt, array_size_counter);
+    if (res == 0)
       count_path++;
+    if (res != -1)
+      all_failed= false;
   }
+  if (skip_value)
+    *skip_value= all_failed &&
+                 (vt == JSON_VALUE_OBJECT || vt == JSON_VALUE_ARRAY);
   return count_path;
 }
 
@@ -1057,9 +1071,9 @@ String *Item_func_json_extract::read_json(String *str,
   int not_first_value= 0, count_path= 0;
   uint n_arg;
   size_t v_len;
-  int possible_multiple_values;
+  int possible_multiple_values, skip_value= 0;
   int array_size_counter[JSON_DEPTH_LIMIT];
-  uint has_negative_path= 0;
+  uint path_types= 0, has_negative_path;
 
   if ((null_value= args[0]->null_value))
     return 0;
@@ -1080,13 +1094,14 @@ String *Item_func_json_extract::read_json(String *str,
          goto return_null;
        }
        c_path->parsed= c_path->constant;
-       has_negative_path|= c_path->p.types_used & JSON_PATH_NEGATIVE_INDEX;
       }
     }
 
     if (args[n_arg]->null_value)
       goto return_null;
+    path_types|= c_path->p.types_used;
   }
+  has_negative_path= path_types & JSON_PATH_NEGATIVE_INDEX;
 
   possible_multiple_values= arg_count > 2 ||
     (paths[0].p.types_used & (JSON_PATH_WILD | JSON_PATH_DOUBLE_WILD |
@@ -1106,7 +1121,8 @@ String *Item_func_json_extract::read_json(String *str,
   json_get_path_start(&je, js->charset(),(const uchar *) js->ptr(),
                       (const uchar *) js->ptr() + js->length(), &p);
 
-  while (json_get_path_next(&je, &p) == 0)
+  while ((skip_value ? json_skip_path_next(&je, &p) :
+                       json_get_path_next(&je, &p)) == 0)
   {
     if (has_negative_path && je.value_type == JSON_VALUE_ARRAY &&
         json_skip_array_and_count(&je,
@@ -1114,7 +1130,10 @@ String *Item_func_json_extract::read_json(String *str,
       goto error;
 
     if (!(count_path= path_exact(paths, arg_count-1, &p, je.value_type,
-                                 array_size_counter)))
+                                 array_size_counter,
+                                 (path_types & (JSON_PATH_DOUBLE_WILD |
+                                                JSON_PATH_NEGATIVE_INDEX)) ?
+                                 NULL : &skip_value)))
       continue;
 
     value= je.value_begin;
@@ -1524,6 +1524,7 @@ Item_sum_sum::Item_sum_sum(THD *thd, Item_sum_sum *item)
    Type_handler_hybrid_field_type(item),
    direct_added(FALSE), direct_reseted_field(FALSE),
    curr_dec_buff(item->curr_dec_buff),
+   dec_scaled_sum(item->dec_scaled_sum),
    count(item->count)
 {
   /* TODO: check if the following assignments are really needed */
@@ -1560,6 +1561,7 @@ void Item_sum_sum::clear()
   {
     curr_dec_buff= 0;
     my_decimal_set_zero(dec_buffs);
+    dec_scaled_sum= 0;
   }
   else
     sum= 0.0;
@@ -1588,6 +1590,7 @@ void Item_sum_sum::fix_length_and_dec_decimal()
                                                            unsigned_flag);
   curr_dec_buff= 0;
   my_decimal_set_zero(dec_buffs);
+  dec_scaled_sum= 0;
 }
 
 
@@ -1637,6 +1640,45 @@ void Item_sum_sum::direct_add(double add_sum_real, bool add_sum_is_null)
 }
 
 
+/**
+  Add a value to (or subtract it from) dec_scaled_sum.
+
+  @return
+    false if the value has another scale, too many digits, or the
+    result would overflow; the caller should then use dec_buffs
+*/
+
+bool Item_sum_sum::add_scaled(const my_decimal *val, bool subtract)
+{
+  longlong x;
+  if (decimal2scaled_longlong(val, decimals, &x))
+    return false;
+  if (subtract)
+    x= -x;
+  if (x > 0 ? dec_scaled_sum > LONGLONG_MAX - x :
+              dec_scaled_sum < LONGLONG_MIN - x)
+    return false;
+  dec_scaled_sum+= x;
+  return true;
+}
+
+
+/** Move dec_scaled_sum into dec_buffs, before the sum is read */
+
+void Item_sum_sum::flush_scaled_sum()
+{
+  if (dec_scaled_sum)
+  {
+    my_decimal value;
+    scaled_longlong2decimal(dec_scaled_sum, decimals, &value);
+    my_decimal_add(E_DEC_FATAL_ERROR, dec_buffs + (curr_dec_buff ^ 1),
+                   &value, dec_buffs + curr_dec_buff);
+    curr_dec_buff^= 1;
+    dec_scaled_sum= 0;
+  }
+}
+
+
 bool Item_sum_sum::add()
 {
   DBUG_ENTER("Item_sum_sum::add");
@@ -1675,8 +1717,13 @@ void Item_sum_sum::add_helper(bool perform_removal)
         {
           if (count > 0)
           {
-            my_decimal_sub(E_DEC_FATAL_ERROR, dec_buffs + (curr_dec_buff ^ 1),
-              dec_buffs + curr_dec_buff, val);
+            if (!add_scaled(val, true))
+            {
+              my_decimal_sub(E_DEC_FATAL_ERROR,
+                             dec_buffs + (curr_dec_buff ^ 1),
+                             dec_buffs + curr_dec_buff, val);
+              curr_dec_buff^= 1;
+            }
             count--;
           }
           else
@@ -1685,10 +1732,13 @@ void Item_sum_sum::add_helper(bool perform_removal)
         else
         {
           count++;
-          my_decimal_add(E_DEC_FATAL_ERROR, dec_buffs + (curr_dec_buff ^ 1),
-            val, dec_buffs + curr_dec_buff);
+          if (!add_scaled(val, false))
+          {
+            my_decimal_add(E_DEC_FATAL_ERROR, dec_buffs + (curr_dec_buff ^ 1),
+                           val, dec_buffs + curr_dec_buff);
+            curr_dec_buff^= 1;
+          }
         }
-        curr_dec_buff^= 1;
         null_value= (count > 0) ? 0 : 1;
       }
     }
@@ -1740,7 +1790,10 @@ longlong Item_sum_sum::val_int()
   if (aggr)
     aggr->endup();
   if (result_type() == DECIMAL_RESULT)
+  {
+    flush_scaled_sum();
     return dec_buffs[curr_dec_buff].to_longlong(unsigned_flag);
+  }
   return val_int_from_real();
 }
 
@@ -1751,7 +1804,10 @@ double Item_sum_sum::val_real()
   if (aggr)
     aggr->endup();
   if (result_type() == DECIMAL_RESULT)
+  {
+    flush_scaled_sum();
     sum= dec_buffs[curr_dec_buff].to_double();
+  }
   return sum;
 }
 
@@ -1771,7 +1827,10 @@ my_decimal *Item_sum_sum::val_decimal(my_decimal *val)
   if (aggr)
     aggr->endup();
   if (result_type() == DECIMAL_RESULT)
+  {
+    flush_scaled_sum();
     return null_value ? NULL : (dec_buffs + curr_dec_buff);
+  }
   return val_decimal_from_real(val);
 }
 
@@ -1986,6 +2045,172 @@ void Item_sum_count::cleanup()
 }
 
 
+/*
+  Approximate COUNT(DISTINCT)
+*/
+
+/** The 64-bit finalizer of MurmurHash3 */
+static inline ulonglong hll_mix(ulonglong x)
+{
+  x^= x >> 33;
+  x*= 0xff51afd7ed558ccdULL;
+  x^= x >> 33;
+  x*= 0xc4ceb9fe1a85ec53ULL;
+  x^= x >> 33;
+  return x;
+}
+
+
+Item_sum_approx_count_distinct::
+Item_sum_approx_count_distinct(THD *thd, Item *item_par):
+  Item_sum_int(thd, item_par),
+  registers((uchar*) thd->calloc(REGISTERS))
+{
+  quick_group= 0;
+}
+
+
+Item_sum_approx_count_distinct::
+Item_sum_approx_count_distinct(THD *thd, Item_sum_approx_count_distinct *item):
+  Item_sum_int(thd, item),
+  registers((uchar*) thd->calloc(REGISTERS))
+{}
+
+
+/**
+  Hash the value of the argument so that values that compare equal
+  get the same hash.
+
+  @retval true   the argument is NULL
+  @retval false  *hash is set
+*/
+
+bool Item_sum_approx_count_distinct::hash_arg(ulonglong *hash)
+{
+  Item *arg= args[0];
+  switch (arg->cmp_type()) {
+  case INT_RESULT:
+  {
+    longlong nr= arg->val_int();
+    if (arg->null_value)
+      return true;
+    *hash= hll_mix((ulonglong) nr);
+    return false;
+  }
+  case REAL_RESULT:
+  {
+    double nr= arg->val_real();
+    ulonglong bits;
+    if (arg->null_value)
+      return true;
+    if (nr == 0.0)
+      nr= 0.0;                                  // -0.0 is equal to 0.0
+    memcpy(&bits, &nr, sizeof bits);
+    *hash= hll_mix(bits);
+    return false;
+  }
+  case TIME_RESULT:
+  {
+    THD *thd= current_thd;
+    longlong nr= arg->type_handler()->mysql_timestamp_type() ==
+                 MYSQL_TIMESTAMP_TIME ?
+                 arg->val_time_packed(thd) : arg->val_datetime_packed(thd);
+    if (arg->null_value)
+      return true;
+    *hash= hll_mix((ulonglong) nr);
+    return false;
+  }
+  case DECIMAL_RESULT:
+  {
+    my_decimal value, rounded, *dec= arg->val_decimal(&value);
+    String *res;
+    ulong nr1= 1, nr2= 4;
+    if (arg->null_value)
+      return true;
+    /* 1.5 and 1.50 are equal, so hash them without the trailing zeros */
+    res= dec->to_string_round(&tmp_value,
+                              (decimal_digits_t) decimal_actual_fraction(dec),
+                              &rounded);
+    my_charset_bin.hash_sort((const uchar*) res->ptr(), res->length(),
+                             &nr1, &nr2);
+    *hash= hll_mix(hll_mix(nr1) + nr2);
+    return false;
+  }
+  case STRING_RESULT:
+  {
+    String *res= arg->val_str(&tmp_value);
+    ulong nr1= 1, nr2= 4;
+    if (arg->null_value)
+      return true;
+    /* Use the collation so that e.g. 'a' and 'A' are one value in _ci */
+    res->charset()->hash_sort((const uchar*) res->ptr(), res->length(),
+                              &nr1, &nr2);
+    *hash= hll_mix(hll_mix(nr1) + nr2);
+    return false;
+  }
+  case ROW_RESULT:
+    break;
+  }
+  DBUG_ASSERT(0);
+  return true;
+}
+
+
+Item *Item_sum_approx_count_distinct::copy_or_same(THD* thd)
+{
+  return new (thd->mem_root) Item_sum_approx_count_distinct(thd, this);
+}
+
+
+void Item_sum_approx_count_distinct::clear()
+{
+  memset(registers, 0, REGISTERS);
+}
+
+
+bool Item_sum_approx_count_distinct::add()
+{
+  ulonglong hash;
+  if (hash_arg(&hash))
+    return false;
+  uint idx= (uint) (hash >> (64 - PRECISION));
+  ulonglong rest= hash << PRECISION;
+  uchar rank= 1;
+  /* The position of the first 1 bit in the remaining 64-PRECISION bits */
+  while (rank <= 64 - PRECISION && !(rest & (1ULL << 63)))
+  {
+    rest<<= 1;
+    rank++;
+  }
+  if (rank > registers[idx])
+    registers[idx]= rank;
+  return false;
+}
+
+
+longlong Item_sum_approx_count_distinct::val_int()
+{
+  DBUG_ASSERT(fixed());
+  const double m= REGISTERS;
+  double sum= 0.0;
+  uint zeros= 0;
+  for (uint i= 0; i < REGISTERS; i++)
+  {
+    sum+= ldexp(1.0, -(int) registers[i]);
+    if (!registers[i])
+      zeros++;
+  }
+  double estimate= 0.7213 / (1.0 + 1.079 / m) * m * m / sum;
+  /*
+    The raw estimate is biased for small cardinalities; as long as some
+    registers are still empty, linear counting is more accurate.
+  */
+  if (estimate <= 2.5 * m && zeros)
+    estimate= m * log(m / zeros);
+  return (longlong) (estimate + 0.5);
+}
+
+
 /*
   Average
 */
@@ -2063,11 +2288,35 @@ void Item_sum_avg::clear()
 }
 
 
+/**
+  Add the sum and count of a group that were computed elsewhere, such as
+  by the data node of a Spider partition, instead of the next argument.
+*/
+
+void Item_sum_avg::direct_add(my_decimal *add_sum_decimal,
+                              ulonglong add_count)
+{
+  Item_sum_sum::direct_add(add_sum_decimal);
+  direct_count= add_sum_decimal ? add_count : 0;
+}
+
+
+void Item_sum_avg::direct_add(double add_sum_real, bool add_sum_is_null,
+                              ulonglong add_count)
+{
+  Item_sum_sum::direct_add(add_sum_real, add_sum_is_null);
+  direct_count= add_sum_is_null ? 0 : add_count;
+}
+
+
 bool Item_sum_avg::add()
 {
+  bool direct= direct_added;
   if (Item_sum_sum::add())
     return TRUE;
-  if (!aggr->arg_is_null(true))
+  if (unlikely(direct))
+    count+= direct_count;
+  else if (!aggr->arg_is_null(true))
     count++;
   return FALSE;
 }
@@ -2116,6 +2365,7 @@ my_decimal *Item_sum_avg::val_decimal(my_decimal *val)
   if (result_type() != DECIMAL_RESULT)
     return val_decimal_from_real(val);
 
+  flush_scaled_sum();
   sum_dec= dec_buffs + curr_dec_buff;
   int2my_decimal(E_DEC_FATAL_ERROR, count, 0, &cnt);
   my_decimal_div(E_DEC_FATAL_ERROR, val, sum_dec, &cnt, prec_increment);
@@ -2938,6 +3188,24 @@ void Item_sum_avg::reset_field()
 {
   uchar *res=result_field->ptr;
   DBUG_ASSERT (aggr->Aggrtype() != Aggregator::DISTINCT_AGGREGATOR);
+  if (unlikely(direct_added))
+  {
+    direct_added= FALSE;
+    if (result_type() == DECIMAL_RESULT)
+    {
+      /* direct_add() stored zero for a NULL sum */
+      direct_sum_decimal.to_binary(res, f_precision, f_scale);
+      res+= dec_bin_size;
+    }
+    else
+    {
+      double nr= direct_sum_is_null ? 0.0 : direct_sum_real;
+      float8store(res, nr);
+      res+= sizeof(double);
+    }
+    int8store(res, direct_count);
+    return;
+  }
   if (result_type() == DECIMAL_RESULT)
   {
     longlong tmp;
@@ -3076,6 +3344,34 @@ void Item_sum_avg::update_field()
 
   DBUG_ASSERT (aggr->Aggrtype() != Aggregator::DISTINCT_AGGREGATOR);
 
+  if (unlikely(direct_added))
+  {
+    direct_added= FALSE;
+    if (!direct_count)
+      return;
+    if (result_type() == DECIMAL_RESULT)
+    {
+      binary2my_decimal(E_DEC_FATAL_ERROR, res,
+                        dec_buffs + 1, f_precision, f_scale);
+      field_count= sint8korr(res + dec_bin_size);
+      my_decimal_add(E_DEC_FATAL_ERROR, dec_buffs, &direct_sum_decimal,
+                     dec_buffs + 1);
+      dec_buffs->to_binary(res, f_precision, f_scale);
+      res+= dec_bin_size;
+    }
+    else
+    {
+      double old_nr;
+      float8get(old_nr, res);
+      field_count= sint8korr(res + sizeof(double));
+      old_nr+= direct_sum_real;
+      float8store(res, old_nr);
+      res+= sizeof(double);
+    }
+    int8store(res, field_count + direct_count);
+    return;
+  }
+
   if (result_type() == DECIMAL_RESULT)
   {
     VDec tmp(args[0]);
@@ -352,7 +352,7 @@ class Item_sum :public Item_func_or_sum
     CUME_DIST_FUNC, NTILE_FUNC, FIRST_VALUE_FUNC, LAST_VALUE_FUNC,
     NTH_VALUE_FUNC, LEAD_FUNC, LAG_FUNC, PERCENTILE_CONT_FUNC,
     PERCENTILE_DISC_FUNC, SP_AGGREGATE_FUNC, JSON_ARRAYAGG_FUNC,
-    JSON_OBJECTAGG_FUNC
+    JSON_OBJECTAGG_FUNC, APPROX_COUNT_DISTINCT_FUNC
   };
 
   Item **ref_by; /* pointer to a ref to the object used to register it */
@@ -433,6 +433,7 @@ class Item_sum :public Item_func_or_sum
     case UDF_SUM_FUNC:
     case GROUP_CONCAT_FUNC:
     case JSON_ARRAYAGG_FUNC:
+    case APPROX_COUNT_DISTINCT_FUNC:
       return true;
     default:
       return false;
@@ -820,7 +821,15 @@ class Item_sum_sum :public Item_sum_num,
   my_decimal direct_sum_decimal;
   my_decimal dec_buffs[2];
   uint curr_dec_buff;
+  /*
+    Part of a DECIMAL sum that is not yet in dec_buffs, as an integer
+    scaled by 10^decimals. Values with few enough digits are added here,
+    which is much cheaper than my_decimal_add().
+  */
+  longlong dec_scaled_sum;
   bool fix_length_and_dec(THD *thd) override;
+  bool add_scaled(const my_decimal *val, bool subtract);
+  void flush_scaled_sum();
 
 public:
   Item_sum_sum(THD *thd, Item *item_par, bool distinct):
@@ -947,20 +956,76 @@ class Item_sum_count :public Item_sum_int
 };
 
 
+/**
+  APPROX_COUNT_DISTINCT(expr)
+
+  Estimates COUNT(DISTINCT expr) with a HyperLogLog sketch: every non-NULL
+  value is hashed, the top PRECISION bits of the hash select a register and
+  the register keeps the longest run of leading zeros seen in the remaining
+  bits. The memory is fixed (REGISTERS bytes), no Unique tree or temporary
+  file is needed, and the standard error is about 1.04/sqrt(REGISTERS).
+  Small cardinalities are estimated by linear counting, which is nearly
+  exact as long as few registers collide.
+
+  The sketch cannot be kept in a temporary table field, so this function
+  does not support quick_group and grouping is done by sorting.
+*/
+
+class Item_sum_approx_count_distinct :public Item_sum_int
+{
+  static const uint PRECISION= 14;
+  static const uint REGISTERS= 1U << PRECISION;
+  uchar *registers;
+  String tmp_value;
+
+  bool hash_arg(ulonglong *hash);
+
+public:
+  Item_sum_approx_count_distinct(THD *thd, Item *item_par);
+  Item_sum_approx_count_distinct(THD *thd,
+                                 Item_sum_approx_count_distinct *item);
+  enum Sumfunctype sum_func () const override
+  { return APPROX_COUNT_DISTINCT_FUNC; }
+  const Type_handler *type_handler() const override
+  { return &type_handler_slonglong; }
+  bool fix_length_and_dec(THD *thd) override
+  {
+    if (!registers)
+      return true;
+    return Item_sum_int::fix_length_and_dec(thd);
+  }
+  void clear() override;
+  bool add() override;
+  longlong val_int() override;
+  void reset_field() override { DBUG_ASSERT(0); }        // not used
+  void update_field() override { DBUG_ASSERT(0); }       // not used
+  LEX_CSTRING func_name_cstring() const override
+  {
+    static LEX_CSTRING name= { STRING_WITH_LEN("approx_count_distinct(") };
+    return name;
+  }
+  Item *copy_or_same(THD* thd) override;
+  Item *do_get_copy(THD *thd) const override
+  { return get_item_copy<Item_sum_approx_count_distinct>(thd, this); }
+};
+
+
 class Item_sum_avg :public Item_sum_sum
 {
 public:
   // TODO-cvicentiu given that Item_sum_sum now uses a counter of its own, in
   // order to implement remove(), it is possible to remove this member.
   ulonglong count;
+  /* The number of values that the direct_add() sum was computed from */
+  ulonglong direct_count;
   uint prec_increment;
   uint f_precision, f_scale, dec_bin_size;
 
   Item_sum_avg(THD *thd, Item *item_par, bool distinct):
-    Item_sum_sum(thd, item_par, distinct), count(0)
+    Item_sum_sum(thd, item_par, distinct), count(0), direct_count(0)
   {}
   Item_sum_avg(THD *thd, Item_sum_avg *item)
-    :Item_sum_sum(thd, item), count(item->count),
+    :Item_sum_sum(thd, item), count(item->count), direct_count(0),
     prec_increment(item->prec_increment) {}
 
   void fix_length_and_dec_double();
@@ -970,6 +1035,9 @@ class Item_sum_avg :public Item_sum_sum
   {
     return has_with_distinct() ? AVG_DISTINCT_FUNC : AVG_FUNC;
   }
+  void direct_add(my_decimal *add_sum_decimal, ulonglong add_count);
+  void direct_add(double add_sum_real, bool add_sum_is_null,
+                  ulonglong add_count);
   void clear() override;
   bool add() override;
   void remove() override;
@@ -2794,21 +2794,41 @@ bool Item_func_from_unixtime::val_native(THD *thd, Native *to)
 }
 
 
+/*
+  Find the time zone named by arg, or return prev_tz if the name is
+  the same as prev_name, the name prev_tz was found by
+*/
+
+Time_zone *Item_func_convert_tz::find_tz(THD *thd, Item *arg,
+                                         String *prev_name,
+                                         Time_zone *prev_tz)
+{
+  String str;
+  String *name= arg->val_str_ascii(&str);
+  Time_zone *tz;
+
+  if (name && prev_name->length() && !stringcmp(name, prev_name))
+    return prev_tz;
+  if (!(tz= my_tz_find(thd, name)) || prev_name->copy(*name))
+    prev_name->length(0);
+  return tz;
+}
+
+
 bool Item_func_convert_tz::get_date(THD *thd, MYSQL_TIME *ltime,
                                     date_mode_t fuzzydate __attribute__((unused)))
 {
   my_time_t my_time_tmp;
-  String str;
 
   if (!from_tz_cached)
   {
-    from_tz= my_tz_find(thd, args[1]->val_str_ascii(&str));
+    from_tz= find_tz(thd, args[1], &from_tz_name, from_tz);
     from_tz_cached= args[1]->const_item();
   }
 
   if (!to_tz_cached)
   {
-    to_tz= my_tz_find(thd, args[2]->val_str_ascii(&str));
+    to_tz= find_tz(thd, args[2], &to_tz_name, to_tz);
     to_tz_cached= args[2]->const_item();
   }
 
@@ -2838,6 +2858,8 @@ bool Item_func_convert_tz::get_date(THD *thd, MYSQL_TIME *ltime,
 void Item_func_convert_tz::cleanup()
 {
   from_tz_cached= to_tz_cached= 0;
+  from_tz_name.length(0);
+  to_tz_name.length(0);
   Item_datetimefunc::cleanup();
 }
 
@@ -1186,6 +1186,13 @@ class Item_func_convert_tz :public Item_datetimefunc
   */
   bool from_tz_cached, to_tz_cached;
   Time_zone *from_tz, *to_tz;
+  /*
+    Names from_tz and to_tz were found by, so that non-constant time
+    zone arguments are only looked up when they change.
+  */
+  String from_tz_name, to_tz_name;
+  static Time_zone *find_tz(THD *thd, Item *arg, String *prev_name,
+                            Time_zone *prev_tz);
  public:
   Item_func_convert_tz(THD *thd, Item *a, Item *b, Item *c):
     Item_datetimefunc(thd, a, b, c), from_tz_cached(0), to_tz_cached(0) {}
@@ -23,6 +23,7 @@
 #include "item_vectorfunc.h"
 #include "vector_mhnsw.h"
 #include "sql_type_vector.h"
+#include "vector_distance.h"
 
 key_map Item_func_vec_distance_common::part_of_sortkey() const
 {
@@ -52,6 +53,20 @@ double Item_func_vec_distance_common::val_real()
   return calc_distance(v1, v2, (r1->length()) / sizeof(float));
 }
 
+double Item_func_vec_distance_euclidean::calc_distance(float *v1, float *v2,
+                                                      size_t v_len)
+{
+  return sqrt(Vector_float_ops::euclidean2(v1, v2, v_len));
+}
+
+double Item_func_vec_distance_cosine::calc_distance(float *v1, float *v2,
+                                                   size_t v_len)
+{
+  double dotp=0, abs1=0, abs2=0;
+  Vector_float_ops::cosine(v1, v2, v_len, &dotp, &abs1, &abs2);
+  return 1 - dotp/sqrt(abs1*abs2);
+}
+
 bool Item_func_vec_totext::fix_length_and_dec(THD *thd)
 {
   decimals= 0;
@@ -24,11 +24,18 @@
 
 class Item_func_vec_distance_common: public Item_real_func
 {
+  /*
+    The argument, that is constant for one index search. An outer reference
+    in a subquery qualifies too, then a correlated subquery searches
+    the index once per outer row, reusing the search state.
+  */
+  static bool is_search_const(const Item *item)
+  { return !(item->used_tables() & ~OUTER_REF_TABLE_BIT); }
   Item_field *get_field_arg() const
   {
-    if (args[0]->type() == Item::FIELD_ITEM && args[1]->const_item())
+    if (args[0]->type() == Item::FIELD_ITEM && is_search_const(args[1]))
       return (Item_field*)(args[0]);
-    if (args[1]->type() == Item::FIELD_ITEM && args[0]->const_item())
+    if (args[1]->type() == Item::FIELD_ITEM && is_search_const(args[0]))
       return (Item_field*)(args[1]);
     return NULL;
   }
@@ -49,9 +56,9 @@ class Item_func_vec_distance_common: public Item_real_func
   double val_real() override;
   Item *get_const_arg() const
   {
-    if (args[0]->type() == Item::FIELD_ITEM && args[1]->const_item())
+    if (args[0]->type() == Item::FIELD_ITEM && is_search_const(args[1]))
       return args[1];
-    if (args[1]->type() == Item::FIELD_ITEM && args[0]->const_item())
+    if (args[1]->type() == Item::FIELD_ITEM && is_search_const(args[0]))
       return args[0];
     return NULL;
   }
@@ -61,16 +68,7 @@ class Item_func_vec_distance_common: public Item_real_func
 
 class Item_func_vec_distance_euclidean: public Item_func_vec_distance_common
 {
-  double calc_distance(float *v1, float *v2, size_t v_len) override
-  {
-    double d= 0;
-    for (size_t i= 0; i < v_len; i++, v1++, v2++)
-    {
-      float dist= get_float(v1) - get_float(v2);
-      d+= dist * dist;
-    }
-    return sqrt(d);
-  }
+  double calc_distance(float *v1, float *v2, size_t v_len) override;
 
 public:
   Item_func_vec_distance_euclidean(THD *thd, Item *a, Item *b)
@@ -87,18 +85,7 @@ class Item_func_vec_distance_euclidean: public Item_func_vec_distance_common
 
 class Item_func_vec_distance_cosine: public Item_func_vec_distance_common
 {
-  double calc_distance(float *v1, float *v2, size_t v_len) override
-  {
-    double dotp=0, abs1=0, abs2=0;
-    for (size_t i= 0; i < v_len; i++, v1++, v2++)
-    {
-      float f1= get_float(v1), f2= get_float(v2);
-      abs1+= f1 * f1;
-      abs2+= f2 * f2;
-      dotp+= f1 * f2;
-    }
-    return 1 - dotp/sqrt(abs1*abs2);
-  }
+  double calc_distance(float *v1, float *v2, size_t v_len) override;
 
 public:
   Item_func_vec_distance_cosine(THD *thd, Item *a, Item *b)
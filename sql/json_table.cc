@@ -295,6 +295,7 @@ void Json_table_nested_path::scan_start(CHARSET_INFO *i_cs,
 {
   json_get_path_start(&m_engine, i_cs, str, end, &m_cur_path);
   m_cur_nested= NULL;
+  m_skip_value= false;
   m_null= false;
   m_ordinality_counter= 0;
 }
@@ -326,10 +327,20 @@ int Json_table_nested_path::scan_next()
 
   DBUG_ASSERT(!m_cur_nested);
 
-  while (!json_get_path_next(&m_engine, &m_cur_path))
+  while (!(m_skip_value ? json_skip_path_next(&m_engine, &m_cur_path) :
+                          json_get_path_next(&m_engine, &m_cur_path)))
   {
-    if (json_path_compare(&m_path, &m_cur_path, m_engine.value_type,
-                          NULL))
+    int res= json_path_compare(&m_path, &m_cur_path, m_engine.value_type,
+                               NULL);
+    /*
+      Unless the path has '**', paths inside a value that doesn't match
+      or that matched can't match either, so don't scan them. The
+      NESTED PATHs and columns of a found value use their own engines.
+    */
+    m_skip_value= (res == 0 || res == -1) &&
+                  !(m_path.types_used & JSON_PATH_DOUBLE_WILD) &&
+                  !json_value_scalar(&m_engine);
+    if (res)
       continue;
     /* path found. */
     ++m_ordinality_counter;
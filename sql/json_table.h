@@ -97,6 +97,12 @@ class Json_table_nested_path : public Sql_alloc
   /* The child NESTED PATH we're currently scanning */
   Json_table_nested_path *m_cur_nested;
 
+  /*
+    TRUE <=> nothing inside the value m_engine is at can match m_path,
+    so the scan should skip over it.
+  */
+  bool m_skip_value;
+
   static bool column_in_this_or_nested(const Json_table_nested_path *p,
                                        const Json_table_column *jc);
   friend class Table_function_json_table;
@@ -147,6 +147,8 @@ KEY_CACHE *create_key_cache(const char *name, size_t length)
       key_cache->param_block_size=     dflt_key_cache_var.param_block_size;
       key_cache->param_division_limit= dflt_key_cache_var.param_division_limit;
       key_cache->param_age_threshold=  dflt_key_cache_var.param_age_threshold;
+      key_cache->param_scan_resistance=
+        dflt_key_cache_var.param_scan_resistance;
       key_cache->param_partitions=     dflt_key_cache_var.param_partitions;
     }
   }
@@ -486,8 +486,11 @@ class binlog_cache_mngr {
                     ulong *param_ptr_binlog_cache_disk_use,
                     bool precompute_checksums)
     : stmt_cache(precompute_checksums), trx_cache(precompute_checksums),
-      last_commit_pos_offset(0), using_xa(FALSE), xa_xid(0)
+      last_commit_pos_offset(0), using_xa(FALSE), xa_xid(0),
+      writeset_overflow(false), tableset_overflow(false)
   {
+     my_init_dynamic_array(PSI_INSTRUMENT_ME, &writeset, 4, 0, 64, MYF(0));
+     my_init_dynamic_array(PSI_INSTRUMENT_ME, &tableset, 4, 0, 8, MYF(0));
      stmt_cache.set_binlog_cache_info(param_max_binlog_stmt_cache_size,
                                       param_ptr_binlog_stmt_cache_use,
                                       param_ptr_binlog_stmt_cache_disk_use);
@@ -497,6 +500,12 @@ class binlog_cache_mngr {
      last_commit_pos_file[0]= 0;
   }
 
+  ~binlog_cache_mngr()
+  {
+    delete_dynamic(&writeset);
+    delete_dynamic(&tableset);
+  }
+
   void reset(bool do_stmt, bool do_trx)
   {
     if (do_stmt)
@@ -507,6 +516,10 @@ class binlog_cache_mngr {
       using_xa= FALSE;
       last_commit_pos_file[0]= 0;
       last_commit_pos_offset= 0;
+      reset_dynamic(&writeset);
+      writeset_overflow= false;
+      reset_dynamic(&tableset);
+      tableset_overflow= false;
     }
   }
 
@@ -552,6 +565,24 @@ class binlog_cache_mngr {
   //Will be reset when gtid is written into binlog
   uchar  gtid_flags3;
   decltype (rpl_gtid::seq_no) sa_seq_no;
+
+  /*
+    Hashes (4 bytes each, int4store'd) of the unique keys of all rows logged
+    to trx_cache, sent in the GTID event when the transaction commits. Rolled
+    back statements leave their keys behind, which only makes the writeset
+    more conservative. writeset_overflow is set when the writeset can not
+    describe the transaction, e.g. a table without unique keys was changed
+    or --binlog-writeset-max-keys was exceeded.
+  */
+  DYNAMIC_ARRAY writeset;
+  bool writeset_overflow;
+  /*
+    Hashes of the tables of all rows logged to trx_cache. They are sent with
+    the writeset, or instead of it after writeset_overflow, so that a large
+    transaction only conflicts with transactions on the same tables.
+  */
+  DYNAMIC_ARRAY tableset;
+  bool tableset_overflow;
 private:
 
   binlog_cache_mngr& operator=(const binlog_cache_mngr& info);
@@ -2724,7 +2755,8 @@ File open_binlog(IO_CACHE *log, const char *log_file_name, const char **errmsg)
     goto err;
   }
   if (init_io_cache_ext(log, file, (size_t)binlog_file_cache_size, READ_CACHE,
-            0, 0, MYF(MY_WME|MY_DONT_CHECK_FILESIZE), key_file_binlog_cache))
+            0, 0, MYF(MY_WME|MY_DONT_CHECK_FILESIZE|MY_READ_AHEAD),
+            key_file_binlog_cache))
   {
     sql_print_error("Failed to create a cache on log (file '%s')",
                     log_file_name);
@@ -3390,6 +3422,21 @@ bool MYSQL_QUERY_LOG::write(THD *thd, time_t current_time,
                     (ulong) (thd->status_var.bytes_sent - thd->bytes_sent_old)))
       goto err;
 
+    if (thd->stmt_start_cpu_time)
+    {
+      /* FLUSH STATUS may have reset the counter during the statement */
+      ulonglong memory_allocated= thd->status_var.memory_allocated;
+      if (memory_allocated >= thd->memory_allocated_old)
+        memory_allocated-= thd->memory_allocated_old;
+      sprintf(query_time_buff, "%.6f",
+              ulonglong2double(my_getcputime() - thd->stmt_start_cpu_time) /
+              10000000.0);
+      if (my_b_printf(&log_file, "# Cpu_time: %s  Memory_allocated: %s\n",
+                      query_time_buff,
+                      llstr(memory_allocated, llbuff)))
+        goto err;
+    }
+
     if (unlikely(log_slow_verbosity &
                  LOG_SLOW_VERBOSITY_ENGINE) &&
         thd->handler_stats.has_stats())
@@ -3417,6 +3464,34 @@ bool MYSQL_QUERY_LOG::write(THD *thd, time_t current_time,
       goto err;
     }
 
+    if (unlikely(log_slow_verbosity & LOG_SLOW_VERBOSITY_ENGINE) &&
+        (thd->wait_profile.has_waits() || thd->threadpool_queue_time))
+    {
+      const ulonglong *w= thd->wait_profile.time;
+      double tracker_frequency= timer_tracker_frequency();
+      char buffs[5][32];
+      sprintf(buffs[0], "%.6f",
+              ulonglong2double(w[THD_WAIT_ROW_LOCK] + w[THD_WAIT_TABLE_LOCK] +
+                               w[THD_WAIT_GLOBAL_LOCK] +
+                               w[THD_WAIT_USER_LOCK]) / tracker_frequency);
+      sprintf(buffs[1], "%.6f",
+              ulonglong2double(w[THD_WAIT_META_DATA_LOCK]) /
+              tracker_frequency);
+      sprintf(buffs[2], "%.6f",
+              ulonglong2double(w[THD_WAIT_BINLOG] + w[THD_WAIT_GROUP_COMMIT] +
+                               w[THD_WAIT_SYNC]) / tracker_frequency);
+      sprintf(buffs[3], "%.6f",
+              ulonglong2double(w[THD_WAIT_DISKIO]) / tracker_frequency);
+      sprintf(buffs[4], "%.6f",
+              ulonglong2double(thd->threadpool_queue_time) / 1000000.0);
+      if (my_b_printf(&log_file,
+                      "# Lock_wait_time: %s  Mdl_wait_time: %s  "
+                      "Commit_wait_time: %s  Io_wait_time: %s  "
+                      "Queue_time: %s\n",
+                      buffs[0], buffs[1], buffs[2], buffs[3], buffs[4]))
+        goto err;
+    }
+
     if ((log_slow_verbosity & LOG_SLOW_VERBOSITY_QUERY_PLAN))
     {
       if (thd->tmp_tables_used &&
@@ -6093,7 +6168,7 @@ bool MYSQL_BIN_LOG::append_no_lock(Log_event* ev,
   DBUG_RETURN(error);
 }
 
-bool MYSQL_BIN_LOG::write_event_buffer(uchar* buf, uint len)
+bool MYSQL_BIN_LOG::write_event_buffer(uchar* buf, uint len, bool flush)
 {
   bool error= 1;
   uchar *ebuf= 0;
@@ -6143,8 +6218,21 @@ bool MYSQL_BIN_LOG::write_event_buffer(uchar* buf, uint len)
 
   error= 0;
   DBUG_PRINT("info",("max_size: %lu",max_size));
-  if (flush_and_sync(0))
-    goto err;
+  {
+    /*
+      Without flush, the event may stay in the append buffer, where the SQL
+      thread reads it from. Still count it towards sync_relay_log and flush
+      and sync when that is due.
+    */
+    uint sync_period= get_sync_period();
+    if (flush || (sync_period && sync_counter + 1 >= sync_period))
+    {
+      if (flush_and_sync(0))
+        goto err;
+    }
+    else if (sync_period)
+      sync_counter++;
+  }
   if (my_b_append_tell(&log_file) > max_size)
     error= new_file_without_locking(false);
 err:
@@ -6337,10 +6425,10 @@ static binlog_cache_mngr *binlog_setup_cache_mngr(THD *thd)
   if (!cache_mngr ||
       open_cached_file(&cache_mngr->stmt_cache.cache_log, binlog_cache_dir,
                        LOG_PREFIX, (size_t) binlog_stmt_cache_size,
-                       MYF(MY_WME | MY_TRACK_WITH_LIMIT)) ||
+                       MYF(MY_WME | MY_TRACK_WITH_LIMIT | MY_READ_AHEAD)) ||
       open_cached_file(&cache_mngr->trx_cache.cache_log, binlog_cache_dir,
                        LOG_PREFIX, (size_t) binlog_cache_size,
-                       MYF(MY_WME | MY_TRACK_WITH_LIMIT)))
+                       MYF(MY_WME | MY_TRACK_WITH_LIMIT | MY_READ_AHEAD)))
   {
     my_free(cache_mngr);
     return NULL;
@@ -6770,6 +6858,113 @@ binlog_cache_data* binlog_get_cache_data(binlog_cache_mngr *cache_mngr,
   return cache_mngr->get_binlog_cache_data(use_trans_cache);
 }
 
+
+/*
+  Add the hashes of the unique keys of one row image to the writeset.
+
+  Keys with a NULL part can not conflict and are skipped. If a key part was
+  neither read nor (for the after image of an update) written, the row image
+  does not tell which key values were touched and the whole writeset is
+  given up.
+*/
+static bool binlog_add_writeset_row(binlog_cache_mngr *cache_mngr,
+                                    TABLE *table, const uchar *record,
+                                    bool check_read_set,
+                                    const MY_BITMAP *written)
+{
+  my_ptrdiff_t diff= record - table->record[0];
+  bool found= false;
+
+  for (uint keynr= 0; keynr < table->s->keys; keynr++)
+  {
+    KEY *key= table->key_info + keynr;
+    KEY_PART_INFO *key_part= key->key_part;
+    KEY_PART_INFO *key_part_end= key_part + key->user_defined_key_parts;
+    uchar keynr_buf[2];
+    Hasher hasher;
+    bool has_null= false;
+
+    if (!(key->flags & HA_NOSAME))
+      continue;
+    for (; key_part < key_part_end; key_part++)
+    {
+      Field *field= key_part->field;
+      if (check_read_set &&
+          !bitmap_is_set(table->read_set, field->field_index) &&
+          !(written && bitmap_is_set(written, field->field_index)))
+        return true;
+      field->move_field_offset(diff);
+      has_null|= field->is_null();
+      field->hash(&hasher);
+      field->move_field_offset(-diff);
+    }
+    found= true;
+    if (has_null)
+      continue;
+
+    /* table_cache_key is "db\0table\0" */
+    hasher.add(&my_charset_bin, table->s->table_cache_key.str,
+               table->s->table_cache_key.length);
+    int2store(keynr_buf, keynr);
+    hasher.add(&my_charset_bin, keynr_buf, sizeof(keynr_buf));
+
+    uchar hash_buf[4];
+    int4store(hash_buf, hasher.finalize());
+    if (cache_mngr->writeset.elements >= opt_binlog_writeset_max_keys ||
+        insert_dynamic(&cache_mngr->writeset, hash_buf))
+      return true;
+  }
+  /* Without a unique key there is no way to tell rows apart */
+  return !found;
+}
+
+
+/* Add the hash of the table of a row change to the tableset. */
+static bool binlog_add_tableset(binlog_cache_mngr *cache_mngr,
+                                const TABLE *table)
+{
+  Hasher hasher;
+  uchar hash_buf[4];
+
+  hasher.add(&my_charset_bin, table->s->table_cache_key.str,
+             table->s->table_cache_key.length);
+  int4store(hash_buf, hasher.finalize());
+  for (uint i= 0; i < cache_mngr->tableset.elements; i++)
+    if (!memcmp(cache_mngr->tableset.buffer + 4 * i, hash_buf, 4))
+      return false;
+  return cache_mngr->tableset.elements >= opt_binlog_writeset_max_keys ||
+         insert_dynamic(&cache_mngr->tableset, hash_buf);
+}
+
+
+/**
+  Record the unique keys of a row change in the writeset of the transaction.
+
+  Called for every row logged to the transaction cache when
+  --binlog-writeset-max-keys is non-zero.
+*/
+void binlog_add_writeset(THD *thd, TABLE *table, const uchar *before_record,
+                         const uchar *after_record)
+{
+  binlog_cache_mngr *cache_mngr= thd->binlog_get_cache_mngr();
+
+  if (!cache_mngr->tableset_overflow &&
+      binlog_add_tableset(cache_mngr, table))
+    cache_mngr->tableset_overflow= true;
+  if (cache_mngr->writeset_overflow)
+    return;
+  if ((before_record &&
+       binlog_add_writeset_row(cache_mngr, table, before_record, true,
+                               NULL)) ||
+      (after_record &&
+       binlog_add_writeset_row(cache_mngr, table, after_record,
+                               before_record != NULL, table->write_set)))
+  {
+    cache_mngr->writeset_overflow= true;
+    reset_dynamic(&cache_mngr->writeset);
+  }
+}
+
 int binlog_flush_pending_rows_event(THD *thd, bool stmt_end,
                                     bool is_transactional,
                                     Event_log *bin_log,
@@ -6989,6 +7184,54 @@ Event_log::prepare_pending_rows_event(THD *thd, TABLE* table,
 }
 
 
+static int cmp_writeset_key(const void *a, const void *b)
+{
+  return memcmp(a, b, 4);
+}
+
+
+/*
+  Attach the deduplicated writeset and the tableset of the transaction to
+  its GTID event. If the writeset overflowed, only the tableset is sent.
+
+  Only transactions that were logged purely as row events from the
+  transaction cache get one: statements logged in statement format
+  (including those replicated from a master) change rows that were never
+  seen by binlog_add_writeset().
+*/
+static void binlog_set_writeset(THD *thd, Gtid_log_event *gtid_event)
+{
+  binlog_cache_mngr *cache_mngr= thd->binlog_get_cache_mngr();
+  DYNAMIC_ARRAY *writeset;
+
+  if (!cache_mngr || cache_mngr->tableset_overflow ||
+      !cache_mngr->tableset.elements || !cache_mngr->stmt_cache.empty() ||
+      thd->rgi_slave ||
+      thd->variables.binlog_format != BINLOG_FORMAT_ROW ||
+      !(gtid_event->flags2 & Gtid_log_event::FL_TRANSACTIONAL))
+    return;
+
+  gtid_event->tableset_count= (uint16) cache_mngr->tableset.elements;
+  gtid_event->tableset= cache_mngr->tableset.buffer;
+  gtid_event->flags_extra|= Gtid_log_event::FL_EXTRA_TABLESET;
+  if (cache_mngr->writeset_overflow || !cache_mngr->writeset.elements)
+    return;
+
+  writeset= &cache_mngr->writeset;
+  sort_dynamic(writeset, cmp_writeset_key);
+  uint count= 1;
+  for (uint i= 1; i < writeset->elements; i++)
+    if (memcmp(writeset->buffer + 4 * i, writeset->buffer + 4 * (count - 1),
+               4))
+      memcpy(writeset->buffer + 4 * count++, writeset->buffer + 4 * i, 4);
+  writeset->elements= count;
+
+  gtid_event->writeset_count= (uint16) count;
+  gtid_event->writeset= writeset->buffer;
+  gtid_event->flags_extra|= Gtid_log_event::FL_EXTRA_WRITESET;
+}
+
+
 /* Generate a new global transaction ID, and write it to the binlog */
 
 bool
@@ -7065,6 +7308,8 @@ MYSQL_BIN_LOG::write_gtid_event(THD *thd, bool standalone,
 
   if (unlikely(commit_by_rotate))
     gtid_event.pad_to_size= binlog_commit_by_rotate.get_gtid_event_pad_data_size();
+  else if (opt_binlog_writeset_max_keys)
+    binlog_set_writeset(thd, &gtid_event);
 
   if (write_event(&gtid_event))
     DBUG_RETURN(true);
@@ -8855,6 +9100,26 @@ MYSQL_BIN_LOG::write_transaction_to_binlog_events(group_commit_entry *entry)
 bool
 MYSQL_BIN_LOG::write_transaction_with_group_commit(group_commit_entry *entry)
 {
+  /*
+    A failure here sets the error flag of the cache, which is reported by
+    write_transaction_or_stmt().
+  */
+  if (entry->using_stmt_cache)
+    (void) entry->cache_mngr->stmt_cache.flush_spilled();
+  if (entry->using_trx_cache)
+    (void) entry->cache_mngr->trx_cache.flush_spilled();
+  /*
+    Larger caches are normally renamed to a binlog file instead of being
+    copied, see Binlog_commit_by_rotate. The rest of the cache is read
+    ahead while it is copied, see MY_READ_AHEAD in binlog_setup_cache_mngr().
+  */
+  if (entry->using_stmt_cache)
+    entry->cache_mngr->stmt_cache.
+      prefetch_spilled(opt_binlog_commit_by_rotate_threshold);
+  if (entry->using_trx_cache)
+    entry->cache_mngr->trx_cache.
+      prefetch_spilled(opt_binlog_commit_by_rotate_threshold);
+
   int is_leader= queue_for_group_commit(entry);
 
 #ifdef WITH_WSREP
@@ -1037,7 +1037,18 @@ class MYSQL_BIN_LOG: public TC_LOG, private Event_log
   }
   bool write_event(Log_event *ev);
 
-  bool write_event_buffer(uchar* buf,uint len);
+  bool write_event_buffer(uchar* buf,uint len, bool flush= true);
+  /*
+    Write out events that write_event_buffer() left in the append buffer,
+    for readers that open the relay log file themselves.
+  */
+  void flush_relay_log_buffer()
+  {
+    mysql_mutex_lock(&LOCK_log);
+    if (is_open())
+      flush_io_cache(&log_file);
+    mysql_mutex_unlock(&LOCK_log);
+  }
   bool append(Log_event* ev, enum enum_binlog_checksum_alg checksum_alg);
   bool append_no_lock(Log_event* ev, enum enum_binlog_checksum_alg checksum_alg);
 
@@ -1407,6 +1418,8 @@ int online_alter_log_row(TABLE* table, const uchar *before_record,
                          const uchar *after_record, Log_func *log_func);
 binlog_cache_data* binlog_get_cache_data(binlog_cache_mngr *cache_mngr,
                                          bool use_trans_cache);
+void binlog_add_writeset(THD *thd, TABLE *table, const uchar *before_record,
+                         const uchar *after_record);
 
 extern MYSQL_PLUGIN_IMPORT MYSQL_BIN_LOG mysql_bin_log;
 extern transaction_participant binlog_tp;
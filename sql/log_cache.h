@@ -216,6 +216,37 @@ class binlog_cache_data
     return reinit_io_cache(&cache_log, READ_CACHE, m_file_reserved_bytes, 0, 0);
   }
 
+  /**
+    Write out the buffered tail of a cache that has already spilled to its
+    temporary file. The committing thread calls this before it queues for
+    group commit, so that init_for_read() has no file write left to do
+    while the group commit leader holds LOCK_log. Caches that still fit in
+    memory are left alone, they are copied without any file I/O.
+  */
+  bool flush_spilled()
+  {
+    if (cache_log.type == WRITE_CACHE && cache_log.file != -1 &&
+        cache_log.pos_in_file > m_file_reserved_bytes)
+      return my_b_flush_io_cache(&cache_log, 1);
+    return false;
+  }
+
+  /**
+    Ask the operating system to read the spilled part of the cache back
+    into memory in the background, after flush_spilled(). The copy to the
+    binlog that the group commit leader does under LOCK_log will then not
+    have to wait for the disk, also if the pages had been evicted.
+
+    @param max_length  maximum number of bytes to prefetch
+  */
+  void prefetch_spilled(my_off_t max_length)
+  {
+    if (cache_log.file != -1 && cache_log.pos_in_file > m_file_reserved_bytes)
+      my_b_prefetch(&cache_log, m_file_reserved_bytes,
+                    (size_t) MY_MIN(cache_log.pos_in_file -
+                                    m_file_reserved_bytes, max_length));
+  }
+
   /**
     For session's binlog cache, it have to call this function to get the
     actual data length.
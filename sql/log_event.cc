@@ -590,6 +590,41 @@ uint32 binlog_get_uncompress_len(const uchar *buf)
   return len;
 }
 
+/**
+  A zlib inflate stream kept for the life of the thread.
+
+  uncompress() allocates and initializes a new inflate state, including
+  its 32K window, for every call. For the small events that are typical
+  in a binlog this costs more than the decompression itself, and a slave
+  or mysqlbinlog pays it for every compressed event it reads. Resetting
+  an existing stream is enough.
+*/
+class Binlog_inflate_stream
+{
+  z_stream m_stream;
+  bool m_inited;
+public:
+  Binlog_inflate_stream() : m_inited(false) {}
+  ~Binlog_inflate_stream()
+  {
+    if (m_inited)
+      inflateEnd(&m_stream);
+  }
+  /** @return reset stream, or NULL if it could not be initialized */
+  z_stream *get()
+  {
+    if (m_inited)
+      return inflateReset(&m_stream) == Z_OK ? &m_stream : NULL;
+    memset(&m_stream, 0, sizeof m_stream);
+    if (inflateInit(&m_stream) != Z_OK)
+      return NULL;
+    m_inited= true;
+    return &m_stream;
+  }
+};
+
+static thread_local Binlog_inflate_stream binlog_inflate_stream;
+
 /**
    Uncompress the content in 'src' with length of 'len' to 'dst'.
 
@@ -613,11 +648,20 @@ int binlog_buf_uncompress(const uchar *src, uchar *dst, uint32 len,
   uint32 alg= (src[0] & 0x70) >> 4;
   switch(alg) {
   case 0:
+  {
     // zlib
-    if (uncompress((Bytef *)dst, &buflen,
-      (const Bytef*)src + 1 + lenlen, len - 1 - lenlen) != Z_OK)
+    z_stream *stream= binlog_inflate_stream.get();
+    if (!stream)
+      return 1;
+    stream->next_in= (Bytef *)src + 1 + lenlen;
+    stream->avail_in= (uInt)(len - 1 - lenlen);
+    stream->next_out= (Bytef *)dst;
+    stream->avail_out= (uInt)buflen;
+    if (inflate(stream, Z_FINISH) != Z_STREAM_END)
       return 1;
+    buflen= stream->total_out;
     break;
+  }
   default:
     //TODO
     //bad algorithm
@@ -2411,7 +2455,8 @@ Gtid_log_event::Gtid_log_event(const uchar *buf, uint event_len,
                                const Format_description_log_event
                                *description_event)
   : Log_event(buf, description_event), seq_no(0), commit_id(0),
-    flags_extra(0), extra_engines(0), thread_id(0)
+    flags_extra(0), extra_engines(0), thread_id(0), writeset_count(0),
+    writeset(NULL), tableset_count(0), tableset(NULL)
 {
   uint8 header_size= description_event->common_header_len;
   uint8 post_header_len= description_event->post_header_len[GTID_EVENT-1];
@@ -2496,6 +2541,34 @@ Gtid_log_event::Gtid_log_event(const uchar *buf, uint event_len,
       thread_id= uint4korr(buf);
       buf+= 4;
     }
+
+    if (flags_extra & FL_EXTRA_WRITESET)
+    {
+      if (event_len < static_cast<uint>(buf - buf_0) + 2 ||
+          event_len < static_cast<uint>(buf - buf_0) + 2 +
+                      4 * (uint) uint2korr(buf))
+      {
+        seq_no= 0;
+        return;
+      }
+      writeset_count= uint2korr(buf);
+      writeset= buf + 2;
+      buf+= 2 + 4 * (uint) writeset_count;
+    }
+
+    if (flags_extra & FL_EXTRA_TABLESET)
+    {
+      if (event_len < static_cast<uint>(buf - buf_0) + 2 ||
+          event_len < static_cast<uint>(buf - buf_0) + 2 +
+                      4 * (uint) uint2korr(buf))
+      {
+        seq_no= 0;
+        return;
+      }
+      tableset_count= uint2korr(buf);
+      tableset= buf + 2;
+      buf+= 2 + 4 * (uint) tableset_count;
+    }
   }
   /*
     the strict '<' part of the assert corresponds to extra zero-padded
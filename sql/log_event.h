@@ -3360,6 +3360,16 @@ class Gtid_log_event: public Log_event
   */
   uint8 extra_engines;
   my_thread_id thread_id;
+  /*
+    Number of unique key hashes and the hashes themselves (int4store'd) of
+    the rows changed by the transaction, see FL_EXTRA_WRITESET. On the slave
+    the hashes point into the event buffer.
+  */
+  uint16 writeset_count;
+  const uchar *writeset;
+  /* The same for the hashes of the changed tables, see FL_EXTRA_TABLESET */
+  uint16 tableset_count;
+  const uchar *tableset;
 
   /* Flags2. */
 
@@ -3406,12 +3416,30 @@ class Gtid_log_event: public Log_event
   static const uchar FL_COMMIT_ALTER_E1= 4;
   static const uchar FL_ROLLBACK_ALTER_E1= 8;
   static const uchar FL_EXTRA_THREAD_ID= 16; // thread_id like in BEGIN Query
+  /*
+    FL_EXTRA_WRITESET is set when the event carries the hashes of all unique
+    keys touched by the transaction (--binlog-writeset-max-keys), so that
+    --slave-parallel-mode=writeset can run non-overlapping transactions in
+    parallel. The data is a 2-byte count followed by 4-byte hashes, written
+    after everything else.
+  */
+  static const uchar FL_EXTRA_WRITESET= 32;
+  /*
+    FL_EXTRA_TABLESET is set when the event carries the hashes of the tables
+    changed by the transaction, as a 2-byte count and 4-byte hashes after the
+    writeset. It is also set without FL_EXTRA_WRITESET when the transaction
+    has too many keys, so that it only conflicts with event groups that
+    change the same tables.
+  */
+  static const uchar FL_EXTRA_TABLESET= 64;
 
 #ifdef MYSQL_SERVER
   static const uint max_data_length= GTID_HEADER_LEN + 2 + sizeof(XID)
                                      + 1 /* flags_extra: */
                                      + 4 /* Extra Engines */
-                                     + 4 /* FL_EXTRA_THREAD_ID */;
+                                     + 4 /* FL_EXTRA_THREAD_ID */
+                                     + 2 /* FL_EXTRA_WRITESET count */
+                                     + 2 /* FL_EXTRA_TABLESET count */;
 
   Gtid_log_event(THD *thd_arg, uint64 seq_no, uint32 domain_id, bool standalone,
                  uint16 flags, bool is_transactional, uint64 commit_id,
@@ -3444,6 +3472,18 @@ class Gtid_log_event: public Log_event
     return seq_no != 0;
   }
 
+  uint32 writeset_key(uint i) const
+  {
+    DBUG_ASSERT(i < writeset_count);
+    return uint4korr(writeset + 4 * i);
+  }
+
+  uint32 tableset_key(uint i) const
+  {
+    DBUG_ASSERT(i < tableset_count);
+    return uint4korr(tableset + 4 * i);
+  }
+
 #ifdef MYSQL_SERVER
   bool write(Log_event_writer *writer) override;
   static int make_compatible_event(String *packet, bool *need_dummy_event,
@@ -4916,6 +4956,7 @@ class Rows_log_event : public Log_event
   int find_key(const rpl_group_info *); // Find a best key to use in find_row()
   uint find_key_parts(const KEY *key) const;
   bool use_pk_position() const;
+  bool use_continued_table_scan() const;
   int find_row(rpl_group_info *);
   int write_row(rpl_group_info *, const bool);
   int update_sequence();
@@ -2850,7 +2850,8 @@ Gtid_log_event::Gtid_log_event(THD *thd_arg, uint64 seq_no_arg,
     pad_to_size(0), flags2((standalone ? FL_STANDALONE : 0) |
            (commit_id_arg ? FL_GROUP_COMMIT_ID : 0)),
     flags_extra(0), extra_engines(0),
-    thread_id(thd_arg->variables.pseudo_thread_id)
+    thread_id(thd_arg->variables.pseudo_thread_id), writeset_count(0),
+    writeset(NULL), tableset_count(0), tableset(NULL)
 {
   cache_type= Log_event::EVENT_NO_CACHE;
   bool is_tmp_table= thd_arg->lex->stmt_accessed_temp_table();
@@ -3042,6 +3043,40 @@ Gtid_log_event::write(Log_event_writer *writer)
     write_len+= 4;
   }
 
+  /*
+    The writeset and tableset hashes follow everything else and are written
+    directly from the binlog cache manager's arrays. They are never combined
+    with padding, as the space reserved in a renamed binlog cache does not
+    account for them.
+  */
+  if (flags_extra & (FL_EXTRA_WRITESET | FL_EXTRA_TABLESET))
+  {
+    size_t writeset_len= 0, tableset_len= 0;
+    uchar tableset_count_buf[2];
+    DBUG_ASSERT(!pad_to_size);
+    if (flags_extra & FL_EXTRA_WRITESET)
+    {
+      DBUG_ASSERT(writeset_count > 0);
+      int2store(buf + write_len, writeset_count);
+      write_len+= 2;
+      writeset_len= 4 * (size_t) writeset_count;
+    }
+    if (flags_extra & FL_EXTRA_TABLESET)
+    {
+      DBUG_ASSERT(tableset_count > 0);
+      int2store(tableset_count_buf, tableset_count);
+      tableset_len= 4 * (size_t) tableset_count;
+    }
+    return write_header(writer, write_len + writeset_len +
+                        (tableset_len ? 2 + tableset_len : 0)) ||
+           write_data(writer, buf, write_len) ||
+           (writeset_len && write_data(writer, writeset, writeset_len)) ||
+           (tableset_len &&
+            (write_data(writer, tableset_count_buf, 2) ||
+             write_data(writer, tableset, tableset_len))) ||
+           write_footer(writer);
+  }
+
   if (write_len < GTID_HEADER_LEN)
   {
     bzero(buf+write_len, GTID_HEADER_LEN-write_len);
@@ -7501,6 +7536,18 @@ bool Rows_log_event::use_pk_position() const
       && m_usable_key_parts == m_table->key_info->user_defined_key_parts;
 }
 
+/**
+  Whether find_row() keeps its table scan open from one row of the event
+  to the next, rather than starting a new scan for every row.
+
+  Not done for versioned tables, where applying a row may insert a history
+  row into the table being scanned.
+*/
+bool Rows_log_event::use_continued_table_scan() const
+{
+  return !m_key_info && !m_table->versioned();
+}
+
 static int end_of_file_error(rpl_group_info *rgi)
 {
   return rgi->speculation != rpl_group_info::SPECULATE_OPTIMISTIC
@@ -7535,7 +7582,9 @@ static int end_of_file_error(rpl_group_info *rgi)
 
   Note that one MUST call ha_index_or_rnd_end() after this function if
   it returns 0 as we must leave the row position in the handler intact
-  for any following update/delete command.
+  for any following update/delete command. A table scan is the exception
+  when use_continued_table_scan() is true: it is left open for the next
+  row and ended in do_after_row_operations().
 */
 
 int Rows_log_event::find_row(rpl_group_info *rgi)
@@ -7767,8 +7816,20 @@ int Rows_log_event::find_row(rpl_group_info *rgi)
     /* We use this to test that the correct key is used in test cases. */
     DBUG_EXECUTE_IF("slave_crash_if_table_scan", abort(););
 
-    /* We don't have a key: search the table using rnd_next() */
-    if (unlikely((error= table->file->ha_rnd_init_with_error(1))))
+    /*
+      We don't have a key: search the table using rnd_next().
+
+      The scan may still be open from the previous row of this event. Rows
+      are normally logged in the order the master found them, which for a
+      table without usable keys is the order of a table scan, so the row
+      is usually found right after the previous one. Only when the end of
+      the table is reached without finding it, start over from the
+      beginning, once. This makes applying an event of N rows one pass
+      over the table in the common case instead of N.
+    */
+    bool full_scan= table->file->inited != handler::RND;
+    if (full_scan &&
+        unlikely((error= table->file->ha_rnd_init_with_error(1))))
     {
       DBUG_PRINT("info",("error initializing table scan"
                          " (ha_rnd_init returns %d)",error));
@@ -7778,7 +7839,7 @@ int Rows_log_event::find_row(rpl_group_info *rgi)
     is_table_scan= true;
 
     /* Continue until we find the right record or have made a full loop */
-    do
+    for (;;)
     {
       if (unlikely((error= table->file->ha_rnd_next(table->record[0]))))
         DBUG_PRINT("info", ("error: %s", HA_ERR(error)));
@@ -7789,6 +7850,15 @@ int Rows_log_event::find_row(rpl_group_info *rgi)
         break;
 
       case HA_ERR_END_OF_FILE:
+        if (!full_scan)
+        {
+          DBUG_PRINT("info", ("Restarting table scan from the beginning"));
+          table->file->ha_rnd_end();
+          if (unlikely((error= table->file->ha_rnd_init_with_error(1))))
+            goto end;
+          full_scan= true;
+          continue;
+        }
         error= end_of_file_error(rgi);
         DBUG_PRINT("info", ("Record not found"));
         table->file->ha_rnd_end();
@@ -7801,9 +7871,10 @@ int Rows_log_event::find_row(rpl_group_info *rgi)
         table->file->ha_rnd_end();
         goto end;
       }
+      if (!record_compare(table, m_vers_from_plain))
+        break;
     }
-    while (record_compare(table, m_vers_from_plain));
-    
+
     /* 
       Note: above record_compare will take into accout all record fields 
       which might be incorrect in case a partial row was given in the event
@@ -7941,7 +8012,8 @@ int Delete_rows_log_event::do_exec_row(rpl_group_info *rgi)
     if (invoke_triggers && likely(!error) &&
         unlikely(process_triggers(TRG_EVENT_DELETE, TRG_ACTION_AFTER, FALSE)))
       error= HA_ERR_GENERIC; // in case if error is not set yet
-    m_table->file->ha_index_or_rnd_end();
+    if (!use_continued_table_scan())
+      m_table->file->ha_index_or_rnd_end();
   }
   thd_proc_info(thd, tmp);
   return error;
@@ -8174,7 +8246,8 @@ Update_rows_log_event::do_exec_row(rpl_group_info *rgi)
 
 err:
   thd_proc_info(thd, tmp);
-  m_table->file->ha_index_or_rnd_end();
+  if (!use_continued_table_scan())
+    m_table->file->ha_index_or_rnd_end();
   return error;
 }
 
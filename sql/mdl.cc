@@ -162,6 +162,12 @@ void MDL_key::init_psi_keys()
 
 static bool mdl_initialized= 0;
 
+/** @@metadata_locks_fast_path: whether the fast path may be used */
+my_bool opt_mdl_fast_path= 0;
+
+/** Number of shards of the MDL_lock fast path counters */
+#define MDL_FAST_PATH_SHARDS 8
+
 
 /**
   A collection of all MDL locks. A singleton,
@@ -174,6 +180,8 @@ class MDL_map
   void init();
   void destroy();
   MDL_lock *find_or_insert(LF_PINS *pins, const MDL_key *key);
+  MDL_lock *fast_path_acquire(LF_PINS *pins, const MDL_key *key, uint shard,
+                              enum_mdl_type type);
   unsigned long get_lock_owner(LF_PINS *pins, const MDL_key *key);
   void remove(LF_PINS *pins, MDL_lock *lock);
   LF_PINS *get_pins() { return lf_hash_get_pins(&m_locks); }
@@ -648,12 +656,92 @@ class MDL_lock
   */
   ulong m_hog_lock_count;
 
+  /**
+    "Fast path" for table locks.
+
+    S, SH, SR and SW locks, which are taken by every SELECT and DML
+    statement, are compatible with each other and only conflict with
+    SU, SRO, SNW, SNRW and X. While none of the latter are granted or
+    waiting, such "unobtrusive" locks are granted without m_rwlock by
+    incrementing a counter in m_fast_path. Their tickets are not in
+    m_granted.
+
+    The counters are split in MDL_FAST_PATH_SHARDS shards (each context
+    uses one of them, see MDL_context::m_fast_path_shard), on different
+    cache lines, so that concurrent statements on a hot table don't
+    contend on the same cache line. Each shard holds one
+    FAST_PATH_COUNT_BITS wide counter per unobtrusive lock type and
+    the flags FAST_PATH_OBTRUSIVE and FAST_PATH_DESTROYED.
+
+    A request for an obtrusive lock sets FAST_PATH_OBTRUSIVE in all
+    shards under m_rwlock before checking for conflicts, after which
+    no new fast path locks can be granted. Such requests take the
+    counters into account in can_grant_lock(). Fast path locks which
+    are released while the flag is set go through m_rwlock and
+    reschedule the waiters. The flag is cleared once no obtrusive
+    tickets are left (@see update_fast_path_flags()).
+
+    Parts of the code which need to see all tickets of a context make
+    the context move its fast path tickets to m_granted first
+    (@see MDL_context::materialize_fast_path_locks()). This is done
+    before a context starts waiting, so that the deadlock detector sees
+    its tickets, before it requests an obtrusive lock, so that its own
+    tickets are recognized by can_grant_lock(), and when it starts to
+    need thr_lock aborts, so that notify_conflicting_locks() finds it.
+  */
+  struct fast_path_shard
+  {
+    std::atomic<uint64_t> state;
+    char pad[CPU_LEVEL1_DCACHE_LINESIZE - sizeof(std::atomic<uint64_t>)];
+  };
+  static constexpr uint FAST_PATH_COUNT_BITS= 15;
+  static constexpr uint64_t FAST_PATH_COUNT_MAX=
+    (1ULL << FAST_PATH_COUNT_BITS) - 1;
+  static constexpr uint64_t FAST_PATH_COUNTS= (1ULL << 60) - 1;
+  static constexpr uint64_t FAST_PATH_OBTRUSIVE= 1ULL << 62;
+  static constexpr uint64_t FAST_PATH_DESTROYED= 1ULL << 63;
+  static constexpr uint64_t FAST_PATH_FLAGS=
+    FAST_PATH_OBTRUSIVE | FAST_PATH_DESTROYED;
+  static constexpr bitmap_t FAST_PATH_TYPES=
+    MDL_BIT(MDL_SHARED) | MDL_BIT(MDL_SHARED_HIGH_PRIO) |
+    MDL_BIT(MDL_SHARED_READ) | MDL_BIT(MDL_SHARED_WRITE);
+
+  static bool is_fast_path_key(const MDL_key *key)
+  { return key->mdl_namespace() == MDL_key::TABLE; }
+  static uint64_t fast_path_unit(enum_mdl_type type)
+  {
+    DBUG_ASSERT(MDL_BIT(type) & FAST_PATH_TYPES);
+    return 1ULL << ((type - MDL_SHARED) * FAST_PATH_COUNT_BITS);
+  }
+
+  bool fast_path_acquire(uint shard, enum_mdl_type type);
+  void fast_path_release(LF_PINS *pins, uint shard, enum_mdl_type type);
+  void fast_path_materialize(uint shard, MDL_ticket *ticket);
+  bitmap_t fast_path_granted_bitmap() const;
+  bool fast_path_used(uint except_shard) const;
+  void fast_path_set_obtrusive();
+  void update_fast_path_flags();
+  bool fast_path_mark_destroyed();
+  void fast_path_reset()
+  {
+    for (auto &s : m_fast_path)
+      s.state.store(0, std::memory_order_relaxed);
+  }
+  void unlock_or_remove(LF_PINS *pins);
+
+private:
+  char m_fast_path_pad[CPU_LEVEL1_DCACHE_LINESIZE];
+  fast_path_shard m_fast_path[MDL_FAST_PATH_SHARDS];
+
 public:
 
   MDL_lock()
     : m_hog_lock_count(0),
       m_strategy(0)
-  { mysql_prlock_init(key_MDL_lock_rwlock, &m_rwlock); }
+  {
+    mysql_prlock_init(key_MDL_lock_rwlock, &m_rwlock);
+    fast_path_reset();
+  }
 
   MDL_lock(const MDL_key *key_arg)
   : key(key_arg),
@@ -662,6 +750,7 @@ class MDL_lock
   {
     DBUG_ASSERT(key_arg->mdl_namespace() == MDL_key::BACKUP);
     mysql_prlock_init(key_MDL_lock_rwlock, &m_rwlock);
+    fast_path_reset();
   }
 
   ~MDL_lock()
@@ -680,6 +769,7 @@ class MDL_lock
     const MDL_key *key_arg= static_cast<const MDL_key *>(_key_arg);
     DBUG_ASSERT(key_arg->mdl_namespace() != MDL_key::BACKUP);
     new (&lock->key) MDL_key(key_arg);
+    lock->fast_path_reset();
     if (key_arg->mdl_namespace() == MDL_key::SCHEMA)
       lock->m_strategy= &m_scoped_lock_strategy;
     else
@@ -785,6 +875,15 @@ static my_bool mdl_iterate_lock(void *lk, void *a)
 }
 
 
+#ifndef DBUG_OFF
+static my_bool mdl_lock_in_use(void *lk, void *)
+{
+  MDL_lock *lock= static_cast<MDL_lock*>(lk);
+  return !lock->is_empty() || lock->fast_path_used(MDL_FAST_PATH_SHARDS);
+}
+#endif
+
+
 int mdl_iterate(mdl_iterator_callback callback, void *arg)
 {
   DBUG_ENTER("mdl_iterate");
@@ -836,7 +935,19 @@ void MDL_map::destroy()
 {
   delete m_backup_lock;
 
-  DBUG_ASSERT(!lf_hash_size(&m_locks));
+#ifndef DBUG_OFF
+  if (!opt_mdl_fast_path)
+    DBUG_ASSERT(!lf_hash_size(&m_locks));
+  /*
+    Locks which were last used through the fast path may be left
+    behind, but none of them can be in use.
+  */
+  else if (LF_PINS *pins= get_pins())
+  {
+    DBUG_ASSERT(!lf_hash_iterate(&m_locks, pins, mdl_lock_in_use, 0));
+    lf_hash_put_pins(pins);
+  }
+#endif
   lf_hash_destroy(&m_locks);
 }
 
@@ -887,6 +998,33 @@ MDL_lock* MDL_map::find_or_insert(LF_PINS *pins, const MDL_key *mdl_key)
 }
 
 
+/**
+  Find the MDL_lock object corresponding to the key and try to grant it
+  an unobtrusive lock through the fast path.
+
+  @retval non-NULL  The lock was granted on the returned MDL_lock.
+  @retval NULL      Use find_or_insert() and acquire the lock under
+                    MDL_lock::m_rwlock.
+*/
+
+MDL_lock *MDL_map::fast_path_acquire(LF_PINS *pins, const MDL_key *mdl_key,
+                                     uint shard, enum_mdl_type type)
+{
+  MDL_lock *lock= (MDL_lock*) lf_hash_search(&m_locks, pins, mdl_key->ptr(),
+                                             mdl_key->length());
+  if (!lock)
+    return NULL;
+  /*
+    The pin keeps the object from being reused. A lock which is being
+    destroyed has FAST_PATH_DESTROYED set.
+  */
+  if (!lock->fast_path_acquire(shard, type))
+    lock= NULL;
+  lf_hash_search_unpin(pins);
+  return lock;
+}
+
+
 /**
  * Return thread id of the owner of the lock, if it is owned.
  */
@@ -956,6 +1094,10 @@ MDL_context::MDL_context()
   m_waiting_for(NULL),
   m_pins(NULL)
 {
+  static std::atomic<uint> next_fast_path_shard;
+  m_fast_path_shard= next_fast_path_shard.fetch_add(1,
+                                                    std::memory_order_relaxed)
+                     % MDL_FAST_PATH_SHARDS;
   mysql_prlock_init(key_MDL_context_LOCK_waiting_for, &m_LOCK_waiting_for);
 }
 
@@ -1773,6 +1915,14 @@ MDL_lock::can_grant_lock(enum_mdl_type type_arg,
   if (!ignore_lock_priority && (m_waiting.bitmap() & waiting_incompat_map))
     return false;
 
+  /*
+    Fast path locks belong to other contexts: requestor_ctx has
+    materialized its own ones before requesting an obtrusive lock.
+  */
+  if ((granted_incompat_map & FAST_PATH_TYPES) &&
+      (fast_path_granted_bitmap() & granted_incompat_map))
+    return false;
+
   if (m_granted.bitmap() & granted_incompat_map)
   {
     bool can_grant= true;
@@ -1834,7 +1984,18 @@ void MDL_lock::remove_ticket(LF_PINS *pins, Ticket_list MDL_lock::*list,
 {
   mysql_prlock_wrlock(&m_rwlock);
   (this->*list).remove_ticket(ticket);
-  if (is_empty())
+  unlock_or_remove(pins);
+}
+
+
+/**
+  Destroy the lock if it is no longer used, otherwise wake up the
+  waiters which can now be granted and unlock m_rwlock.
+*/
+
+void MDL_lock::unlock_or_remove(LF_PINS *pins)
+{
+  if (is_empty() && fast_path_mark_destroyed())
     mdl_locks.remove(pins, this);
   else
   {
@@ -1853,11 +2014,172 @@ void MDL_lock::remove_ticket(LF_PINS *pins, Ticket_list MDL_lock::*list,
       pending request).
     */
     reschedule_waiters();
+    update_fast_path_flags();
     mysql_prlock_unlock(&m_rwlock);
   }
 }
 
 
+/**
+  Try to grant an unobtrusive lock through the fast path.
+
+  @retval true   The lock was granted, the ticket must not be added
+                 to m_granted.
+  @retval false  The fast path is disabled for the lock, use m_rwlock.
+*/
+
+bool MDL_lock::fast_path_acquire(uint shard, enum_mdl_type type)
+{
+  std::atomic<uint64_t> &state= m_fast_path[shard].state;
+  const uint64_t unit= fast_path_unit(type);
+  uint64_t old= state.load(std::memory_order_relaxed);
+  do
+  {
+    if ((old & FAST_PATH_FLAGS) ||
+        ((old / unit) & FAST_PATH_COUNT_MAX) == FAST_PATH_COUNT_MAX)
+      return false;
+  }
+  while (!state.compare_exchange_weak(old, old + unit,
+                                      std::memory_order_acquire,
+                                      std::memory_order_relaxed));
+  return true;
+}
+
+
+/**
+  Release a lock granted through the fast path.
+
+  If an obtrusive lock is granted or waiting, or this looks like the
+  last lock on the object so that the MDL_lock could be destroyed, the
+  counter is decremented under m_rwlock.
+*/
+
+void MDL_lock::fast_path_release(LF_PINS *pins, uint shard,
+                                 enum_mdl_type type)
+{
+  std::atomic<uint64_t> &state= m_fast_path[shard].state;
+  const uint64_t unit= fast_path_unit(type);
+  uint64_t old= state.load(std::memory_order_relaxed);
+  do
+  {
+    if ((old & FAST_PATH_FLAGS) ||
+        ((old & FAST_PATH_COUNTS) == unit && !fast_path_used(shard)))
+    {
+      mysql_prlock_wrlock(&m_rwlock);
+      state.fetch_sub(unit, std::memory_order_release);
+      unlock_or_remove(pins);
+      return;
+    }
+  }
+  while (!state.compare_exchange_weak(old, old - unit,
+                                      std::memory_order_release,
+                                      std::memory_order_relaxed));
+}
+
+
+/**
+  Move a ticket granted through the fast path to m_granted.
+  @pre m_rwlock is write-locked.
+*/
+
+void MDL_lock::fast_path_materialize(uint shard, MDL_ticket *ticket)
+{
+  m_fast_path[shard].state.fetch_sub(fast_path_unit(ticket->get_type()),
+                                     std::memory_order_relaxed);
+  m_granted.add_ticket(ticket);
+}
+
+
+/** Bitmap of the lock types granted through the fast path. */
+
+MDL_lock::bitmap_t MDL_lock::fast_path_granted_bitmap() const
+{
+  bitmap_t bitmap= 0;
+  if (!is_fast_path_key(&key))
+    return 0;
+  for (const auto &s : m_fast_path)
+  {
+    const uint64_t state= s.state.load(std::memory_order_acquire);
+    for (uint type= MDL_SHARED; type <= MDL_SHARED_WRITE; type++)
+      if ((state / fast_path_unit(enum_mdl_type(type))) & FAST_PATH_COUNT_MAX)
+        bitmap|= MDL_BIT(type);
+  }
+  return bitmap;
+}
+
+
+/** Check if some other shard than except_shard has fast path locks */
+
+bool MDL_lock::fast_path_used(uint except_shard) const
+{
+  for (uint i= 0; i < MDL_FAST_PATH_SHARDS; i++)
+    if (i != except_shard &&
+        (m_fast_path[i].state.load(std::memory_order_relaxed) &
+         FAST_PATH_COUNTS))
+      return true;
+  return false;
+}
+
+
+/**
+  Disable the fast path before granting or queueing an obtrusive lock.
+  @pre m_rwlock is write-locked.
+*/
+
+void MDL_lock::fast_path_set_obtrusive()
+{
+  if (m_fast_path[0].state.load(std::memory_order_relaxed) &
+      FAST_PATH_OBTRUSIVE)
+    return;
+  for (auto &s : m_fast_path)
+    s.state.fetch_or(FAST_PATH_OBTRUSIVE);
+}
+
+
+/**
+  Enable the fast path again if no obtrusive locks are left.
+  @pre m_rwlock is write-locked.
+*/
+
+void MDL_lock::update_fast_path_flags()
+{
+  if (!(m_fast_path[0].state.load(std::memory_order_relaxed) &
+        FAST_PATH_OBTRUSIVE) ||
+      ((m_granted.bitmap() | m_waiting.bitmap()) & ~FAST_PATH_TYPES))
+    return;
+  for (auto &s : m_fast_path)
+    s.state.fetch_and(~FAST_PATH_OBTRUSIVE, std::memory_order_release);
+}
+
+
+/**
+  Prevent new fast path locks on an empty lock which is to be
+  destroyed.
+  @pre m_rwlock is write-locked.
+
+  @retval false  There are fast path locks, the lock must not be destroyed.
+*/
+
+bool MDL_lock::fast_path_mark_destroyed()
+{
+  if (!is_fast_path_key(&key))
+    return true;
+  for (uint i= 0; i < MDL_FAST_PATH_SHARDS; i++)
+  {
+    if (m_fast_path[i].state.fetch_or(FAST_PATH_DESTROYED) &
+        FAST_PATH_COUNTS)
+    {
+      do
+        m_fast_path[i].state.fetch_and(~FAST_PATH_DESTROYED,
+                                       std::memory_order_relaxed);
+      while (i--);
+      return false;
+    }
+  }
+  return true;
+}
+
+
 /**
   Check if we have any pending locks which conflict with existing
   shared lock.
@@ -2024,9 +2346,12 @@ MDL_context::try_acquire_lock(MDL_request *mdl_request)
       Our attempt to acquire lock without waiting has failed.
       Let us release resources which were acquired in the process.
       We can't get here if we allocated a new lock object so there
-      is no need to release it.
+      is no need to release it. With @@metadata_locks_fast_path, the
+      lock may be empty if the conflict was with fast path locks; it is
+      destroyed when they are released or by the next user of the
+      object.
     */
-    DBUG_ASSERT(! ticket->m_lock->is_empty());
+    DBUG_ASSERT(opt_mdl_fast_path || !ticket->m_lock->is_empty());
     mysql_prlock_unlock(&ticket->m_lock->m_rwlock);
     MDL_ticket::destroy(ticket);
   }
@@ -2111,6 +2436,29 @@ MDL_context::try_acquire_lock_impl(MDL_request *mdl_request,
                                    )))
     return TRUE;
 
+  if (MDL_lock::is_fast_path_key(key))
+  {
+    if (!(MDL_BIT(mdl_request->type) & MDL_lock::FAST_PATH_TYPES))
+      materialize_fast_path_locks();
+    else if (fast_path_allowed() &&
+             (lock= mdl_locks.fast_path_acquire(m_pins, key,
+                                                m_fast_path_shard,
+                                                mdl_request->type)))
+    {
+      ticket->m_lock= lock;
+      ticket->m_fast_path= true;
+      ticket->m_psi= mysql_mdl_create(ticket, key, mdl_request->type,
+                                      mdl_request->duration,
+                                      MDL_ticket::PENDING,
+                                      mdl_request->m_src_file,
+                                      mdl_request->m_src_line);
+      m_tickets[mdl_request->duration].push_front(ticket);
+      mdl_request->ticket= ticket;
+      mysql_mdl_set_status(ticket->m_psi, MDL_ticket::GRANTED);
+      return FALSE;
+    }
+  }
+
   /* The below call implicitly locks MDL_lock::m_rwlock on success. */
   if (!(lock= mdl_locks.find_or_insert(m_pins, key)))
   {
@@ -2118,6 +2466,10 @@ MDL_context::try_acquire_lock_impl(MDL_request *mdl_request,
     return TRUE;
   }
 
+  if (!(MDL_BIT(mdl_request->type) & MDL_lock::FAST_PATH_TYPES) &&
+      MDL_lock::is_fast_path_key(key))
+    lock->fast_path_set_obtrusive();
+
   DBUG_ASSERT(ticket->m_psi == NULL);
   ticket->m_psi= mysql_mdl_create(ticket,
                                   &mdl_request->key,
@@ -2150,6 +2502,55 @@ MDL_context::try_acquire_lock_impl(MDL_request *mdl_request,
 }
 
 
+/**
+  Check if this context may acquire locks through the MDL_lock fast path.
+
+  The fast path is not used by contexts which need their locks to be
+  found by notify_conflicting_locks(), and while the metadata_lock_info
+  plugin, Galera or slave_abort_blocking_timeout need to see all granted
+  tickets.
+*/
+
+bool MDL_context::fast_path_allowed() const
+{
+  return opt_mdl_fast_path &&
+         !m_needs_thr_lock_abort && !metadata_lock_info_plugin_loaded &&
+#ifdef WITH_WSREP
+         !WSREP_ON &&
+#endif
+         slave_abort_blocking_timeout >= LONG_TIMEOUT;
+}
+
+
+/**
+  Move the tickets of this context which were granted through the fast
+  path to MDL_lock::m_granted of their locks.
+
+  @see MDL_lock::m_fast_path
+*/
+
+void MDL_context::materialize_fast_path_locks()
+{
+  for (uint i= 0; i < MDL_DURATION_END; i++)
+  {
+    Ticket_iterator it(m_tickets[i]);
+    MDL_ticket *ticket;
+
+    while ((ticket= it++))
+    {
+      if (ticket->m_fast_path)
+      {
+        MDL_lock *lock= ticket->m_lock;
+        mysql_prlock_wrlock(&lock->m_rwlock);
+        lock->fast_path_materialize(m_fast_path_shard, ticket);
+        mysql_prlock_unlock(&lock->m_rwlock);
+        ticket->m_fast_path= false;
+      }
+    }
+  }
+}
+
+
 /**
   Create a copy of a granted ticket.
   This is used to make sure that HANDLER ticket
@@ -2648,6 +3049,9 @@ MDL_context::upgrade_shared_lock(MDL_ticket *mdl_ticket,
   if (acquire_lock(&mdl_xlock_request, lock_wait_timeout))
     DBUG_RETURN(TRUE);
 
+  /* Both tickets must be in m_granted for the merge below */
+  materialize_fast_path_locks();
+
   is_new_ticket= ! has_lock(mdl_svp, mdl_xlock_request.ticket);
 
   /* Merge the acquired and the original lock. @todo: move to a method. */
@@ -2934,7 +3338,10 @@ void MDL_context::release_lock(enum_mdl_duration duration, MDL_ticket *ticket)
   DBUG_ASSERT(this == ticket->get_ctx());
   DBUG_PRINT("mdl", ("Released: %s", dbug_print_mdl(ticket)));
 
-  lock->remove_ticket(m_pins, &MDL_lock::m_granted, ticket);
+  if (ticket->m_fast_path)
+    lock->fast_path_release(m_pins, m_fast_path_shard, ticket->m_type);
+  else
+    lock->remove_ticket(m_pins, &MDL_lock::m_granted, ticket);
 
   m_tickets[duration].remove(ticket);
   MDL_ticket::destroy(ticket);
@@ -3060,6 +3467,7 @@ void MDL_ticket::downgrade_lock(enum_mdl_type type)
   m_type= type;
   m_lock->m_granted.add_ticket(this);
   m_lock->reschedule_waiters();
+  m_lock->update_fast_path_flags();
   mysql_prlock_unlock(&m_lock->m_rwlock);
   DBUG_VOID_RETURN;
 }
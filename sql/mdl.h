@@ -762,7 +762,8 @@ class MDL_ticket : public MDL_wait_for_subgraph, public ilist_node<>
      m_type(type_arg),
      m_ctx(ctx_arg),
      m_lock(NULL),
-     m_psi(NULL)
+     m_psi(NULL),
+     m_fast_path(false)
   {}
 
   virtual ~MDL_ticket()
@@ -792,6 +793,12 @@ class MDL_ticket : public MDL_wait_for_subgraph, public ilist_node<>
 
   PSI_metadata_lock *m_psi;
 
+  /**
+    TRUE if the lock was granted through the fast path, i.e. the ticket
+    is not in MDL_lock::m_granted. Context private.
+  */
+  bool m_fast_path;
+
 private:
   MDL_ticket(const MDL_ticket &);               /* not implemented */
   MDL_ticket &operator=(const MDL_ticket &);    /* not implemented */
@@ -966,6 +973,12 @@ class MDL_context
             will see the new value eventually.
     */
     m_needs_thr_lock_abort= needs_thr_lock_abort;
+    /*
+      MDL_lock::notify_conflicting_locks() must find the locks of
+      such contexts.
+    */
+    if (needs_thr_lock_abort)
+      materialize_fast_path_locks();
   }
   bool get_needs_thr_lock_abort() const
   {
@@ -1063,6 +1076,8 @@ class MDL_context
   MDL_wait_for_subgraph *m_waiting_for;
   LF_PINS *m_pins;
   uint m_deadlock_overweight;
+  /** Shard of MDL_lock fast path counters used by this context */
+  uint m_fast_path_shard;
 private:
   MDL_ticket *find_ticket(MDL_request *mdl_req,
                           enum_mdl_duration *duration);
@@ -1072,7 +1087,10 @@ class MDL_context
                              MDL_ticket **out_ticket);
   bool fix_pins();
 
+  bool fast_path_allowed() const;
+
 public:
+  void materialize_fast_path_locks();
   THD *get_thd() const { return m_owner->get_thd(); }
   bool has_explicit_locks();
   void find_deadlock();
@@ -1084,6 +1102,8 @@ class MDL_context
   /** Inform the deadlock detector there is an edge in the wait-for graph. */
   void will_wait_for(MDL_wait_for_subgraph *waiting_for_arg)
   {
+    /* The deadlock detector only sees the tickets in MDL_lock::m_granted */
+    materialize_fast_path_locks();
     mysql_prlock_wrlock(&m_LOCK_waiting_for);
     m_waiting_for=  waiting_for_arg;
     mysql_prlock_unlock(&m_LOCK_waiting_for);
@@ -1136,6 +1156,8 @@ class MDL_context
 void mdl_init();
 void mdl_destroy();
 
+extern my_bool opt_mdl_fast_path;
+
 extern "C" unsigned long thd_get_thread_id(const MYSQL_THD thd);
 
 /**
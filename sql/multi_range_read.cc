@@ -93,6 +93,27 @@ void handler::calculate_costs(Cost_estimate *cost, uint keyno,
  * Default MRR implementation (MRR to non-MRR converter)
  ***************************************************************************/
 
+/**
+  Default implementation of handler::records_in_ranges()
+*/
+
+void handler::records_in_ranges(uint inx, uint n_ranges,
+                                key_range *const *min_keys,
+                                key_range *const *max_keys,
+                                page_range *pages, ha_rows *rows)
+{
+  for (uint i= 0; i < n_ranges; i++)
+  {
+    if ((rows[i]= records_in_range(inx, min_keys[i], max_keys[i],
+                                   &pages[i])) == HA_POS_ERROR)
+      break;
+  }
+}
+
+
+/* Max number of ranges passed to one records_in_ranges() call */
+#define RECORDS_IN_RANGES_BATCH 16
+
 /**
   Get cost and other information about MRR scan over a known list of ranges
 
@@ -187,167 +208,227 @@ handler::multi_range_read_info_const(uint keyno, RANGE_SEQ_IF *seq,
   bool use_statistics_for_eq_range= eq_ranges_exceeds_limit(seq,
                                                             seq_init_param,
                                                             limit);
+  /* Ranges waiting for records_in_ranges(), see the loop below */
+  key_range batch_min[RECORDS_IN_RANGES_BATCH];
+  key_range batch_max[RECORDS_IN_RANGES_BATCH];
+  key_range *batch_min_endp[RECORDS_IN_RANGES_BATCH];
+  key_range *batch_max_endp[RECORDS_IN_RANGES_BATCH];
+  page_range batch_pages[RECORDS_IN_RANGES_BATCH];
+  ha_rows batch_rows[RECORDS_IN_RANGES_BATCH];
+  /* Value of single_point_ranges when the range was returned */
+  ulonglong batch_single_point_ranges[RECORDS_IN_RANGES_BATCH];
+  uint n_batched= 0;
+  uchar key_buff[2 * MAX_KEY_LENGTH];
+  size_t key_buff_used= 0;
   DBUG_ENTER("multi_range_read_info_const");
 
   /* Default MRR implementation doesn't need buffer */
   *bufsz= 0;
 
   seq_it= seq->init(seq_init_param, n_ranges, *flags);
-  while (!seq->next(seq_it, &range))
+  for (;;)
   {
     ha_rows rows;
+    key_range *min_endp= NULL, *max_endp= NULL;
+    bool seq_end= seq->next(seq_it, &range);
 
-    if (unlikely(thd->killed != 0))
-      DBUG_RETURN(HA_POS_ERROR);
-
-    n_ranges++;
-    key_range *min_endp, *max_endp;
-    if (range.range_flag & GEOM_FLAG)
-    {
-      /* In this case tmp_min_flag contains the handler-read-function */
-      range.start_key.flag= (ha_rkey_function) (range.range_flag ^ GEOM_FLAG);
-      min_endp= &range.start_key;
-      max_endp= NULL;
-    }
-    else
+    if (!seq_end)
     {
-      min_endp= range.start_key.length? &range.start_key : NULL;
-      max_endp= range.end_key.length? &range.end_key : NULL;
-    }
-    int keyparts_used= my_count_bits(range.start_key.keypart_map);
+      if (unlikely(thd->killed != 0))
+        DBUG_RETURN(HA_POS_ERROR);
 
-    if ((range.range_flag & UNIQUE_RANGE) && !(range.range_flag & NULL_RANGE))
-    {
-      rows= 1;
-      /*
-        In this case we do not call records_in_range() and as a result
-        do not get any info on the edge blocks for this range. However if it
-        happens that the range for which we have such info uses the same block
-        for its first record as the last range for which such info is
-        provided uses for its last record then this range can be assigned
-        later to one of the blocks used by other ranges.
-
-        Note that we don't have to increment edge_blocks_cnt or
-        range_blocks_cnt here.
-      */
-      single_point_ranges++;
-    }
-    else if (use_statistics_for_eq_range &&
-             !(range.range_flag & NULL_RANGE) &&
-             (range.range_flag & EQ_RANGE) &&
-             table->key_info[keyno].actual_rec_per_key(keyparts_used - 1) > 0.5)
-    {
-      rows= ((ha_rows) table->key_info[keyno].
-             actual_rec_per_key(keyparts_used-1));
-      range_blocks_cnt+= ((MY_MAX(rows, 1) - 1) / avg_block_records + 1);
-    }
-    else
-    {
-      page_range pages= unused_page_range;
-      if ((rows= this->records_in_range(keyno, min_endp, max_endp, &pages)) ==
-          HA_POS_ERROR)
+      n_ranges++;
+      if (range.range_flag & GEOM_FLAG)
       {
-        /* Can't scan one range => can't do MRR scan at all */
-        total_rows= HA_POS_ERROR;
-        if (thd->is_error())
-          DBUG_RETURN(HA_POS_ERROR);
-        break;
+        /* In this case tmp_min_flag contains the handler-read-function */
+        range.start_key.flag= (ha_rkey_function) (range.range_flag ^
+                                                  GEOM_FLAG);
+        min_endp= &range.start_key;
+        max_endp= NULL;
       }
-      if (pages.first_page == UNUSED_PAGE_NO)
+      else
+      {
+        min_endp= range.start_key.length? &range.start_key : NULL;
+        max_endp= range.end_key.length? &range.end_key : NULL;
+      }
+      int keyparts_used= my_count_bits(range.start_key.keypart_map);
+
+      if ((range.range_flag & UNIQUE_RANGE) &&
+          !(range.range_flag & NULL_RANGE))
       {
         /*
-          The engine does not provide info on the range position.
-          Place the range in a new block. Note that in this case
-          any new range will be placed in a new block.
-	*/
-        ulonglong additional_blocks= ((MY_MAX(rows,1) - 1) / avg_block_records +
-                                      1);
-        edge_blocks_cnt+= additional_blocks == 1 ? 1 : 2;
-        range_blocks_cnt+= additional_blocks;
+          In this case we do not call records_in_range() and as a result
+          do not get any info on the edge blocks for this range. However if
+          it happens that the range for which we have such info uses the
+          same block for its first record as the last range for which such
+          info is provided uses for its last record then this range can be
+          assigned later to one of the blocks used by other ranges.
+
+          Note that we don't have to increment edge_blocks_cnt or
+          range_blocks_cnt here.
+        */
+        single_point_ranges++;
+        total_rows++;
+        continue;
       }
-      else
+      if (use_statistics_for_eq_range &&
+          !(range.range_flag & NULL_RANGE) &&
+          (range.range_flag & EQ_RANGE) &&
+          table->key_info[keyno].actual_rec_per_key(keyparts_used - 1) > 0.5)
       {
-        /* The info on the range position is provided */
-        if (pages.first_page == prev_range_last_block)
-	{
+        rows= ((ha_rows) table->key_info[keyno].
+               actual_rec_per_key(keyparts_used-1));
+        range_blocks_cnt+= ((MY_MAX(rows, 1) - 1) / avg_block_records + 1);
+        total_rows+= rows;
+        continue;
+      }
+    }
+
+    /*
+      The remaining ranges need records_in_range(). They are collected
+      and passed to records_in_ranges() together, so that the engine can
+      share the work between them. The range keys are only valid until
+      the next seq->next() call and are copied to key_buff.
+    */
+    size_t range_key_length= ((min_endp ? min_endp->length : 0) +
+                              (max_endp ? max_endp->length : 0));
+    if (n_batched &&
+        (seq_end || n_batched == RECORDS_IN_RANGES_BATCH ||
+         key_buff_used + range_key_length > sizeof(key_buff)))
+    {
+      records_in_ranges(keyno, n_batched, batch_min_endp, batch_max_endp,
+                        batch_pages, batch_rows);
+      for (uint i= 0; i < n_batched; i++)
+      {
+        page_range pages= batch_pages[i];
+        if ((rows= batch_rows[i]) == HA_POS_ERROR)
+        {
+          /* Can't scan one range => can't do MRR scan at all */
+          total_rows= HA_POS_ERROR;
+          if (thd->is_error())
+            DBUG_RETURN(HA_POS_ERROR);
+          break;
+        }
+        if (pages.first_page == UNUSED_PAGE_NO)
+        {
           /*
-            The new range starts in the same block that the last range
-            for which the position of the range was provided.
+            The engine does not provide info on the range position.
+            Place the range in a new block. Note that in this case
+            any new range will be placed in a new block.
+	*/
+          ulonglong additional_blocks= ((MY_MAX(rows,1) - 1) /
+                                        avg_block_records + 1);
+          edge_blocks_cnt+= additional_blocks == 1 ? 1 : 2;
+          range_blocks_cnt+= additional_blocks;
+        }
+        else
+        {
+          /* The info on the range position is provided */
+          if (pages.first_page == prev_range_last_block)
+	{
+            /*
+              The new range starts in the same block that the last range
+              for which the position of the range was provided.
 	  */
-          /*
-            First add records of single point ranges that can be placed
-            between these two ranges.
+            /*
+              First add records of single point ranges that can be placed
+              between these two ranges.
 	  */
-          prev_range_last_block_records+= (single_point_ranges -
-                                           assigned_single_point_ranges);
-          assigned_single_point_ranges= single_point_ranges;
-          if (pages.first_page == pages.last_page)
+            prev_range_last_block_records+= (batch_single_point_ranges[i] -
+                                             assigned_single_point_ranges);
+            assigned_single_point_ranges= batch_single_point_ranges[i];
+            if (pages.first_page == pages.last_page)
 	  {
-            /*
-              All records of the current range are in the same block
-              Note that the prev_range_last_block_records can be much larger
-              than max_records_in_block as the rows can be compressed!
-            */
-            prev_range_last_block_records+= rows;
-            DBUG_ASSERT(prev_range_last_block_records <
-                        stats.block_size);
+              /*
+                All records of the current range are in the same block
+                Note that the prev_range_last_block_records can be much larger
+                than max_records_in_block as the rows can be compressed!
+              */
+              prev_range_last_block_records+= rows;
+              DBUG_ASSERT(prev_range_last_block_records <
+                          stats.block_size);
+            }
+            else
+	  {
+              /*
+                The current range spans more than one block
+
+                Place part of the range records in 'prev_range_last_block'
+                and the remaining records in additional blocks.
+
+                We don't know where the first key was positioned in the
+                block, so we assume the range started in the middle of the
+                block.
+
+                Note that prev_range_last_block_records > avg_block_records
+                can be true in case of compressed rows.
+              */
+              ha_rows rem_rows= rows;
+
+              if (avg_block_records > prev_range_last_block_records)
+              {
+                ha_rows space_left_in_prev_block=
+                  (avg_block_records - prev_range_last_block_records)/2;
+                rem_rows= 0;
+                if (rows > space_left_in_prev_block)
+                  rem_rows= rows - space_left_in_prev_block;
+              }
+              /* Calculate how many additional blocks we need for rem_rows */
+              ulonglong additional_blocks= ((MY_MAX(rem_rows, 1) - 1) /
+                                            avg_block_records + 1);
+              edge_blocks_cnt++;
+              range_blocks_cnt+= additional_blocks;
+              prev_range_last_block= pages.last_page;
+              /* There is at least one row on last page */
+              prev_range_last_block_records= 1;
+            }
           }
           else
-	  {
+	{
             /*
-              The current range spans more than one block
-
-              Place part of the range records in 'prev_range_last_block'
-              and the remaining records in additional blocks.
-
-              We don't know where the first key was positioned in the
-              block, so we assume the range started in the middle of the
-              block.
-
-              Note that prev_range_last_block_records > avg_block_records
-              can be true in case of compressed rows.
-            */
-            ha_rows rem_rows= rows;
-
-            if (avg_block_records > prev_range_last_block_records)
-            {
-              ha_rows space_left_in_prev_block=
-                (avg_block_records - prev_range_last_block_records)/2;
-              rem_rows= 0;
-              if (rows > space_left_in_prev_block)
-                rem_rows= rows - space_left_in_prev_block;
-            }
-            /* Calculate how many additional blocks we need for rem_rows */
-            ulonglong additional_blocks= ((MY_MAX(rem_rows, 1) - 1) /
+              The new range does not start in the same block that the last range
+              for which the position of the range was provided.
+              Note that rows may be 0!
+	  */
+            ulonglong additional_blocks= ((MY_MAX(rows, 1) - 1) /
                                           avg_block_records + 1);
-            edge_blocks_cnt++;
+            edge_blocks_cnt+= additional_blocks == 1 ? 1 : 2;
             range_blocks_cnt+= additional_blocks;
+            unassigned_single_point_ranges+= (batch_single_point_ranges[i] -
+                                              assigned_single_point_ranges);
+            assigned_single_point_ranges= batch_single_point_ranges[i];
             prev_range_last_block= pages.last_page;
             /* There is at least one row on last page */
             prev_range_last_block_records= 1;
           }
         }
-        else
-	{
-          /*
-            The new range does not start in the same block that the last range
-            for which the position of the range was provided.
-            Note that rows may be 0!
-	  */
-          ulonglong additional_blocks= ((MY_MAX(rows, 1) - 1) /
-                                        avg_block_records + 1);
-          edge_blocks_cnt+= additional_blocks == 1 ? 1 : 2;
-          range_blocks_cnt+= additional_blocks;
-          unassigned_single_point_ranges+= (single_point_ranges -
-                                            assigned_single_point_ranges);
-          assigned_single_point_ranges= single_point_ranges;
-          prev_range_last_block= pages.last_page;
-          /* There is at least one row on last page */
-          prev_range_last_block_records= 1;
-        }
+        total_rows+= rows;
       }
+      if (total_rows == HA_POS_ERROR)
+        break;
+      n_batched= 0;
+      key_buff_used= 0;
+    }
+    if (seq_end)
+      break;
+
+    DBUG_ASSERT(range_key_length <= sizeof(key_buff));
+    key_range *endp[2]= { min_endp, max_endp };
+    key_range *copy[2]= { &batch_min[n_batched], &batch_max[n_batched] };
+    for (uint j= 0; j < 2; j++)
+    {
+      if (!endp[j])
+        continue;
+      *copy[j]= *endp[j];
+      copy[j]->key= key_buff + key_buff_used;
+      memcpy(key_buff + key_buff_used, endp[j]->key, endp[j]->length);
+      key_buff_used+= endp[j]->length;
     }
-    total_rows+= rows;
+    batch_min_endp[n_batched]= min_endp ? copy[0] : NULL;
+    batch_max_endp[n_batched]= max_endp ? copy[1] : NULL;
+    batch_pages[n_batched]= unused_page_range;
+    batch_single_point_ranges[n_batched]= single_point_ranges;
+    n_batched++;
   }
   /*
     Count the number of io_blocks that where not yet read and thus not cached.
@@ -404,6 +404,10 @@ my_bool opt_skip_slave_start = 0; ///< If set, slave is not autostarted
 my_bool opt_reckless_slave = 0;
 my_bool opt_enable_named_pipe= 0;
 my_bool opt_local_infile, opt_slave_compressed_protocol;
+/** enum enum_net_compression requested by the slave IO thread */
+ulong opt_slave_compression_algorithm;
+/** Zstandard level for the packets sent on compressed connections */
+uint protocol_compression_zstd_level;
 my_bool opt_safe_user_create = 0;
 my_bool opt_show_slave_auth_info;
 my_bool opt_log_slave_updates= 0;
@@ -450,6 +454,7 @@ ulong opt_binlog_rows_event_max_size;
 ulong binlog_row_metadata;
 my_bool opt_binlog_gtid_index= TRUE;
 uint opt_binlog_gtid_index_page_size= 4096;
+uint opt_binlog_writeset_max_keys= 0;
 uint opt_binlog_gtid_index_span_min= 65536;
 my_bool opt_master_verify_checksum= 0;
 my_bool opt_slave_sql_verify_checksum= 1;
@@ -474,6 +479,7 @@ ulong thread_created;
 ulong back_log, connect_timeout, server_id;
 ulong what_to_log;
 ulong slow_launch_time;
+ulong histogram_auto_collect_threshold;
 ulong open_files_limit, max_binlog_size;
 ulong slave_trans_retries;
 ulong slave_trans_retry_interval;
@@ -485,6 +491,8 @@ ulonglong slave_type_conversions_options;
 ulong thread_cache_size=0;
 ulonglong global_max_tmp_space_usage;
 Atomic_counter<ulonglong> global_tmp_space_used;
+ulonglong global_query_alloc_retain_limit;
+Atomic_counter<ulonglong> global_query_alloc_retained;
 ulonglong binlog_cache_size=0;
 ulonglong binlog_file_cache_size=0;
 uint slave_connections_needed_for_purge;
@@ -560,6 +568,12 @@ ulonglong binlog_space_limit;
 */
 ulong stored_program_cache_size= 0;
 
+/**
+  Upper limit for number of stored routine definitions shared by
+  all connections, see sp_definition_cache_lookup().
+*/
+ulong stored_program_definition_cache_size= 0;
+
 ulong opt_slave_parallel_threads= 0;
 ulong opt_slave_domain_parallel_threads= 0;
 ulong opt_slave_parallel_mode;
@@ -676,6 +690,12 @@ const char *current_dbug_option="";
 
 struct system_variables max_system_variables;
 struct system_status_var global_status_var;
+/**
+  Memory allocated for global usage by threads that have no THD, and by
+  THDs that have ended. It is kept outside global_status_var because it is
+  updated by concurrent threads on every such allocation.
+*/
+Sharded_counter<int64> global_memory_used_counter;
 
 MY_TMPDIR mysql_tmpdir_list;
 static MY_BITMAP temp_pool;
@@ -727,7 +747,11 @@ static thread_local THD *THR_THD;
 */
 
 MYSQL_THD _current_thd() { return THR_THD; }
-void set_current_thd(THD *thd) { THR_THD= thd; }
+void set_current_thd(THD *thd)
+{
+  THR_THD= thd;
+  set_root_block_cache(thd ? &thd->root_block_cache : 0);
+}
 
 /*
   LOCK_start_thread is used to syncronize thread start and stop with
@@ -764,7 +788,8 @@ mysql_mutex_t LOCK_thread_id;
   server may be fairly high, we need a dedicated lock.
 */
 mysql_mutex_t LOCK_prepared_stmt_count;
-mysql_mutex_t LOCK_backup_log, LOCK_optimizer_costs;
+mysql_mutex_t LOCK_backup_log, LOCK_optimizer_costs, LOCK_cost_feedback;
+mysql_mutex_t LOCK_histogram_collect;
 mysql_rwlock_t LOCK_grant, LOCK_sys_init_connect, LOCK_sys_init_slave;
 mysql_rwlock_t LOCK_ssl_refresh;
 mysql_rwlock_t LOCK_all_status_vars;
@@ -945,6 +970,7 @@ PSI_mutex_key key_BINLOG_LOCK_index, key_BINLOG_LOCK_xid_list,
   key_LOCK_delayed_insert, key_LOCK_delayed_status, key_LOCK_error_log,
   key_LOCK_gdl, key_LOCK_global_system_variables,
   key_LOCK_manager, key_LOCK_backup_log, key_LOCK_optimizer_costs,
+  key_LOCK_cost_feedback, key_LOCK_histogram_collect,
   key_LOCK_prepared_stmt_count,
   key_LOCK_rpl_status, key_LOCK_server_started,
   key_LOCK_status, key_LOCK_temp_pool,
@@ -981,6 +1007,7 @@ PSI_mutex_key key_LOCK_prepare_ordered, key_LOCK_commit_ordered;
 PSI_mutex_key key_TABLE_SHARE_LOCK_share;
 PSI_mutex_key key_TABLE_SHARE_LOCK_statistics;
 PSI_mutex_key key_LOCK_ack_receiver;
+PSI_mutex_key key_LOCK_load_read_ahead;
 
 PSI_mutex_key key_TABLE_SHARE_LOCK_rotation;
 PSI_cond_key key_TABLE_SHARE_COND_rotation;
@@ -1010,6 +1037,8 @@ static PSI_mutex_info all_server_mutexes[]=
   { &key_LOCK_active_mi, "LOCK_active_mi", PSI_FLAG_GLOBAL},
   { &key_LOCK_backup_log, "LOCK_backup_log", PSI_FLAG_GLOBAL},
   { &key_LOCK_optimizer_costs, "LOCK_optimizer_costs", PSI_FLAG_GLOBAL},
+  { &key_LOCK_cost_feedback, "LOCK_cost_feedback", PSI_FLAG_GLOBAL},
+  { &key_LOCK_histogram_collect, "LOCK_histogram_collect", PSI_FLAG_GLOBAL},
   { &key_LOCK_temp_pool, "LOCK_temp_pool", PSI_FLAG_GLOBAL},
   { &key_LOCK_thread_id, "LOCK_thread_id", PSI_FLAG_GLOBAL},
   { &key_LOCK_crypt, "LOCK_crypt", PSI_FLAG_GLOBAL},
@@ -1066,6 +1095,7 @@ static PSI_mutex_info all_server_mutexes[]=
   { &key_LOCK_rpl_thread_pool, "LOCK_rpl_thread_pool", 0},
   { &key_LOCK_parallel_entry, "LOCK_parallel_entry", 0},
   { &key_LOCK_ack_receiver, "Ack_receiver::mutex", 0},
+  { &key_LOCK_load_read_ahead, "Load_read_ahead::mutex", 0},
   { &key_LOCK_rpl_semi_sync_master_enabled, "LOCK_rpl_semi_sync_master_enabled", 0},
   { &key_LOCK_binlog, "LOCK_binlog", 0}
 };
@@ -1129,6 +1159,7 @@ PSI_cond_key key_COND_rpl_thread_queue, key_COND_rpl_thread,
   key_COND_prepare_ordered;
 PSI_cond_key key_COND_wait_gtid, key_COND_gtid_ignore_duplicates;
 PSI_cond_key key_COND_ack_receiver;
+PSI_cond_key key_COND_load_read_ahead;
 
 static PSI_cond_info all_server_conds[]=
 {
@@ -1176,6 +1207,7 @@ static PSI_cond_info all_server_conds[]=
   { &key_COND_wait_gtid, "COND_wait_gtid", 0},
   { &key_COND_gtid_ignore_duplicates, "COND_gtid_ignore_duplicates", 0},
   { &key_COND_ack_receiver, "Ack_receiver::cond", 0},
+  { &key_COND_load_read_ahead, "Load_read_ahead::cond", 0},
   { &key_COND_binlog_send, "COND_binlog_send", 0},
   { &key_TABLE_SHARE_COND_rotation, "TABLE_SHARE::COND_rotation", 0}
 };
@@ -1185,6 +1217,9 @@ PSI_thread_key key_thread_delayed_insert,
   key_thread_one_connection, key_thread_signal_hand,
   key_thread_slave_background, key_rpl_parallel_thread;
 PSI_thread_key key_thread_ack_receiver;
+PSI_thread_key key_thread_load_read_ahead;
+PSI_thread_key key_thread_parallel_sort;
+PSI_thread_key key_thread_histogram_collect;
 
 static PSI_thread_info all_server_threads[]=
 {
@@ -1195,6 +1230,9 @@ static PSI_thread_info all_server_threads[]=
   { &key_thread_signal_hand, "signal_handler", PSI_FLAG_GLOBAL},
   { &key_thread_slave_background, "slave_bg", PSI_FLAG_GLOBAL},
   { &key_thread_ack_receiver, "Ack_receiver", PSI_FLAG_GLOBAL},
+  { &key_thread_load_read_ahead, "Load_read_ahead", 0},
+  { &key_thread_parallel_sort, "parallel_sort", 0},
+  { &key_thread_histogram_collect, "histogram_collect", 0},
   { &key_rpl_parallel_thread, "rpl_parallel", 0}
 };
 
@@ -1509,6 +1547,8 @@ char *opt_ssl_ca= NULL, *opt_ssl_capath= NULL, *opt_ssl_cert= NULL,
   *opt_ssl_cipher= NULL, *opt_ssl_key= NULL, *opt_ssl_crl= NULL,
   *opt_ssl_crlpath= NULL, *opt_tls_version= NULL;
 ulonglong tls_version= 0;
+uint opt_ssl_session_cache_size;
+my_bool opt_ssl_ktls;
 
 static scheduler_functions thread_scheduler_struct, extra_thread_scheduler_struct;
 scheduler_functions *thread_scheduler= &thread_scheduler_struct,
@@ -1946,9 +1986,9 @@ static void mysqld_exit(int exit_code)
   shutdown_performance_schema();        // we do it as late as possible
 #endif
   set_malloc_size_cb(NULL);
-  if (global_status_var.global_memory_used)
+  if (int64 memory_used= global_memory_used_counter)
     fprintf(stderr, "Warning: Internal memory accounting error of %lld bytes\n",
-            (longlong) global_status_var.global_memory_used);
+            (longlong) memory_used);
   if (global_tmp_space_used)
     fprintf(stderr, "Warning: Internal tmp_space accounting error of %lld "
             "bytes\n",
@@ -2016,6 +2056,7 @@ static void clean_up(bool print_message)
   free_all_optimizer_costs();
   wt_end();
   multi_keycache_free();
+  sp_definition_cache_end();
   sp_cache_end();
   free_status_vars();
   end_thr_timer();
@@ -2158,6 +2199,8 @@ static void clean_up_mutexes()
   mysql_rwlock_destroy(&LOCK_ssl_refresh);
   mysql_mutex_destroy(&LOCK_backup_log);
   mysql_mutex_destroy(&LOCK_optimizer_costs);
+  mysql_mutex_destroy(&LOCK_cost_feedback);
+  mysql_mutex_destroy(&LOCK_histogram_collect);
   mysql_mutex_destroy(&LOCK_temp_pool);
   mysql_rwlock_destroy(&LOCK_sys_init_connect);
   mysql_rwlock_destroy(&LOCK_sys_init_slave);
@@ -3746,6 +3789,8 @@ static void my_malloc_size_cb_func(long long size, my_bool is_thread_specific)
                         (longlong) thd->status_var.local_memory_used,
                         size));
     thd->status_var.local_memory_used+= size;
+    if (size > 0)
+      thd->status_var.memory_allocated+= size;
     set_if_bigger(thd->status_var.max_local_memory_used,
                   thd->status_var.local_memory_used);
     if (size > 0 &&
@@ -3932,7 +3977,7 @@ static int init_early_variables()
   set_current_thd(0);
   set_malloc_size_cb(my_malloc_size_cb_func);
   update_tmp_file_size= temp_file_size_cb_func;
-  global_status_var.global_memory_used= 0;
+  global_memory_used_counter.reset();
   init_alloc_root(PSI_NOT_INSTRUMENTED, &startup_root, 1024, 0, MYF(0));
   init_alloc_root(PSI_NOT_INSTRUMENTED, &read_only_root, 1024, 0,
 		  MYF(MY_ROOT_USE_MPROTECT));
@@ -4549,6 +4594,10 @@ static int init_thread_environment()
   mysql_mutex_init(key_LOCK_backup_log, &LOCK_backup_log, MY_MUTEX_INIT_FAST);
   mysql_mutex_init(key_LOCK_optimizer_costs, &LOCK_optimizer_costs,
                    MY_MUTEX_INIT_FAST);
+  mysql_mutex_init(key_LOCK_cost_feedback, &LOCK_cost_feedback,
+                   MY_MUTEX_INIT_FAST);
+  mysql_mutex_init(key_LOCK_histogram_collect, &LOCK_histogram_collect,
+                   MY_MUTEX_INIT_FAST);
   mysql_mutex_init(key_LOCK_temp_pool, &LOCK_temp_pool, MY_MUTEX_INIT_FAST);
 
 #ifdef HAVE_OPENSSL
@@ -4580,6 +4629,7 @@ static int init_thread_environment()
                    &LOCK_server_started, MY_MUTEX_INIT_FAST);
   mysql_cond_init(key_COND_server_started, &COND_server_started, NULL);
   sp_cache_init();
+  sp_definition_cache_init();
 #ifdef HAVE_EVENT_SCHEDULER
   Events::init_mutexes();
 #endif
@@ -4753,7 +4803,8 @@ static void init_ssl()
 					  opt_ssl_ca, opt_ssl_capath,
 					  opt_ssl_cipher, &error,
 					  opt_ssl_crl, opt_ssl_crlpath,
-					  tls_version);
+					  tls_version, opt_ssl_session_cache_size,
+					  opt_ssl_ktls);
     DBUG_PRINT("info",("ssl_acceptor_fd: %p", ssl_acceptor_fd));
     if (!ssl_acceptor_fd)
     {
@@ -4802,7 +4853,7 @@ int reinit_ssl()
   enum enum_ssl_init_error error = SSL_INITERR_NOERROR;
   st_VioSSLFd *new_fd = new_VioSSLAcceptorFd(opt_ssl_key, opt_ssl_cert,
     opt_ssl_ca, opt_ssl_capath, opt_ssl_cipher, &error, opt_ssl_crl,
-    opt_ssl_crlpath, tls_version);
+    opt_ssl_crlpath, tls_version, opt_ssl_session_cache_size, opt_ssl_ktls);
 
   if (!new_fd)
   {
@@ -6172,7 +6223,7 @@ int mysqld_main(int argc, char **argv)
   (void)MYSQL_SET_STAGE(0 ,__FILE__, __LINE__);
 
   /* Memory used when everything is setup */
-  start_memory_used= global_status_var.global_memory_used;
+  start_memory_used= global_memory_used_counter;
 
   run_main_loop();
 
@@ -6927,7 +6978,10 @@ struct my_option my_long_options[]=
    "--slave-parallel-threads. Possible values: \"optimistic\" tries to "
    "apply most transactional DML in parallel, and handles any conflicts "
    "with rollback and retry. \"conservative\" limits parallelism in an "
-   "effort to avoid any conflicts. \"aggressive\" tries to maximise the "
+   "effort to avoid any conflicts. \"writeset\" runs transactions in "
+   "parallel when the writesets logged by the master "
+   "(--binlog-writeset-max-keys) show they do not conflict, and is "
+   "conservative otherwise. \"aggressive\" tries to maximise the "
    "parallelism, possibly at the cost of increased conflict rate. "
    "\"minimal\" only parallelizes the commit steps of transactions. "
    "\"none\" disables parallel apply completely",
@@ -7032,6 +7086,16 @@ static int show_queries(THD *thd, SHOW_VAR *var, void *,
 }
 
 
+static int show_query_alloc_retained(THD *thd, SHOW_VAR *var, void *buff,
+                                     system_status_var *, enum_var_type)
+{
+  var->type= SHOW_LONGLONG;
+  var->value= buff;
+  *(longlong*) buff= (longlong) global_query_alloc_retained;
+  return 0;
+}
+
+
 static int show_net_compression(THD *thd, SHOW_VAR *var, void *,
                                 system_status_var *, enum_var_type)
 {
@@ -7040,6 +7104,16 @@ static int show_net_compression(THD *thd, SHOW_VAR *var, void *,
   return 0;
 }
 
+static int show_net_compression_algorithm(THD *thd, SHOW_VAR *var, void *,
+                                          system_status_var *, enum_var_type)
+{
+  static const char *names[]= {"zlib", "zstd", "lz4"};
+  var->type= SHOW_CHAR;
+  var->value= const_cast<char*>(thd->net.compress
+                                ? names[thd->net.compress_algorithm] : "");
+  return 0;
+}
+
 static int show_starttime(THD *thd, SHOW_VAR *var, void *buff,
                           system_status_var *, enum_var_type)
 {
@@ -7574,6 +7648,7 @@ SHOW_VAR status_vars[]= {
   {"Column_decompressions",    (char*) offsetof(STATUS_VAR, column_decompressions), SHOW_LONG_STATUS},
   {"Com",                      (char*) com_status_vars, SHOW_ARRAY},
   {"Compression",              (char*) &show_net_compression, SHOW_SIMPLE_FUNC},
+  {"Compression_algorithm",    (char*) &show_net_compression_algorithm, SHOW_SIMPLE_FUNC},
   {"Connections",              (char*) &global_thread_id,         SHOW_LONG_NOFLUSH},
   {"Connection_errors_accept", (char*) &connection_errors_accept, SHOW_LONG},
   {"Connection_errors_internal", (char*) &connection_errors_internal, SHOW_LONG},
@@ -7654,6 +7729,7 @@ SHOW_VAR status_vars[]= {
   {"Max_tmp_space_used",       (char*) offsetof(STATUS_VAR, max_tmp_space_used), SHOW_LONGLONG_STATUS},
   {"Max_used_connections",     (char*) &max_used_connections,  SHOW_LONG},
   {"Max_used_connections_time",(char*) &show_max_used_connections_time, SHOW_SIMPLE_FUNC},
+  {"Memory_allocated",         (char*) offsetof(STATUS_VAR, memory_allocated), SHOW_LONGLONG_STATUS},
   {"Memory_used",              (char*) &show_memory_used, SHOW_SIMPLE_FUNC},
   {"Memory_used_initial",      (char*) &start_memory_used, SHOW_LONGLONG_NOFLUSH},
   {"Resultset_metadata_skipped", (char *) offsetof(STATUS_VAR, skip_metadata_count),SHOW_LONG_STATUS},
@@ -7700,6 +7776,7 @@ SHOW_VAR status_vars[]= {
   {"Qcache_queries_in_cache",  (char*) &query_cache.queries_in_cache, SHOW_LONG_NOFLUSH},
   {"Qcache_total_blocks",      (char*) &query_cache.total_blocks, SHOW_LONG_NOFLUSH},
   {"Queries",                  (char*) &show_queries,            SHOW_SIMPLE_FUNC},
+  {"Query_alloc_retained",     (char*) &show_query_alloc_retained, SHOW_SIMPLE_FUNC},
   {"Questions",                (char*) offsetof(STATUS_VAR, questions), SHOW_LONG_STATUS},
 #ifdef HAVE_REPLICATION
   {"Rpl_status",               (char*) &show_rpl_status,          SHOW_SIMPLE_FUNC},
@@ -7790,6 +7867,8 @@ SHOW_VAR status_vars[]= {
   {"Uptime",                   (char*) &show_starttime,         SHOW_SIMPLE_FUNC},
   {"Uptime_since_flush_status",(char*) &show_flushstatustime,   SHOW_SIMPLE_FUNC},
 #ifdef WITH_WSREP
+  {"wsrep_applier_commit_waits", (char*) offsetof(STATUS_VAR, wsrep_applier_commit_waits), SHOW_LONG_STATUS},
+  {"wsrep_applier_commit_wait_time", (char*) offsetof(STATUS_VAR, wsrep_applier_commit_wait_time), SHOW_LONG_STATUS},
   {"wsrep_connected",         (char*) &wsrep_connected,         SHOW_BOOL},
   {"wsrep_ready",             (char*) &wsrep_show_ready,        SHOW_FUNC},
   {"wsrep_cluster_state_uuid",(char*) &wsrep_cluster_state_uuid,SHOW_CHAR_PTR},
@@ -8597,6 +8676,7 @@ mysql_getopt_value(const char *name, uint length,
   case OPT_KEY_CACHE_AGE_THRESHOLD:
   case OPT_KEY_CACHE_PARTITIONS:
   case OPT_KEY_CACHE_CHANGED_BLOCKS_HASH_SIZE:
+  case OPT_KEY_CACHE_SCAN_RESISTANCE:
   {
     KEY_CACHE *key_cache;
     if (unlikely(!(key_cache= get_or_create_key_cache(name, length))))
@@ -8618,6 +8698,8 @@ mysql_getopt_value(const char *name, uint length,
       return (uchar**) &key_cache->param_partitions;
     case OPT_KEY_CACHE_CHANGED_BLOCKS_HASH_SIZE:
       return (uchar**) &key_cache->changed_blocks_hash_size;
+    case OPT_KEY_CACHE_SCAN_RESISTANCE:
+      return &key_cache->param_scan_resistance;
     }
   }
   /* We return in all cases above. Let us silence -Wimplicit-fallthrough */
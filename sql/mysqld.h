@@ -71,7 +71,8 @@ enum enum_slave_parallel_mode {
   SLAVE_PARALLEL_MINIMAL,
   SLAVE_PARALLEL_CONSERVATIVE,
   SLAVE_PARALLEL_OPTIMISTIC,
-  SLAVE_PARALLEL_AGGRESSIVE
+  SLAVE_PARALLEL_AGGRESSIVE,
+  SLAVE_PARALLEL_WRITESET
 };
 
 /* Function prototypes */
@@ -122,6 +123,8 @@ extern MYSQL_PLUGIN_IMPORT bool volatile abort_loop;
 extern my_bool opt_safe_user_create;
 extern my_bool opt_local_infile, opt_myisam_use_mmap;
 extern my_bool opt_slave_compressed_protocol, use_temp_pool;
+extern ulong opt_slave_compression_algorithm;
+extern uint protocol_compression_zstd_level;
 extern ulong slave_exec_mode_options, slave_ddl_exec_mode_options;
 extern ulong slave_retried_transactions;
 extern ulong transactions_multi_engine;
@@ -207,6 +210,8 @@ extern char log_error_file[FN_REFLEN], *opt_tc_log_file, *opt_ddl_recovery_file;
 extern const double log_10[309];
 extern ulonglong global_max_tmp_space_usage;
 extern Atomic_counter<ulonglong> global_tmp_space_used;
+extern ulonglong global_query_alloc_retain_limit;
+extern Atomic_counter<ulonglong> global_query_alloc_retained;
 extern my_thread_id global_thread_id;
 extern ulong binlog_cache_use, binlog_cache_disk_use;
 extern ulong binlog_stmt_cache_use, binlog_stmt_cache_disk_use;
@@ -223,6 +228,7 @@ extern ulonglong query_cache_size;
 extern ulong query_cache_limit;
 extern ulong query_cache_min_res_unit;
 extern ulong slow_launch_threads, slow_launch_time;
+extern ulong histogram_auto_collect_threshold;
 extern MYSQL_PLUGIN_IMPORT ulong max_connections;
 extern uint max_digest_length;
 extern ulong max_connect_errors, connect_timeout;
@@ -247,9 +253,11 @@ extern ulong opt_binlog_rows_event_max_size;
 extern ulong binlog_row_metadata;
 extern my_bool opt_binlog_gtid_index;
 extern uint opt_binlog_gtid_index_page_size;
+extern uint opt_binlog_writeset_max_keys;
 extern uint opt_binlog_gtid_index_span_min;
 extern ulong thread_cache_size;
 extern ulong stored_program_cache_size;
+extern ulong stored_program_definition_cache_size;
 extern ulong opt_slave_parallel_threads;
 extern ulong opt_slave_domain_parallel_threads;
 extern ulong opt_slave_parallel_max_queued;
@@ -276,6 +284,7 @@ extern const LEX_CSTRING error_clex_str;
 extern SHOW_VAR status_vars[];
 extern struct system_variables max_system_variables;
 extern struct system_status_var global_status_var;
+extern Sharded_counter<int64> global_memory_used_counter;
 extern struct my_rnd_struct sql_rand;
 extern handlerton *partition_hton;
 extern handlerton *myisam_hton;
@@ -322,7 +331,8 @@ extern PSI_mutex_key key_BINLOG_LOCK_index, key_BINLOG_LOCK_xid_list,
   key_LOCK_gdl, key_LOCK_global_system_variables, key_LOCK_manager,
   key_LOCK_prepared_stmt_count,
   key_LOCK_rpl_status, key_LOCK_server_started,
-  key_LOCK_status, key_LOCK_optimizer_costs,
+  key_LOCK_status, key_LOCK_optimizer_costs, key_LOCK_cost_feedback,
+  key_LOCK_histogram_collect,
   key_LOCK_thd_data, key_LOCK_thd_kill,
   key_LOCK_user_conn, key_LOG_LOCK_log, key_gtid_index_lock,
   key_master_info_data_lock, key_master_info_run_lock,
@@ -717,7 +727,7 @@ extern mysql_mutex_t
        LOCK_delayed_status, LOCK_delayed_create, LOCK_crypt, LOCK_timezone,
        LOCK_active_mi, LOCK_manager, LOCK_user_conn,
        LOCK_prepared_stmt_count, LOCK_error_messages,  LOCK_backup_log,
-       LOCK_optimizer_costs;
+       LOCK_optimizer_costs, LOCK_cost_feedback, LOCK_histogram_collect;
 extern MYSQL_PLUGIN_IMPORT mysql_mutex_t LOCK_global_system_variables;
 extern mysql_rwlock_t LOCK_all_status_vars;
 extern mysql_mutex_t LOCK_start_thread;
@@ -733,6 +743,8 @@ extern my_bool opt_use_ssl;
 extern char *opt_ssl_ca, *opt_ssl_capath, *opt_ssl_cert, *opt_ssl_cipher,
   *opt_ssl_key, *opt_ssl_crl, *opt_ssl_crlpath;
 extern ulonglong tls_version;
+extern uint opt_ssl_session_cache_size;
+extern my_bool opt_ssl_ktls;
 
 #ifdef MYSQL_SERVER
 
@@ -773,6 +785,7 @@ enum options_mysqld
   OPT_KEY_CACHE_DIVISION_LIMIT,
   OPT_KEY_CACHE_PARTITIONS,
   OPT_KEY_CACHE_CHANGED_BLOCKS_HASH_SIZE,
+  OPT_KEY_CACHE_SCAN_RESISTANCE,
   OPT_LOG_BASENAME,
   OPT_LOG_ERROR,
   OPT_LOG_SLOW_FILTER,
@@ -49,6 +49,8 @@
 #include "proxy_protocol.h"
 #include <mysql_com_server.h>
 #include <mysqld.h>
+#include <providers/lz4.h>
+#include <providers/zstd.h>
 
 PSI_memory_key key_memory_NET_buff;
 PSI_memory_key key_memory_NET_compress_packet;
@@ -118,6 +120,8 @@ extern my_bool thd_net_is_killed(THD *thd);
 
 
 static my_bool net_write_buff(NET *, const uchar *, size_t len);
+static int net_real_write_gather(NET *net, const uchar *head, size_t head_len,
+                                 const uchar *packet, size_t len);
 
 my_bool net_allocate_new_packet(NET *net, void *thd, uint my_flags);
 
@@ -139,6 +143,8 @@ my_bool my_net_init(NET *net, Vio *vio, void *thd, uint my_flags)
   net->pkt_nr=net->compress_pkt_nr=0;
   net->last_error[0]=0;
   net->compress=0; net->reading_or_writing=0;
+  net->compress_algorithm= NET_COMPRESSION_ZLIB;
+  net->compress_level= NET_COMPRESSION_ZSTD_DEFAULT_LEVEL;
   net->where_b = net->remain_in_buf=0;
   net->net_skip_rest_factor= 0;
   net->last_errno=0;
@@ -581,6 +587,19 @@ net_write_buff(NET *net, const uchar *packet, size_t len)
 #endif
   if (len > left_length)
   {
+    if (net->write_pos != net->buff && !net->compress)
+    {
+      /*
+        Send what is buffered and the whole new packet together, instead
+        of copying a part of the packet into the buffer first.
+      */
+      my_bool error= MY_TEST(net_real_write_gather(net, net->buff,
+                                                   (size_t) (net->write_pos -
+                                                             net->buff),
+                                                   packet, len));
+      net->write_pos= net->buff;
+      return error;
+    }
     if (net->write_pos != net->buff)
     {
       /* Fill up already used packet and write it */
@@ -618,6 +637,108 @@ net_write_buff(NET *net, const uchar *packet, size_t len)
 }
 
 
+#ifdef HAVE_COMPRESS
+/**
+  Compress a packet in place with the algorithm negotiated for the
+  connection.
+
+  @param net      Network handler
+  @param packet   Data to compress; replaced with the compressed data
+  @param len      in: length of the data, out: length of the compressed data
+  @param complen  out: length of the original data
+
+  @retval 0 ok
+  @retval 1 the packet must be sent uncompressed; 'len' is not changed
+*/
+
+static my_bool net_compress(NET *net, uchar *packet, size_t *len,
+                            size_t *complen)
+{
+  if (net->compress_algorithm == NET_COMPRESSION_ZLIB)
+    return my_compress(packet, len, complen);
+  if (*len < MIN_COMPRESS_LENGTH)
+    return 1;
+
+  size_t bound= net->compress_algorithm == NET_COMPRESSION_ZSTD
+    ? ZSTD_compressBound(*len) : size_t(LZ4_compressBound(int(*len)));
+  if (!bound)
+    return 1;
+  uchar *compbuf= (uchar*) my_malloc(key_memory_NET_compress_packet, bound,
+                                     MYF(net->thread_specific_malloc
+                                         ? MY_THREAD_SPECIFIC : 0));
+  if (!compbuf)
+    return 1;
+
+  size_t out;
+  if (net->compress_algorithm == NET_COMPRESSION_ZSTD)
+  {
+    out= ZSTD_compress(compbuf, bound, packet, *len, net->compress_level);
+    if (ZSTD_isError(out))
+      out= 0;
+  }
+  else
+    out= size_t(LZ4_compress_default((const char*) packet, (char*) compbuf,
+                                     int(*len), int(bound)));
+
+  /* Not worth it if the packet did not get smaller */
+  if (!out || out >= *len)
+  {
+    my_free(compbuf);
+    return 1;
+  }
+  memcpy(packet, compbuf, out);
+  my_free(compbuf);
+  *complen= *len;
+  *len= out;
+  return 0;
+}
+
+
+/**
+  Uncompress a packet in place with the algorithm negotiated for the
+  connection.
+
+  @param net      Network handler
+  @param packet   Compressed data; replaced with the original data
+  @param len      Length of the compressed data
+  @param complen  in: length of the original data, or 0 if the packet is
+                  not compressed; out: length of the data at 'packet'
+
+  @retval 0 ok
+  @retval 1 error
+*/
+
+static my_bool net_uncompress(NET *net, uchar *packet, size_t len,
+                              size_t *complen)
+{
+  if (net->compress_algorithm == NET_COMPRESSION_ZLIB)
+    return my_uncompress(packet, len, complen);
+  if (!*complen)
+  {
+    *complen= len;
+    return 0;
+  }
+
+  uchar *compbuf= (uchar*) my_malloc(key_memory_NET_compress_packet, *complen,
+                                     MYF(MY_WME | (net->thread_specific_malloc
+                                                   ? MY_THREAD_SPECIFIC : 0)));
+  if (!compbuf)
+    return 1;
+
+  bool ok;
+  if (net->compress_algorithm == NET_COMPRESSION_ZSTD)
+    ok= ZSTD_decompress(compbuf, *complen, packet, len) == *complen;
+  else
+    ok= LZ4_decompress_safe((const char*) packet, (char*) compbuf, int(len),
+                            int(*complen)) == int(*complen);
+  if (ok)
+    memcpy(packet, compbuf, *complen);
+  my_free(compbuf);
+  return !ok;
+}
+#endif /* HAVE_COMPRESS */
+
+
 /**
   Read and write one packet using timeouts.
   If needed, the packet is compressed before sending.
@@ -628,15 +749,33 @@ net_write_buff(NET *net, const uchar *packet, size_t len)
 
 int
 net_real_write(NET *net,const uchar *packet, size_t len)
+{
+  return net_real_write_gather(net, NULL, 0, packet, len);
+}
+
+
+/**
+  Write the concatenation of head and packet, with a single system call
+  where the transport allows it.
+
+  @note head must be empty if compression is used
+*/
+
+static int
+net_real_write_gather(NET *net, const uchar *head, size_t head_len,
+                      const uchar *packet, size_t len)
 {
   size_t length;
   const uchar *pos,*end;
   uint retry_count=0;
-  DBUG_ENTER("net_real_write");
+  DBUG_ENTER("net_real_write_gather");
+  DBUG_ASSERT(!head_len || !net->compress);
 
 #if defined(MYSQL_SERVER)
   THD *thd= (THD *)net->thd;
 #if defined(USE_QUERY_CACHE)
+  if (head_len)
+    query_cache_insert(thd, (char*) head, head_len, net->pkt_nr);
   query_cache_insert(thd, (char*) packet, len, net->pkt_nr);
 #endif
   if (likely(thd))
@@ -674,7 +813,8 @@ net_real_write(NET *net,const uchar *packet, size_t len)
     memcpy(b+header_length,packet,len);
 
     /* Don't compress error packets (compress == 2) */
-    if (net->compress == 2 || my_compress(b+header_length, &len, &complen))
+    if (net->compress == 2 ||
+        net_compress(net, b+header_length, &len, &complen))
       complen=0;
     int3store(&b[NET_HEADER_SIZE],complen);
     int3store(b,len);
@@ -685,13 +825,17 @@ net_real_write(NET *net,const uchar *packet, size_t len)
 #endif /* HAVE_COMPRESS */
 
 #ifdef DEBUG_DATA_PACKETS
+  if (head_len)
+    DBUG_DUMP("data_written", head, head_len);
   DBUG_DUMP("data_written", packet, len);
 #endif
   pos= packet;
   end=pos+len;
-  while (pos != end)
+  while (head_len || pos != end)
   {
-    length= vio_write(net->vio, pos, (size_t) (end - pos));
+    length= head_len ? vio_write_gather(net->vio, head, head_len,
+                                        pos, (size_t) (end - pos)) :
+                       vio_write(net->vio, pos, (size_t) (end - pos));
     if (ssize_t(length) <= 0)
     {
       bool interrupted= vio_should_retry(net->vio);
@@ -719,15 +863,22 @@ net_real_write(NET *net,const uchar *packet, size_t len)
       MYSQL_SERVER_my_error(net->last_errno, MYF(0));
       break;
     }
-    pos+=length;
     update_statistics(thd_increment_bytes_sent(net->thd, length));
+    if (length < head_len)
+    {
+      head+= length;
+      head_len-= length;
+      continue;
+    }
+    pos+= length - head_len;
+    head_len= 0;
   }
 #ifdef HAVE_COMPRESS
   if (net->compress)
     my_free((void*) packet);
 #endif
   net->reading_or_writing= 0;
-  DBUG_RETURN(pos != end);
+  DBUG_RETURN(head_len || pos != end);
 }
 
 /**
@@ -1186,8 +1337,8 @@ my_net_read_packet_reallen(NET *net, my_bool read_from_server, ulong* reallen)
 	return packet_error;
       }
       read_from_server= 0;
-      if (my_uncompress(net->buff + net->where_b, packet_len,
-			&complen))
+      if (net_uncompress(net, net->buff + net->where_b, packet_len,
+                         &complen))
       {
 	net->error= 2;			/* caller will close socket */
         net->last_errno= ER_NET_UNCOMPRESS_ERROR;
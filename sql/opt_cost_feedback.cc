@@ -0,0 +1,167 @@
+/* This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+#include "mariadb.h"
+#include "sql_priv.h"
+#include "sql_select.h"                         // join_type_str
+#include "sql_show.h"
+#include "sql_i_s.h"
+#include "sql_acl.h"                            // PROCESS_ACL
+#include "sql_parse.h"                          // check_global_access
+#include "opt_cost_feedback.h"
+
+namespace Show {
+
+ST_FIELD_INFO optimizer_cost_feedback_info[]=
+{
+  Column("QUERY_ID",             SLonglong(),          NOT_NULL),
+  Column("TABLE_SCHEMA",         Varchar(NAME_CHAR_LEN), NOT_NULL),
+  Column("TABLE_NAME",           Varchar(NAME_CHAR_LEN), NOT_NULL),
+  Column("ENGINE",               Varchar(NAME_CHAR_LEN), NOT_NULL),
+  Column("PAGE_SIZE",            ULong(10),            NOT_NULL),
+  Column("ACCESS_TYPE",          Varchar(32),          NOT_NULL),
+  Column("EST_LOOPS",            Double(MY_INT64_NUM_DECIMAL_DIGITS), NOT_NULL),
+  Column("EST_ROWS",             Double(MY_INT64_NUM_DECIMAL_DIGITS), NOT_NULL),
+  Column("EST_COST",             Decimal(2006),        NOT_NULL),
+  Column("R_LOOPS",              ULonglong(),          NOT_NULL),
+  Column("R_ROWS",               Double(MY_INT64_NUM_DECIMAL_DIGITS), NOT_NULL),
+  Column("R_TIME_MS",            Decimal(2006),        NOT_NULL),
+  Column("R_PAGES_ACCESSED",     ULonglong(),          NOT_NULL),
+  Column("R_PAGES_READ",         ULonglong(),          NOT_NULL),
+  Column("R_PAGES_READ_TIME_MS", Decimal(2006),        NOT_NULL),
+  CEnd()
+};
+
+} // namespace Show
+
+
+/*
+  One table access of an ANALYZE statement. Names are copied, as the
+  TABLE_SHARE and the handlerton may be gone by the time the entry is read.
+*/
+
+struct Cost_feedback_entry
+{
+  query_id_t query_id;
+  char db[NAME_LEN + 1];
+  char table_name[NAME_LEN + 1];
+  char engine[NAME_LEN + 1];
+  ulong page_size;
+  enum join_type type;
+  double est_loops;
+  double est_rows;
+  double est_cost;
+  ulonglong r_loops;
+  double r_rows;
+  double r_time_ms;
+  ulonglong r_pages_accessed;
+  ulonglong r_pages_read;
+  double r_pages_read_time_ms;
+};
+
+/* Protected by LOCK_cost_feedback */
+static Cost_feedback_entry cost_feedback_history[COST_FEEDBACK_HISTORY];
+static ulonglong cost_feedback_records;
+
+
+static void copy_name(char *to, const char *from, size_t length)
+{
+  length= MY_MIN(length, NAME_LEN);
+  memcpy(to, from, length);
+  to[length]= 0;
+}
+
+
+/**
+  Save the estimate and the measured cost of one table access.
+
+  @note Only accesses that were actually executed, and for which the engine
+  collects handler_stats, are recorded. Without them there is nothing the
+  estimate could be compared against.
+*/
+
+void cost_feedback_record(THD *thd, const Explain_table_access *eta)
+{
+  handler *file= eta->handler_for_stats;
+  if (!file || !file->handler_stats || !eta->tracker.has_scans())
+    return;
+
+  ha_handler_stats *hs= file->handler_stats;
+  TABLE_SHARE *share= file->get_table_share();
+  const LEX_CSTRING *engine= hton_name(file->partition_ht());
+
+  mysql_mutex_lock(&LOCK_cost_feedback);
+  Cost_feedback_entry *entry=
+    &cost_feedback_history[cost_feedback_records++ % COST_FEEDBACK_HISTORY];
+  entry->query_id= thd->query_id;
+  copy_name(entry->db, share->db.str, share->db.length);
+  copy_name(entry->table_name, share->table_name.str,
+            share->table_name.length);
+  copy_name(entry->engine, engine->str, engine->length);
+  entry->page_size= file->stats.block_size;
+  entry->type= eta->type;
+  entry->est_loops= eta->loops;
+  entry->est_rows= rows2double(eta->rows);
+  entry->est_cost= eta->cost;
+  entry->r_loops= eta->tracker.get_loops();
+  entry->r_rows= eta->tracker.get_avg_rows();
+  entry->r_time_ms= eta->op_tracker.get_time_ms();
+  entry->r_pages_accessed= hs->pages_accessed;
+  entry->r_pages_read= hs->pages_read_count;
+  entry->r_pages_read_time_ms= (hs->pages_read_time * 1000. /
+                                timer_tracker_frequency());
+  mysql_mutex_unlock(&LOCK_cost_feedback);
+}
+
+
+int fill_optimizer_cost_feedback(THD *thd, TABLE_LIST *tables, Item *)
+{
+  TABLE *table= tables->table;
+  DBUG_ENTER("fill_optimizer_cost_feedback");
+
+  if (check_global_access(thd, PROCESS_ACL, true))
+    DBUG_RETURN(0);
+
+  mysql_mutex_lock(&LOCK_cost_feedback);
+  ulonglong end= cost_feedback_records;
+  ulonglong start= end > COST_FEEDBACK_HISTORY ?
+                   end - COST_FEEDBACK_HISTORY : 0;
+  int res= 0;
+  for (ulonglong i= start; i < end && !res; i++)
+  {
+    Cost_feedback_entry *entry= &cost_feedback_history[i %
+                                                       COST_FEEDBACK_HISTORY];
+    const char *type= join_type_str[entry->type];
+    restore_record(table, s->default_values);
+    table->field[0]->store((longlong) entry->query_id, false);
+    table->field[1]->store(entry->db, strlen(entry->db), system_charset_info);
+    table->field[2]->store(entry->table_name, strlen(entry->table_name),
+                           system_charset_info);
+    table->field[3]->store(entry->engine, strlen(entry->engine),
+                           system_charset_info);
+    table->field[4]->store((longlong) entry->page_size, true);
+    table->field[5]->store(type, strlen(type), system_charset_info);
+    table->field[6]->store(entry->est_loops);
+    table->field[7]->store(entry->est_rows);
+    table->field[8]->store(entry->est_cost);
+    table->field[9]->store((longlong) entry->r_loops, true);
+    table->field[10]->store(entry->r_rows);
+    table->field[11]->store(entry->r_time_ms);
+    table->field[12]->store((longlong) entry->r_pages_accessed, true);
+    table->field[13]->store((longlong) entry->r_pages_read, true);
+    table->field[14]->store(entry->r_pages_read_time_ms);
+    res= schema_table_store_record(thd, table);
+  }
+  mysql_mutex_unlock(&LOCK_cost_feedback);
+  DBUG_RETURN(res);
+}
@@ -0,0 +1,39 @@
+#ifndef OPT_COST_FEEDBACK_INCLUDED
+#define OPT_COST_FEEDBACK_INCLUDED
+/* This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+/*
+  Cost model calibration feedback.
+
+  When optimizer_cost_feedback=ON, every ANALYZE statement records, for each
+  table access in its plan, the optimizer's estimate (loops, rows, cost)
+  next to what was measured while executing it (loops, rows, time, engine
+  page accesses and reads). The last COST_FEEDBACK_HISTORY accesses are kept
+  in a server-wide ring buffer that is exposed as
+  INFORMATION_SCHEMA.OPTIMIZER_COST_FEEDBACK. The procedure
+  sys.optimizer_cost_calibration() turns it into suggested values for the
+  optimizer_*_cost variables.
+*/
+
+class THD;
+class Item;
+class Explain_table_access;
+struct TABLE_LIST;
+
+#define COST_FEEDBACK_HISTORY 1024
+
+void cost_feedback_record(THD *thd, const Explain_table_access *eta);
+int fill_optimizer_cost_feedback(THD *thd, TABLE_LIST *tables, Item *);
+
+#endif /* OPT_COST_FEEDBACK_INCLUDED */
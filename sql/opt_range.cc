@@ -8354,6 +8354,37 @@ SEL_TREE *Item_func_in::get_func_mm_tree(RANGE_OPT_PARAM *param,
       }
     }
   }
+  else if (array && array->type_handler()->result_type() != ROW_RESULT &&
+           array->used_count)
+  {
+    /*
+      We get here for conditions in form "t.key IN (c1, c2, ...)",
+      where c{i} are constants. The array is already sorted, so walk
+      it instead of the arguments: every distinct value is converted
+      and analyzed once, in ascending order, so that repeated constants
+      in long IN lists do not produce SEL_TREEs that tree_or() has to
+      merge away again.
+    */
+    MEM_ROOT *tmp_root= param->mem_root;
+    param->thd->mem_root= param->old_root;
+    Item *value_item= array->create_item(param->thd);
+    param->thd->mem_root= tmp_root;
+    if (!value_item)
+      DBUG_RETURN(0);
+
+    array->value_to_item(0, value_item);
+    tree= get_mm_parts(param, field, Item_func::EQ_FUNC, value_item);
+    for (uint i= 1; tree && i < array->used_count; i++)
+    {
+      if (array->compare_elems(i, i - 1))
+      {
+        array->value_to_item(i, value_item);
+        tree= tree_or(param, tree, get_mm_parts(param, field,
+                                                Item_func::EQ_FUNC,
+                                                value_item));
+      }
+    }
+  }
   else
   {
     tree= get_mm_parts(param, field, Item_func::EQ_FUNC, args[1]);
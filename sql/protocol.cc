@@ -203,6 +203,17 @@ bool Protocol::net_send_error(THD *thd, uint sql_errno, const char *err,
 */
 
 #ifndef EMBEDDED_LIBRARY
+/**
+  Flush the reply that ends a statement, unless the next pipelined command
+  is already waiting: then the reply stays buffered and goes out in the
+  same write as the following ones.
+*/
+static inline bool net_flush_reply(THD *thd, NET *net)
+{
+  return thd->defer_reply_flush ? false : net_flush(net);
+}
+
+
 bool
 Protocol::net_send_ok(THD *thd,
                       uint server_status, uint statement_warn_count,
@@ -280,7 +291,7 @@ Protocol::net_send_ok(THD *thd,
 
   error= my_net_write(net, (const unsigned char*)store.ptr(), store.length());
   if (likely(!error))
-    error= net_flush(net);
+    error= net_flush_reply(thd, net);
 
   thd->get_stmt_da()->set_overwrite_status(false);
   DBUG_PRINT("info", ("OK sent, so no more error sending allowed"));
@@ -344,7 +355,7 @@ Protocol::net_send_eof(THD *thd, uint server_status, uint statement_warn_count)
     thd->get_stmt_da()->set_overwrite_status(true);
     error= write_eof_packet(thd, net, server_status, statement_warn_count);
     if (likely(!error))
-      error= net_flush(net);
+      error= net_flush_reply(thd, net);
     thd->get_stmt_da()->set_overwrite_status(false);
     DBUG_PRINT("info", ("EOF sent, so no more error sending allowed"));
   }
@@ -37,8 +37,10 @@ static int rr_from_tempfile(READ_RECORD *info);
 template<bool> static int rr_unpack_from_tempfile(READ_RECORD *info);
 template<bool,bool> static int rr_unpack_from_buffer(READ_RECORD *info);
 int rr_from_pointers(READ_RECORD *info);
+int rr_from_pointers_in_batches(READ_RECORD *info);
 static int rr_from_cache(READ_RECORD *info);
 static int init_rr_cache(THD *thd, READ_RECORD *info);
+static int init_rr_batches(THD *thd, READ_RECORD *info);
 static int rr_cmp(uchar *a,uchar *b);
 static int rr_index_first(READ_RECORD *info);
 static int rr_index_last(READ_RECORD *info);
@@ -141,6 +143,13 @@ bool init_read_record_idx(READ_RECORD *info, THD *thd, TABLE *table,
       session variable max_length_for_sort_data.
       In this case the record data is fetched from the handler using the
       saved reference using the rnd_pos handler call.
+    rr_from_pointers_in_batches:
+    ----------------------------
+      Same as rr_from_pointers, for handlers without HA_FAST_KEY_READ.
+      The references are taken a batch at a time, the batch is read in
+      the handler's rowid (primary key) order with handler::cmp_ref()
+      and the records are then returned in sorted order. Used under the
+      same conditions as rr_from_cache.
 
   Methods used when ref's are in a temporary file (using rr_from_tempfile)
     rr_unpack_from_tempfile:
@@ -302,6 +311,24 @@ bool init_read_record(READ_RECORD *info,THD *thd, TABLE *table,
       info->cache_end= (info->cache_pos+
                         filesort->return_rows * info->ref_length);
       info->read_record_func= rr_from_pointers;
+
+      if (!disable_rr_cache &&
+          thd->variables.read_rnd_buff_size &&
+          !(table->file->ha_table_flags() & HA_FAST_KEY_READ) &&
+          (table->db_stat & HA_READ_ONLY ||
+           table->reginfo.lock_type < TL_FIRST_WRITE) &&
+          (ulonglong) table->s->reclength* (table->file->stats.records+
+                                            table->file->stats.deleted) >
+          (ulonglong) MIN_FILE_LENGTH_TO_USE_ROW_CACHE &&
+          filesort->return_rows > MIN_ROWS_TO_USE_TABLE_CACHE &&
+          !table->s->blob_fields && !table->vfield)
+      {
+        if (!init_rr_batches(thd, info))
+        {
+          DBUG_PRINT("info",("using rr_from_pointers_in_batches"));
+          info->read_record_func= rr_from_pointers_in_batches;
+        }
+      }
     }
   }
   else if (table->file->keyread_enabled())
@@ -614,6 +641,116 @@ int rr_from_pointers(READ_RECORD *info)
   return tmp;
 }
 
+/** A rowid of a batch and the position of its record in the batch */
+struct Rr_batch_pos
+{
+  uchar *ref;
+  uint idx;
+};
+
+
+static int rr_cmp_batch_pos(handler *file, const Rr_batch_pos *a,
+                            const Rr_batch_pos *b)
+{
+  return file->cmp_ref(a->ref, b->ref);
+}
+
+
+/*
+  The first batch is small, as a query with LIMIT or a semi-join may stop
+  after a few rows; each following batch is twice as large as the
+  previous one until the read_rnd_buffer_size is used up.
+*/
+static const uint MIN_ROWS_IN_BATCH= 16;
+
+static int init_rr_batches(THD *thd, READ_RECORD *info)
+{
+  uint cache_records;
+  DBUG_ENTER("init_rr_batches");
+
+  info->reclength= ALIGN_SIZE(info->table->s->reclength + 1);
+  info->error_offset= info->table->s->reclength;
+  cache_records= (uint) (thd->variables.read_rnd_buff_size /
+                         (info->reclength + sizeof(Rr_batch_pos)));
+  if (cache_records <= MIN_ROWS_IN_BATCH ||
+      !(info->cache= (uchar*) my_malloc_lock(cache_records *
+                                             (info->reclength +
+                                              sizeof(Rr_batch_pos)),
+                                             MYF(MY_THREAD_SPECIFIC))))
+    DBUG_RETURN(1);
+  DBUG_PRINT("info", ("Allocated buffer for %u records", cache_records));
+
+  info->read_positions= info->cache + cache_records * info->reclength;
+  info->max_batch_records= cache_records;
+  info->batch_records= MIN_ROWS_IN_BATCH / 2;
+  info->ref_cursor= info->cache_pos;
+  info->ref_end= info->cache_end;
+  info->cache_pos= info->cache_end= info->cache;
+  DBUG_RETURN(0);
+}
+
+
+int rr_from_pointers_in_batches(READ_RECORD *info)
+{
+  handler *file= info->table->file;
+
+  for (;;)
+  {
+    if (info->cache_pos != info->cache_end)
+    {
+      uchar *record_pos= info->cache_pos;
+      info->cache_pos+= info->reclength;
+      if (likely(!record_pos[info->error_offset]))
+      {
+        memcpy(info->record(), record_pos,
+               (size_t) info->table->s->reclength);
+        return 0;
+      }
+      int16 error;
+      shortget(error, record_pos);
+      /* The following is extremely unlikely to happen */
+      if (error == HA_ERR_KEY_NOT_FOUND)
+        continue;
+      return rr_handle_error(info, error);
+    }
+
+    if (info->ref_cursor == info->ref_end)
+      return -1;                                /* End of file */
+
+    info->batch_records= MY_MIN(info->batch_records * 2,
+                                info->max_batch_records);
+    uint length= (uint) MY_MIN((size_t) info->batch_records,
+                                (size_t) (info->ref_end - info->ref_cursor) /
+                                info->ref_length);
+    Rr_batch_pos *positions= (Rr_batch_pos*) info->read_positions;
+    for (uint i= 0; i < length; i++)
+    {
+      positions[i].ref= info->ref_cursor;
+      positions[i].idx= i;
+      info->ref_cursor+= info->ref_length;
+    }
+    my_qsort2(positions, length, sizeof(Rr_batch_pos),
+              (qsort2_cmp) rr_cmp_batch_pos, file);
+
+    for (uint i= 0; i < length; i++)
+    {
+      uchar *record_pos= info->cache + positions[i].idx * info->reclength;
+      int16 error;
+      if (unlikely((error= (int16) file->ha_rnd_pos(record_pos,
+                                                    positions[i].ref))))
+      {
+        record_pos[info->error_offset]= 1;
+        shortstore(record_pos, error);
+      }
+      else
+        record_pos[info->error_offset]= 0;
+    }
+    info->cache_end= (info->cache_pos= info->cache) +
+                     length * info->reclength;
+  }
+}
+
+
 /**
   Read a result set record from a buffer after sorting.
 
@@ -66,6 +66,9 @@ struct READ_RECORD
   uchar *ref_pos;				/* pointer to form->refpos */
   uchar *rec_buf;                /* to read field values  after filesort */
   uchar	*cache,*cache_pos,*cache_end,*read_positions;
+  /* rr_from_pointers_in_batches(): next and end of the sorted rowids */
+  uchar *ref_cursor, *ref_end;
+  uint batch_records, max_batch_records;
 
   /*
     Structure storing information about sorting
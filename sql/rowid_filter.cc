@@ -22,6 +22,8 @@
 #include "optimizer_defaults.h"
 #include "sql_select.h"
 #include "opt_trace.h"
+#include "key.h"
+#include "bloom_filters.h"
 
 /*
   key_next_find_cost below is the cost of finding the next possible key
@@ -34,6 +36,9 @@ lookup_cost(Rowid_filter_container_type cont_type)
   switch (cont_type) {
   case SORTED_ARRAY_CONTAINER:
     return log2(est_elements) * rowid_compare_cost + base_lookup_cost;
+  case BLOOM_FILTER_CONTAINER:
+    /* Hashing a rowid costs about as much as one comparison of rowids */
+    return rowid_compare_cost + base_lookup_cost;
   default:
     DBUG_ASSERT(0);
     return 0;
@@ -52,8 +57,11 @@ double Range_rowid_filter_cost_info::
 avg_access_and_eval_gain_per_row(Rowid_filter_container_type cont_type,
                                  double cost_of_row_fetch)
 {
-  return (cost_of_row_fetch + where_cost) * (1 - selectivity) -
-         lookup_cost(cont_type);
+  double rejected= 1 - selectivity;
+  /* False positives of a bloom filter are fetched and evaluated anyway */
+  if (cont_type == BLOOM_FILTER_CONTAINER)
+    rejected*= 1 - Rowid_filter_bloom::false_positive_rate;
+  return (cost_of_row_fetch + where_cost) * rejected - lookup_cost(cont_type);
 }
 
 
@@ -165,6 +173,10 @@ Range_rowid_filter_cost_info::build_cost(Rowid_filter_container_type cont_type)
             (costs->rowid_copy_cost +                      // Copying rowid
              costs->rowid_cmp_cost * log2(est_elements))); // Sort
     break;
+  case BLOOM_FILTER_CONTAINER:
+    /* Add cost of hashing the rowids. There is no sorting */
+    cost+= est_elements * costs->rowid_cmp_cost;
+    break;
   default:
     DBUG_ASSERT(0);
   }
@@ -184,6 +196,9 @@ Rowid_filter_container *Range_rowid_filter_cost_info::create_container()
     res= new (thd->mem_root) Rowid_filter_sorted_array((uint) est_elements,
                                                        elem_sz);
     break;
+  case BLOOM_FILTER_CONTAINER:
+    res= new (thd->mem_root) Rowid_filter_bloom((uint) est_elements);
+    break;
   default:
     DBUG_ASSERT(0);
   }
@@ -342,6 +357,42 @@ get_max_range_rowid_filter_elems_for_table(
 }
 
 
+/**
+  @brief
+    Choose the type of the container for a range filter built over an index
+
+  @details
+    A sorted array is used whenever it is not too large. Otherwise a bloom
+    filter is used if it is not too large. A bloom filter takes a few bits
+    per element instead of ref_length bytes, so it can be used for ranges
+    that are too large for a sorted array.
+
+  @retval
+    true    the filter over the index key_no cannot be used
+    false   otherwise, the chosen type is returned in *cont_type
+*/
+
+static bool
+choose_range_rowid_filter_container(THD *thd, TABLE *tab, uint key_no,
+                                    Rowid_filter_container_type *cont_type)
+{
+  ha_rows rows= tab->opt_range[key_no].rows;
+  if (rows <= get_max_range_rowid_filter_elems_for_table(thd, tab,
+                                                         SORTED_ARRAY_CONTAINER))
+  {
+    *cont_type= SORTED_ARRAY_CONTAINER;
+    return false;
+  }
+  if (Rowid_filter_bloom::size_for_elements(rows) <=
+      thd->variables.max_rowid_filter_size)
+  {
+    *cont_type= BLOOM_FILTER_CONTAINER;
+    return false;
+  }
+  return true;
+}
+
+
 /**
   @brief
     Prepare info on possible range filters used by optimizer
@@ -367,7 +418,10 @@ void TABLE::init_cost_info_for_usable_range_rowid_filters(THD *thd)
 {
   uint key_no;
   key_map usable_range_filter_keys;
+  key_map bloom_filter_keys;
+  Rowid_filter_container_type cont_type;
   usable_range_filter_keys.clear_all();
+  bloom_filter_keys.clear_all();
   key_map::Iterator it(opt_range_keys);
 
   if (file->ha_table_flags() & HA_NON_COMPARABLE_ROWID)
@@ -383,11 +437,12 @@ void TABLE::init_cost_info_for_usable_range_rowid_filters(THD *thd)
   {
   if (!can_use_rowid_filter(key_no))                                // 1 & 2
       continue;
-   if (opt_range[key_no].rows >
-       get_max_range_rowid_filter_elems_for_table(thd, this,
-                                                  SORTED_ARRAY_CONTAINER)) // !3
+   if (choose_range_rowid_filter_container(thd, this, key_no,
+                                           &cont_type))                 // !3
       continue;
     usable_range_filter_keys.set_bit(key_no);
+    if (cont_type == BLOOM_FILTER_CONTAINER)
+      bloom_filter_keys.set_bit(key_no);
   }
 
   /*
@@ -420,7 +475,10 @@ void TABLE::init_cost_info_for_usable_range_rowid_filters(THD *thd)
   while ((key_no= li++) != key_map::Iterator::BITMAP_END)
   {
     *curr_ptr= curr_filter_cost_info;
-    curr_filter_cost_info->init(SORTED_ARRAY_CONTAINER, this, key_no);
+    curr_filter_cost_info->init(bloom_filter_keys.is_set(key_no) ?
+                                BLOOM_FILTER_CONTAINER :
+                                SORTED_ARRAY_CONTAINER,
+                                this, key_no);
     curr_ptr++;
     curr_filter_cost_info++;
   }
@@ -622,7 +680,7 @@ Rowid_filter::build_return_code Range_rowid_filter::build()
         break;
       }
       file->position(quick->record);
-      if (container->add(NULL, (char *) file->ref))
+      if (container->add(table, (char *) file->ref))
       {
         rc= NON_FATAL_ERROR;
         break;
@@ -689,6 +747,105 @@ bool Rowid_filter_sorted_array::check(void *ctxt, char *elem)
 }
 
 
+/**
+  @brief
+    Calculate the hash of a rowid / primary key
+
+  @details
+    Rows with equal rowids must get equal hashes. If the rowid is a clustered
+    primary key then it is compared by handler::cmp_ref() taking into account
+    the collations of its fields, so its hash is calculated in the same way.
+    Otherwise the bytes of the rowid are hashed.
+*/
+
+ulonglong Rowid_filter_bloom::hash(TABLE *table, const char *elem)
+{
+  handler *file= table->file;
+  uint pk= table->s->primary_key;
+  if (pk != MAX_KEY && file->pk_is_clustering_key(pk))
+  {
+    KEY *key_info= table->key_info + pk;
+    return key_hashnr(key_info, key_info->user_defined_key_parts,
+                      (const uchar *) elem);
+  }
+  return my_hash_sort(&my_charset_bin, (const uchar *) elem, file->ref_length);
+}
+
+
+/**
+  @brief
+    Return the size in bytes of a bloom filter for the given number of elements
+*/
+
+ulonglong Rowid_filter_bloom::size_for_elements(ulonglong elems)
+{
+  double bits_per_val= -1.44 * log2(false_positive_rate);
+  double bits= MY_MAX(512.0, bits_per_val * elems + 0.5);
+  if (bits >= (double) INT_MAX32)
+    return ULONGLONG_MAX;
+  /* One 64 bit block per 32 bits on the rounded down power of two */
+  return (1ULL << my_bit_log2_uint32((uint32) bits)) / 4;
+}
+
+
+bool Rowid_filter_bloom::alloc()
+{
+  DBUG_ASSERT(!filter);
+  filter= new PatternedSimdBloomFilter<uchar>((int) max_elements,
+                                              false_positive_rate);
+  return filter == 0;
+}
+
+
+Rowid_filter_bloom::~Rowid_filter_bloom()
+{
+  delete filter;
+}
+
+
+void Rowid_filter_bloom::flush_pending()
+{
+  if (!n_pending)
+    return;
+  /* Pad the batch with the copies of its first element */
+  for (uint i= n_pending; i < 8; i++)
+    pending[i]= pending[0];
+  filter->Insert(pending);
+  n_pending= 0;
+}
+
+
+bool Rowid_filter_bloom::add(void *ctxt, char *elem)
+{
+  pending[n_pending++]= (const uchar *) (intptr) hash((TABLE *) ctxt, elem);
+  n_elements++;
+  if (n_pending == 8)
+    flush_pending();
+  return false;
+}
+
+
+/**
+  @brief
+    Check a rowid against a bloom filter
+
+  @param ctxt   the TABLE structure of the table elem refers to
+  @param elem   rowid / primary key to look for
+
+  @retval
+    false   elem is definitely not in the container
+    true    elem is probably in the container
+*/
+
+bool Rowid_filter_bloom::check(void *ctxt, char *elem)
+{
+  DBUG_ASSERT(!n_pending);
+  uchar *h= (uchar *) (intptr) hash((TABLE *) ctxt, elem);
+  uchar *batch[8]= {h, h, h, h, h, h, h, h};
+  return filter->Query(batch) & 1;
+}
+
+
 Range_rowid_filter::~Range_rowid_filter()
 {
   delete container;
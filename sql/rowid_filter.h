@@ -146,9 +146,11 @@ class Range_rowid_filter_cost_info;
 typedef enum
 {
   SORTED_ARRAY_CONTAINER,
-  BLOOM_FILTER_CONTAINER      // Not used yet
+  BLOOM_FILTER_CONTAINER
 } Rowid_filter_container_type;
 
+template <typename T> struct PatternedSimdBloomFilter;
+
 /**
   @class Rowid_filter_container
 
@@ -384,6 +386,73 @@ class Rowid_filter_sorted_array: public Rowid_filter_container
 
 };
 
+
+/**
+  @class Rowid_filter_bloom
+
+  The implementation of the Rowid_filter_container interface as
+  a bloom filter over hashes of rowids / primary keys.
+
+  The container is used when a sorted array with the expected number of
+  elements would exceed max_rowid_filter_size. It takes a few bits per
+  element no matter what the length of rowids is, and a check costs the
+  same as a hash calculation. The price is that a small fraction of the
+  rowids that are not in the filter pass the check. This is acceptable
+  for a rowid filter, where a false positive only means that a row is
+  read and then rejected by the condition.
+*/
+
+class Rowid_filter_bloom: public Rowid_filter_container
+{
+  /* The expected number of elements in the filter */
+  uint max_elements;
+  /* The number of elements added to the filter */
+  uint n_elements;
+  PatternedSimdBloomFilter<uchar> *filter;
+  /*
+    The bloom filter works in batches of 8 elements.
+    Hashes of the added rowids are accumulated here until a batch is full.
+  */
+  const uchar *pending[8];
+  uint n_pending;
+
+  static ulonglong hash(TABLE *table, const char *elem);
+  void flush_pending();
+
+public:
+  /* The share of false positives the filter is sized for */
+  static constexpr float false_positive_rate= 0.01f;
+
+  Rowid_filter_bloom(uint elems)
+    : max_elements(elems), n_elements(0), filter(0), n_pending(0) {}
+
+  ~Rowid_filter_bloom();
+
+  Rowid_filter_container_type get_type() override
+  { return BLOOM_FILTER_CONTAINER; }
+
+  bool alloc() override;
+
+  bool add(void *ctxt, char *elem) override;
+
+  bool check(void *ctxt, char *elem) override;
+
+  uint elements() override { return n_elements; }
+
+  /*
+    There is nothing to sort in a bloom filter. The call is made when all
+    elements have been added, so the last incomplete batch is flushed here.
+  */
+  void sort (int (*cmp) (void *ctxt, const void *el1, const void *el2),
+                         void *cmp_arg) override
+  {
+    flush_pending();
+  }
+
+  /* Number of bytes the filter needs for the given number of elements */
+  static ulonglong size_for_elements(ulonglong elems);
+};
+
 /**
   @class Range_rowid_filter_cost_info
 
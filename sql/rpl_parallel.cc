@@ -1024,6 +1024,7 @@ retry_event_group(rpl_group_info *rgi, rpl_parallel_thread *rpt,
 
 #endif /* WITH_WSREP */
   strmake_buf(log_name, ir->name);
+  rli->relay_log.flush_relay_log_buffer();
   if ((fd= open_binlog(&rlog, log_name, &errmsg)) <0)
   {
     err= 1;
@@ -1110,6 +1111,7 @@ retry_event_group(rpl_group_info *rgi, rpl_parallel_thread *rpt,
             goto check_retry;
           }
       });
+      rli->relay_log.flush_relay_log_buffer();
       if ((fd= open_binlog(&rlog, log_name, &errmsg)) <0)
       {
         err= 1;
@@ -2615,6 +2617,64 @@ rpl_parallel_entry::check_xa_xid_dependency(xid_t *xid)
 }
 
 
+/*
+  Check if an event group with a tableset may conflict with an event group
+  that was queued earlier and has not committed yet.
+
+  committed_sub_id is a (possibly stale) value of last_committed_sub_id; a
+  stale value only makes the check more conservative.
+*/
+bool
+rpl_parallel_entry::writeset_conflicts(const Gtid_log_event *gtid_ev,
+                                       uint64 committed_sub_id) const
+{
+  DBUG_ASSERT(gtid_ev->flags_extra & Gtid_log_event::FL_EXTRA_TABLESET);
+  const bool has_writeset=
+    gtid_ev->flags_extra & Gtid_log_event::FL_EXTRA_WRITESET;
+  const uint64 *tables= has_writeset ? tableset_coarse_history
+                                     : tableset_history;
+  if (writeset_unknown_sub_id > committed_sub_id)
+    return true;
+  for (uint i= 0; i < gtid_ev->tableset_count; i++)
+  {
+    if (tables[gtid_ev->tableset_key(i) % tableset_history_size] >
+        committed_sub_id)
+      return true;
+  }
+  for (uint i= 0; i < gtid_ev->writeset_count; i++)
+  {
+    if (writeset_history[gtid_ev->writeset_key(i) % writeset_history_size] >
+        committed_sub_id)
+      return true;
+  }
+  return false;
+}
+
+
+/* Remember the keys and tables of an event group queued with sub_id. */
+void
+rpl_parallel_entry::writeset_record(const Gtid_log_event *gtid_ev,
+                                    uint64 sub_id)
+{
+  if (!(gtid_ev->flags_extra & Gtid_log_event::FL_EXTRA_TABLESET))
+  {
+    writeset_unknown_sub_id= sub_id;
+    return;
+  }
+  const bool has_writeset=
+    gtid_ev->flags_extra & Gtid_log_event::FL_EXTRA_WRITESET;
+  for (uint i= 0; i < gtid_ev->tableset_count; i++)
+  {
+    uint32 slot= gtid_ev->tableset_key(i) % tableset_history_size;
+    tableset_history[slot]= sub_id;
+    if (!has_writeset)
+      tableset_coarse_history[slot]= sub_id;
+  }
+  for (uint i= 0; i < gtid_ev->writeset_count; i++)
+    writeset_history[gtid_ev->writeset_key(i) % writeset_history_size]= sub_id;
+}
+
+
 /*
   Obtain a worker thread that we can queue an event to.
 
@@ -3346,6 +3406,7 @@ rpl_parallel::do_event(rpl_group_info *serial_rgi, Log_event *ev,
   }
 
   Gtid_log_event *gtid_ev= NULL;
+  uint64 writeset_committed_sub_id= 0;
   if (typ == GTID_EVENT)
   {
     rpl_gtid gtid;
@@ -3378,6 +3439,13 @@ rpl_parallel::do_event(rpl_group_info *serial_rgi, Log_event *ev,
       delete_or_keep_event_post_apply(serial_rgi, typ, ev);
       return 0;
     }
+
+    if (rli->mi->parallel_mode == SLAVE_PARALLEL_WRITESET)
+    {
+      mysql_mutex_lock(&e->LOCK_parallel_entry);
+      writeset_committed_sub_id= e->last_committed_sub_id;
+      mysql_mutex_unlock(&e->LOCK_parallel_entry);
+    }
   }
   else
     e= current;
@@ -3387,6 +3455,14 @@ rpl_parallel::do_event(rpl_group_info *serial_rgi, Log_event *ev,
     Prefer a new thread, so we maximise parallelism (at least for the group
     commit). But do not exceed a limit of --slave-domain-parallel-threads;
     instead re-use a thread that we queued for previously.
+
+    All events of one event group go to the same worker, however large the
+    group is. The storage engine transaction (and its locks and undo) is
+    bound to the worker's THD, so row events of one transaction can not be
+    split across workers and still commit atomically. Parallelism for large
+    transactions must come from running the following event groups
+    speculatively, see --slave-parallel-mode; with writeset, a transaction
+    with too many keys only holds back event groups on the same tables.
   */
   cur_thread=
     e->choose_thread(serial_rgi, &did_enter_cond, &old_stage, gtid_ev);
@@ -3468,7 +3544,28 @@ rpl_parallel::do_event(rpl_group_info *serial_rgi, Log_event *ev,
         */
         new_gco= false;
       }
-      else if ((mode >= SLAVE_PARALLEL_OPTIMISTIC) &&
+      else if (mode == SLAVE_PARALLEL_WRITESET &&
+               !(flags & group_commit_orderer::FORCE_SWITCH) &&
+               (gtid_flags & Gtid_log_event::FL_TRANSACTIONAL) &&
+               (gtid_ev->flags_extra & Gtid_log_event::FL_EXTRA_TABLESET))
+      {
+        /*
+          The master logged the unique keys changed by this transaction, or
+          only its tables if it changed too many rows. If none of them were
+          changed by an earlier transaction that is still uncommitted, run
+          it in parallel. The optimistic rollback and retry
+          still catches conflicts the writeset can not see (eg. foreign keys).
+          Otherwise wait for prior transactions to commit before starting,
+          without blocking the transactions that follow.
+        */
+        new_gco= false;
+        if (e->writeset_conflicts(gtid_ev, writeset_committed_sub_id))
+          speculation= rpl_group_info::SPECULATE_WAIT;
+        else
+          speculation= rpl_group_info::SPECULATE_OPTIMISTIC;
+      }
+      else if ((mode == SLAVE_PARALLEL_OPTIMISTIC ||
+                mode == SLAVE_PARALLEL_AGGRESSIVE) &&
                !(flags & group_commit_orderer::FORCE_SWITCH))
       {
         /*
@@ -3543,6 +3640,8 @@ rpl_parallel::do_event(rpl_group_info *serial_rgi, Log_event *ev,
       e->current_gco= gco;
     }
     rgi->gco= gco;
+    if (mode == SLAVE_PARALLEL_WRITESET)
+      e->writeset_record(gtid_ev, rgi->gtid_sub_id);
 
     qev->rgi= e->current_group_info= rgi;
     e->current_sub_id= rgi->gtid_sub_id;
@@ -479,6 +479,28 @@ struct rpl_parallel_entry {
   group_commit_orderer *current_gco;
   /* Relay log info of replication source for this entry. */
   Relay_log_info *rli;
+  /*
+    Writeset history for --slave-parallel-mode=writeset. Each slot holds the
+    sub_id of the last queued event group that changed a unique key hashing
+    to that slot. An event group conflicts with any earlier one that has not
+    yet committed (sub_id > last_committed_sub_id). Collisions between keys
+    sharing a slot only cause false conflicts.
+
+    tableset_history does the same for the tables changed by an event group,
+    and tableset_coarse_history only for event groups that came with a
+    tableset but without a writeset (too many keys, or a table without a
+    unique key). An event group with a writeset conflicts with those on the
+    same tables; one without conflicts with any earlier one on its tables.
+
+    writeset_unknown_sub_id is the last event group queued without a
+    tableset; every event group conflicts with it until it commits.
+  */
+  static const uint32 writeset_history_size= 4096;
+  uint64 writeset_history[writeset_history_size];
+  static const uint32 tableset_history_size= 1024;
+  uint64 tableset_history[tableset_history_size];
+  uint64 tableset_coarse_history[tableset_history_size];
+  uint64 writeset_unknown_sub_id;
 
   void check_scheduling_generation(sched_bucket *cur);
   sched_bucket *check_xa_xid_dependency(xid_t *xid);
@@ -490,6 +512,9 @@ struct rpl_parallel_entry {
                          rpl_group_info *rgi, PSI_stage_info *old_stage);
   int queue_master_restart(rpl_group_info *rgi,
                            Format_description_log_event *fdev);
+  bool writeset_conflicts(const Gtid_log_event *gtid_ev,
+                          uint64 committed_sub_id) const;
+  void writeset_record(const Gtid_log_event *gtid_ev, uint64 sub_id);
   /*
     the initial size of maybe_ array corresponds to the case of
     each worker receives perhaps unlikely XA-PREPARE and XA-COMMIT within
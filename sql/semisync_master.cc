@@ -586,15 +586,15 @@ void Repl_semi_sync_master::remove_slave()
   @retval -1  Slave is going down (ok)
 */
 
-int Repl_semi_sync_master::report_reply_packet(uint32 server_id,
-                                               const uchar *packet,
-                                               ulong packet_len)
+int Repl_semi_sync_master::read_reply_packet(uint32 server_id,
+                                             const uchar *packet,
+                                             ulong packet_len,
+                                             char *log_file_name,
+                                             my_off_t *log_file_pos)
 {
   int result= 1;                                // Assume error
-  char log_file_name[FN_REFLEN+1];
-  my_off_t log_file_pos;
   ulong log_file_len = 0;
-  DBUG_ENTER("Repl_semi_sync_master::report_reply_packet");
+  DBUG_ENTER("Repl_semi_sync_master::read_reply_packet");
 
   DBUG_EXECUTE_IF("semisync_corrupt_magic",
                   const_cast<uchar*>(packet)[REPLY_MAGIC_NUM_OFFSET]= 0;);
@@ -618,7 +618,7 @@ int Repl_semi_sync_master::report_reply_packet(uint32 server_id,
     goto l_end;
   }
 
-  log_file_pos = uint8korr(packet + REPLY_BINLOG_POS_OFFSET);
+  *log_file_pos = uint8korr(packet + REPLY_BINLOG_POS_OFFSET);
   log_file_len = packet_len - REPLY_BINLOG_NAME_OFFSET;
   if (unlikely(log_file_len >= FN_REFLEN))
   {
@@ -631,11 +631,10 @@ int Repl_semi_sync_master::report_reply_packet(uint32 server_id,
   DBUG_ASSERT(dirname_length(log_file_name) == 0);
 
   DBUG_PRINT("semisync", ("%s: Got reply(%s, %lu) from server %u",
-                          "Repl_semi_sync_master::report_reply_packet",
-                          log_file_name, (ulong)log_file_pos, server_id));
+                          "Repl_semi_sync_master::read_reply_packet",
+                          log_file_name, (ulong)*log_file_pos, server_id));
 
   rpl_semi_sync_master_get_ack++;
-  report_reply_binlog(server_id, log_file_name, log_file_pos);
   DBUG_RETURN(0);
 
 l_end:
@@ -558,9 +558,18 @@ class Repl_semi_sync_master
   /* Remove a semi-sync replication slave */
   void remove_slave();
 
-  /* It parses a reply packet and call report_reply_binlog to handle it. */
-  int report_reply_packet(uint32 server_id, const uchar *packet,
-                        ulong packet_len);
+  /* It parses a reply packet into the binlog position it acknowledges.
+   * The caller passes the position to report_reply_binlog(), once for the
+   * last of the replies it has read from the slave.
+   *
+   * Input:
+   *  server_id     - (IN)  slave server id number
+   *  log_file_name - (OUT) binlog file name, at least FN_REFLEN+1 long
+   *  log_file_pos  - (OUT) binlog file position
+   */
+  int read_reply_packet(uint32 server_id, const uchar *packet,
+                        ulong packet_len, char *log_file_name,
+                        my_off_t *log_file_pos);
 
   /* In semi-sync replication, reports up to which binlog position we have
    * received replies from the slave indicating that it already get the events.
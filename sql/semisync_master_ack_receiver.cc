@@ -318,6 +318,10 @@ void Ack_receiver::run()
     }
 
     listener.clear_signal();
+    /* Let replies queue up in the sockets */
+    DBUG_EXECUTE_IF("semisync_ack_receiver_hold",
+                    while (DBUG_IF("semisync_ack_receiver_hold"))
+                      my_sleep(10000););
     mysql_mutex_lock(&m_mutex);
     set_stage_info(stage_reading_semi_sync_ack);
     Slave_ilist_iterator it(m_slaves);
@@ -349,12 +353,53 @@ void Ack_receiver::run()
           continue;
         }
 
-        len= my_net_read(&net);
+        /*
+          A slave acknowledges positions in increasing order, so the last
+          reply covers all earlier ones. Read all replies that have
+          already arrived and report only the last, so that waiting
+          transactions are released in one pass over the active
+          transactions instead of one pass per reply. The Vio does not
+          buffer reads, so ask the socket whether another reply is there.
+        */
+        char log_file_name[FN_REFLEN+1];
+        my_off_t log_file_pos;
+        uint replies= 0;
+        int res= 0;
+        do
+        {
+          len= my_net_read(&net);
+          if (unlikely(len == packet_error))
+            break;
+          char reply_file_name[FN_REFLEN+1];
+          my_off_t reply_file_pos;
+          res= repl_semisync_master.read_reply_packet(slave->server_id(),
+                                                      net.read_pos, len,
+                                                      reply_file_name,
+                                                      &reply_file_pos);
+          if (likely(res == 0))
+          {
+            strmake_buf(log_file_name, reply_file_name);
+            log_file_pos= reply_file_pos;
+            replies++;
+          }
+          net_clear(&net, 0);
+        } while (res >= 0 &&
+                 (slave->vio.has_data(&slave->vio) ||
+                  vio_io_wait(&slave->vio, VIO_IO_EVENT_READ, 0) > 0));
+
+        if (replies)
+        {
+          DBUG_EXECUTE_IF("semisync_log_ack_batch",
+                          if (replies > 1)
+                            sql_print_information("Semisync ack receiver "
+                                                  "reported %u replies at "
+                                                  "once", replies););
+          repl_semisync_master.report_reply_binlog(slave->server_id(),
+                                                   log_file_name,
+                                                   log_file_pos);
+        }
         if (likely(len != packet_error))
         {
-          int res;
-          res= repl_semisync_master.report_reply_packet(slave->server_id(),
-                                                        net.read_pos, len);
           if (unlikely(res < 0))
           {
             /*
@@ -6774,7 +6774,19 @@ static int queue_event(Master_info* mi, const uchar *buf, ulong event_len)
         int4store(&buf[event_len - BINLOG_CHECKSUM_LEN], crc);
       }
     }
-    if (likely(!rli->relay_log.write_event_buffer((uchar*)buf, event_len)))
+    /*
+      The SQL thread reads the hot relay log through the IO_CACHE that we
+      append to here, so it sees the event without a flush. And
+      flush_master_info() flushes the relay log before it stores a new
+      master position. So a write() per event is only needed when the
+      relay log contents are used after a crash, which is not the case
+      with GTID (relay logs are purged when the slave starts) or with
+      relay_log_recovery. A semi-sync reply promises the event is written.
+    */
+    bool flush_event= (mi->using_gtid == Master_info::USE_GTID_NO &&
+                       !relay_log_recovery) || mi->semi_sync_reply_enabled;
+    if (likely(!rli->relay_log.write_event_buffer((uchar*)buf, event_len,
+                                                  flush_event)))
     {
       mi->master_log_pos+= inc_pos;
       DBUG_PRINT("info", ("master_log_pos: %lu", (ulong) mi->master_log_pos));
@@ -6963,7 +6975,13 @@ static int connect_to_master(THD* thd, MYSQL* mysql, Master_info* mi,
 #endif
   ulong client_flag= CLIENT_REMEMBER_OPTIONS;
   if (opt_slave_compressed_protocol)
+  {
+    uint algorithm= (uint) opt_slave_compression_algorithm;
     client_flag|= CLIENT_COMPRESS;                /* We will use compression */
+    mysql_options(mysql, MYSQL_OPT_COMPRESSION_ALGORITHM, &algorithm);
+    mysql_options(mysql, MYSQL_OPT_ZSTD_COMPRESSION_LEVEL,
+                  &protocol_compression_zstd_level);
+  }
 
   mysql_options(mysql, MYSQL_OPT_CONNECT_TIMEOUT, &slave_net_timeout);
   mysql_options(mysql, MYSQL_OPT_READ_TIMEOUT, &slave_net_timeout);
@@ -667,6 +667,215 @@ bool AUTHID::read_from_mysql_proc_row(THD *thd, TABLE *table)
 }
 
 
+/*
+  Definitions of stored routines read from mysql.proc, shared by all
+  connections when stored_program_definition_cache is not 0.
+
+  Every connection still builds its own sp_head, as sp_head, its
+  instructions and items keep the execution state of the routine, but the
+  first call of a routine in a connection does not have to open and read
+  mysql.proc. An entry is used only while sp_cache_version(), which is
+  incremented by every change of a stored routine, is the same as
+  when the row was read.
+*/
+
+struct Sp_definition
+{
+  MEM_ROOT mem_root;
+  LEX_CSTRING key;
+  ulong version;
+  sql_mode_t sql_mode;
+  longlong created;
+  longlong modified;
+  st_sp_chistics chistics;
+  AUTHID definer;
+  LEX_CSTRING params;
+  LEX_CSTRING returns;
+  LEX_CSTRING body;
+  Stored_program_creation_ctx *creation_ctx;
+};
+
+static HASH sp_definitions;
+static mysql_mutex_t LOCK_sp_definitions;
+
+#ifdef HAVE_PSI_INTERFACE
+static PSI_mutex_key key_LOCK_sp_definitions;
+
+static PSI_mutex_info all_sp_definitions_mutexes[]=
+{
+  { &key_LOCK_sp_definitions, "LOCK_sp_definitions", PSI_FLAG_GLOBAL}
+};
+#endif
+
+
+extern "C" uchar *sp_definition_get_key(const uchar *ptr, size_t *plen,
+                                        my_bool first)
+{
+  Sp_definition *def= (Sp_definition *) ptr;
+  *plen= def->key.length;
+  return (uchar *) def->key.str;
+}
+
+
+extern "C" void sp_definition_free(void *ptr)
+{
+  Sp_definition *def= (Sp_definition *) ptr;
+  MEM_ROOT mem_root= def->mem_root;
+  free_root(&mem_root, MYF(0));
+}
+
+
+void sp_definition_cache_init()
+{
+#ifdef HAVE_PSI_INTERFACE
+  mysql_mutex_register("sql", all_sp_definitions_mutexes,
+                       array_elements(all_sp_definitions_mutexes));
+#endif
+  mysql_mutex_init(key_LOCK_sp_definitions, &LOCK_sp_definitions,
+                   MY_MUTEX_INIT_FAST);
+  my_hash_init(key_memory_sp_cache, &sp_definitions, &my_charset_bin, 0, 0,
+               0, sp_definition_get_key, sp_definition_free, 0);
+}
+
+
+void sp_definition_cache_end()
+{
+  my_hash_free(&sp_definitions);
+  mysql_mutex_destroy(&LOCK_sp_definitions);
+}
+
+
+/**
+  Make the key of a routine in sp_definitions: the type of the routine
+  followed by its qualified name, as in sp_cache.
+
+  @return the length of the key
+*/
+
+static size_t sp_definition_make_key(char *buf, size_t size,
+                                     enum_sp_type type,
+                                     const Database_qualified_name *name)
+{
+  buf[0]= (char) type;
+  return name->to_identifier_chain2().
+           make_qname_casedn_part1(buf + 1, size - 1) + 1;
+}
+
+
+static LEX_CSTRING sp_definition_dup(MEM_ROOT *mem_root,
+                                     const LEX_CSTRING &str)
+{
+  return str.str ? LEX_CSTRING{strmake_root(mem_root, str.str, str.length),
+                               str.length}
+                 : str;
+}
+
+
+/** Copy a definition, allocating its strings on mem_root */
+
+static void sp_definition_copy(MEM_ROOT *mem_root, Sp_definition *dst,
+                               const Sp_definition &src)
+{
+  dst->sql_mode= src.sql_mode;
+  dst->created= src.created;
+  dst->modified= src.modified;
+  dst->chistics= src.chistics;
+  dst->chistics.comment= sp_definition_dup(mem_root, src.chistics.comment);
+  dst->definer.user= sp_definition_dup(mem_root, src.definer.user);
+  dst->definer.host= sp_definition_dup(mem_root, src.definer.host);
+  dst->params= sp_definition_dup(mem_root, src.params);
+  dst->returns= sp_definition_dup(mem_root, src.returns);
+  dst->body= sp_definition_dup(mem_root, src.body);
+  dst->creation_ctx= src.creation_ctx->clone(mem_root);
+}
+
+
+/**
+  Look up a routine in sp_definitions.
+
+  @param thd   Thread context
+  @param type  Type of the routine
+  @param name  Name of the routine
+  @param def   Out parameter which gets a copy of the definition, allocated
+               on thd->mem_root
+
+  @retval true   The routine was found
+  @retval false  Not found, out of date or the cache is disabled
+*/
+
+static bool sp_definition_cache_lookup(THD *thd, enum_sp_type type,
+                                       const Database_qualified_name *name,
+                                       Sp_definition *def)
+{
+  char buf[NAME_LEN * 2 + 3];
+  bool found= false;
+
+  if (!stored_program_definition_cache_size)
+    return false;
+
+  size_t length= sp_definition_make_key(buf, sizeof(buf), type, name);
+  mysql_mutex_lock(&LOCK_sp_definitions);
+  if (Sp_definition *cached= (Sp_definition *)
+        my_hash_search(&sp_definitions, (uchar *) buf, length))
+  {
+    if (cached->version != sp_cache_version())
+      my_hash_delete(&sp_definitions, (uchar *) cached);
+    else
+    {
+      sp_definition_copy(thd->mem_root, def, *cached);
+      found= true;
+    }
+  }
+  mysql_mutex_unlock(&LOCK_sp_definitions);
+  return found;
+}
+
+
+/**
+  Remember the definition of a routine in sp_definitions.
+
+  @param type     Type of the routine
+  @param name     Name of the routine
+  @param version  sp_cache_version() before the definition was read
+  @param src      The definition
+*/
+
+static void sp_definition_cache_insert(enum_sp_type type,
+                                       const Database_qualified_name *name,
+                                       ulong version,
+                                       const Sp_definition &src)
+{
+  char buf[NAME_LEN * 2 + 3];
+  MEM_ROOT mem_root;
+  Sp_definition *def;
+
+  if (!stored_program_definition_cache_size)
+    return;
+
+  init_sql_alloc(key_memory_sp_cache, &mem_root, 1024, 0, MYF(0));
+  if (!(def= (Sp_definition *) alloc_root(&mem_root, sizeof(*def))))
+  {
+    free_root(&mem_root, MYF(0));
+    return;
+  }
+  size_t length= sp_definition_make_key(buf, sizeof(buf), type, name);
+  def->key= {strmake_root(&mem_root, buf, length), length};
+  def->version= version;
+  sp_definition_copy(&mem_root, def, src);
+  def->mem_root= mem_root;
+
+  mysql_mutex_lock(&LOCK_sp_definitions);
+  if (sp_definitions.records >= stored_program_definition_cache_size)
+    my_hash_reset(&sp_definitions);
+  if (uchar *old= my_hash_search(&sp_definitions, (uchar *) def->key.str,
+                                 def->key.length))
+    my_hash_delete(&sp_definitions, old);
+  if (my_hash_insert(&sp_definitions, (uchar *) def))
+    sp_definition_free(def);
+  mysql_mutex_unlock(&LOCK_sp_definitions);
+}
+
+
 /**
   Find routine definition in mysql.proc table and create corresponding
   sp_head object for it.
@@ -708,6 +917,17 @@ Sp_handler::db_find_routine(THD *thd, const Database_qualified_name *name,
 
   *sphp= 0;                                     // In case of errors
 
+  Sp_definition def;
+  const ulong version= sp_cache_version();
+  if (sp_definition_cache_lookup(thd, type(), name, &def))
+  {
+    Sql_mode_instant_set sms(thd, 0);
+    DBUG_RETURN(db_load_routine(thd, name, sphp, def.sql_mode, def.params,
+                                def.returns, def.body, def.chistics,
+                                def.definer, def.created, def.modified,
+                                NULL, def.creation_ctx));
+  }
+
   start_new_trans new_trans(thd);
   Sql_mode_instant_set sms(thd, 0);
 
@@ -758,6 +978,20 @@ Sp_handler::db_find_routine(THD *thd, const Database_qualified_name *name,
 
   creation_ctx= Stored_routine_creation_ctx::load_from_db(thd, name, table);
 
+  if (creation_ctx)
+  {
+    def.sql_mode= sql_mode;
+    def.created= created;
+    def.modified= modified;
+    def.chistics= chistics;
+    def.definer= definer;
+    def.params= params;
+    def.returns= returns;
+    def.body= body;
+    def.creation_ctx= creation_ctx;
+    sp_definition_cache_insert(type(), name, version, def);
+  }
+
   trans_commited= 1;
   thd->commit_whole_transaction_and_close_tables();
   new_trans.restore_old_transaction();
@@ -694,6 +694,9 @@ extern "C" uchar* sp_sroutine_key(const uchar *ptr, size_t *plen,
 */
 TABLE *open_proc_table_for_read(THD *thd);
 
+void sp_definition_cache_init();
+void sp_definition_cache_end();
+
 bool load_charset(THD *thd,
                   MEM_ROOT *mem_root,
                   Field *field,
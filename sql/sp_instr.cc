@@ -305,6 +305,19 @@ sp_lex_keeper::reset_lex_and_exec_core(THD *thd, uint *nextp,
 
   Json_writer_object trace_command(thd);
   Json_writer_array trace_command_steps(thd, "steps");
+
+  /*
+    An expression which refers to no tables, calls no stored functions and
+    has no subqueries (like the ones in SET v= v + 1 or IF v < 10 in a loop)
+    neither opens nor locks anything, so there is no statement transaction
+    to end and there are no tables to close after it.
+  */
+  if (open_tables && !m_lex->query_tables &&
+      !m_lex->sroutines_list.elements &&
+      (!m_lex->all_selects_list ||
+       !m_lex->all_selects_list->next_select_in_list()))
+    open_tables= false;
+
   if (open_tables)
     res= instr->exec_open_and_lock_tables(thd, m_lex->query_tables);
 
@@ -56,6 +56,8 @@
 #include "password.h"
 
 #include "sql_plugin_compat.h"
+#include <providers/lz4.h>
+#include <providers/zstd.h>
 #include "wsrep_mysqld.h"
 
 #define MAX_SCRAMBLE_LENGTH 1024
@@ -13508,6 +13510,12 @@ static bool send_server_handshake_packet(MPVIO_EXT *mpvio,
     thd->client_capabilities|= CLIENT_TRANSACTIONS;
 
   thd->client_capabilities|= CAN_CLIENT_COMPRESS;
+#ifdef HAVE_COMPRESS
+  if (provider_service_zstd->is_loaded)
+    thd->client_capabilities|= MARIADB_CLIENT_COMPRESS_ZSTD;
+  if (provider_service_lz4->is_loaded)
+    thd->client_capabilities|= MARIADB_CLIENT_COMPRESS_LZ4;
+#endif
 
   if (ssl_acceptor_fd)
   {
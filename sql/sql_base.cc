@@ -9985,7 +9985,26 @@ int TABLE::hlindexes_on_delete_all(bool truncate)
   return 0;
 }
 
-int TABLE::hlindex_read_first(uint nr, Item *item, ulonglong limit)
+int TABLE::hlindexes_on_bulk_insert_start()
+{
+  DBUG_ASSERT(s->hlindexes() == (hlindex != NULL));
+  if (hlindex && hlindex->in_use)
+    if (int err= mhnsw_bulk_begin(this, key_info + s->keys))
+      return err;
+  return 0;
+}
+
+int TABLE::hlindexes_on_bulk_insert_end(bool abort)
+{
+  DBUG_ASSERT(s->hlindexes() == (hlindex != NULL));
+  if (hlindex && hlindex->in_use)
+    if (int err= mhnsw_bulk_end(this, key_info + s->keys, abort))
+      return err;
+  return 0;
+}
+
+int TABLE::hlindex_read_first(uint nr, Item *item, ulonglong limit,
+                              Item *cond)
 {
   DBUG_ASSERT(s->hlindexes() == 1);
   DBUG_ASSERT(nr == s->keys);
@@ -9995,7 +10014,7 @@ int TABLE::hlindex_read_first(uint nr, Item *item, ulonglong limit)
 
   DBUG_ASSERT(hlindex->in_use == in_use);
 
-  return mhnsw_read_first(this, key_info + s->keys, item, limit);
+  return mhnsw_read_first(this, key_info + s->keys, item, limit, cond);
 }
 
 int TABLE::hlindex_read_next()
@@ -1709,10 +1709,12 @@ size_t build_normalized_name(char *buff, size_t bufflen,
 int
 Query_cache::send_result_to_client(THD *thd, char *org_sql, uint query_length)
 {
-  ulonglong engine_data;
+  ulonglong engine_data, found_rows;
   Query_cache_query *query;
 #ifndef EMBEDDED_LIBRARY
   Query_cache_block *first_result_block;
+  size_t result_length;
+  uchar *result_copy;
 #endif
   Query_cache_block *result_block;
   Query_cache_block_table *block_table, *block_table_end;
@@ -2163,24 +2165,62 @@ def_week_frmt: %zu, in_trans: %d, autocommit: %d",
   /*
     Send cached result to client
   */
+  found_rows= query->found_rows();
 #ifndef EMBEDDED_LIBRARY
   THD_STAGE_INFO(thd, stage_sending_cached_result_to_client);
+  /*
+    Copy the result out of the cache and release the block before
+    sending it. Invalidation waits for the block lock while it has the
+    whole query cache locked, so a slow client would otherwise stall
+    every other user of the query cache.
+  */
+  result_length= 0;
   do
   {
-    DBUG_PRINT("qcache", ("Results  (len: %zu  used: %zu  headers: %u)",
-			  result_block->length, result_block->used,
-			  (uint) (result_block->headers_len()+
-                                   ALIGN_SIZE(sizeof(Query_cache_result)))));
-    
-    Query_cache_result *result = result_block->result();
-    if (send_data_in_chunks(&thd->net, result->data(),
-                            result_block->used -
-                            result_block->headers_len() -
-                            ALIGN_SIZE(sizeof(Query_cache_result))))
-      break;                                    // Client aborted
-    result_block = result_block->next;
-    thd->net.pkt_nr= query->last_pkt_nr; // Keep packet number updated
+    result_length+= result_block->used - result_block->headers_len() -
+                    ALIGN_SIZE(sizeof(Query_cache_result));
+    result_block= result_block->next;
   } while (result_block != first_result_block);
+
+  if ((result_copy= (uchar*) my_malloc(PSI_INSTRUMENT_ME, result_length,
+                                       MYF(MY_THREAD_SPECIFIC))))
+  {
+    uchar *pos= result_copy;
+    do
+    {
+      size_t length= result_block->used - result_block->headers_len() -
+                     ALIGN_SIZE(sizeof(Query_cache_result));
+      memcpy(pos, result_block->result()->data(), length);
+      pos+= length;
+      result_block= result_block->next;
+    } while (result_block != first_result_block);
+    uint last_pkt_nr= query->last_pkt_nr;
+    BLOCK_UNLOCK_RD(query_block);
+    query_block= NULL;
+
+    if (!send_data_in_chunks(&thd->net, result_copy, result_length))
+      thd->net.pkt_nr= last_pkt_nr;             // Keep packet number updated
+    my_free(result_copy);
+  }
+  else
+  {
+    do
+    {
+      DBUG_PRINT("qcache", ("Results  (len: %zu  used: %zu  headers: %u)",
+                            result_block->length, result_block->used,
+                            (uint) (result_block->headers_len()+
+                                    ALIGN_SIZE(sizeof(Query_cache_result)))));
+
+      Query_cache_result *result = result_block->result();
+      if (send_data_in_chunks(&thd->net, result->data(),
+                              result_block->used -
+                              result_block->headers_len() -
+                              ALIGN_SIZE(sizeof(Query_cache_result))))
+        break;                                  // Client aborted
+      result_block = result_block->next;
+      thd->net.pkt_nr= query->last_pkt_nr; // Keep packet number updated
+    } while (result_block != first_result_block);
+  }
 #else
   {
     Querycache_stream qs(result_block, result_block->headers_len() +
@@ -2189,7 +2229,7 @@ def_week_frmt: %zu, in_trans: %d, autocommit: %d",
   }
 #endif /*!EMBEDDED_LIBRARY*/
 
-  thd->set_sent_row_count(thd->limit_found_rows = query->found_rows());
+  thd->set_sent_row_count(thd->limit_found_rows = found_rows);
   thd->status_var.last_query_cost= 0.0;
   thd->query_plan_flags= (thd->query_plan_flags & ~QPLAN_QC_NO) | QPLAN_QC;
   if (!thd->get_sent_row_count())
@@ -2206,7 +2246,8 @@ def_week_frmt: %zu, in_trans: %d, autocommit: %d",
   (void) trans_commit_stmt(thd);
   thd->get_stmt_da()->disable_status();
 
-  BLOCK_UNLOCK_RD(query_block);
+  if (query_block)
+    BLOCK_UNLOCK_RD(query_block);
   MYSQL_QUERY_CACHE_HIT(thd->query(), thd->limit_found_rows);
   DBUG_RETURN(1);				// Result sent to client
 
@@ -775,6 +775,7 @@ THD::THD(my_thread_id id, bool is_wsrep_applier)
 #endif /*WITH_WSREP */
 {
   bzero(&variables, sizeof(variables));
+  bzero(&root_block_cache, sizeof(root_block_cache));
 
   /*
     We set THR_THD to temporally point to this THD to register all the
@@ -811,6 +812,8 @@ THD::THD(my_thread_id id, bool is_wsrep_applier)
   scheduler= thread_scheduler;                 // Will be fixed later
   event_scheduler.data= 0;
   skip_wait_timeout= false;
+  defer_reply_flush= false;
+  query_alloc_retained= 0;
   catalog= (char*)"std"; // the only catalog we have for now
   main_security_ctx.init();
   security_ctx= &main_security_ctx;
@@ -832,6 +835,8 @@ THD::THD(my_thread_id id, bool is_wsrep_applier)
   start_utime= utime_after_query= 0;
   system_time.start.val= system_time.sec= system_time.sec_part= 0;
   utime_after_lock= 0L;
+  threadpool_queue_time= 0;
+  memory_allocated_old= stmt_start_cpu_time= 0;
   progress.arena= 0;
   progress.report_to_client= 0;
   progress.max_counter= 0;
@@ -1359,6 +1364,7 @@ void THD::init()
     transaction->stmt.m_unsafe_rollback_flags= 0;
 
   open_options=ha_open_options;
+  root_block_cache.max_size= variables.mem_root_cache_size;
   update_lock_default= (variables.low_priority_updates ?
 			TL_WRITE_LOW_PRIORITY :
 			TL_WRITE);
@@ -1750,6 +1756,44 @@ void THD::free_connection()
   - Variables not reset between each statements. See reset_for_next_command.
 */
 
+/**
+  Free the memory of the last command on main_mem_root.
+
+  Besides the preallocated block (query_prealloc_size), up to
+  query_alloc_retain_size bytes of blocks are kept for the next command,
+  as long as all connections together keep less than
+  query_alloc_retain_limit bytes. This saves malloc()/free() calls and
+  fragmentation for connections that run many statements.
+
+  @param release_all  Free all memory, including the preallocated block
+*/
+
+void THD::free_query_mem_root(bool release_all)
+{
+  size_t retain= 0;
+  if (release_all)
+    free_root(&main_mem_root, MYF(0));
+  else
+  {
+    if (variables.query_alloc_retain_size && mem_root == &main_mem_root)
+    {
+      ulonglong others= global_query_alloc_retained - query_alloc_retained;
+      if (others < global_query_alloc_retain_limit)
+        retain= (size_t) MY_MIN(variables.query_alloc_retain_size,
+                                global_query_alloc_retain_limit - others);
+    }
+    if (!retain && (!query_alloc_retained || mem_root != &main_mem_root))
+    {
+      free_root(mem_root, MYF(MY_KEEP_PREALLOC));
+      return;
+    }
+    retain= free_root_retain(&main_mem_root, retain);
+  }
+  global_query_alloc_retained+= (ulonglong) retain - query_alloc_retained;
+  query_alloc_retained= retain;
+}
+
+
 void THD::reset_for_reuse()
 {
   if (status_var.tmp_space_used)
@@ -1808,6 +1852,9 @@ THD::~THD()
     that memory allocation counting is done correctly
   */
   set_current_thd(this);
+  /* Memory roots freed from now on should not fill the block cache */
+  root_block_cache.max_size= 0;
+  free_root_block_cache(&root_block_cache);
   if (!status_in_global)
     add_status_to_global();
 
@@ -1846,7 +1893,7 @@ THD::~THD()
   my_free(semisync_info);
 #endif
   main_lex.free_set_stmt_mem_root();
-  free_root(&main_mem_root, MYF(0));
+  free_query_mem_root(true);
   my_free(m_token_array);
   my_free(killed_err);
   main_da.free_memory();
@@ -1920,6 +1967,7 @@ void add_to_status(STATUS_VAR *to_var, STATUS_VAR *from_var)
   to_var->rows_sent+=           from_var->rows_sent;
   to_var->rows_tmp_read+=       from_var->rows_tmp_read;
   to_var->binlog_bytes_written+= from_var->binlog_bytes_written;
+  to_var->memory_allocated+=    from_var->memory_allocated;
   to_var->cpu_time+=            from_var->cpu_time;
   to_var->busy_time+=           from_var->busy_time;
   to_var->table_open_cache_hits+= from_var->table_open_cache_hits;
@@ -1927,15 +1975,12 @@ void add_to_status(STATUS_VAR *to_var, STATUS_VAR *from_var)
   to_var->table_open_cache_overflows+= from_var->table_open_cache_overflows;
 
   /*
-    Update global_memory_used. We have to do this with atomic_add as the
-    global value can change outside of LOCK_status.
+    Update global_memory_used. This goes to global_memory_used_counter,
+    as the global value can change outside of LOCK_status.
     Note that local_memory_used is handled in calc_sum_callback().
   */
   if (to_var == &global_status_var)
   {
-    DBUG_PRINT("info", ("global memory_used: %lld  size: %lld",
-                        (longlong) global_status_var.global_memory_used,
-                        (longlong) from_var->global_memory_used));
     update_global_memory_status(from_var->global_memory_used);
     /* global_tmp_space_used is always kept up to date */
     to_var->tmp_space_used= global_tmp_space_used;
@@ -1980,6 +2025,8 @@ void add_diff_to_status(STATUS_VAR *to_var, STATUS_VAR *from_var,
   to_var->rows_tmp_read+=        from_var->rows_tmp_read - dec_var->rows_tmp_read;
   to_var->binlog_bytes_written+= from_var->binlog_bytes_written -
                                  dec_var->binlog_bytes_written;
+  to_var->memory_allocated+=     from_var->memory_allocated -
+                                 dec_var->memory_allocated;
   to_var->cpu_time+=             from_var->cpu_time - dec_var->cpu_time;
   to_var->busy_time+=            from_var->busy_time - dec_var->busy_time;
   to_var->table_open_cache_hits+= from_var->table_open_cache_hits -
@@ -4608,6 +4655,7 @@ void TMP_TABLE_PARAM::init()
   materialized_subquery= 0;
   force_not_null_cols= 0;
   skip_create_table= 0;
+  expected_rows= 0;
   tmp_name= "temptable";                        // Name of temp table on disk
   DBUG_VOID_RETURN;
 }
@@ -5889,6 +5937,7 @@ extern "C" void thd_wait_begin(MYSQL_THD thd, int wait_type)
     if (unlikely(!thd))
       return;
   }
+  thd->wait_profile.begin(wait_type);
   MYSQL_CALLBACK(thd->scheduler, thd_wait_begin, (thd, wait_type));
 }
 
@@ -5908,6 +5957,7 @@ extern "C" void thd_wait_end(MYSQL_THD thd)
       return;
   }
   MYSQL_CALLBACK(thd->scheduler, thd_wait_end, (thd));
+  thd->wait_profile.end();
 }
 
 #endif // INNODB_COMPATIBILITY_HOOKS */
@@ -6119,6 +6169,8 @@ void THD::store_slow_query_state(Sub_statement_state *backup)
   backup->affected_rows=           affected_rows;
   backup->max_tmp_space_used=      max_tmp_space_used;
   backup->bytes_sent_old=          bytes_sent_old;
+  backup->memory_allocated_old=    memory_allocated_old;
+  backup->stmt_start_cpu_time=     stmt_start_cpu_time;
   backup->examined_row_count=      m_examined_row_count;
   backup->examined_row_count_for_statement= examined_row_count_for_statement;
   backup->query_plan_flags=        query_plan_flags;
@@ -6129,6 +6181,7 @@ void THD::store_slow_query_state(Sub_statement_state *backup)
   backup->tmp_tables_size=         tmp_tables_size;
   backup->tmp_tables_used=         tmp_tables_used;
   backup->handler_stats=           handler_stats;
+  backup->wait_profile=            wait_profile;
 }
 
 /* Reset variables related to slow query log */
@@ -6138,6 +6191,14 @@ void THD::reset_slow_query_state(Sub_statement_state *backup)
   affected_rows=                0;
   max_tmp_space_used=           0;
   bytes_sent_old=               status_var.bytes_sent;
+  memory_allocated_old=         status_var.memory_allocated;
+  /*
+    CLOCK_THREAD_CPUTIME_ID is not served by the vDSO, so only pay for it
+    when the statement may end up in the slow log. The whole statement
+    runs in one OS thread, also with the thread pool.
+  */
+  stmt_start_cpu_time= (global_system_variables.sql_log_slow &&
+                        variables.sql_log_slow) ? my_getcputime() : 0;
   m_examined_row_count=         0;
   m_sent_row_count=             0;
   query_plan_flags=             QPLAN_INIT;
@@ -6160,6 +6221,7 @@ void THD::reset_slow_query_state(Sub_statement_state *backup)
     handler_stats.reset();
   else
     handler_stats.active= 0;
+  wait_profile.reset();
 }
 
 /*
@@ -6171,6 +6233,8 @@ void THD::add_slow_query_state(Sub_statement_state *backup)
 {
   affected_rows+=                backup->affected_rows;
   bytes_sent_old=                backup->bytes_sent_old;
+  memory_allocated_old=          backup->memory_allocated_old;
+  stmt_start_cpu_time=           backup->stmt_start_cpu_time;
   m_examined_row_count+=         backup->examined_row_count;
   m_sent_row_count+=             backup->sent_row_count;
   query_plan_flags|=             backup->query_plan_flags;
@@ -6192,6 +6256,7 @@ void THD::add_slow_query_state(Sub_statement_state *backup)
   }
   if (handler_stats.active && backup->handler_stats.active)
     handler_stats.add(&backup->handler_stats);
+  wait_profile.add(backup->wait_profile);
 }
 
 
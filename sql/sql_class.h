@@ -54,6 +54,7 @@
 #include "xa.h"
 #include "ddl_log.h"                            /* DDL_LOG_STATE */
 #include "ha_handler_stats.h"                    // ha_handler_stats */
+#include "wait_profile.h"                        // Wait_profile
 
 extern "C"
 void set_thd_stage_info(void *thd,
@@ -747,6 +748,7 @@ typedef struct system_variables
   double log_slow_query_time_double, max_statement_time_double;
   double log_slow_always_query_time_double;
   double sample_percentage;
+  ulong analyze_sample_method;
 
   ha_rows select_limit;
   ha_rows max_join_size;
@@ -769,11 +771,13 @@ typedef struct system_variables
   ulong column_compression_zlib_strategy;
   ulong lock_wait_timeout;
   ulong join_cache_level;
+  ulong join_buff_spill_partitions;
   ulong max_allowed_packet;
   ulong max_error_count;
   ulong max_length_for_sort_data;
   ulong max_recursive_iterations;
   ulong max_sort_length;
+  ulong max_sort_threads;
   ulong max_insert_delayed_threads;
   ulong min_examined_row_limit;
   ulong net_buffer_length;
@@ -804,11 +808,14 @@ typedef struct system_variables
   /* Total size of all buffers used by the subselect_rowid_merge_engine. */
   ulong rowid_merge_buff_size;
   ulong max_sp_recursion_depth;
+  ulong sequence_session_cache;
   ulong default_week_format;
   ulong max_seeks_for_key;
   ulong range_alloc_block_size;
   ulong query_alloc_block_size;
   ulong query_prealloc_size;
+  uint query_alloc_retain_size;
+  uint mem_root_cache_size;
   ulong trans_alloc_block_size;
   ulong trans_prealloc_size;
   ulong log_warnings;
@@ -860,6 +867,7 @@ typedef struct system_variables
   */
   my_bool tx_read_only;
   my_bool low_priority_updates;
+  my_bool load_data_read_ahead;
   my_bool query_cache_wlock_invalidate;
   my_bool keep_files_on_create;
 
@@ -867,6 +875,8 @@ typedef struct system_variables
   my_bool old_passwords;
   my_bool big_tables;
   my_bool only_standard_compliant_cte;
+  my_bool prepared_stmt_reuse;
+  my_bool optimizer_cost_feedback;
   my_bool query_cache_strip_comments;
   my_bool sql_log_slow;
   my_bool sql_log_bin;
@@ -1033,6 +1043,10 @@ typedef struct system_status_var
   ulong master_gtid_wait_time;              /* Time in microseconds */
   ulong master_gtid_wait_count;
 
+  /* Galera appliers waiting for their turn to commit */
+  ulong wsrep_applier_commit_waits;
+  ulong wsrep_applier_commit_wait_time;     /* Time in microseconds */
+
   ulong empty_queries;
   ulong access_denied_errors;
   ulong lost_connections;
@@ -1063,6 +1077,8 @@ typedef struct system_status_var
   ulonglong table_open_cache_misses;
   ulonglong table_open_cache_overflows;
   ulonglong send_metadata_skips;
+  /* Bytes of thread specific memory allocated, never decremented */
+  ulonglong memory_allocated;
   double last_query_cost;
   double cpu_time, busy_time;
   uint32 threads_running;
@@ -1129,17 +1145,14 @@ static inline void calc_sum_of_all_status_if_needed(STATUS_VAR *to)
 }
 
 /*
-  Update global_memory_used. We have to do this with atomic_add as the
-  global value can change outside of LOCK_status.
+  Update global_memory_used. This is done outside of LOCK_status, from any
+  thread, so it goes to a sharded counter that calc_sum_of_all_status()
+  adds up.
 */
 static inline void update_global_memory_status(int64 size)
 {
-  DBUG_PRINT("info", ("global memory_used: %lld  size: %lld",
-                      (longlong) global_status_var.global_memory_used,
-                      size));
-  // workaround for gcc 4.2.4-1ubuntu4 -fPIE (from DEB_BUILD_HARDENING=1)
-  int64 volatile * volatile ptr= &global_status_var.global_memory_used;
-  my_atomic_add64_explicit(ptr, size, MY_MEMORY_ORDER_RELAXED);
+  DBUG_PRINT("info", ("global memory_used size: %lld", size));
+  global_memory_used_counter+= size;
 }
 
 
@@ -2149,8 +2162,11 @@ class Sub_statement_state
   ulonglong sent_row_count_for_statement, examined_row_count_for_statement;
   ulonglong affected_rows;
   ulonglong bytes_sent_old;
+  ulonglong memory_allocated_old;
+  ulonglong stmt_start_cpu_time;
   ulonglong max_tmp_space_used;
   ha_handler_stats handler_stats;
+  Wait_profile wait_profile;
   ulong     tmp_tables_used;
   ulong     tmp_tables_disk_used;
   ulong     query_plan_fsort_passes;
@@ -3042,6 +3058,9 @@ class THD: public THD_count, /* this must be first */
   struct  system_status_var org_status_var; // For user statistics
   struct  system_status_var *initial_status_var; /* used by show status */
   ha_handler_stats handler_stats;       // Handler statistics
+  Wait_profile wait_profile;            // Statement waits for slow log
+  /* Time the current request waited in the thread pool queue, microseconds */
+  ulonglong threadpool_queue_time;
   THR_LOCK_INFO lock_info;              // Locking info of this thread
 
   /**
@@ -3260,6 +3279,13 @@ class THD: public THD_count, /* this must be first */
   /* Do not set socket timeouts for wait_timeout (used with threadpool) */
   bool skip_wait_timeout;
 
+  /*
+    The client pipelines commands (MARIADB_CLIENT_PIPELINE) and the next one
+    was already received, so the reply to the current command is left in the
+    network buffer instead of being flushed. See do_command().
+  */
+  bool defer_reply_flush;
+
   bool prepare_derived_at_open;
 
   /* Set to 1 if status of this THD is already in global status */
@@ -3898,6 +3924,9 @@ class THD: public THD_count, /* this must be first */
   ulong      tmp_tables_disk_used;
   ulonglong  tmp_tables_size;
   ulonglong  bytes_sent_old;
+  ulonglong  memory_allocated_old;
+  /* my_getcputime() at statement start, or 0 if not measured */
+  ulonglong  stmt_start_cpu_time;
   ulonglong  affected_rows;                     /* Number of changed rows */
   ulonglong  max_tmp_space_used= 0;
 
@@ -4195,6 +4224,7 @@ class THD: public THD_count, /* this must be first */
   void cleanup_after_query();
   void free_connection();
   void reset_for_reuse();
+  void free_query_mem_root(bool release_all= false);
   void store_globals();
   void reset_stack()
   {
@@ -5586,6 +5616,11 @@ class THD: public THD_count, /* this must be first */
     tree itself is reused between executions and thus is stored elsewhere.
   */
   MEM_ROOT main_mem_root;
+  /*
+    Size of the blocks, besides the preallocated one, that main_mem_root
+    keeps between commands. Counted in global_query_alloc_retained.
+  */
+  size_t query_alloc_retained;
   Diagnostics_area main_da;
   Diagnostics_area *m_stmt_da;
 
@@ -5610,6 +5645,11 @@ class THD: public THD_count, /* this must be first */
 
 public:
   Session_tracker session_tracker;
+  /*
+    Blocks freed by the thread specific memory roots of this connection,
+    kept for reuse up to variables.mem_root_cache_size bytes.
+  */
+  ROOT_BLOCK_CACHE root_block_cache;
   /*
     Flag, mutex and condition for a thread to wait for a signal from another
     thread.
@@ -6767,6 +6807,12 @@ class TMP_TABLE_PARAM :public Sql_alloc
   KEY *keyinfo;
   ulong *rec_per_key;
   ha_rows end_write_records;
+  /**
+    Number of rows the optimizer expects to be written to the table, or 0
+    if not known. Lets create_tmp_table() put the table on disk at once
+    when it is certain to outgrow memory, instead of converting it later.
+  */
+  double expected_rows;
   /**
     Number of normal fields in the query, including those referred to
     from aggregate functions. Hence, "SELECT `field1`,
@@ -6836,6 +6882,14 @@ class TMP_TABLE_PARAM :public Sql_alloc
     TRUE <=> create_tmp_table will create only the TABLE structure.
   */
   bool skip_create_table;
+  /*
+    The group that end_update() updated last is not written back to the
+    table while the following rows belong to the same group: the updated
+    row is kept in table->record[1]. hot_group_buff holds the key of the
+    group followed by the image of the row as it is stored in the table.
+  */
+  uchar *hot_group_buff;
+  bool hot_group;
 
   TMP_TABLE_PARAM()
     :copy_field(0), group_parts(0),
@@ -6843,7 +6897,8 @@ class TMP_TABLE_PARAM :public Sql_alloc
      using_outer_summary_function(0),
      schema_table(0), materialized_subquery(0), force_not_null_cols(0),
      precomputed_group_by(0), group_concat(0),
-     force_copy_fields(0), bit_fields_as_long(0), skip_create_table(0)
+     force_copy_fields(0), bit_fields_as_long(0), skip_create_table(0),
+     hot_group_buff(0), hot_group(0)
   {
     init();
   }
@@ -6894,7 +6949,7 @@ class select_unit :public select_result_interceptor
   virtual bool postponed_prepare(List<Item> &types)
   { return false; }
   int send_data(List<Item> &items) override;
-  int write_record();
+  virtual int write_record();
   int update_counter(Field *counter, longlong value);
   int delete_record();
   bool send_eof() override;
@@ -7084,10 +7139,12 @@ class select_union_recursive :public select_unit
   select_union_recursive(THD *thd_arg):
     select_unit(thd_arg),
       incr_table(0), first_rec_table_to_update(0), cleanup_count(0),
-      row_counter(0)
+      row_counter(0), is_distinct(false), seen_rows_state(SEEN_ROWS_OFF)
   { incr_table_param.init(); };
 
   int send_data(List<Item> &items) override;
+  int write_record() override;
+  void reset_seen_rows();
   bool create_result_table(THD *thd, List<Item> *column_types,
                            bool is_distinct, ulonglong options,
                            const LEX_CSTRING *alias,
@@ -7096,6 +7153,17 @@ class select_union_recursive :public select_unit
                            bool keep_row_order,
                            uint hidden) override;
   void cleanup() override;
+
+private:
+  /* Whether the result table eliminates duplicates (UNION DISTINCT) */
+  bool is_distinct;
+  /*
+    Images of the rows written to the result table since it was converted
+    to a disk-based table, see write_record()
+  */
+  enum { SEEN_ROWS_OFF, SEEN_ROWS_ON, SEEN_ROWS_FULL } seen_rows_state;
+  HASH seen_rows;
+  MEM_ROOT seen_rows_root;
 };
 
 /**
@@ -472,6 +472,7 @@ void init_user_stats(USER_STATS *user_stats,
   user_stats->max_statement_time_exceeded= max_statement_time_exceeded;
   user_stats->access_denied_errors= access_denied_errors;
   user_stats->empty_queries= empty_queries;
+  user_stats->memory_allocated= 0;
   DBUG_VOID_RETURN;
 }
 
@@ -710,6 +711,8 @@ static void update_global_user_stats_with_user(THD *thd,
   user_stats->denied_connections+= thd->status_var.access_denied_errors;
   user_stats->lost_connections+=   thd->status_var.lost_connections;
   user_stats->max_statement_time_exceeded+= thd->status_var.max_statement_time_exceeded;
+  user_stats->memory_allocated+= (thd->status_var.memory_allocated -
+                                  thd->org_status_var.memory_allocated);
 }
 
 
@@ -1265,7 +1268,22 @@ void prepare_new_connection_state(THD* thd)
   Security_context *sctx= thd->security_ctx;
 
   if (thd->client_capabilities & CLIENT_COMPRESS)
+  {
     thd->net.compress=1;				// Use compression
+    /* Prefer Zstandard if the client accepts more than one format */
+    if (thd->client_capabilities & MARIADB_CLIENT_COMPRESS_ZSTD)
+      thd->net.compress_algorithm= NET_COMPRESSION_ZSTD;
+    else if (thd->client_capabilities & MARIADB_CLIENT_COMPRESS_LZ4)
+      thd->net.compress_algorithm= NET_COMPRESSION_LZ4;
+    thd->net.compress_level= (uchar) protocol_compression_zstd_level;
+  }
+
+  /*
+    A pipelining client sends many short packets back to back; read them
+    in blocks rather than with two recv() calls per packet.
+  */
+  if (thd->client_capabilities & MARIADB_CLIENT_PIPELINE)
+    vio_enable_buffered_read(thd->net.vio);
 
   /*
     Much of this is duplicated in create_embedded_thd() for the
@@ -1537,6 +1555,23 @@ void CONNECT::close_with_error(uint sql_errno,
 }
 
 
+/**
+  Free THD cached by Thread_cache::park_thd(), and the mysys_thread_var
+  it was cached with.
+*/
+
+void delete_cached_thd(THD *thd)
+{
+  THD *old_thd= current_thd;
+  st_my_thread_var *old_mysys_var= my_thread_var;
+  set_mysys_var(thd->mysys_var);
+  delete thd;
+  my_thread_end();
+  set_mysys_var(old_mysys_var);
+  set_current_thd(old_thd);
+}
+
+
 /* Reuse or create a THD based on a CONNECT object */
 
 THD *CONNECT::create_thd(THD *thd)
@@ -21,6 +21,7 @@
 #include "opt_range.h"
 #include "sql_expression_cache.h"
 #include "item_subselect.h"
+#include "opt_cost_feedback.h"
 
 #include <stack>
 
@@ -182,6 +183,37 @@ void Explain_query::notify_tables_are_closed()
 #ifndef DBUG_OFF
     can_print_json= false;
 #endif
+    /* handler_for_stats pointers are still valid, collect them now */
+    if (stmt_thd->lex->analyze_stmt &&
+        stmt_thd->variables.optimizer_cost_feedback)
+      record_cost_feedback();
+  }
+}
+
+
+static void record_join_cost_feedback(THD *thd, Explain_basic_join *join)
+{
+  for (uint i= 0; i < join->n_join_tabs; i++)
+  {
+    Explain_table_access *eta= join->join_tabs[i];
+    cost_feedback_record(thd, eta);
+    if (eta->sjm_nest)
+      record_join_cost_feedback(thd, eta->sjm_nest);
+  }
+}
+
+
+/*
+  Save estimated vs. measured costs of all table accesses of an ANALYZE
+  statement for INFORMATION_SCHEMA.OPTIMIZER_COST_FEEDBACK
+*/
+
+void Explain_query::record_cost_feedback()
+{
+  for (uint i= 0; i < selects.elements(); i++)
+  {
+    if (Explain_select *sel= selects.at(i))
+      record_join_cost_feedback(stmt_thd, sel);
   }
 }
 
@@ -1949,6 +1981,9 @@ static void trace_engine_stats(handler *file, Json_writer *writer)
       writer->add_member("pages_prefetch_read_count").add_ull(hs->pages_prefetched);
     if (hs->undo_records_read)
       writer->add_member("old_rows_read").add_ull(hs->undo_records_read);
+    if (hs->lock_wait_time)
+      writer->add_member("lock_wait_time_ms").
+        add_double(hs->lock_wait_time * 1000. / timer_tracker_frequency());
     writer->end_object();
   }
 }
@@ -532,6 +532,7 @@ class Explain_query : public Sql_alloc
   bool print_query_blocks_json(Json_writer *writer, const bool is_analyze);
   void print_query_optimization_json(Json_writer *writer);
   void send_explain_json_to_output(Json_writer *writer, select_result_sink *output);
+  void record_cost_feedback();
  
   /* Explain_delete inherits from Explain_update */
   Explain_update *upd_del_plan;
@@ -44,9 +44,11 @@ Expression_cache_tmptable::Expression_cache_tmptable(THD *thd,
                                                      List<Item> &dependants,
                                                      Item *value)
   :cache_table(NULL), table_thd(thd), tracker(NULL), items(dependants), val(value),
+   lru_first(NULL), lru_last(NULL), hash_memory(0), hash_memory_limit(0),
    hit(0), miss(0), inited (0)
 {
   DBUG_ENTER("Expression_cache_tmptable::Expression_cache_tmptable");
+  my_hash_clear(&hash);
   DBUG_VOID_RETURN;
 };
 
@@ -59,6 +61,12 @@ void Expression_cache_tmptable::disable_cache()
 {
   if (cache_table->file->inited)
     cache_table->file->ha_index_end();
+  if (my_hash_inited(&hash))
+  {
+    my_hash_free(&hash);
+    lru_first= lru_last= NULL;
+    hash_memory= 0;
+  }
   free_tmp_table(table_thd, cache_table);
   cache_table= NULL;
   update_tracker();
@@ -132,9 +140,9 @@ void Expression_cache_tmptable::init()
     DBUG_VOID_RETURN;
   }
 
-  if (cache_table->s->db_type() != heap_hton)
+  if (cache_table->s->db_type() != heap_hton || cache_table->s->blob_fields)
   {
-    DBUG_PRINT("error", ("we need only heap table"));
+    DBUG_PRINT("error", ("we need only heap table without blobs"));
     goto error;
   }
 
@@ -156,8 +164,20 @@ void Expression_cache_tmptable::init()
   ref.has_record= 0;
   ref.use_count= 0;
 
-
-  if (open_tmp_table(cache_table))
+  if (!cache_table->s->blob_fields)
+  {
+    hash_memory_limit= (size_t)
+      MY_MIN(table_thd->variables.tmp_memory_table_size,
+             table_thd->variables.max_heap_table_size);
+    if (my_hash_init(PSI_INSTRUMENT_ME, &hash, &my_charset_bin, 32,
+                     sizeof(Hash_entry), ref.key_length, NULL, my_free,
+                     HASH_THREAD_SPECIFIC))
+    {
+      DBUG_PRINT("error", ("creating hash failed"));
+      goto error;
+    }
+  }
+  else if (open_tmp_table(cache_table))
   {
     DBUG_PRINT("error", ("Opening (creating) temporary table failed"));
     goto error;
@@ -197,6 +217,116 @@ Expression_cache_tmptable::~Expression_cache_tmptable()
 }
 
 
+void Expression_cache_tmptable::lru_unlink(Hash_entry *entry)
+{
+  if (entry->lru_prev)
+    entry->lru_prev->lru_next= entry->lru_next;
+  else
+    lru_first= entry->lru_next;
+  if (entry->lru_next)
+    entry->lru_next->lru_prev= entry->lru_prev;
+  else
+    lru_last= entry->lru_prev;
+}
+
+
+void Expression_cache_tmptable::lru_push_front(Hash_entry *entry)
+{
+  entry->lru_prev= NULL;
+  entry->lru_next= lru_first;
+  if (lru_first)
+    lru_first->lru_prev= entry;
+  else
+    lru_last= entry;
+  lru_first= entry;
+}
+
+
+/**
+  Look the current set of parameters up in the in-memory hash
+
+  @details
+  The parameters are encoded into ref.key_buff. Unused bytes of the key
+  buffer are zeroed first, so that equal parameters always get the same
+  key image.
+
+  @retval 0   found, the cached record has been copied to record[0]
+  @retval -1  not found, or the parameters can not be cached
+*/
+
+int Expression_cache_tmptable::hash_lookup()
+{
+  Hash_entry *entry;
+  bzero(ref.key_buff, ref.key_length);
+  if ((ref.key_err= cp_buffer_from_ref(table_thd, cache_table, &ref)) ||
+      !(entry= (Hash_entry*) my_hash_search(&hash, ref.key_buff,
+                                            ref.key_length)))
+    return -1;
+  memcpy(cache_table->record[0],
+         ((uchar*) (entry + 1)) + ref.key_length, cache_table->s->reclength);
+  lru_unlink(entry);
+  lru_push_front(entry);
+  return 0;
+}
+
+
+/**
+  Put record[0] into the in-memory hash under the key of the last lookup
+
+  @details
+  If the hash is full, the cache is switched off when its hit rate is
+  low, otherwise the least recently used entries are evicted.
+
+  @retval FALSE OK
+  @retval TRUE  the cache has been disabled
+*/
+
+bool Expression_cache_tmptable::hash_insert()
+{
+  size_t length= sizeof(Hash_entry) + ref.key_length +
+                 cache_table->s->reclength;
+  Hash_entry *entry;
+
+  if (hash_memory + length > hash_memory_limit && lru_last)
+  {
+    double hit_rate= ((double)hit / ((double)hit + miss));
+    DBUG_ASSERT(miss > 0);
+    if (hit_rate < EXPCACHE_MIN_HIT_RATE_FOR_MEM_TABLE)
+    {
+      DBUG_PRINT("info", ("hit rate is not so good to keep the cache"));
+      disable_cache();
+      return TRUE;
+    }
+    while (hash_memory + length > hash_memory_limit && lru_last)
+    {
+      entry= lru_last;
+      lru_unlink(entry);
+      hash_memory-= length;
+      my_hash_delete(&hash, (uchar*) entry);
+    }
+  }
+
+  if (!(entry= (Hash_entry*) my_malloc(PSI_INSTRUMENT_ME, length,
+                                       MYF(MY_THREAD_SPECIFIC))))
+  {
+    disable_cache();
+    return TRUE;
+  }
+  memcpy(entry + 1, ref.key_buff, ref.key_length);
+  memcpy(((uchar*) (entry + 1)) + ref.key_length, cache_table->record[0],
+         cache_table->s->reclength);
+  if (my_hash_insert(&hash, (uchar*) entry))
+  {
+    my_free(entry);
+    disable_cache();
+    return TRUE;
+  }
+  lru_push_front(entry);
+  hash_memory+= length;
+  return FALSE;
+}
+
+
 /**
   Check if a given set of parameters of the expression is in the cache
 
@@ -221,7 +351,9 @@ Expression_cache::result Expression_cache_tmptable::check_value(Item **value)
   {
     DBUG_PRINT("info", ("status: %u  has_record %u",
                         (uint)cache_table->status, (uint)ref.has_record));
-    if ((res= join_read_key2(table_thd, NULL, cache_table, &ref)) == 1)
+    if (my_hash_inited(&hash))
+      res= hash_lookup();
+    else if ((res= join_read_key2(table_thd, NULL, cache_table, &ref)) == 1)
       DBUG_RETURN(ERROR);
 
     if (res)
@@ -277,6 +409,14 @@ my_bool Expression_cache_tmptable::put_value(Item *value)
   if (unlikely(table_thd->is_error()))
     goto err2;
 
+  if (my_hash_inited(&hash))
+  {
+    /* Parameters which can not be looked up are not cached */
+    if (!ref.key_err)
+      hash_insert();
+    DBUG_RETURN(FALSE);
+  }
+
   if (unlikely((error=
                 cache_table->file->ha_write_tmp_row(cache_table->record[0]))))
   {
@@ -106,6 +106,13 @@ class Expression_cache_tracker :public Sql_alloc
 
 /**
   Implementation of expression cache over a temporary table
+
+  @note
+  If the temporary table has no blobs, it is never opened: its record
+  buffer and its key are only used to encode the parameters, and the
+  cached records are kept in an in-memory hash bounded by
+  tmp_memory_table_size, the least recently used entries being evicted
+  first.
 */
 
 class Expression_cache_tmptable :public Expression_cache
@@ -137,7 +144,17 @@ class Expression_cache_tmptable :public Expression_cache
   }
 
 private:
+  /* Entry of the in-memory hash, followed by its key and its record */
+  struct Hash_entry
+  {
+    Hash_entry *lru_prev, *lru_next;
+  };
+
   void disable_cache();
+  int hash_lookup();
+  bool hash_insert();
+  void lru_unlink(Hash_entry *entry);
+  void lru_push_front(Hash_entry *entry);
 
   /* tmp table parameters */
   TMP_TABLE_PARAM cache_table_param;
@@ -155,6 +172,12 @@ class Expression_cache_tmptable :public Expression_cache
   List<Item> &items;
   /* Value Item example */
   Item *val;
+  /* In-memory hash of the cached records */
+  HASH hash;
+  /* Most and least recently used entries of the hash */
+  Hash_entry *lru_first, *lru_last;
+  /* Memory used by the hash entries and its limit */
+  size_t hash_memory, hash_memory_limit;
   /* hit/miss counters */
   ulong hit, miss;
   /* Set on if the object has been successfully initialized with init() */
@@ -98,6 +98,11 @@ static void unlink_blobs(TABLE *table);
 #endif
 static bool check_view_insertability(THD *thd, TABLE_LIST *view,
                                      List<Item> &fields);
+static int write_record_batch(THD *thd, TABLE *table, COPY_INFO *info,
+                              const uchar *rows, ha_rows n);
+
+/** Size of the rows that mysql_insert() passes to ha_write_rows() at once */
+#define INSERT_BATCH_SIZE 65536
 static int binlog_show_create_table_(THD *thd, TABLE *table,
                                      Table_specification_st *create_info);
 
@@ -738,6 +743,9 @@ bool mysql_insert(THD *thd, TABLE_LIST *table_list,
   Name_resolution_context_state ctx_state;
   SELECT_LEX *returning= thd->lex->has_returning() ? thd->lex->returning() : 0;
   unsigned char *readbuff= NULL;
+  /* rows that were prepared for handler::ha_write_rows() */
+  uchar *batch= NULL;
+  ha_rows batch_size= 0, batched= 0;
 
 #ifndef EMBEDDED_LIBRARY
   char *query= thd->query();
@@ -1046,6 +1054,30 @@ bool mysql_insert(THD *thd, TABLE_LIST *table_list,
   if (returning)
     fix_rownum_pointers(thd, thd->lex->returning(), &info.accepted_rows);
 
+  /*
+    Pass the rows to the engine in batches, unless something has to act
+    on every row as soon as it is written, or the VALUES may read the
+    table (through a subquery or a stored function, which would add
+    tables after table_list), or the record refers to memory that is
+    reused for the next row (BLOB values). A duplicate key is only noticed
+    when the batch is written, after the VALUES of the following rows of
+    the batch were evaluated.
+  */
+  if (values_list.elements > 1 && lock_type != TL_WRITE_DELAYED &&
+      (table->file->ha_table_flags() & HA_CAN_WRITE_ROWS) &&
+      duplic == DUP_ERROR && !ignore && !returning && !table->triggers &&
+      !table->next_number_field && !table->versioned() &&
+      !table->s->blob_fields && !table->s->long_unique_table &&
+      !table->s->period.unique_keys && !table->s->hlindexes() &&
+      !table->s->sequence && !table_list->view && !table_list->next_global &&
+      thd->lex->query_tables == table_list && !WSREP(thd))
+  {
+    batch_size= MY_MIN(values_list.elements,
+                       MY_MAX(INSERT_BATCH_SIZE / table->s->rec_buff_length,
+                              2));
+    batch= (uchar*) thd->alloc(batch_size * table->s->rec_buff_length);
+  }
+
   do
   {
     DBUG_PRINT("info", ("iteration %llu", iteration));
@@ -1178,11 +1210,26 @@ bool mysql_insert(THD *thd, TABLE_LIST *table_list,
       }
       else
 #endif
-      error= write_record(thd, table, &info, result);
+      if (!batch)
+        error= write_record(thd, table, &info, result);
+      else
+      {
+        memcpy(batch + batched++ * table->s->rec_buff_length,
+               table->record[0], table->s->reclength);
+        info.records++;
+        if (batched == batch_size)
+        {
+          error= write_record_batch(thd, table, &info, batch, batched);
+          batched= 0;
+        }
+      }
       if (unlikely(error))
         break;
       info.accepted_rows++;
     }
+    if (batched && !error)
+      error= write_record_batch(thd, table, &info, batch, batched);
+    batched= 0;
     its.rewind();
     iteration++;
 
@@ -1934,6 +1981,39 @@ int vers_insert_history_row(TABLE *table)
 */
 
 
+/**
+  Write rows that were prepared by mysql_insert() for a table that needs
+  none of the duplicate key, trigger or RETURNING handling of
+  write_record().
+
+  @param thd    thread handler
+  @param table  table to insert into
+  @param info   COPY_INFO of the INSERT
+  @param rows   consecutive records of table->s->rec_buff_length bytes
+  @param n      number of rows
+
+  @retval 0 on success
+  @retval 1 if an error was reported
+*/
+
+static int write_record_batch(THD *thd, TABLE *table, COPY_INFO *info,
+                              const uchar *rows, ha_rows n)
+{
+  ha_rows written;
+  int error= table->file->ha_write_rows(rows, n, &written);
+  info->copied+= written;
+  if (written)
+    thd->transaction->stmt.modified_non_trans_table|=
+      !table->file->has_transactions_and_rollback();
+  if (likely(!error))
+    return 0;
+  info->last_errno= error;
+  /* ha_write_rows() copied the failed row to record[0] */
+  table->file->print_error(error, MYF(0));
+  return 1;
+}
+
+
 int write_record(THD *thd, TABLE *table, COPY_INFO *info, select_result *sink)
 {
   int error, trg_error= 0;
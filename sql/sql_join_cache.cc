@@ -3283,8 +3283,7 @@ bool JOIN_CACHE_HASHED::key_search(uchar *key, uint key_len,
     the calculated index of the hash entry for the given key  
 */
 
-inline
-uint JOIN_CACHE_HASHED::get_hash_idx_simple(uchar* key, uint key_len)
+static inline ulong key_hashnr_simple(uchar *key, uint key_len)
 {
   ulong nr= 1;
   ulong nr2= 4;
@@ -3295,7 +3294,13 @@ uint JOIN_CACHE_HASHED::get_hash_idx_simple(uchar* key, uint key_len)
     nr^= (ulong) ((((uint) nr & 63)+nr2)*((uint) *pos))+ (nr << 8);
     nr2+= 3;
   }
-  return nr % hash_entries;
+  return nr;
+}
+
+inline
+uint JOIN_CACHE_HASHED::get_hash_idx_simple(uchar* key, uint key_len)
+{
+  return key_hashnr_simple(key, key_len) % hash_entries;
 }
 
 
@@ -3330,6 +3335,32 @@ uint JOIN_CACHE_HASHED::get_hash_idx_complex(uchar *key, uint key_len)
 }
 
 
+/*
+  Calculate the hash value of a key independently of the hash table
+
+  SYNOPSIS
+    get_key_hashnr()
+      key             pointer to the key value
+      key_len         key value length
+
+  DESCRIPTION
+    The function calculates the hash value of the given key by the same
+    hash function as the one employed by the hash table, but without
+    taking the value modulo the number of the hash entries. Equal keys
+    always get the same hash value.
+
+  RETURN VALUE
+    the calculated hash value for the given key
+*/
+
+ulong JOIN_CACHE_HASHED::get_key_hashnr(uchar *key, uint key_len)
+{
+  if (hash_func == &JOIN_CACHE_HASHED::get_hash_idx_complex)
+    return key_hashnr(ref_key_info, ref_used_key_parts, key);
+  return key_hashnr_simple(key, key_len);
+}
+
+
 /* 
   Compare two key entries in the hash table as sequence of bytes
 
@@ -3965,6 +3996,437 @@ int JOIN_CACHE_BNLH::init(bool for_explain)
 }
 
 
+/* The size of the buffer of each partition file of a BNLH join cache */
+static const size_t JOIN_CACHE_SPILL_BUFF_SIZE= 4*IO_SIZE;
+
+/*
+  Check whether the records of a BNLH join cache can be spilled to partitions
+
+  SYNOPSIS
+    can_spill()
+
+  DESCRIPTION
+    The records of the partial join and the records of join_tab are spilled
+    as the images of the record buffers of their tables. This is possible
+    only if the cache is not linked to other caches, no table has blobs
+    and no rowids are needed. Match flags are not preserved in partition
+    files, so only inner joins that need all matches are supported.
+
+  RETURN VALUE
+    TRUE    the records can be spilled to partitions
+    FALSE   otherwise
+*/
+
+bool JOIN_CACHE_BNLH::can_spill()
+{
+  if (join->thd->variables.join_buff_spill_partitions < 2 ||
+      prev_cache || next_cache ||
+      join_tab->first_inner || join_tab->emb_sj_nest ||
+      join_tab->bush_root_tab || join_tab->check_only_first_match() ||
+      join_tab->keep_current_rowid || join_tab->use_quick == 2 ||
+      join_tab->table->s->blob_fields)
+    return FALSE;
+
+  for (JOIN_TAB *tab= start_tab; tab != join_tab;
+       tab= next_linear_tab(join, tab, WITHOUT_BUSH_ROOTS))
+  {
+    if (tab->first_inner || tab->emb_sj_nest || tab->bush_root_tab ||
+        tab->keep_current_rowid || tab->table->s->blob_fields)
+      return FALSE;
+  }
+  return TRUE;
+}
+
+
+/*
+  Start spilling the records of a BNLH join cache to partitions
+
+  SYNOPSIS
+    start_spill()
+
+  DESCRIPTION
+    The function is called when the join buffer has become full for the
+    first time. It estimates the number of partitions from the expected
+    cardinality of the partial join, opens the partition files and moves
+    all records from the join buffer into them.
+
+  RETURN VALUE
+    FALSE   the records have been moved to the partition files
+    TRUE    the partition files could not be created or written
+*/
+
+bool JOIN_CACHE_BNLH::start_spill()
+{
+  uint max_parts= (uint) join->thd->variables.join_buff_spill_partitions;
+  double refills= (join_tab-1)->get_partial_join_cardinality() /
+                  (double) records;
+  uint parts= refills < max_parts / 2 ? (uint) (refills * 2) + 1 : max_parts;
+  set_if_bigger(parts, 2);
+
+  if (!(spill_build= (IO_CACHE*) my_malloc(key_memory_JOIN_CACHE,
+                                           2 * parts * sizeof(IO_CACHE),
+                                           MYF(MY_WME | MY_THREAD_SPECIFIC |
+                                               MY_ZEROFILL))))
+    return TRUE;
+  spill_probe= spill_build + parts;
+  spill_parts= parts;
+
+  for (uint i= 0; i < 2 * parts; i++)
+  {
+    if (open_cached_file(&spill_build[i], mysql_tmpdir, TEMP_PREFIX,
+                         JOIN_CACHE_SPILL_BUFF_SIZE, MYF(MY_WME)))
+    {
+      end_spill();
+      return TRUE;
+    }
+  }
+
+  reset(FALSE);
+  for (size_t i= records; i; i--)
+  {
+    get_record();
+    if (spill_record())
+    {
+      end_spill();
+      return TRUE;
+    }
+  }
+  reset(TRUE);
+  return FALSE;
+}
+
+
+/*
+  Close the partition files of a BNLH join cache
+
+  SYNOPSIS
+    end_spill()
+
+  DESCRIPTION
+    The function closes all partition files, if any, and returns the
+    cache to the state where the records are joined refill by refill.
+
+  RETURN VALUE
+    none
+*/
+
+void JOIN_CACHE_BNLH::end_spill()
+{
+  if (!spill_parts)
+    return;
+  for (uint i= 0; i < 2 * spill_parts; i++)
+    close_cached_file(&spill_build[i]);
+  my_free(spill_build);
+  spill_build= spill_probe= 0;
+  spill_parts= 0;
+  spill_error= FALSE;
+}
+
+
+/*
+  Get the partition of a record of a BNLH join cache
+
+  SYNOPSIS
+    get_spill_part()
+      key   the join key of the record
+
+  DESCRIPTION
+    The partitions are chosen by a hash value of the join key that does
+    not depend on the hash table. The value is mixed so that the records
+    from one partition are not mapped to a subset of the hash entries.
+
+  RETURN VALUE
+    the number of the partition for the record
+*/
+
+uint JOIN_CACHE_BNLH::get_spill_part(uchar *key)
+{
+  ulong nr= get_key_hashnr(key, key_length);
+  nr^= nr >> 15;
+  nr*= 0x9E3779B1UL;
+  nr^= nr >> 16;
+  return (uint) (nr % spill_parts);
+}
+
+
+/*
+  Write the records of the partial join into a partition file
+
+  SYNOPSIS
+    spill_record()
+
+  DESCRIPTION
+    The function builds the join key over the fields read into the record
+    buffers of the tables from the cache and appends the images of these
+    record buffers to the partition file chosen by this key.
+
+  RETURN VALUE
+    FALSE   the record has been written
+    TRUE    otherwise
+*/
+
+bool JOIN_CACHE_BNLH::spill_record()
+{
+  TABLE_REF *ref= &join_tab->ref;
+  cp_buffer_from_ref(join->thd, join_tab->table, ref);
+  IO_CACHE *file= &spill_build[get_spill_part(ref->key_buff)];
+
+  for (JOIN_TAB *tab= start_tab; tab != join_tab;
+       tab= next_linear_tab(join, tab, WITHOUT_BUSH_ROOTS))
+  {
+    if (my_b_write(file, tab->table->record[0], tab->table->s->reclength))
+      return TRUE;
+  }
+  return FALSE;
+}
+
+
+/*
+  Add a record into the buffer of a BNLH join cache or into a partition file
+
+  SYNOPSIS
+    put_record()
+
+  DESCRIPTION
+    This implementation of the virtual function put_record adds the record
+    into the join buffer, unless the records are spilled to partitions.
+    When the join buffer becomes full for the first time and the records
+    can be spilled, the records from the buffer are moved to the partition
+    files, and all subsequent records are written there directly.
+
+  RETURN VALUE
+    TRUE    if it has been decided that it should be the last record
+            in the join buffer, or if writing a partition file failed
+    FALSE   otherwise
+*/
+
+bool JOIN_CACHE_BNLH::put_record()
+{
+  if (spill_parts)
+  {
+    if (spill_record())
+      spill_error= TRUE;
+    return spill_error;
+  }
+
+  bool is_full= JOIN_CACHE_HASHED::put_record();
+  if (is_full && can_spill() && !start_spill())
+    return FALSE;
+  return is_full;
+}
+
+
+/*
+  Write the records of join_tab that can match into partition files
+
+  SYNOPSIS
+    spill_join_tab_records()
+
+  DESCRIPTION
+    The function performs one scan of join_tab in the same way as the
+    function join_matching_records does and writes the images of the
+    record buffer of join_tab into the partition files chosen by the join
+    keys built over the records.
+
+  RETURN VALUE
+    return one of enum_nested_loop_state
+*/
+
+enum_nested_loop_state JOIN_CACHE_BNLH::spill_join_tab_records()
+{
+  int error;
+  enum_nested_loop_state rc= NESTED_LOOP_OK;
+  TABLE *table= join_tab->table;
+  table->null_row= 0;
+
+  if ((rc= join_tab_execution_startup(join_tab)) < 0)
+    return rc;
+
+  if (join_tab->need_to_build_rowid_filter &&
+      join_tab->build_range_rowid_filter())
+    return NESTED_LOOP_ERROR;
+
+  if (unlikely((error= join_tab_scan->open())))
+    rc= NESTED_LOOP_ERROR;
+  else
+  {
+    while (!(error= join_tab_scan->next()))
+    {
+      if (unlikely(join->thd->check_killed()))
+      {
+        rc= NESTED_LOOP_KILLED;
+        break;
+      }
+      key_copy(key_buff, table->record[0], ref_key_info, key_length, TRUE);
+      if (my_b_write(&spill_probe[get_spill_part(key_buff)],
+                     table->record[0], table->s->reclength))
+      {
+        rc= NESTED_LOOP_ERROR;
+        break;
+      }
+    }
+    if (error > 0)
+      rc= NESTED_LOOP_ERROR;
+  }
+  join_tab_scan->close();
+  return rc;
+}
+
+
+/*
+  Find matches from a partition for the records in a BNLH join buffer
+
+  SYNOPSIS
+    join_spilled_part()
+      part   the number of the partition
+
+  DESCRIPTION
+    The function reads the records of join_tab from the partition file with
+    the number part and looks for the matches in the join buffer, which
+    contains records from the partition of the partial join with the same
+    number. If a match is found the function calls generate_full_extensions
+    for it.
+
+  RETURN VALUE
+    return one of enum_nested_loop_state
+*/
+
+enum_nested_loop_state JOIN_CACHE_BNLH::join_spilled_part(uint part)
+{
+  enum_nested_loop_state rc= NESTED_LOOP_OK;
+  TABLE *table= join_tab->table;
+  IO_CACHE *file= &spill_probe[part];
+
+  if (reinit_io_cache(file, READ_CACHE, 0L, 0, 0))
+    return NESTED_LOOP_ERROR;
+
+  while (!my_b_read(file, table->record[0], table->s->reclength))
+  {
+    if (unlikely(join->thd->check_killed()))
+      return NESTED_LOOP_KILLED;
+
+    if (prepare_look_for_matches(FALSE))
+      continue;
+    join_tab->jbuf_tracker->r_scans++;
+
+    uchar *rec_ptr;
+    while ((rec_ptr= get_next_candidate_for_match()))
+    {
+      join_tab->jbuf_tracker->r_rows++;
+      read_next_candidate_for_match(rec_ptr);
+      rc= generate_full_extensions(rec_ptr);
+      if (rc != NESTED_LOOP_OK && rc != NESTED_LOOP_NO_MORE_ROWS)
+        return rc;
+    }
+  }
+  return file->error ? NESTED_LOOP_ERROR : rc;
+}
+
+
+/*
+  Join the records of the partition files of a BNLH join cache pairwise
+
+  SYNOPSIS
+    join_spilled_records()
+
+  DESCRIPTION
+    The function first distributes the records of join_tab over the
+    partition files. Then, for each partition, it loads the records of the
+    partial join from the partition file into the join buffer and looks
+    for matches among the records of join_tab from the partition with the
+    same number. If the records of one partition do not fit into the join
+    buffer, the partition of join_tab is read once for each refill.
+
+  RETURN VALUE
+    return one of enum_nested_loop_state
+*/
+
+enum_nested_loop_state JOIN_CACHE_BNLH::join_spilled_records()
+{
+  enum_nested_loop_state rc;
+
+  if (spill_error)
+    return NESTED_LOOP_ERROR;
+  if ((rc= spill_join_tab_records()) != NESTED_LOOP_OK)
+    return rc;
+
+  for (uint part= 0; part < spill_parts; part++)
+  {
+    IO_CACHE *file= &spill_build[part];
+    if (reinit_io_cache(file, READ_CACHE, 0L, 0, 0))
+      return NESTED_LOOP_ERROR;
+
+    reset(TRUE);
+    for (;;)
+    {
+      bool eof= FALSE;
+      for (JOIN_TAB *tab= start_tab; tab != join_tab;
+           tab= next_linear_tab(join, tab, WITHOUT_BUSH_ROOTS))
+      {
+        if (my_b_read(file, tab->table->record[0], tab->table->s->reclength))
+        {
+          if (file->error)
+            return NESTED_LOOP_ERROR;
+          eof= TRUE;
+          break;
+        }
+      }
+      if (eof)
+        break;
+      if (JOIN_CACHE_HASHED::put_record())
+      {
+        rc= join_spilled_part(part);
+        if (rc != NESTED_LOOP_OK && rc != NESTED_LOOP_NO_MORE_ROWS)
+          return rc;
+        reset(TRUE);
+      }
+    }
+
+    if (records)
+    {
+      rc= join_spilled_part(part);
+      if (rc != NESTED_LOOP_OK && rc != NESTED_LOOP_NO_MORE_ROWS)
+        return rc;
+    }
+  }
+  return NESTED_LOOP_OK;
+}
+
+
+/*
+  Join records from a BNLH join buffer or from its partition files
+
+  SYNOPSIS
+    join_records()
+      skip_last    do not look for matches for the last partial join record
+
+  DESCRIPTION
+    If the records of the cache have not been spilled to partitions the
+    function just calls the default implementation of join_records.
+    Otherwise it is called once after all records of the partial join have
+    been written into the partition files, and it joins the partitions
+    pairwise by calling join_spilled_records.
+
+  RETURN VALUE
+    return one of enum_nested_loop_state, except NESTED_LOOP_NO_MORE_ROWS.
+*/
+
+enum_nested_loop_state JOIN_CACHE_BNLH::join_records(bool skip_last)
+{
+  if (!spill_parts)
+    return JOIN_CACHE::join_records(skip_last);
+
+  DBUG_ASSERT(!skip_last);
+  enum_nested_loop_state rc= join_spilled_records();
+  end_spill();
+  if (rc == NESTED_LOOP_NO_MORE_ROWS)
+    rc= NESTED_LOOP_OK;
+  restore_last_record();
+  reset(TRUE);
+  return rc;
+}
+
+
 /* 
   Calculate the increment of the MRR buffer for a record write       
 
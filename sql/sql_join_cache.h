@@ -671,7 +671,7 @@ class JOIN_CACHE :public Sql_alloc
   }
      
   /* Join records from the join buffer with records from the next join table */ 
-  enum_nested_loop_state join_records(bool skip_last);
+  virtual enum_nested_loop_state join_records(bool skip_last);
 
   /* Add a comment on the join algorithm employed by the join cache */
   virtual bool save_explain_data(EXPLAIN_BKA_TYPE *explain);
@@ -680,7 +680,7 @@ class JOIN_CACHE :public Sql_alloc
 
   virtual ~JOIN_CACHE() = default;
   void reset_join(JOIN *j) { join= j; }
-  void free()
+  virtual void free()
   { 
     my_free(buff);
     buff= 0;
@@ -984,6 +984,9 @@ class JOIN_CACHE_HASHED: public JOIN_CACHE
   /* Search for a key in the hash table of the join buffer */
   bool key_search(uchar *key, uint key_len, uchar **key_ref_ptr);
 
+  /* Get the hash value of a key that does not depend on the hash table */
+  ulong get_key_hashnr(uchar *key, uint key_len);
+
   /* Reallocate the join buffer of a hashed join cache */
   int realloc_buffer() override;
 
@@ -1154,6 +1157,12 @@ class JOIN_CACHE_BNL :public JOIN_CACHE
 /*
   The class JOIN_CACHE_BNLH is used when the BNLH join algorithm is
   employed to perform a join operation   
+  If the records of the partial join do not fit into the join buffer
+  and join_buffer_spill_partitions allows it, the records are not joined
+  refill by refill, each refill requiring a full scan of join_tab.
+  Instead, the records of the partial join and then the records of join_tab
+  are written into partition files by the hash of their join keys, and the
+  pairs of the partitions are joined one by one (grace hash join).
 */
 
 class JOIN_CACHE_BNLH :public JOIN_CACHE_HASHED
@@ -1190,6 +1199,35 @@ class JOIN_CACHE_BNLH :public JOIN_CACHE_HASHED
 
   void read_next_candidate_for_match(uchar *rec_ptr) override;
 
+  /*
+    The number of the partitions that the records are spilled into when
+    they do not fit into the join buffer, 0 if the records are not spilled
+  */
+  uint spill_parts;
+  /* Set if writing a record into a partition file has failed */
+  bool spill_error;
+  /* The partition files for the records of the tables from the cache */
+  IO_CACHE *spill_build;
+  /* The partition files for the records of join_tab */
+  IO_CACHE *spill_probe;
+
+  /* Check whether the records of the cache can be spilled to partitions */
+  bool can_spill();
+  /* Start spilling the records of the cache to partitions */
+  bool start_spill();
+  /* Close the partition files */
+  void end_spill();
+  /* Get the partition of a record by its join key */
+  uint get_spill_part(uchar *key);
+  /* Write the records of the partial join into a partition file */
+  bool spill_record();
+  /* Write all records of join_tab that can match into partition files */
+  enum_nested_loop_state spill_join_tab_records();
+  /* Join the records of the partitions pairwise */
+  enum_nested_loop_state join_spilled_records();
+  /* Find matches for the records in the join buffer from a partition */
+  enum_nested_loop_state join_spilled_part(uint part);
+
 public:
 
   /* 
@@ -1197,7 +1235,8 @@ class JOIN_CACHE_BNLH :public JOIN_CACHE_HASHED
     used to join table 'tab' to the result of joining the previous tables 
     specified by the 'j' parameter.
   */   
-  JOIN_CACHE_BNLH(JOIN *j, JOIN_TAB *tab) : JOIN_CACHE_HASHED(j, tab) {}
+  JOIN_CACHE_BNLH(JOIN *j, JOIN_TAB *tab)
+    : JOIN_CACHE_HASHED(j, tab), spill_parts(0), spill_error(FALSE) {}
 
   /* 
     This constructor creates a linked BNLH join cache. The cache is to be 
@@ -1206,11 +1245,23 @@ class JOIN_CACHE_BNLH :public JOIN_CACHE_HASHED
     cache object to which this cache is linked.
   */   
   JOIN_CACHE_BNLH(JOIN *j, JOIN_TAB *tab, JOIN_CACHE *prev) 
-    : JOIN_CACHE_HASHED(j, tab, prev) {}
+    : JOIN_CACHE_HASHED(j, tab, prev), spill_parts(0), spill_error(FALSE) {}
 
   /* Initialize the BNLH cache */       
   int init(bool for_explain) override;
 
+  /* Add a record into the join buffer or into a partition file */
+  bool put_record() override;
+
+  /* Join records from the join buffer or from the partition files */
+  enum_nested_loop_state join_records(bool skip_last) override;
+
+  void free() override
+  {
+    end_spill();
+    JOIN_CACHE_HASHED::free();
+  }
+
   enum Join_algorithm get_join_alg() override { return BNLH_JOIN_ALG; }
 
   bool is_key_access() override { return TRUE; }
@@ -35,6 +35,7 @@
                         // Execute_load_query_log_event,
                         // LOG_EVENT_UPDATE_TABLE_MAP_VERSION_F
 #include <m_ctype.h>
+#include "mysys_err.h"                          // EE_READ
 #include "rpl_mi.h"
 #include "sql_repl.h"
 #include "sp_head.h"
@@ -45,8 +46,14 @@
 #include "wsrep_mysqld.h"
 
 #include "scope.h"  // scope_exit
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 extern "C" int _my_b_net_read(IO_CACHE *info, uchar *Buffer, size_t Count);
+extern PSI_mutex_key key_LOCK_load_read_ahead;
+extern PSI_cond_key key_COND_load_read_ahead;
+extern PSI_thread_key key_thread_load_read_ahead;
 
 class XML_TAG {
 public:
@@ -98,6 +105,182 @@ class Term_string
 };
 
 
+/*
+  Read ahead of a LOAD DATA INFILE file that is read from the server.
+
+  A helper thread reads the next block of the file while the connection
+  thread parses and inserts the rows of the current one, so that waiting
+  for the file and the CPU work of LOAD DATA overlap.
+*/
+class Load_read_ahead
+{
+  File file;
+  uchar *block;                 /* the block that is read ahead */
+  size_t block_size;
+  size_t length;                /* bytes in block, if !reading */
+  my_off_t offset;              /* position of block in file */
+  int read_errno;               /* my_errno of a failed read, or 0 */
+  bool reading, stop, started;
+  mysql_mutex_t mutex;
+  mysql_cond_t cond;
+  pthread_t thread;
+
+  void run()
+  {
+    my_thread_init();
+    mysql_mutex_lock(&mutex);
+    for (;;)
+    {
+      while (!reading && !stop)
+        mysql_cond_wait(&cond, &mutex);
+      if (stop)
+        break;
+      const my_off_t pos= offset;
+      mysql_mutex_unlock(&mutex);
+      size_t n= mysql_file_pread(file, block, block_size, pos, MYF(0));
+      mysql_mutex_lock(&mutex);
+      if (n == MY_FILE_ERROR)
+      {
+        read_errno= my_errno ? my_errno : EIO;
+        n= 0;
+      }
+      length= n;
+      reading= false;
+      mysql_cond_broadcast(&cond);
+    }
+    mysql_mutex_unlock(&mutex);
+    my_thread_end();
+  }
+
+  static void *run_thread(void *arg)
+  {
+    static_cast<Load_read_ahead*>(arg)->run();
+    return NULL;
+  }
+
+public:
+  Load_read_ahead(File file_arg, size_t block_size_arg) :
+    file(file_arg), block(NULL), block_size(block_size_arg), length(0),
+    offset(0),
+    read_errno(0), reading(true), stop(false), started(false)
+  {
+    mysql_mutex_init(key_LOCK_load_read_ahead, &mutex, MY_MUTEX_INIT_FAST);
+    mysql_cond_init(key_COND_load_read_ahead, &cond, NULL);
+  }
+
+  /**
+    Start reading the first block of the file
+    @retval true  if the helper thread could not be started; the caller
+                  should read the file by itself
+  */
+  bool start()
+  {
+    DBUG_EXECUTE_IF("load_read_ahead_no_thread", return true;);
+    if (!(block= (uchar*) my_malloc(PSI_INSTRUMENT_ME, block_size,
+                                    MYF(0))))
+      return true;
+    if (mysql_thread_create(key_thread_load_read_ahead, &thread, NULL,
+                            run_thread, this))
+      return true;
+    started= true;
+    return false;
+  }
+
+  ~Load_read_ahead()
+  {
+    if (started)
+    {
+      mysql_mutex_lock(&mutex);
+      stop= true;
+      mysql_cond_broadcast(&cond);
+      mysql_mutex_unlock(&mutex);
+      pthread_join(thread, NULL);
+    }
+    my_free(block);
+    mysql_cond_destroy(&cond);
+    mysql_mutex_destroy(&mutex);
+  }
+
+  /**
+    Get the next block and start reading the one after it.
+    @param to   buffer of block_size bytes
+    @return number of bytes copied to to; 0 at the end of the file
+    @retval (size_t) -1 on read error
+  */
+  size_t next(uchar *to)
+  {
+    mysql_mutex_lock(&mutex);
+    while (reading)
+      mysql_cond_wait(&cond, &mutex);
+    size_t n;
+    if (read_errno)
+    {
+      my_errno= read_errno;
+      n= (size_t) -1;
+    }
+    else
+    {
+      n= length;
+      memcpy(to, block, n);
+      if (n)
+      {
+        offset+= n;
+        reading= true;
+        mysql_cond_broadcast(&cond);
+      }
+    }
+    mysql_mutex_unlock(&mutex);
+    return n;
+  }
+};
+
+
+struct Load_data_cache : public LOAD_FILE_IO_CACHE
+{
+  Load_read_ahead *read_ahead;
+};
+
+
+/**
+  IO_CACHE::read_function for READ_CACHE that gets the blocks from
+  Load_read_ahead instead of reading them
+*/
+static int read_ahead_read(IO_CACHE *info, uchar *Buffer, size_t Count)
+{
+  Load_read_ahead *read_ahead= static_cast<Load_data_cache*>(info)->read_ahead;
+  size_t copied= 0;
+  DBUG_ASSERT(info->read_pos == info->read_end);
+
+  while (Count)
+  {
+    my_off_t pos= info->pos_in_file + (info->read_end - info->buffer);
+    size_t length= read_ahead->next(info->buffer);
+    if (length == (size_t) -1)
+    {
+      my_error(EE_READ, MYF(ME_BELL), my_filename(info->file), my_errno);
+      info->read_pos= info->read_end= info->buffer;
+      info->error= -1;
+      return 1;
+    }
+    info->pos_in_file= pos;
+    info->read_pos= info->buffer;
+    info->read_end= info->buffer + length;
+    if (!length)
+    {
+      info->error= (int) copied;
+      return 1;
+    }
+    size_t n= MY_MIN(Count, length);
+    memcpy(Buffer, info->read_pos, n);
+    info->read_pos+= n;
+    Buffer+= n;
+    Count-= n;
+    copied+= n;
+  }
+  return 0;
+}
+
+
 #define GET (stack_pos != stack ? *--stack_pos : my_b_get(&cache))
 #define PUSH(A) *(stack_pos++)=(A)
 
@@ -164,6 +347,49 @@ class READ_INFO: public Load_data_param
   int	*stack,*stack_pos;
   bool	found_end_of_line,start_of_line,eof;
   int level; /* for load xml */
+  /*
+    The bytes that read_field() has to look at one by one: the escape and
+    enclosure characters, the first bytes of the terminators and, for
+    multi-byte character sets, all bytes >= 0x80. Runs of other bytes are
+    copied in bulk by plain_run().
+  */
+  bool special[256];
+  uchar special_needle[4];
+  bool special_high;
+  bool plain_runs;                      /* whether plain_run() can be used */
+
+  /**
+    Find the first byte that read_field() must interpret.
+    @param str     bytes to scan
+    @param length  number of bytes
+    @return number of bytes before the first special one, at most length
+  */
+  size_t plain_run(const uchar *str, size_t length) const
+  {
+    size_t i= 0;
+#ifdef __SSE2__
+    const __m128i n0= _mm_set1_epi8((char) special_needle[0]);
+    const __m128i n1= _mm_set1_epi8((char) special_needle[1]);
+    const __m128i n2= _mm_set1_epi8((char) special_needle[2]);
+    const __m128i n3= _mm_set1_epi8((char) special_needle[3]);
+    for (; i + 16 <= length; i+= 16)
+    {
+      const __m128i v= _mm_loadu_si128((const __m128i*) (str + i));
+      const __m128i eq= _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, n0),
+                                                  _mm_cmpeq_epi8(v, n1)),
+                                     _mm_or_si128(_mm_cmpeq_epi8(v, n2),
+                                                  _mm_cmpeq_epi8(v, n3)));
+      uint mask= (uint) _mm_movemask_epi8(eq);
+      if (special_high)
+        mask|= (uint) _mm_movemask_epi8(v);
+      if (mask)
+        return i + my_find_first_bit(mask);
+    }
+#endif
+    for (; i < length && !special[str[i]]; i++)
+    {}
+    return i;
+  }
 
   bool getbyte(char *to)
   {
@@ -241,7 +467,7 @@ class READ_INFO: public Load_data_param
   bool error,line_cuted,found_null,enclosed;
   uchar	*row_start,			/* Found row starts here */
 	*row_end;			/* Found row ends here */
-  LOAD_FILE_IO_CACHE cache;
+  Load_data_cache cache;
 
   READ_INFO(THD *thd, File file, const Load_data_param &param,
 	    String &field_term,String &line_start,String &line_term,
@@ -1431,6 +1657,7 @@ READ_INFO::READ_INFO(THD *thd, File file_par,
    escape_char(escape), found_end_of_line(false), eof(false),
    error(false), line_cuted(false), found_null(false)
 {
+  cache.read_ahead= NULL;
   data.set_thread_specific();
   /*
     Field and line terminators must be interpreted as sequence of unsigned char.
@@ -1445,6 +1672,30 @@ READ_INFO::READ_INFO(THD *thd, File file_par,
     m_line_term.reset();
   enclosed_char= enclosed_par.length() ? (uchar) enclosed_par[0] : INT_MAX;
 
+  /* ucs2, utf16 and utf32 have ASCII bytes inside their characters */
+  plain_runs= charset()->mbminlen == 1;
+  special_high= charset()->use_mb();
+  {
+    uint n_needles= 0;
+    const int chars[4]= {escape_char, enclosed_char,
+                         m_field_term.length() ? m_field_term.initial_byte()
+                                               : INT_MAX,
+                         m_line_term.length() ? m_line_term.initial_byte()
+                                              : INT_MAX};
+    bzero(special, sizeof special);
+    for (int chr : chars)
+      if (chr >= 0 && chr <= 255)
+        special_needle[n_needles++]= (uchar) chr;
+    if (!n_needles)
+      special_needle[n_needles++]= 0;
+    for (uint i= n_needles; i < array_elements(special_needle); i++)
+      special_needle[i]= special_needle[0];
+    for (uchar chr : special_needle)
+      special[chr]= true;
+    if (special_high)
+      memset(special + 0x80, 1, 0x80);
+  }
+
   /* Set of a stack for unget if long terminators */
   uint length= MY_MAX(charset()->mbmaxlen, MY_MAX(m_field_term.length(),
                                                   m_line_term.length())) + 1;
@@ -1465,6 +1716,20 @@ READ_INFO::READ_INFO(THD *thd, File file_par,
     }
     else
     {
+      if (!get_it_from_net && !is_fifo &&
+          thd->variables.load_data_read_ahead &&
+          cache.end_of_file > cache.buffer_length)
+      {
+        cache.read_ahead= new Load_read_ahead(file, cache.buffer_length);
+        if (cache.read_ahead->start())
+        {
+          /* Fall back to reading the file in this thread */
+          delete cache.read_ahead;
+          cache.read_ahead= NULL;
+        }
+        else
+          cache.read_function= read_ahead_read;
+      }
 #ifndef EMBEDDED_LIBRARY
       if (get_it_from_net)
 	cache.read_function = _my_b_net_read;
@@ -1482,6 +1747,7 @@ READ_INFO::READ_INFO(THD *thd, File file_par,
 
 READ_INFO::~READ_INFO()
 {
+  delete cache.read_ahead;
   ::end_io_cache(&cache);
   List_iterator<XML_TAG> xmlit(taglist);
   XML_TAG *t;
@@ -1596,6 +1862,18 @@ int READ_INFO::read_field(CHARSET_INFO *cs)
     // Make sure we have enough space for the longest multi-byte character.
     while (data.length() + cs->mbmaxlen <= data.alloced_length())
     {
+      if (plain_runs && stack_pos == stack)
+      {
+        size_t length= MY_MIN((size_t) (cache.read_end - cache.read_pos),
+                              data.alloced_length() - data.length() -
+                              cs->mbmaxlen + 1);
+        if ((length= plain_run(cache.read_pos, length)))
+        {
+          data.append((const char*) cache.read_pos, length);
+          cache.read_pos+= length;
+          continue;
+        }
+      }
       chr = GET;
       if (chr == my_b_EOF)
 	goto found_eof;
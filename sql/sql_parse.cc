@@ -1156,6 +1156,13 @@ static bool wsrep_command_no_result(char command)
 }
 #endif /* WITH_WSREP */
 #ifndef EMBEDDED_LIBRARY
+/** Check if the next command is already cached in the NET or its Vio */
+static inline bool net_has_unread_data(NET *net)
+{
+  return net->vio->has_data(net->vio) || (net->compress && net->remain_in_buf);
+}
+
+
 static enum enum_server_command fetch_command(THD *thd, char *packet)
 {
   enum enum_server_command
@@ -1269,6 +1276,7 @@ dispatch_command_return do_command(THD *thd, bool blocking)
   */
   DEBUG_SYNC(thd, "before_do_command_net_read");
 
+  thd->defer_reply_flush= false;
   packet_length= my_net_read_packet(net, 1);
 
   if (unlikely(packet_length == packet_error))
@@ -1323,6 +1331,13 @@ dispatch_command_return do_command(THD *thd, bool blocking)
   /* Do not rely on my_net_read, extra safety against programming errors. */
   packet[packet_length]= '\0';                  /* safety */
 
+  /*
+    A pipelining client does not wait for this reply before sending the next
+    command. If that command is already here, keep the reply buffered so that
+    the replies to the whole batch are sent with as few writes as possible.
+  */
+  if (thd->client_capabilities & MARIADB_CLIENT_PIPELINE)
+    thd->defer_reply_flush= net_has_unread_data(net);
 
   command= fetch_command(thd, packet);
 
@@ -1426,6 +1441,20 @@ dispatch_command_return do_command(THD *thd, bool blocking)
   DBUG_ASSERT(!thd->apc_target.is_enabled());
 
 out:
+  /*
+    Send the replies held back for a pipelined batch before the connection
+    waits for more input or is closed. Commands such as COM_STMT_CLOSE have
+    no reply of their own, so this cannot be left to the last command.
+  */
+  if (unlikely(net->write_pos != net->buff) &&
+      (thd->client_capabilities & MARIADB_CLIENT_PIPELINE) &&
+      return_value != DISPATCH_COMMAND_WOULDBLOCK &&
+      (return_value == DISPATCH_COMMAND_CLOSE_CONNECTION ||
+       !net_has_unread_data(net)))
+  {
+    thd->defer_reply_flush= false;
+    (void) net_flush(net);
+  }
   thd->lex->restore_set_statement_var();
   /* The statement instrumentation must be closed in all cases. */
   DBUG_ASSERT(thd->m_digest == NULL);
@@ -2484,7 +2513,7 @@ dispatch_command_return dispatch_command(enum enum_server_command command, THD *
     Unlink it now, before freeing the root.
   */
   thd->lex->m_sql_cmd= NULL;
-  free_root(thd->mem_root,MYF(MY_KEEP_PREALLOC));
+  thd->free_query_mem_root();
   DBUG_EXECUTE_IF("print_allocated_thread_memory",
                   SAFEMALLOC_REPORT_MEMORY(sf_malloc_dbug_id()););
 
@@ -112,6 +112,8 @@ static int get_part_iter_for_interval_cols_via_map(partition_info *, bool,
           uint32 *, uchar *, uchar *, uint, uint, uint, PARTITION_ITERATOR *);
 static int get_part_iter_for_interval_via_walking(partition_info *, bool,
           uint32 *, uchar *, uchar *, uint, uint, uint, PARTITION_ITERATOR *);
+static int get_part_iter_for_interval_vers_current(partition_info *, bool,
+          uint32 *, uchar *, uchar *, uint, uint, uint, PARTITION_ITERATOR *);
 static int cmp_rec_and_tuple(part_column_list_val *val, uint32 nvals_in_rec);
 static int cmp_rec_and_tuple_prune(part_column_list_val *val,
                                    uint32 n_vals_in_rec,
@@ -8105,6 +8107,7 @@ void make_used_partitions_str(MEM_ROOT *alloc,
     (1) get_part_iter_for_interval_via_mapping
     (2) get_part_iter_for_interval_cols_via_map 
     (3) get_part_iter_for_interval_via_walking
+    (4) get_part_iter_for_interval_vers_current
 
     They all have limited applicability:
     (1) is applicable for "PARTITION BY <RANGE|LIST>(func(t.field))", where
@@ -8114,6 +8117,8 @@ void make_used_partitions_str(MEM_ROOT *alloc,
 
     (3) is applicable for 
       "[SUB]PARTITION BY <any-partitioning-type>(any_func(t.integer_field))"
+
+    (4) is applicable for "PARTITION BY SYSTEM_TIME" without INTERVAL
       
     If both (1) and (3) are applicable, (1) is preferred over (3).
     
@@ -8135,7 +8140,11 @@ static void set_up_range_analysis_info(partition_info *part_info)
   switch (part_info->part_type) {
   case VERSIONING_PARTITION:
     if (!part_info->vers_info->interval.is_set())
-      break;
+    {
+      part_info->get_part_iter_for_interval=
+        get_part_iter_for_interval_vers_current;
+      goto setup_subparts;
+    }
     /* Fall through */
   case RANGE_PARTITION:
   case LIST_PARTITION:
@@ -8756,6 +8765,68 @@ static int get_part_iter_for_interval_via_mapping(partition_info *part_info,
 }
 
 
+/**
+  Partitioning Interval Analysis: Initialize the iterator for a table that
+  is partitioned BY SYSTEM_TIME without INTERVAL
+
+  The history partitions of such a table are filled by LIMIT or by
+  rotating them by hand, so they have no row_end ranges to map the
+  interval on. But all their rows have a row_end below the maximum,
+  while the current partition holds exactly the rows with the maximum
+  row_end. So a query on the current data is pruned to the current
+  partition, and a query on the history to the history partitions.
+
+  @return Status of iterator
+    @retval 0   No matching partitions (iterator not initialized)
+    @retval 1   Ok, iterator intialized for traversal of matching partitions.
+*/
+
+static int get_part_iter_for_interval_vers_current(partition_info *part_info,
+                        bool is_subpart,
+                        uint32 *store_length_array, /* ignored */
+                        uchar *min_value, uchar *max_value,
+                        uint min_len, uint max_len, /* ignored */
+                        uint flags,
+                        PARTITION_ITERATOR *part_iter)
+{
+  Field *field= part_info->part_field_array[STAT_TRX_END];
+  uint field_len= field->pack_length_in_rec();
+  uint32 now_id= part_info->vers_info->now_part->id;
+  bool history= true, current= true;
+  DBUG_ENTER("get_part_iter_for_interval_vers_current");
+  DBUG_ASSERT(!is_subpart);
+  DBUG_ASSERT(now_id == part_info->num_parts - 1);
+  DBUG_ASSERT(!field->real_maybe_null());
+  (void) store_length_array;
+  (void) min_len;
+  (void) max_len;
+  part_iter->ret_null_part= part_iter->ret_null_part_orig= FALSE;
+  part_iter->ret_default_part= part_iter->ret_default_part_orig= FALSE;
+
+  if (!(flags & NO_MIN_RANGE))
+  {
+    store_key_image_to_rec(field, min_value, field_len);
+    if (field->is_max())
+    {
+      history= false;
+      if (flags & NEAR_MIN)
+        current= false;
+    }
+  }
+  if (!(flags & NO_MAX_RANGE))
+  {
+    store_key_image_to_rec(field, max_value, field_len);
+    if ((flags & NEAR_MAX) || !field->is_max())
+      current= false;
+  }
+
+  part_iter->part_nums.start= part_iter->part_nums.cur= history ? 0 : now_id;
+  part_iter->part_nums.end= current ? now_id + 1 : now_id;
+  part_iter->get_next= get_next_partition_id_range;
+  DBUG_RETURN(part_iter->part_nums.start < part_iter->part_nums.end);
+}
+
+
 /* See get_part_iter_for_interval_via_walking for definition of what this is */
 #define MAX_RANGE_TO_WALK 32
 
@@ -218,6 +218,7 @@ class Prepared_statement: public Statement
   inline bool is_sql_prepare() const { return flags & (uint) IS_SQL_PREPARE; }
   void set_sql_prepare() { flags|= (uint) IS_SQL_PREPARE; }
   bool prepare(const char *packet, uint packet_length);
+  bool is_prepared_as(THD *thd, const LEX_CSTRING *query_arg) const;
   bool execute_loop(String *expanded_query,
                     bool open_cursor,
                     uchar *packet_arg, uchar *packet_end_arg);
@@ -239,6 +240,7 @@ class Prepared_statement: public Statement
   sql_mode_t m_sql_mode;
   THD::used_t m_prepare_time_thd_used_flags;
   uint m_prepare_time_charset_collation_map_version;
+  CHARSET_INFO *m_prepare_time_collation_connection;
   bool check_charset_collation_map_version(THD *thd,
                                            Reprepare_observer *observer)
   {
@@ -2724,7 +2726,11 @@ void mysql_sql_stmt_prepare(THD *thd)
       DBUG_VOID_RETURN;
     }
 
-    stmt->deallocate();
+    if (!thd->variables.prepared_stmt_reuse)
+    {
+      stmt->deallocate();
+      stmt= NULL;
+    }
   }
 
   /*
@@ -2732,12 +2738,33 @@ void mysql_sql_stmt_prepare(THD *thd)
     See comments in get_dynamic_sql_string().
   */
   StringBuffer<256> buffer;
-  if (lex->prepared_stmt.get_dynamic_sql_string(thd, &query, &buffer) ||
-      ! (stmt= new Prepared_statement(thd)))
+  if (lex->prepared_stmt.get_dynamic_sql_string(thd, &query, &buffer))
   {
-    DBUG_VOID_RETURN;                           /* out of memory */
+    if (stmt)
+      stmt->deallocate();
+    DBUG_VOID_RETURN;
   }
 
+  if (stmt)
+  {
+    /*
+      With prepared_stmt_reuse, preparing the same text again keeps the
+      statement. A change of the tables it uses is still detected, and
+      the statement is reprepared, when it is executed.
+    */
+    if (stmt->is_prepared_as(thd, &query))
+    {
+      status_var_increment(thd->status_var.com_stmt_prepare);
+      thd->session_tracker.state_change.mark_as_changed(thd);
+      my_ok(thd, 0L, 0L, "Statement prepared");
+      DBUG_VOID_RETURN;
+    }
+    stmt->deallocate();
+  }
+
+  if (! (stmt= new Prepared_statement(thd)))
+    DBUG_VOID_RETURN;                           /* out of memory */
+
   stmt->set_sql_prepare();
 
   /* Set the name first, insert should know that this statement has a name */
@@ -3894,7 +3921,8 @@ Prepared_statement::Prepared_statement(THD *thd_arg)
   read_types(0),
   m_sql_mode(thd->variables.sql_mode),
   m_prepare_time_thd_used_flags(0),
-  m_prepare_time_charset_collation_map_version(0)
+  m_prepare_time_charset_collation_map_version(0),
+  m_prepare_time_collation_connection(NULL)
 {
   init_sql_alloc(key_memory_prepared_statement_main_mem_root,
                  &main_mem_root, thd_arg->variables.query_alloc_block_size,
@@ -4289,10 +4317,39 @@ bool Prepared_statement::prepare(const char *packet, uint packet_len)
   m_prepare_time_thd_used_flags= thd->used;
   m_prepare_time_charset_collation_map_version=
     thd->variables.character_set_collations.version();
+  m_prepare_time_collation_connection= thd->variables.collation_connection;
   DBUG_RETURN(error);
 }
 
 
+/**
+  Check if preparing the query now would give this statement again.
+
+  @param thd        current thread
+  @param query_arg  text of the statement to prepare
+
+  @return true if the query text and the character set it is in, the
+          current database, sql_mode and collation_connection are those
+          the statement was prepared with
+*/
+
+bool Prepared_statement::is_prepared_as(THD *thd,
+                                        const LEX_CSTRING *query_arg) const
+{
+  const LEX_CSTRING *cur_db= &thd->db;
+  return query_length() == query_arg->length &&
+         !memcmp(query(), query_arg->str, query_arg->length) &&
+         query_charset() == thd->charset() &&
+         m_sql_mode == thd->variables.sql_mode &&
+         m_prepare_time_collation_connection ==
+           thd->variables.collation_connection &&
+         m_prepare_time_charset_collation_map_version ==
+           thd->variables.character_set_collations.version() &&
+         db.length == cur_db->length &&
+         (!db.length || !memcmp(db.str, cur_db->str, db.length));
+}
+
+
 /**
   Assign parameter values either from variables, in case of SQL PS
   or from the execute packet.
@@ -4875,6 +4932,9 @@ Prepared_statement::swap_prepared_statement(Prepared_statement *copy)
   swap_variables(THD::used_t,
                  m_prepare_time_thd_used_flags,
                  copy->m_prepare_time_thd_used_flags);
+  swap_variables(CHARSET_INFO *,
+                 m_prepare_time_collation_connection,
+                 copy->m_prepare_time_collation_connection);
 
   DBUG_ASSERT(param_count == copy->param_count);
   DBUG_ASSERT(thd == copy->thd);
@@ -1449,7 +1449,9 @@ gtid_find_binlog_pos(slave_connection_state *state, char *out_name,
                      bool *found_in_index, uint32 *out_start_seek)
 {
   MEM_ROOT memroot;
-  binlog_file_entry *list;
+  binlog_file_entry *list, **files;
+  uint32 n_files= 0, lo, hi, i, checked, found_count;
+  int res;
   Gtid_list_log_event *glev= NULL;
   const char *errormsg= NULL;
   Gtid_index_reader_hot *reader= NULL;
@@ -1464,95 +1466,148 @@ gtid_find_binlog_pos(slave_connection_state *state, char *out_name,
     goto end;
   }
 
+  for (binlog_file_entry *e= list; e; e= e->next)
+    ++n_files;
+  if (!(files= (binlog_file_entry **)
+        alloc_root(&memroot, n_files * sizeof(*files))))
+  {
+    errormsg= "Out of memory while looking for GTID position in binlog";
+    goto end;
+  }
+  for (i= 0; list; list= list->next)
+    files[i++]= list;
+
   if (opt_binlog_gtid_index)
     reader= new Gtid_index_reader_hot();
 
-  while (list)
+  /*
+    The list is newest first, and once a file is old enough to contain the
+    slave position, so are normally all files before it. Rather than check
+    the files one by one, which means opening thousands of them for a slave
+    that is far behind, first check files 0, 1, 3, 7, ... until one is not
+    too new, and then binary search the files between that one and the last
+    one that was too new. A slave close to the head still needs just one
+    check. Should the states in the files not be ordered, the file picked
+    is still one that contains the position, just maybe not the newest.
+  */
+  lo= 0;
+  hi= n_files;
+  checked= n_files;
+  for (i= 0; i < n_files; i= 2 * i + 1)
   {
-    uint32 found_count;
-    int res= gtid_check_binlog_file(state, reader, list, found_in_index,
-                                    out_start_seek, &found_count,
-                                    out_name, &glev, &errormsg);
+    if (glev)
+    {
+      delete glev;
+      glev= NULL;
+    }
+    checked= i;
+    res= gtid_check_binlog_file(state, reader, files[i], found_in_index,
+                                out_start_seek, &found_count,
+                                out_name, &glev, &errormsg);
     if (res < 0)
       goto end;
     if (res == 0)
     {
-      if (*found_in_index || glev)
-      {
-        uint32 i;
-        uint32 count;
-        rpl_gtid *gtids;
+      hi= i;
+      break;
+    }
+    lo= i + 1;
+  }
+  while (lo < hi || (lo < n_files && checked != lo))
+  {
+    i= lo < hi ? lo + (hi - lo) / 2 : lo;
+    if (glev)
+    {
+      delete glev;
+      glev= NULL;
+    }
+    checked= i;
+    res= gtid_check_binlog_file(state, reader, files[i], found_in_index,
+                                out_start_seek, &found_count,
+                                out_name, &glev, &errormsg);
+    if (res < 0)
+      goto end;
+    if (res == 0)
+      hi= i;
+    else
+      lo= i + 1;
+  }
+
+  if (lo < n_files)
+  {
+    if (*found_in_index || glev)
+    {
+      uint32 count;
+      rpl_gtid *gtids;
 
-        if (*found_in_index)
+      if (*found_in_index)
+      {
+        count= found_count;
+        gtids= reader->search_gtid_list();
+        /*
+          Load the initial GTID state corresponding to the position found in
+          the GTID index, as we will not have a GTID_LIST event to load it
+          from.
+        */
+        until_binlog_state->load(gtids, count);
+      }
+      else
+      {
+        count= glev->count;
+        gtids= glev->list;
+      }
+      /*
+        As a special case, we allow to start from binlog file N if the
+        requested GTID is the last event (in the corresponding domain) in
+        binlog file (N-1), but then we need to remove that GTID from the slave
+        state, rather than skipping events waiting for it to turn up.
+
+        If slave is doing START SLAVE UNTIL, check for any UNTIL conditions
+        that are already included in a previous binlog file. Delete any such
+        from the UNTIL hash, to mark that such domains have already reached
+        their UNTIL condition.
+      */
+      for (i= 0; i < count; ++i)
+      {
+        const rpl_gtid *gtid= state->find(gtids[i].domain_id);
+        if (!gtid)
         {
-          count= found_count;
-          gtids= reader->search_gtid_list();
           /*
-            Load the initial GTID state corresponding to the position found in
-            the GTID index, as we will not have a GTID_LIST event to load it
-            from.
+            Contains_all_slave_gtid() returns false if there is any domain in
+            Gtid_list_event which is not in the requested slave position.
+
+            We may delete a domain from the slave state inside this loop, but
+            we only do this when it is the very last GTID logged for that
+            domain in earlier binlogs, and then we can not encounter it in any
+            further GTIDs in the Gtid_list.
           */
-          until_binlog_state->load(gtids, count);
-        }
-        else
+          DBUG_ASSERT(0);
+        } else if (gtid->server_id == gtids[i].server_id &&
+                   gtid->seq_no == gtids[i].seq_no)
         {
-          count= glev->count;
-          gtids= glev->list;
+          /*
+            The slave requested to start from the very beginning of this
+            domain in this binlog file. So delete the entry from the state,
+            we do not need to skip anything.
+          */
+          state->remove(gtid);
         }
-        /*
-          As a special case, we allow to start from binlog file N if the
-          requested GTID is the last event (in the corresponding domain) in
-          binlog file (N-1), but then we need to remove that GTID from the slave
-          state, rather than skipping events waiting for it to turn up.
-
-          If slave is doing START SLAVE UNTIL, check for any UNTIL conditions
-          that are already included in a previous binlog file. Delete any such
-          from the UNTIL hash, to mark that such domains have already reached
-          their UNTIL condition.
-        */
-        for (i= 0; i < count; ++i)
-        {
-          const rpl_gtid *gtid= state->find(gtids[i].domain_id);
-          if (!gtid)
-          {
-            /*
-              Contains_all_slave_gtid() returns false if there is any domain in
-              Gtid_list_event which is not in the requested slave position.
-
-              We may delete a domain from the slave state inside this loop, but
-              we only do this when it is the very last GTID logged for that
-              domain in earlier binlogs, and then we can not encounter it in any
-              further GTIDs in the Gtid_list.
-            */
-            DBUG_ASSERT(0);
-          } else if (gtid->server_id == gtids[i].server_id &&
-                     gtid->seq_no == gtids[i].seq_no)
-          {
-            /*
-              The slave requested to start from the very beginning of this
-              domain in this binlog file. So delete the entry from the state,
-              we do not need to skip anything.
-            */
-            state->remove(gtid);
-          }
 
-          if (until_gtid_state &&
-              (gtid= until_gtid_state->find(gtids[i].domain_id)) &&
-              gtid->server_id == gtids[i].server_id &&
-              gtid->seq_no <= gtids[i].seq_no)
-          {
-            /*
-              We've already reached the stop position in UNTIL for this domain,
-              since it is before the start position.
-            */
-            until_gtid_state->remove(gtid);
-          }
+        if (until_gtid_state &&
+            (gtid= until_gtid_state->find(gtids[i].domain_id)) &&
+            gtid->server_id == gtids[i].server_id &&
+            gtid->seq_no <= gtids[i].seq_no)
+        {
+          /*
+            We've already reached the stop position in UNTIL for this domain,
+            since it is before the start position.
+          */
+          until_gtid_state->remove(gtid);
         }
       }
-
-      goto end;
     }
-    list= list->next;
+
+    goto end;
   }
 
   /* We reached the end without finding anything. */
@@ -3173,6 +3228,15 @@ void mysql_binlog_send(THD* thd, char* log_ident, my_off_t pos,
       info->error= ER_MASTER_FATAL_ERROR_READING_BINLOG;
       goto err;
     }
+#ifndef _WIN32
+    /*
+      A dump thread reads the binlog strictly front to back, and a slave that
+      is catching up reads files that are no longer in the page cache. Ask
+      for more aggressive read-ahead, so that fewer of the small reads done
+      through the IO_CACHE end up waiting for the disk.
+    */
+    (void) posix_fadvise(file, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
 
     if (send_format_descriptor_event(info, &log, &linfo, pos))
     {
@@ -4507,6 +4571,9 @@ bool mysql_show_binlog_events(THD* thd)
 
     thd->set_current_linfo(&linfo);
 
+    if (binary_log->is_relay_log)
+      binary_log->flush_relay_log_buffer();
+
     if ((file=open_binlog(&log, linfo.log_file_name, &errmsg)) < 0)
       goto err;
 
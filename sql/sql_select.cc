@@ -2726,6 +2726,47 @@ JOIN::optimize_inner()
 }
 
 
+/**
+  Pass the LIMIT of a full-text search ordered by its relevance to the engine
+
+  @details
+    When the only table is read by a full-text search, the WHERE condition
+    is the MATCH function itself and the result is ordered by the same
+    MATCH in descending order, only the documents of the highest relevance
+    can be part of the result. The engine is then allowed to read no more
+    documents than the limit; the result is still sorted by filesort.
+*/
+
+static void set_fulltext_limit(JOIN *join)
+{
+  SELECT_LEX *select_lex= join->select_lex;
+  ORDER *order= join->order;
+
+  if (join->table_count != 1 || join->const_tables ||
+      join->join_tab->type != JT_FT || !join->conds ||
+      !order || order->next || order->direction != ORDER::ORDER_DESC ||
+      join->group_list || join->select_distinct || join->having ||
+      select_lex->with_sum_func || select_lex->have_window_funcs() ||
+      select_lex->with_rownum || join->unit->lim.is_with_ties() ||
+      join->select_limit == HA_POS_ERROR)
+    return;
+
+  Item *cond= join->conds;
+  Item *item= (*order->item)->real_item();
+  if (cond->type() != Item::FUNC_ITEM ||
+      ((Item_func*) cond)->functype() != Item_func::FT_FUNC ||
+      item->type() != Item::FUNC_ITEM ||
+      ((Item_func*) item)->functype() != Item_func::FT_FUNC ||
+      !cond->eq(item, true))
+    return;
+
+  Item_func_match *match= (Item_func_match*) cond;
+  if (match->master)
+    match= match->master;
+  match->ft_limit= join->select_limit;
+}
+
+
 int JOIN::optimize_stage2()
 {
   ulonglong select_opts_for_readinfo;
@@ -3280,8 +3321,11 @@ int JOIN::optimize_stage2()
 
   /* Perform FULLTEXT search before all regular searches */
   if (!(select_options & SELECT_DESCRIBE))
+  {
+    set_fulltext_limit(this);
     if (init_ftfuncs(thd, select_lex, MY_TEST(order)))
       DBUG_RETURN(1);
+  }
 
   /*
     It's necessary to check const part of HAVING cond as
@@ -4213,6 +4257,23 @@ bool JOIN::make_aggr_tables_info()
 
       if (unit->lim.is_with_ties())
         sort_tab->filesort->limit= HA_POS_ERROR;
+
+      /*
+        When the sorted table is a temporary table filled by end_write(),
+        rows that can not be among the first 'limit' ones need not be
+        written to it at all.
+      */
+      if (sort_tab->filesort->limit != HA_POS_ERROR &&
+          sort_tab->filesort->limit > 0 &&
+          sort_tab->aggr && !group_list && !select_distinct &&
+          !tmp_table_param.sum_func_count &&
+          !select_lex->have_window_funcs() && !thd->lex->with_rownum &&
+          !(select_options & (OPTION_FOUND_ROWS | SELECT_DESCRIBE)) &&
+          !(sort_tab->filesort->select && sort_tab->filesort->select->cond))
+      {
+        sort_tab->filesort->top_n=
+          new (thd->mem_root) Filesort_top_n(sort_tab->filesort->limit);
+      }
     }
     if (!only_const_tables() &&
         !join_tab[const_tables].filesort &&
@@ -4310,6 +4371,19 @@ JOIN::create_postjoin_aggr_table(JOIN_TAB *tab, List<Item> *table_fields,
 
   if (!(tab->tmp_table_param= new TMP_TABLE_PARAM(tmp_table_param)))
     DBUG_RETURN(true);
+  /*
+    Without grouping or DISTINCT every row of the join is written to the
+    first temporary table, so the join cardinality is a usable estimate
+    of its size.
+  */
+  if (aggr_tables == 1 && !group_list && !distinct &&
+      !select_lex->with_sum_func)
+  {
+    double rows= join_record_count;
+    if (table_rows_limit != HA_POS_ERROR)
+      set_if_smaller(rows, (double) table_rows_limit);
+    tab->tmp_table_param->expected_rows= rows;
+  }
   if (tmp_table_keep_current_rowid)
     add_fields_for_current_rowid(tab, table_fields);
   tab->tmp_table_param->skip_create_table= true;
@@ -4657,6 +4731,8 @@ JOIN::reinit()
         continue;
       tmp_table->file->extra(HA_EXTRA_RESET_STATE);
       tmp_table->file->ha_delete_all_rows();
+      if (curr_tab->filesort && curr_tab->filesort->top_n)
+        curr_tab->filesort->top_n->reset();
     }
   }
   clear_sj_tmp_tables(this);
@@ -5336,6 +5412,10 @@ mysql_select(THD *thd, TABLE_LIST *tables, List<Item> &fields, COND *conds,
   /* Look for a table owned by an engine with the select_handler interface */
   select_lex->pushdown_select= find_single_select_handler(thd, select_lex);
 
+  if (free_join && !select_lex->pushdown_select &&
+      join->exec_pk_lookup(&exec_error))
+    goto err;
+
   if ((err= join->optimize()))
   {
     goto err;					// 1
@@ -5376,6 +5456,150 @@ mysql_select(THD *thd, TABLE_LIST *tables, List<Item> &fields, COND *conds,
 }
 
 
+/**
+  Check if the select is a point lookup by the primary key
+
+  Executions of prepared statements of the form
+
+    SELECT <expressions> FROM t WHERE pk = <constant or parameter>
+
+  where pk is a primary key with one key part, read the row with one
+  handler call in exec_pk_lookup(). The statement is already parsed and
+  its names resolved, so this leaves out only the join optimizer, which
+  would find the same plan: one const table.
+
+  @return the value that the primary key is compared with, or NULL if
+          the select is not such a lookup
+*/
+
+Item *JOIN::pk_lookup_value()
+{
+  TABLE_LIST *tbl;
+  TABLE *table;
+  KEY *key_info;
+  Item_func *eq;
+  Item *field_item, *value;
+
+  if (!thd->stmt_arena->is_stmt_execute() ||
+      thd->lex->sql_command != SQLCOM_SELECT ||
+      thd->lex->describe || thd->lex->analyze_stmt ||
+      thd->lex->limit_rows_examined || thd->trace_started() ||
+      (select_options & (SELECT_DESCRIBE | SELECT_DISTINCT)) ||
+      procedure || group_list || order || having ||
+      select_lex->with_sum_func || select_lex->have_window_funcs() ||
+      select_lex->ftfunc_list->elements ||
+      select_lex->limit_params.explicit_limit || select_lex->with_rownum ||
+      select_lex->outer_select() || select_lex->first_inner_unit() ||
+      unit->is_unit_op() || unit->fake_select_lex ||
+      unit->lim.get_offset_limit() || !unit->lim.get_select_limit() ||
+      select_lex->leaf_tables.elements != 1)
+    return NULL;
+
+  tbl= select_lex->leaf_tables.head();
+  if (!(table= tbl->table) || tbl->on_expr || tbl->jtbm_subselect ||
+      tbl->table_function || tbl->embedding || tbl->belong_to_view ||
+      table->s->primary_key == MAX_KEY ||
+      !table->keys_in_use_for_query.is_set(table->s->primary_key))
+    return NULL;
+  key_info= table->key_info + table->s->primary_key;
+  if (key_info->user_defined_key_parts != 1)
+    return NULL;
+
+  if (!conds || conds->type() != Item::FUNC_ITEM ||
+      (eq= (Item_func*) conds)->functype() != Item_func::EQ_FUNC)
+    return NULL;
+  field_item= eq->arguments()[0]->real_item();
+  value= eq->arguments()[1];
+  if (field_item->type() != Item::FIELD_ITEM)
+  {
+    field_item= eq->arguments()[1]->real_item();
+    value= eq->arguments()[0];
+  }
+  if (field_item->type() != Item::FIELD_ITEM ||
+      ((Item_field*) field_item)->field != key_info->key_part[0].field ||
+      !value->const_item() || value->is_expensive() ||
+      (((Item_field*) field_item)->field->
+         can_optimize_keypart_ref((Item_bool_func*) eq, value) !=
+       Data_type_compatibility::OK))
+    return NULL;
+  return value;
+}
+
+
+/**
+  Execute a point lookup by the primary key without optimizing the join
+
+  @param[out] error  Set to 1 if the execution failed
+
+  @retval true   The select was executed
+  @retval false  The select is not a lookup that pk_lookup_value()
+                 accepts, or the value does not convert to a key value
+                 exactly; it has to be optimized and executed normally
+*/
+
+bool JOIN::exec_pk_lookup(bool *error)
+{
+  Item *value;
+  TABLE *table;
+  KEY *key_info;
+  uchar *key;
+  int res;
+  DBUG_ENTER("JOIN::exec_pk_lookup");
+
+  if (!(value= pk_lookup_value()))
+    DBUG_RETURN(false);
+  DBUG_EXECUTE_IF("show_pk_lookup",
+                  push_warning(thd, Sql_condition::WARN_LEVEL_NOTE,
+                               ER_YES, "exec_pk_lookup"););
+
+  table= select_lex->leaf_tables.head()->table;
+  key_info= table->key_info + table->s->primary_key;
+  if (!(key= (uchar*) thd->alloc(key_info->key_length)))
+  {
+    *error= true;
+    DBUG_RETURN(true);
+  }
+  if (value->save_in_field_no_warnings(key_info->key_part[0].field, true) ||
+      value->null_value)
+    DBUG_RETURN(false);
+  key_copy(key, table->record[0], key_info, key_info->key_length);
+
+  THD_STAGE_INFO(thd, stage_executing);
+  *error= true;
+  if (result->prepare2(this) ||
+      result->send_result_set_metadata(fields_list,
+                                       Protocol::SEND_NUM_ROWS |
+                                       Protocol::SEND_EOF))
+    DBUG_RETURN(true);
+
+  send_records= 0;
+  table->null_row= 0;
+  res= table->file->ha_index_read_idx_map(table->record[0],
+                                          table->s->primary_key, key,
+                                          HA_WHOLE_KEY, HA_READ_KEY_EXACT);
+  if (!res)
+  {
+    table->status= 0;
+    thd->inc_examined_row_count_fast();
+    /* The key value was converted; check the comparison itself too */
+    if (conds->val_bool() && !thd->is_error())
+    {
+      if (result->send_data_with_check(fields_list, unit, 0) > 0)
+        DBUG_RETURN(true);
+      send_records= 1;
+    }
+  }
+  else if (report_error(table, res) > 0)
+    DBUG_RETURN(true);
+
+  if (thd->is_error())
+    DBUG_RETURN(true);
+  thd->limit_found_rows= send_records;
+  *error= result->send_eof();
+  DBUG_RETURN(true);
+}
+
+
 /**
   Approximate how many records are going to be returned by this table in this
   select with this key.
@@ -10538,6 +10762,95 @@ optimize_straight_join(JOIN *join, table_map remaining_tables)
 }
 
 
+/**
+  Costs of the partial plans of one best_extension_by_limited_search() run,
+  per set of joined tables.
+
+  @details
+  The cost of joining the remaining tables to a partial plan depends on
+  the set of tables in the plan and on its cardinality, not on their
+  order. A partial plan that is not cheaper and does not produce fewer
+  rows than an already expanded one over the same tables can not lead to
+  a better complete plan, so its expansion is skipped. This turns the
+  search over permutations of large joins into something closer to a
+  search over subsets.
+
+  Partial plans are only comparable if the ORDER BY sort cost added for
+  complete plans is the same: whether the first table is sort_by_table
+  is part of the key.
+*/
+
+class Join_prefix_memo
+{
+  struct Entry
+  {
+    table_map tables;
+    table_map sort_first;
+    double read_time;
+    double record_count;
+  };
+  HASH hash;
+  MEM_ROOT root;
+
+public:
+  Join_prefix_memo()
+  {
+    init_sql_alloc(PSI_INSTRUMENT_ME, &root, 4096, 0,
+                   MYF(MY_THREAD_SPECIFIC));
+    my_hash_init(PSI_INSTRUMENT_ME, &hash, &my_charset_bin, 256,
+                 offsetof(Entry, tables), 2 * sizeof(table_map), NULL, NULL,
+                 HASH_THREAD_SPECIFIC);
+  }
+  ~Join_prefix_memo()
+  {
+    my_hash_free(&hash);
+    free_root(&root, MYF(0));
+  }
+  void reset()
+  {
+    my_hash_reset(&hash);
+    free_root(&root, MYF(MY_MARK_BLOCKS_FREE));
+  }
+
+  /**
+    Check if the partial plan over 'tables' is dominated by another one,
+    remember it otherwise
+
+    @retval true   a partial plan over the same tables with lower or equal
+                   cost and cardinality has already been expanded
+    @retval false  the plan should be expanded
+  */
+  bool is_dominated(table_map tables, bool sort_first, double read_time,
+                    double record_count)
+  {
+    Entry key= { tables, (table_map) sort_first, 0, 0 };
+    Entry *entry= (Entry*) my_hash_search(&hash, (uchar*) &key.tables,
+                                          2 * sizeof(table_map));
+    if (entry)
+    {
+      if (entry->read_time <= read_time &&
+          entry->record_count <= record_count)
+        return true;
+      if (entry->read_time >= read_time &&
+          entry->record_count >= record_count)
+      {
+        entry->read_time= read_time;
+        entry->record_count= record_count;
+      }
+      return false;
+    }
+    if ((entry= (Entry*) memdup_root(&root, &key, sizeof(key))))
+    {
+      entry->read_time= read_time;
+      entry->record_count= record_count;
+      if (my_hash_insert(&hash, (uchar*) entry))
+        reset();
+    }
+    return false;
+  }
+};
+
+
 /**
   Find a good, possibly optimal, query execution plan (QEP) by a greedy search.
 
@@ -10613,6 +10926,11 @@ optimize_straight_join(JOIN *join, table_map remaining_tables)
   @param use_cond_selectivity  specifies how the selectivity of the conditions
                           pushed to a table should be taken into account
 
+  @note
+    With optimizer_prune_level=3, partial plans dominated by another one
+    over the same tables are not expanded for joins without semi-joins,
+    see Join_prefix_memo.
+
   @retval
     FALSE       ok
   @retval
@@ -10645,6 +10963,13 @@ greedy_search(JOIN      *join,
                   remaining_tables);
   n_tables= size_remain= my_count_bits(usable_tables);
 
+  Join_prefix_memo prefix_memo;
+  join->prefix_memo= (join->prune_level >= 3 &&
+                      !join->emb_sjm_nest &&
+                      !join->select_lex->sj_nests.elements &&
+                      !join->limit_optimization_mode) ?
+                     &prefix_memo : NULL;
+
   join->next_sort_position= join->sort_positions;
   do {
     /*
@@ -10654,13 +10979,18 @@ greedy_search(JOIN      *join,
       an embedded table is depending on an outer table.
     */
     join->best_read= DBL_MAX;
+    if (join->prefix_memo)
+      join->prefix_memo->reset();
     if ((int) best_extension_by_limited_search(join, remaining_tables, idx,
                                                record_count,
                                                read_time, search_depth,
                                                use_cond_selectivity,
                                                &eq_ref_tables) <
         (int) SEARCH_OK)
+    {
+      join->prefix_memo= NULL;
       DBUG_RETURN(TRUE);
+    }
     /*
       'best_read < DBL_MAX' means that optimizer managed to find
       some plan and updated 'best_positions' array accordingly.
@@ -10676,6 +11006,7 @@ greedy_search(JOIN      *join,
       DBUG_EXECUTE("opt", print_plan(join, n_tables,
                                      record_count, read_time, read_time,
                                      "optimal"););
+      join->prefix_memo= NULL;
       DBUG_RETURN(FALSE);
     }
 
@@ -12217,6 +12548,22 @@ best_extension_by_limited_search(JOIN      *join,
       if ((search_depth > 1) && (remaining_tables & ~real_table_bit) &
           allowed_tables)
       {
+        if (join->prefix_memo &&
+            join->prefix_memo->is_dominated(remaining_tables &
+                                            ~real_table_bit,
+                                            join->sort_by_table &&
+                                            join->sort_by_table ==
+                                            join->positions[join->const_tables].
+                                            table->table,
+                                            current_read_time,
+                                            partial_join_cardinality))
+        {
+          trace_one_table.add("pruned_by_memo", true);
+          restore_prev_nj_state(s);
+          restore_prev_sj_state(remaining_tables, s, idx);
+          continue;
+        }
+
         /* Recursively expand the current partial plan */
         Json_writer_array trace_rest(thd, "rest_of_plan");
 
@@ -21977,6 +22324,32 @@ bool Create_tmp_table::add_fields(THD *thd,
 }
 
 
+/*
+  Check if a temporary table is expected to hold far more rows than fit
+  in memory. Such a table would be converted to disk after being filled
+  up, which costs a copy of all rows written so far, so it is better to
+  create it on disk from the start. The estimate has to exceed the limit
+  by a wide margin, as row estimates can be far off.
+*/
+
+static bool tmp_table_expected_to_overflow(THD *thd, TABLE_SHARE *share,
+                                           TMP_TABLE_PARAM *param)
+{
+  ulonglong memory;
+  uint row_size;
+
+  if (param->expected_rows <= 0 ||
+      thd->variables.tmp_memory_table_size == ~(ulonglong) 0)
+    return false;
+  memory= MY_MIN(thd->variables.tmp_memory_table_size,
+                 thd->variables.max_heap_table_size);
+  /* Same row size estimate as get_tmp_table_costs() */
+  row_size= share->reclength + sizeof(char*) * 2;
+  row_size= MY_ALIGN(MY_MAX(row_size, sizeof(char*)) + 1, sizeof(char*));
+  return param->expected_rows > 2 * (memory / (double) row_size);
+}
+
+
 bool Create_tmp_table::choose_engine(THD *thd, TABLE *table,
                                      TMP_TABLE_PARAM *param)
 {
@@ -21985,13 +22358,18 @@ bool Create_tmp_table::choose_engine(THD *thd, TABLE *table,
   /*
     If result table is small; use a heap, otherwise TMP_TABLE_HTON (Aria)
     In the future we should try making storage engine selection more dynamic
+    Heap stores blobs, but can't have them in a key, so blobs are only
+    allowed in a heap table that will not get a group or distinct key.
   */
 
-  if (share->blob_fields || m_using_unique_constraint ||
+  if ((share->blob_fields && (m_group || m_distinct)) ||
+      m_using_unique_constraint ||
       (thd->variables.big_tables &&
        !(m_select_options & SELECT_SMALL_RESULT)) ||
       (m_select_options & TMP_TABLE_FORCE_MYISAM) ||
-      thd->variables.tmp_memory_table_size == 0)
+      thd->variables.tmp_memory_table_size == 0 ||
+      (!(m_select_options & SELECT_SMALL_RESULT) &&
+       tmp_table_expected_to_overflow(thd, share, param)))
   {
     share->db_plugin= ha_lock_engine(0, TMP_ENGINE_HTON);
     table->file= get_new_handler(share, &table->mem_root,
@@ -22938,10 +23316,20 @@ bool create_internal_tmp_table(TABLE *table, KEY *org_keyinfo,
     we first write the row, then check for key conflicts and then we have to
     delete the row.  The cases when this can happen is when there is
     a group by and no sum functions or if distinct is used.
+    A table without keys whose columns can't be packed takes no more
+    space in STATIC_RECORD than in BLOCK_RECORD, so we use STATIC_RECORD
+    for it whatever the row length. Such a table is written through the
+    write cache and scanned through the read cache in large blocks,
+    without the bitmap and page cache overhead of BLOCK_RECORD.
   */
   {
+    bool fixed_rows= !share->blob_fields && !share->keys;
+    for (TMP_ENGINE_COLUMNDEF *column= start_recinfo;
+         fixed_rows && column < *recinfo; column++)
+      fixed_rows= column->type == FIELD_NORMAL;
     enum data_file_type file_type= table->no_rows ? NO_RECORD :
-        (share->reclength < 64 && !share->blob_fields ? STATIC_RECORD :
+        ((share->reclength < 64 && !share->blob_fields) || fixed_rows ?
+         STATIC_RECORD :
          table->used_for_duplicate_elimination ? DYNAMIC_RECORD : BLOCK_RECORD);
     uint create_flags= HA_CREATE_TMP_TABLE | HA_CREATE_INTERNAL_TABLE |
         (table->keep_row_order ? HA_PRESERVE_INSERT_ORDER : 0);
@@ -24148,6 +24536,272 @@ sub_select(JOIN *join,JOIN_TAB *join_tab,bool end_of_records)
   DBUG_RETURN(rc);
 }
 
+/* Rows to check before a filter that rejects too little is disabled */
+static const ulonglong INT_FILTER_SAMPLE_ROWS= 1024;
+
+/**
+  Compare two integers with their signedness taken into account
+*/
+
+static inline int int_filter_cmp(longlong a, bool a_unsigned,
+                                 longlong b, bool b_unsigned)
+{
+  if (a_unsigned != b_unsigned)
+  {
+    if (!a_unsigned && a < 0)
+      return -1;
+    if (!b_unsigned && b < 0)
+      return 1;
+    a_unsigned= true;
+  }
+  if (a_unsigned)
+    return (ulonglong) a < (ulonglong) b ? -1 : (ulonglong) a > (ulonglong) b;
+  return a < b ? -1 : a > b;
+}
+
+
+/**
+  Compile an atom of Int_column_filter from a predicate
+
+  @param thd    thread handle
+  @param table  the table whose columns can be filtered
+  @param func   the predicate
+
+  @return the atom, or NULL if the predicate is not of a supported form
+*/
+
+Int_column_filter::Atom *
+Int_column_filter::make_atom(THD *thd, TABLE *table, Item_func *func)
+{
+  Op op;
+  bool swap= false;
+  switch (func->functype()) {
+  case Item_func::EQ_FUNC: op= EQ; break;
+  case Item_func::NE_FUNC: op= NE; break;
+  case Item_func::LT_FUNC: op= LT; break;
+  case Item_func::LE_FUNC: op= LE; break;
+  case Item_func::GT_FUNC: op= GT; break;
+  case Item_func::GE_FUNC: op= GE; break;
+  case Item_func::BETWEEN:
+  case Item_func::IN_FUNC:
+    if (((Item_func_opt_neg*) func)->negated)
+      return NULL;
+    op= func->functype() == Item_func::BETWEEN ? BETWEEN : IN;
+    break;
+  default:
+    return NULL;
+  }
+
+  Item **args= func->arguments();
+  uint n_args= func->argument_count();
+  if (n_args < 2 || (op == BETWEEN && n_args != 3))
+    return NULL;
+  if (op < BETWEEN && n_args == 2 &&
+      args[1]->real_item()->type() == Item::FIELD_ITEM &&
+      args[0]->real_item()->type() != Item::FIELD_ITEM)
+  {
+    /* constant op column */
+    static const Op swapped[]= { EQ, NE, GT, GE, LT, LE };
+    op= swapped[op];
+    swap= true;
+  }
+
+  Item *col= args[swap ? 1 : 0]->real_item();
+  if (col->type() != Item::FIELD_ITEM)
+    return NULL;
+  Field *field= ((Item_field*) col)->field;
+  if (field->table != table || field->cmp_type() != INT_RESULT)
+    return NULL;
+  switch (field->type()) {
+  case MYSQL_TYPE_TINY:
+  case MYSQL_TYPE_SHORT:
+  case MYSQL_TYPE_INT24:
+  case MYSQL_TYPE_LONG:
+  case MYSQL_TYPE_LONGLONG:
+    break;
+  default:
+    return NULL;
+  }
+
+  Atom *atom= thd->alloc<Atom>(1);
+  Value *values= thd->alloc<Value>(n_args - 1);
+  if (!atom || !values)
+    return NULL;
+  atom->field= field;
+  atom->op= op;
+  atom->length= field->pack_length();
+  atom->is_unsigned= ((Field_num*) field)->unsigned_flag;
+  atom->values= values;
+  atom->n_values= 0;
+
+  for (uint i= 0; i < n_args; i++)
+  {
+    if (i == (swap ? 1U : 0U))
+      continue;
+    Item *arg= args[i];
+    if (!arg->const_item() || arg->is_expensive() ||
+        arg->cmp_type() != INT_RESULT)
+      return NULL;
+    longlong value= arg->val_int();
+    if (arg->null_value)
+    {
+      /* NULL in an IN list can be ignored, otherwise the result is NULL */
+      if (op == IN)
+        continue;
+      return NULL;
+    }
+    values[atom->n_values].value= value;
+    values[atom->n_values].is_unsigned= arg->unsigned_flag;
+    atom->n_values++;
+  }
+  return atom->n_values ? atom : NULL;
+}
+
+
+/**
+  Collect the atoms of Int_column_filter from the top-level conjuncts
+  of a condition
+
+  @return true on out of memory
+*/
+
+bool Int_column_filter::add_atoms(THD *thd, TABLE *table, Item *cond,
+                                  List<Atom> *list)
+{
+  if (cond->type() == Item::COND_ITEM &&
+      ((Item_cond*) cond)->functype() == Item_func::COND_AND_FUNC)
+  {
+    List_iterator_fast<Item> it(*((Item_cond*) cond)->argument_list());
+    while (Item *item= it++)
+      if (add_atoms(thd, table, item, list))
+        return true;
+    return false;
+  }
+  if (cond->type() != Item::FUNC_ITEM)
+    return false;
+  Atom *atom= make_atom(thd, table, (Item_func*) cond);
+  return atom && list->push_back(atom, thd->mem_root);
+}
+
+
+/**
+  Compile a filter for the rows of a table from a condition
+
+  @param thd    thread handle
+  @param table  the table whose columns can be filtered
+  @param cond   the condition attached to the table
+
+  @return the filter, or NULL if cond has no conjuncts of a supported form
+*/
+
+Int_column_filter *Int_column_filter::create(THD *thd, TABLE *table,
+                                             Item *cond)
+{
+  List<Atom> list;
+  if (add_atoms(thd, table, cond, &list) || list.is_empty())
+    return NULL;
+
+  Int_column_filter *filter= new (thd->mem_root) Int_column_filter;
+  if (!filter || !(filter->atoms= thd->alloc<Atom>(list.elements)))
+    return NULL;
+  filter->n_atoms= 0;
+  List_iterator_fast<Atom> it(list);
+  while (Atom *atom= it++)
+    filter->atoms[filter->n_atoms++]= *atom;
+  filter->n_checked= filter->n_rejected= 0;
+  filter->disabled= false;
+  return filter;
+}
+
+
+inline bool Int_column_filter::check_atom(const Atom &atom)
+{
+  const Field *field= atom.field;
+  if (field->is_null())
+    return false;
+
+  const uchar *ptr= field->ptr;
+  longlong v;
+  switch (atom.length) {
+  case 1: v= atom.is_unsigned ? (longlong) *ptr : (longlong) (int8) *ptr; break;
+  case 2: v= atom.is_unsigned ? (longlong) uint2korr(ptr) : sint2korr(ptr); break;
+  case 3: v= atom.is_unsigned ? (longlong) uint3korr(ptr) : sint3korr(ptr); break;
+  case 4: v= atom.is_unsigned ? (longlong) uint4korr(ptr) : sint4korr(ptr); break;
+  default: v= sint8korr(ptr);
+  }
+
+  const Value *val= atom.values;
+  switch (atom.op) {
+  case EQ:
+    return !int_filter_cmp(v, atom.is_unsigned, val->value, val->is_unsigned);
+  case NE:
+    return int_filter_cmp(v, atom.is_unsigned, val->value, val->is_unsigned);
+  case LT:
+    return int_filter_cmp(v, atom.is_unsigned, val->value, val->is_unsigned) < 0;
+  case LE:
+    return int_filter_cmp(v, atom.is_unsigned, val->value, val->is_unsigned) <= 0;
+  case GT:
+    return int_filter_cmp(v, atom.is_unsigned, val->value, val->is_unsigned) > 0;
+  case GE:
+    return int_filter_cmp(v, atom.is_unsigned, val->value, val->is_unsigned) >= 0;
+  case BETWEEN:
+    return int_filter_cmp(v, atom.is_unsigned,
+                          val[0].value, val[0].is_unsigned) >= 0 &&
+      int_filter_cmp(v, atom.is_unsigned, val[1].value, val[1].is_unsigned) <= 0;
+  case IN:
+    for (uint i= 0; i < atom.n_values; i++)
+      if (!int_filter_cmp(v, atom.is_unsigned,
+                          val[i].value, val[i].is_unsigned))
+        return true;
+    return false;
+  }
+  return true;
+}
+
+
+bool Int_column_filter::check()
+{
+  if (disabled)
+    return true;
+
+  bool pass= true;
+  for (uint i= 0; i < n_atoms; i++)
+  {
+    if (!check_atom(atoms[i]))
+    {
+      pass= false;
+      break;
+    }
+  }
+
+  n_rejected+= !pass;
+  if (++n_checked == INT_FILTER_SAMPLE_ROWS)
+  {
+    /* The filter only adds work if the conjuncts reject few rows */
+    disabled= n_rejected < INT_FILTER_SAMPLE_ROWS / 8;
+  }
+  return pass;
+}
+
+
+/**
+  Check the current row of the table against the integer column filter
+  compiled from select_cond.
+
+  @retval false  the row does not satisfy select_cond
+  @retval true   select_cond must be evaluated for the row
+*/
+
+bool JOIN_TAB::check_int_filter()
+{
+  if (int_filter_cond != select_cond)
+  {
+    int_filter_cond= select_cond;
+    int_filter= Int_column_filter::create(join->thd, table, select_cond);
+  }
+  return !int_filter || int_filter->check();
+}
+
 /**
   @brief Process one row of the nested loop join.
 
@@ -24191,7 +24845,8 @@ evaluate_join_record(JOIN *join, JOIN_TAB *join_tab,
 
   if (select_cond)
   {
-    select_cond_result= MY_TEST(select_cond->val_bool());
+    select_cond_result= join_tab->check_int_filter() &&
+                        MY_TEST(select_cond->val_bool());
 
     /* check for errors evaluating the condition */
     if (unlikely(join->thd->is_error()))
@@ -25200,9 +25855,18 @@ join_read_first(JOIN_TAB *tab)
     DBUG_ASSERT(tab->sorted);
     DBUG_ASSERT(order);
     DBUG_ASSERT(order->next == NULL);
+    /*
+      A condition on this table only can be checked during the vector
+      search, so that LIMIT nearest rows are found among matching rows
+    */
+    Item *cond= tab->select_cond;
+    if (cond && ((cond->used_tables() & ~(table->map |
+                                          tab->join->const_table_map)) ||
+                 cond->is_expensive()))
+      cond= NULL;
     tab->read_record.read_record_func= join_hlindex_read_next;
     error= tab->table->hlindex_read_first(tab->index, *order->item,
-                                          tab->join->select_limit);
+                                          tab->join->select_limit, cond);
   }
   else
   {
@@ -25698,6 +26362,9 @@ end_write(JOIN *join, JOIN_TAB *join_tab __attribute__((unused)),
       int error;
       join->found_records++;
       join->accepted_rows++;
+      if (join_tab->filesort && join_tab->filesort->top_n &&
+          join_tab->filesort->top_n->is_worse(join_tab))
+        goto end;
       if ((error= table->file->ha_write_tmp_row(table->record[0])))
       {
         if (likely(!table->file->is_fatal_error(error, HA_CHECK_DUP)))
@@ -25731,6 +26398,27 @@ end_write(JOIN *join, JOIN_TAB *join_tab __attribute__((unused)),
 }
 
 
+/**
+  Write back the group that end_update() has kept in table->record[1]
+
+  @return true on error
+*/
+
+static bool end_update_flush_group(TABLE *table, TMP_TABLE_PARAM *param)
+{
+  int error;
+  param->hot_group= false;
+  if (unlikely((error= table->file->ha_update_tmp_row(param->hot_group_buff +
+                                                      param->group_length,
+                                                      table->record[1]))))
+  {
+    table->file->print_error(error,MYF(0));	/* purecov: inspected */
+    return true;
+  }
+  return false;
+}
+
+
 /*
   @brief
     Perform GROUP BY operation over rows coming in arbitrary order: use
@@ -25752,6 +26440,10 @@ end_write(JOIN *join, JOIN_TAB *join_tab __attribute__((unused)),
   @detail
     Also applies HAVING, etc.
 
+    Consecutive rows of the same group are accumulated in table->record[1]
+    and the group is written back only when a row of another group comes,
+    or at the end, to save an index lookup and a row update per row.
+
   @seealso end_unique_update()
 */
 
@@ -25760,12 +26452,17 @@ end_update(JOIN *join, JOIN_TAB *join_tab __attribute__((unused)),
 	   bool end_of_records)
 {
   TABLE *const table= join_tab->table;
+  TMP_TABLE_PARAM *const param= join_tab->tmp_table_param;
   ORDER   *group;
   int	  error;
   DBUG_ENTER("end_update");
 
   if (end_of_records)
+  {
+    if (param->hot_group && end_update_flush_group(table, param))
+      DBUG_RETURN(NESTED_LOOP_ERROR);            /* purecov: inspected */
     DBUG_RETURN(NESTED_LOOP_OK);
+  }
 
   join->found_records++;
   copy_fields(join_tab->tmp_table_param);	// Groups are copied twice.
@@ -25787,11 +26484,40 @@ end_update(JOIN *join, JOIN_TAB *join_tab __attribute__((unused)),
     if (item->maybe_null())
       group->buff[-1]= (char) group->field->is_null();
   }
+  if (param->hot_group)
+  {
+    if (!memcmp(param->hot_group_buff, param->group_buff,
+                param->group_length))
+    {						/* Same group as last time */
+      restore_record(table,record[1]);
+      update_tmptable_sum_func(join->sum_funcs,table);
+      store_record(table,record[1]);
+      goto end;
+    }
+    if (end_update_flush_group(table, param))
+      DBUG_RETURN(NESTED_LOOP_ERROR);            /* purecov: inspected */
+  }
   if (!table->file->ha_index_read_map(table->record[1],
-                                      join_tab->tmp_table_param->group_buff,
+                                      param->group_buff,
                                       HA_WHOLE_KEY,
                                       HA_READ_KEY_EXACT))
   {						/* Update old record */
+    if (!table->s->blob_fields &&
+        (param->hot_group_buff ||
+         (param->hot_group_buff=
+          (uchar*) join->thd->alloc(param->group_length +
+                                    table->s->reclength))))
+    {
+      /* Keep the group in record[1] until a row of another group comes */
+      memcpy(param->hot_group_buff + param->group_length, table->record[1],
+             table->s->reclength);
+      restore_record(table,record[1]);
+      update_tmptable_sum_func(join->sum_funcs,table);
+      store_record(table,record[1]);
+      memcpy(param->hot_group_buff, param->group_buff, param->group_length);
+      param->hot_group= true;
+      goto end;
+    }
     restore_record(table,record[1]);
     update_tmptable_sum_func(join->sum_funcs,table);
     if (unlikely((error= table->file->ha_update_tmp_row(table->record[1],
@@ -27854,8 +28580,8 @@ JOIN_TAB::remove_duplicates()
   table->file->info(HA_STATUS_VARIABLE);
   table->reginfo.lock_type=TL_WRITE;
 
-  if (table->s->db_type() == heap_hton ||
-      (!table->s->blob_fields &&
+  if (!table->s->blob_fields &&
+      (table->s->db_type() == heap_hton ||
        ((ALIGN_SIZE(keylength) + HASH_OVERHEAD) * table->file->stats.records <
 	thd->variables.sortbuff_size)))
     error= remove_dup_with_hash_index(join->thd, table, field_count,
@@ -33151,6 +33877,8 @@ AGGR_OP::prepare_tmp_table()
   JOIN *join= join_tab->join;
   int rc= 0;
 
+  /* A previous execution may have stopped with a group kept by end_update() */
+  join_tab->tmp_table_param->hot_group= false;
   if (!join_tab->table->is_created())
   {
     if (instantiate_tmp_table(table, join_tab->tmp_table_param->keyinfo,
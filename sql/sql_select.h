@@ -250,6 +250,59 @@ class Filesort;
 struct SplM_plan_info;
 class SplM_opt_info;
 
+/**
+  A filter over the integer columns of a table, compiled from the simple
+  top-level conjuncts of a pushed down condition:
+
+    column {=|<>|<|<=|>|>=} constant,
+    column BETWEEN constant AND constant,
+    column IN (constant, ...).
+
+  The filter reads the column values right from the record buffer of the
+  table, so that the rows rejected by these conjuncts are discarded by a
+  tight loop before the Item tree of the condition is evaluated.
+  The rows that pass the filter must still be checked by the condition.
+*/
+
+class Int_column_filter :public Sql_alloc
+{
+  enum Op { EQ, NE, LT, LE, GT, GE, BETWEEN, IN };
+  struct Value
+  {
+    longlong value;
+    bool is_unsigned;
+  };
+  struct Atom
+  {
+    Field *field;
+    Op op;
+    uint length;
+    bool is_unsigned;
+    /* 1 value for comparisons, 2 for BETWEEN, any number for IN */
+    uint n_values;
+    Value *values;
+  };
+
+  Atom *atoms;
+  uint n_atoms;
+  /* Rows checked and rejected, to give up on filters that reject little */
+  ulonglong n_checked, n_rejected;
+  bool disabled;
+
+  static bool add_atoms(THD *thd, TABLE *table, Item *cond, List<Atom> *list);
+  static Atom *make_atom(THD *thd, TABLE *table, Item_func *func);
+  static inline bool check_atom(const Atom &atom);
+
+public:
+  static Int_column_filter *create(THD *thd, TABLE *table, Item *cond);
+
+  /**
+    @retval false  the current row of the table does not satisfy the condition
+    @retval true   the row may satisfy the condition
+  */
+  bool check();
+};
+
 typedef struct st_join_table {
   TABLE		*table;
   TABLE_LIST    *tab_list;
@@ -269,6 +322,10 @@ typedef struct st_join_table {
     NULL means no index condition pushdown was performed.
   */
   Item          *pre_idx_push_select_cond;
+  /* Filter compiled from int_filter_cond, or NULL */
+  Int_column_filter *int_filter;
+  /* The select_cond for which int_filter has been compiled */
+  Item          *int_filter_cond;
   /*
     Pointer to the associated ON expression. on_expr_ref=!NULL except for
     degenerate joins. 
@@ -594,6 +651,7 @@ typedef struct st_join_table {
   void clear_range_rowid_filter();
 
   void cleanup();
+  bool check_int_filter();
   inline bool is_using_loose_index_scan()
   {
     const SQL_SELECT *sel= get_sql_select();
@@ -1474,6 +1532,11 @@ class JOIN :public Sql_alloc
     optimizer_extra_pruning_depth)
   */
   bool extra_heuristic_pruning;
+  /*
+    Costs of the partial plans considered for each set of tables, used by
+    greedy_search() for joins of many tables. NULL if not used.
+  */
+  class Join_prefix_memo *prefix_memo;
 #ifndef DBUG_OFF
   void dbug_verify_sj_inner_tables(uint n_positions) const;
   int dbug_join_tab_array_size;
@@ -1777,6 +1840,8 @@ class JOIN :public Sql_alloc
   int init_execution();
   int exec() __attribute__((warn_unused_result));
   int exec_inner();
+  Item *pk_lookup_value();
+  bool exec_pk_lookup(bool *error);
   bool prepare_result(List<Item> **columns_list);
   int destroy();
   void restore_tmp();
@@ -568,11 +568,20 @@ bool sequence_insert(THD *thd, LEX *lex, TABLE_LIST *org_table_list)
 
 /* Create a SQUENCE object */
 
-SEQUENCE::SEQUENCE() :all_values_used(0), initialized(SEQ_UNINTIALIZED)
+SEQUENCE::SEQUENCE() :all_values_used(0), initialized(SEQ_UNINTIALIZED),
+  generation(0)
 {
   mysql_rwlock_init(key_LOCK_SEQUENCE, &mutex);
 }
 
+/** Source of SEQUENCE::generation, unique over all sequence objects */
+static Atomic_counter<ulonglong> sequence_generations;
+
+void SEQUENCE::new_generation()
+{
+  generation= ++sequence_generations;
+}
+
 SEQUENCE::~SEQUENCE()
 {
   mysql_rwlock_destroy(&mutex);
@@ -752,6 +761,7 @@ int SEQUENCE::read_stored_values(TABLE *table)
   adjust_values(reserved_until);
 
   all_values_used= 0;
+  new_generation();
   thd->pop_internal_handler();
   DBUG_RETURN(0);
 }
@@ -896,55 +906,29 @@ int sequence_definition::write(TABLE *table, bool all_fields)
 }
 
 
-/**
-   Get next value for sequence
-
-   @param in   table  Sequence table
-   @param in   second_round
-                      1 if recursive call (out of values once)
-   @param out  error  Set this to <> 0 in case of error
-                      push_warning_printf(WARN_LEVEL_WARN) has been called
-
-
-   @retval     0      Next number or error. Check error variable
-               #      Next sequence number
-
-   NOTES:
-     Return next_free_value and increment next_free_value to next allowed
-     value or reserved_value if out of range
-     if next_free_value >= reserved_value reserve a new range by writing
-     a record to the sequence table.
-
-  The state of the variables:
-    next_free_value contains next value to use. It may be
-    bigger than max_value or less than min_value if end of sequence.
-    reserved_until contains the last value written to the file. All
-    values up to this one can be used.
-    If next_free_value >= reserved_until we have to reserve new
-    values from the sequence.
+/*
+  Get next value for the sequence, with the sequence write locked.
+  second_round is 1 for the recursive call after running out of values
+  once. In case of an error *error is set to ER_SEQUENCE_RUN_OUT, for
+  which no error has been given yet, or to the error from writing the
+  sequence table.
 */
 
-longlong SEQUENCE::next_value(TABLE *table, bool second_round, int *error)
+longlong SEQUENCE::next_value_low(TABLE *table, bool second_round,
+                                  int *error)
 {
   longlong res_value, org_reserved_until, add_to;
   bool out_of_values;
   THD *thd= table->in_use;
-  DBUG_ENTER("SEQUENCE::next_value");
   DBUG_ASSERT(thd);
 
   *error= 0;
-  if (!second_round)
-    write_lock(table);
-
   res_value= next_free_value;
   next_free_value= increment_value(next_free_value, real_increment);
 
   if (within_bound(res_value, reserved_until, reserved_until,
                     real_increment > 0))
-  {
-    write_unlock(table);
-    DBUG_RETURN(res_value);
-  }
+    return res_value;
 
   if (all_values_used)
     goto err;
@@ -972,7 +956,7 @@ longlong SEQUENCE::next_value(TABLE *table, bool second_round, int *error)
       We have to do everything again to ensure that the given range was
       not empty, which could happen if increment == 0
     */
-    DBUG_RETURN(next_value(table, 1, error));
+    return next_value_low(table, 1, error);
   }
 
   if (unlikely((*error= write(table,
@@ -982,17 +966,93 @@ longlong SEQUENCE::next_value(TABLE *table, bool second_round, int *error)
     reserved_until= org_reserved_until;
     next_free_value= res_value;
   }
+  return res_value;
 
+err:
+  *error= ER_SEQUENCE_RUN_OUT;
+  all_values_used= 1;
+  return 0;
+}
+
+
+/**
+   Get next value for sequence
+
+   @param in   table  Sequence table
+   @param out  error  Set this to <> 0 in case of error
+                      push_warning_printf(WARN_LEVEL_WARN) has been called
+
+
+   @retval     0      Next number or error. Check error variable
+               #      Next sequence number
+
+   NOTES:
+     Return next_free_value and increment next_free_value to next allowed
+     value or reserved_value if out of range
+     if next_free_value >= reserved_value reserve a new range by writing
+     a record to the sequence table.
+
+  The state of the variables:
+    next_free_value contains next value to use. It may be
+    bigger than max_value or less than min_value if end of sequence.
+    reserved_until contains the last value written to the file. All
+    values up to this one can be used.
+    If next_free_value >= reserved_until we have to reserve new
+    values from the sequence.
+*/
+
+longlong SEQUENCE::next_value(TABLE *table, int *error)
+{
+  longlong res_value;
+  DBUG_ENTER("SEQUENCE::next_value");
+
+  write_lock(table);
+  res_value= next_value_low(table, 0, error);
   write_unlock(table);
+
+  if (*error == ER_SEQUENCE_RUN_OUT)
+    my_error(ER_SEQUENCE_RUN_OUT, MYF(0), table->s->db.str,
+             table->s->table_name.str);
   DBUG_RETURN(res_value);
+}
 
-err:
+
+/*
+  Reserve the next values of the sequence with one lock of the sequence
+
+  @param in   table   Sequence table
+  @param out  values  The values, in the order next_value() would return
+                      them
+  @param in   count   Number of values wanted
+  @param out  error   Set to <> 0 if no value could be reserved
+
+  @return     Number of values stored in values. A shorter count than
+              wanted means that the sequence ran out of values or the
+              sequence table could not be written; this is reported by
+              the next call.
+*/
+
+uint SEQUENCE::next_values(TABLE *table, longlong *values, uint count,
+                           int *error)
+{
+  uint i;
+  DBUG_ENTER("SEQUENCE::next_values");
+
+  write_lock(table);
+  for (i= 0; i < count; i++)
+  {
+    values[i]= next_value_low(table, 0, error);
+    if (*error)
+      break;
+  }
   write_unlock(table);
-  my_error(ER_SEQUENCE_RUN_OUT, MYF(0), table->s->db.str,
-           table->s->table_name.str);
-  *error= ER_SEQUENCE_RUN_OUT;
-  all_values_used= 1;
-  DBUG_RETURN(0);
+
+  if (i)
+    *error= 0;
+  else if (*error == ER_SEQUENCE_RUN_OUT)
+    my_error(ER_SEQUENCE_RUN_OUT, MYF(0), table->s->db.str,
+             table->s->table_name.str);
+  DBUG_RETURN(i);
 }
 
 
@@ -1016,6 +1076,63 @@ void SEQUENCE_LAST_VALUE::set_version(TABLE *table)
   memcpy(table_version, table->s->tabledef_version.str, MY_UUID_SIZE);
 }
 
+
+/**
+   Get next value for sequence for this session
+
+   With sequence_session_cache > 0 the session reserves that many values
+   with one lock of the sequence and returns them one by one without
+   locking it. The values that different sessions get are then unique
+   but not increasing in the order they were asked for.
+
+   The unused values are discarded if the sequence was re-created,
+   altered or reset with SETVAL() since they were reserved.
+
+   @param in   table  Sequence table
+   @param out  error  Set this to <> 0 in case of error
+
+   @retval     0      Next number or error. Check error variable
+               #      Next sequence number
+*/
+
+longlong SEQUENCE_LAST_VALUE::next_value(TABLE *table, int *error)
+{
+  SEQUENCE *seq= table->s->sequence;
+  const uint size= (uint) table->in_use->variables.sequence_session_cache;
+  DBUG_ENTER("SEQUENCE_LAST_VALUE::next_value");
+
+  if (size > 1 && cached_pos < cached_count && !check_version(table) &&
+      cached_generation == seq->generation)
+  {
+    *error= 0;
+    DBUG_RETURN(cached_values[cached_pos++]);
+  }
+  cached_pos= cached_count= 0;
+
+  if (size <= 1)
+    DBUG_RETURN(seq->next_value(table, error));
+
+  if (size != cached_size)
+  {
+    longlong *values;
+    if (!(values= (longlong*) my_realloc(PSI_INSTRUMENT_ME, cached_values,
+                                         size * sizeof *values,
+                                         MYF(MY_WME | MY_ALLOW_ZERO_PTR))))
+    {
+      *error= HA_ERR_OUT_OF_MEM;
+      DBUG_RETURN(0);
+    }
+    cached_values= values;
+    cached_size= size;
+  }
+
+  cached_generation= seq->generation;
+  if (!(cached_count= seq->next_values(table, cached_values, size, error)))
+    DBUG_RETURN(0);
+  cached_pos= 1;
+  DBUG_RETURN(cached_values[0]);
+}
+
 /**
    Set the next value for sequence
 
@@ -1093,6 +1210,8 @@ int SEQUENCE::set_value(TABLE *table, longlong next_val, ulonglong next_round,
       goto end;
     }
   }
+  /* Values reserved by the sessions may be below the new value */
+  new_generation();
   error= 0;
 
 end:
@@ -36,6 +36,7 @@
 
 #include "mysql_com.h"
 #include "sql_type_int.h"
+#include "my_atomic_wrapper.h"
 
 class Create_field;
 class Type_handler;
@@ -149,15 +150,25 @@ class SEQUENCE :public sequence_definition
     sequence_definition::operator= (*seq);
     adjust_values(reserved_until);
     all_values_used= 0;
+    new_generation();
   }
-  longlong next_value(TABLE *table, bool second_round, int *error);
+  longlong next_value(TABLE *table, int *error);
+  uint next_values(TABLE *table, longlong *values, uint count, int *error);
   int set_value(TABLE *table, longlong next_value, ulonglong round_arg,
                 bool is_used);
 
   bool all_values_used;
   seq_init initialized;
+  /**
+    Changed when the values that next_value() returns are reset by
+    ALTER SEQUENCE or SETVAL(). Values that a session reserved before
+    are discarded then.
+  */
+  Atomic_relaxed<ulonglong> generation;
 
 private:
+  void new_generation();
+  longlong next_value_low(TABLE *table, bool second_round, int *error);
   /**
     Check that a value is within a relevant bound
 
@@ -268,16 +279,30 @@ class SEQUENCE_LAST_VALUE
     :key(key_arg), length(length_arg)
   {}
   ~SEQUENCE_LAST_VALUE()
-  { my_free((void*) key); }
+  {
+    my_free((void*) key);
+    my_free(cached_values);
+  }
   /* Returns 1 if table hasn't been dropped or re-created */
   bool check_version(TABLE *table);
   void set_version(TABLE *table);
+  longlong next_value(TABLE *table, int *error);
 
   const uchar *key;
   uint length;
   bool null_value;
   longlong value;
   uchar table_version[MY_UUID_SIZE];
+
+private:
+  /*
+    Values reserved from the sequence for this session
+    (sequence_session_cache), of which the first cached_pos are used
+  */
+  longlong *cached_values= nullptr;
+  uint cached_size= 0, cached_count= 0, cached_pos= 0;
+  /* SEQUENCE::generation when the values were reserved */
+  ulonglong cached_generation= 0;
 };
 
 extern bool check_sequence_fields(LEX *lex, List<Create_field> *fields,
@@ -68,6 +68,7 @@
 #endif
 #include "transaction.h"
 #include "opt_trace.h"
+#include "opt_cost_feedback.h"
 #include "my_cpu.h"
 #include "key.h"
 #include "vector_mhnsw.h"
@@ -4084,6 +4085,8 @@ uint calc_sum_of_all_status(STATUS_VAR *to)
   DBUG_ENTER("calc_sum_of_all_status");
 
   to->local_memory_used= 0;
+  /* "to" is a copy of global_status_var, which lacks this part */
+  to->global_memory_used+= global_memory_used_counter;
   /* Add to this status from existing threads */
   server_threads.iterate(calc_sum_callback, &arg);
   DBUG_RETURN(arg.count);
@@ -9454,7 +9457,6 @@ bool optimize_schema_tables_memory_usage(List<TABLE_LIST> &tables)
       store_record(table, s->default_values);
       p->recinfo= to_recinfo;
 
-      // TODO switch from Aria to Memory if all blobs were optimized away?
       if (instantiate_tmp_table(table, p->keyinfo, p->start_recinfo, &p->recinfo,
                    table_list->select_lex->options | thd->variables.option_bits))
         DBUG_RETURN(1);
@@ -10646,6 +10648,8 @@ namespace Show {
 
 /** For creating fields of information_schema.OPTIMIZER_TRACE */
 extern ST_FIELD_INFO optimizer_trace_info[];
+/** For creating fields of information_schema.OPTIMIZER_COST_FEEDBACK */
+extern ST_FIELD_INFO optimizer_cost_feedback_info[];
 
 } //namespace Show
 
@@ -10724,6 +10728,9 @@ ST_SCHEMA_TABLE schema_tables[]=
    fill_open_tables, make_old_format, 0, -1, -1, 1, 0},
   {"OPTIMIZER_COSTS"_Lex_ident_i_s_table, Show::optimizer_costs_fields_info, 0,
    fill_optimizer_costs_tables, 0, 0, -1,-1, 0, 0},
+  {"OPTIMIZER_COST_FEEDBACK"_Lex_ident_i_s_table,
+   Show::optimizer_cost_feedback_info, 0,
+   fill_optimizer_cost_feedback, 0, 0, -1, -1, 0, 0},
   {"OPTIMIZER_TRACE"_Lex_ident_i_s_table, Show::optimizer_trace_info, 0,
      fill_optimizer_trace_info, NULL, NULL, -1, -1, false, 0},
   {"PARAMETERS"_Lex_ident_i_s_table, Show::parameters_fields_info, 0,
@@ -34,6 +34,8 @@
 #include "sql_show.h"
 #include "sql_partition.h"
 #include "sql_alter.h"                          // RENAME_STAT_PARAMS
+#include "sql_parse.h"                          // mysql_parse
+#include "sql_connect.h"                        // server_threads
 
 #include <vector>
 #include <string>
@@ -2791,12 +2793,20 @@ int collect_statistics_for_table(THD *thd, TABLE *table)
 
   restore_record(table, s->default_values);
 
-  /* Perform a full table scan to collect statistics on 'table's columns */
-  if (!(rc= file->ha_rnd_init(TRUE)))
+  /*
+    Let the engine read a sample of its pages if it can, otherwise perform
+    a full table scan to collect statistics on 'table's columns
+  */
+  bool sample_pages= sample_fraction < 1 &&
+    thd->variables.analyze_sample_method == ANALYZE_SAMPLE_PAGES &&
+    !file->sample_init(&sample_fraction);
+  if (sample_pages || !(rc= file->ha_rnd_init(TRUE)))
   {
     DEBUG_SYNC(table->in_use, "statistics_collection_start");
 
-    while ((rc= file->ha_rnd_next(table->record[0])) != HA_ERR_END_OF_FILE)
+    while ((rc= sample_pages ? file->sample_next(table->record[0])
+                             : file->ha_rnd_next(table->record[0])) !=
+           HA_ERR_END_OF_FILE)
     {
       if (thd->killed)
         break;
@@ -2804,7 +2814,7 @@ int collect_statistics_for_table(THD *thd, TABLE *table)
       if (rc)
         break;
 
-      if (thd_rnd(thd) <= sample_fraction)
+      if (sample_pages || thd_rnd(thd) <= sample_fraction)
       {
         for (field_ptr= table->field; *field_ptr; field_ptr++)
         {
@@ -2819,7 +2829,10 @@ int collect_statistics_for_table(THD *thd, TABLE *table)
         rows++;
       }
     }
-    file->ha_rnd_end();
+    if (sample_pages)
+      file->sample_end();
+    else
+      file->ha_rnd_end();
   }
   rc= (rc == HA_ERR_END_OF_FILE && !thd->killed) ? 0 : 1;
 
@@ -4197,6 +4210,215 @@ double get_column_avg_frequency(Field * field)
 } 
 
 
+/*
+  A request to collect a histogram for a column in the background,
+  see histogram_auto_collect_request()
+*/
+
+struct Histogram_collect_request
+{
+  Histogram_collect_request *next;
+  LEX_CSTRING db;
+  LEX_CSTRING table_name;
+  LEX_CSTRING column_name;
+};
+
+extern PSI_thread_key key_thread_histogram_collect;
+
+/*
+  Requests waiting for the histogram collector thread, oldest first, and
+  whether the thread is running. Both are protected by LOCK_histogram_collect.
+*/
+static Histogram_collect_request *histogram_collect_queue;
+static bool histogram_collect_running;
+
+
+/**
+  @brief
+  Collect a histogram for a column on the histogram collector thread
+
+  @details
+  The function runs
+    ANALYZE TABLE db.t PERSISTENT FOR COLUMNS (c) INDEXES ()
+  in a THD of its own. The THD is registered in server_threads, so that the
+  statement shows up in the process list and can be killed, also by the
+  server shutdown. The statement is not written to the binary log and lets
+  the server choose the sample size, so that the collection stays cheap on
+  big tables.
+*/
+
+static void bg_histogram_collect(Histogram_collect_request *req)
+{
+  THD *thd= new THD(next_thread_id());
+  thd->thread_stack= (char *) &thd;
+  thd->store_globals();
+  thd->system_thread= SYSTEM_THREAD_GENERIC;
+  thd->security_ctx->skip_grants();
+  thd->set_command(COM_DAEMON);
+  thd->variables.wsrep_on= 0;
+  thd->variables.option_bits&= ~(ulonglong) OPTION_BIN_LOG;
+  thd->variables.sample_percentage= 0;
+
+  StringBuffer<3 * NAME_LEN + 80> query;
+  query.append(STRING_WITH_LEN("ANALYZE TABLE "));
+  append_identifier(thd, &query, &req->db);
+  query.append('.');
+  append_identifier(thd, &query, &req->table_name);
+  query.append(STRING_WITH_LEN(" PERSISTENT FOR COLUMNS ("));
+  append_identifier(thd, &query, &req->column_name);
+  query.append(STRING_WITH_LEN(") INDEXES ()"));
+
+  thd->set_query_and_id((char *) query.c_ptr_safe(), query.length(),
+                        thd->charset(), next_query_id());
+  server_threads.insert(thd);
+  /* A shutdown that started before the insert would not kill the THD */
+  if (!abort_loop)
+  {
+    Parser_state parser_state;
+    if (!parser_state.init(thd, thd->query(), thd->query_length()))
+      mysql_parse(thd, thd->query(), thd->query_length(), &parser_state);
+    if (thd->is_error() && !thd->killed)
+      sql_print_warning("Could not collect a histogram for %s.%s.%s: %s",
+                        req->db.str, req->table_name.str,
+                        req->column_name.str,
+                        thd->get_stmt_da()->message());
+  }
+  thd->reset_query();
+  server_threads.erase(thd);
+  delete thd;
+  my_free(req);
+}
+
+
+/**
+  @brief
+  The histogram collector thread
+
+  @details
+  The thread is started when a histogram is requested and none is running.
+  It serves the requests one at a time, so that at most one ANALYZE runs in
+  the background, and exits when there are no more requests. Requests left
+  at shutdown are dropped.
+*/
+
+static void *histogram_collect_thread(void *)
+{
+  my_thread_init();
+  my_thread_set_name("histogram_collect");
+  for (;;)
+  {
+    mysql_mutex_lock(&LOCK_histogram_collect);
+    Histogram_collect_request *req= histogram_collect_queue;
+    if (!req || abort_loop)
+    {
+      histogram_collect_queue= NULL;
+      histogram_collect_running= false;
+      mysql_mutex_unlock(&LOCK_histogram_collect);
+      while (req)
+      {
+        Histogram_collect_request *next= req->next;
+        my_free(req);
+        req= next;
+      }
+      break;
+    }
+    histogram_collect_queue= req->next;
+    mysql_mutex_unlock(&LOCK_histogram_collect);
+    bg_histogram_collect(req);
+  }
+  my_thread_end();
+  return NULL;
+}
+
+
+/**
+  @brief
+  Queue a request for the histogram collector thread
+
+  @retval false  The request is queued and will be freed by the thread
+  @retval true   The server is shutting down or the thread could not be
+                 started, the request is not queued
+*/
+
+static bool histogram_collect_submit(Histogram_collect_request *req)
+{
+  bool error= false;
+  req->next= NULL;
+  mysql_mutex_lock(&LOCK_histogram_collect);
+  if (abort_loop)
+    error= true;
+  else if (!histogram_collect_running)
+  {
+    pthread_t th;
+    histogram_collect_queue= req;
+    if (mysql_thread_create(key_thread_histogram_collect, &th,
+                            &connection_attrib, histogram_collect_thread,
+                            NULL))
+    {
+      histogram_collect_queue= NULL;
+      error= true;
+    }
+    else
+      histogram_collect_running= true;
+  }
+  else
+  {
+    Histogram_collect_request **last= &histogram_collect_queue;
+    while (*last)
+      last= &(*last)->next;
+    *last= req;
+  }
+  mysql_mutex_unlock(&LOCK_histogram_collect);
+  return error;
+}
+
+
+/**
+  @brief
+  Count a range estimate over a column without a histogram
+
+  @details
+  Once the column has been used in histogram_auto_collect_threshold range
+  estimates a histogram for it is requested from the histogram collector
+  thread. The
+  counter lives in the statistical data shared by all instances of the
+  table, so the request is made once for every version of the statistics.
+  When the histogram has been collected the statistics are reloaded and the
+  column is not counted any more.
+*/
+
+static void histogram_auto_collect_request(Field *field,
+                                           Column_statistics *col_stats)
+{
+  TABLE_SHARE *share= field->table->s;
+  ulong threshold= histogram_auto_collect_threshold;
+
+  if (col_stats->ranges_without_histogram++ != threshold - 1 ||
+      share->tmp_table != NO_TMP_TABLE ||
+      share->table_category != TABLE_CATEGORY_USER)
+    return;
+
+  Histogram_collect_request *req;
+  char *db, *table_name, *column_name;
+  if (!my_multi_malloc(PSI_INSTRUMENT_ME, MYF(MY_WME),
+                       &req, sizeof(*req),
+                       &db, share->db.length + 1,
+                       &table_name, share->table_name.length + 1,
+                       &column_name, field->field_name.length + 1,
+                       NullS))
+    return;
+  strmake(db, share->db.str, share->db.length);
+  strmake(table_name, share->table_name.str, share->table_name.length);
+  strmake(column_name, field->field_name.str, field->field_name.length);
+  req->db= {db, share->db.length};
+  req->table_name= {table_name, share->table_name.length};
+  req->column_name= {column_name, field->field_name.length};
+
+  if (histogram_collect_submit(req))
+    my_free(req);
+}
+
+
 /**
   @brief
   Estimate the number of rows in a column range using data from stat tables 
@@ -4243,6 +4465,10 @@ double get_column_range_cardinality(Field *field,
   if (!table->stats_is_read)
     return tab_records;
 
+  if (histogram_auto_collect_threshold && !col_stats->histogram_exists &&
+      global_system_variables.histogram_size)
+    histogram_auto_collect_request(field, col_stats);
+
   THD *thd= table->in_use;
   double col_nulls= tab_records * col_stats->get_nulls_ratio();
 
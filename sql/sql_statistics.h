@@ -50,6 +50,12 @@ enum enum_histogram_type
   INVALID_HISTOGRAM
 } Histogram_type;
 
+enum enum_analyze_sample_method
+{
+  ANALYZE_SAMPLE_ROWS,
+  ANALYZE_SAMPLE_PAGES
+};
+
 enum enum_stat_tables
 {
   TABLE_STAT,
@@ -510,6 +516,11 @@ class Column_statistics :public Sql_alloc
 public:
   Histogram_base *histogram;
   bool histogram_exists;
+  /*
+    How many times the optimizer has estimated a range over the column
+    while there was no histogram for it, see histogram_auto_collect_threshold
+  */
+  Atomic_counter<uint32> ranges_without_histogram;
 
   uint32 no_values_provided_bitmap()
   {
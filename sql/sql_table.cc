@@ -12195,9 +12195,14 @@ class Has_default_error_handler : public Internal_error_handler
 };
 
 
+/**
+  Apply the row events that were logged since the previous call.
+  @param[out] applied  the size of the applied events in bytes
+*/
 static int online_alter_read_from_binlog(THD *thd, rpl_group_info *rgi,
                                          Cache_flip_event_log *log,
-                                         ha_rows *found_rows)
+                                         ha_rows *found_rows,
+                                         my_off_t *applied)
 {
   int error= 0;
 
@@ -12233,6 +12238,7 @@ static int online_alter_read_from_binlog(THD *thd, rpl_group_info *rgi,
     DEBUG_SYNC(thd, "alter_table_online_progress");
   } while(!error);
   thd->pop_internal_handler();
+  *applied= my_b_tell(log_file);
 
   return MY_TEST(error);
 }
@@ -12320,7 +12326,7 @@ copy_data_between_tables(THD *thd, TABLE *from, TABLE *to,
   bool make_versioned= !from->versioned() && to->versioned();
   bool make_unversioned= from->versioned() && !to->versioned();
   bool keep_versioned= from->versioned() && to->versioned();
-  bool bulk_insert_started= 0;
+  bool bulk_insert_started= 0, hlindex_bulk_started= 0;
   Field *to_row_start= NULL, *to_row_end= NULL, *from_row_end= NULL;
   MYSQL_TIME query_start;
   DBUG_ENTER("copy_data_between_tables");
@@ -12465,6 +12471,16 @@ copy_data_between_tables(THD *thd, TABLE *from, TABLE *to,
   to->file->prepare_for_modify(true, false);
   DBUG_ASSERT(to->file->inited == handler::NONE);
 
+  if (to->s->hlindexes())
+  {
+    if (int err= to->hlindexes_on_bulk_insert_start())
+    {
+      to->file->print_error(err, MYF(0));
+      goto err;
+    }
+    hlindex_bulk_started= 1;
+  }
+
   /* Tell handler that we have values for all columns in the to table */
   to->use_all_columns();
   /* Add virtual columns to vcol_set to ensure they are updated */
@@ -12661,6 +12677,17 @@ copy_data_between_tables(THD *thd, TABLE *from, TABLE *to,
   }
 
   bulk_insert_started= 0;
+  if (hlindex_bulk_started)
+  {
+    hlindex_bulk_started= 0;
+    if (int err= to->hlindexes_on_bulk_insert_end(error > 0))
+    {
+      if (!thd->is_error())
+        to->file->print_error(err, MYF(0));
+      error= 1;
+    }
+  }
+
   if (!ignore && !to->s->hlindexes() && error <= 0)
   {
     int alt_error= to->file->extra(HA_EXTRA_END_ALTER_COPY);
@@ -12709,7 +12736,23 @@ copy_data_between_tables(THD *thd, TABLE *from, TABLE *to,
     mysql_unlock_tables(thd, thd->lock);
     thd->lock= NULL;
 
-    error= online_alter_read_from_binlog(thd, &rgi, binlog, &found_count);
+    /*
+      Catch up without the lock in rounds, while each round has at most
+      half as much to apply as the previous one. The concurrent changes
+      logged during a round are applied in the next, so that only a
+      small remainder is left for the round under the lock.
+    */
+    const uint max_rounds= 8;
+    my_off_t applied, prev_applied= MY_FILEPOS_ERROR;
+    for (uint round= 1;; round++)
+    {
+      error= online_alter_read_from_binlog(thd, &rgi, binlog, &found_count,
+                                           &applied);
+      if (error || !applied || round == max_rounds ||
+          (prev_applied != MY_FILEPOS_ERROR && applied > prev_applied / 2))
+        break;
+      prev_applied= applied;
+    }
     if (start_alter_id)
     {
       DBUG_ASSERT(thd->slave_thread);
@@ -12730,7 +12773,8 @@ copy_data_between_tables(THD *thd, TABLE *from, TABLE *to,
     if (!error)
     {
       thd_progress_next_stage(thd);
-      error= online_alter_read_from_binlog(thd, &rgi, binlog, &found_count);
+      error= online_alter_read_from_binlog(thd, &rgi, binlog, &found_count,
+                                           &applied);
     }
 
     /*
@@ -12785,6 +12829,8 @@ copy_data_between_tables(THD *thd, TABLE *from, TABLE *to,
  err:
   if (bulk_insert_started)
     (void) to->file->ha_end_bulk_insert();
+  if (hlindex_bulk_started)
+    (void) to->hlindexes_on_bulk_insert_end(true);
 
   if (init_read_record_done)
     end_read_record(&info);
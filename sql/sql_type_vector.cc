@@ -17,10 +17,17 @@
 #include "sql_type_vector.h"
 #include "sql_class.h"
 #include "sql_lex.h"
+#include "vector_distance.h"
 
 Named_type_handler<Type_handler_vector> type_handler_vector("vector");
 Type_collection_vector type_collection_vector;
 
+bool Type_handler_vector::is_valid(const char *from, size_t length)
+{
+  return std::isfinite(Vector_float_ops::abs2((const float*)from,
+                                              length / sizeof(float)));
+}
+
 const Type_collection *Type_handler_vector::type_collection() const
 {
   return &type_collection_vector;
@@ -298,6 +298,73 @@ int select_union_recursive::send_data(List<Item> &values)
 }
 
 
+/*
+  @brief
+    Write a record into the result table of a recursive CTE
+
+  @details
+    With UNION DISTINCT every row produced by an iteration is checked
+    against the unique index of the result table, and most rows produced
+    by a graph traversal are duplicates. Once the table no longer fits in
+    memory each such check is a lookup in a disk-based index, so the images
+    of the rows written or found since then are also kept in an in-memory
+    hash, up to max_heap_table_size bytes. A row whose image is found there is a
+    duplicate and is not written at all. A row that is not found is written
+    as usual, as rows with different images may still be equal for the
+    index. Blobs are stored by pointer, so tables with blobs are excluded.
+*/
+
+int select_union_recursive::write_record()
+{
+  size_t length= incr_table->s->reclength;
+  if (seen_rows_state != SEEN_ROWS_OFF &&
+      my_hash_search(&seen_rows, table->record[0], length))
+  {
+    write_err= HA_ERR_FOUND_DUPP_KEY;
+    return -1;
+  }
+
+  int rc= select_unit::write_record();
+  if (rc > 0 || !is_distinct || table->s->blob_fields ||
+      table->s->db_type() == heap_hton || seen_rows_state == SEEN_ROWS_FULL)
+    return rc;
+
+  if (seen_rows_state == SEEN_ROWS_OFF)
+  {
+    init_alloc_root(PSI_INSTRUMENT_ME, &seen_rows_root, 8192, 0,
+                    MYF(MY_THREAD_SPECIFIC));
+    if (my_hash_init(PSI_INSTRUMENT_ME, &seen_rows, &my_charset_bin, 1024,
+                     0, length, NULL, NULL, HASH_UNIQUE))
+    {
+      free_root(&seen_rows_root, MYF(0));
+      seen_rows_state= SEEN_ROWS_FULL;
+      return rc;
+    }
+    seen_rows_state= SEEN_ROWS_ON;
+  }
+
+  uchar *image;
+  if (seen_rows.records * (length + 2 * sizeof(uchar*)) >=
+        thd->variables.max_heap_table_size ||
+      !(image= (uchar*) memdup_root(&seen_rows_root, table->record[0],
+                                    length)) ||
+      my_hash_insert(&seen_rows, image))
+    seen_rows_state= SEEN_ROWS_FULL;            // Keep what is there
+  return rc;
+}
+
+
+void select_union_recursive::reset_seen_rows()
+{
+  if (seen_rows_state != SEEN_ROWS_OFF)
+  {
+    my_hash_free(&seen_rows);
+    free_root(&seen_rows_root, MYF(0));
+    seen_rows_state= SEEN_ROWS_OFF;
+  }
+}
+
+
 bool select_unit::flush()
 {
   int error;
@@ -397,6 +464,7 @@ select_union_recursive::create_result_table(THD *thd_arg,
     return true;
 
   incr_table->keys_in_use_for_query.clear_all();
+  is_distinct= is_union_distinct;
   return false;
 }
 
@@ -901,6 +969,7 @@ bool select_unit_ext::send_eof()
 
 void select_union_recursive::cleanup()
 {
+  reset_seen_rows();
   if (table)
   {
     select_unit::cleanup();
@@ -2620,6 +2689,7 @@ bool st_select_lex_unit::exec_recursive()
 
   if (with_element->level == 0)
   {
+    with_element->rec_result->reset_seen_rows();
     if (!incr_table->is_created() &&
         instantiate_tmp_table(incr_table,
                               tmp_table_param->keyinfo,
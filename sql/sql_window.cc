@@ -22,6 +22,7 @@
 #include "filesort.h"
 #include "sql_base.h"
 #include "sql_window.h"
+#include <deque>
 
 
 bool
@@ -791,6 +792,7 @@ void order_window_funcs_by_window_specs(List<Item_window_func> *win_func_list)
 
 // note: make rr_from_pointers static again when not need it here anymore
 int rr_from_pointers(READ_RECORD *info);
+int rr_from_pointers_in_batches(READ_RECORD *info);
 
 
 /////////////////////////////////////////////////////////////////////////////
@@ -846,6 +848,13 @@ class Rowid_seq_cursor
       cache_pos=   info->cache_pos;
       cache_end=   info->cache_end;
     }
+    else if (info->read_record_func == rr_from_pointers_in_batches)
+    {
+      io_cache= NULL;
+      cache_start= info->ref_cursor;
+      cache_pos=   info->ref_cursor;
+      cache_end=   info->ref_end;
+    }
     else
     {
       //DBUG_ASSERT(info->read_record == rr_from_tempfile);
@@ -2287,6 +2296,201 @@ class Frame_scan_cursor : public Frame_cursor
   }
 };
 
+/*
+  A cursor that computes MIN() or MAX() over a moving frame without
+  rescanning it for every row.
+
+  The frame bounds only move forward, so the candidates for the result are
+  kept in a monotonic deque of row numbers: a row is dropped from the back
+  as soon as a later row with a better or equal value is added, and from
+  the front when it leaves the frame. The front of the deque is then the
+  row holding the result, and each row is added and removed at most once.
+*/
+class Frame_min_max_cursor : public Frame_cursor
+{
+public:
+  Frame_min_max_cursor(THD *thd, Item_sum *sum_func,
+                       const Frame_cursor &top_bound,
+                       const Frame_cursor &bottom_bound) :
+    top_bound(top_bound), bottom_bound(bottom_bound),
+    is_max(sum_func->sum_func() == Item_sum::MAX_FUNC),
+    arg(sum_func->get_arg(0)), cmp(NULL)
+  {
+    if ((new_value= arg->get_cache(thd)) && (back_value= arg->get_cache(thd)))
+    {
+      new_value->setup(thd, arg);
+      back_value->setup(thd, arg);
+      new_value->set_used_tables(RAND_TABLE_BIT);
+      back_value->set_used_tables(RAND_TABLE_BIT);
+      if ((cmp= new (thd->mem_root) Arg_comparator()))
+        cmp->set_cmp_func(thd, sum_func, arg->type_handler_for_comparison(),
+                          (Item**) &new_value, (Item**) &back_value, FALSE);
+    }
+  }
+
+  /* Whether there was enough memory to set up the comparison */
+  bool is_usable() const { return cmp != NULL; }
+
+  void init(READ_RECORD *info) override
+  {
+    cursor.init(info);
+    back_cursor.init(info);
+  }
+
+  void pre_next_partition(ha_rows rownum) override
+  {
+    curr_rownum= rownum;
+    reset(rownum);
+    clear_sum_functions();
+  }
+
+  void next_partition(ha_rows rownum) override
+  {
+    compute_values_for_current_row();
+  }
+
+  void next_row() override
+  {
+    curr_rownum++;
+    compute_values_for_current_row();
+  }
+
+  ha_rows get_curr_rownum() const override
+  {
+    return curr_rownum;
+  }
+
+private:
+  const Frame_cursor &top_bound;
+  const Frame_cursor &bottom_bound;
+  const bool is_max;
+  Item *arg;
+  Item_cache *new_value, *back_value;
+  Arg_comparator *cmp;
+  /* Reads the rows that are added to the frame */
+  Table_read_cursor cursor;
+  /* Reads the rows at the back of the deque and the result row */
+  Table_read_cursor back_cursor;
+  ha_rows curr_rownum;
+  /* The previous top bound of the frame */
+  ha_rows top_rownum;
+  /* The first row that has not been added yet */
+  ha_rows next_rownum;
+  /* The row that the sum function was computed from, or HA_POS_ERROR */
+  ha_rows result_rownum;
+  /* Whether back_value holds the value of the row at the back of rows */
+  bool back_cached;
+  std::deque<ha_rows> rows;
+
+  void reset(ha_rows rownum)
+  {
+    rows.clear();
+    top_rownum= next_rownum= rownum;
+    result_rownum= HA_POS_ERROR;
+    back_cached= false;
+  }
+
+  void clear_result()
+  {
+    if (result_rownum != HA_POS_ERROR)
+    {
+      clear_sum_functions();
+      result_rownum= HA_POS_ERROR;
+    }
+  }
+
+  /* Add the row in the record buffer, whose number is rownum */
+  void add_row(ha_rows rownum)
+  {
+    new_value->store(arg);
+    new_value->cache_value();
+    if (new_value->null_value)
+      return;                                   // MIN/MAX skip NULLs
+
+    while (!rows.empty())
+    {
+      if (!back_cached)
+      {
+        back_cursor.move_to(rows.back());
+        if (back_cursor.fetch())
+          break;
+        back_value->store(arg);
+        back_value->cache_value();
+        back_cached= true;
+      }
+      int res= cmp->compare();
+      if (is_max ? res < 0 : res > 0)
+        break;
+      rows.pop_back();
+      back_cached= false;
+    }
+    rows.push_back(rownum);
+    back_value->store(new_value);
+    back_value->cache_value();
+    back_cached= true;
+  }
+
+  void compute_values_for_current_row()
+  {
+    if (top_bound.is_outside_computation_bounds() ||
+        bottom_bound.is_outside_computation_bounds())
+    {
+      clear_result();
+      return;
+    }
+
+    ha_rows start_rownum= top_bound.get_curr_rownum();
+    ha_rows bottom_rownum= bottom_bound.get_curr_rownum();
+
+    /* Should the frame ever move back, start over from its top */
+    if (start_rownum < top_rownum || bottom_rownum + 1 < next_rownum)
+    {
+      clear_result();
+      reset(start_rownum);
+    }
+    top_rownum= start_rownum;
+    set_if_bigger(next_rownum, start_rownum);
+
+    if (next_rownum <= bottom_rownum)
+    {
+      cursor.move_to(next_rownum);
+      for (; next_rownum <= bottom_rownum; next_rownum++)
+      {
+        if (cursor.fetch()) //EOF
+          break;
+        add_row(next_rownum);
+        if (cursor.next()) // EOF
+        {
+          next_rownum++;
+          break;
+        }
+      }
+    }
+
+    while (!rows.empty() && rows.front() < start_rownum)
+    {
+      rows.pop_front();
+      back_cached= back_cached && !rows.empty();
+    }
+
+    if (rows.empty())
+    {
+      clear_result();
+      return;
+    }
+    if (rows.front() != result_rownum)
+    {
+      clear_sum_functions();
+      result_rownum= HA_POS_ERROR;
+      back_cursor.move_to(rows.front());
+      if (back_cursor.fetch())
+        return;
+      add_value_to_items();
+      result_rownum= rows.front();
+    }
+  }
+};
+
 /* A cursor that follows a target cursor. Each time a new row is added,
    the window functions are cleared and only have the row at which the target
    is point at added to them.
@@ -2759,8 +2963,19 @@ void get_window_functions_required_cursors(
     {
       frame_bottom->set_no_action();
       frame_top->set_no_action();
-      Frame_cursor *scan_cursor= new Frame_scan_cursor(*frame_top,
-                                                       *frame_bottom);
+      Frame_cursor *scan_cursor= NULL;
+      if (sum_func->sum_func() == Item_sum::MIN_FUNC ||
+          sum_func->sum_func() == Item_sum::MAX_FUNC)
+      {
+        Frame_min_max_cursor *min_max_cursor=
+          new Frame_min_max_cursor(thd, sum_func, *frame_top, *frame_bottom);
+        if (min_max_cursor->is_usable())
+          scan_cursor= min_max_cursor;
+        else
+          delete min_max_cursor;
+      }
+      if (!scan_cursor)
+        scan_cursor= new Frame_scan_cursor(*frame_top, *frame_bottom);
       scan_cursor->add_sum_func(sum_func);
       cursor_manager->add_cursor(scan_cursor);
 
@@ -2775,11 +2990,11 @@ void get_window_functions_required_cursors(
 */
 static
 bool save_window_function_values(List<Item_window_func>& window_functions,
-                                 TABLE *tbl, uchar *rowid_buf)
+                                 TABLE *tbl)
 {
   List_iterator_fast<Item_window_func> iter(window_functions);
   JOIN_TAB *join_tab= tbl->reginfo.join_tab;
-  tbl->file->ha_rnd_pos(tbl->record[0], rowid_buf);
+  /* record[0] and the handler are already positioned on the current row */
   store_record(tbl, record[1]);
   while (Item_window_func *item_win= iter++)
     item_win->save_in_field(item_win->result_field, true);
@@ -2875,13 +3090,34 @@ bool compute_window_func(THD *thd,
   while ((cursor_manager= iter_cursor_managers++))
     cursor_manager->initialize_cursors(&info);
 
-  /* One partition tracker for each window function. */
+  /*
+    One partition tracker for each window function. Window functions with
+    the same PARTITION BY list (e.g. the ones that refer to the same named
+    window) share a tracker, so that the partition is checked once per row.
+  */
   List<Group_bound_tracker> partition_trackers;
+  uint n_funcs= window_functions.elements;
+  SQL_I_List<ORDER> **partition_lists=
+    (SQL_I_List<ORDER> **) thd->alloc(sizeof(SQL_I_List<ORDER> *) * n_funcs);
+  uint *first_func= (uint *) thd->alloc(sizeof(uint) * n_funcs);
+  bool *partition_changed= (bool *) thd->alloc(sizeof(bool) * n_funcs);
+  if (!partition_lists || !first_func || !partition_changed)
+  {
+    end_read_record(&info);
+    return true;
+  }
+
   Item_window_func *win_func;
-  while ((win_func= iter_win_funcs++))
+  for (uint i= 0; (win_func= iter_win_funcs++); i++)
   {
+    partition_lists[i]= win_func->window_spec->partition_list;
+    for (first_func[i]= 0; first_func[i] < i; first_func[i]++)
+      if (partition_lists[first_func[i]] == partition_lists[i])
+        break;
+    if (first_func[i] < i)
+      continue;
     Group_bound_tracker *tracker= new Group_bound_tracker(thd,
-                                        win_func->window_spec->partition_list);
+                                                          partition_lists[i]);
     // TODO(cvicentiu) This should be removed and placed in constructor.
     tracker->init();
     partition_trackers.push_back(tracker);
@@ -2905,12 +3141,15 @@ bool compute_window_func(THD *thd,
     iter_part_trackers.rewind();
     iter_cursor_managers.rewind();
 
-    Group_bound_tracker *tracker;
-    while ((win_func= iter_win_funcs++) &&
-           (tracker= iter_part_trackers++) &&
-           (cursor_manager= iter_cursor_managers++))
+    for (uint i= 0; (win_func= iter_win_funcs++) &&
+                    (cursor_manager= iter_cursor_managers++); i++)
     {
-      if (tracker->check_if_next_group() || (rownum == 0))
+      if (first_func[i] == i)
+        partition_changed[i]= iter_part_trackers++->check_if_next_group();
+      else
+        partition_changed[i]= partition_changed[first_func[i]];
+
+      if (partition_changed[i] || (rownum == 0))
       {
         /* TODO(cvicentiu)
            Clearing window functions should happen through cursors. */
@@ -2931,7 +3170,7 @@ bool compute_window_func(THD *thd,
       }
 
       /* Return to current row after notifying cursors for each window
-         function. */
+         function. This also positions the handler for the update. */
       if (tbl->file->ha_rnd_pos(tbl->record[0], rowid_buf))
       {
         ret= true;
@@ -2939,9 +3178,12 @@ bool compute_window_func(THD *thd,
       }
     }
 
+    if (ret)
+      break;
+
     /* We now have computed values for each window function. They can now
        be saved in the current row. */
-    if (save_window_function_values(window_functions, tbl, rowid_buf))
+    if (save_window_function_values(window_functions, tbl))
     {
       ret= true;
       break;
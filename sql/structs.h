@@ -379,6 +379,7 @@ typedef struct st_user_stats
   ulonglong denied_connections, lost_connections, max_statement_time_exceeded;
   ulonglong access_denied_errors;
   ulonglong empty_queries;
+  ulonglong memory_allocated;
   double busy_time;       // in seconds
   double cpu_time;        // in seconds
 } USER_STATS;
@@ -55,6 +55,7 @@
 #include "opt_trace_context.h"
 #include "log_event.h"
 #include "optimizer_defaults.h"
+#include "sql_statistics.h"                     // ANALYZE_SAMPLE_ROWS
 #include "vector_mhnsw.h"
 
 #ifdef WITH_PERFSCHEMA_STORAGE_ENGINE
@@ -456,6 +457,17 @@ static Sys_var_double Sys_analyze_sample_percentage(
        CMD_LINE(REQUIRED_ARG), VALID_RANGE(0, 100),
        DEFAULT(100));
 
+static const char *analyze_sample_methods[]= {"ROWS", "PAGES", 0};
+static Sys_var_enum Sys_analyze_sample_method(
+       "analyze_sample_method",
+       "How ANALYZE TABLE samples rows when analyze_sample_percentage "
+       "is not 100. Possible values are: "
+       "ROWS - scan the whole table and use a random subset of the rows, "
+       "PAGES - read only a random subset of the pages of the table, "
+       "when the storage engine supports it",
+       SESSION_VAR(analyze_sample_method), CMD_LINE(REQUIRED_ARG),
+       analyze_sample_methods, DEFAULT(ANALYZE_SAMPLE_ROWS));
+
 static Sys_var_ulong Sys_auto_increment_increment(
        "auto_increment_increment",
        "Auto-increment columns are incremented by this",
@@ -1496,6 +1508,18 @@ static Sys_var_keycache Sys_key_cache_age_threshold(
        BLOCK_SIZE(100), NO_MUTEX_GUARD, NOT_IN_BINLOG, ON_CHECK(0),
        ON_UPDATE(change_keycache_param));
 
+static Sys_var_keycache Sys_key_cache_scan_resistance(
+       "key_cache_scan_resistance",
+       "If set to 1, the first hit on a block after it is read into the "
+       "key cache does not age the hot blocks, so that a scan touching "
+       "many blocks once does not push the working set out of the cache. "
+       "Has effect only if key_cache_division_limit is less than 100",
+       KEYCACHE_VAR(param_scan_resistance),
+       CMD_LINE(REQUIRED_ARG, OPT_KEY_CACHE_SCAN_RESISTANCE),
+       VALID_RANGE(0, 1), DEFAULT(0),
+       BLOCK_SIZE(1), NO_MUTEX_GUARD, NOT_IN_BINLOG, ON_CHECK(0),
+       ON_UPDATE(change_keycache_param));
+
 static Sys_var_keycache Sys_key_cache_file_hash_size(
        "key_cache_file_hash_size",
        "Number of hash buckets for open and changed files.  If you have a lot of MyISAM "
@@ -1531,6 +1555,13 @@ static Sys_var_charptr_fscs Sys_language(
        READ_ONLY GLOBAL_VAR(lc_messages_dir_ptr), CMD_LINE(REQUIRED_ARG, 'L'),
        DEFAULT(0));
 
+static Sys_var_mybool Sys_load_data_read_ahead(
+       "load_data_read_ahead",
+       "Read the next block of a LOAD DATA INFILE file from the server "
+       "in a helper thread, while the rows of the current block are "
+       "parsed and inserted",
+       SESSION_VAR(load_data_read_ahead), CMD_LINE(OPT_ARG), DEFAULT(TRUE));
+
 static Sys_var_mybool Sys_local_infile(
        "local_infile", "Enable LOAD DATA LOCAL INFILE",
        GLOBAL_VAR(opt_local_infile), CMD_LINE(OPT_ARG), DEFAULT(TRUE));
@@ -1937,6 +1968,14 @@ static Sys_var_ulong Sys_metadata_locks_cache_size(
        BLOCK_SIZE(1), NO_MUTEX_GUARD, NOT_IN_BINLOG, ON_CHECK(0), ON_UPDATE(0),
        DEPRECATED(1105, ""));
 
+static Sys_var_mybool Sys_metadata_locks_fast_path(
+       "metadata_locks_fast_path",
+       "Grant shared metadata locks on tables by updating counters in the "
+       "lock object, without taking its rwlock, while no conflicting lock is "
+       "granted or requested",
+       READ_ONLY GLOBAL_VAR(opt_mdl_fast_path), CMD_LINE(OPT_ARG),
+       DEFAULT(FALSE));
+
 static ulong mdl_locks_hash_partitions;
 static Sys_var_ulong Sys_metadata_locks_hash_instances(
       "metadata_locks_hash_instances", UNUSED_HELP,
@@ -2518,7 +2557,8 @@ Sys_var_slave_parallel_mode::global_value_ptr(THD *thd,
 
 /* The order here must match enum_slave_parallel_mode in mysqld.h. */
 static const char *slave_parallel_mode_names[] = {
-  "none", "minimal", "conservative", "optimistic", "aggressive", NULL
+  "none", "minimal", "conservative", "optimistic", "aggressive", "writeset",
+  NULL
 };
 export TYPELIB slave_parallel_mode_typelib =
   CREATE_TYPELIB_FOR(slave_parallel_mode_names);
@@ -2531,7 +2571,10 @@ Sys_slave_parallel_mode(
        "--slave-parallel-threads. Possible values: \"optimistic\" tries to "
        "apply most transactional DML in parallel, and handles any conflicts "
        "with rollback and retry. \"conservative\" limits parallelism in an "
-       "effort to avoid any conflicts. \"aggressive\" tries to maximise the "
+       "effort to avoid any conflicts. \"writeset\" runs transactions in "
+       "parallel when the writesets logged by the master "
+       "(--binlog-writeset-max-keys) show they do not conflict, and is "
+       "conservative otherwise. \"aggressive\" tries to maximise the "
        "parallelism, possibly at the cost of increased conflict rate. "
        "\"minimal\" only parallelizes the commit steps of transactions. "
        "\"none\" disables parallel apply completely",
@@ -2701,6 +2744,14 @@ static Sys_var_ulong Sys_max_sort_length(
        SESSION_VAR(max_sort_length), CMD_LINE(REQUIRED_ARG),
        VALID_RANGE(64, 8192*1024L), DEFAULT(1024), BLOCK_SIZE(1));
 
+static Sys_var_ulong Sys_max_sort_threads(
+       "max_sort_threads",
+       "Maximum number of threads that filesort uses for sorting one sort "
+       "buffer; 1 means the buffer is sorted in the connection thread. "
+       "The order of rows with equal sort keys may depend on this",
+       SESSION_VAR(max_sort_threads), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(1, 256), DEFAULT(1), BLOCK_SIZE(1));
+
 static Sys_var_ulong Sys_max_sp_recursion_depth(
        "max_sp_recursion_depth",
        "Maximum stored procedure recursion depth",
@@ -2913,9 +2964,11 @@ static Sys_var_ulong Sys_optimizer_prune_level(
        "less-promising partial plans from the optimizer search space. "
        "Meaning: 0 - do not apply any heuristic, thus perform exhaustive "
        "search: 1 - prune plans based on cost and number of retrieved rows "
-       "eq_ref: 2 - prune also if we find an eq_ref chain",
+       "eq_ref: 2 - prune also if we find an eq_ref chain: 3 - skip also "
+       "partial plans that are not cheaper and produce no fewer rows than "
+       "another one over the same set of tables",
        SESSION_VAR(optimizer_prune_level), CMD_LINE(REQUIRED_ARG),
-       VALID_RANGE(0, 2), DEFAULT(2), BLOCK_SIZE(1));
+       VALID_RANGE(0, 3), DEFAULT(2), BLOCK_SIZE(1));
 
 static Sys_var_ulong Sys_optimizer_selectivity_sampling_limit(
        "optimizer_selectivity_sampling_limit",
@@ -3049,6 +3102,13 @@ static Sys_var_ulong Sys_optimizer_trace_max_mem_size(
     SESSION_VAR(optimizer_trace_max_mem_size), CMD_LINE(REQUIRED_ARG),
     VALID_RANGE(0, ULONG_MAX), DEFAULT(1024 * 1024), BLOCK_SIZE(1));
 
+static Sys_var_mybool Sys_optimizer_cost_feedback(
+    "optimizer_cost_feedback",
+    "Record estimated and measured costs of every table access of ANALYZE "
+    "statements in INFORMATION_SCHEMA.OPTIMIZER_COST_FEEDBACK",
+    SESSION_VAR(optimizer_cost_feedback), CMD_LINE(OPT_ARG),
+    DEFAULT(FALSE));
+
 static Sys_var_ulong Sys_optimizer_adjust_secondary_key_costs(
     "optimizer_adjust_secondary_key_costs",
     UNUSED_HELP,
@@ -3255,6 +3315,43 @@ static Sys_var_ulong Sys_query_prealloc_size(
        BLOCK_SIZE(1024), NO_MUTEX_GUARD, NOT_IN_BINLOG, ON_CHECK(0),
        ON_UPDATE(fix_thd_mem_root));
 
+static Sys_var_uint Sys_query_alloc_retain_size(
+       "query_alloc_retain_size",
+       "Size of memory blocks, besides query_prealloc_size, that a "
+       "connection keeps between statements for reuse instead of freeing "
+       "them. See also query_alloc_retain_limit",
+       SESSION_VAR(query_alloc_retain_size), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(0, UINT_MAX), DEFAULT(0), BLOCK_SIZE(1024));
+
+static Sys_var_ulonglong Sys_query_alloc_retain_limit(
+       "query_alloc_retain_limit",
+       "Limit for the total size of memory blocks that all connections "
+       "keep between statements because of query_alloc_retain_size",
+       GLOBAL_VAR(global_query_alloc_retain_limit), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(0, ULONGLONG_MAX), DEFAULT(256*1024*1024),
+       BLOCK_SIZE(1024));
+
+static bool fix_mem_root_cache_size(sys_var *self, THD *thd,
+                                    enum_var_type type)
+{
+  if (type != OPT_GLOBAL)
+  {
+    thd->root_block_cache.max_size= thd->variables.mem_root_cache_size;
+    if (thd->root_block_cache.size > thd->root_block_cache.max_size)
+      free_root_block_cache(&thd->root_block_cache);
+  }
+  return false;
+}
+static Sys_var_uint Sys_mem_root_cache_size(
+       "mem_root_cache_size",
+       "Size of freed memory blocks that a connection keeps for reuse by "
+       "its next memory roots, instead of returning them to malloc. "
+       "0 disables the cache",
+       SESSION_VAR(mem_root_cache_size), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(0, UINT_MAX), DEFAULT(0), BLOCK_SIZE(1024),
+       NO_MUTEX_GUARD, NOT_IN_BINLOG, ON_CHECK(0),
+       ON_UPDATE(fix_mem_root_cache_size));
+
 // this has to be NO_CMD_LINE as the command-line option has a different name
 static Sys_var_mybool Sys_skip_external_locking(
        "skip_external_locking", "Don't use system (external) locking",
@@ -3569,6 +3666,26 @@ Sys_slave_compressed_protocol(
        GLOBAL_VAR(opt_slave_compressed_protocol), CMD_LINE(OPT_ARG),
        DEFAULT(FALSE));
 
+static const char *slave_compression_algorithm_names[]=
+  {"zlib", "zstd", "lz4", 0};
+static Sys_var_on_access_global<Sys_var_enum,
+                PRIV_SET_SYSTEM_GLOBAL_VAR_SLAVE_COMPRESSED_PROTOCOL>
+Sys_slave_compression_algorithm(
+       "slave_compression_algorithm",
+       "Compression format requested by the slave when "
+       "slave_compressed_protocol is set. The master falls back to zlib "
+       "unless it has the matching compression provider loaded",
+       GLOBAL_VAR(opt_slave_compression_algorithm), CMD_LINE(REQUIRED_ARG),
+       slave_compression_algorithm_names, DEFAULT(NET_COMPRESSION_ZLIB));
+
+static Sys_var_uint Sys_protocol_compression_zstd_level(
+       "protocol_compression_zstd_level",
+       "Zstandard compression level of the packets sent on compressed "
+       "connections that negotiated the zstd format",
+       GLOBAL_VAR(protocol_compression_zstd_level), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(1, 22), DEFAULT(NET_COMPRESSION_ZSTD_DEFAULT_LEVEL),
+       BLOCK_SIZE(1));
+
 #ifdef HAVE_REPLICATION
 static const char *slave_exec_mode_names[]= {"STRICT", "IDEMPOTENT", 0};
 static Sys_var_on_access_global<Sys_var_enum,
@@ -4096,6 +4213,20 @@ static Sys_var_charptr_fscs Sys_ssl_crlpath(
        READ_ONLY GLOBAL_VAR(opt_ssl_crlpath), SSL_OPT(OPT_SSL_CRLPATH),
        DEFAULT(0));
 
+static Sys_var_uint Sys_ssl_session_cache_size(
+       "ssl_session_cache_size",
+       "Number of TLS sessions the server caches for session resumption. "
+       "0 disables session resumption, including session tickets",
+       READ_ONLY GLOBAL_VAR(opt_ssl_session_cache_size), SSL_OPT(0),
+       VALID_RANGE(0, UINT_MAX), DEFAULT(128), BLOCK_SIZE(1));
+
+static Sys_var_mybool Sys_ssl_ktls(
+       "ssl_ktls",
+       "Let the kernel encrypt and decrypt traffic of established TLS "
+       "connections (kTLS), if the TLS library and the kernel support it",
+       READ_ONLY GLOBAL_VAR(opt_ssl_ktls), SSL_OPT(0),
+       DEFAULT(FALSE));
+
 static const char *tls_version_names[]=
 {
   "TLSv1.0",
@@ -4125,6 +4256,15 @@ static Sys_var_mybool Sys_standard_compliant_cte(
        SESSION_VAR(only_standard_compliant_cte), CMD_LINE(OPT_ARG),
        DEFAULT(TRUE));
 
+static Sys_var_mybool Sys_prepared_stmt_reuse(
+       "prepared_stmt_reuse",
+       "If set to 1, PREPARE of a name that is already prepared with the "
+       "same query text, in the same database and with the same sql_mode "
+       "and character set keeps the existing statement instead of parsing "
+       "and resolving it again",
+       SESSION_VAR(prepared_stmt_reuse), CMD_LINE(OPT_ARG),
+       DEFAULT(FALSE));
+
 
 // why ENUM and not BOOL ?
 static const char *updatable_views_with_limit_names[]= {"NO", "YES", 0};
@@ -4260,7 +4400,8 @@ Sys_threadpool_mode(
   );
 #endif
 
-static const char *threadpool_priority_names[]={ "high", "low", "auto", 0 };
+static const char *threadpool_priority_names[]={ "high", "low", "auto", "cost",
+                                                 0 };
 static Sys_var_on_access_global<Sys_var_enum,
                                 PRIV_SET_SYSTEM_GLOBAL_VAR_THREAD_POOL>
 Sys_thread_pool_priority(
@@ -4268,7 +4409,9 @@ Sys_thread_pool_priority(
   "Threadpool priority. High priority connections usually start executing "
   "earlier than low priority. If priority set to 'auto', the the actual "
   "priority(low or high) is determined based on whether or not connection "
-  "is inside transaction",
+  "is inside transaction. If set to 'cost', connections whose recent "
+  "commands took longer than thread_pool_prio_cost_threshold on average "
+  "get low priority",
   SESSION_VAR(threadpool_priority), CMD_LINE(REQUIRED_ARG),
   threadpool_priority_names, DEFAULT(TP_PRIORITY_AUTO));
 
@@ -4335,6 +4478,15 @@ Sys_threadpool_threadpool_prio_kickup_timer(
   VALID_RANGE(0, UINT_MAX), DEFAULT(1000), BLOCK_SIZE(1)
 );
 
+static Sys_var_on_access_global<Sys_var_uint,
+                                PRIV_SET_SYSTEM_GLOBAL_VAR_THREAD_POOL>
+Sys_threadpool_prio_cost_threshold(
+ "thread_pool_prio_cost_threshold",
+ "With thread_pool_priority=cost, the average execution time in milliseconds of a connection's recent commands above which the connection gets low priority",
+  GLOBAL_VAR(threadpool_prio_cost_threshold), CMD_LINE(REQUIRED_ARG),
+  VALID_RANGE(0, UINT_MAX), DEFAULT(100), BLOCK_SIZE(1)
+);
+
 static Sys_var_on_access_global<Sys_var_mybool,
                                 PRIV_SET_SYSTEM_GLOBAL_VAR_THREAD_POOL>
 Sys_threadpool_exact_stats(
@@ -4352,6 +4504,35 @@ Sys_threadpool_dedicated_listener(
   GLOBAL_VAR(threadpool_dedicated_listener), CMD_LINE(OPT_ARG), DEFAULT(FALSE),
   NO_MUTEX_GUARD, NOT_IN_BINLOG
 );
+
+static Sys_var_on_access_global<Sys_var_mybool,
+                                PRIV_SET_SYSTEM_GLOBAL_VAR_THREAD_POOL>
+Sys_threadpool_work_stealing(
+  "thread_pool_work_stealing",
+  "If set to 1, a worker that finds nothing to do in its own thread group "
+  "runs requests queued in another group that has no idle worker",
+  GLOBAL_VAR(threadpool_work_stealing), CMD_LINE(OPT_ARG), DEFAULT(FALSE),
+  NO_MUTEX_GUARD, NOT_IN_BINLOG
+);
+
+static Sys_var_on_access_global<Sys_var_mybool,
+                                PRIV_SET_SYSTEM_GLOBAL_VAR_THREAD_POOL>
+Sys_threadpool_release_idle_memory(
+  "thread_pool_release_idle_memory",
+  "If set to 1, connections waiting for the next command free their "
+  "network buffer and statement memory, which are allocated again when "
+  "the next command arrives",
+  GLOBAL_VAR(threadpool_release_idle_memory), CMD_LINE(OPT_ARG),
+  DEFAULT(FALSE), NO_MUTEX_GUARD, NOT_IN_BINLOG
+);
+
+static Sys_var_mybool Sys_threadpool_io_uring(
+  "thread_pool_io_uring",
+  "If set to 1, thread groups of the generic thread pool wait for client "
+  "requests with io_uring instead of epoll, if the server was built with "
+  "io_uring support and the kernel allows it",
+  READ_ONLY GLOBAL_VAR(threadpool_io_uring), CMD_LINE(OPT_ARG),
+  DEFAULT(FALSE));
 #endif /* HAVE_POOL_OF_THREADS */
 
 /**
@@ -6602,6 +6783,16 @@ static Sys_var_ulong Sys_sp_cache_size(
        GLOBAL_VAR(stored_program_cache_size), CMD_LINE(REQUIRED_ARG),
        VALID_RANGE(0, 512 * 1024), DEFAULT(256), BLOCK_SIZE(1));
 
+static Sys_var_ulong Sys_sp_definition_cache_size(
+       "stored_program_definition_cache",
+       "The upper limit for number of stored routine definitions read from "
+       "mysql.proc that are shared by all connections, so that a routine "
+       "is not read again when it is first called in a connection. "
+       "If set to 0, every connection reads mysql.proc",
+       GLOBAL_VAR(stored_program_definition_cache_size),
+       CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(0, 512 * 1024), DEFAULT(0), BLOCK_SIZE(1));
+
 export const char *plugin_maturity_names[]=
 { "unknown", "experimental", "alpha", "beta", "gamma", "stable", 0 };
 static Sys_var_enum Sys_plugin_maturity(
@@ -6858,6 +7049,15 @@ static Sys_var_ulonglong Sys_join_buffer_space_limit(
        VALID_RANGE(2048, ULONGLONG_MAX), DEFAULT(16*128*1024),
        BLOCK_SIZE(2048));
 
+static Sys_var_ulong Sys_join_buffer_spill_partitions(
+       "join_buffer_spill_partitions",
+       "Maximum number of partitions that the records of an inner join are "
+       "spilled into when they do not fit into a hashed join buffer; each pair "
+       "of partitions is then joined separately, instead of scanning the joined "
+       "table once for each refill of the buffer. 0 or 1 disables spilling",
+       SESSION_VAR(join_buff_spill_partitions), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(0, 256), DEFAULT(0), BLOCK_SIZE(1));
+
 static Sys_var_ulong Sys_progress_report_time(
        "progress_report_time",
        "Seconds between sending progress reports to the client for "
@@ -6892,6 +7092,15 @@ static Sys_var_enum Sys_histogram_type(
        SESSION_VAR(histogram_type), CMD_LINE(REQUIRED_ARG),
        histogram_types, DEFAULT(2));
 
+static Sys_var_ulong Sys_histogram_auto_collect_threshold(
+       "histogram_auto_collect_threshold",
+       "Number of range estimates made by the optimizer for a column that "
+       "has engine-independent statistics but no histogram, after which "
+       "a histogram for the column is collected in the background. "
+       "If set to 0, histograms are only created by ANALYZE",
+       GLOBAL_VAR(histogram_auto_collect_threshold), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(0, UINT_MAX32), DEFAULT(0), BLOCK_SIZE(1));
+
 static Sys_var_mybool Sys_query_cache_strip_comments(
        "query_cache_strip_comments",
        "Strip all comments from a query before storing it "
@@ -7009,6 +7218,19 @@ Sys_binlog_gtid_index_span_min(
        VALID_RANGE(1, 1024*1024L*1024L), DEFAULT(65536), BLOCK_SIZE(1));
 
 
+static Sys_var_on_access_global<Sys_var_uint,
+                        PRIV_SET_SYSTEM_GLOBAL_VAR_BINLOG_WRITESET_MAX_KEYS>
+Sys_binlog_writeset_max_keys(
+       "binlog_writeset_max_keys",
+       "If non-zero, when binlog_format=ROW, write hashes of the unique keys "
+       "changed by each transaction into its GTID event, so that slaves "
+       "using --slave-parallel-mode=writeset can apply non-conflicting "
+       "transactions in parallel. Transactions changing more keys than this "
+       "are logged with the hashes of their tables only. 0 disables writesets",
+       GLOBAL_VAR(opt_binlog_writeset_max_keys), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(0, UINT_MAX16), DEFAULT(0), BLOCK_SIZE(1));
+
+
 static bool check_pseudo_slave_mode(sys_var *self, THD *thd, set_var *var)
 {
   longlong previous_val= thd->variables.pseudo_slave_mode;
@@ -7259,6 +7481,16 @@ static Sys_var_enum Sys_secure_timestamp(
        READ_ONLY GLOBAL_VAR(opt_secure_timestamp), CMD_LINE(REQUIRED_ARG),
        secure_timestamp_levels, DEFAULT(SECTIME_NO));
 
+static Sys_var_ulong Sys_sequence_session_cache(
+       "sequence_session_cache",
+       "Number of values of a sequence that NEXT VALUE FOR reserves for "
+       "the session at once. The session returns them without locking the "
+       "sequence, so the values given to different sessions are unique but "
+       "not increasing in the order they were asked for. 0 or 1 reserves "
+       "the values one by one",
+       SESSION_VAR(sequence_session_cache), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(0, 65535), DEFAULT(0), BLOCK_SIZE(1));
+
 static Sys_var_ulonglong Sys_max_rowid_filter_size(
        "max_rowid_filter_size",
        "The maximum size of the container of a rowid filter",
@@ -1796,7 +1796,7 @@ struct TABLE
 
   int hlindex_open(uint nr);
   int hlindex_lock(uint nr);
-  int hlindex_read_first(uint nr, Item *item, ulonglong limit);
+  int hlindex_read_first(uint nr, Item *item, ulonglong limit, Item *cond);
   int hlindex_read_next();
   int hlindex_read_end();
 
@@ -1805,6 +1805,8 @@ struct TABLE
   int hlindexes_on_update();
   int hlindexes_on_delete(const uchar *buf);
   int hlindexes_on_delete_all(bool truncate);
+  int hlindexes_on_bulk_insert_start();
+  int hlindexes_on_bulk_insert_end(bool abort);
   int reset_hlindexes();
 
   void prepare_triggers_for_insert_stmt_or_event();
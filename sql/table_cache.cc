@@ -51,6 +51,9 @@
 #include "table.h"
 #include "sql_base.h"
 #include "aligned.h"
+#ifdef HAVE_SCHED_GETCPU
+#include <sched.h>
+#endif
 
 
 /** Configuration. */
@@ -223,6 +226,28 @@ struct Table_cache_instance
 static Table_cache_instance *tc;
 
 
+/**
+  Pick table cache instance for the calling thread.
+
+  Instances are meant to split LOCK_table_cache contention between CPUs.
+  Selecting by thread id lets many connections that happen to run on the
+  same CPU hammer different instances while threads that are far apart
+  share one, so prefer the CPU the thread currently runs on. A thread may
+  migrate right after the call, that's harmless: TABLE::instance remembers
+  where each object is accounted.
+*/
+
+static inline uint32_t tc_instance(THD *thd, uint32_t n_instances)
+{
+#ifdef HAVE_SCHED_GETCPU
+  int cpu= sched_getcpu();
+  if (cpu >= 0)
+    return static_cast<uint32_t>(cpu) % n_instances;
+#endif
+  return static_cast<uint32_t>(thd->thread_id % n_instances);
+}
+
+
 static void intern_close_table(TABLE *table)
 {
   delete table->triggers;
@@ -344,7 +369,7 @@ void tc_purge()
 void tc_add_table(THD *thd, TABLE *table)
 {
   uint32_t i=
-    thd->thread_id % tc_active_instances.load(std::memory_order_relaxed);
+    tc_instance(thd, tc_active_instances.load(std::memory_order_relaxed));
   TABLE *LRU_table= 0;
   TDC_element *element= table->s->tdc;
 
@@ -385,6 +410,30 @@ void tc_add_table(THD *thd, TABLE *table)
 }
 
 
+/**
+  Take unused TABLE object of a share from table cache instance.
+
+  @pre tc[i].LOCK_table_cache is locked.
+*/
+
+static TABLE *tc_pop_free_table(THD *thd, TDC_element *element, uint32_t i)
+{
+  TABLE *table= element->free_tables[i].list.pop_front();
+  if (table)
+  {
+    DBUG_ASSERT(!table->in_use);
+    DBUG_ASSERT(table->instance == i);
+    table->in_use= thd;
+    /* The ex-unused table must be fully functional. */
+    DBUG_ASSERT(table->db_stat && table->file);
+    /* The children must be detached from the table. */
+    DBUG_ASSERT(!table->file->extra(HA_EXTRA_IS_ATTACHED_CHILDREN));
+    tc[i].free_tables.remove(table);
+  }
+  return table;
+}
+
+
 /**
   Acquire TABLE object from table cache.
 
@@ -392,28 +441,33 @@ void tc_add_table(THD *thd, TABLE *table)
 
   Acquired object cannot be evicted or acquired again.
 
+  Own instance is searched first. If it has no unused objects of this
+  share, other active instances are probed without waiting for their
+  mutexes: an unused object parked by a thread that ran on another CPU is
+  much cheaper to reuse than opening a new one. The object stays accounted
+  by the instance that created it and is released back there.
+
   @return TABLE object, or NULL if no unused objects.
 */
 
 TABLE *tc_acquire_table(THD *thd, TDC_element *element)
 {
   uint32_t n_instances= tc_active_instances.load(std::memory_order_relaxed);
-  uint32_t i= thd->thread_id % n_instances;
+  uint32_t i= tc_instance(thd, n_instances);
   TABLE *table;
 
   tc[i].lock_and_check_contention(n_instances, i);
-  table= element->free_tables[i].list.pop_front();
-  if (table)
+  table= tc_pop_free_table(thd, element, i);
+  mysql_mutex_unlock(&tc[i].LOCK_table_cache);
+
+  for (uint32_t n= 1; !table && n < n_instances; n++)
   {
-    DBUG_ASSERT(!table->in_use);
-    table->in_use= thd;
-    /* The ex-unused table must be fully functional. */
-    DBUG_ASSERT(table->db_stat && table->file);
-    /* The children must be detached from the table. */
-    DBUG_ASSERT(!table->file->extra(HA_EXTRA_IS_ATTACHED_CHILDREN));
-    tc[i].free_tables.remove(table);
+    uint32_t j= (i + n) % n_instances;
+    if (mysql_mutex_trylock(&tc[j].LOCK_table_cache))
+      continue;
+    table= tc_pop_free_table(thd, element, j);
+    mysql_mutex_unlock(&tc[j].LOCK_table_cache);
   }
-  mysql_mutex_unlock(&tc[i].LOCK_table_cache);
   return table;
 }
 
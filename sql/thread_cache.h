@@ -16,11 +16,18 @@
 */
 
 
+void delete_cached_thd(THD *thd);
+
+
 /**
   MariaDB thread cache for "one thread per connection" scheduler.
 
   Thread cache allows to re-use threads (as well as THD objects) for
   subsequent connections.
+
+  The thread pool scheduler does not park threads, but keeps THD objects
+  of closed connections (together with their mysys_thread_var) in the
+  same cache, bounded by the same thread_cache_size.
 */
 class Thread_cache
 {
@@ -31,6 +38,8 @@ class Thread_cache
   I_List<CONNECT> list;
   /** Number of threads parked in the cache. */
   ulong cached_thread_count;
+  /** THD objects of closed thread pool connections, see park_thd(). */
+  DYNAMIC_ARRAY cached_thds;
   /** Number of active flush requests. */
   uint32_t kill_cached_threads;
   /**
@@ -61,6 +70,8 @@ class Thread_cache
                      MY_MUTEX_INIT_FAST);
     mysql_cond_init(key_COND_thread_cache, &COND_thread_cache, 0);
     mysql_cond_init(key_COND_flush_thread_cache, &COND_flush_thread_cache, 0);
+    my_init_dynamic_array(PSI_INSTRUMENT_ME, &cached_thds, sizeof(THD*), 0, 16,
+                          MYF(0));
     list.empty();
     kill_cached_threads= 0;
     cached_thread_count= 0;
@@ -71,6 +82,8 @@ class Thread_cache
   {
     DBUG_ASSERT(cached_thread_count == 0);
     DBUG_ASSERT(list.is_empty());
+    DBUG_ASSERT(cached_thds.elements == 0);
+    delete_dynamic(&cached_thds);
     mysql_cond_destroy(&COND_flush_thread_cache);
     mysql_cond_destroy(&COND_thread_cache);
     mysql_mutex_destroy(&LOCK_thread_cache);
@@ -82,11 +95,19 @@ class Thread_cache
 
     Awakes parked threads and requests them to shutdown.
     Waits until last parked thread leaves the cache.
+    Frees cached THD objects.
   */
   void flush()
   {
     mysql_mutex_lock(&LOCK_thread_cache);
     kill_cached_threads++;
+    while (cached_thds.elements)
+    {
+      THD *thd= *static_cast<THD**>(pop_dynamic(&cached_thds));
+      mysql_mutex_unlock(&LOCK_thread_cache);
+      delete_cached_thd(thd);
+      mysql_mutex_lock(&LOCK_thread_cache);
+    }
     while (cached_thread_count)
     {
       mysql_cond_broadcast(&COND_thread_cache);
@@ -197,6 +218,45 @@ class Thread_cache
   }
 
 
+  /**
+    Keeps THD of a closed thread pool connection for reuse.
+
+    THD must be unlinked and its instrumentation deleted, so that it only
+    needs THD::reset_for_reuse() to serve new connection.
+
+    @return
+      @retval true THD is cached
+      @retval false thread cache is full or flushed, caller must delete THD
+  */
+  bool park_thd(THD *thd)
+  {
+    bool parked= false;
+    mysql_mutex_lock(&LOCK_thread_cache);
+    if (cached_thds.elements < thread_cache_size && !kill_cached_threads)
+      parked= !insert_dynamic(&cached_thds, &thd);
+    mysql_mutex_unlock(&LOCK_thread_cache);
+    return parked;
+  }
+
+
+  /**
+    Takes THD cached by park_thd().
+
+    @return
+      @retval pointer to THD
+      @retval 0 if there are no cached THD objects
+  */
+  THD *unpark_thd()
+  {
+    THD *thd= 0;
+    mysql_mutex_lock(&LOCK_thread_cache);
+    if (cached_thds.elements)
+      thd= *static_cast<THD**>(pop_dynamic(&cached_thds));
+    mysql_mutex_unlock(&LOCK_thread_cache);
+    return thd;
+  }
+
+
   /** Returns the number of parked threads. */
   ulong size() const
   {
@@ -26,8 +26,12 @@ extern uint threadpool_stall_limit;  /* time interval in milliseconds for stall
 extern uint threadpool_max_threads;  /* Maximum threads in pool */
 extern uint threadpool_oversubscribe;  /* Maximum active threads in group */
 extern uint threadpool_prio_kickup_timer;  /* Time before low prio item gets prio boost */
+extern uint threadpool_prio_cost_threshold; /* Average command time that makes a connection low prio */
 extern my_bool threadpool_exact_stats; /* Better queueing time stats for information_schema, at small performance cost */
 extern my_bool threadpool_dedicated_listener; /* Listener thread does not pick up work items. */
+extern my_bool threadpool_io_uring; /* Thread groups poll with io_uring instead of epoll */
+extern my_bool threadpool_work_stealing; /* Idle workers take queued events from other groups */
+extern my_bool threadpool_release_idle_memory; /* Idle connections free their buffers */
 #ifdef _WIN32
 extern uint threadpool_mode; /* Thread pool implementation , windows or generic */
 #define TP_MODE_WINDOWS 0
@@ -68,7 +72,8 @@ extern int tp_get_thread_count();
 enum  TP_PRIORITY {
   TP_PRIORITY_HIGH,
   TP_PRIORITY_LOW,
-  TP_PRIORITY_AUTO
+  TP_PRIORITY_AUTO,
+  TP_PRIORITY_COST
 };
 
 
@@ -95,11 +100,14 @@ struct TP_connection
   CONNECT*    connect;
   TP_STATE    state;
   TP_PRIORITY priority;
+  /* Moving average of command execution time (microseconds) */
+  ulonglong   avg_cost;
   TP_connection(CONNECT *c) :
     thd(0),
     connect(c),
     state(TP_STATE_IDLE),
-    priority(TP_PRIORITY_HIGH)
+    priority(TP_PRIORITY_HIGH),
+    avg_cost(0)
   {}
 
   virtual ~TP_connection() = default;
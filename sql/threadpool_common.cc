@@ -25,6 +25,7 @@
 #include <threadpool.h>
 #include <sql_class.h>
 #include <sql_parse.h>
+#include "thread_cache.h"
 
 #ifdef WITH_WSREP
 #include "wsrep_trans_observer.h"
@@ -45,8 +46,12 @@ uint threadpool_max_threads;
 uint threadpool_oversubscribe;
 uint threadpool_mode;
 uint threadpool_prio_kickup_timer;
+uint threadpool_prio_cost_threshold;
 my_bool threadpool_exact_stats;
 my_bool threadpool_dedicated_listener;
+my_bool threadpool_io_uring;
+my_bool threadpool_work_stealing;
+my_bool threadpool_release_idle_memory;
 
 /* Stats */
 TP_STATISTICS tp_stats;
@@ -55,6 +60,7 @@ TP_STATISTICS tp_stats;
 static void  threadpool_remove_connection(THD *thd);
 static dispatch_command_return threadpool_process_request(THD *thd);
 static THD*  threadpool_add_connection(CONNECT *connect, TP_connection *c);
+static bool  acquire_idle_memory(THD *thd);
 
 extern bool do_command(THD*);
 
@@ -208,7 +214,12 @@ static void thread_attach(THD* thd)
 
 /*
   Determine connection priority , using current
-  transaction state and 'threadpool_priority' variable value.
+  transaction state, recent command cost and 'threadpool_priority'
+  variable value.
+
+  With 'cost', connections whose recent commands ran longer than
+  thread_pool_prio_cost_threshold on average are queued behind the
+  others. The prio kickup timer still keeps them from starving.
 */
 static TP_PRIORITY get_priority(TP_connection *c)
 {
@@ -216,11 +227,25 @@ static TP_PRIORITY get_priority(TP_connection *c)
   TP_PRIORITY prio= (TP_PRIORITY)c->thd->variables.threadpool_priority;
   if (prio == TP_PRIORITY_AUTO)
     prio= c->thd->transaction->is_active() ? TP_PRIORITY_HIGH : TP_PRIORITY_LOW;
+  else if (prio == TP_PRIORITY_COST)
+    prio= c->avg_cost > 1000ULL * threadpool_prio_cost_threshold ?
+          TP_PRIORITY_LOW : TP_PRIORITY_HIGH;
 
   return prio;
 }
 
 
+/*
+  Fold the execution time of the last request into the connection's
+  moving average, giving the new sample a weight of 1/8.
+*/
+static void update_cost(TP_connection *c, ulonglong start)
+{
+  ulonglong elapsed= microsecond_interval_timer() - start;
+  c->avg_cost= c->avg_cost - c->avg_cost / 8 + elapsed / 8;
+}
+
+
 void tp_callback(TP_connection *c)
 {
   DBUG_ASSERT(c);
@@ -245,6 +270,10 @@ void tp_callback(TP_connection *c)
   }
   else
   {
+    /* Only pay for the timer if the cost is going to be used */
+    ulonglong start=
+      thd->variables.threadpool_priority == TP_PRIORITY_COST ?
+      microsecond_interval_timer() : 0;
 retry:
     switch(threadpool_process_request(thd))
     {
@@ -266,6 +295,8 @@ void tp_callback(TP_connection *c)
         break;
     }
     thd->async_state.m_state= thd_async_state::enum_async_state::NONE;
+    if (start)
+      update_cost(c, start);
   }
 
   /* Set priority */
@@ -290,21 +321,35 @@ void tp_callback(TP_connection *c)
 
 static THD *threadpool_add_connection(CONNECT *connect, TP_connection *c)
 {
-  THD *thd= NULL;
-
   /*
-    Create a new connection context: mysys_thread_var and PSI thread
+    Reuse THD of a closed connection, together with its mysys_thread_var,
+    if there is one in the thread cache. Otherwise, create a new
+    connection context: mysys_thread_var and PSI thread.
     Store them in THD.
   */
+  THD *cached_thd= thread_cache.unpark_thd();
+  THD *thd= NULL;
+  st_my_thread_var* mysys_var;
 
-  set_mysys_var(NULL);
-  my_thread_init();
-  st_my_thread_var* mysys_var= my_thread_var;
+  if (cached_thd)
+  {
+    mysys_var= cached_thd->mysys_var;
+    set_mysys_var(mysys_var);
+    mysys_var->abort= 0;
+    set_current_thd(cached_thd);
+  }
+  else
+  {
+    set_mysys_var(NULL);
+    my_thread_init();
+    mysys_var= my_thread_var;
+  }
   PSI_CALL_set_thread(PSI_CALL_new_thread(key_thread_one_connection, connect, 0));
-  if (!mysys_var ||!(thd= connect->create_thd(NULL)))
+  if (!mysys_var ||!(thd= connect->create_thd(cached_thd)))
   {
     /* Out of memory? */
     connect->close_and_delete(0);
+    delete cached_thd;
     if (mysys_var)
       my_thread_end();
     return NULL;
@@ -351,11 +396,18 @@ static THD *threadpool_add_connection(CONNECT *connect, TP_connection *c)
 static void threadpool_remove_connection(THD *thd)
 {
   thread_attach(thd);
+  /* The connection may have gone away while idle, see release_idle_memory() */
+  (void) acquire_idle_memory(thd);
   thd->net.reading_or_writing = 0;
   end_connection(thd);
   close_connection(thd, 0);
   unlink_thd(thd);
-  PSI_CALL_delete_current_thread(); // before THD is destroyed
+  PSI_CALL_delete_current_thread(); // before THD is destroyed or cached
+  thd->set_psi(NULL);
+
+  /* Keep THD and its mysys thread_var for the next connection */
+  if (thread_cache.park_thd(thd))
+    return;
   delete thd;
 
   /*
@@ -391,6 +443,39 @@ static bool has_unread_data(THD* thd)
 }
 
 
+/*
+  With thread_pool_release_idle_memory, a connection that waits for the
+  next command frees its network buffer, result packet and statement
+  memory root preallocation, leaving little beyond THD itself for an idle
+  connection. acquire_idle_memory() allocates the network buffer again
+  before the connection is processed; the rest grows back on demand.
+
+  Compressed connections keep their buffer, as the compressed read state
+  refers to it.
+*/
+static void release_idle_memory(THD *thd)
+{
+  NET *net= &thd->net;
+  DBUG_ASSERT(!has_unread_data(thd));
+  if (net->compress)
+    return;
+  thd->packet.free();
+  thd->free_query_mem_root(true);
+  my_free(net->buff);
+  net->buff= net->buff_end= net->write_pos= net->read_pos= 0;
+}
+
+
+static bool acquire_idle_memory(THD *thd)
+{
+  NET *net= &thd->net;
+  if (likely(net->buff != 0))
+    return false;
+  net->max_packet= (ulong) thd->variables.net_buffer_length;
+  return net_allocate_new_packet(net, thd, MYF(MY_THREAD_SPECIFIC));
+}
+
+
 /**
  Process a single client request or a single batch.
 */
@@ -402,6 +487,13 @@ static dispatch_command_return threadpool_process_request(THD *thd)
   if(thd->async_state.m_state == thd_async_state::enum_async_state::RESUMED)
     goto resume;
 
+  if (unlikely(acquire_idle_memory(thd)))
+  {
+    /* Out of memory */
+    retval= DISPATCH_COMMAND_CLOSE_CONNECTION;
+    goto end;
+  }
+
   if (thd->killed >= KILL_CONNECTION)
   {
     /*
@@ -454,6 +546,8 @@ static dispatch_command_return threadpool_process_request(THD *thd)
     {
       /* More info on this debug sync is in sql_parse.cc*/
       DEBUG_SYNC(thd, "before_do_command_net_read");
+      if (threadpool_release_idle_memory)
+        release_idle_memory(thd);
       goto end;
     }
   }
@@ -61,10 +61,18 @@ static bool threadpool_started= false;
 #ifdef HAVE_PSI_INTERFACE
 static PSI_mutex_key key_group_mutex;
 static PSI_mutex_key key_timer_mutex;
+#ifdef HAVE_URING
+static PSI_mutex_key key_uring_sq_mutex;
+static PSI_mutex_key key_uring_cq_mutex;
+#endif
 static PSI_mutex_info mutex_list[]=
 {
   { &key_group_mutex, "group_mutex", 0},
-  { &key_timer_mutex, "timer_mutex", PSI_FLAG_GLOBAL}
+  { &key_timer_mutex, "timer_mutex", PSI_FLAG_GLOBAL},
+#ifdef HAVE_URING
+  { &key_uring_sq_mutex, "uring_sq_mutex", 0},
+  { &key_uring_cq_mutex, "uring_cq_mutex", 0}
+#endif
 };
 
 static PSI_cond_key key_worker_cond;
@@ -442,6 +450,185 @@ int io_poll_wait(TP_file_handle pollfd, native_event *events, int maxevents,
 
 #endif
 
+#ifdef HAVE_URING
+#include <liburing.h>
+#include <poll.h>
+#ifndef POLLRDHUP
+#define POLLRDHUP 0
+#endif
+
+/**
+  io_uring that replaces the epoll descriptor of a thread group.
+
+  A connection is watched with a single shot IORING_OP_POLL_ADD, which
+  behaves like EPOLLONESHOT: after the completion was reaped nothing is
+  left in the ring for the connection, so neither disassociating nor
+  closing the socket needs to touch the ring.
+
+  Completions are read straight from the shared completion ring, so the
+  non-blocking poll that a worker does before going to sleep does not
+  need a system call at all.
+*/
+struct tp_uring
+{
+  struct io_uring ring;
+  /** Protects the submission queue; liburing calls are not thread safe */
+  mysql_mutex_t sq_mutex;
+  /** Held by the thread that reaps completions */
+  mysql_mutex_t cq_mutex;
+};
+
+static tp_uring *tp_uring_create()
+{
+  tp_uring *u= (tp_uring*) my_malloc(PSI_INSTRUMENT_ME, sizeof *u, MYF(0));
+  if (!u)
+    return NULL;
+  if (int err= io_uring_queue_init(MAX_EVENTS, &u->ring, 0))
+  {
+    sql_print_warning("Threadpool: io_uring_queue_init() failed with "
+                      "errno %d, falling back to epoll", -err);
+    my_free(u);
+    return NULL;
+  }
+  mysql_mutex_init(key_uring_sq_mutex, &u->sq_mutex, NULL);
+  mysql_mutex_init(key_uring_cq_mutex, &u->cq_mutex, NULL);
+  return u;
+}
+
+static void tp_uring_destroy(tp_uring *u)
+{
+  io_uring_queue_exit(&u->ring);
+  mysql_mutex_destroy(&u->sq_mutex);
+  mysql_mutex_destroy(&u->cq_mutex);
+  my_free(u);
+}
+
+static int tp_uring_start_read(tp_uring *u, TP_file_handle fd, void *data)
+{
+  int ret= -1;
+  mysql_mutex_lock(&u->sq_mutex);
+  if (io_uring_sqe *sqe= io_uring_get_sqe(&u->ring))
+  {
+    io_uring_prep_poll_add(sqe, fd, POLLIN | POLLRDHUP);
+    io_uring_sqe_set_data(sqe, data);
+    ret= io_uring_submit(&u->ring) == 1 ? 0 : -1;
+  }
+  mysql_mutex_unlock(&u->sq_mutex);
+  return ret;
+}
+
+/**
+  Same as io_poll_wait(), for io_uring.
+
+  Only the infinite and the zero timeouts are used by the callers. With
+  the zero timeout nothing is returned while another thread is reaping.
+*/
+static int tp_uring_wait(tp_uring *u, native_event *events, int maxevents,
+                         int timeout_ms)
+{
+  DBUG_ASSERT(timeout_ms == 0 || timeout_ms == -1);
+  if (timeout_ms)
+    mysql_mutex_lock(&u->cq_mutex);
+  else if (mysql_mutex_trylock(&u->cq_mutex))
+    return 0;
+
+  io_uring_cqe *cqe;
+  if (timeout_ms)
+  {
+    int err;
+    while ((err= io_uring_wait_cqe(&u->ring, &cqe)) == -EINTR) {}
+    if (err)
+    {
+      mysql_mutex_unlock(&u->cq_mutex);
+      errno= -err;
+      return -1;
+    }
+  }
+
+  unsigned head;
+  int n= 0;
+  io_uring_for_each_cqe(&u->ring, head, cqe)
+  {
+    if (n == maxevents)
+      break;
+    events[n].data.u64= 0;
+    events[n].data.ptr= io_uring_cqe_get_data(cqe);
+    events[n].events= cqe->res < 0 ? EPOLLERR : uint32_t(cqe->res);
+    n++;
+  }
+  io_uring_cq_advance(&u->ring, unsigned(n));
+  mysql_mutex_unlock(&u->cq_mutex);
+  return n;
+}
+#endif /* HAVE_URING */
+
+
+/*
+  The thread groups use the io_poll API through the following functions,
+  which pick io_uring instead, if the group has one.
+*/
+
+static TP_file_handle group_poll_create(thread_group_t *group)
+{
+#ifdef HAVE_URING
+  if (threadpool_io_uring && (group->uring= tp_uring_create()))
+    return group->uring->ring.ring_fd;
+#endif
+  return io_poll_create();
+}
+
+static void group_poll_close(thread_group_t *group)
+{
+#ifdef HAVE_URING
+  if (group->uring)
+  {
+    tp_uring_destroy(group->uring);
+    group->uring= NULL;
+    return;
+  }
+#endif
+  io_poll_close(group->pollfd);
+}
+
+static int group_poll_associate_fd(thread_group_t *group, TP_file_handle fd,
+                                   void *data, void *opt)
+{
+#ifdef HAVE_URING
+  if (group->uring)
+    return tp_uring_start_read(group->uring, fd, data);
+#endif
+  return io_poll_associate_fd(group->pollfd, fd, data, opt);
+}
+
+static int group_poll_start_read(thread_group_t *group, TP_file_handle fd,
+                                 void *data, void *opt)
+{
+#ifdef HAVE_URING
+  if (group->uring)
+    return tp_uring_start_read(group->uring, fd, data);
+#endif
+  return io_poll_start_read(group->pollfd, fd, data, opt);
+}
+
+static int group_poll_disassociate_fd(thread_group_t *group, TP_file_handle fd)
+{
+#ifdef HAVE_URING
+  if (group->uring)
+    return 0;
+#endif
+  return io_poll_disassociate_fd(group->pollfd, fd);
+}
+
+static int group_poll_wait(thread_group_t *group, native_event *events,
+                           int maxevents, int timeout_ms)
+{
+#ifdef HAVE_URING
+  if (group->uring)
+    return tp_uring_wait(group->uring, events, maxevents, timeout_ms);
+#endif
+  return io_poll_wait(group->pollfd, events, maxevents, timeout_ms);
+}
+
 
 /* Dequeue element from a workqueue */
 
@@ -730,7 +917,7 @@ static TP_connection_generic * listener(worker_thread_t *current_thread,
     if (thread_group->shutdown)
       break;
 
-    cnt = io_poll_wait(thread_group->pollfd, ev, MAX_EVENTS, -1);
+    cnt = group_poll_wait(thread_group, ev, MAX_EVENTS, -1);
     TP_INCREMENT_GROUP_COUNTER(thread_group, polls[(int)operation_origin::LISTENER]);
     if (cnt <=0)
     {
@@ -988,6 +1175,9 @@ int thread_group_init(thread_group_t *thread_group, pthread_attr_t* thread_attr)
   thread_group->pthread_attr = thread_attr;
   mysql_mutex_init(key_group_mutex, &thread_group->mutex, NULL);
   thread_group->pollfd= INVALID_HANDLE_VALUE;
+#ifdef HAVE_URING
+  thread_group->uring= NULL;
+#endif
   thread_group->shutdown_pipe[0]= -1;
   thread_group->shutdown_pipe[1]= -1;
   queue_init(thread_group);
@@ -1000,7 +1190,7 @@ void thread_group_destroy(thread_group_t *thread_group)
   mysql_mutex_destroy(&thread_group->mutex);
   if (thread_group->pollfd != INVALID_HANDLE_VALUE)
   {
-    io_poll_close(thread_group->pollfd);
+    group_poll_close(thread_group);
     thread_group->pollfd= INVALID_HANDLE_VALUE;
   }
 #ifndef _WIN32
@@ -1057,7 +1247,7 @@ static int wake_listener(thread_group_t *thread_group)
   }
 
   /* Wake listener */
-  if (io_poll_associate_fd(thread_group->pollfd,
+  if (group_poll_associate_fd(thread_group,
     thread_group->shutdown_pipe[0], NULL, NULL))
   {
     return -1;
@@ -1140,6 +1330,76 @@ static bool too_many_threads(thread_group_t *thread_group)
 }
 
 
+/**
+  Take a queued event from another group that has no idle worker to run it.
+
+  Groups are scanned starting with the neighbours of the current one.
+  Victim mutexes are only try-locked, since the caller holds the mutex of
+  its own group and another worker may be stealing in the opposite
+  direction. While the event runs, the thread counts as active in the
+  victim group, because that is the group the connection uses for
+  wait_begin()/wait_end() and for re-arming its socket.
+
+  @param current_thread - current worker thread
+  @param thread_group - current thread group, its mutex is locked
+
+  @return stolen connection, or NULL
+*/
+
+static TP_connection_generic *steal_event(worker_thread_t *current_thread,
+                                          thread_group_t *thread_group)
+{
+  uint n= group_count;
+  uint own= (uint) (thread_group - all_groups);
+  for (uint i= 1; i < n; i++)
+  {
+    thread_group_t *victim= &all_groups[(own + i) % n];
+    /* Unlocked peek to skip uninteresting groups, rechecked below */
+    if (!victim->waiting_threads.is_empty() || is_queue_empty(victim) ||
+        mysql_mutex_trylock(&victim->mutex))
+      continue;
+
+    TP_connection_generic *connection= NULL;
+    if (!victim->shutdown && victim->waiting_threads.is_empty())
+      connection= queue_get(victim, operation_origin::WORKER);
+    if (connection)
+      victim->active_thread_count++;
+    mysql_mutex_unlock(&victim->mutex);
+
+    if (connection)
+    {
+      thread_group->active_thread_count--;
+      current_thread->stolen_from= victim;
+      return connection;
+    }
+  }
+  return NULL;
+}
+
+
+/**
+  Move the accounting of a worker back to its own group after it has
+  handled a connection taken by steal_event().
+*/
+
+static void end_stolen_event(worker_thread_t *current_thread)
+{
+  thread_group_t *victim= current_thread->stolen_from;
+  current_thread->stolen_from= NULL;
+
+  mysql_mutex_lock(&victim->mutex);
+  victim->active_thread_count--;
+  if (victim->active_thread_count == 0 && !is_queue_empty(victim))
+    wake_or_create_thread(victim);
+  mysql_mutex_unlock(&victim->mutex);
+
+  thread_group_t *thread_group= current_thread->thread_group;
+  mysql_mutex_lock(&thread_group->mutex);
+  thread_group->active_thread_count++;
+  mysql_mutex_unlock(&thread_group->mutex);
+}
+
+
 /**
   Retrieve a connection with pending event.
 
@@ -1210,7 +1470,7 @@ TP_connection_generic *get_event(worker_thread_t *current_thread,
     if (!oversubscribed && !threadpool_dedicated_listener)
     {
       native_event ev[MAX_EVENTS];
-      int cnt = io_poll_wait(thread_group->pollfd, ev, MAX_EVENTS, 0);
+      int cnt = group_poll_wait(thread_group, ev, MAX_EVENTS, 0);
       TP_INCREMENT_GROUP_COUNTER(thread_group, polls[(int)operation_origin::WORKER]);
       if (cnt > 0)
       {
@@ -1220,6 +1480,11 @@ TP_connection_generic *get_event(worker_thread_t *current_thread,
       }
     }
 
+    /* Nothing to do in this group, try helping a busier one */
+    if (!oversubscribed && threadpool_work_stealing &&
+        (connection= steal_event(current_thread, thread_group)))
+      break;
+
 
     /* And now, finally sleep */
     current_thread->woken = false; /* wake() sets this to true */
@@ -1468,7 +1733,7 @@ static int change_group(TP_connection_generic *c,
   mysql_mutex_lock(&old_group->mutex);
   if (c->bound_to_poll_descriptor)
   {
-    io_poll_disassociate_fd(old_group->pollfd,c->fd);
+    group_poll_disassociate_fd(old_group, c->fd);
     c->bound_to_poll_descriptor= false;
   }
   c->thread_group->connection_count--;
@@ -1516,10 +1781,10 @@ int TP_connection_generic::start_io()
   if (!bound_to_poll_descriptor)
   {
     bound_to_poll_descriptor= true;
-    return io_poll_associate_fd(thread_group->pollfd, fd, this, OPTIONAL_IO_POLL_READ_PARAM);
+    return group_poll_associate_fd(thread_group, fd, this, OPTIONAL_IO_POLL_READ_PARAM);
   }
 
-  return io_poll_start_read(thread_group->pollfd, fd, this, OPTIONAL_IO_POLL_READ_PARAM);
+  return group_poll_start_read(thread_group, fd, this, OPTIONAL_IO_POLL_READ_PARAM);
 }
 
 
@@ -1543,6 +1808,7 @@ static void *worker_main(void *param)
   /* Init per-thread structure */
   mysql_cond_init(key_worker_cond, &this_thread.cond, NULL);
   this_thread.thread_group= thread_group;
+  this_thread.stolen_from= NULL;
   this_thread.event_count=0;
 
   /* Run event loop */
@@ -1555,7 +1821,16 @@ static void *worker_main(void *param)
     if (!connection)
       break;
     this_thread.event_count++;
+    if (THD *thd= connection->thd)
+    {
+      ulonglong now= threadpool_exact_stats
+        ? microsecond_interval_timer() : pool_timer.current_microtime;
+      thd->threadpool_queue_time= now > connection->enqueue_time
+        ? now - connection->enqueue_time : 0;
+    }
     tp_callback(connection);
+    if (this_thread.stolen_from)
+      end_stolen_event(&this_thread);
   }
 
   /* Thread shutdown: cleanup per-worker-thread structure. */
@@ -1594,6 +1869,11 @@ int TP_pool_generic::init()
   PSI_register(mutex);
   PSI_register(cond);
   PSI_register(thread);
+#ifndef HAVE_URING
+  if (threadpool_io_uring)
+    sql_print_warning("Threadpool: io_uring is not available in this build, "
+                      "thread_pool_io_uring is ignored");
+#endif
   scheduler_init();
   threadpool_started= true;
   for (uint i= 0; i < threadpool_max_size; i++)
@@ -1657,7 +1937,7 @@ int TP_pool_generic::set_pool_size(uint size)
     mysql_mutex_lock(&group->mutex);
     if (group->pollfd == INVALID_HANDLE_VALUE)
     {
-      group->pollfd= io_poll_create();
+      group->pollfd= group_poll_create(group);
       success= (group->pollfd != INVALID_HANDLE_VALUE);
       if(!success)
       {
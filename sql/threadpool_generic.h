@@ -58,6 +58,8 @@ struct worker_thread_t
 {
   ulonglong  event_count; /* number of request handled by this thread */
   thread_group_t* thread_group;
+  /* Group whose connection this thread currently handles, if not its own */
+  thread_group_t* stolen_from;
   worker_thread_t* next_in_list;
   worker_thread_t** prev_in_list;
   mysql_cond_t  cond;
@@ -136,6 +138,10 @@ struct thread_group_t
   worker_thread_t* listener;
   pthread_attr_t* pthread_attr;
   TP_file_handle  pollfd;
+#ifdef HAVE_URING
+  /** Used instead of epoll if thread_pool_io_uring is set */
+  struct tp_uring *uring;
+#endif
   int  thread_count;
   int  active_thread_count;
   int  connection_count;
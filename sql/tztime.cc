@@ -45,6 +45,7 @@
 #include "tzfile.h"
 #include <m_string.h>
 #include <my_dir.h>
+#include <my_atomic.h>
 #include <mysql/psi/mysql_file.h>
 #include "lock.h"                               // MYSQL_LOCK_IGNORE_FLUSH,
                                                 // MYSQL_LOCK_IGNORE_TIMEOUT
@@ -126,6 +127,13 @@ typedef struct st_time_zone_info
     there are no transitions at all.
   */
   TRAN_TYPE_INFO *fallback_tti;
+  /*
+    Ranges of ats and revts that were found last, tried before doing
+    the binary search, as consecutive conversions are usually in the
+    same range. Shared by all threads using the zone.
+  */
+  mutable int32 last_ats_range;
+  mutable int32 last_revts_range;
 
 } TIME_ZONE_INFO;
 
@@ -641,6 +649,32 @@ find_time_range(my_int_time_t t, const my_int_time_t *range_boundaries,
   return lower_bound;
 }
 
+
+/*
+  Same as find_time_range(), but try the range found by the previous
+  call first
+
+  SYNOPSIS
+    find_time_range_cached()
+      t, range_boundaries, higher_bound - as in find_time_range()
+      last_range       - index of the range found by the previous call,
+                         updated if another range is found
+*/
+static uint
+find_time_range_cached(my_int_time_t t, const my_int_time_t *range_boundaries,
+                       uint higher_bound, int32 *last_range)
+{
+  uint i= (uint) my_atomic_load32_explicit(last_range,
+                                           MY_MEMORY_ORDER_RELAXED);
+  if (i < higher_bound && range_boundaries[i] <= t &&
+      (i + 1 == higher_bound || t < range_boundaries[i + 1]))
+    return i;
+
+  i= find_time_range(t, range_boundaries, higher_bound);
+  my_atomic_store32_explicit(last_range, (int32) i, MY_MEMORY_ORDER_RELAXED);
+  return i;
+}
+
 /*
   Find local time transition for given my_time_t.
 
@@ -671,7 +705,8 @@ find_transition_type(my_time_t t, const TIME_ZONE_INFO *sp)
     contain t. With this localtime_r on real data may takes less
     time than with linear search (I've seen 30% speed up).
   */
-  return &(sp->ttis[sp->types[find_time_range(t, sp->ats, sp->timecnt)]]);
+  return &(sp->ttis[sp->types[find_time_range_cached(t, sp->ats, sp->timecnt,
+                                                     &sp->last_ats_range)]]);
 }
 
 
@@ -939,7 +974,8 @@ a  */
   }
 
   /* binary search for our range */
-  i= find_time_range(local_t, sp->revts, sp->revcnt);
+  i= find_time_range_cached(local_t, sp->revts, sp->revcnt,
+                            &sp->last_revts_range);
 
   /*
     As there are no offset switches at the end of TIMESTAMP range,
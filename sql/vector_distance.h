@@ -0,0 +1,224 @@
+/*
+   Copyright (c) 2024, MariaDB plc
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1335  USA
+*/
+
+/*
+  Kernels for VEC_DISTANCE_*() and VECTOR value validation, working
+  on unaligned float32 arrays as they're stored in the VECTOR column
+
+  Products are computed in float and summed in double, exactly like
+  the scalar code always did, so results don't depend on the CPU
+  (except for the summation order). Vector_float_ops dispatches to
+  the best variant at runtime, like FVector does in vector_mhnsw.cc.
+*/
+
+#pragma once
+#include <my_global.h>
+#include <my_byteorder.h>
+#include <cmath>
+#include "bloom_filters.h"                      // *_IMPLEMENTATION
+
+struct Vector_float_ops
+{
+  /* sum of squares of the differences */
+  static double euclidean2_default(const float *v1, const float *v2,
+                                   size_t len)
+  {
+    double d= 0;
+    for (size_t i= 0; i < len; i++)
+    {
+      float dist= get_float(v1 + i) - get_float(v2 + i);
+      d+= dist * dist;
+    }
+    return d;
+  }
+
+  /* dot product and squares of both vectors for the cosine distance */
+  static void cosine_default(const float *v1, const float *v2, size_t len,
+                             double *dotp, double *abs1, double *abs2)
+  {
+    for (size_t i= 0; i < len; i++)
+    {
+      float f1= get_float(v1 + i), f2= get_float(v2 + i);
+      *abs1+= f1 * f1;
+      *abs2+= f2 * f2;
+      *dotp+= f1 * f2;
+    }
+  }
+
+  /* sum of squares in float, overflows to inf like a float column would */
+  static float abs2_default(const float *v, size_t len)
+  {
+    float abs2= 0.0f;
+    for (size_t i= 0; i < len; i++)
+    {
+      float val= get_float(v + i);
+      abs2+= val*val;
+    }
+    return abs2;
+  }
+
+#ifdef AVX2_IMPLEMENTATION
+  AVX2_IMPLEMENTATION
+  static double hsum(__m256d d)
+  {
+    __m128d s= _mm_add_pd(_mm256_castpd256_pd128(d), _mm256_extractf128_pd(d, 1));
+    return _mm_cvtsd_f64(_mm_add_sd(s, _mm_unpackhi_pd(s, s)));
+  }
+
+  AVX2_IMPLEMENTATION
+  static __m256d add_products(__m256d d, __m256 p)
+  {
+    d= _mm256_add_pd(d, _mm256_cvtps_pd(_mm256_castps256_ps128(p)));
+    return _mm256_add_pd(d, _mm256_cvtps_pd(_mm256_extractf128_ps(p, 1)));
+  }
+
+  AVX2_IMPLEMENTATION
+  static double euclidean2_avx2(const float *v1, const float *v2, size_t len)
+  {
+    __m256d d= _mm256_setzero_pd();
+    size_t i= 0;
+    for (; i + 8 <= len; i+= 8)
+    {
+      __m256 diff= _mm256_sub_ps(_mm256_loadu_ps(v1 + i),
+                                 _mm256_loadu_ps(v2 + i));
+      d= add_products(d, _mm256_mul_ps(diff, diff));
+    }
+    return hsum(d) + euclidean2_default(v1 + i, v2 + i, len - i);
+  }
+
+  AVX2_IMPLEMENTATION
+  static void cosine_avx2(const float *v1, const float *v2, size_t len,
+                          double *dotp, double *abs1, double *abs2)
+  {
+    __m256d d= _mm256_setzero_pd(), a1= d, a2= d;
+    size_t i= 0;
+    for (; i + 8 <= len; i+= 8)
+    {
+      __m256 f1= _mm256_loadu_ps(v1 + i), f2= _mm256_loadu_ps(v2 + i);
+      a1= add_products(a1, _mm256_mul_ps(f1, f1));
+      a2= add_products(a2, _mm256_mul_ps(f2, f2));
+      d= add_products(d, _mm256_mul_ps(f1, f2));
+    }
+    *dotp+= hsum(d);
+    *abs1+= hsum(a1);
+    *abs2+= hsum(a2);
+    cosine_default(v1 + i, v2 + i, len - i, dotp, abs1, abs2);
+  }
+
+  AVX2_IMPLEMENTATION
+  static float abs2_avx2(const float *v, size_t len)
+  {
+    __m256 s= _mm256_setzero_ps();
+    size_t i= 0;
+    for (; i + 8 <= len; i+= 8)
+    {
+      __m256 f= _mm256_loadu_ps(v + i);
+      s= _mm256_add_ps(s, _mm256_mul_ps(f, f));
+    }
+    __m128 h= _mm_add_ps(_mm256_castps256_ps128(s), _mm256_extractf128_ps(s, 1));
+    h= _mm_add_ps(h, _mm_movehl_ps(h, h));
+    h= _mm_add_ss(h, _mm_shuffle_ps(h, h, 1));
+    return _mm_cvtss_f32(h) + abs2_default(v + i, len - i);
+  }
+
+  AVX2_IMPLEMENTATION
+  static double euclidean2(const float *v1, const float *v2, size_t len)
+  { return euclidean2_avx2(v1, v2, len); }
+
+  AVX2_IMPLEMENTATION
+  static void cosine(const float *v1, const float *v2, size_t len,
+                     double *dotp, double *abs1, double *abs2)
+  { cosine_avx2(v1, v2, len, dotp, abs1, abs2); }
+
+  AVX2_IMPLEMENTATION
+  static float abs2(const float *v, size_t len)
+  { return abs2_avx2(v, len); }
+#endif
+
+#ifdef NEON_IMPLEMENTATION
+  static float64x2_t add_products(float64x2_t d, float32x4_t p)
+  {
+    d= vaddq_f64(d, vcvt_f64_f32(vget_low_f32(p)));
+    return vaddq_f64(d, vcvt_high_f64_f32(p));
+  }
+
+  static double euclidean2_neon(const float *v1, const float *v2, size_t len)
+  {
+    float64x2_t d= vdupq_n_f64(0);
+    size_t i= 0;
+    for (; i + 4 <= len; i+= 4)
+    {
+      float32x4_t diff= vsubq_f32(vld1q_f32(v1 + i), vld1q_f32(v2 + i));
+      d= add_products(d, vmulq_f32(diff, diff));
+    }
+    return vaddvq_f64(d) + euclidean2_default(v1 + i, v2 + i, len - i);
+  }
+
+  static void cosine_neon(const float *v1, const float *v2, size_t len,
+                          double *dotp, double *abs1, double *abs2)
+  {
+    float64x2_t d= vdupq_n_f64(0), a1= d, a2= d;
+    size_t i= 0;
+    for (; i + 4 <= len; i+= 4)
+    {
+      float32x4_t f1= vld1q_f32(v1 + i), f2= vld1q_f32(v2 + i);
+      a1= add_products(a1, vmulq_f32(f1, f1));
+      a2= add_products(a2, vmulq_f32(f2, f2));
+      d= add_products(d, vmulq_f32(f1, f2));
+    }
+    *dotp+= vaddvq_f64(d);
+    *abs1+= vaddvq_f64(a1);
+    *abs2+= vaddvq_f64(a2);
+    cosine_default(v1 + i, v2 + i, len - i, dotp, abs1, abs2);
+  }
+
+  static float abs2_neon(const float *v, size_t len)
+  {
+    float32x4_t s= vdupq_n_f32(0);
+    size_t i= 0;
+    for (; i + 4 <= len; i+= 4)
+    {
+      float32x4_t f= vld1q_f32(v + i);
+      s= vaddq_f32(s, vmulq_f32(f, f));
+    }
+    return vaddvq_f32(s) + abs2_default(v + i, len - i);
+  }
+
+  static double euclidean2(const float *v1, const float *v2, size_t len)
+  { return euclidean2_neon(v1, v2, len); }
+
+  static void cosine(const float *v1, const float *v2, size_t len,
+                     double *dotp, double *abs1, double *abs2)
+  { cosine_neon(v1, v2, len, dotp, abs1, abs2); }
+
+  static float abs2(const float *v, size_t len)
+  { return abs2_neon(v, len); }
+#else
+  DEFAULT_IMPLEMENTATION
+  static double euclidean2(const float *v1, const float *v2, size_t len)
+  { return euclidean2_default(v1, v2, len); }
+
+  DEFAULT_IMPLEMENTATION
+  static void cosine(const float *v1, const float *v2, size_t len,
+                     double *dotp, double *abs1, double *abs2)
+  { cosine_default(v1, v2, len, dotp, abs1, abs2); }
+
+  DEFAULT_IMPLEMENTATION
+  static float abs2(const float *v, size_t len)
+  { return abs2_default(v, len); }
+#endif
+};
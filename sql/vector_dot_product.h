@@ -0,0 +1,161 @@
+/*
+   Copyright (c) 2024, MariaDB plc
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1335  USA
+*/
+
+/*
+  Dot product kernels for quantized vectors of the MHNSW index
+
+  Every variant has its own name, so that they can be compared with each
+  other (see unittest/sql/vector_dot_product-t.cc), the runtime dispatch
+  happens in FVector::dot_product().
+
+  SIMD variants process whole registers, the caller must zero-pad vectors
+  to a multiple of *_bytes (see FVector::fix_tail()), AVX variants
+  also need vectors aligned to *_bytes.
+*/
+
+#pragma once
+#include "bloom_filters.h"                      // *_IMPLEMENTATION
+
+#ifdef AVX2_IMPLEMENTATION
+static constexpr size_t AVX2_bytes= 256/8;
+
+AVX2_IMPLEMENTATION
+static inline float dot_product_avx2(const int16_t *v1, const int16_t *v2,
+                                     size_t len)
+{
+  typedef float v8f __attribute__((vector_size(AVX2_bytes)));
+  union { v8f v; __m256 i; } tmp;
+  __m256i *p1= (__m256i*)v1;
+  __m256i *p2= (__m256i*)v2;
+  v8f d= {0};
+  const size_t dims= AVX2_bytes/sizeof(int16_t);
+  for (size_t i= 0; i < (len + dims-1)/dims; p1++, p2++, i++)
+  {
+    tmp.i= _mm256_cvtepi32_ps(_mm256_madd_epi16(*p1, *p2));
+    d+= tmp.v;
+  }
+  return d[0] + d[1] + d[2] + d[3] + d[4] + d[5] + d[6] + d[7];
+}
+
+AVX2_IMPLEMENTATION
+static inline float dot_product_avx2(const int8_t *v1, const int8_t *v2,
+                                     size_t len)
+{
+  typedef float v8f __attribute__((vector_size(AVX2_bytes)));
+  union { v8f v; __m256 i; } tmp;
+  __m128i *p1= (__m128i*)v1;
+  __m128i *p2= (__m128i*)v2;
+  v8f d= {0};
+  const size_t dims= AVX2_bytes/sizeof(int16_t);
+  for (size_t i= 0; i < (len + dims-1)/dims; p1++, p2++, i++)
+  {
+    __m256i a= _mm256_cvtepi8_epi16(_mm_load_si128(p1));
+    __m256i b= _mm256_cvtepi8_epi16(_mm_load_si128(p2));
+    tmp.i= _mm256_cvtepi32_ps(_mm256_madd_epi16(a, b));
+    d+= tmp.v;
+  }
+  return d[0] + d[1] + d[2] + d[3] + d[4] + d[5] + d[6] + d[7];
+}
+#endif
+
+#ifdef AVX512_IMPLEMENTATION
+static constexpr size_t AVX512_bytes= 512/8;
+
+AVX512_IMPLEMENTATION
+static inline float dot_product_avx512(const int16_t *v1, const int16_t *v2,
+                                       size_t len)
+{
+  __m512i *p1= (__m512i*)v1;
+  __m512i *p2= (__m512i*)v2;
+  __m512 d= _mm512_setzero_ps();
+  const size_t dims= AVX512_bytes/sizeof(int16_t);
+  for (size_t i= 0; i < (len + dims-1)/dims; p1++, p2++, i++)
+    d= _mm512_add_ps(d, _mm512_cvtepi32_ps(_mm512_madd_epi16(*p1, *p2)));
+  return _mm512_reduce_add_ps(d);
+}
+
+AVX512_IMPLEMENTATION
+static inline float dot_product_avx512(const int8_t *v1, const int8_t *v2,
+                                       size_t len)
+{
+  __m256i *p1= (__m256i*)v1;
+  __m256i *p2= (__m256i*)v2;
+  __m512 d= _mm512_setzero_ps();
+  const size_t dims= AVX512_bytes/sizeof(int16_t);
+  for (size_t i= 0; i < (len + dims-1)/dims; p1++, p2++, i++)
+  {
+    __m512i a= _mm512_cvtepi8_epi16(_mm256_load_si256(p1));
+    __m512i b= _mm512_cvtepi8_epi16(_mm256_load_si256(p2));
+    d= _mm512_add_ps(d, _mm512_cvtepi32_ps(_mm512_madd_epi16(a, b)));
+  }
+  return _mm512_reduce_add_ps(d);
+}
+#endif
+
+#ifdef NEON_IMPLEMENTATION
+static constexpr size_t NEON_bytes= 128/8;
+
+/*
+  vmull+vmlal of two int16 pairs can't overflow int32,
+  as coordinates are in [-32767, 32767]
+*/
+static inline float dot_product_neon(const int16_t *v1, const int16_t *v2,
+                                     size_t len)
+{
+  int64x2_t d= vdupq_n_s64(0);
+  const size_t dims= NEON_bytes/sizeof(int16_t);
+  for (size_t i= 0; i < (len + dims-1)/dims; v1+= dims, v2+= dims, i++)
+  {
+    int16x8_t a= vld1q_s16(v1), b= vld1q_s16(v2);
+    int32x4_t p= vmull_s16(vget_low_s16(a), vget_low_s16(b));
+    d= vpadalq_s32(d, vmlal_high_s16(p, a, b));
+  }
+  return static_cast<float>(vaddvq_s64(d));
+}
+
+static inline float dot_product_neon(const int8_t *v1, const int8_t *v2,
+                                     size_t len)
+{
+  int32x4_t d= vdupq_n_s32(0);
+  const size_t dims= NEON_bytes/sizeof(int8_t);
+  for (size_t i= 0; i < (len + dims-1)/dims; v1+= dims, v2+= dims, i++)
+  {
+    int8x16_t a= vld1q_s8(v1), b= vld1q_s8(v2);
+    int16x8_t p= vmull_s8(vget_low_s8(a), vget_low_s8(b));
+    d= vpadalq_s16(d, vmlal_high_s8(p, a, b));
+  }
+  return static_cast<float>(vaddvq_s32(d));
+}
+#endif
+
+static inline float dot_product_default(const int16_t *v1, const int16_t *v2,
+                                        size_t len)
+{
+  int64_t d= 0;
+  for (size_t i= 0; i < len; i++)
+    d+= int32_t(v1[i]) * int32_t(v2[i]);
+  return static_cast<float>(d);
+}
+
+static inline float dot_product_default(const int8_t *v1, const int8_t *v2,
+                                        size_t len)
+{
+  int64_t d= 0;
+  for (size_t i= 0; i < len; i++)
+    d+= int32_t(v1[i]) * int32_t(v2[i]);
+  return static_cast<float>(d);
+}
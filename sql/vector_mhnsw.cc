@@ -21,9 +21,16 @@
 #include "table_cache.h"
 #include "vector_mhnsw.h"
 #include "item_vectorfunc.h"
+#include "rowid_filter.h"
+#include "sql_i_s.h"
+#include "sql_show.h"
+#include "sql_parse.h"                          // check_table_access()
 #include <scope.h>
 #include <my_atomic_wrapper.h>
 #include "bloom_filters.h"
+#include "vector_dot_product.h"
+#include <thread>
+#include <vector>
 
 // distance can be a little bit < 0 because of fast math
 static constexpr float NEAREST = -1.0f;
@@ -37,6 +44,13 @@ static ulonglong mhnsw_max_cache_size;
 static MYSQL_SYSVAR_ULONGLONG(max_cache_size, mhnsw_max_cache_size,
        PLUGIN_VAR_RQCMDARG, "Upper limit for one MHNSW vector index cache",
        nullptr, nullptr, 16*1024*1024, 1024*1024, SIZE_T_MAX, 1);
+static uint mhnsw_cache_preload_pct;
+static MYSQL_SYSVAR_UINT(cache_preload_pct, mhnsw_cache_preload_pct,
+       PLUGIN_VAR_RQCMDARG, "Percentage of mhnsw_max_cache_size to fill "
+       "with graph nodes, top layers first, when the vector index cache is "
+       "created. Makes first searches after a restart as fast as later ones, "
+       "at the cost of a slower first access to the index",
+       nullptr, nullptr, 0, 0, 100, 1);
 static MYSQL_THDVAR_UINT(ef_search, PLUGIN_VAR_RQCMDARG,
        "Larger values mean slower SELECTs but more accurate results. "
        "Defines the minimal number of result candidates to look for in the "
@@ -47,6 +61,11 @@ static MYSQL_THDVAR_UINT(default_m, PLUGIN_VAR_RQCMDARG,
        "Larger values mean slower SELECTs and INSERTs, larger index size "
        "and higher memory consumption but more accurate results",
        nullptr, nullptr, 6, 3, 200, 1);
+static MYSQL_THDVAR_UINT(build_threads, PLUGIN_VAR_RQCMDARG,
+       "Number of threads to use when ALTER TABLE builds a vector index. "
+       "Larger values mean faster index creation on multi-core machines, "
+       "1 means the index is built in the connection thread",
+       nullptr, nullptr, 1, 1, 256, 1);
 
 enum metric_type : uint { EUCLIDEAN, COSINE };
 static const char *distance_names[]= { "euclidean", "cosine", nullptr };
@@ -55,10 +74,18 @@ static MYSQL_THDVAR_ENUM(default_distance, PLUGIN_VAR_RQCMDARG,
        "Distance function to build the vector index for",
        nullptr, nullptr, EUCLIDEAN, &distances);
 
+/*
+  How coordinates are stored in the graph: INT16 is precise enough to
+  order candidates, INT8 takes half the memory, but final candidates are
+  reranked by the exact distance, see rerank()
+*/
+enum quant_type : uint { INT16, INT8 };
+
 struct ha_index_option_struct
 {
   ulonglong M; // option struct does not support uint
   metric_type metric;
+  quant_type quantization;
 };
 
 enum Graph_table_fields {
@@ -73,6 +100,9 @@ class FVectorNode;
 
 /*
   One vector, an array of coordinates in ctx->vec_len dimensions
+
+  Coordinates are int16_t or, for INT8 quantization, int8_t,
+  see i8() and dims_size()
 */
 #pragma pack(push, 1)
 struct FVector
@@ -84,14 +114,19 @@ struct FVector
   int16_t dims[4];
 
   uchar *data() const { return (uchar*)(&scale); }
+  int8_t *i8() const { return (int8_t*)dims; }
+
+  static size_t dims_size(size_t n, quant_type q)
+  { return q == INT8 ? n : n*2; }
 
-  static size_t data_size(size_t n)
-  { return data_header + n*2; }
+  static size_t data_size(size_t n, quant_type q)
+  { return data_header + dims_size(n, q); }
 
-  static size_t data_to_value_size(size_t data_size)
-  { return (data_size - data_header)*2; }
+  static size_t data_to_value_size(size_t data_size, quant_type q)
+  { return (data_size - data_header) * (q == INT8 ? 4 : 2); }
 
-  static const FVector *create(metric_type metric, void *mem, const void *src, size_t src_len)
+  static const FVector *create(metric_type metric, quant_type q, void *mem,
+                               const void *src, size_t src_len)
   {
     float scale=0, *v= (float *)src;
     size_t vec_len= src_len / sizeof(float);
@@ -99,11 +134,20 @@ struct FVector
       if (std::abs(scale) < std::abs(get_float(v + i)))
         scale= get_float(v + i);
 
-    FVector *vec= align_ptr(mem);
-    vec->scale= scale ? scale/32767 : 1;
-    for (size_t i= 0; i < vec_len; i++)
-      vec->dims[i] = static_cast<int16_t>(std::round(get_float(v + i) / vec->scale));
-    vec->postprocess(vec_len);
+    FVector *vec= align_ptr(mem, q);
+    if (q == INT8)
+    {
+      vec->scale= scale ? scale/127 : 1;
+      for (size_t i= 0; i < vec_len; i++)
+        vec->i8()[i] = static_cast<int8_t>(std::round(get_float(v + i) / vec->scale));
+    }
+    else
+    {
+      vec->scale= scale ? scale/32767 : 1;
+      for (size_t i= 0; i < vec_len; i++)
+        vec->dims[i] = static_cast<int16_t>(std::round(get_float(v + i) / vec->scale));
+    }
+    vec->postprocess(vec_len, q);
     if (metric == COSINE)
     {
       if (vec->abs2 > 0.0f)
@@ -113,104 +157,115 @@ struct FVector
     return vec;
   }
 
-  void postprocess(size_t vec_len)
+  void postprocess(size_t vec_len, quant_type q)
+  {
+    fix_tail(dims_size(vec_len, q));
+    abs2= scale * scale * dot_product(this, vec_len, q) / 2;
+  }
+
+  float dot_product(const FVector *other, size_t vec_len, quant_type q) const
   {
-    fix_tail(vec_len);
-    abs2= scale * scale * dot_product(dims, dims, vec_len) / 2;
+    return q == INT8 ? dot_product(i8(), other->i8(), vec_len)
+                     : dot_product(dims, other->dims, vec_len);
   }
 
 #ifdef AVX2_IMPLEMENTATION
   /************* AVX2 *****************************************************/
-  static constexpr size_t AVX2_bytes= 256/8;
-  static constexpr size_t AVX2_dims= AVX2_bytes/sizeof(int16_t);
-
   AVX2_IMPLEMENTATION
   static float dot_product(const int16_t *v1, const int16_t *v2, size_t len)
-  {
-    typedef float v8f __attribute__((vector_size(AVX2_bytes)));
-    union { v8f v; __m256 i; } tmp;
-    __m256i *p1= (__m256i*)v1;
-    __m256i *p2= (__m256i*)v2;
-    v8f d= {0};
-    for (size_t i= 0; i < (len + AVX2_dims-1)/AVX2_dims; p1++, p2++, i++)
-    {
-      tmp.i= _mm256_cvtepi32_ps(_mm256_madd_epi16(*p1, *p2));
-      d+= tmp.v;
-    }
-    return d[0] + d[1] + d[2] + d[3] + d[4] + d[5] + d[6] + d[7];
-  }
+  { return dot_product_avx2(v1, v2, len); }
+
+  AVX2_IMPLEMENTATION
+  static float dot_product(const int8_t *v1, const int8_t *v2, size_t len)
+  { return dot_product_avx2(v1, v2, len); }
 
   AVX2_IMPLEMENTATION
-  static size_t alloc_size(size_t n)
-  { return alloc_header + MY_ALIGN(n*2, AVX2_bytes) + AVX2_bytes - 1; }
+  static size_t alloc_size(size_t n, quant_type q)
+  { return alloc_header + MY_ALIGN(dims_size(n, q), AVX2_bytes) + AVX2_bytes - 1; }
 
   AVX2_IMPLEMENTATION
-  static FVector *align_ptr(void *ptr)
+  static FVector *align_ptr(void *ptr, quant_type)
   { return (FVector*)(MY_ALIGN(((intptr)ptr) + alloc_header, AVX2_bytes)
                       - alloc_header); }
 
   AVX2_IMPLEMENTATION
-  void fix_tail(size_t vec_len)
+  void fix_tail(size_t bytes)
   {
-    bzero(dims + vec_len, (MY_ALIGN(vec_len, AVX2_dims) - vec_len)*2);
+    bzero(((uchar*)dims) + bytes, MY_ALIGN(bytes, AVX2_bytes) - bytes);
   }
 #endif
 
 #ifdef AVX512_IMPLEMENTATION
   /************* AVX512 ****************************************************/
-  static constexpr size_t AVX512_bytes= 512/8;
-  static constexpr size_t AVX512_dims= AVX512_bytes/sizeof(int16_t);
-
   AVX512_IMPLEMENTATION
   static float dot_product(const int16_t *v1, const int16_t *v2, size_t len)
-  {
-    __m512i *p1= (__m512i*)v1;
-    __m512i *p2= (__m512i*)v2;
-    __m512 d= _mm512_setzero_ps();
-    for (size_t i= 0; i < (len + AVX512_dims-1)/AVX512_dims; p1++, p2++, i++)
-      d= _mm512_add_ps(d, _mm512_cvtepi32_ps(_mm512_madd_epi16(*p1, *p2)));
-    return _mm512_reduce_add_ps(d);
-  }
+  { return dot_product_avx512(v1, v2, len); }
 
   AVX512_IMPLEMENTATION
-  static size_t alloc_size(size_t n)
-  { return alloc_header + MY_ALIGN(n*2, AVX512_bytes) + AVX512_bytes - 1; }
+  static float dot_product(const int8_t *v1, const int8_t *v2, size_t len)
+  { return dot_product_avx512(v1, v2, len); }
 
   AVX512_IMPLEMENTATION
-  static FVector *align_ptr(void *ptr)
+  static size_t alloc_size(size_t n, quant_type q)
+  { return alloc_header + MY_ALIGN(dims_size(n, q), AVX512_bytes) + AVX512_bytes - 1; }
+
+  AVX512_IMPLEMENTATION
+  static FVector *align_ptr(void *ptr, quant_type)
   { return (FVector*)(MY_ALIGN(((intptr)ptr) + alloc_header, AVX512_bytes)
                       - alloc_header); }
 
   AVX512_IMPLEMENTATION
-  void fix_tail(size_t vec_len)
+  void fix_tail(size_t bytes)
   {
-    bzero(dims + vec_len, (MY_ALIGN(vec_len, AVX512_dims) - vec_len)*2);
+    bzero(((uchar*)dims) + bytes, MY_ALIGN(bytes, AVX512_bytes) - bytes);
   }
 #endif
 
-  /************* no-SIMD default ******************************************/
-  DEFAULT_IMPLEMENTATION
+#ifdef NEON_IMPLEMENTATION
+  /************* ARM NEON **************************************************
+    NEON is always available on aarch64, so there is no runtime dispatch
+    and no default variant
+  */
   static float dot_product(const int16_t *v1, const int16_t *v2, size_t len)
+  { return dot_product_neon(v1, v2, len); }
+
+  static float dot_product(const int8_t *v1, const int8_t *v2, size_t len)
+  { return dot_product_neon(v1, v2, len); }
+
+  static size_t alloc_size(size_t n, quant_type q)
+  { return alloc_header + MY_ALIGN(dims_size(n, q), NEON_bytes); }
+
+  static FVector *align_ptr(void *ptr, quant_type) { return (FVector*)ptr; }
+
+  void fix_tail(size_t bytes)
   {
-    int64_t d= 0;
-    for (size_t i= 0; i < len; i++)
-      d+= int32_t(v1[i]) * int32_t(v2[i]);
-    return static_cast<float>(d);
+    bzero(((uchar*)dims) + bytes, MY_ALIGN(bytes, NEON_bytes) - bytes);
   }
+#else
+  /************* no-SIMD default ******************************************/
+  DEFAULT_IMPLEMENTATION
+  static float dot_product(const int16_t *v1, const int16_t *v2, size_t len)
+  { return dot_product_default(v1, v2, len); }
 
   DEFAULT_IMPLEMENTATION
-  static size_t alloc_size(size_t n) { return alloc_header + n*2; }
+  static float dot_product(const int8_t *v1, const int8_t *v2, size_t len)
+  { return dot_product_default(v1, v2, len); }
 
   DEFAULT_IMPLEMENTATION
-  static FVector *align_ptr(void *ptr) { return (FVector*)ptr; }
+  static size_t alloc_size(size_t n, quant_type q)
+  { return alloc_header + dims_size(n, q); }
+
+  DEFAULT_IMPLEMENTATION
+  static FVector *align_ptr(void *ptr, quant_type) { return (FVector*)ptr; }
 
   DEFAULT_IMPLEMENTATION
   void fix_tail(size_t) {  }
+#endif
 
-  float distance_to(const FVector *other, size_t vec_len) const
+  float distance_to(const FVector *other, size_t vec_len, quant_type q) const
   {
     return abs2 + other->abs2 - scale * other->scale *
-           dot_product(dims, other->dims, vec_len);
+           dot_product(other, vec_len, q);
   }
 };
 #pragma pack(pop)
@@ -276,7 +331,7 @@ class FVectorNode
   const FVector *vec= nullptr;
   Neighborhood *neighbors= nullptr;
   uint8_t max_layer;
-  bool stored:1, deleted:1;
+  bool stored:1, deleted:1, dirty:1, changed:1;
 
   FVectorNode(MHNSW_Share *ctx_, const void *gref_);
   FVectorNode(MHNSW_Share *ctx_, const void *tref_, uint8_t layer,
@@ -290,6 +345,7 @@ class FVectorNode
   uchar *gref() const;
   uchar *tref() const;
   void push_neighbor(size_t layer, FVectorNode *v);
+  void publish(const FVectorNode &from);
 
   static uchar *get_key(const FVectorNode *elem, size_t *key_len, my_bool);
 };
@@ -325,7 +381,7 @@ class MHNSW_Share : public Sql_alloc
   void *alloc_node_internal()
   {
     return alloc_root(&root, sizeof(FVectorNode) + gref_len + tref_len
-                      + FVector::alloc_size(vec_len));
+                      + FVector::alloc_size(vec_len, quantization));
   }
 
 protected:
@@ -341,16 +397,25 @@ class MHNSW_Share : public Sql_alloc
   Atomic_relaxed<double> ef_power{0.6}; // for the bloom filter size heuristic
   Atomic_relaxed<float>  diameter{0};   // for the generosity heuristic
   FVectorNode *start= 0;
+  std::atomic<bool> preloaded{false};
+
+  /* statistics, see INFORMATION_SCHEMA.MHNSW_STATISTICS */
+  ulonglong cache_hits= 0, cache_misses= 0; // protected by cache_lock
+  Atomic_relaxed<ulonglong> nodes_loaded{0}, searches{0}, layers_searched{0},
+                            ef_total{0}, distances{0};
+
   const uint tref_len;
   const uint gref_len;
   const uint M;
   metric_type metric;
+  quant_type quantization;
 
   MHNSW_Share(TABLE *t)
     : tref_len(t->file->ref_length),
       gref_len(t->hlindex->file->ref_length),
       M(static_cast<uint>(t->s->key_info[t->s->keys].option_struct->M)),
-      metric(t->s->key_info[t->s->keys].option_struct->metric)
+      metric(t->s->key_info[t->s->keys].option_struct->metric),
+      quantization(t->s->key_info[t->s->keys].option_struct->quantization)
   {
     mysql_rwlock_init(PSI_INSTRUMENT_ME, &commit_lock);
     mysql_mutex_init(PSI_INSTRUMENT_ME, &cache_lock, MY_MUTEX_INIT_FAST);
@@ -387,6 +452,22 @@ class MHNSW_Share : public Sql_alloc
     return (layer ? 1 : 2) * M; // heuristic from the paper
   }
 
+  /* size, nodes, hits, misses */
+  void cache_stats(ulonglong *stats)
+  {
+    mysql_mutex_lock(&cache_lock);
+    stats[0]= root_size(&root);
+    stats[1]= node_cache.size();
+    stats[2]= cache_hits;
+    stats[3]= cache_misses;
+    mysql_mutex_unlock(&cache_lock);
+  }
+
+  bool cache_is_full()
+  {
+    return root_size(&root) > mhnsw_max_cache_size;
+  }
+
   void set_lengths(size_t len)
   {
     byte_len= len;
@@ -395,6 +476,7 @@ class MHNSW_Share : public Sql_alloc
 
   static int acquire(MHNSW_Share **ctx, TABLE *table, bool for_update);
   static MHNSW_Share *get_from_share(TABLE_SHARE *share, TABLE *table);
+  int preload(TABLE *graph);
 
   virtual void reset(TABLE_SHARE *share)
   {
@@ -438,7 +520,10 @@ class MHNSW_Share : public Sql_alloc
     {
       node= new (alloc_node_internal()) FVectorNode(this, gref);
       cache_internal(node);
+      cache_misses++;
     }
+    else
+      cache_hits++;
     mysql_mutex_unlock(&cache_lock);
     return node;
   }
@@ -593,13 +678,18 @@ int MHNSW_Trx::do_commit(THD *thd, bool)
             ctx->reset(share);
           else
           {
-            // consider copying nodes from trx to shared cache when it makes
-            // sense. for ann_benchmarks it does not.
-            // also, consider flushing only changed nodes (a flag in the node)
+            /*
+              only nodes that the transaction has modified can differ,
+              their new links are copied into the shared cache. New nodes
+              are not copied, they're loaded when first reached
+            */
             for (FVectorNode &from : trx->get_cache())
-              if (FVectorNode *node= ctx->find_node(from.gref()))
-                node->vec= nullptr;
-            ctx->start= nullptr;
+              if (from.changed)
+                if (FVectorNode *node= ctx->find_node(from.gref()))
+                  node->publish(from);
+            if (!trx->start || !ctx->start ||
+                ctx->find_node(trx->start->gref()) != ctx->start)
+              ctx->start= nullptr;
           }
           ctx->release(true, share);
         }
@@ -666,7 +756,8 @@ int MHNSW_Share::acquire(MHNSW_Share **ctx, TABLE *table, bool for_update)
 {
   TABLE *graph= table->hlindex;
 
-  if (!(*ctx= MHNSW_Trx::get_from_thd(table, for_update)))
+  MHNSW_Trx *trx= MHNSW_Trx::get_from_thd(table, for_update);
+  if (!(*ctx= trx))
   {
     *ctx= MHNSW_Share::get_from_share(table->s, table);
     if (table->file->has_transactions())
@@ -685,26 +776,61 @@ int MHNSW_Share::acquire(MHNSW_Share **ctx, TABLE *table, bool for_update)
     return err;
 
   graph->file->position(graph->record[0]);
-  (*ctx)->set_lengths(FVector::data_to_value_size(graph->field[FIELD_VEC]->value_length()));
+  (*ctx)->set_lengths(FVector::data_to_value_size(
+                  graph->field[FIELD_VEC]->value_length(), (*ctx)->quantization));
   (*ctx)->start= (*ctx)->get_node(graph->file->ref);
-  return (*ctx)->start->load_from_record(graph);
+  if (int err= (*ctx)->start->load_from_record(graph))
+    return err;
+  return trx ? 0 : (*ctx)->preload(graph);
+}
+
+/*
+  Fills the shared cache with nodes, highest layers first
+
+  Every search starts from the top layer and goes down, so upper layer
+  nodes are hot for any query. They are loaded in one index scan instead of
+  random FVectorNode::load() calls of first searches after the restart.
+  Done only once per cache, see mhnsw_cache_preload_pct.
+*/
+int MHNSW_Share::preload(TABLE *graph)
+{
+  const ulonglong limit= mhnsw_max_cache_size / 100 * mhnsw_cache_preload_pct;
+  if (!limit || preloaded.exchange(true))
+    return 0;
+
+  if (int err= graph->file->ha_index_init(IDX_LAYER, 1))
+    return err;
+
+  int err= graph->file->ha_index_last(graph->record[0]);
+  while (!err && root_size(&root) < limit)
+  {
+    graph->file->position(graph->record[0]);
+    err= get_node(graph->file->ref)->load_from_record(graph);
+    if (!err)
+      err= graph->file->ha_index_prev(graph->record[0]);
+  }
+  graph->file->ha_index_end();
+  return err == HA_ERR_END_OF_FILE ? 0 : err;
 }
 
 /* copy the vector, preprocessed as needed */
 const FVector *FVectorNode::make_vec(const void *v)
 {
-  return FVector::create(ctx->metric, tref() + tref_len(), v, ctx->byte_len);
+  return FVector::create(ctx->metric, ctx->quantization, tref() + tref_len(),
+                         v, ctx->byte_len);
 }
 
 FVectorNode::FVectorNode(MHNSW_Share *ctx_, const void *gref_)
-  : ctx(ctx_), stored(true), deleted(false)
+  : ctx(ctx_), stored(true), deleted(false), dirty(false),
+    changed(false)
 {
   memcpy(gref(), gref_, gref_len());
 }
 
 FVectorNode::FVectorNode(MHNSW_Share *ctx_, const void *tref_, uint8_t layer,
                          const void *vec_)
-  : ctx(ctx_), stored(false), deleted(false)
+  : ctx(ctx_), stored(false), deleted(false), dirty(false),
+    changed(false)
 {
   DBUG_ASSERT(tref_);
   memset(gref(), 0xff, gref_len()); // important: larger than any real gref
@@ -716,7 +842,7 @@ FVectorNode::FVectorNode(MHNSW_Share *ctx_, const void *tref_, uint8_t layer,
 
 float FVectorNode::distance_to(const FVector *other) const
 {
-  return vec->distance_to(other, ctx->vec_len);
+  return vec->distance_to(other, ctx->vec_len, ctx->quantization);
 }
 
 int FVectorNode::alloc_neighborhood(uint8_t layer)
@@ -767,11 +893,11 @@ int FVectorNode::load_from_record(TABLE *graph)
   if (unlikely(!v))
     return my_errno= HA_ERR_CRASHED;
 
-  if (v->length() != FVector::data_size(ctx->vec_len))
+  if (v->length() != FVector::data_size(ctx->vec_len, ctx->quantization))
     return my_errno= HA_ERR_CRASHED;
-  FVector *vec_ptr= FVector::align_ptr(tref() + tref_len());
+  FVector *vec_ptr= FVector::align_ptr(tref() + tref_len(), ctx->quantization);
   memcpy(vec_ptr->data(), v->ptr(), v->length());
-  vec_ptr->postprocess(ctx->vec_len);
+  vec_ptr->postprocess(ctx->vec_len, ctx->quantization);
 
   longlong layer= graph->field[FIELD_LAYER]->val_int();
   if (layer > 100) // 10e30 nodes at M=2, more at larger M's
@@ -797,6 +923,7 @@ int FVectorNode::load_from_record(TABLE *graph)
     for (size_t j=0; j < grefs; j++, ptr+= gref_len())
       neighbors[i].links[j]= ctx->get_node(ptr);
   }
+  ctx->nodes_loaded+= 1;
   vec= vec_ptr; // must be done at the very end
   return 0;
 }
@@ -876,8 +1003,9 @@ class VisitedSet
   one extra candidate is specified separately to avoid appending it to
   the Neighborhood candidates, which might be already at its max size.
 */
-static int select_neighbors(MHNSW_Share *ctx, TABLE *graph, size_t layer,
-                            FVectorNode &target, const Neighborhood &candidates,
+static int select_neighbors(MHNSW_Share *ctx, TABLE *graph, MEM_ROOT *root,
+                            size_t layer, FVectorNode &target,
+                            const Neighborhood &candidates,
                             FVectorNode *extra_candidate,
                             size_t max_neighbor_connections)
 {
@@ -886,7 +1014,6 @@ static int select_neighbors(MHNSW_Share *ctx, TABLE *graph, size_t layer,
   if (pq.init(max_ef, false, Visited::cmp))
     return my_errno= HA_ERR_OUT_OF_MEM;
 
-  MEM_ROOT * const root= graph->in_use->mem_root;
   auto discarded= (Visited**)my_safe_alloca(sizeof(Visited**)*max_neighbor_connections);
   size_t discarded_num= 0;
   Neighborhood &neighbors= target.neighbors[layer];
@@ -941,7 +1068,8 @@ int FVectorNode::save(TABLE *graph)
     graph->field[FIELD_TREF]->set_notnull();
     graph->field[FIELD_TREF]->store_binary(tref(), tref_len());
   }
-  graph->field[FIELD_VEC]->store_binary(vec->data(), FVector::data_size(ctx->vec_len));
+  graph->field[FIELD_VEC]->store_binary(vec->data(),
+                         FVector::data_size(ctx->vec_len, ctx->quantization));
 
   size_t total_size= 0;
   for (size_t i=0; i <= max_layer; i++)
@@ -975,12 +1103,45 @@ int FVectorNode::save(TABLE *graph)
     stored= true;
     ctx->cache_node(this);
   }
+  changed= true;
   my_safe_afree(neighbor_blob, total_size);
   return err;
 }
 
+/*
+  Makes a cached node look like its committed copy from a transaction cache
+
+  Only links and the deleted flag can change, the vector and the layer
+  of a node are never updated. Must be called under exclusive
+  commit_lock, when nobody is traversing the graph.
+*/
+void FVectorNode::publish(const FVectorNode &from)
+{
+  if (!vec)
+    return; // not loaded, will be read from the graph table
+  if (!from.vec)
+  {
+    vec= nullptr; // only the deleted flag is known, reload it
+    return;
+  }
+  DBUG_ASSERT(max_layer == from.max_layer);
+  deleted= from.deleted;
+  for (size_t i= 0; i <= max_layer; i++)
+  {
+    neighbors[i].num= from.neighbors[i].num;
+    for (size_t j= 0; j < from.neighbors[i].num; j++)
+      neighbors[i].links[j]= ctx->get_node(from.neighbors[i].links[j]->gref());
+  }
+}
+
+/*
+  @param dirty  if not NULL, modified neighbors are not saved but
+                appended to this array (bulk build), see Bulk_context
+*/
 static int update_second_degree_neighbors(MHNSW_Share *ctx, TABLE *graph,
-                                          size_t layer, FVectorNode *node)
+                                          MEM_ROOT *root, size_t layer,
+                                          FVectorNode *node,
+                                          Dynamic_array<FVectorNode*> *dirty)
 {
   const uint max_neighbors= ctx->max_neighbors(layer);
   // it seems that one could update nodes in the gref order
@@ -992,11 +1153,20 @@ static int update_second_degree_neighbors(MHNSW_Share *ctx, TABLE *graph,
     if (neighneighbors.num < max_neighbors)
       neigh->push_neighbor(layer, node);
     else
-      if (int err= select_neighbors(ctx, graph, layer, *neigh, neighneighbors,
-                                    node, max_neighbors))
+      if (int err= select_neighbors(ctx, graph, root, layer, *neigh,
+                                    neighneighbors, node, max_neighbors))
         return err;
-    if (int err= neigh->save(graph))
-      return err;
+    if (!dirty)
+    {
+      if (int err= neigh->save(graph))
+        return err;
+    }
+    else if (!neigh->dirty)
+    {
+      neigh->dirty= true;
+      if (dirty->append(neigh))
+        return my_errno= HA_ERR_OUT_OF_MEM;
+    }
   }
   return 0;
 }
@@ -1012,16 +1182,61 @@ static inline float generous_furthest(const Queue<Visited> &q, float maxd, float
   return d*(1 + (g - 1)/2 * (1 - sigmoid));
 }
 
+/*
+  WHERE conditions of a filtered vector search
+
+  Nodes that don't pass the filter are still traversed, but never make
+  it into the result, so ORDER BY ... LIMIT gets its top-K from the matching
+  rows only. The rowid filter only needs the node's tref, the condition
+  needs the row, so it is checked last.
+*/
+class Search_filter: public Sql_alloc
+{
+  TABLE *table;
+  Item *cond;
+public:
+  Search_filter(TABLE *t, Item *c) : table(t), cond(c) {}
+
+  static Search_filter *create(TABLE *table, MEM_ROOT *root, Item *cond)
+  {
+    if (!table->file->pushed_rowid_filter || !table->file->rowid_filter_is_active)
+      if (!cond)
+        return NULL;
+    return new (root) Search_filter(table, cond);
+  }
+
+  int check(FVectorNode *node, bool *pass)
+  {
+    handler *h= table->file;
+    *pass= true;
+    if (h->pushed_rowid_filter && h->rowid_filter_is_active &&
+        !h->pushed_rowid_filter->check((char*)node->tref()))
+      *pass= false;
+    else if (cond)
+    {
+      int err= h->ha_rnd_pos(table->record[0], node->tref());
+      if (err == HA_ERR_RECORD_DELETED || err == HA_ERR_KEY_NOT_FOUND)
+        *pass= false;
+      else if (err)
+        return err;
+      else
+        *pass= cond->val_bool();
+    }
+    return 0;
+  }
+};
+
 /*
   @param[in/out] inout    in: start nodes, out: result nodes
+  @param[in]     filter   if not NULL, checked on layer 0 for result nodes
 */
-static int search_layer(MHNSW_Share *ctx, TABLE *graph, const FVector *target,
-                        float threshold, uint result_size,
-                        size_t layer, Neighborhood *inout, bool construction)
+static int search_layer(MHNSW_Share *ctx, TABLE *graph, MEM_ROOT *root,
+                        const FVector *target, float threshold,
+                        uint result_size, size_t layer, Neighborhood *inout,
+                        bool construction, Search_filter *filter)
 {
   DBUG_ASSERT(inout->num > 0);
 
-  MEM_ROOT * const root= graph->in_use->mem_root;
   Queue<Visited> candidates, best;
   bool skip_deleted;
   uint ef= result_size;
@@ -1036,6 +1251,8 @@ static int search_layer(MHNSW_Share *ctx, TABLE *graph, const FVector *target,
   else
   {
     skip_deleted= layer == 0;
+    if (layer)
+      filter= NULL;
     if (ef > 1 || layer == 0)
       ef= std::max(THDVAR(graph->in_use, ef_search), ef);
   }
@@ -1057,6 +1274,14 @@ static int search_layer(MHNSW_Share *ctx, TABLE *graph, const FVector *target,
     candidates.push(v);
     if ((skip_deleted && v->node->deleted) || threshold > NEAREST)
       continue;
+    if (filter)
+    {
+      bool pass;
+      if (int err= filter->check(v->node, &pass))
+        return err;
+      if (!pass)
+        continue;
+    }
     best.push(v);
   }
 
@@ -1090,9 +1315,17 @@ static int search_layer(MHNSW_Share *ctx, TABLE *graph, const FVector *target,
         if (!best.is_full())
         {
           max_distance= std::max(max_distance, v->distance_to_target);
-          candidates.push(v);
+          candidates.safe_push(v); // with a filter best can stay not full
           if (skip_deleted && v->node->deleted)
             continue;
+          if (filter)
+          {
+            bool pass;
+            if (int err= filter->check(v->node, &pass))
+              return err;
+            if (!pass)
+              continue;
+          }
           best.push(v);
           furthest_best= generous_furthest(best, max_distance, generosity);
         }
@@ -1103,6 +1336,14 @@ static int search_layer(MHNSW_Share *ctx, TABLE *graph, const FVector *target,
             continue;
           if (v->distance_to_target < best.top()->distance_to_target)
           {
+            if (filter)
+            {
+              bool pass;
+              if (int err= filter->check(v->node, &pass))
+                return err;
+              if (!pass)
+                continue;
+            }
             best.replace_top(v);
             furthest_best= generous_furthest(best, max_distance, generosity);
           }
@@ -1111,6 +1352,16 @@ static int search_layer(MHNSW_Share *ctx, TABLE *graph, const FVector *target,
     }
   }
   set_if_bigger(ctx->diameter, max_distance); // not atomic, but it's ok
+  if (!construction) // statistics are only about searches for queries
+  {
+    ctx->layers_searched+= 1;
+    ctx->distances+= visited.count;
+    if (layer == 0)
+    {
+      ctx->searches+= 1;
+      ctx->ef_total+= ef;
+    }
+  }
   if (ef > 1 && visited.count*2 > est_size)
   {
     double ef_power= std::log(visited.count*2/est_heuristic) / std::log(ef);
@@ -1128,11 +1379,280 @@ static int search_layer(MHNSW_Share *ctx, TABLE *graph, const FVector *target,
 }
 
 
+/*
+  finds neighbors of a new node on all its layers
+
+  Only reads the graph, the node itself is not linked into it yet.
+  The node must not be visible to other threads, so this can be run
+  concurrently for different nodes, see bulk_find_neighbors()
+*/
+static int find_neighbors(MHNSW_Share *ctx, TABLE *graph, MEM_ROOT *root,
+                          FVectorNode *start, FVectorNode *target)
+{
+  const size_t max_found= ctx->max_neighbors(0);
+  Neighborhood candidates;
+  candidates.init((FVectorNode**)alloc_root(root, sizeof(FVectorNode*) *
+                                            (max_found + 7)), max_found);
+  candidates.links[candidates.num++]= start;
+
+  int cur_layer;
+  for (cur_layer= start->max_layer; cur_layer > target->max_layer; cur_layer--)
+  {
+    if (int err= search_layer(ctx, graph, root, target->vec, NEAREST,
+                              1, cur_layer, &candidates, true, NULL))
+      return err;
+  }
+
+  for (; cur_layer >= 0; cur_layer--)
+  {
+    uint max_neighbors= ctx->max_neighbors(cur_layer);
+    if (int err= search_layer(ctx, graph, root, target->vec, NEAREST,
+                              max_neighbors, cur_layer, &candidates, true,
+                              NULL))
+      return err;
+
+    if (int err= select_neighbors(ctx, graph, root, cur_layer, *target,
+                                  candidates, 0, max_neighbors))
+      return err;
+  }
+  return 0;
+}
+
+
+/* creates a new node for the row in table->record[0], not linked yet */
+static FVectorNode *create_node(MHNSW_Share *ctx, TABLE *table,
+                                const String *vec)
+{
+  THD *thd= table->in_use;
+  const double NORMALIZATION_FACTOR= 1 / std::log(ctx->M);
+  double log= -std::log(my_rnd(&thd->rand)) * NORMALIZATION_FACTOR;
+  const uint8_t max_layer= ctx->start->max_layer;
+  uint8_t target_layer= std::min<uint8_t>(static_cast<uint8_t>(std::floor(log)), max_layer + 1);
+
+  return new (ctx->alloc_node())
+         FVectorNode(ctx, table->file->ref, target_layer, vec->ptr());
+}
+
+
+/*
+  Bulk build of the graph, used when ALTER TABLE populates a new table
+
+  Every row still gets its own node, but the graph is only modified in
+  memory and nodes are written into the graph table once, at the end.
+  The expensive part, searching the graph for neighbors of new nodes, is
+  done in batches by build_threads worker threads concurrently - they
+  search the graph as it was at the start of the batch and don't modify
+  it, so no locking is needed. Then the connection thread links the batch
+  into the graph. Nodes of one batch don't see each other, so batches
+  are kept small relatively to the graph size.
+
+  The graph being built must fit into mhnsw_max_cache_size, if it doesn't
+  the built part is written and remaining rows are inserted one by one.
+*/
+struct Bulk_context: public Sql_alloc
+{
+  MHNSW_Share *ctx= nullptr;
+  Dynamic_array<FVectorNode*> batch{PSI_INSTRUMENT_MEM};
+  Dynamic_array<FVectorNode*> dirty{PSI_INSTRUMENT_MEM};
+  size_t nodes= 0;                      // number of nodes in the graph
+  uint threads;
+  Bulk_context(uint t) : threads(t) {}
+
+  size_t batch_size() const
+  { return threads == 1 ? 1 : std::min<size_t>(nodes/8 + 1, threads * 64); }
+};
+
+
+static int bulk_find_neighbors(Bulk_context *bulk, TABLE *graph)
+{
+  MHNSW_Share *ctx= bulk->ctx;
+  FVectorNode *start= ctx->start;
+  const size_t batch_size= bulk->batch.elements();
+  std::atomic<size_t> next{0};
+  std::atomic<int> error{0};
+
+  auto worker= [&]()
+  {
+    MEM_ROOT root;
+    init_alloc_root(PSI_INSTRUMENT_MEM, &root, 8192, 0, MYF(0));
+    for (size_t i; !error && (i= next++) < batch_size; )
+    {
+      if (int err= find_neighbors(ctx, graph, &root, start, bulk->batch.at(i)))
+        error= err;
+      free_root(&root, MYF(MY_MARK_BLOCKS_FREE));
+    }
+    free_root(&root, MYF(0));
+  };
+
+  std::vector<std::thread> workers;
+  for (uint i= 1; i < std::min<size_t>(bulk->threads, batch_size); i++)
+    workers.emplace_back([&worker]()
+                         { my_thread_init(); worker(); my_thread_end(); });
+  worker();
+  for (std::thread &t : workers)
+    t.join();
+  return error;
+}
+
+
+/* links the batch into the graph, see Bulk_context */
+static int bulk_insert_batch(Bulk_context *bulk, TABLE *graph)
+{
+  MHNSW_Share *ctx= bulk->ctx;
+  MEM_ROOT *root= graph->in_use->mem_root;
+
+  if (int err= bulk_find_neighbors(bulk, graph))
+    return err;
+
+  MEM_ROOT_SAVEPOINT memroot_sv;
+  root_make_savepoint(root, &memroot_sv);
+  SCOPE_EXIT([memroot_sv](){ root_free_to_savepoint(&memroot_sv); });
+
+  for (size_t i= 0; i < bulk->batch.elements(); i++)
+  {
+    FVectorNode *target= bulk->batch.at(i);
+    target->dirty= true;
+    if (bulk->dirty.append(target))
+      return my_errno= HA_ERR_OUT_OF_MEM;
+    if (target->max_layer > ctx->start->max_layer)
+      ctx->start= target;
+    for (int cur_layer= target->max_layer; cur_layer >= 0; cur_layer--)
+    {
+      if (int err= update_second_degree_neighbors(ctx, graph, root, cur_layer,
+                                                  target, &bulk->dirty))
+        return err;
+    }
+  }
+  bulk->nodes+= bulk->batch.elements();
+  bulk->batch.clear();
+  return 0;
+}
+
+
+/*
+  writes all nodes modified in the bulk build into the graph table
+
+  new nodes get their gref only when written, so a node that was written
+  before all its neighbors were has to be written again with correct grefs
+*/
+static int bulk_flush(Bulk_context *bulk, TABLE *graph)
+{
+  if (int err= graph->file->ha_rnd_init(0))
+    return err;
+  SCOPE_EXIT([graph](){ graph->file->ha_rnd_end(); });
+
+  for (size_t i= 0; i < bulk->dirty.elements(); i++)
+  {
+    FVectorNode *node= bulk->dirty.at(i);
+    if (node->stored)
+      continue;
+    bool neighbors_stored= true;
+    for (size_t layer= 0; layer <= node->max_layer && neighbors_stored; layer++)
+      for (size_t j= 0; j < node->neighbors[layer].num; j++)
+        if (!(neighbors_stored= node->neighbors[layer].links[j]->stored))
+          break;
+    if (int err= node->save(graph))
+      return err;
+    node->dirty= !neighbors_stored;
+  }
+
+  for (size_t i= 0; i < bulk->dirty.elements(); i++)
+  {
+    FVectorNode *node= bulk->dirty.at(i);
+    if (!node->dirty)
+      continue;
+    if (int err= node->save(graph))
+      return err;
+    node->dirty= false;
+  }
+  bulk->dirty.clear();
+  return 0;
+}
+
+
+static int bulk_insert(Bulk_context *bulk, TABLE *table, const String *vec)
+{
+  MHNSW_Share *ctx= bulk->ctx;
+  TABLE *graph= table->hlindex;
+
+  if (!ctx->start)
+  {
+    // First insert!
+    ctx->set_lengths(vec->length());
+    FVectorNode *target= new (ctx->alloc_node())
+                   FVectorNode(ctx, table->file->ref, 0, vec->ptr());
+    target->dirty= true;
+    ctx->start= target;
+    bulk->nodes= 1;
+    return bulk->dirty.append(target) ? my_errno= HA_ERR_OUT_OF_MEM : 0;
+  }
+
+  if (ctx->byte_len != vec->length())
+    return my_errno= HA_ERR_CRASHED;
+
+  if (bulk->batch.append(create_node(ctx, table, vec)))
+    return my_errno= HA_ERR_OUT_OF_MEM;
+
+  if (bulk->batch.elements() < bulk->batch_size())
+    return 0;
+
+  return bulk_insert_batch(bulk, graph);
+}
+
+
+int mhnsw_bulk_begin(TABLE *table, KEY *keyinfo)
+{
+  TABLE *graph= table->hlindex;
+  THD *thd= table->in_use;
+
+  DBUG_ASSERT(graph);
+  DBUG_ASSERT(keyinfo->algorithm == HA_KEY_ALG_VECTOR);
+  DBUG_ASSERT(!graph->context);
+
+  auto bulk= new (thd->mem_root) Bulk_context(THDVAR(thd, build_threads));
+  if (!bulk)
+    return my_errno= HA_ERR_OUT_OF_MEM;
+
+  int err= MHNSW_Share::acquire(&bulk->ctx, table, true);
+  if (err != HA_ERR_END_OF_FILE)
+  {
+    /* only an empty graph can be built in bulk */
+    bulk->ctx->release(table);
+    bulk->~Bulk_context();
+    return err;
+  }
+
+  graph->context= bulk;
+  return 0;
+}
+
+
+int mhnsw_bulk_end(TABLE *table, KEY *keyinfo, bool abort)
+{
+  TABLE *graph= table->hlindex;
+  auto bulk= static_cast<Bulk_context*>(graph->context);
+  if (!bulk)
+    return 0;
+
+  int err= 0;
+  graph->context= nullptr;
+  if (!abort && bulk->batch.elements())
+    err= bulk_insert_batch(bulk, graph);
+  if (!abort && !err)
+    err= bulk_flush(bulk, graph);
+  bulk->ctx->release(table);
+  bulk->~Bulk_context();
+  return err;
+}
+
+
 int mhnsw_insert(TABLE *table, KEY *keyinfo)
 {
   THD *thd= table->in_use;
   TABLE *graph= table->hlindex;
   MY_BITMAP *old_map= dbug_tmp_use_all_columns(table, &table->read_set);
+  SCOPE_EXIT([table, old_map](){
+    dbug_tmp_restore_column_map(&table->read_set, old_map); });
   Field *vec_field= keyinfo->key_part->field;
   String buf, *res= vec_field->val_str(&buf);
   MHNSW_Share *ctx;
@@ -1149,6 +1669,16 @@ int mhnsw_insert(TABLE *table, KEY *keyinfo)
 
   table->file->position(table->record[0]);
 
+  if (auto bulk= static_cast<Bulk_context*>(graph->context))
+  {
+    if (!bulk->ctx->cache_is_full())
+      return bulk_insert(bulk, table, res);
+
+    /* the graph doesn't fit in memory, continue with normal inserts */
+    if (int err= mhnsw_bulk_end(table, keyinfo, false))
+      return err;
+  }
+
   int err= MHNSW_Share::acquire(&ctx, table, true);
   SCOPE_EXIT([ctx, table](){ ctx->release(table); });
   if (err)
@@ -1172,75 +1702,113 @@ int mhnsw_insert(TABLE *table, KEY *keyinfo)
   root_make_savepoint(thd->mem_root, &memroot_sv);
   SCOPE_EXIT([memroot_sv](){ root_free_to_savepoint(&memroot_sv); });
 
-  const size_t max_found= ctx->max_neighbors(0);
-  Neighborhood candidates;
-  candidates.init(thd->alloc<FVectorNode*>(max_found + 7), max_found);
-  candidates.links[candidates.num++]= ctx->start;
-
-  const double NORMALIZATION_FACTOR= 1 / std::log(ctx->M);
-  double log= -std::log(my_rnd(&thd->rand)) * NORMALIZATION_FACTOR;
-  const uint8_t max_layer= candidates.links[0]->max_layer;
-  uint8_t target_layer= std::min<uint8_t>(static_cast<uint8_t>(std::floor(log)), max_layer + 1);
-  int cur_layer;
-
-  FVectorNode *target= new (ctx->alloc_node())
-                 FVectorNode(ctx, table->file->ref, target_layer, res->ptr());
+  FVectorNode *start= ctx->start;
+  FVectorNode *target= create_node(ctx, table, res);
 
   if (int err= graph->file->ha_rnd_init(0))
     return err;
   SCOPE_EXIT([graph](){ graph->file->ha_rnd_end(); });
 
-  for (cur_layer= max_layer; cur_layer > target_layer; cur_layer--)
-  {
-    if (int err= search_layer(ctx, graph, target->vec, NEAREST,
-                              1, cur_layer, &candidates, false))
-      return err;
-  }
-
-  for (; cur_layer >= 0; cur_layer--)
-  {
-    uint max_neighbors= ctx->max_neighbors(cur_layer);
-    if (int err= search_layer(ctx, graph, target->vec, NEAREST,
-                              max_neighbors, cur_layer, &candidates, true))
-      return err;
-
-    if (int err= select_neighbors(ctx, graph, cur_layer, *target, candidates,
-                                  0, max_neighbors))
-      return err;
-  }
+  if (int err= find_neighbors(ctx, graph, thd->mem_root, start, target))
+    return err;
 
   if (int err= target->save(graph))
     return err;
 
-  if (target_layer > max_layer)
+  if (target->max_layer > start->max_layer)
     ctx->start= target;
 
-  for (cur_layer= target_layer; cur_layer >= 0; cur_layer--)
+  for (int cur_layer= target->max_layer; cur_layer >= 0; cur_layer--)
   {
-    if (int err= update_second_degree_neighbors(ctx, graph, cur_layer, target))
+    if (int err= update_second_degree_neighbors(ctx, graph, thd->mem_root,
+                                                cur_layer, target, nullptr))
       return err;
   }
 
-  dbug_tmp_restore_column_map(&table->read_set, old_map);
-
   return 0;
 }
 
 
+/*
+  State of one ORDER BY ... LIMIT search
+
+  When the search is repeated within a statement (the target vector is
+  an outer reference in a subquery), the context and the memory in
+  its root are reused for the next target, see mhnsw_read_first()
+*/
 struct Search_context: public Sql_alloc
 {
+  MEM_ROOT root;
   Neighborhood found;
-  MHNSW_Share *ctx;
+  MHNSW_Share *ctx= nullptr;
   const FVector *target;
+  Item *dist;
+  Search_filter *filter;
   ulonglong ctx_version;
-  size_t pos= 0;
-  float threshold= NEAREST/2;
-  Search_context(Neighborhood *n, MHNSW_Share *s, const FVector *v)
-    : found(*n), ctx(s->dup(false)), target(v), ctx_version(ctx->version) {}
+  size_t pos;
+  float threshold;
+
+  Search_context()
+  { init_alloc_root(PSI_INSTRUMENT_MEM, &root, 8192, 0, MYF(MY_THREAD_SPECIFIC)); }
+  ~Search_context() { free_root(&root, MYF(0)); }
+
+  void start(Neighborhood *n, MHNSW_Share *s, const FVector *v, Item *d,
+             Search_filter *f)
+  {
+    found= *n;
+    ctx= s->dup(false);
+    target= v;
+    dist= d;
+    filter= f;
+    ctx_version= ctx->version;
+    pos= 0;
+    threshold= NEAREST/2;
+  }
+
+  /* forget the previous search, keeping the allocated memory */
+  void reset(TABLE *table)
+  {
+    if (ctx)
+      ctx->release(false, table->s);
+    ctx= nullptr;
+    free_root(&root, MYF(MY_MARK_BLOCKS_FREE));
+  }
 };
 
 
-int mhnsw_read_first(TABLE *table, KEY *keyinfo, Item *dist, ulonglong limit)
+/*
+  sorts found nodes by the exact distance to the target
+
+  INT8 coordinates are too coarse to order the final candidates, so more
+  candidates are searched for and then sorted by the distance computed
+  from the full-precision vector in the row itself
+*/
+static int rerank(TABLE *table, Item *dist, Neighborhood *found)
+{
+  struct Candidate { FVectorNode *node; double distance; };
+  auto cands= (Candidate*)my_safe_alloca(sizeof(Candidate)*found->num);
+  SCOPE_EXIT([cands, found](){
+    my_safe_afree(cands, sizeof(Candidate)*found->num); });
+
+  for (size_t i= 0; i < found->num; i++)
+  {
+    cands[i].node= found->links[i];
+    if (int err= table->file->ha_rnd_pos(table->record[0],
+                                         cands[i].node->tref()))
+      return err;
+    cands[i].distance= dist->val_real();
+  }
+  std::stable_sort(cands, cands + found->num,
+                   [](const Candidate &a, const Candidate &b)
+                   { return a.distance < b.distance; });
+  for (size_t i= 0; i < found->num; i++)
+    found->links[i]= cands[i].node;
+  return 0;
+}
+
+
+int mhnsw_read_first(TABLE *table, KEY *keyinfo, Item *dist, ulonglong limit,
+                     Item *cond)
 {
   THD *thd= table->in_use;
   TABLE *graph= table->hlindex;
@@ -1252,16 +1820,38 @@ int mhnsw_read_first(TABLE *table, KEY *keyinfo, Item *dist, ulonglong limit)
   String buf, *res= fun->get_const_arg()->val_str(&buf);
   MHNSW_Share *ctx;
 
-  if (int err= table->file->ha_rnd_init(0))
-    return err;
+  auto result= static_cast<Search_context*>(graph->context);
+  if (result)
+  {
+    result->reset(table);
+    graph->file->ha_rnd_end();
+  }
+  else
+  {
+    if (!(result= new (thd->mem_root) Search_context()))
+      return my_errno= HA_ERR_OUT_OF_MEM;
+    graph->context= result;
+  }
+  MEM_ROOT *root= &result->root;
+
+  if (table->file->inited == handler::NONE)
+    if (int err= table->file->ha_rnd_init(0))
+      return err;
 
   int err= MHNSW_Share::acquire(&ctx, table, false);
   SCOPE_EXIT([ctx, table](){ ctx->release(table); });
   if (err)
     return err;
 
+  if (ctx->quantization == INT8) // keep all candidates for rerank()
+    limit= std::min<ulonglong>(std::max<ulonglong>(limit, THDVAR(thd, ef_search)),
+                               max_ef);
+
+  Search_filter *filter= Search_filter::create(table, root, cond);
+
   Neighborhood candidates;
-  candidates.init(thd->alloc<FVectorNode*>(limit + 7), limit);
+  candidates.init((FVectorNode**)alloc_root(root, sizeof(FVectorNode*)*(limit + 7)),
+                  limit);
 
   // one could put all max_layer nodes in candidates
   // but it has no effect on the recall or speed
@@ -1282,32 +1872,39 @@ int mhnsw_read_first(TABLE *table, KEY *keyinfo, Item *dist, ulonglong limit)
   }
 
   const longlong max_layer= candidates.links[0]->max_layer;
-  auto target= FVector::create(ctx->metric, thd->alloc(FVector::alloc_size(ctx->vec_len)),
-                               res->ptr(), res->length());
+  auto target= FVector::create(ctx->metric, ctx->quantization,
+              alloc_root(root, FVector::alloc_size(ctx->vec_len, ctx->quantization)),
+              res->ptr(), res->length());
 
   if (int err= graph->file->ha_rnd_init(0))
     return err;
 
   for (size_t cur_layer= max_layer; cur_layer > 0; cur_layer--)
   {
-    if (int err= search_layer(ctx, graph, target, NEAREST,
-                              1, cur_layer, &candidates, false))
+    if (int err= search_layer(ctx, graph, root, target, NEAREST,
+                              1, cur_layer, &candidates, false, NULL))
     {
       graph->file->ha_rnd_end();
       return err;
     }
   }
 
-  if (int err= search_layer(ctx, graph, target, NEAREST,
-                            static_cast<uint>(limit), 0, &candidates, false))
+  if (int err= search_layer(ctx, graph, root, target, NEAREST,
+                            static_cast<uint>(limit), 0, &candidates, false,
+                            filter))
   {
     graph->file->ha_rnd_end();
     return err;
   }
 
-  auto result= new (thd->mem_root) Search_context(&candidates, ctx, target);
-  graph->context= result;
+  if (ctx->quantization == INT8)
+    if (int err= rerank(table, dist, &candidates))
+    {
+      graph->file->ha_rnd_end();
+      return err;
+    }
 
+  result->start(&candidates, ctx, target, dist, filter);
   return mhnsw_read_next(table);
 }
 
@@ -1353,10 +1950,19 @@ int mhnsw_read_next(TABLE *table)
   }
 
   float new_threshold= result->found.links[result->found.num-1]->distance_to(result->target);
-
-  if (int err= search_layer(ctx, graph, result->target, result->threshold,
-                   static_cast<uint>(result->pos), 0, &result->found, false))
+  if (ctx->quantization == INT8) // after rerank() the last isn't the furthest
+    for (size_t i= 0; i < result->found.num; i++)
+      set_if_bigger(new_threshold,
+                    result->found.links[i]->distance_to(result->target));
+
+  if (int err= search_layer(ctx, graph, &result->root,
+                   result->target, result->threshold,
+                   static_cast<uint>(result->pos), 0, &result->found, false,
+                   result->filter))
     return err;
+  if (ctx->quantization == INT8)
+    if (int err= rerank(table, result->dist, &result->found))
+      return err;
   result->pos= 0;
   result->threshold= new_threshold;
   return mhnsw_read_next(table);
@@ -1365,9 +1971,11 @@ int mhnsw_read_next(TABLE *table)
 int mhnsw_read_end(TABLE *table)
 {
   auto result= static_cast<Search_context*>(table->hlindex->context);
-  result->ctx->release(false, table->s);
+  result->reset(table);
+  result->~Search_context();
   table->hlindex->context= 0;
-  table->hlindex->file->ha_rnd_end();
+  if (table->hlindex->file->inited)
+    table->hlindex->file->ha_rnd_end();
   return 0;
 }
 
@@ -1381,6 +1989,75 @@ void mhnsw_free(TABLE_SHARE *share)
   graph_share->hlindex_data= 0;
 }
 
+/*
+  reconnects neighbors of a deleted node
+
+  The deleted node stays in the graph: links can be one-directional, so
+  the nodes that link to it can't be found without a full graph scan.
+  But the nodes it links to, which mostly link back, replace the link to it
+  with links to its other neighbors. This way searches don't walk through
+  deleted nodes and the graph doesn't degrade under deletes and updates.
+*/
+static int repair_neighbors(MHNSW_Share *ctx, TABLE *graph, MEM_ROOT *root,
+                            FVectorNode *node)
+{
+  if (int err= node->load(graph))
+    return err;
+
+  for (size_t layer= 0; layer <= node->max_layer; layer++)
+  {
+    const Neighborhood &around= node->neighbors[layer];
+    for (size_t i= 0; i < around.num; i++)
+    {
+      FVectorNode *neigh= around.links[i];
+      if (int err= neigh->load(graph))
+        return err;
+      if (neigh->deleted)
+        continue;
+
+      Neighborhood &neighneighbors= neigh->neighbors[layer];
+      const size_t max_candidates= neighneighbors.num + around.num;
+      Neighborhood candidates;
+      candidates.init((FVectorNode**)alloc_root(root, sizeof(FVectorNode*) *
+                                        MY_ALIGN(max_candidates, 8)),
+                      max_candidates);
+      bool linked= false;
+      for (size_t j= 0; j < neighneighbors.num; j++)
+        if (neighneighbors.links[j] == node)
+          linked= true;
+        else
+          candidates.links[candidates.num++]= neighneighbors.links[j];
+      if (!linked)
+        continue;
+
+      for (size_t j= 0; j < around.num; j++)
+      {
+        FVectorNode *other= around.links[j];
+        if (other == neigh)
+          continue;
+        if (int err= other->load(graph))
+          return err;
+        if (other->deleted ||
+            std::find(candidates.links, candidates.links + candidates.num,
+                      other) != candidates.links + candidates.num)
+          continue;
+        candidates.links[candidates.num++]= other;
+      }
+      if (!candidates.num)
+        continue; // the link to the deleted node is the only way out
+
+      if (int err= select_neighbors(ctx, graph, root, layer, *neigh,
+                                    candidates, NULL,
+                                    ctx->max_neighbors(layer)))
+        return err;
+      if (int err= neigh->save(graph))
+        return err;
+    }
+  }
+  return 0;
+}
+
+
 int mhnsw_invalidate(TABLE *table, const uchar *rec, KEY *keyinfo)
 {
   TABLE *graph= table->hlindex;
@@ -1419,8 +2096,21 @@ int mhnsw_invalidate(TABLE *table, const uchar *rec, KEY *keyinfo)
   graph->file->position(graph->record[0]);
   FVectorNode *node= ctx->get_node(graph->file->ref);
   node->deleted= true;
+  node->changed= true;
 
-  return 0;
+  THD *thd= table->in_use;
+  MEM_ROOT_SAVEPOINT memroot_sv;
+  root_make_savepoint(thd->mem_root, &memroot_sv);
+  SCOPE_EXIT([memroot_sv](){ root_free_to_savepoint(&memroot_sv); });
+
+  /* the graph can be already in use by DELETE ... ORDER BY ... LIMIT */
+  const bool inited= graph->file->inited != handler::NONE;
+  if (!inited)
+    if (int err= graph->file->ha_rnd_init(0))
+      return err;
+  SCOPE_EXIT([graph, inited](){ if (!inited) graph->file->ha_rnd_end(); });
+
+  return repair_neighbors(ctx, graph, thd->mem_root, node);
 }
 
 int mhnsw_delete_all(TABLE *table, KEY *keyinfo, bool truncate)
@@ -1476,6 +2166,7 @@ ha_create_table_option mhnsw_index_options[]=
 {
   HA_IOPTION_SYSVAR("m", M, default_m),
   HA_IOPTION_SYSVAR("distance", metric, default_distance),
+  HA_IOPTION_ENUM("quantization", quantization, "int16,int8", INT16),
   HA_IOPTION_END
 };
 
@@ -1500,12 +2191,112 @@ static int mhnsw_deinit(void *)
 static struct st_mysql_storage_engine mhnsw_daemon=
 { MYSQL_DAEMON_INTERFACE_VERSION };
 
+/*
+  INFORMATION_SCHEMA.MHNSW_STATISTICS
+
+  One row per vector index that has its cache loaded. Counters are since
+  the cache was created, AVG_* are per search of the bottom layer
+  (one ORDER BY ... LIMIT can do more than one).
+*/
+namespace Show {
+
+static ST_FIELD_INFO mhnsw_statistics_fields_info[]=
+{
+  Column("TABLE_SCHEMA",  Name(),        NOT_NULL),
+  Column("TABLE_NAME",    Name(),        NOT_NULL),
+  Column("CACHE_SIZE",    ULonglong(),   NOT_NULL),
+  Column("CACHE_NODES",   ULonglong(),   NOT_NULL),
+  Column("CACHE_HITS",    ULonglong(),   NOT_NULL),
+  Column("CACHE_MISSES",  ULonglong(),   NOT_NULL),
+  Column("NODES_LOADED",  ULonglong(),   NOT_NULL),
+  Column("SEARCHES",      ULonglong(),   NOT_NULL),
+  Column("AVG_LAYERS",    Double(MY_INT64_NUM_DECIMAL_DIGITS), NOT_NULL),
+  Column("AVG_EF",        Double(MY_INT64_NUM_DECIMAL_DIGITS), NOT_NULL),
+  Column("AVG_DISTANCES", Double(MY_INT64_NUM_DECIMAL_DIGITS), NOT_NULL),
+  CEnd()
+};
+
+} // namespace Show
+
+struct mhnsw_statistics_arg
+{
+  THD *thd;
+  TABLE *table;
+};
+
+static my_bool mhnsw_statistics_callback(void *el, void *a)
+{
+  TDC_element *element= static_cast<TDC_element*>(el);
+  auto arg= static_cast<mhnsw_statistics_arg*>(a);
+  const Lex_ident_db
+    db= Lex_ident_db(Lex_cstring_strlen((const char*) element->m_key));
+  const Lex_ident_table table_name=
+    Lex_ident_table(Lex_cstring_strlen(db.str + db.length + 1));
+  ulonglong stats[6];
+  double searches= 0, layers= 0, ef= 0, distances= 0;
+
+  TABLE_LIST tl;
+  tl.init_one_table(&db, &table_name, nullptr, TL_IGNORE);
+  if (check_table_access(arg->thd, SELECT_ACL, &tl, TRUE, 1, TRUE))
+    return FALSE;
+
+  mysql_mutex_lock(&element->LOCK_table_share);
+  TABLE_SHARE *share= element->share;
+  MHNSW_Share *ctx= share && !share->error && share->hlindex
+                    ? MHNSW_Share::get_from_share(share, nullptr) : nullptr;
+  if (ctx)
+  {
+    ctx->cache_stats(stats);
+    stats[4]= ctx->nodes_loaded;
+    stats[5]= ctx->searches;
+    searches= static_cast<double>(std::max<ulonglong>(stats[5], 1));
+    layers= static_cast<double>(ctx->layers_searched);
+    ef= static_cast<double>(ctx->ef_total);
+    distances= static_cast<double>(ctx->distances);
+    ctx->release(false, share);
+  }
+  mysql_mutex_unlock(&element->LOCK_table_share);
+  if (!ctx)
+    return FALSE;
+
+  TABLE *table= arg->table;
+  restore_record(table, s->default_values);
+  table->field[0]->store(db.str, db.length, system_charset_info);
+  table->field[1]->store(table_name.str, table_name.length,
+                         system_charset_info);
+  for (uint i= 0; i < array_elements(stats); i++)
+    table->field[2 + i]->store(stats[i], true);
+  table->field[8]->store(layers / searches);
+  table->field[9]->store(ef / searches);
+  table->field[10]->store(distances / searches);
+  return schema_table_store_record(arg->thd, table);
+}
+
+static int mhnsw_statistics_fill(THD *thd, TABLE_LIST *tables, COND *)
+{
+  mhnsw_statistics_arg arg= { thd, tables->table };
+  return tdc_iterate(thd, mhnsw_statistics_callback, &arg, true);
+}
+
+static int mhnsw_statistics_init(void *p)
+{
+  ST_SCHEMA_TABLE *is= static_cast<ST_SCHEMA_TABLE*>(p);
+  is->fields_info= Show::mhnsw_statistics_fields_info;
+  is->fill_table= mhnsw_statistics_fill;
+  return 0;
+}
+
+static struct st_mysql_information_schema mhnsw_statistics=
+{ MYSQL_INFORMATION_SCHEMA_INTERFACE_VERSION };
+
 static struct st_mysql_sys_var *mhnsw_sys_vars[]=
 {
   MYSQL_SYSVAR(max_cache_size),
+  MYSQL_SYSVAR(cache_preload_pct),
   MYSQL_SYSVAR(default_m),
   MYSQL_SYSVAR(default_distance),
   MYSQL_SYSVAR(ef_search),
+  MYSQL_SYSVAR(build_threads),
   NULL
 };
 
@@ -1516,5 +2307,12 @@ maria_declare_plugin(mhnsw)
   "A plugin for mhnsw vector index algorithm",
   PLUGIN_LICENSE_GPL, mhnsw_init, mhnsw_deinit, 0x0100, NULL,
   mhnsw_sys_vars, "1.0", MariaDB_PLUGIN_MATURITY_STABLE
+},
+{
+  MYSQL_INFORMATION_SCHEMA_PLUGIN,
+  &mhnsw_statistics, "MHNSW_STATISTICS", "MariaDB plc",
+  "Statistics of mhnsw vector index caches",
+  PLUGIN_LICENSE_GPL, mhnsw_statistics_init, NULL, 0x0100, NULL,
+  NULL, "1.0", MariaDB_PLUGIN_MATURITY_STABLE
 }
 maria_declare_plugin_end;
@@ -0,0 +1,91 @@
+#ifndef WAIT_PROFILE_INCLUDED
+#define WAIT_PROFILE_INCLUDED
+/*
+   Copyright (c) 2026, MariaDB Foundation
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; version 2 of
+   the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1335  USA
+*/
+
+#include "my_rdtsc.h"
+#include "my_atomic_wrapper.h"
+#include <mysql/service_thd_wait.h>
+
+/*
+  Time a statement spent in waits reported through thd_wait_begin() and
+  thd_wait_end(), per thd_wait_type.
+
+  Times are in timer_tracker_frequency() units, like the ANALYZE
+  statement trackers. Only the outermost of nested waits is timed.
+*/
+
+class Wait_profile
+{
+  ulonglong start;
+  uint depth;
+
+  static ulonglong measure()
+  {
+#if (MY_TIMER_ROUTINE_CYCLES)
+    return my_timer_cycles();
+#else
+    return my_timer_microseconds();
+#endif
+  }
+
+public:
+  ulonglong time[THD_WAIT_LAST];
+  /* Type of the wait in progress, or 0; may be read by other threads */
+  Atomic_relaxed<int> current;
+
+  Wait_profile() : start(0), depth(0), current(0) { reset(); }
+
+  /* Clear accumulated times; does not affect a wait in progress */
+  void reset() { memset(time, 0, sizeof time); }
+
+  void add(const Wait_profile &from)
+  {
+    for (uint i= 0; i < THD_WAIT_LAST; i++)
+      time[i]+= from.time[i];
+  }
+
+  void begin(int wait_type)
+  {
+    if (!depth++)
+    {
+      current= wait_type;
+      start= measure();
+    }
+  }
+
+  void end()
+  {
+    if (depth && !--depth)
+    {
+      int type= current;
+      if (type > 0 && type < THD_WAIT_LAST)
+        time[type]+= measure() - start;
+      current= 0;
+    }
+  }
+
+  bool has_waits() const
+  {
+    for (uint i= 0; i < THD_WAIT_LAST; i++)
+      if (time[i])
+        return true;
+    return false;
+  }
+};
+#endif /* WAIT_PROFILE_INCLUDED */
@@ -314,7 +314,22 @@ static inline int wsrep_before_commit(THD* thd, bool all)
   int ret= 0;
   DBUG_ASSERT(wsrep_run_commit_hook(thd, all));
 
-  if ((ret= thd->wsrep_cs().before_commit()) == 0)
+  /*
+    An applier blocks here until all the write sets it depends on in
+    the commit order have committed. Account that time so that a
+    serialized parallel applier shows up in the applier's status.
+  */
+  const bool applying= wsrep_thd_is_applying(thd);
+  const ulonglong before= applying ? microsecond_interval_timer() : 0;
+  ret= thd->wsrep_cs().before_commit();
+  if (applying)
+  {
+    status_var_increment(thd->status_var.wsrep_applier_commit_waits);
+    status_var_add(thd->status_var.wsrep_applier_commit_wait_time,
+                   static_cast<ulong>(microsecond_interval_timer() - before));
+  }
+
+  if (ret == 0)
   {
     DBUG_ASSERT(!thd->wsrep_trx().ws_meta().gtid().is_undefined());
     if (!thd->variables.gtid_seq_no &&
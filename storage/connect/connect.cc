@@ -440,7 +440,7 @@ RCODE CntReadNext(PGLOBAL g, PTDB tdbp)
 
 		do {
 			if ((rc = (RCODE)tdbp->ReadDB(g)) == RC_OK)
-				if (!ApplyFilter(g, tdbp->GetFilter()))
+				if (!tdbp->FilterApplied() && !ApplyFilter(g, tdbp->GetFilter()))
 					rc = RC_NF;
 
 		} while (rc == RC_NF);
@@ -59,6 +59,7 @@
 #endif   // ZIP_SUPPORT
 #include "tabfmt.h"
 #include "tabmul.h"
+#include "filter.h"
 #define  NO_FUNC
 #include "plgcnx.h"                       // For DB types
 #include "resource.h"
@@ -615,6 +616,9 @@ TDBCSV::TDBCSV(PCSVDEF tdp, PTXF txfp) : TDBDOS(tdp, txfp)
   Offset = NULL;
   Fldlen = NULL;
   Fields = 0;
+  Fltp = NULL;
+  Fltfields = 0;
+  Filtered = false;
   Nerr = 0;
   Quoted = tdp->Quoted;
   Maxerr = tdp->Maxerr;
@@ -658,6 +662,9 @@ TDBCSV::TDBCSV(PGLOBAL g, PTDBCSV tdbp) : TDBDOS(g, tdbp)
     Fldlen = NULL;
   } // endif Fields
 
+  Fltp = NULL;
+  Fltfields = 0;
+  Filtered = false;
   Nerr = tdbp->Nerr;
   Maxerr = tdbp->Maxerr;
   Quoted = tdbp->Quoted;
@@ -908,26 +915,80 @@ bool TDBCSV::SkipHeader(PGLOBAL g)
   return rc;
   } // end of SkipHeader
 
+/***********************************************************************/
+/*  FilterFields: returns the number of fields that must be found to   */
+/*  evaluate the filter, or Fields if it cannot be evaluated early.    */
+/***********************************************************************/
+int TDBCSV::FilterFields(PFIL filp)
+  {
+  int n = 0;
+
+  for (int i = 0; i < 2; i++)
+    switch (filp->GetArgType(i)) {
+      case TYPE_FILTER:
+        n = MY_MAX(n, FilterFields((PFIL)filp->Arg(i)));
+        break;
+      case TYPE_COLBLK: {
+        PCOL colp = (PCOL)filp->Arg(i);
+
+        if (colp->GetTo_Tdb() != this || colp->IsVirtual())
+          return Fields;
+        else if (!colp->IsSpecial())
+          n = MY_MAX(n, ((PCSVCOL)colp)->Fldnum + 1);
+
+        } break;
+      case TYPE_CONST:
+      case TYPE_ARRAY:
+      case TYPE_VOID:
+        break;
+      default:
+        return Fields;
+      } // endswitch type
+
+  return n;
+  } // end of FilterFields
+
 /***********************************************************************/
 /*  ReadBuffer: Physical read routine for the CSV access method.       */
+/*  When reading sequentially with a filter, the filter is applied as  */
+/*  soon as the fields it uses are found, so that the other fields of  */
+/*  the rejected rows are not searched for.                            */
 /***********************************************************************/
 int TDBCSV::ReadBuffer(PGLOBAL g)
   {
   //char *p1, *p2, *p = NULL;
 	char *p2, *p = NULL;
-	int   i, n, len, rc = Txfp->ReadBuffer(g);
+	int   i, n, len, nflt = Fields, rc = Txfp->ReadBuffer(g);
   bool  bad = false;
 
   if (trace(2))
     htrc("CSV: Row is '%s' rc=%d\n", To_Line, rc);
 
+  Filtered = false;
+
   if (rc != RC_OK || !Fields)
     return rc;
   else
     p2 = To_Line;
 
+  if (To_Filter && Mode == MODE_READ && !To_Kindex) {
+    if (To_Filter != Fltp) {
+      Fltp = To_Filter;
+      Fltfields = FilterFields(To_Filter);
+      } // endif Fltp
+
+    nflt = Fltfields;
+    } // endif To_Filter
+
   // Find the offsets and lengths of the columns for this row
   for (i = 0; i < Fields; i++) {
+    if (i == nflt) {
+      if (!ApplyFilter(g, To_Filter))
+        return RC_NF;               // Rejected row
+
+      Filtered = true;
+      } // endif nflt
+
     if (!bad) {
       if (Qot && *p2 == Qot) {                // Quoted field
         //for (n = 0, p1 = ++p2; (p = strchr(p1, Qot)); p1 = p + 2)
@@ -68,6 +68,7 @@ class DllExport TDBCSV : public TDBDOS {
   PTDB Clone(PTABS t) override;
 //virtual bool IsUsingTemp(PGLOBAL g);
   int  GetBadLines(void) override {return (int)Nerr;}
+  bool FilterApplied(void) override {return Filtered;}
 
   // Database routines
   PCOL MakeCol(PGLOBAL g, PCOLDEF cdp, PCOL cprec, int n) override;
@@ -83,18 +84,22 @@ class DllExport TDBCSV : public TDBDOS {
 
  protected:
   bool PrepareWriting(PGLOBAL g) override;
+  int  FilterFields(PFIL filp);
 
   // Members
+  PFIL  Fltp;              // Filter for which Fltfields was computed
   PSZ  *Field;             // Field to write to current line
   int  *Offset;            // Column offsets for current record
   int  *Fldlen;            // Column field length for current record
   bool *Fldtyp;            // true for numeric fields
   int   Fields;            // Number of fields to handle
+  int   Fltfields;         // Number of fields used by the filter
   int   Nerr;              // Number of bad records
   int   Maxerr;            // Maximum number of bad records
   int   Quoted;            // Quoting level for quoted fields
   bool  Accept;            // true if bad lines are accepted
   bool  Header;            // true if first line contains column headers
+  bool  Filtered;          // true if ReadBuffer applied the filter
   char  Sep;               // Separator
   char  Qot;               // Quoting character
   }; // end of class TDBCSV
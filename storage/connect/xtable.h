@@ -104,6 +104,7 @@ class DllExport TDB: public BLOCK {     // Table Descriptor Block.
 	virtual void   ResetSize(void) {MaxSize = -1;}
 	virtual int    RowNumber(PGLOBAL g, bool b = false);
 	virtual bool   CanBeFiltered(void) {return true;}
+	virtual bool   FilterApplied(void) {return false;}
   virtual PTDB   Duplicate(PGLOBAL) {return NULL;}
   virtual PTDB   Clone(PTABS) {return this;}
   virtual PTDB   Copy(PTABS t);
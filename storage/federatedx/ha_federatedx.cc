@@ -2638,7 +2638,7 @@ int ha_federatedx::index_read_idx_with_result_set(uchar *buf, uint index,
   index_string.length(0);
   sql_query.length(0);
 
-  sql_query.append(share->select_query);
+  append_stmt_select(&sql_query);
 
   range.key= key;
   range.length= key_len;
@@ -2674,6 +2674,50 @@ int ha_federatedx::index_read_idx_with_result_set(uchar *buf, uint index,
 }
 
 
+/*
+  Append the SELECT ... FROM part of a query that reads rows
+
+  SYNOPSIS
+    append_stmt_select()
+      query     String to append to
+
+  DESCRIPTION
+    The columns that are not in the read_set are selected as NULL, so
+    that the remote server does not send their values. As the result
+    keeps one column per field, convert_row_to_internal_format() maps
+    the result columns to the fields as for share->select_query.
+
+  RETURN VALUE
+    0   OK
+    1   Out of memory
+*/
+
+bool ha_federatedx::append_stmt_select(String *query)
+{
+  DBUG_ENTER("ha_federatedx::append_stmt_select");
+
+  if (bitmap_is_set_all(table->read_set))
+    DBUG_RETURN(query->append(share->select_query));
+
+  query->append(STRING_WITH_LEN("SELECT "));
+  for (Field **field= table->field; *field; field++)
+  {
+    if (bitmap_is_set(table->read_set, (*field)->field_index))
+      append_ident(query, (*field)->field_name.str,
+                   (*field)->field_name.length, ident_quote_char);
+    else
+      query->append(STRING_WITH_LEN("NULL"));
+    query->append(STRING_WITH_LEN(", "));
+  }
+  /* chops off trailing comma */
+  query->length(query->length() - sizeof_trailing_comma);
+
+  query->append(STRING_WITH_LEN(" FROM "));
+  DBUG_RETURN(append_ident(query, share->table_name,
+                           share->table_name_length, ident_quote_char));
+}
+
+
 /*
   This method is used exlusevely by filesort() to check if we
   can create sorting buffers of necessary size.
@@ -2721,7 +2765,7 @@ int ha_federatedx::read_range_first(const key_range *start_key,
   DBUG_ASSERT(!(start_key == NULL && end_key == NULL));
 
   sql_query.length(0);
-  sql_query.append(share->select_query);
+  append_stmt_select(&sql_query);
   create_where_from_key(&sql_query, &table->key_info[active_index],
                         start_key, end_key, eq_range_arg);
 
@@ -2824,6 +2868,9 @@ int ha_federatedx::rnd_init(bool scan)
   if (scan)
   {
     int error;
+    char sql_query_buffer[FEDERATEDX_QUERY_BUFFER_SIZE];
+    String sql_query(sql_query_buffer, sizeof(sql_query_buffer),
+                     &my_charset_bin);
 
     if ((error= txn->acquire(share, ha_thd(), TRUE, &io)))
       DBUG_RETURN(error);
@@ -2831,7 +2878,9 @@ int ha_federatedx::rnd_init(bool scan)
     if (stored_result)
       (void) free_result();
 
-    if (io->query(share->select_query.str, share->select_query.length))
+    sql_query.length(0);
+    if (append_stmt_select(&sql_query) ||
+        io->query(sql_query.ptr(), sql_query.length()))
       goto error;
 
     stored_result= io->store_result();
@@ -299,6 +299,7 @@ class ha_federatedx final : public handler
                                HA_CREATE_INFO *);
 
   bool append_stmt_insert(String *query);
+  bool append_stmt_select(String *query);
 
   int read_next(uchar *buf, FEDERATEDX_IO_RESULT *result);
   int index_read_idx_with_result_set(uchar *buf, uint index,
@@ -647,6 +647,7 @@ static int heap_prepare_hp_create_info(TABLE *table_arg, bool internal_table,
   ha_rows max_rows;
   HP_KEYDEF *keydef;
   HA_KEYSEG *seg;
+  HP_BLOB_DESC *blob_desc;
   bool found_real_auto_increment= 0;
 
   bzero(hp_create_info, sizeof(*hp_create_info));
@@ -664,6 +665,7 @@ static int heap_prepare_hp_create_info(TABLE *table_arg, bool internal_table,
                        MYF(MY_WME | MY_THREAD_SPECIFIC),
                        &keydef, keys * sizeof(HP_KEYDEF),
                        &seg, parts * sizeof(HA_KEYSEG),
+                       &blob_desc, share->blob_fields * sizeof(HP_BLOB_DESC),
                        NULL))
     return my_errno;
   for (key= 0; key < keys; key++)
@@ -770,6 +772,22 @@ static int heap_prepare_hp_create_info(TABLE *table_arg, bool internal_table,
   hp_create_info->keys= share->keys;
   hp_create_info->reclength= share->reclength;
   hp_create_info->keydef= keydef;
+  hp_create_info->blob_descs= blob_desc;
+  for (uint i= 0; i < share->blob_fields; i++)
+  {
+    Field_blob *field= (Field_blob*) table_arg->field[share->blob_field[i]];
+    /* Information schema replaces the columns it doesn't read */
+    if (!(field->flags & BLOB_FLAG))
+      continue;
+    hp_create_info->blobs++;
+    blob_desc->offset= (uint) (field->ptr - table_arg->record[0]);
+    blob_desc->packlength= field->pack_length_no_ptr();
+    blob_desc->null_bit= field->null_bit;
+    blob_desc->null_pos= (field->null_ptr ?
+                          (uint) (field->null_ptr - table_arg->record[0]) :
+                          0);
+    blob_desc++;
+  }
   return 0;
 }
 
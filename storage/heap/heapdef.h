@@ -100,6 +100,13 @@ extern void hp_clear(HP_SHARE *info);
 extern void hp_clear_keys(HP_SHARE *info);
 extern uint hp_rb_pack_key(HP_KEYDEF *keydef, uchar *key, const uchar *old,
                            key_part_map keypart_map);
+extern int hp_copy_blobs(HP_INFO *info, const uchar *record,
+                         const uchar *old, my_bool check_size);
+extern void hp_free_copied_blobs(HP_INFO *info, const uchar *old);
+extern void hp_store_record(HP_INFO *info, uchar *pos, const uchar *record,
+                            my_bool replace);
+extern void hp_free_blobs(HP_SHARE *share, uchar *pos);
+extern void hp_free_all_blobs(HP_SHARE *share);
 
 extern mysql_mutex_t THR_LOCK_heap;
 
@@ -107,6 +114,7 @@ extern PSI_memory_key hp_key_memory_HP_SHARE;
 extern PSI_memory_key hp_key_memory_HP_INFO;
 extern PSI_memory_key hp_key_memory_HP_PTRS;
 extern PSI_memory_key hp_key_memory_HP_KEYDEF;
+extern PSI_memory_key hp_key_memory_HP_BLOB;
 
 #ifdef HAVE_PSI_INTERFACE
 void init_heap_psi_keys();
@@ -0,0 +1,216 @@
+/* Copyright (c) 2024, MariaDB Corporation
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1335 USA */
+
+/*
+  Blob storage for heap tables
+
+  A stored record keeps the blob length and a pointer like the record
+  buffer does, but the pointer is to a copy of the data that is owned by
+  the table. The copy is done before a write or update changes the
+  table, so that running out of memory leaves the table untouched.
+*/
+
+#include "heapdef.h"
+
+static inline uint32 hp_blob_length(const HP_BLOB_DESC *desc,
+                                    const uchar *record)
+{
+  const uchar *pos= record + desc->offset;
+  if (desc->null_bit && (record[desc->null_pos] & desc->null_bit))
+    return 0;
+  switch (desc->packlength) {
+  case 1:
+    return (uint32) *pos;
+  case 2:
+    return uint2korr(pos);
+  case 3:
+    return uint3korr(pos);
+  case 4:
+    return uint4korr(pos);
+  }
+  DBUG_ASSERT(0);
+  return 0;
+}
+
+
+static inline uchar *hp_blob_data(const HP_BLOB_DESC *desc,
+                                  const uchar *record)
+{
+  uchar *data;
+  memcpy(&data, record + desc->offset + desc->packlength, sizeof(data));
+  return data;
+}
+
+
+static void free_copies(HP_INFO *info, const uchar *old, uint count)
+{
+  HP_BLOB_DESC *desc= info->s->blob_descs;
+  uchar **data, **end= info->blob_data + count;
+  for (data= info->blob_data; data < end; data++, desc++)
+  {
+    if (*data && (!old || *data != hp_blob_data(desc, old)))
+      my_free(*data);
+  }
+}
+
+
+/*
+  Copy the blobs of a record to be written or updated
+
+  SYNOPSIS
+    hp_copy_blobs()
+    info			Heap table
+    record			Record to be stored
+    old				Stored record that is updated, or 0 for a write
+    check_size			Fail with HA_ERR_RECORD_FILE_FULL if the
+                                copies would make the table too big
+
+  NOTES
+    The copies are stored in info->blob_data, to be put in the table
+    with hp_store_record() (or freed with hp_free_copied_blobs()).
+    A blob that is unchanged from 'old' is not copied again.
+
+  RETURN
+    0     ok
+    #     error number
+*/
+
+int hp_copy_blobs(HP_INFO *info, const uchar *record, const uchar *old,
+                  my_bool check_size)
+{
+  HP_SHARE *share= info->s;
+  HP_BLOB_DESC *desc= share->blob_descs;
+  uchar **data= info->blob_data;
+  ulonglong new_length= 0;
+  uint i;
+
+  for (i= 0; i < share->blobs; i++, desc++, data++)
+  {
+    uint32 length= hp_blob_length(desc, record);
+    uchar *from= hp_blob_data(desc, record);
+
+    if (!length)
+    {
+      *data= 0;
+      continue;
+    }
+    if (old && from == hp_blob_data(desc, old) &&
+        length == hp_blob_length(desc, old))
+    {
+      *data= from;
+      continue;
+    }
+    new_length+= length;
+    if (check_size &&
+        share->data_length + share->index_length + new_length >=
+        share->max_table_size)
+    {
+      my_errno= HA_ERR_RECORD_FILE_FULL;
+      goto err;
+    }
+    if (!(*data= (uchar*) my_malloc(hp_key_memory_HP_BLOB, length,
+                                    MYF(share->internal ?
+                                        MY_THREAD_SPECIFIC : 0))))
+    {
+      my_errno= HA_ERR_OUT_OF_MEM;
+      goto err;
+    }
+    memcpy(*data, from, length);
+  }
+  return 0;
+
+err:
+  free_copies(info, old, i);
+  return my_errno;
+}
+
+
+/* Free the copies made by hp_copy_blobs() when the row isn't stored */
+
+void hp_free_copied_blobs(HP_INFO *info, const uchar *old)
+{
+  free_copies(info, old, info->s->blobs);
+}
+
+
+/*
+  Store a record in the table, using the blob copies from hp_copy_blobs()
+
+  SYNOPSIS
+    hp_store_record()
+    info			Heap table
+    pos				Where to store the record
+    record			Record to store
+    replace			1 if pos holds the old version of the record
+                                whose blobs should be freed
+*/
+
+void hp_store_record(HP_INFO *info, uchar *pos, const uchar *record,
+                     my_bool replace)
+{
+  HP_SHARE *share= info->s;
+  HP_BLOB_DESC *desc, *end= share->blob_descs + share->blobs;
+  uchar **data;
+
+  for (desc= share->blob_descs, data= info->blob_data; desc < end;
+       desc++, data++)
+  {
+    uchar *old= replace ? hp_blob_data(desc, pos) : 0;
+    if (*data == old)
+      continue;
+    if (old)
+    {
+      share->data_length-= hp_blob_length(desc, pos);
+      my_free(old);
+    }
+    if (*data)
+      share->data_length+= hp_blob_length(desc, record);
+  }
+  memcpy(pos, record, (size_t) share->reclength);
+  for (desc= share->blob_descs, data= info->blob_data; desc < end;
+       desc++, data++)
+    memcpy(pos + desc->offset + desc->packlength, data, sizeof(*data));
+}
+
+
+/* Free the blobs of a stored record */
+
+void hp_free_blobs(HP_SHARE *share, uchar *pos)
+{
+  HP_BLOB_DESC *desc, *end= share->blob_descs + share->blobs;
+  for (desc= share->blob_descs; desc < end; desc++)
+  {
+    uchar *data;
+    if ((data= hp_blob_data(desc, pos)))
+    {
+      share->data_length-= hp_blob_length(desc, pos);
+      my_free(data);
+    }
+  }
+}
+
+
+/* Free the blobs of all records, before the record blocks are freed */
+
+void hp_free_all_blobs(HP_SHARE *share)
+{
+  ulong i, records= share->records + share->deleted;
+  for (i= 0; i < records; i++)
+  {
+    uchar *pos= hp_find_block(&share->block, i);
+    if (pos[share->visible])
+      hp_free_blobs(share, pos);
+  }
+}
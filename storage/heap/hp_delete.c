@@ -43,6 +43,8 @@ int heap_delete(HP_INFO *info, const uchar *record)
   }
 
   info->update=HA_STATE_DELETED;
+  if (share->blobs)
+    hp_free_blobs(share, pos);
   *((uchar**) pos)=share->del_link;
   share->del_link=pos;
   pos[share->visible]=0;		/* Record deleted */
@@ -104,7 +106,7 @@ int hp_rb_delete_key(HP_INFO *info, register HP_KEYDEF *keyinfo,
 int hp_delete_key(HP_INFO *info, register HP_KEYDEF *keyinfo,
 		  const uchar *record, uchar *recpos, int flag)
 {
-  ulong blength, pos2, pos_hashnr, lastpos_hashnr, key_pos;
+  ulong blength, pos2, pos_hashnr, lastpos_hashnr, key_pos, hashnr;
   HASH_INFO *lastpos,*gpos,*pos,*pos3,*empty,*last_ptr;
   HP_SHARE *share=info->s;
   DBUG_ENTER("hp_delete_key");
@@ -116,14 +118,16 @@ int hp_delete_key(HP_INFO *info, register HP_KEYDEF *keyinfo,
   last_ptr=0;
 
   /* Search after record with key */
-  key_pos= hp_mask(hp_rec_hashnr(keyinfo, record), blength, share->records + 1);
+  hashnr= hp_rec_hashnr(keyinfo, record);
+  key_pos= hp_mask(hashnr, blength, share->records + 1);
   pos= hp_find_hash(&keyinfo->block, key_pos);
 
   gpos = pos3 = 0;
 
   while (pos->ptr_to_rec != recpos)
   {
-    if (flag && !hp_rec_key_cmp(keyinfo, record, pos->ptr_to_rec))
+    if (flag && pos->hash_of_key == hashnr &&
+        !hp_rec_key_cmp(keyinfo, record, pos->ptr_to_rec))
       last_ptr=pos;				/* Previous same key */
     gpos=pos;
     if (!(pos=pos->next_key))
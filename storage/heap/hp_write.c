@@ -42,8 +42,14 @@ int heap_write(HP_INFO *info, const uchar *record)
     DBUG_RETURN(my_errno=EACCES);
   }
 #endif
+  if (share->blobs && hp_copy_blobs(info, record, 0, 1))
+    DBUG_RETURN(my_errno);
   if (!(pos=next_free_record_pos(share)))
+  {
+    if (share->blobs)
+      hp_free_copied_blobs(info, 0);
     DBUG_RETURN(my_errno);
+  }
   share->changed=1;
 
   for (keydef = share->keydef, end = keydef + share->keys; keydef < end;
@@ -53,7 +59,10 @@ int heap_write(HP_INFO *info, const uchar *record)
       goto err;
   }
 
-  memcpy(pos,record,(size_t) share->reclength);
+  if (share->blobs)
+    hp_store_record(info, pos, record, 0);
+  else
+    memcpy(pos,record,(size_t) share->reclength);
   pos[share->visible]= 1;                     /* Mark record as not deleted */
   if (++share->records == share->blength)
     share->blength+= share->blength;
@@ -86,6 +95,8 @@ int heap_write(HP_INFO *info, const uchar *record)
       break;
     keydef--;
   } 
+  if (share->blobs)
+    hp_free_copied_blobs(info, 0);
 
   share->deleted++;
   *((uchar**) pos)=share->del_link;
@@ -34,6 +34,7 @@ Created 6/2/1994 Heikki Tuuri
 #include "btr0cur.h"
 #include "btr0sea.h"
 #include "btr0pcur.h"
+#include "buf0stats.h"
 #include "rem0cmp.h"
 #include "lock0lock.h"
 #include "trx0trx.h"
@@ -467,6 +468,7 @@ btr_page_create(
   ut_ad(mtr->memo_contains_flagged(block, MTR_MEMO_PAGE_X_FIX));
   byte *index_id= my_assume_aligned<2>(PAGE_HEADER + PAGE_INDEX_ID +
                                        block->page.frame);
+  buf_index_stats.assign(block->page, index->id);
 
   if (UNIV_LIKELY_NULL(page_zip))
   {
@@ -912,6 +914,7 @@ static void btr_root_page_init(buf_block_t *block, index_id_t index_id,
 {
   constexpr uint16_t field= PAGE_HEADER + PAGE_INDEX_ID;
   byte *page_index_id= my_assume_aligned<2>(field + block->page.frame);
+  buf_index_stats.assign(block->page, index_id);
 
   /* Create a new index page on the allocated segment page */
   if (UNIV_LIKELY_NULL(block->page.zip.data))
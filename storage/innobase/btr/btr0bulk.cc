@@ -28,6 +28,7 @@ Created 03/11/2014 Shaohua Wang
 #include "btr0btr.h"
 #include "btr0cur.h"
 #include "btr0pcur.h"
+#include "buf0stats.h"
 #include "page0page.h"
 #include "trx0trx.h"
 
@@ -74,6 +75,7 @@ PageBulk::init()
 
 		byte* index_id = my_assume_aligned<2>
 			(PAGE_HEADER + PAGE_INDEX_ID + new_page);
+		buf_index_stats.assign(new_block->page, m_index->id);
 		compile_time_assert(FIL_PAGE_NEXT == FIL_PAGE_PREV + 4);
 		compile_time_assert(FIL_NULL == 0xffffffff);
 		memset_aligned<8>(new_page + FIL_PAGE_PREV, 0xff, 8);
@@ -27,6 +27,7 @@ Created 2/17/1996 Heikki Tuuri
 #include "btr0sea.h"
 #ifdef BTR_CUR_HASH_ADAPT
 #include "buf0buf.h"
+#include "buf0stats.h"
 #include "page0page.h"
 #include "page0cur.h"
 #include "btr0cur.h"
@@ -41,6 +42,10 @@ char		btr_search_enabled;
 /** Number of adaptive hash index partition. */
 ulong		btr_ahi_parts;
 
+/** innodb_adaptive_hash_index_tuning: whether the adaptive hash index
+is disabled for indexes where it does not pay off */
+my_bool		btr_search_tuning;
+
 #ifdef UNIV_SEARCH_PERF_STAT
 /** Number of successful adaptive hash index lookups */
 ulint		btr_search_n_succ	= 0;
@@ -211,6 +216,7 @@ ATTRIBUTE_COLD static void btr_search_lazy_free(dict_index_t *index)
     ut_ad(!table->id);
     table->autoinc_mutex.wr_unlock();
     table->autoinc_mutex.destroy();
+    table->shared_scan_mutex.destroy();
     dict_mem_table_free(table);
     return;
   }
@@ -288,6 +294,35 @@ void btr_search_enable(bool resize)
 	btr_search_x_unlock_all();
 }
 
+/** Account for a miss or a maintenance operation of the adaptive hash
+index of an index, and disable hashing for the index if there were
+not enough hits in the tuning window, to save the CPU time and
+the contention on the partition latch. NOTE that info is NOT protected
+by any semaphore!
+@param[in,out]	info	search info */
+static void btr_search_tune(btr_search_t *info)
+{
+	if (!btr_search_tuning
+	    || ++info->tune_cost < BTR_SEARCH_TUNE_WINDOW) {
+		return;
+	}
+
+	const ulint hits = info->tune_hits;
+	info->tune_cost = 0;
+	info->tune_hits = 0;
+
+	if (hits < BTR_SEARCH_TUNE_MIN_HITS) {
+		/* Start the hash analysis from scratch when hashing
+		is tried again. Pages that are hashed for this index will be
+		dropped from the hash index when they are modified. */
+		info->n_hash_potential = 0;
+		info->hash_analysis = 0;
+		info->last_hash_succ = FALSE;
+		info->n_tuned_off++;
+		info->tune_off = BTR_SEARCH_TUNE_OFF;
+	}
+}
+
 /** Updates the search info of an index about hash successes. NOTE that info
 is NOT protected by any semaphore, to save CPU time! Do not assume its fields
 are consistent.
@@ -921,6 +956,8 @@ void
 btr_search_failure(btr_search_t* info, btr_cur_t* cursor)
 {
 	cursor->flag = BTR_CUR_HASH_FAIL;
+	info->n_misses++;
+	btr_search_tune(info);
 
 #ifdef UNIV_SEARCH_PERF_STAT
 	++info->n_hash_fail;
@@ -1049,6 +1086,7 @@ btr_search_guess_on_hash(
 
 	if (latch_mode > BTR_MODIFY_LEAF
 	    || !info->last_hash_succ || !info->n_hash_potential
+	    || info->tune_off
 	    || (tuple->info_bits & REC_INFO_MIN_REC_FLAG)) {
 		return false;
 	}
@@ -1170,6 +1208,9 @@ btr_search_guess_on_hash(
 	}
 
 	info->last_hash_succ = TRUE;
+	info->n_hits++;
+	info->tune_hits++;
+	buf_index_stats.ahi_hit(block->page);
 
 #ifdef UNIV_SEARCH_PERF_STAT
 	btr_search_n_succ++;
@@ -1472,6 +1513,9 @@ btr_search_build_page_hash_index(
 		return;
 	}
 
+	index->search_info->n_maintenance++;
+	btr_search_tune(index->search_info);
+
 	if (rebuild) {
 		btr_search_drop_page_hash_index(block, false);
 	}
@@ -1633,6 +1677,9 @@ void btr_search_info_update_slow(btr_search_t *info, btr_cur_t *cursor)
 	We cannot assume the fields are consistent when we return from
 	those functions! */
 
+	info->n_maintenance++;
+	btr_search_tune(info);
+
 	btr_search_info_update_hash(info, cursor);
 
 	bool build_index = btr_search_update_block_hash_info(info, block);
@@ -1770,7 +1817,7 @@ void btr_search_update_hash_on_delete(btr_cur_t *cursor)
 
 	ut_ad(!cursor->index()->table->is_temporary());
 
-	if (index != cursor->index()) {
+	if (index != cursor->index() || index->search_info->tune_off) {
 		btr_search_drop_page_hash_index(block, false);
 		return;
 	}
@@ -1779,6 +1826,9 @@ void btr_search_update_hash_on_delete(btr_cur_t *cursor)
 	ut_a(index == cursor->index());
 	ut_a(block->curr_n_fields > 0 || block->curr_n_bytes > 0);
 
+	index->search_info->n_maintenance++;
+	btr_search_tune(index->search_info);
+
 	rec = btr_cur_get_rec(cursor);
 
 	fold = rec_fold(rec, rec_get_offsets(rec, index, offsets_,
@@ -1843,7 +1893,7 @@ void btr_search_update_hash_node_on_insert(btr_cur_t *cursor,
 
 	ut_ad(!cursor->index()->table->is_temporary());
 
-	if (index != cursor->index()) {
+	if (index != cursor->index() || index->search_info->tune_off) {
 		ut_ad(index->id == cursor->index()->id);
 		btr_search_drop_page_hash_index(block, false);
 		return;
@@ -1870,6 +1920,8 @@ void btr_search_update_hash_node_on_insert(btr_cur_t *cursor,
 				cursor->fold, rec, block, new_rec)) {
 				MONITOR_INC(MONITOR_ADAPTIVE_HASH_ROW_UPDATED);
 			}
+			index->search_info->n_maintenance++;
+			btr_search_tune(index->search_info);
 		} else {
 			ut_ad("corrupted page" == 0);
 		}
@@ -1934,7 +1986,7 @@ void btr_search_update_hash_on_insert(btr_cur_t *cursor,
 
 	ut_ad(!cursor->index()->table->is_temporary());
 
-	if (index != cursor->index()) {
+	if (index != cursor->index() || index->search_info->tune_off) {
 		ut_ad(index->id == cursor->index()->id);
 drop:
 		btr_search_drop_page_hash_index(block, false);
@@ -1942,6 +1994,8 @@ void btr_search_update_hash_on_insert(btr_cur_t *cursor,
 	}
 
 	ut_a(index == cursor->index());
+	index->search_info->n_maintenance++;
+	btr_search_tune(index->search_info);
 
 	n_fields = block->curr_n_fields;
 	n_bytes = block->curr_n_bytes;
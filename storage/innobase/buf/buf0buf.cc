@@ -44,6 +44,9 @@ Created 11/5/1995 Heikki Tuuri
 #include "buf0flu.h"
 #include "buf0buddy.h"
 #include "buf0dblwr.h"
+#include "buf0tier.h"
+#include "buf0stats.h"
+#include "buf0track.h"
 #include "lock0lock.h"
 #include "btr0sea.h"
 #include "trx0undo.h"
@@ -62,6 +65,8 @@ Created 11/5/1995 Heikki Tuuri
 #include "buf0dump.h"
 #include <map>
 #include <sstream>
+#include <vector>
+#include <algorithm>
 #include "log.h"
 
 using st_::span;
@@ -279,21 +284,27 @@ the read requests for the whole area.
 # ifdef SUX_LOCK_GENERIC
 void page_hash_latch::read_lock_wait()
 {
+  latch_wait w{this};
   /* First, try busy spinning for a while. */
   for (auto spin= srv_n_spin_wait_rounds; spin--; )
   {
+    w.spin();
     LF_BACKOFF();
     if (read_trylock())
       return;
   }
   /* Fall back to yielding to other threads. */
   do
+  {
+    w.sleep();
     std::this_thread::yield();
+  }
   while (!read_trylock());
 }
 
 void page_hash_latch::write_lock_wait()
 {
+  latch_wait w{this};
   write_lock_wait_start();
 
   /* First, try busy spinning for a while. */
@@ -301,12 +312,16 @@ void page_hash_latch::write_lock_wait()
   {
     if (write_lock_poll())
       return;
+    w.spin();
     LF_BACKOFF();
   }
 
   /* Fall back to yielding to other threads. */
   do
+  {
+    w.sleep();
     std::this_thread::yield();
+  }
   while (!write_lock_poll());
 }
 # endif
@@ -1087,6 +1102,7 @@ inline bool buf_pool_t::chunk_t::create(size_t bytes)
   MEM_UNDEFINED(mem, mem_size());
 
 #ifdef HAVE_LIBNUMA
+  numa_node= -1;
   if (srv_numa_interleave)
   {
     struct bitmask *numa_mems_allowed= numa_get_mems_allowed();
@@ -1101,6 +1117,36 @@ inline bool buf_pool_t::chunk_t::create(size_t bytes)
     }
     numa_bitmask_free(numa_mems_allowed);
   }
+  else if (srv_numa_bind)
+  {
+    /* Assign the chunks to the allowed nodes in a round-robin fashion.
+    The memory has not been touched yet, so the pages will be allocated
+    from the preferred node, starting with the block descriptors below. */
+    struct bitmask *numa_mems_allowed= numa_get_mems_allowed();
+    MEM_MAKE_DEFINED(numa_mems_allowed, sizeof *numa_mems_allowed);
+    const unsigned n_nodes= numa_bitmask_weight(numa_mems_allowed);
+    if (n_nodes > 1)
+    {
+      unsigned n= unsigned(this - buf_pool.chunks) % n_nodes;
+      for (unsigned i= 0; i < numa_mems_allowed->size; i++)
+        if (numa_bitmask_isbitset(numa_mems_allowed, i) && !n--)
+        {
+          numa_node= int(i);
+          break;
+        }
+      struct bitmask *node= numa_allocate_nodemask();
+      numa_bitmask_setbit(node, numa_node);
+      if (mbind(mem, mem_size(), MPOL_PREFERRED, node->maskp, node->size,
+                MPOL_MF_MOVE))
+      {
+        ib::warn() << "Failed to bind buffer pool page frames to NUMA node "
+                   << numa_node << " (error: " << strerror(errno) << ").";
+        numa_node= -1;
+      }
+      numa_bitmask_free(node);
+    }
+    numa_bitmask_free(numa_mems_allowed);
+  }
 #endif /* HAVE_LIBNUMA */
 
 
@@ -1202,11 +1248,11 @@ inline const buf_block_t *buf_pool_t::chunk_t::not_freed() const
 void buf_pool_t::page_hash_table::create(ulint n)
 {
   n_cells= ut_find_prime(n);
-  const size_t size= MY_ALIGN(pad(n_cells) * sizeof *array,
-                              CPU_LEVEL1_DCACHE_LINESIZE);
-  void *v= aligned_malloc(size, CPU_LEVEL1_DCACHE_LINESIZE);
-  memset_aligned<CPU_LEVEL1_DCACHE_LINESIZE>(v, 0, size);
-  array= static_cast<hash_chain*>(v);
+  size= MY_ALIGN(pad(n_cells) * sizeof *array, CPU_LEVEL1_DCACHE_LINESIZE);
+  /* The zero-filled mapping is page aligned, and it will be backed by
+  huge pages if possible. */
+  array= reinterpret_cast<hash_chain*>(my_large_malloc(&size, MYF(0)));
+  latch_stats.add(latch_stats_t::BUF_POOL_PAGE_HASH, array, size);
 }
 
 /** Create the buffer pool.
@@ -1327,6 +1373,9 @@ bool buf_pool_t::create()
   chunk_t::map_ref= chunk_t::map_reg;
   buf_LRU_old_ratio_update(100 * 3 / 8, false);
   btr_search_sys_create();
+  buf_tier.create();
+  buf_index_stats.create();
+  buf_track.create();
 
 #ifdef __linux__
   if (srv_operation == SRV_OPERATION_NORMAL)
@@ -1336,6 +1385,17 @@ bool buf_pool_t::create()
   return false;
 }
 
+#ifdef HAVE_LIBNUMA
+int buf_pool_t::numa_node(const buf_page_t &bpage) const
+{
+  mysql_mutex_assert_owner(&mutex);
+  ut_ad(!resize_in_progress());
+  chunk_t::map::const_iterator it= chunk_t::map_ref->upper_bound(bpage.frame);
+  ut_ad(it != chunk_t::map_ref->begin());
+  return (--it)->second->numa_node;
+}
+#endif /* HAVE_LIBNUMA */
+
 /** Clean up after successful create() */
 void buf_pool_t::close()
 {
@@ -1343,6 +1403,9 @@ void buf_pool_t::close()
   if (!is_initialised())
     return;
 
+  buf_tier.close();
+  buf_index_stats.close();
+  buf_track.close();
   mysql_mutex_destroy(&mutex);
   mysql_mutex_destroy(&flush_list_mutex);
 
@@ -1576,12 +1639,42 @@ buf_resize_status(
 	ib::info() << export_vars.innodb_buffer_pool_resize_status;
 }
 
+/** Maximum time to hold buf_pool.mutex while relocating pages
+in buf_pool_t::withdraw_blocks(), in nanoseconds */
+static constexpr ulonglong WITHDRAW_BATCH_NS= 1000000;
+
+/** Release the memory of withdrawn page frames to the operating system.
+@param frames  page frames that are in buf_pool.withdraw */
+static void buf_withdraw_advise(std::vector<byte*> &frames)
+{
+#if defined HAVE_MADVISE && defined MADV_FREE
+  /* Issue one call for each range of adjacent frames. Blocks are never
+  removed from buf_pool.withdraw before the chunks are freed, so this
+  is safe without holding buf_pool.mutex. */
+  std::sort(frames.begin(), frames.end());
+  for (size_t i= 0; i < frames.size(); )
+  {
+    size_t j= i + 1;
+    while (j < frames.size() &&
+           frames[j] == frames[j - 1] + srv_page_size)
+      j++;
+    madvise(frames[i], (j - i) << srv_page_size_shift, MADV_FREE);
+    i= j;
+  }
+#endif
+  frames.clear();
+}
+
 /** Withdraw blocks from the buffer pool until meeting withdraw_target.
+Pages in the withdrawn area are relocated in batches that hold
+buf_pool.mutex for at most WITHDRAW_BATCH_NS at a time, so that
+foreground threads will not be stalled for long.
 @return whether retry is needed */
 inline bool buf_pool_t::withdraw_blocks()
 {
 	buf_block_t*	block;
 	ulint		loop_count = 0;
+	std::vector<byte*> frames;
 
 	ib::info() << "Start to withdraw the last "
 		<< withdraw_target << " blocks.";
@@ -1612,6 +1705,7 @@ inline bool buf_pool_t::withdraw_blocks()
 				UT_LIST_REMOVE(free, &block->page);
 				UT_LIST_ADD_LAST(withdraw, &block->page);
 				ut_d(block->in_withdraw_list = true);
+				frames.push_back(block->page.frame);
 				count1++;
 			}
 
@@ -1619,22 +1713,80 @@ inline bool buf_pool_t::withdraw_blocks()
 		}
 
 		/* reserve free_list length */
-		if (UT_LIST_GET_LEN(withdraw) < withdraw_target) {
+		const bool wait_for_flush
+			= UT_LIST_GET_LEN(withdraw) < withdraw_target;
+		if (wait_for_flush) {
 			try_LRU_scan = false;
-			mysql_mutex_unlock(&mutex);
+		}
+		mysql_mutex_unlock(&mutex);
+
+		buf_withdraw_advise(frames);
+
+		if (wait_for_flush) {
 			mysql_mutex_lock(&flush_list_mutex);
 			page_cleaner_wakeup(true);
 			my_cond_wait(&done_flush_list,
 				     &flush_list_mutex.m_mutex);
 			mysql_mutex_unlock(&flush_list_mutex);
-			mysql_mutex_lock(&mutex);
 		}
 
-		/* relocate blocks/buddies in withdrawn area */
+		/* relocate the pages in the withdrawn area */
 		ulint	count2 = 0;
+		bool	relocate_zip = false;
+		bool	out_of_blocks = false;
+
+		for (chunk_t* chunk = chunks + n_chunks_new,
+		     * const echunk = chunks + n_chunks;
+		     chunk != echunk && !out_of_blocks; chunk++) {
+			for (size_t i = 0; i < chunk->size
+				     && !out_of_blocks; ) {
+				mysql_mutex_lock(&mutex);
+				const ulonglong start = my_interval_timer();
+				buf_pool_mutex_exit_forbid();
+				do {
+					block = &chunk->blocks[i++];
+					switch (block->page.state()) {
+					case buf_page_t::NOT_USED:
+					case buf_page_t::REMOVE_HASH:
+						continue;
+					case buf_page_t::MEMORY:
+						/* possibly used by
+						buf_buddy_alloc() */
+						relocate_zip = true;
+						continue;
+					}
+					if (!block->page.can_relocate()) {
+						continue;
+					}
+					if (!realloc(block)) {
+						/* failed to allocate block */
+						out_of_blocks = true;
+						break;
+					}
+					if (block->page.state()
+					    == buf_page_t::NOT_USED) {
+						/* The page was relocated
+						and block was withdrawn. */
+						frames.push_back(
+							block->page.frame);
+					}
+					count2++;
+				} while (i < chunk->size
+					 && (i & 63
+					     || my_interval_timer() - start
+					     < WITHDRAW_BATCH_NS));
+				buf_pool_mutex_exit_allow();
+				mysql_mutex_unlock(&mutex);
+				buf_withdraw_advise(frames);
+			}
+		}
 
+		/* relocate ROW_FORMAT=COMPRESSED buddies in the
+		withdrawn area */
+		mysql_mutex_lock(&mutex);
 		buf_pool_mutex_exit_forbid();
-		for (buf_page_t* bpage = UT_LIST_GET_FIRST(LRU), *next_bpage;
+		for (buf_page_t* bpage = relocate_zip
+			     ? UT_LIST_GET_FIRST(LRU) : nullptr, *next_bpage;
 		     bpage; bpage = next_bpage) {
 			ut_ad(bpage->in_file());
 			next_bpage = UT_LIST_GET_NEXT(LRU, bpage);
@@ -1648,20 +1800,6 @@ inline bool buf_pool_t::withdraw_blocks()
 					break;
 				}
 				count2++;
-				if (bpage->frame) {
-					goto realloc_frame;
-				}
-			}
-
-			if (bpage->frame && will_be_withdrawn(*bpage)
-			    && bpage->can_relocate()) {
-realloc_frame:
-				if (!realloc(reinterpret_cast<buf_block_t*>(
-						     bpage))) {
-					/* failed to allocate block */
-					break;
-				}
-				count2++;
 			}
 		}
 		buf_pool_mutex_exit_allow();
@@ -3330,6 +3468,8 @@ static buf_block_t *buf_page_create_low(page_id_t page_id, ulint zip_size,
                         : state & buf_page_t::LRU_MASK);
     }
 
+    buf_index_stats.reinit(*bpage);
+
 #ifdef BTR_CUR_HASH_ADAPT
     if (drop_hash_entry)
       btr_search_drop_page_hash_index(reinterpret_cast<buf_block_t*>(bpage),
@@ -3344,6 +3484,9 @@ static buf_block_t *buf_page_create_low(page_id_t page_id, ulint zip_size,
   DBUG_PRINT("ib_buf", ("create page %u:%u",
                         page_id.space(), page_id.page_no()));
 
+  /* Any copy of the old contents of the page is now stale. */
+  buf_tier.discard(page_id);
+
   bpage= &free_block->page;
 
   ut_ad(bpage->state() == buf_page_t::MEMORY);
@@ -3355,6 +3498,7 @@ static buf_block_t *buf_page_create_low(page_id_t page_id, ulint zip_size,
     transactional_lock_guard<page_hash_latch> g
       {buf_pool.page_hash.lock_get(chain)};
     bpage->set_state(buf_page_t::REINIT + 1);
+    buf_index_stats.add(*bpage);
     buf_pool.page_hash.append(chain, bpage);
   }
 
@@ -3707,6 +3851,7 @@ dberr_t buf_page_t::read_complete(const fil_node_t &node)
 
   if (UNIV_UNLIKELY(MONITOR_IS_ON(MONITOR_MODULE_BUF_PAGE)))
     buf_page_monitor(*this, true);
+  buf_index_stats.read(*this, read_frame);
   DBUG_PRINT("ib_buf", ("read page %u:%u", id().space(), id().page_no()));
 
   if (!recovery)
@@ -40,6 +40,7 @@ Created April 08, 2011 Vasil Dimov
 #include "ut0byte.h"
 
 #include <algorithm>
+#include <thread>
 
 #include "mysql/service_wsrep.h" /* wsrep_recovery */
 #include <my_service_manager.h>
@@ -415,6 +416,59 @@ buf_dump(
 	export_vars.innodb_buffer_pool_load_incomplete = 0;
 }
 
+/** Limits the rate of buffer pool load while the buffer pool is being
+accessed by other threads. As long as only buffer pool load is reading
+pages, it runs at full speed; after innodb_io_capacity pages have been
+submitted, if also other threads read pages in the meantime, the load
+pauses for the rest of the second, so that it will not compete with
+the workload for the I/O capacity. */
+class buf_load_throttle
+{
+	/** start time of the interval, from my_interval_timer() */
+	ulonglong	start;
+	/** buf_pool.stat.n_pages_read at start */
+	ulint		n_pages_read;
+	/** number of pages submitted by buf_load() since start */
+	ulint		n_submitted = 0;
+
+	/** Start a new interval. */
+	void reset()
+	{
+		mysql_mutex_lock(&buf_pool.mutex);
+		n_pages_read = buf_pool.stat.n_pages_read;
+		mysql_mutex_unlock(&buf_pool.mutex);
+		start = my_interval_timer();
+		n_submitted = 0;
+	}
+public:
+	buf_load_throttle() { reset(); }
+
+	/** Note that pages were submitted for reading, and pause if needed.
+	@param n	number of pages submitted by buf_load() */
+	void submitted(ulint n)
+	{
+		n_submitted += n;
+		if (n_submitted < srv_io_capacity) {
+			return;
+		}
+
+		mysql_mutex_lock(&buf_pool.mutex);
+		const ulint n_read = buf_pool.stat.n_pages_read - n_pages_read;
+		mysql_mutex_unlock(&buf_pool.mutex);
+
+		if (n_read > n_submitted) {
+			const ulonglong end = start + 1000000000ULL;
+			while (!SHUTTING_DOWN() && !buf_load_abort_flag
+			       && my_interval_timer() < end) {
+				std::this_thread::sleep_for(
+					std::chrono::milliseconds(10));
+			}
+		}
+
+		reset();
+	}
+};
+
 /*****************************************************************//**
 Perform a buffer pool load from the file specified by
 innodb_buffer_pool_filename. If any errors occur then the value of
@@ -592,6 +646,8 @@ buf_load()
 	mysql_stage_set_work_estimated(pfs_stage_progress, dump_n);
 	mysql_stage_set_work_completed(pfs_stage_progress, 0);
 
+	buf_load_throttle	throttle;
+
 	for (i = 0; i < dump_n && !SHUTTING_DOWN(); i++) {
 
 		/* space_id for this iteration of the loop */
@@ -631,8 +687,22 @@ buf_load()
 			continue;
 		}
 
-		space->reacquire();
-		buf_read_page_background(space, dump[i], zip_size);
+		/* Submit a run of consecutive pages at once, so that
+		they can be read with a single IORequest::READ_BATCH. */
+		const uint32_t	size = space->get_size();
+		ulint		run = i + 1;
+		while (run < dump_n
+		       && run - i < buf_pool_t::READ_AHEAD_PAGES
+		       && dump[run].space() == this_space_id
+		       && dump[run].page_no() == dump[run - 1].page_no() + 1
+		       && dump[run].page_no() < size) {
+			run++;
+		}
+
+		throttle.submitted(buf_read_pages_background(
+					   space, dump[i], dump[run - 1] + 1,
+					   zip_size));
+		i = run - 1;
 
 		if (buf_load_abort_flag) {
 			if (space) {
@@ -34,6 +34,8 @@ Created 11/11/1995 Heikki Tuuri
 #include "buf0buf.h"
 #include "buf0checksum.h"
 #include "buf0dblwr.h"
+#include "buf0stats.h"
+#include "buf0track.h"
 #include "srv0start.h"
 #include "page0zip.h"
 #include "fil0fil.h"
@@ -284,10 +286,13 @@ void buf_page_t::write_complete(bool persistent, bool error, uint32_t state)
     ut_d(lsn_t om= oldest_modification());
     ut_ad(om >= 2);
     ut_ad(persistent == (om > 2));
+    if (persistent)
+      buf_track.add(id());
     /* We use release memory order to guarantee that callers of
     oldest_modification_acquire() will observe the block as
     being detached from buf_pool.flush_list, after reading the value 0. */
     oldest_modification_.store(persistent, std::memory_order_release);
+    buf_index_stats.write(*this);
   }
   zip.fix.fetch_sub((state >= WRITE_FIX_REINIT)
                     ? (WRITE_FIX_REINIT - UNFIXED)
@@ -577,6 +582,20 @@ a page is written to disk.
 @param[in,out]  size    payload size in bytes
 @return page frame to be written to file
 (may be src_frame or an encrypted/compressed copy of it) */
+/** @return whether the pages of a tablespace are encrypted when written */
+static bool buf_flush_encrypted(const fil_space_t &space)
+{
+  if (space.purpose == FIL_TYPE_TEMPORARY)
+  {
+    ut_ad(!space.crypt_data);
+    return innodb_encrypt_temporary_tables;
+  }
+  const fil_space_crypt_t *crypt_data= space.crypt_data;
+  return crypt_data && !crypt_data->not_encrypted() &&
+    crypt_data->type != CRYPT_SCHEME_UNENCRYPTED &&
+    (!crypt_data->is_default_encryption() || srv_encrypt_tables);
+}
+
 static byte *buf_page_encrypt(fil_space_t* space, buf_page_t* bpage, byte* s,
                               buf_tmp_buffer_t **slot, size_t *size)
 {
@@ -598,21 +617,9 @@ static byte *buf_page_encrypt(fil_space_t* space, buf_page_t* bpage, byte* s,
     return s;
   }
 
-  fil_space_crypt_t *crypt_data= space->crypt_data;
-  bool encrypted, page_compressed;
-  if (space->purpose == FIL_TYPE_TEMPORARY)
-  {
-    ut_ad(!crypt_data);
-    encrypted= innodb_encrypt_temporary_tables;
-    page_compressed= false;
-  }
-  else
-  {
-    encrypted= crypt_data && !crypt_data->not_encrypted() &&
-      crypt_data->type != CRYPT_SCHEME_UNENCRYPTED &&
-      (!crypt_data->is_default_encryption() || srv_encrypt_tables);
-    page_compressed= space->is_compressed();
-  }
+  const bool encrypted= buf_flush_encrypted(*space);
+  const bool page_compressed= space->purpose != FIL_TYPE_TEMPORARY &&
+    space->is_compressed();
 
   const bool full_crc32= space->full_crc32();
 
@@ -721,6 +728,175 @@ ATTRIBUTE_COLD void buf_pool_t::release_freed_page(buf_page_t *bpage) noexcept
   buf_LRU_free_page(bpage, true);
 }
 
+/** A page write that buf_flush_page_cleaner() handed over to a worker */
+struct buf_flush_write_t
+{
+  buf_page_t *bpage;
+  fil_space_t *space;
+  lsn_t lsn;
+  uint32_t state;
+};
+
+/** A thread that helps buf_flush_page_cleaner() with a shard of the
+page writes, selected by page_id_t::fold(). Checksums, encryption and
+compression are computed and the writes submitted by the workers, while
+the page cleaner keeps choosing the pages and advancing the checkpoint.
+A handed over page is write-fixed and remains in buf_pool.flush_list until
+the write completes, so the oldest modification (and the checkpoint)
+cannot move past it. The page cleaner only has to wait for all hand-overs
+before buf_dblwr.flush_buffered_writes().
+
+The pages of tablespaces that are page_compressed or encrypted are all
+handed over, so that the page cleaner does not spend its time on
+compressing or encrypting while it could be choosing the next pages. */
+struct buf_flush_worker_t
+{
+  mysql_mutex_t mutex;
+  /** signalled when queue becomes nonempty, or on shutdown */
+  pthread_cond_t cond;
+  /** signalled when pending reaches 0 */
+  pthread_cond_t done;
+  /** writes that have not been picked up yet */
+  std::vector<buf_flush_write_t> queue;
+  /** number of writes queued or being submitted */
+  size_t pending;
+  /** whether the worker should exit when queue is empty */
+  bool stop;
+};
+
+/** innodb_page_cleaner_threads - 1 workers */
+static buf_flush_worker_t *buf_flush_workers;
+/** number of elements in buf_flush_workers */
+static uint buf_flush_n_workers;
+/** whether the current thread is buf_flush_page_cleaner() */
+static thread_local bool buf_flush_in_page_cleaner;
+
+/** Hand over a write-fixed page to a page cleaner worker.
+@return whether the page was handed over */
+static bool buf_flush_offload(buf_page_t *bpage, fil_space_t *space,
+                              lsn_t lsn, uint32_t s)
+{
+  if (!buf_flush_in_page_cleaner || !buf_flush_n_workers)
+    return false;
+  const ulint fold= bpage->id().fold();
+  ulint shard;
+  if (space->is_compressed() || buf_flush_encrypted(*space))
+    shard= 1 + fold % buf_flush_n_workers;
+  /* shard 0 of the other pages is written by the page cleaner itself */
+  else if (!(shard= fold % (buf_flush_n_workers + 1)))
+    return false;
+  buf_flush_worker_t &w= buf_flush_workers[shard - 1];
+  mysql_mutex_lock(&w.mutex);
+  w.queue.push_back(buf_flush_write_t{bpage, space, lsn, s});
+  if (!w.pending++)
+    pthread_cond_signal(&w.cond);
+  mysql_mutex_unlock(&w.mutex);
+  return true;
+}
+
+/** Wait until all page writes handed over by buf_flush_page_cleaner()
+have been submitted. */
+static void buf_flush_workers_wait()
+{
+  if (!buf_flush_in_page_cleaner)
+    return;
+  for (uint i= 0; i < buf_flush_n_workers; i++)
+  {
+    buf_flush_worker_t &w= buf_flush_workers[i];
+    mysql_mutex_lock(&w.mutex);
+    while (w.pending)
+      my_cond_wait(&w.done, &w.mutex.m_mutex);
+    mysql_mutex_unlock(&w.mutex);
+  }
+}
+
+/** Page cleaner worker thread */
+static void buf_flush_worker(buf_flush_worker_t *w)
+{
+  my_thread_init();
+#ifdef UNIV_PFS_THREAD
+  pfs_register_thread(page_cleaner_thread_key);
+#endif /* UNIV_PFS_THREAD */
+  my_thread_set_name("page_cleaner");
+
+  std::vector<buf_flush_write_t> batch;
+  mysql_mutex_lock(&w->mutex);
+  for (;;)
+  {
+    if (w->queue.empty())
+    {
+      if (w->stop)
+        break;
+      my_cond_wait(&w->cond, &w->mutex.m_mutex);
+      continue;
+    }
+    batch.swap(w->queue);
+    mysql_mutex_unlock(&w->mutex);
+    for (const buf_flush_write_t &write : batch)
+      write.bpage->submit_write(write.space, write.lsn, write.state);
+    mysql_mutex_lock(&w->mutex);
+    w->pending-= batch.size();
+    batch.clear();
+    if (!w->pending)
+      pthread_cond_broadcast(&w->done);
+  }
+  mysql_mutex_unlock(&w->mutex);
+
+  my_thread_end();
+#ifdef UNIV_PFS_THREAD
+  pfs_delete_thread();
+#endif
+}
+
+/** Start the page cleaner workers.
+@return the worker threads */
+static std::vector<std::thread> buf_flush_workers_start()
+{
+  std::vector<std::thread> threads;
+  buf_flush_n_workers= srv_n_page_cleaner_threads - 1;
+  if (!buf_flush_n_workers)
+    return threads;
+  buf_flush_workers= new buf_flush_worker_t[buf_flush_n_workers];
+  for (uint i= 0; i < buf_flush_n_workers; i++)
+  {
+    buf_flush_worker_t &w= buf_flush_workers[i];
+    mysql_mutex_init(page_cleaner_mutex_key, &w.mutex, nullptr);
+    pthread_cond_init(&w.cond, nullptr);
+    pthread_cond_init(&w.done, nullptr);
+    w.pending= 0;
+    w.stop= false;
+    threads.emplace_back(buf_flush_worker, &w);
+  }
+  return threads;
+}
+
+/** Stop the page cleaner workers after submitting all handed over writes.
+@param threads  buf_flush_workers_start() */
+static void buf_flush_workers_stop(std::vector<std::thread> &threads)
+{
+  for (uint i= 0; i < buf_flush_n_workers; i++)
+  {
+    buf_flush_worker_t &w= buf_flush_workers[i];
+    mysql_mutex_lock(&w.mutex);
+    w.stop= true;
+    pthread_cond_signal(&w.cond);
+    mysql_mutex_unlock(&w.mutex);
+  }
+  for (std::thread &t : threads)
+    t.join();
+  for (uint i= 0; i < buf_flush_n_workers; i++)
+  {
+    buf_flush_worker_t &w= buf_flush_workers[i];
+    ut_ad(!w.pending);
+    mysql_mutex_destroy(&w.mutex);
+    pthread_cond_destroy(&w.cond);
+    pthread_cond_destroy(&w.done);
+  }
+  delete[] buf_flush_workers;
+  buf_flush_workers= nullptr;
+  buf_flush_n_workers= 0;
+}
+
 /** Write a flushable page to a file or free a freeable block.
 @param space       tablespace
 @return whether a page write was initiated and buf_pool.mutex released */
@@ -776,6 +952,18 @@ bool buf_page_t::flush(fil_space_t *space)
   buf_LRU_stat_inc_io();
   mysql_mutex_unlock(&buf_pool.mutex);
 
+  space->reacquire();
+  if (!buf_flush_offload(this, space, lsn, s))
+    submit_write(space, lsn, s);
+  return true;
+}
+
+/** Prepare and submit the write of a write-fixed page.
+@param space       tablespace, reacquired by flush()
+@param lsn         FIL_PAGE_LSN
+@param s           state() before the page was write-fixed */
+void buf_page_t::submit_write(fil_space_t *space, lsn_t lsn, uint32_t s)
+{
   IORequest::Type type= IORequest::WRITE_ASYNC;
 
   /* Apart from the U-lock, this block will also be protected by
@@ -785,7 +973,6 @@ bool buf_page_t::flush(fil_space_t *space)
   buf_block_t *block= reinterpret_cast<buf_block_t*>(this);
   page_t *write_frame= zip.data;
 
-  space->reacquire();
   size_t size;
 #if defined HAVE_FALLOC_PUNCH_HOLE_AND_KEEP_SIZE || defined _WIN32
   size_t orig_size;
@@ -854,7 +1041,6 @@ bool buf_page_t::flush(fil_space_t *space)
   else
     buf_dblwr.add_to_batch(IORequest{this, slot, space->chain.start, type},
                            size);
-  return true;
 }
 
 /** Check whether a page can be flushed from the buf_pool.
@@ -1582,6 +1768,7 @@ static ulint buf_flush_list(ulint max_n= ULINT_UNDEFINED,
   mysql_mutex_lock(&buf_pool.mutex);
   ulint n= buf_flush_list_holding_mutex(max_n, lsn);
   mysql_mutex_unlock(&buf_pool.mutex);
+  buf_flush_workers_wait();
   buf_dblwr.flush_buffered_writes();
   return n;
 }
@@ -1783,6 +1970,7 @@ inline void log_t::write_checkpoint(lsn_t end_lsn) noexcept
       header_write(resize_buf, resizing, is_encrypted());
       pmem_persist(resize_buf, resize_target);
     }
+    buf_track.checkpoint(next_checkpoint_lsn);
     pmem_persist(c, 64);
   }
   else
@@ -1792,6 +1980,7 @@ inline void log_t::write_checkpoint(lsn_t end_lsn) noexcept
     ut_ad(!checkpoint_pending);
     checkpoint_pending= true;
     latch.wr_unlock();
+    buf_track.checkpoint(next_checkpoint_lsn);
     log_write_and_flush_prepare();
     resizing= resize_lsn.load(std::memory_order_relaxed);
     ut_ad(ut_is_2pow(write_size));
@@ -2413,6 +2602,8 @@ static void buf_flush_page_cleaner()
   my_thread_set_name("page_cleaner");
   ut_ad(!srv_read_only_mode);
   ut_ad(buf_page_cleaner_is_active);
+  buf_flush_in_page_cleaner= true;
+  std::vector<std::thread> workers= buf_flush_workers_start();
 
   ulint last_pages= 0;
   timespec abstime;
@@ -2474,6 +2665,7 @@ static void buf_flush_page_cleaner()
       if (UNIV_UNLIKELY(srv_shutdown_state > SRV_SHUTDOWN_INITIATED))
         break;
       mysql_mutex_unlock(&buf_pool.flush_list_mutex);
+      buf_flush_workers_wait();
       buf_dblwr.flush_buffered_writes();
 
       do
@@ -2635,6 +2827,8 @@ static void buf_flush_page_cleaner()
 
   mysql_mutex_unlock(&buf_pool.flush_list_mutex);
 
+  buf_flush_workers_wait();
+
   if (srv_fast_shutdown != 2)
   {
     buf_dblwr.flush_buffered_writes();
@@ -2652,6 +2846,9 @@ static void buf_flush_page_cleaner()
     mysql_mutex_unlock(&buf_pool.flush_list_mutex);
     goto furious_flush;
   }
+  mysql_mutex_unlock(&buf_pool.flush_list_mutex);
+  buf_flush_workers_stop(workers);
+  mysql_mutex_lock(&buf_pool.flush_list_mutex);
   buf_page_cleaner_is_active= false;
   pthread_cond_broadcast(&buf_pool.done_flush_list);
   mysql_mutex_unlock(&buf_pool.flush_list_mutex);
@@ -31,6 +31,8 @@ Created 11/5/1995 Heikki Tuuri
 #include "buf0buf.h"
 #include "buf0flu.h"
 #include "buf0rea.h"
+#include "buf0tier.h"
+#include "buf0stats.h"
 #include "btr0sea.h"
 #include "os0file.h"
 #include "page0zip.h"
@@ -38,6 +40,10 @@ Created 11/5/1995 Heikki Tuuri
 #include "srv0srv.h"
 #include "srv0mon.h"
 #include "my_cpu.h"
+#ifdef HAVE_LIBNUMA
+# include <numa.h>
+# include <sched.h>
+#endif
 
 /** The number of blocks from the LRU_old pointer onward, including
 the block pointed to, must be buf_pool.LRU_old_ratio/BUF_LRU_OLD_RATIO_DIV
@@ -76,6 +82,12 @@ static constexpr ulint BUF_LRU_STAT_N_INTERVAL= 4;
 with page_zip_decompress() operations. */
 static constexpr ulint BUF_LRU_IO_TO_UNZIP_FACTOR= 50;
 
+#ifdef HAVE_LIBNUMA
+/** Number of buf_pool.free blocks to check for a block of the local
+NUMA node when innodb_numa_bind=ON */
+static constexpr ulint BUF_LRU_FREE_LOCAL_SCAN= 32;
+#endif
+
 /** Sampled values buf_LRU_stat_cur.
 Not protected by any mutex.  Updated by buf_LRU_stat_update(). */
 static buf_LRU_stat_t		buf_LRU_stat_arr[BUF_LRU_STAT_N_INTERVAL];
@@ -259,6 +271,35 @@ static bool buf_LRU_free_from_common_LRU_list(ulint limit)
 	return(freed);
 }
 
+#ifdef HAVE_LIBNUMA
+/** Look for a block of the local NUMA node near the start of
+buf_pool.free when innodb_numa_bind=ON.
+@param first	the first block of buf_pool.free
+@return	a block of the NUMA node of the current CPU
+@retval	first	if no such block was found */
+static buf_block_t* buf_LRU_get_free_local(buf_block_t* first)
+{
+	const int cpu = sched_getcpu();
+	if (cpu < 0) {
+		return first;
+	}
+
+	const int node = numa_node_of_cpu(cpu);
+	buf_page_t* bpage = &first->page;
+
+	/* Freed blocks are added to the start of the list, so a thread
+	that evicts pages will usually find blocks of its own node here. */
+	for (ulint i = BUF_LRU_FREE_LOCAL_SCAN; i-- && bpage;
+	     bpage = UT_LIST_GET_NEXT(list, bpage)) {
+		if (buf_pool.numa_node(*bpage) == node) {
+			return reinterpret_cast<buf_block_t*>(bpage);
+		}
+	}
+
+	return first;
+}
+#endif /* HAVE_LIBNUMA */
+
 /** @return a buffer block from the buf_pool.free list
 @retval	NULL	if the free list is empty */
 buf_block_t* buf_LRU_get_free_only()
@@ -270,6 +311,13 @@ buf_block_t* buf_LRU_get_free_only()
 	block = reinterpret_cast<buf_block_t*>(
 		UT_LIST_GET_FIRST(buf_pool.free));
 
+#ifdef HAVE_LIBNUMA
+	if (srv_numa_bind && !srv_numa_interleave && block
+	    && !buf_pool.resize_in_progress()) {
+		block = buf_LRU_get_free_local(block);
+	}
+#endif /* HAVE_LIBNUMA */
+
 	while (block != NULL) {
 		ut_ad(block->page.in_free_list);
 		ut_d(block->page.in_free_list = FALSE);
@@ -848,6 +896,14 @@ bool buf_LRU_free_page(buf_page_t *bpage, bool zip)
 
 	ut_ad(bpage->can_relocate());
 
+	/* Keep a copy of a clean uncompressed page, which is identical
+	to the page in the persistent data file. */
+	if (UNIV_UNLIKELY(buf_tier.enabled()) && !b && !bpage->zip.data
+	    && bpage->frame && !bpage->is_freed()
+	    && id.space() != SRV_TMP_SPACE_ID && !recv_recovery_is_on()) {
+		buf_tier.insert(id, bpage->frame);
+	}
+
 	if (!buf_LRU_block_remove_hashed(bpage, id, chain, zip)) {
 		ut_ad(!b);
 		mysql_mutex_assert_not_owner(&buf_pool.flush_list_mutex);
@@ -884,6 +940,7 @@ bool buf_LRU_free_page(buf_page_t *bpage, bool zip)
 		ut_d(b->in_page_hash = false);
 		b->hash = nullptr;
 
+		buf_index_stats.readd(*b);
 		buf_pool.page_hash.append(chain, b);
 
 		/* Insert b where bpage was in the LRU list. */
@@ -1113,6 +1170,7 @@ static bool buf_LRU_block_remove_hashed(buf_page_t *bpage, const page_id_t id,
 	}
 
 	ut_ad(!bpage->in_zip_hash);
+	buf_index_stats.remove(*bpage);
 	buf_pool.page_hash.remove(chain, bpage);
 	page_hash_latch& hash_lock = buf_pool.page_hash.lock_get(chain);
 
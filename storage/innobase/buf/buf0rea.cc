@@ -35,6 +35,8 @@ Created 11/5/1995 Heikki Tuuri
 #include "buf0lru.h"
 #include "buf0buddy.h"
 #include "buf0dblwr.h"
+#include "buf0tier.h"
+#include "buf0stats.h"
 #include "page0zip.h"
 #include "log0recv.h"
 #include "trx0sys.h"
@@ -122,6 +124,7 @@ static buf_page_t *buf_page_init_for_read(const page_id_t page_id,
   {
     block= nullptr;
     /* Insert into the hash table of file pages */
+    buf_index_stats.add(*bpage);
     buf_pool.page_hash.append(chain, bpage);
     hash_lock.unlock();
 
@@ -180,6 +183,7 @@ static buf_page_t *buf_page_init_for_read(const page_id_t page_id,
     {
       transactional_lock_guard<page_hash_latch> g
         {buf_pool.page_hash.lock_get(chain)};
+      buf_index_stats.add(*bpage);
       buf_pool.page_hash.append(chain, bpage);
     }
 
@@ -196,6 +200,25 @@ static buf_page_t *buf_page_init_for_read(const page_id_t page_id,
   return bpage;
 }
 
+/** Try to read a page from buf_tier instead of the data file.
+@param bpage  read-fixed page
+@param space  tablespace
+@return whether the page was copied to bpage->frame */
+static bool buf_read_from_tier(buf_page_t *bpage, const fil_space_t &space)
+{
+  if (UNIV_LIKELY(!buf_tier.enabled()))
+    return false;
+  /* The copies are of the page frame, which differs from the
+  file contents of encrypted or compressed pages. */
+  if (bpage->zip.data || space.crypt_data || space.is_compressed() ||
+      space.purpose != FIL_TYPE_TABLESPACE)
+  {
+    buf_tier.take(bpage->id(), nullptr);
+    return false;
+  }
+  return buf_tier.take(bpage->id(), bpage->frame);
+}
+
 /** Low-level function which reads a page asynchronously from a file to the
 buffer buf_pool if it is not already there, in which case does nothing.
 Sets the io_fix flag and sets an exclusive lock on the buffer frame. The
@@ -207,7 +230,8 @@ flag is cleared and the x-lock released by an i/o-handler thread.
 @param[in,out] chain	buf_pool.page_hash cell for page_id
 @param[in,out] space	tablespace
 @param[in,out] block	preallocated buffer block
-@param[in] sync		true if synchronous aio is desired
+@param[in] type		IORequest::READ_SYNC, IORequest::READ_ASYNC,
+			or IORequest::READ_AHEAD
 @return error code
 @retval DB_SUCCESS if the page was read
 @retval DB_SUCCESS_LOCKED_REC if the page exists in the buffer pool already */
@@ -219,9 +243,13 @@ buf_read_page_low(
 	buf_pool_t::hash_chain&	chain,
 	fil_space_t*		space,
 	buf_block_t*&		block,
-	bool			sync = false)
+	IORequest::Type		type)
 {
 	buf_page_t*	bpage;
+	const bool	sync = type == IORequest::READ_SYNC;
+
+	ut_ad(sync || type == IORequest::READ_ASYNC
+	      || type == IORequest::READ_AHEAD);
 
 	if (buf_dblwr.is_inside(page_id)) {
 		space->release();
@@ -236,6 +264,14 @@ buf_read_page_low(
 	}
 
 	ut_ad(bpage->in_file());
+
+	if (buf_read_from_tier(bpage, *space)) {
+		DBUG_LOG("ib_buf", "read page " << page_id << " from tier");
+		dberr_t err = bpage->read_complete(*space->chain.start);
+		space->release();
+		return err;
+	}
+
 	ulonglong mariadb_timer = 0;
 
 	if (sync) {
@@ -254,9 +290,7 @@ buf_read_page_low(
 	void* dst = zip_size > 1 ? bpage->zip.data : bpage->frame;
 	const ulint len = zip_size & ~1 ? zip_size & ~1 : srv_page_size;
 
-	auto fio = space->io(IORequest(sync
-				       ? IORequest::READ_SYNC
-				       : IORequest::READ_ASYNC),
+	auto fio = space->io(IORequest(type),
 			     os_offset_t{page_id.page_no()} * len, len,
 			     dst, bpage);
 
@@ -293,6 +327,205 @@ static void buf_read_release(buf_block_t *block)
   }
 }
 
+/** Consecutive pages of a read-ahead area that are read with a single
+IORequest::READ_BATCH into a staging buffer, and copied to the page frames
+on completion. This trades a memcpy() per page for one system call and one
+completion instead of one per page. */
+struct buf_read_batch
+{
+  /** the pages being read, with consecutive page numbers */
+  buf_page_t *pages[buf_pool_t::READ_AHEAD_PAGES];
+  /** number of pages */
+  uint32_t n;
+
+  /** @return the staging buffer, aligned to srv_page_size */
+  byte *buf() { return reinterpret_cast<byte*>(this) - (size_t{n} <<
+                                                         srv_page_size_shift); }
+
+  /** Allocate a batch, with the descriptor after the staging buffer.
+  @param run  the pages
+  @param n    number of pages
+  @return the batch
+  @retval nullptr if out of memory */
+  static buf_read_batch *create(buf_page_t *const *run, uint32_t n)
+  {
+    ut_ad(n > 1);
+    ut_ad(n <= buf_pool_t::READ_AHEAD_PAGES);
+    const size_t size= size_t{n} << srv_page_size_shift;
+    byte *buf= static_cast<byte*>(aligned_malloc(size + sizeof(buf_read_batch),
+                                                 srv_page_size));
+    if (UNIV_UNLIKELY(!buf))
+      return nullptr;
+    buf_read_batch *batch= reinterpret_cast<buf_read_batch*>(buf + size);
+    batch->n= n;
+    memcpy(batch->pages, run, n * sizeof *run);
+    return batch;
+  }
+
+  /** Free the batch */
+  void free() { aligned_free(buf()); }
+};
+
+/** Submit an asynchronous read of consecutive pages.
+@param space  tablespace, with a reference acquired for each page
+@param req    I/O request
+@param buf    where to read the pages
+@param run    the pages
+@param n      number of pages
+@return whether the read was submitted */
+static bool buf_read_submit(fil_space_t *space, const IORequest &req,
+                            void *buf, buf_page_t *const *run, uint32_t n)
+{
+  const fil_io_t fio= space->io(req, os_offset_t{run[0]->id().page_no()} <<
+                                srv_page_size_shift,
+                                size_t{n} << srv_page_size_shift, buf, run[0]);
+  if (UNIV_LIKELY(fio.err == DB_SUCCESS))
+    return true;
+
+  /* space->io() released one reference */
+  for (uint32_t i= 0; i < n; i++)
+  {
+    if (i)
+      space->release();
+    recv_sys.free_corrupted_page(run[i]->id(), *space->chain.start);
+    buf_pool.corrupted_evict(run[i], buf_page_t::READ_FIX);
+  }
+  return false;
+}
+
+/** Submit asynchronous reads of uncompressed consecutive pages.
+@param space  tablespace
+@param run    the pages
+@param n      number of pages
+@return number of pages whose read was submitted */
+static ulint buf_read_run(fil_space_t *space, buf_page_t *const *run,
+                          uint32_t n)
+{
+  if (n > 1)
+  {
+    if (buf_read_batch *batch= buf_read_batch::create(run, n))
+    {
+      for (uint32_t i= n; i--; )
+        space->reacquire();
+      DBUG_LOG("ib_buf", "read " << n << " pages from " << run[0]->id());
+      if (buf_read_submit(space, IORequest{IORequest::READ_BATCH, run[0],
+                                           reinterpret_cast<buf_tmp_buffer_t*>
+                                           (batch)},
+                          batch->buf(), run, n))
+        return n;
+      batch->free();
+      return 0;
+    }
+  }
+
+  ulint count= 0;
+  for (uint32_t i= 0; i < n; i++)
+  {
+    space->reacquire();
+    count+= buf_read_submit(space, IORequest{IORequest::READ_AHEAD, run[i]},
+                            run[i]->frame, &run[i], 1);
+  }
+  return count;
+}
+
+void buf_read_batch_complete(const IORequest &request, int io_error)
+{
+  ut_ad(request.type == IORequest::READ_BATCH);
+  buf_read_batch *batch= reinterpret_cast<buf_read_batch*>(request.slot);
+  ut_ad(request.bpage == batch->pages[0]);
+  const byte *buf= batch->buf();
+
+  for (uint32_t i= 0; i < batch->n; i++, buf+= srv_page_size)
+  {
+    buf_page_t *bpage= batch->pages[i];
+    if (!io_error)
+      memcpy_aligned<4096>(bpage->frame, buf, srv_page_size);
+    IORequest{bpage, nullptr, request.node, IORequest::READ_ASYNC}.
+      read_complete(io_error);
+  }
+
+  batch->free();
+}
+
+/** Read the pages of a read-ahead area that are not in the buffer pool.
+@param space     tablespace
+@param id        first page to read
+@param end       end of the area
+@param zip_size  ROW_FORMAT=COMPRESSED page size, or 0,
+                 bitwise-ORed with 1 in recovery
+@param block     preallocated buffer block
+@return number of page read requests issued */
+static ulint buf_read_ahead_pages(fil_space_t *space, page_id_t id,
+                                  const page_id_t end, unsigned zip_size,
+                                  buf_block_t *&block)
+{
+  ulint count= 0;
+
+  if (zip_size || UT_LIST_GET_NEXT(chain, UT_LIST_GET_FIRST(space->chain)))
+  {
+    /* Read ROW_FORMAT=COMPRESSED pages, or pages of a tablespace that
+    consists of multiple files, one by one. */
+    for (; id < end; ++id)
+    {
+      if (space->is_stopping())
+        break;
+      buf_pool_t::hash_chain &chain= buf_pool.page_hash.cell_get(id.fold());
+      space->reacquire();
+      if (buf_read_page_low(id, zip_size, chain, space, block,
+                            IORequest::READ_AHEAD) == DB_SUCCESS)
+      {
+        count++;
+        ut_ad(!block);
+        if ((!zip_size || (zip_size & 1)) &&
+            UNIV_UNLIKELY(!(block= buf_read_acquire())))
+          break;
+      }
+    }
+    return count;
+  }
+
+  /* Coalesce the pages that are not in the buffer pool yet into runs
+  of consecutive pages. */
+  buf_page_t *run[buf_pool_t::READ_AHEAD_PAGES];
+  uint32_t n= 0;
+
+  for (; id < end; ++id)
+  {
+    if (space->is_stopping())
+      break;
+    buf_page_t *bpage= nullptr;
+    if (!buf_dblwr.is_inside(id))
+    {
+      buf_pool_t::hash_chain &chain= buf_pool.page_hash.cell_get(id.fold());
+      bpage= buf_page_init_for_read(id, 0, chain, block);
+    }
+    if (!bpage)
+    {
+      count+= buf_read_run(space, run, n);
+      n= 0;
+      continue;
+    }
+    ut_ad(bpage->in_file());
+    ut_ad(!block);
+    if (buf_read_from_tier(bpage, *space))
+    {
+      count+= buf_read_run(space, run, n);
+      n= 0;
+      bpage->read_complete(*space->chain.start);
+      count++;
+      if (UNIV_UNLIKELY(!(block= buf_read_acquire())))
+        break;
+      continue;
+    }
+    ut_ad(n < array_elements(run));
+    run[n++]= bpage;
+    if (UNIV_UNLIKELY(!(block= buf_read_acquire())))
+      break;
+  }
+
+  return count + buf_read_run(space, run, n);
+}
+
 /** Applies a random read-ahead in buf_pool if there are at least a threshold
 value of accessed pages from the random read-ahead area. Does not read any
 page, not even the one at the position (space, offset), if the read-ahead
@@ -363,21 +596,7 @@ ulint buf_read_ahead_random(const page_id_t page_id)
     goto allocate_block;
   }
 
-  for (page_id_t i= low; i < high; ++i)
-  {
-    if (space->is_stopping())
-      break;
-    buf_pool_t::hash_chain &chain= buf_pool.page_hash.cell_get(i.fold());
-    space->reacquire();
-    if (buf_read_page_low(i, zip_size, chain, space, block) == DB_SUCCESS)
-    {
-      count++;
-      ut_ad(!block);
-      if ((UNIV_LIKELY(!zip_size) || (zip_size & 1)) &&
-          UNIV_UNLIKELY(!(block= buf_read_acquire())))
-        break;
-    }
-  }
+  count= buf_read_ahead_pages(space, low, high, zip_size, block);
 
   if (count)
   {
@@ -431,7 +650,8 @@ dberr_t buf_read_page(const page_id_t page_id,
     goto allocate_block;
   }
 
-  dberr_t err= buf_read_page_low(page_id, zip_size, chain, space, block, true);
+  dberr_t err= buf_read_page_low(page_id, zip_size, chain, space, block,
+                                 IORequest::READ_SYNC);
   buf_read_release(block);
   return err;
 }
@@ -467,8 +687,8 @@ void buf_read_page_background(fil_space_t *space, const page_id_t page_id,
     goto allocate_block;
   }
 
-  if (buf_read_page_low(page_id, zip_size, chain, space, block) ==
-      DB_SUCCESS)
+  if (buf_read_page_low(page_id, zip_size, chain, space, block,
+                        IORequest::READ_AHEAD) == DB_SUCCESS)
     ut_ad(!block);
   else
     buf_read_release(block);
@@ -481,6 +701,32 @@ void buf_read_page_background(fil_space_t *space, const page_id_t page_id,
   can ignore these in our heuristics. */
 }
 
+ulint buf_read_pages_background(fil_space_t *space, const page_id_t first,
+                                const page_id_t end, ulint zip_size)
+{
+  ut_ad(first < end);
+  ut_ad(end.page_no() - first.page_no() <= buf_pool_t::READ_AHEAD_PAGES);
+
+  buf_block_t *block= nullptr;
+  unsigned z{unsigned(zip_size)};
+  if (UNIV_LIKELY(!z))
+  {
+  allocate_block:
+    if (UNIV_UNLIKELY(!(block= buf_read_acquire())))
+      return 0;
+  }
+  else if (recv_recovery_is_on())
+  {
+    z|= 1;
+    goto allocate_block;
+  }
+
+  const ulint count= buf_read_ahead_pages(space, first, end, z, block);
+  buf_read_release(block);
+  /* Like buf_read_page_background(), do not invoke buf_LRU_stat_inc_io(). */
+  return count;
+}
+
 /** Applies linear read-ahead if in the buf_pool the page is a border page of
 a linear read-ahead area and all the pages in the area have been accessed.
 Does not read any page if the read-ahead mechanism is not activated. Note
@@ -654,23 +900,8 @@ ulint buf_read_ahead_linear(const page_id_t page_id)
     goto allocate_block;
   }
 
-  count= 0;
-  for (; new_low <= new_high_1; ++new_low)
-  {
-    if (space->is_stopping())
-      break;
-    buf_pool_t::hash_chain &chain= buf_pool.page_hash.cell_get(new_low.fold());
-    space->reacquire();
-    if (buf_read_page_low(new_low, zip_size, chain, space, block) ==
-        DB_SUCCESS)
-    {
-      count++;
-      ut_ad(!block);
-      if ((UNIV_LIKELY(!zip_size) || (zip_size & 1)) &&
-          UNIV_UNLIKELY(!(block= buf_read_acquire())))
-        break;
-    }
-  }
+  count= buf_read_ahead_pages(space, new_low, new_high_1 + 1, zip_size,
+                              block);
 
   if (count)
   {
@@ -718,7 +949,8 @@ void buf_read_recover(fil_space_t *space, const page_id_t page_id,
     }
   }
   else if (dberr_t err=
-           buf_read_page_low(page_id, zip_size, chain, space, block))
+           buf_read_page_low(page_id, zip_size, chain, space, block,
+                             IORequest::READ_ASYNC))
   {
     if (err != DB_SUCCESS_LOCKED_REC)
       sql_print_error("InnoDB: Recovery failed to read page "
@@ -0,0 +1,134 @@
+/*****************************************************************************
+
+Copyright (c) 2026, MariaDB plc
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; version 2 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1335 USA
+
+*****************************************************************************/
+
+/**************************************************//**
+@file buf/buf0stats.cc
+Per-index buffer pool statistics
+
+The slots form an open addressing hash table that is never shrunk:
+once assigned, a slot keeps its (tablespace, index) until shutdown, so
+that lookups do not need any latch. Only the assignment of a free slot
+is protected by a mutex.
+*******************************************************/
+
+#include "buf0stats.h"
+#include "buf0buf.h"
+#include "fil0fil.h"
+#include "page0page.h"
+
+buf_index_stats_t buf_index_stats;
+
+void buf_index_stats_t::create()
+{
+  mutex.init();
+  for (slot &s : slots)
+  {
+    s.used.store(false, std::memory_order_relaxed);
+    s.space_id= 0;
+    s.index_id= 0;
+    s.resident= 0;
+    s.reads= 0;
+    s.writes= 0;
+    s.ahi_hits= 0;
+  }
+  slots[UNTRACKED].space_id= FIL_NULL;
+  slots[UNTRACKED].used.store(true, std::memory_order_release);
+}
+
+uint32_t buf_index_stats_t::lookup(uint32_t space_id, index_id_t index_id)
+{
+  const uint32_t h= uint32_t(ut_fold_ulint_pair(space_id,
+                                                ut_fold_ull(index_id)));
+  for (uint32_t i= 0; i < MAX_PROBES; i++)
+  {
+    /* slots[UNTRACKED] is never probed */
+    const uint32_t n= 1 + (h + i) % (N_SLOTS - 1);
+    slot &s= slots[n];
+    if (!s.used.load(std::memory_order_acquire))
+    {
+      mutex.wr_lock();
+      if (!s.used.load(std::memory_order_relaxed))
+      {
+        s.space_id= space_id;
+        s.index_id= index_id;
+        s.used.store(true, std::memory_order_release);
+        mutex.wr_unlock();
+        return n;
+      }
+      mutex.wr_unlock();
+    }
+    if (s.space_id == space_id && s.index_id == index_id)
+      return n;
+  }
+  return UNTRACKED;
+}
+
+void buf_index_stats_t::move(buf_page_t &bpage, uint32_t s)
+{
+  ut_ad(s < N_SLOTS);
+  if (s == bpage.stats_slot)
+    return;
+  slots[bpage.stats_slot].resident--;
+  slots[s].resident++;
+  bpage.stats_slot= s;
+}
+
+void buf_index_stats_t::add(buf_page_t &bpage)
+{
+  bpage.stats_slot= lookup(bpage.id().space(), 0);
+  slots[bpage.stats_slot].resident++;
+}
+
+void buf_index_stats_t::readd(const buf_page_t &bpage)
+{
+  ut_ad(bpage.stats_slot < N_SLOTS);
+  slots[bpage.stats_slot].resident++;
+}
+
+void buf_index_stats_t::remove(const buf_page_t &bpage)
+{
+  ut_ad(bpage.stats_slot < N_SLOTS);
+  slots[bpage.stats_slot].resident--;
+}
+
+void buf_index_stats_t::assign(buf_page_t &bpage, index_id_t index_id)
+{
+  move(bpage, lookup(bpage.id().space(), index_id));
+}
+
+void buf_index_stats_t::read(buf_page_t &bpage, const byte *frame)
+{
+  switch (fil_page_get_type(frame)) {
+  case FIL_PAGE_INDEX:
+  case FIL_PAGE_RTREE:
+    assign(bpage, mach_read_from_8(frame + PAGE_HEADER + PAGE_INDEX_ID));
+  }
+  slots[bpage.stats_slot].reads++;
+}
+
+void buf_index_stats_t::write(const buf_page_t &bpage)
+{
+  ut_ad(bpage.stats_slot < N_SLOTS);
+  slots[bpage.stats_slot].writes++;
+}
+
+void buf_index_stats_t::ahi_hit(const buf_page_t &bpage)
+{
+  ut_ad(bpage.stats_slot < N_SLOTS);
+  slots[bpage.stats_slot].ahi_hits++;
+}
@@ -0,0 +1,255 @@
+/*****************************************************************************
+
+Copyright (c) 2024, MariaDB plc
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; version 2 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1335 USA
+
+*****************************************************************************/
+
+/**************************************************//**
+@file buf/buf0tier.cc
+Compressed tier of the buffer pool
+
+A page is copied as is by buf_LRU_free_page(), while buf_pool.mutex is
+being held, and compressed later by a background task, so that the
+eviction does not get any slower than a memcpy(). Pages that do not
+compress to 3/4 of their size are not worth keeping.
+*******************************************************/
+
+#include "buf0tier.h"
+#include "srv0srv.h"
+#include "zlib.h"
+#include "lz4.h"
+
+ulonglong srv_buf_pool_tier_size;
+
+buf_tier_t buf_tier;
+
+/** Compress the pending entries of buf_tier */
+static void buf_tier_compress(void*) { buf_tier.compress(); }
+
+static tpool::task_group buf_tier_group(1);
+static tpool::waitable_task buf_tier_task(buf_tier_compress, nullptr,
+                                          &buf_tier_group);
+
+void buf_tier_t::create()
+{
+  mutex.init();
+  UT_LIST_INIT(lru, &entry::lru);
+  UT_LIST_INIT(pending, &entry::queue);
+  seq= 0;
+  task_submitted= false;
+  size= 0;
+  n_hits= 0;
+  max_size= size_t(srv_buf_pool_tier_size);
+}
+
+void buf_tier_t::close()
+{
+  resize(0);
+  buf_tier_task.wait();
+  ut_ad(map.empty());
+  mutex.destroy();
+}
+
+void buf_tier_t::remove(entry *e)
+{
+  map.erase(e->id.raw());
+  UT_LIST_REMOVE(lru, e);
+  if (e->algo == entry::PENDING)
+    UT_LIST_REMOVE(pending, e);
+  size-= sizeof *e + e->len;
+  ut_free(e->data);
+  ut_free(e);
+}
+
+void buf_tier_t::shrink()
+{
+  while (size > max_size)
+    remove(UT_LIST_GET_FIRST(lru));
+}
+
+void buf_tier_t::resize(size_t max)
+{
+  max_size= max;
+  mutex.wr_lock();
+  shrink();
+  mutex.wr_unlock();
+}
+
+void buf_tier_t::insert(const page_id_t id, const byte *frame)
+{
+  entry *e= static_cast<entry*>(ut_malloc_nokey(sizeof *e));
+  byte *data= static_cast<byte*>(ut_malloc_nokey(srv_page_size));
+  if (UNIV_UNLIKELY(!e || !data))
+  {
+    ut_free(e);
+    ut_free(data);
+    return;
+  }
+  memcpy(data, frame, srv_page_size);
+  e->id= id;
+  e->data= data;
+  e->len= uint32_t(srv_page_size);
+  e->algo= entry::PENDING;
+
+  mutex.wr_lock();
+  e->seq= ++seq;
+  auto i= map.emplace(id.raw(), e);
+  if (!i.second)
+  {
+    remove(i.first->second);
+    map.emplace(id.raw(), e);
+  }
+  UT_LIST_ADD_LAST(lru, e);
+  UT_LIST_ADD_LAST(pending, e);
+  size+= sizeof *e + e->len;
+  shrink();
+  const bool submit= UT_LIST_GET_LEN(pending) && !task_submitted;
+  if (submit)
+    task_submitted= true;
+  mutex.wr_unlock();
+
+  if (submit)
+    srv_thread_pool->submit_task(&buf_tier_task);
+}
+
+bool buf_tier_t::take(const page_id_t id, byte *frame)
+{
+  mutex.wr_lock();
+  auto i= map.find(id.raw());
+  if (i == map.end())
+  {
+    mutex.wr_unlock();
+    return false;
+  }
+  entry *e= i->second;
+  map.erase(i);
+  UT_LIST_REMOVE(lru, e);
+  if (e->algo == entry::PENDING)
+    UT_LIST_REMOVE(pending, e);
+  size-= sizeof *e + e->len;
+  if (frame)
+    n_hits++;
+  mutex.wr_unlock();
+
+  bool ok= false;
+
+  if (frame)
+  {
+    switch (e->algo) {
+    case entry::PENDING:
+    case entry::RAW:
+      ut_ad(e->len == srv_page_size);
+      memcpy(frame, e->data, srv_page_size);
+      ok= true;
+      break;
+    case entry::LZ4:
+      ok= LZ4_decompress_safe(reinterpret_cast<const char*>(e->data),
+                              reinterpret_cast<char*>(frame), int(e->len),
+                              int(srv_page_size)) == int(srv_page_size);
+      break;
+    case entry::ZLIB:
+      {
+        uLongf len= uLongf(srv_page_size);
+        ok= uncompress(frame, &len, e->data, uLong(e->len)) == Z_OK &&
+          len == srv_page_size;
+      }
+    }
+  }
+
+  ut_free(e->data);
+  ut_free(e);
+  return ok;
+}
+
+void buf_tier_t::discard_space(uint32_t space_id)
+{
+  if (!enabled())
+    return;
+  mutex.wr_lock();
+  for (entry *e= UT_LIST_GET_FIRST(lru); e; )
+  {
+    entry *next= UT_LIST_GET_NEXT(lru, e);
+    if (e->id.space() == space_id)
+      remove(e);
+    e= next;
+  }
+  mutex.wr_unlock();
+}
+
+void buf_tier_t::compress()
+{
+  const size_t limit= srv_page_size / 4 * 3;
+  byte *raw= static_cast<byte*>(ut_malloc_nokey(srv_page_size + limit));
+
+  mutex.wr_lock();
+  while (entry *e= UT_LIST_GET_FIRST(pending))
+  {
+    UT_LIST_REMOVE(pending, e);
+    e->algo= entry::RAW;
+    const page_id_t id{e->id};
+    const uint64_t s= e->seq;
+    if (UNIV_UNLIKELY(!raw))
+    {
+      remove(e);
+      continue;
+    }
+    memcpy(raw, e->data, srv_page_size);
+    mutex.wr_unlock();
+
+    byte *out= raw + srv_page_size;
+    size_t len;
+    entry::format algo;
+    if (provider_service_lz4->is_loaded)
+    {
+      algo= entry::LZ4;
+      len= size_t(LZ4_compress_default(reinterpret_cast<const char*>(raw),
+                                       reinterpret_cast<char*>(out),
+                                       int(srv_page_size), int(limit)));
+    }
+    else
+    {
+      algo= entry::ZLIB;
+      uLongf l= uLongf(limit);
+      len= compress2(out, &l, raw, uLong(srv_page_size), 1) == Z_OK
+        ? size_t(l) : 0;
+    }
+
+    byte *data= len ? static_cast<byte*>(ut_malloc_nokey(len)) : nullptr;
+    if (data)
+      memcpy(data, out, len);
+
+    mutex.wr_lock();
+    auto i= map.find(id.raw());
+    if (i == map.end() || i->second->seq != s)
+      ut_free(data);
+    else if (!data)
+      remove(i->second);
+    else
+    {
+      e= i->second;
+      ut_ad(e->algo == entry::RAW);
+      size-= e->len;
+      ut_free(e->data);
+      e->data= data;
+      e->len= uint32_t(len);
+      e->algo= algo;
+      size+= len;
+    }
+  }
+  task_submitted= false;
+  mutex.wr_unlock();
+
+  ut_free(raw);
+}
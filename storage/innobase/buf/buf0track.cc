@@ -0,0 +1,270 @@
+/*****************************************************************************
+
+Copyright (c) 2026, MariaDB plc
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; version 2 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1335 USA
+
+*****************************************************************************/
+
+/**************************************************//**
+@file buf/buf0track.cc
+Changed page tracking for incremental backups
+
+A page is added after it has been written, before oldest_modification
+is reset, so that a checkpoint for which the page no longer needs to be
+written cannot be written before the page is part of a record. Because
+the record is durable before the checkpoint, the records up to the
+latest checkpoint cover every page that was written, and later writes
+are covered by the redo log that mariabackup copies.
+*******************************************************/
+
+#include "buf0track.h"
+#include "log0log.h"
+#include "mach0data.h"
+#include "srv0srv.h"
+#include "my_sys.h"
+#include "log.h"
+#include <algorithm>
+
+my_bool srv_track_changed_pages;
+ulonglong srv_track_changed_pages_file_size;
+
+buf_track_t buf_track;
+
+/** size of the fields before the pages */
+static constexpr size_t HEADER_SIZE= 28;
+/** size of one page identifier */
+static constexpr size_t ENTRY_SIZE= 8;
+/** size of the checksum */
+static constexpr size_t CHECKSUM_SIZE= 4;
+
+/** Read a file.
+@param name  file name in the redo log directory
+@param buf   the contents of the file
+@return whether the file exists */
+static bool buf_track_read_file(const char *name, std::vector<byte> &buf)
+{
+  const std::string path{get_log_file_path(name)};
+  File fd= my_open(path.c_str(), O_RDONLY | O_CLOEXEC, MYF(0));
+  if (fd < 0)
+    return false;
+  buf.resize(size_t(my_seek(fd, 0, MY_SEEK_END, MYF(0))));
+  if (!buf.empty() &&
+      my_pread(fd, buf.data(), buf.size(), 0, MYF(MY_WME | MY_NABP)))
+    buf.clear();
+  my_close(fd, MYF(0));
+  return true;
+}
+
+/** Parse the records of a file.
+@param buf     the contents of the file
+@param record  callback that is invoked with the start_lsn, end_lsn,
+               checkpoint_lsn, pages and number of pages of each record
+@return the size of the valid records */
+template<typename Record>
+static size_t buf_track_parse(const std::vector<byte> &buf, Record record)
+{
+  size_t pos= 0;
+  while (buf.size() - pos >= HEADER_SIZE + CHECKSUM_SIZE)
+  {
+    const byte *b= &buf[pos];
+    const size_t n= mach_read_from_4(b + 24);
+    if ((buf.size() - pos - HEADER_SIZE - CHECKSUM_SIZE) / ENTRY_SIZE < n)
+      break;
+    const size_t len= HEADER_SIZE + n * ENTRY_SIZE;
+    if (my_crc32c(0, b, len) != mach_read_from_4(b + len))
+      break;
+    record(mach_read_from_8(b), mach_read_from_8(b + 8),
+           mach_read_from_8(b + 16), b + HEADER_SIZE, n);
+    pos+= len + CHECKSUM_SIZE;
+  }
+  return pos;
+}
+
+void buf_track_t::create()
+{
+  mutex.init();
+  pending_unique= 0;
+  last= ~0ULL;
+  fd= -1;
+  size= 0;
+  start_lsn= 0;
+}
+
+void buf_track_t::unique()
+{
+  std::sort(pending.begin(), pending.end());
+  pending.erase(std::unique(pending.begin(), pending.end()), pending.end());
+  pending_unique= pending.size();
+}
+
+void buf_track_t::open()
+{
+  if (!srv_track_changed_pages)
+    return;
+  ut_ad(fd < 0);
+
+  std::vector<byte> buf;
+  buf_track_read_file(FILE_NAME, buf);
+  lsn_t end_lsn= 0, checkpoint_lsn= 0;
+  size_t end= buf_track_parse(buf, [&](lsn_t, lsn_t e, lsn_t c,
+                                       const byte *, size_t)
+                              { end_lsn= e; checkpoint_lsn= c; });
+
+  const std::string path{get_log_file_path(FILE_NAME)};
+  fd= my_open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, MYF(MY_WME));
+  if (fd < 0)
+  {
+    sql_print_error("InnoDB: Cannot open %s;"
+                    " changed page tracking is disabled", path.c_str());
+    srv_track_changed_pages= false;
+    return;
+  }
+
+  if (end && checkpoint_lsn == log_sys.last_checkpoint_lsn &&
+      srv_force_recovery < SRV_FORCE_NO_LOG_REDO)
+    start_lsn= end_lsn;
+  else
+  {
+    /* The pages that were written after the last record cannot be
+    known. Start a new chain from the current LSN. */
+    if (end)
+      sql_print_information("InnoDB: Discarding %s, which does not cover"
+                            " the checkpoint at LSN=" LSN_PF,
+                            path.c_str(),
+                            lsn_t{log_sys.last_checkpoint_lsn});
+    end= 0;
+    start_lsn= log_sys.get_lsn();
+    my_delete(get_log_file_path(OLD_FILE_NAME).c_str(), MYF(0));
+  }
+
+  if (end != buf.size())
+    my_chsize(fd, end, 0, MYF(MY_WME));
+  size= end;
+}
+
+void buf_track_t::close()
+{
+  if (fd >= 0)
+  {
+    my_close(fd, MYF(MY_WME));
+    fd= -1;
+  }
+  pending.clear();
+  pending.shrink_to_fit();
+  mutex.destroy();
+}
+
+bool buf_track_t::rotate()
+{
+  const std::string path{get_log_file_path(FILE_NAME)};
+  my_close(fd, MYF(MY_WME));
+  fd= -1;
+  if (my_rename(path.c_str(), get_log_file_path(OLD_FILE_NAME).c_str(),
+                MYF(MY_WME)))
+    return false;
+  fd= my_open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC,
+              MYF(MY_WME));
+  size= 0;
+  return fd >= 0;
+}
+
+void buf_track_t::checkpoint(lsn_t checkpoint_lsn)
+{
+  if (!srv_track_changed_pages || fd < 0)
+    return;
+
+  std::vector<uint64_t> ids;
+  mutex.wr_lock();
+  /* No page in pending can have been modified after this. */
+  const lsn_t end_lsn{log_sys.get_lsn()};
+  ids.swap(pending);
+  pending_unique= 0;
+  last= ~0ULL;
+  mutex.wr_unlock();
+
+  std::sort(ids.begin(), ids.end());
+  ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+
+  const size_t len= HEADER_SIZE + ids.size() * ENTRY_SIZE;
+  std::vector<byte> rec(len + CHECKSUM_SIZE);
+  mach_write_to_8(&rec[0], start_lsn);
+  mach_write_to_8(&rec[8], end_lsn);
+  mach_write_to_8(&rec[16], checkpoint_lsn);
+  mach_write_to_4(&rec[24], uint32_t(ids.size()));
+  byte *b= &rec[HEADER_SIZE];
+  for (uint64_t id : ids)
+  {
+    mach_write_to_8(b, id);
+    b+= ENTRY_SIZE;
+  }
+  mach_write_to_4(&rec[len], my_crc32c(0, rec.data(), len));
+
+  if ((size < srv_track_changed_pages_file_size || rotate()) &&
+      !my_pwrite(fd, rec.data(), rec.size(), size, MYF(MY_WME | MY_NABP)) &&
+      !my_sync(fd, MYF(MY_WME)))
+  {
+    size+= rec.size();
+    start_lsn= end_lsn;
+    return;
+  }
+
+  sql_print_error("InnoDB: Cannot write %s;"
+                  " changed page tracking is disabled",
+                  get_log_file_path(FILE_NAME).c_str());
+  srv_track_changed_pages= false;
+  if (fd >= 0)
+  {
+    my_close(fd, MYF(0));
+    fd= -1;
+  }
+}
+
+bool buf_track_t::read(lsn_t from_lsn, lsn_t to_lsn,
+                       std::vector<page_id_t> &pages)
+{
+  std::vector<uint64_t> ids;
+  bool chain= false;
+  lsn_t chain_start= 0, chain_end= 0, chain_checkpoint= 0;
+
+  for (const char *name : {OLD_FILE_NAME, FILE_NAME})
+  {
+    std::vector<byte> buf;
+    if (!buf_track_read_file(name, buf))
+      continue;
+    buf_track_parse(buf, [&](lsn_t s, lsn_t e, lsn_t c,
+                             const byte *b, size_t n)
+    {
+      if (!chain || s != chain_end)
+      {
+        /* A record is missing; the earlier ones are of no use. */
+        chain= true;
+        chain_start= s;
+        ids.clear();
+      }
+      chain_end= e;
+      chain_checkpoint= c;
+      if (e > from_lsn)
+        for (const byte *end= b + n * ENTRY_SIZE; b < end; b+= ENTRY_SIZE)
+          ids.push_back(mach_read_from_8(b));
+    });
+  }
+
+  if (!chain || chain_start > from_lsn || chain_checkpoint < to_lsn)
+    return false;
+
+  std::sort(ids.begin(), ids.end());
+  ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+  pages.assign(ids.begin(), ids.end());
+  return true;
+}
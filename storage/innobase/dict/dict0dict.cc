@@ -937,6 +937,7 @@ void dict_sys_t::create()
   temp_id_hash.create(hash_size);
 
   latch.SRW_LOCK_INIT(dict_operation_lock_key);
+  latch_stats.add(latch_stats_t::DICT_SYS, &latch, sizeof latch);
 
   if (!srv_read_only_mode)
   {
@@ -1138,6 +1139,7 @@ inline void dict_sys_t::add(dict_table_t* table)
 
 	table->row_id = 0;
 	table->autoinc_mutex.init();
+	table->shared_scan_mutex.init();
 	table->lock_mutex_init();
 
 	/* Look for a table with the same name: error if such exists */
@@ -1866,6 +1868,7 @@ void dict_sys_t::remove(dict_table_t* table, bool lru, bool keep)
 
 	if (keep) {
 		table->autoinc_mutex.destroy();
+		table->shared_scan_mutex.destroy();
 		return;
 	}
 
@@ -1890,6 +1893,7 @@ void dict_sys_t::remove(dict_table_t* table, bool lru, bool keep)
 #endif /* BTR_CUR_HASH_ADAPT */
 
 	table->autoinc_mutex.destroy();
+	table->shared_scan_mutex.destroy();
 	dict_mem_table_free(table);
 }
 
@@ -4474,6 +4478,7 @@ void dict_sys_t::close()
   temp_id_hash.free();
 
   unlock();
+  latch_stats.remove(&latch);
   latch.destroy();
 
   mysql_mutex_destroy(&dict_foreign_err_mutex);
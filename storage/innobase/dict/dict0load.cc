@@ -872,6 +872,104 @@ static uint32_t dict_find_max_space_id(btr_pcur_t *pcur, mtr_t *mtr)
   return max_space_id;
 }
 
+/** A tablespace file that dict_load_tablespaces() will open */
+struct dict_load_space_t
+{
+  /** SYS_TABLES.NAME */
+  std::string name;
+  /** SYS_TABLES.SPACE */
+  uint32_t id;
+  /** fil_space_t::flags */
+  uint32_t flags;
+  /** whether the SYS_TABLES record was not delete-marked */
+  bool not_dropped;
+};
+
+/** Open and validate a tablespace file for dict_load_tablespaces().
+@param s  tablespace */
+static void dict_load_tablespace(const dict_load_space_t &s)
+{
+	const span<const char> name{s.name.data(), s.name.size()};
+
+	char*	filepath = fil_make_filepath(nullptr, name, IBD, false);
+
+	/* Check that the .ibd file exists. */
+	if (fil_ibd_open(s.not_dropped, FIL_TYPE_TABLESPACE,
+			 s.id, s.flags, name, filepath)) {
+	} else if (!s.not_dropped) {
+	} else if (srv_operation == SRV_OPERATION_NORMAL
+		   && srv_start_after_restore
+		   && srv_force_recovery < SRV_FORCE_NO_BACKGROUND
+		   && dict_table_t::is_temporary_name(filepath)) {
+		/* Mariabackup will not copy files whose
+		names start with #sql-. This table ought to
+		be dropped by drop_garbage_tables_after_restore()
+		a little later. */
+	} else {
+		sql_print_warning("InnoDB: Ignoring tablespace for"
+				  " %.*s because it"
+				  " could not be opened.",
+				  static_cast<int>(name.size()), name.data());
+	}
+
+	ut_free(filepath);
+}
+
+/** Tablespace files that dict_load_tablespaces() opens */
+struct dict_load_spaces_t
+{
+  /** the tablespaces */
+  const std::vector<dict_load_space_t> &spaces;
+  /** index of the next tablespace to open */
+  std::atomic<size_t> next;
+
+  dict_load_spaces_t(const std::vector<dict_load_space_t> &spaces) :
+    spaces(spaces), next(0) {}
+
+  /** Open tablespaces until all have been opened. */
+  void open()
+  {
+    for (size_t i; (i= next.fetch_add(1, std::memory_order_relaxed)) <
+           spaces.size(); )
+      dict_load_tablespace(spaces[i]);
+  }
+
+  /** Open tablespaces in a srv_thread_pool task.
+  @param arg  dict_load_spaces_t */
+  static void task(void *arg)
+  { static_cast<dict_load_spaces_t*>(arg)->open(); }
+};
+
+/** Tablespaces that one thread opens before another is used */
+static constexpr size_t dict_load_spaces_per_thread= 64;
+
+/** Open and validate tablespace files, using up to
+innodb_read_io_threads threads, because opening a file and reading
+its first page is dominated by I/O latency.
+@param spaces  tablespaces to open */
+static void
+dict_open_tablespaces(const std::vector<dict_load_space_t> &spaces)
+{
+	dict_load_spaces_t work{spaces};
+	const size_t n_threads = std::min<size_t>(
+		srv_n_read_io_threads,
+		1 + spaces.size() / dict_load_spaces_per_thread);
+	std::vector<tpool::waitable_task*> tasks;
+
+	for (size_t i = 1; i < n_threads; i++) {
+		tasks.emplace_back(new tpool::waitable_task(
+					   dict_load_spaces_t::task, &work));
+		srv_thread_pool->submit_task(tasks.back());
+	}
+
+	work.open();
+
+	for (tpool::waitable_task* task : tasks) {
+		task->wait();
+		delete task;
+	}
+}
+
 /** Check MAX(SPACE) FROM SYS_TABLES and store it in fil_system.
 Open each data file if an encryption plugin has been loaded.
 
@@ -882,6 +980,7 @@ void dict_load_tablespaces(const std::set<uint32_t> *spaces, bool upgrade)
 	uint32_t	max_space_id = 0;
 	btr_pcur_t	pcur;
 	mtr_t		mtr;
+	std::vector<dict_load_space_t> to_open;
 
 	mtr.start();
 
@@ -949,41 +1048,22 @@ void dict_load_tablespaces(const std::set<uint32_t> *spaces, bool upgrade)
 			continue;
 		}
 
-		const span<const char> name{field, len};
-
-		char*	filepath = fil_make_filepath(nullptr, name,
-						     IBD, false);
-
-		const bool not_dropped{!rec_get_deleted_flag(rec, 0)};
-
-		/* Check that the .ibd file exists. */
-		if (fil_ibd_open(not_dropped, FIL_TYPE_TABLESPACE,
-				 space_id, dict_tf_to_fsp_flags(flags),
-				 name, filepath)) {
-		} else if (!not_dropped) {
-		} else if (srv_operation == SRV_OPERATION_NORMAL
-			   && srv_start_after_restore
-			   && srv_force_recovery < SRV_FORCE_NO_BACKGROUND
-			   && dict_table_t::is_temporary_name(filepath)) {
-			/* Mariabackup will not copy files whose
-			names start with #sql-. This table ought to
-			be dropped by drop_garbage_tables_after_restore()
-			a little later. */
-		} else {
-			sql_print_warning("InnoDB: Ignoring tablespace for"
-					  " %.*s because it"
-					  " could not be opened.",
-					  static_cast<int>(len), field);
-		}
+		/* The files will be opened after the scan, so that
+		the SYS_TABLES pages will not stay latched meanwhile. */
+		to_open.push_back({std::string(field, len), space_id,
+				   dict_tf_to_fsp_flags(flags),
+				   !rec_get_deleted_flag(rec, 0)});
 
 		max_space_id = ut_max(max_space_id, space_id);
-
-		ut_free(filepath);
 	}
 
 done:
 	mtr.commit();
 
+	if (!to_open.empty()) {
+		dict_open_tablespaces(to_open);
+	}
+
 	fil_set_max_space_id_if_bigger(max_space_id);
 
 	dict_sys.unlock();
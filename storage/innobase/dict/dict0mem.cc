@@ -230,6 +230,7 @@ dict_mem_table_free(
 	}
 
 	UT_DELETE(table->s_cols);
+	ut_free(table->shared_scan_pos);
 
 	mem_heap_free(table->heap);
 }
@@ -33,6 +33,7 @@ Created Jan 06, 2010 Vasil Dimov
 #include <mysql_com.h>
 #include "log.h"
 #include "btr0btr.h"
+#include "buf0rea.h"
 #include "que0que.h"
 #include "scope.h"
 #include "debug_sync.h"
@@ -1062,7 +1063,7 @@ btr_record_not_null_field_in_rec(
 	}
 }
 
-inline dberr_t
+dberr_t
 btr_cur_t::open_random_leaf(rec_offs *&offsets, mem_heap_t *&heap, mtr_t &mtr)
 {
   ut_ad(!index()->is_spatial());
@@ -1585,94 +1586,6 @@ dict_stats_update_transient(
 	return err;
 }
 
-/** Open a cursor at the first page in a tree level.
-@param page_cur  cursor
-@param level     level to search for (0=leaf)
-@param mtr       mini-transaction */
-static dberr_t page_cur_open_level(page_cur_t *page_cur, ulint level,
-                                   mtr_t *mtr)
-{
-  mem_heap_t *heap= nullptr;
-  rec_offs offsets_[REC_OFFS_NORMAL_SIZE];
-  rec_offs *offsets= offsets_;
-  dberr_t err;
-
-  dict_index_t *const index= page_cur->index;
-
-  rec_offs_init(offsets_);
-  ut_ad(level != ULINT_UNDEFINED);
-  ut_ad(mtr->memo_contains_flagged(&index->lock, MTR_MEMO_SX_LOCK));
-  ut_ad(mtr->get_savepoint() == 1);
-
-  uint32_t page= index->page;
-
-  for (ulint height = ULINT_UNDEFINED;; height--)
-  {
-    buf_block_t* block= btr_block_get(*index, page, RW_S_LATCH, mtr, &err);
-    if (!block)
-      break;
-
-    const uint32_t l= btr_page_get_level(block->page.frame);
-
-    if (height == ULINT_UNDEFINED)
-    {
-      ut_ad(!heap);
-      /* We are in the root node */
-      height= l;
-      if (UNIV_UNLIKELY(height < level))
-        return DB_CORRUPTION;
-    }
-    else if (UNIV_UNLIKELY(height != l) || page_has_prev(block->page.frame))
-    {
-      err= DB_CORRUPTION;
-      break;
-    }
-
-    page_cur_set_before_first(block, page_cur);
-
-    if (height == level)
-      break;
-
-    ut_ad(height);
-
-    if (!page_cur_move_to_next(page_cur))
-    {
-      err= DB_CORRUPTION;
-      break;
-    }
-
-    offsets= rec_get_offsets(page_cur->rec, index, offsets, 0, ULINT_UNDEFINED,
-                             &heap);
-    page= btr_node_ptr_get_child_page_no(page_cur->rec, offsets);
-  }
-
-  if (UNIV_LIKELY_NULL(heap))
-    mem_heap_free(heap);
-
-  /* Release all page latches except the one on the desired page. */
-  const auto end= mtr->get_savepoint();
-  if (end > 1)
-    mtr->rollback_to_savepoint(1, end - 1);
-
-  return err;
-}
-
-/** Open a cursor at the first page in a tree level.
-@param page_cur  cursor
-@param level     level to search for (0=leaf)
-@param mtr       mini-transaction
-@param index     index tree */
-static dberr_t btr_pcur_open_level(btr_pcur_t *pcur, ulint level, mtr_t *mtr,
-                                   dict_index_t *index)
-{
-  pcur->latch_mode= BTR_SEARCH_LEAF;
-  pcur->search_mode= PAGE_CUR_G;
-  pcur->pos_state= BTR_PCUR_IS_POSITIONED;
-  pcur->btr_cur.page_cur.index= index;
-  return page_cur_open_level(&pcur->btr_cur.page_cur, level, mtr);
-}
-
-
 /* @{ Pseudo code about the relation between the following functions
 
 let N = N_SAMPLE_PAGES(index)
@@ -2337,6 +2250,53 @@ struct n_diff_data_t {
 	ib_uint64_t	n_external_pages_sum;
 };
 
+/** Submit asynchronous reads of the pages below the records of a B-tree
+level that dict_stats_analyze_index_for_n_prefix() is going to dive below,
+so that the dives will not have to wait for each page read in turn.
+@param index       B-tree
+@param level       level of the records (at least 1)
+@param dive_below  ascending positions of the records on the level
+@param mtr         mini-transaction holding the index latch */
+static void dict_stats_read_ahead(dict_index_t *index, ulint level,
+                                  const boundaries_t &dive_below, mtr_t *mtr)
+{
+  const ulint savepoint= mtr->get_savepoint();
+  btr_pcur_t pcur;
+
+  if (btr_pcur_open_level(&pcur, level, mtr, index) == DB_SUCCESS &&
+      btr_pcur_move_to_next_on_page(&pcur))
+  {
+    fil_space_t *space= index->table->space;
+    const ulint zip_size= space->zip_size();
+    mem_heap_t *heap= nullptr;
+    rec_offs *offsets= nullptr;
+    ib_uint64_t rec_idx= 0;
+
+    for (const ib_uint64_t idx : dive_below)
+    {
+      while (rec_idx < idx && btr_pcur_is_on_user_rec(&pcur))
+      {
+        btr_pcur_move_to_next_user_rec(&pcur, mtr);
+        rec_idx++;
+      }
+      if (rec_idx < idx || !btr_pcur_is_on_user_rec(&pcur))
+        break;
+      const rec_t *rec= btr_pcur_get_rec(&pcur);
+      offsets= rec_get_offsets(rec, index, offsets, 0, ULINT_UNDEFINED,
+                               &heap);
+      const page_id_t id{space->id,
+                         btr_node_ptr_get_child_page_no(rec, offsets)};
+      if (space->acquire())
+        buf_read_page_background(space, id, zip_size);
+    }
+
+    if (heap)
+      mem_heap_free(heap);
+  }
+
+  mtr->rollback_to_savepoint(savepoint);
+}
+
 /** Estimate the number of different key values in an index when looking at
 the first n_prefix columns. For a given level in an index select
 n_diff_data->n_leaf_pages_to_analyze records from that level and dive below
@@ -2353,6 +2313,9 @@ last record from each group of distinct keys
 n_external_pages_sum in this structure will be set by this function. The
 members level, n_diff_on_level and n_leaf_pages_to_analyze must be set by the
 caller in advance - they are used by some calculations inside this function
+@param[in]	deadline		microsecond_interval_timer() after
+which to stop diving, or 0 for no limit; n_leaf_pages_to_analyze will be
+reduced to the number of leaf pages that were analyzed
 @param[in,out]	mtr			mini-transaction */
 static
 void
@@ -2361,6 +2324,7 @@ dict_stats_analyze_index_for_n_prefix(
 	ulint			n_prefix,
 	const boundaries_t*	boundaries,
 	n_diff_data_t*		n_diff_data,
+	ulonglong		deadline,
 	mtr_t*			mtr)
 {
 	btr_pcur_t	pcur;
@@ -2377,39 +2341,23 @@ dict_stats_analyze_index_for_n_prefix(
 
 	ut_ad(n_diff_data->level);
 
-	/* Position pcur on the leftmost record on the leftmost page
-	on the desired level. */
-
 	n_diff_data->n_diff_all_analyzed_pages = 0;
 	n_diff_data->n_external_pages_sum = 0;
 
-	if (btr_pcur_open_level(&pcur, n_diff_data->level, mtr, index)
-	    != DB_SUCCESS
-	    || !btr_pcur_move_to_next_on_page(&pcur)) {
-		return;
-	}
-
-	page = btr_pcur_get_page(&pcur);
-
-	const rec_t*	first_rec = btr_pcur_get_rec(&pcur);
-
-	/* The page must not be empty, except when
-	it is the root page (and the whole index is empty). */
-	if (page_has_prev(page)
-	    || !btr_pcur_is_on_user_rec(&pcur)
-	    || btr_page_get_level(page) != n_diff_data->level
-	    || first_rec != page_rec_get_next_const(page_get_infimum_rec(page))
-	    || !(rec_get_info_bits(first_rec, page_is_comp(page))
-		 & REC_INFO_MIN_REC_FLAG)) {
+	if (!n_diff_data->n_diff_on_level) {
 		return;
 	}
 
+	/* Pick the records to dive below, so that the pages below
+	them can be read ahead. */
 	const ib_uint64_t	last_idx_on_level = boundaries->at(
 		static_cast<unsigned>(n_diff_data->n_diff_on_level - 1));
 
-	rec_idx = 0;
+	const ib_uint64_t	n_diff = n_diff_data->n_diff_on_level;
+	const ib_uint64_t	n_pick = n_diff_data->n_leaf_pages_to_analyze;
+	boundaries_t		dive_below(static_cast<size_t>(n_pick));
 
-	for (i = 0; i < n_diff_data->n_leaf_pages_to_analyze; i++) {
+	for (i = 0; i < n_pick; i++) {
 		/* there are n_diff_on_level elements
 		in 'boundaries' and we divide those elements
 		into n_leaf_pages_to_analyze segments, for example:
@@ -2438,10 +2386,6 @@ dict_stats_analyze_index_for_n_prefix(
 
 		then we select a random record from each segment and dive
 		below it */
-		const ib_uint64_t	n_diff = n_diff_data->n_diff_on_level;
-		const ib_uint64_t	n_pick
-			= n_diff_data->n_leaf_pages_to_analyze;
-
 		const ib_uint64_t	left = n_diff * i / n_pick;
 		const ib_uint64_t	right = n_diff * (i + 1) / n_pick - 1;
 
@@ -2451,8 +2395,51 @@ dict_stats_analyze_index_for_n_prefix(
 		const ulint	rnd = ut_rnd_interval(
 			static_cast<ulint>(right - left));
 
-		const ib_uint64_t	dive_below_idx
+		dive_below[static_cast<size_t>(i)]
 			= boundaries->at(static_cast<unsigned>(left + rnd));
+	}
+
+	if (n_pick > 1) {
+		dict_stats_read_ahead(index, n_diff_data->level,
+				      dive_below, mtr);
+	}
+
+	/* Position pcur on the leftmost record on the leftmost page
+	on the desired level. */
+
+	if (btr_pcur_open_level(&pcur, n_diff_data->level, mtr, index)
+	    != DB_SUCCESS
+	    || !btr_pcur_move_to_next_on_page(&pcur)) {
+		return;
+	}
+
+	page = btr_pcur_get_page(&pcur);
+
+	const rec_t*	first_rec = btr_pcur_get_rec(&pcur);
+
+	/* The page must not be empty, except when
+	it is the root page (and the whole index is empty). */
+	if (page_has_prev(page)
+	    || !btr_pcur_is_on_user_rec(&pcur)
+	    || btr_page_get_level(page) != n_diff_data->level
+	    || first_rec != page_rec_get_next_const(page_get_infimum_rec(page))
+	    || !(rec_get_info_bits(first_rec, page_is_comp(page))
+		 & REC_INFO_MIN_REC_FLAG)) {
+		return;
+	}
+
+	rec_idx = 0;
+
+	for (i = 0; i < n_pick; i++) {
+		if (deadline && i && microsecond_interval_timer() > deadline) {
+			/* Out of time; extrapolate from the pages that
+			were analyzed so far. */
+			n_diff_data->n_leaf_pages_to_analyze = i;
+			break;
+		}
+
+		const ib_uint64_t	dive_below_idx
+			= dive_below[static_cast<size_t>(i)];
 
 #if 0
 		DEBUG_PRINTF("    %s(): dive below record with index="
@@ -2626,8 +2613,11 @@ dict_stats_index_set_n_diff(
 members stat_n_diff_key_vals[], stat_n_sample_sizes[], stat_index_size and
 stat_n_leaf_pages. This function can be slow.
 @param[in]	index	index to analyze
+@param[in]	deadline	microsecond_interval_timer() after which
+to stop sampling leaf pages, or 0 for no limit
 @return index stats */
-static index_stats_t dict_stats_analyze_index(dict_index_t* index)
+static index_stats_t dict_stats_analyze_index(dict_index_t* index,
+					      ulonglong deadline = 0)
 {
 	bool		level_is_analyzed;
 	ulint		n_uniq;
@@ -2913,7 +2903,7 @@ static index_stats_t dict_stats_analyze_index(dict_index_t* index)
 
 		dict_stats_analyze_index_for_n_prefix(
 			index, n_prefix, &n_diff_boundaries[n_prefix - 1],
-			data, &mtr);
+			data, deadline, &mtr);
 	}
 
 	mtr.commit();
@@ -2943,7 +2933,10 @@ static
 dberr_t
 dict_stats_update_persistent(
 /*=========================*/
-	dict_table_t*	table)		/*!< in/out: table */
+	dict_table_t*	table,		/*!< in/out: table */
+	ulonglong	deadline)	/*!< in: microsecond_interval_timer()
+					after which to stop sampling leaf
+					pages, or 0 for no limit */
 {
 	dict_index_t*	index;
 
@@ -2969,7 +2962,7 @@ dict_stats_update_persistent(
 	dict_stats_empty_index(index);
 	table->stats_mutex_unlock();
 
-	index_stats_t stats = dict_stats_analyze_index(index);
+	index_stats_t stats = dict_stats_analyze_index(index, deadline);
 
 	if (stats.is_bulk_operation()) {
 		dict_stats_empty_table(table);
@@ -3010,7 +3003,7 @@ dict_stats_update_persistent(
 		}
 
 		table->stats_mutex_unlock();
-		stats = dict_stats_analyze_index(index);
+		stats = dict_stats_analyze_index(index, deadline);
 		table->stats_mutex_lock();
 
 		if (stats.is_bulk_operation()) {
@@ -3980,11 +3973,15 @@ dberr_t
 dict_stats_update(
 /*==============*/
 	dict_table_t*		table,	/*!< in/out: table */
-	dict_stats_upd_option_t	stats_upd_option)
+	dict_stats_upd_option_t	stats_upd_option,
 					/*!< in: whether to (re) calc
 					the stats or to fetch them from
 					the persistent statistics
 					storage */
+	ulonglong		deadline)
+					/*!< in: microsecond_interval_timer()
+					after which to stop sampling leaf
+					pages, or 0 for no limit */
 {
 	ut_ad(!table->stats_mutex_is_owner());
 
@@ -4030,7 +4027,7 @@ dict_stats_update(
 
 			dberr_t	err;
 
-			err = dict_stats_update_persistent(table);
+			err = dict_stats_update_persistent(table, deadline);
 
 			if (err != DB_SUCCESS) {
 				return(err);
@@ -70,6 +70,9 @@ static bool			stats_initialised;
 
 static THD *dict_stats_thd;
 
+/** Sessions of the additional innodb_stats_auto_recalc_threads */
+static THD *dict_stats_worker_thd[DICT_STATS_MAX_THREADS - 1];
+
 /*****************************************************************//**
 Free the resources occupied by the recalc pool, called once during
 thread de-initialization. */
@@ -91,6 +94,13 @@ static void dict_stats_recalc_pool_deinit()
 
 	if (dict_stats_thd)
 		destroy_background_thd(dict_stats_thd);
+
+	for (THD*& thd : dict_stats_worker_thd) {
+		if (thd) {
+			destroy_background_thd(thd);
+			thd = nullptr;
+		}
+	}
 }
 
 /*****************************************************************//**
@@ -338,8 +348,11 @@ static bool dict_stats_process_entry_from_recalc_pool(THD *thd)
   const bool update_now=
     difftime(time(nullptr), table->stats_last_recalc) >= MIN_RECALC_INTERVAL;
 
+  const ulonglong deadline= srv_stats_auto_recalc_time_budget
+    ? microsecond_interval_timer() + 1000ULL * srv_stats_auto_recalc_time_budget
+    : 0;
   const dberr_t err= update_now
-    ? dict_stats_update(table, DICT_STATS_RECALC_PERSISTENT)
+    ? dict_stats_update(table, DICT_STATS_RECALC_PERSISTENT, deadline)
     : DB_SUCCESS_LOCKED_REC;
 
   dict_table_close(table, false, thd, mdl);
@@ -377,17 +390,43 @@ static bool is_recalc_pool_empty()
   return empty;
 }
 
+/** Process entries of the recalc pool until none can be processed now.
+@param arg  the session to use; created on the first use */
+static void dict_stats_worker(void *arg)
+{
+  THD *&thd= *static_cast<THD**>(arg);
+  if (!thd)
+    thd= innobase_create_background_thd("InnoDB statistics");
+  set_current_thd(thd);
+
+  while (dict_stats_process_entry_from_recalc_pool(thd)) {}
+
+  innobase_reset_background_thd(thd);
+  set_current_thd(nullptr);
+}
+
 static tpool::timer* dict_stats_timer;
 static void dict_stats_func(void*)
 {
-  if (!dict_stats_thd)
-    dict_stats_thd= innobase_create_background_thd("InnoDB statistics");
-  set_current_thd(dict_stats_thd);
+  /* Let additional tasks process other tables of the recalc pool
+  concurrently with this one. */
+  tpool::waitable_task *workers[DICT_STATS_MAX_THREADS - 1];
+  const uint n_workers= srv_stats_auto_recalc_threads - 1;
+  for (uint i= 0; i < n_workers; i++)
+  {
+    workers[i]= new tpool::waitable_task(dict_stats_worker,
+                                         &dict_stats_worker_thd[i]);
+    srv_thread_pool->submit_task(workers[i]);
+  }
 
-  while (dict_stats_process_entry_from_recalc_pool(dict_stats_thd)) {}
+  dict_stats_worker(&dict_stats_thd);
+
+  for (uint i= 0; i < n_workers; i++)
+  {
+    workers[i]->wait();
+    delete workers[i];
+  }
 
-  innobase_reset_background_thd(dict_stats_thd);
-  set_current_thd(nullptr);
   if (!is_recalc_pool_empty())
     dict_stats_schedule(MIN_RECALC_INTERVAL * 1000);
 }
@@ -32,6 +32,7 @@ Modified           Jan Lindström jan.lindstrom@mariadb.com
 #else
 #include "buf0flu.h"
 #include "buf0dblwr.h"
+#include "buf0rea.h"
 #include "srv0srv.h"
 #include "srv0start.h"
 #include "mtr0mtr.h"
@@ -1641,6 +1642,18 @@ fil_crypt_find_page_to_rotate(
 	return found;
 }
 
+/** Sleep to stay within the allocated iops.
+@param sleeptime_ms  time to sleep, in milliseconds */
+static void fil_crypt_throttle_sleep(ulint sleeptime_ms)
+{
+	mysql_mutex_lock(&fil_crypt_threads_mutex);
+	timespec abstime;
+	set_timespec_nsec(abstime, 1000000ULL * sleeptime_ms);
+	my_cond_timedwait(&fil_crypt_throttle_sleep_cond,
+			  &fil_crypt_threads_mutex.m_mutex, &abstime);
+	mysql_mutex_unlock(&fil_crypt_threads_mutex);
+}
+
 /***********************************************************************
 Get a page and compute sleep time
 @param[in,out]		state		Rotation state
@@ -1839,13 +1852,61 @@ fil_crypt_rotate_page(
 	}
 
 	if (sleeptime_ms) {
-		mysql_mutex_lock(&fil_crypt_threads_mutex);
-		timespec abstime;
-		set_timespec_nsec(abstime, 1000000ULL * sleeptime_ms);
-		my_cond_timedwait(&fil_crypt_throttle_sleep_cond,
-				  &fil_crypt_threads_mutex.m_mutex, &abstime);
-		mysql_mutex_unlock(&fil_crypt_threads_mutex);
+		fil_crypt_throttle_sleep(sleeptime_ms);
+	}
+}
+
+/** Read the allocated pages that follow state->offset in a rotation
+batch asynchronously, so that fil_crypt_rotate_page() finds them in the
+buffer pool instead of reading them one at a time. The reads are counted
+against the allocated iops. No pages are read while many reads are
+pending, so that rotation backs off when the foreground IO is busy.
+@param[in,out]	state	rotation state
+@param[in]	end	end of the batch
+@return end of the pages that were considered */
+static uint32_t fil_crypt_read_ahead(rotate_thread_t *state, uint32_t end)
+{
+	fil_space_t* space = &*state->space;
+	const uint32_t first = state->offset;
+	const uint32_t last = std::min<uint32_t>(
+		end, first + buf_pool_t::READ_AHEAD_PAGES);
+
+	/* Do not read ahead the doublewrite buffer, see
+	fil_crypt_rotate_pages(). */
+	if (space->id == TRX_SYS_SPACE || space->is_stopping()
+	    || os_aio_pending_reads_approx() > buf_pool.curr_size / 2) {
+		return last;
 	}
+
+	const ulint zip_size = space->zip_size();
+	const ulint physical_size = space->physical_size();
+	ulint n = 0;
+
+	/* Submit each run of allocated pages. */
+	for (uint32_t i = first; i < last; ) {
+		uint32_t j = i;
+		while (j < last
+		       && (!(j % physical_size)
+			   || fseg_page_is_allocated(space, j)
+			   == DB_SUCCESS_LOCKED_REC)) {
+			j++;
+		}
+
+		if (j > i) {
+			n += buf_read_pages_background(
+				space, page_id_t(space->id, i),
+				page_id_t(space->id, j), zip_size);
+		}
+
+		i = j + 1;
+	}
+
+	if (n) {
+		state->crypt_stat.pages_read_from_disk += n;
+		fil_crypt_throttle_sleep(n * 1000 / state->allocated_iops);
+	}
+
+	return last;
 }
 
 /***********************************************************************
@@ -1861,11 +1922,16 @@ fil_crypt_rotate_pages(
 	const uint32_t space_id = state->space->id;
 	uint32_t end = std::min(state->offset + uint32_t(state->batch),
 				state->space->free_limit);
+	uint32_t read_ahead_end = state->offset;
 
 	ut_ad(state->space->referenced());
 
 	for (; state->offset < end; state->offset++) {
 
+		if (state->offset >= read_ahead_end) {
+			read_ahead_end = fil_crypt_read_ahead(state, end);
+		}
+
 		/* we can't rotate pages in dblwr buffer as
 		* it's not possible to read those due to lots of asserts
 		* in buffer pool.
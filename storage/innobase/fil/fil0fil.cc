@@ -46,6 +46,8 @@ Created 10/25/1995 Heikki Tuuri
 #include "trx0purge.h"
 #include "buf0lru.h"
 #include "buf0flu.h"
+#include "buf0rea.h"
+#include "buf0tier.h"
 #include "log.h"
 #ifdef __linux__
 # include <sys/types.h>
@@ -1814,6 +1816,7 @@ void fil_close_tablespace(uint32_t id)
 	}
 	log_sys.latch.wr_unlock();
 	fil_space_free_low(space);
+	buf_tier.discard_space(id);
 }
 
 /** Delete a tablespace and associated .ibd file.
@@ -1825,7 +1828,10 @@ pfs_os_file_t fil_delete_tablespace(uint32_t id)
   ut_ad(!is_system_tablespace(id));
   pfs_os_file_t handle= OS_FILE_CLOSED;
   if (fil_space_t *space= fil_space_t::drop(id, &handle))
+  {
     fil_space_free_low(space);
+    buf_tier.discard_space(id);
+  }
   return handle;
 }
 
@@ -2908,7 +2914,7 @@ fil_io_t fil_space_t::io(const IORequest &type, os_offset_t offset, size_t len,
 	ulint p = static_cast<ulint>(offset >> srv_page_size_shift);
 	dberr_t err;
 
-	if (type.type == IORequest::READ_ASYNC && is_stopping()) {
+	if (type.is_read() && type.is_async() && is_stopping()) {
 		err = DB_TABLESPACE_DELETED;
 		node = nullptr;
 		goto release;
@@ -2932,7 +2938,7 @@ fil_io_t fil_space_t::io(const IORequest &type, os_offset_t offset, size_t len,
 			node = UT_LIST_GET_NEXT(chain, node);
 			if (!node) {
 fail:
-				if (type.type != IORequest::READ_ASYNC) {
+				if (!type.is_read() || !type.is_async()) {
 					fil_invalid_page_access_msg(
 						node->name,
 						offset, len,
@@ -3024,6 +3030,12 @@ void IORequest::read_complete(int io_error) const
   ut_ad(is_read());
   ut_ad(bpage);
 
+  if (type == READ_BATCH)
+  {
+    buf_read_batch_complete(*this, io_error);
+    return;
+  }
+
   const page_id_t id(bpage->id());
 
   if (UNIV_UNLIKELY(io_error != 0))
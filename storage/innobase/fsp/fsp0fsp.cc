@@ -3362,9 +3362,12 @@ dberr_t fsp_shrink_list(buf_block_t *header, uint16_t hdr_offset,
 
   for (uint32_t i= len; i > 0; i--)
   {
-    ut_d(fil_space_t *space= header->page.id().space() == 0
+    ut_d(const uint32_t space_id= header->page.id().space());
+    ut_d(fil_space_t *space= space_id == 0
                              ? fil_system.sys_space
-                             : fil_system.temp_space);
+                             : space_id == SRV_TMP_SPACE_ID
+                             ? fil_system.temp_space
+                             : fil_space_get(space_id));
     ut_ad(addr.page < space->size);
     ut_ad(!(addr.page & (srv_page_size - 1)));
     if (!descr_block || descr_block->page.id().page_no() != addr.page)
@@ -4147,9 +4150,113 @@ void fsp_system_tablespace_truncate(bool shutdown)
   fil_system.set_use_doublewrite(old_dblwr_buf);
 }
 
-inline void fil_space_t::clear_freed_ranges(uint32_t threshold)
+bool fsp_shrink_undo_space(fil_space_t *space)
 {
-  ut_ad(id == SRV_TMP_SPACE_ID);
+  ut_ad(srv_is_undo_tablespace(space->id));
+  ut_ad(UT_LIST_GET_LEN(space->chain) == 1);
+  /* Keep the size above SRV_UNDO_TABLESPACE_SIZE_IN_PAGES, so that
+  recovery can tell the TRIM_PAGES record apart from the one that is
+  written when the whole tablespace is being reinitialized. */
+  const uint32_t min_size=
+    ut_calc_align(SRV_UNDO_TABLESPACE_SIZE_IN_PAGES + 1, FSP_EXTENT_SIZE);
+  /* Limit the size of the mini-transaction, which will have to latch
+  every page of the discarded range that resides in the buffer pool. */
+  const uint32_t max_shrink= 256 * FSP_EXTENT_SIZE;
+
+  if (space->size_in_header <= min_size)
+    return false;
+
+  log_free_check();
+
+  mtr_t mtr;
+  mtr.start();
+  mtr.x_lock_space(space);
+  mtr.set_named_space(space);
+
+  const uint32_t header_size= space->size_in_header;
+  uint32_t threshold= 0;
+  dberr_t err= fsp_traverse_extents(space, &threshold, &mtr);
+  if (err != DB_SUCCESS || threshold >= header_size)
+  {
+func_exit:
+    mtr.commit();
+    return false;
+  }
+
+  threshold= std::max(threshold, min_size);
+  if (header_size > max_shrink)
+    threshold= std::max(threshold, ut_calc_align(header_size - max_shrink,
+                                                 FSP_EXTENT_SIZE));
+  if (threshold >= header_size)
+    goto func_exit;
+
+  {
+    fsp_xdes_old_page old_xdes_list(space->id);
+    err= fsp_traverse_extents(space, &threshold, &mtr, &old_xdes_list);
+    if (err != DB_SUCCESS)
+      goto func_exit;
+
+    buf_block_t *header= fsp_get_latched_xdes_page(
+      page_id_t(space->id, 0), &mtr, &err);
+    if (!header)
+      goto func_exit;
+
+    mtr.write<4, mtr_t::FORCED>(
+      *header, FSP_HEADER_OFFSET + FSP_SIZE + header->page.frame, threshold);
+    if (space->free_limit > threshold)
+      mtr.write<4,mtr_t::MAYBE_NOP>(*header, FSP_HEADER_OFFSET
+                                    + FSP_FREE_LIMIT + header->page.frame,
+                                    threshold);
+    err= fsp_shrink_list(header, FSP_HEADER_OFFSET + FSP_FREE,
+                         threshold, &mtr);
+    if (err == DB_SUCCESS)
+      err= fsp_shrink_list(header, FSP_HEADER_OFFSET + FSP_FREE_FRAG,
+                           threshold, &mtr);
+    if (err == DB_SUCCESS)
+      err= fsp_xdes_reset(space->id, threshold, &mtr);
+    if (err != DB_SUCCESS)
+    {
+discard:
+      old_xdes_list.restore(&mtr);
+      mtr.discard_modifications();
+      goto func_exit;
+    }
+
+    /* Latch the discarded pages that reside in the buffer pool, so that
+    mtr_t::commit_shrink() will mark them as freed and will prevent any
+    write beyond the end of the file. Freed pages are ignored here; they
+    will never be written. */
+    for (uint32_t page_no= threshold; page_no < header_size; page_no++)
+    {
+      const page_id_t id{space->id, page_no};
+      if (!(page_no & (srv_page_size - 1)) &&
+          mtr.get_already_latched(id, MTR_MEMO_PAGE_SX_FIX))
+        continue;
+      buf_page_get_gen(id, 0, RW_X_LATCH, nullptr, BUF_PEEK_IF_IN_POOL, &mtr);
+    }
+
+    mtr.trim_pages(page_id_t(space->id, threshold));
+    if (mtr.get_log_size() >
+        (2 << 20) - 8 /* encryption nonce */ - 5 /* EOF, checksum */)
+      goto discard;
+
+    if (space->free_limit > threshold)
+      space->free_limit= threshold;
+    space->free_len= flst_get_len(FSP_HEADER_OFFSET + FSP_FREE +
+                                  header->page.frame);
+  }
+
+  sql_print_information("InnoDB: Shrinking %s from " UINT32PF " to "
+                        UINT32PF " pages",
+                        UT_LIST_GET_FIRST(space->chain)->name,
+                        header_size, threshold);
+  mtr.commit_shrink(*space, threshold, false);
+  return true;
+}
+
+void fil_space_t::clear_freed_ranges(uint32_t threshold)
+{
+  ut_ad(id == SRV_TMP_SPACE_ID || srv_is_undo_tablespace(id));
   std::lock_guard<std::mutex> freed_lock(freed_range_mutex);
   range_set current_ranges;
   for (const auto &range : freed_ranges)
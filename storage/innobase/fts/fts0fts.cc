@@ -185,14 +185,12 @@ struct fts_tokenize_param_t {
 /** Run SYNC on the table, i.e., write out data from the cache to the
 FTS auxiliary INDEX table and clear the cache at the end.
 @param[in,out]	sync		sync state
-@param[in]	unlock_cache	whether unlock cache lock when write node
 @param[in]	wait		whether wait when a sync is in progress
 @return DB_SUCCESS if all OK */
 static
 dberr_t
 fts_sync(
 	fts_sync_t*	sync,
-	bool		unlock_cache,
 	bool		wait);
 
 /****************************************************************//**
@@ -3360,7 +3358,7 @@ fts_add_doc_from_tuple(
 
                        if (cache->total_size > fts_max_cache_size / 5
                            || fts_need_sync) {
-                               fts_sync(cache->sync, true, false);
+                               fts_sync(cache->sync, false);
                        }
 
                        mtr_start(&mtr);
@@ -3561,7 +3559,7 @@ fts_add_doc_by_id(
 
 				DBUG_EXECUTE_IF(
 					"fts_instrument_sync_debug",
-					fts_sync(cache->sync, true, true);
+					fts_sync(cache->sync, true);
 				);
 
 				DEBUG_SYNC_C("fts_instrument_sync_request");
@@ -4279,14 +4277,12 @@ fts_sync_rollback(
 /** Run SYNC on the table, i.e., write out data from the cache to the
 FTS auxiliary INDEX table and clear the cache at the end.
 @param[in,out]	sync		sync state
-@param[in]	unlock_cache	whether unlock cache lock when write node
 @param[in]	wait		whether wait when a sync is in progress
 @return DB_SUCCESS if all OK */
 static
 dberr_t
 fts_sync(
 	fts_sync_t*	sync,
-	bool		unlock_cache,
 	bool		wait)
 {
 	if (srv_read_only_mode) {
@@ -4317,26 +4313,26 @@ fts_sync(
 		} while (sync->in_progress);
 	}
 
-	sync->unlock_cache = unlock_cache;
+	sync->unlock_cache = true;
 	sync->in_progress = true;
 
 	DEBUG_SYNC_C("fts_sync_begin");
 	fts_sync_begin(sync);
 
-begin_sync:
-	const size_t fts_cache_size= fts_max_cache_size;
-	if (cache->total_size > fts_cache_size) {
-		/* Avoid the case: sync never finish when
-		insert/update keeps comming. */
-		ut_ad(sync->unlock_cache);
-		sync->unlock_cache = false;
+	if (cache->total_size > fts_max_cache_size) {
 		ib::warn() << "Total InnoDB FTS size "
 			<< cache->total_size << " for the table "
 			<< cache->sync->table->name
 			<< " exceeds the innodb_ft_cache_size "
-			<< fts_cache_size;
+			<< fts_max_cache_size;
 	}
 
+	/* The first pass writes the nodes with the cache lock released
+	for each node, so that inserts into the cache can continue. The
+	nodes that were added meanwhile are written by one more pass that
+	holds the lock, so that the sync finishes even if inserts keep
+	coming, and only that difference blocks them. */
+begin_sync:
 	for (i = 0; i < ib_vector_size(cache->indexes); ++i) {
 		fts_index_cache_t*	index_cache;
 
@@ -4355,13 +4351,6 @@ fts_sync(
 		if (error != DB_SUCCESS) {
 			goto end_sync;
 		}
-
-		if (!sync->unlock_cache
-		    && cache->total_size < fts_max_cache_size) {
-			/* Reset the unlock cache if the value
-			is less than innodb_ft_cache_size */
-			sync->unlock_cache = true;
-		}
 	}
 
 	DBUG_EXECUTE_IF("fts_instrument_sync_interrupted",
@@ -4382,6 +4371,7 @@ fts_sync(
 			continue;
 		}
 
+		sync->unlock_cache = false;
 		goto begin_sync;
 	}
 
@@ -4423,7 +4413,7 @@ dberr_t fts_sync_table(dict_table_t* table, bool wait)
   ut_ad(table->fts);
 
   return table->space && !table->corrupted && table->fts->cache
-    ? fts_sync(table->fts->cache->sync, !wait, wait)
+    ? fts_sync(table->fts->cache->sync, wait)
     : DB_SUCCESS;
 }
 
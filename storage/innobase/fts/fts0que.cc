@@ -4171,7 +4171,9 @@ FTS Query sort result, returned by fts_query() on fts_ranking_t::rank. */
 void
 fts_query_sort_result_on_rank(
 /*==========================*/
-	fts_result_t*	result)		/*!< out: result instance to sort.*/
+	fts_result_t*	result,		/*!< out: result instance to sort.*/
+	ulint		limit)		/*!< in: number of documents of
+					the highest rank to keep */
 {
 	const ib_rbt_node_t*	node;
 	ib_rbt_t*		ranked;
@@ -4195,6 +4197,20 @@ fts_query_sort_result_on_rank(
 
 		ut_a(ranking->words == NULL);
 
+		if (rbt_size(ranked) >= limit) {
+			/* Keep only the limit documents of the highest
+			rank, without allocating the others. */
+			const ib_rbt_node_t*	lowest = rbt_last(ranked);
+
+			if (!lowest
+			    || fts_query_compare_rank(ranking, lowest->value)
+			    >= 0) {
+				continue;
+			}
+
+			ut_free(rbt_remove_node(ranked, lowest));
+		}
+
 		rbt_insert(ranked, ranking, ranking);
 	}
 
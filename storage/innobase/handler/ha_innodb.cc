@@ -72,6 +72,8 @@ extern my_bool opt_readonly;
 #include "buf0buf.h"
 #include "buf0flu.h"
 #include "buf0lru.h"
+#include "buf0tier.h"
+#include "buf0track.h"
 #include "dict0boot.h"
 #include "dict0load.h"
 #include "dict0crea.h"
@@ -95,6 +97,8 @@ extern my_bool opt_readonly;
 #include "row0mysql.h"
 #include "row0quiesce.h"
 #include "row0sel.h"
+#include "btr0pcur.h"
+#include "buf0rea.h"
 #include "row0upd.h"
 #include "fil0crypt.h"
 #include "srv0mon.h"
@@ -516,6 +520,7 @@ mysql_pfs_key_t	buf_pool_mutex_key;
 mysql_pfs_key_t	dict_foreign_err_mutex_key;
 mysql_pfs_key_t	fil_system_mutex_key;
 mysql_pfs_key_t	flush_list_mutex_key;
+mysql_pfs_key_t	page_cleaner_mutex_key;
 mysql_pfs_key_t	fts_cache_mutex_key;
 mysql_pfs_key_t	fts_cache_init_mutex_key;
 mysql_pfs_key_t	fts_delete_mutex_key;
@@ -547,6 +552,7 @@ static PSI_mutex_info all_innodb_mutexes[] = {
 	PSI_KEY(recalc_pool_mutex),
 	PSI_KEY(fil_system_mutex),
 	PSI_KEY(flush_list_mutex),
+	PSI_KEY(page_cleaner_mutex),
 	PSI_KEY(fts_cache_mutex),
 	PSI_KEY(fts_cache_init_mutex),
 	PSI_KEY(fts_delete_mutex),
@@ -867,6 +873,12 @@ static MYSQL_THDVAR_BOOL(snapshot_isolation, PLUGIN_VAR_OPCMDARG,
   "Use snapshot isolation (write-write conflict detection)",
   NULL, NULL, TRUE);
 
+static MYSQL_THDVAR_BOOL(insert_select_consistent_read, PLUGIN_VAR_OPCMDARG,
+  "Use consistent read instead of shared locks for the tables read by"
+  " INSERT...SELECT, REPLACE...SELECT and CREATE...SELECT at REPEATABLE READ"
+  " when the binary log does not require a locking read",
+  NULL, NULL, FALSE);
+
 static MYSQL_THDVAR_BOOL(strict_mode, PLUGIN_VAR_OPCMDARG,
   "Use strict mode when evaluating create options",
   NULL, NULL, TRUE);
@@ -965,10 +977,18 @@ static SHOW_VAR innodb_status_variables[]= {
   {"buffer_pool_read_requests",
    &export_vars.innodb_buffer_pool_read_requests, SHOW_SIZE_T},
   {"buffer_pool_reads", &buf_pool.stat.n_pages_read, SHOW_SIZE_T},
+  {"buffer_pool_tier_bytes",
+   &export_vars.innodb_buffer_pool_tier_bytes, SHOW_SIZE_T},
+  {"buffer_pool_tier_hits", &buf_tier.n_hits, SHOW_SIZE_T},
+  {"buffer_pool_tier_pages",
+   &export_vars.innodb_buffer_pool_tier_pages, SHOW_SIZE_T},
   {"buffer_pool_wait_free", &buf_pool.stat.LRU_waits, SHOW_SIZE_T},
   {"buffer_pool_write_requests", &buf_pool.flush_list_requests, SHOW_SIZE_T},
   {"checkpoint_age", &export_vars.innodb_checkpoint_age, SHOW_SIZE_T},
   {"checkpoint_max_age", &export_vars.innodb_checkpoint_max_age, SHOW_SIZE_T},
+  {"checkpoint_rate", &export_vars.innodb_checkpoint_rate, SHOW_ULONGLONG},
+  {"checkpoint_time_to_sync_flush",
+   &export_vars.innodb_checkpoint_time_to_sync_flush, SHOW_SLONGLONG},
   {"data_fsyncs", (size_t*) &os_n_fsyncs, SHOW_SIZE_T},
   {"data_pending_fsyncs",
    (size_t*) &fil_n_pending_tablespace_flushes, SHOW_SIZE_T},
@@ -982,6 +1002,9 @@ static SHOW_VAR innodb_status_variables[]= {
   {"dblwr_writes", &export_vars.innodb_dblwr_writes, SHOW_SIZE_T},
   {"deadlocks", &lock_sys.deadlocks, SHOW_SIZE_T},
   {"history_list_length", &export_vars.innodb_history_list_length,SHOW_SIZE_T},
+  {"log_generation_rate", &export_vars.innodb_log_generation_rate,
+   SHOW_ULONGLONG},
+  {"log_throttle_waits", &log_sys.throttle_waits, SHOW_SIZE_T},
   {"log_waits", &log_sys.waits, SHOW_SIZE_T},
   {"log_write_requests", &log_sys.write_to_buf, SHOW_SIZE_T},
   {"log_writes", &log_sys.write_to_log, SHOW_SIZE_T},
@@ -1001,6 +1024,8 @@ static SHOW_VAR innodb_status_variables[]= {
   {"pages_created", &buf_pool.stat.n_pages_created, SHOW_SIZE_T},
   {"pages_read", &buf_pool.stat.n_pages_read, SHOW_SIZE_T},
   {"pages_written", &buf_pool.stat.n_pages_written, SHOW_SIZE_T},
+  {"purge_active_tasks", &purge_sys.n_active_tasks, SHOW_SIZE_T},
+  {"purge_split_tables", &purge_sys.n_split_tables, SHOW_SIZE_T},
   {"row_lock_current_waits", &export_vars.innodb_row_lock_current_waits,
    SHOW_SIZE_T},
   {"row_lock_time", &export_vars.innodb_row_lock_time, SHOW_LONGLONG},
@@ -3008,9 +3033,15 @@ ha_innobase::ha_innobase(
                           | HA_CAN_ONLINE_BACKUPS
 			  | HA_CONCURRENT_OPTIMIZE
 			  | HA_CAN_SKIP_LOCKED
+			  | HA_CAN_WRITE_ROWS
 			  |  (srv_force_primary_key ? HA_REQUIRE_PRIMARY_KEY : 0)
 		  ),
 	m_start_of_scan(),
+	m_shared_scan(),
+	m_shared_scan_mid(),
+	m_shared_scan_wrapped(),
+	m_shared_scan_rows(),
+	m_shared_scan_start(),
         m_mysql_has_locked()
 {}
 
@@ -3703,12 +3734,12 @@ static ulonglong innodb_prepare_commit_versioned(THD* thd, ulonglong *trx_id)
         DBUG_ASSERT(t.first->versioned_by_id());
         DBUG_ASSERT(trx->rsegs.m_redo.rseg);
         versioned= true;
-        if (!trx->bulk_insert)
+        if (!trx->bulk_insert && !trx->bulk_insert_non_empty)
           break;
       }
-      if (t.second.is_bulk_insert())
+      if (t.second.is_bulk_insert() || t.second.is_bulk_insert_non_empty())
       {
-        ut_ad(trx->bulk_insert);
+        ut_ad(trx->bulk_insert || trx->bulk_insert_non_empty);
         if (t.second.write_bulk(t.first, trx))
           return ULONGLONG_MAX;
       }
@@ -6207,7 +6238,10 @@ ha_innobase::close()
 {
 	DBUG_ENTER("ha_innobase::close");
 
+	shared_scan_end();
 	row_prebuilt_free(m_prebuilt);
+	my_free(m_shared_scan_start);
+	m_shared_scan_start = NULL;
 
 	if (m_upd_buf != NULL) {
 		ut_ad(m_upd_buf_size != 0);
@@ -7673,6 +7707,49 @@ bool ha_innobase::is_read_only(bool altering_to_supported) const
   return true;
 }
 
+/** Prepare for inserting multiple rows. If innodb_bulk_insert_non_empty
+is set and the table can be locked exclusively without waiting, buffer
+the entries of non-unique secondary indexes until the end of the
+statement, and insert them in sorted order. */
+void ha_innobase::start_bulk_insert(ha_rows, uint)
+{
+  dict_table_t *table= m_prebuilt->table;
+  trx_t *trx= m_prebuilt->trx;
+
+  /* Triggers could read the table, or the index entries that would
+  still be sitting in the sort buffers. */
+  if (!innodb_bulk_insert_non_empty || is_read_only() ||
+      handler::table->triggers ||
+      table->is_temporary() || table->is_native_online_ddl() ||
+      trx->duplicates || trx->bulk_insert ||
+      !table->foreign_set.empty() || !table->referenced_set.empty())
+    return;
+#ifdef WITH_WSREP
+  if (trx->is_wsrep())
+    return;
+#endif /* WITH_WSREP */
+
+  const dict_index_t *index= dict_table_get_next_index(
+    dict_table_get_first_index(table));
+  while (index && !row_merge_bulk_t::non_empty_buffered(*index))
+    index= dict_table_get_next_index(index);
+  if (!index)
+    return;
+
+  /* The exclusive lock guarantees that inserting the buffered
+  entries will not conflict with any locks of other transactions. */
+  trx_start_if_not_started(trx, true);
+  if (lock_table_for_trx(table, trx, LOCK_X, true) != DB_SUCCESS)
+    return;
+
+  auto m= trx->mod_tables.emplace(table, trx->undo_no);
+  if (!m.first->second.bulk_buffer_exist())
+  {
+    m.first->second.start_bulk_insert_non_empty(table, trx->undo_no);
+    trx->bulk_insert_non_empty= true;
+  }
+}
+
 /********************************************************************//**
 Stores a row in an InnoDB database, to the table specified in this
 handle.
@@ -7897,6 +7974,23 @@ ha_innobase::write_row(
 	DBUG_RETURN(error_result);
 }
 
+/** Insert rows that the server prepared outside record[0].
+Each row is inserted by row_insert_for_mysql() in its own mini-transaction,
+as it may need to wait for a lock, but directly from the buffer.
+@param rows     consecutive records of table->s->rec_buff_length bytes
+@param n        number of rows
+@param written  number of rows that were inserted
+@return error code of the row after the inserted ones */
+int ha_innobase::write_rows(const uchar *rows, ha_rows n, ha_rows *written)
+{
+  ut_ad(!table->next_number_field);
+  const size_t length= table->s->rec_buff_length;
+  for (*written= 0; *written < n; ++*written)
+    if (int error= write_row(rows + *written * length))
+      return error;
+  return 0;
+}
+
 /** Fill the update vector's "old_vrow" field for those non-updated,
 but indexed columns. Such columns could stil present in the virtual
 index rec fields even if they are not updated (some other fields updated),
@@ -9211,6 +9305,22 @@ ha_innobase::general_fetch(
 	case DB_SUCCESS:
 		error = 0;
 		table->status = 0;
+		if (!m_prebuilt->n_fetch_cached
+		    && m_prebuilt->n_rows_fetched
+		    >= 4 * m_prebuilt->fetch_cache_size
+		    && m_prebuilt->fetch_cache_size < MYSQL_FETCH_CACHE_MAX) {
+			/* This is a long scan, for example an aggregation
+			over an index range. Let it copy more rows at a
+			time while holding the page latch. */
+			const ulint n = std::min<ulint>(
+				2 * m_prebuilt->fetch_cache_size,
+				MYSQL_FETCH_CACHE_GROW_BYTES
+				/ (m_prebuilt->mysql_row_len + 8));
+			if (n > m_prebuilt->fetch_cache_size) {
+				row_prebuilt_set_fetch_cache_size(
+					m_prebuilt, n);
+			}
+		}
 		break;
 	case DB_RECORD_NOT_FOUND:
 		error = HA_ERR_END_OF_FILE;
@@ -9376,6 +9486,12 @@ ha_innobase::rnd_init(
 
 	m_start_of_scan = true;
 
+	shared_scan_end();
+
+	if (scan && !err) {
+		shared_scan_begin();
+	}
+
 	return(err);
 }
 
@@ -9388,6 +9504,7 @@ ha_innobase::rnd_end(void)
 /*======================*/
 {
 	m_disable_rowid_filter = false;
+	shared_scan_end();
 	return(index_end());
 }
 
@@ -9406,7 +9523,13 @@ ha_innobase::rnd_next(
 	DBUG_ENTER("rnd_next");
 
 	if (m_start_of_scan) {
-		error = index_first(buf);
+		if (m_shared_scan_mid) {
+			error = index_read(buf, m_shared_scan_start,
+					   uint(ref_length),
+					   HA_READ_KEY_OR_NEXT);
+		} else {
+			error = index_first(buf);
+		}
 
 		if (error == HA_ERR_KEY_NOT_FOUND) {
 			error = HA_ERR_END_OF_FILE;
@@ -9417,9 +9540,422 @@ ha_innobase::rnd_next(
 		error = general_fetch(buf, ROW_SEL_NEXT, 0);
 	}
 
+	if (m_shared_scan) {
+		error = shared_scan_next(buf, error);
+	}
+
 	DBUG_RETURN(error);
 }
 
+/** Number of rows after which a shared scan publishes its position */
+static constexpr ulint SHARED_SCAN_PUBLISH_ROWS = 256;
+
+/** Start taking part in shared scans, if this full table scan is
+eligible. The scan starts at the position that a concurrent shared scan
+of the table has most recently published, so that the scans read the
+same pages at about the same time instead of each reading the whole
+table into the buffer pool separately. After reaching the end of the
+clustered index, the scan wraps around to the first record and ends at
+the record where it started. Only non-locking reads of SELECT are
+eligible, because the rows are not returned in the order of the
+clustered index. READ UNCOMMITTED is not eligible either, because
+without a read view the rows that are inserted or deleted while the
+scan wraps around could be returned twice or not at all. */
+void ha_innobase::shared_scan_begin()
+{
+	ut_ad(!m_shared_scan);
+	dict_table_t*	t = m_prebuilt->table;
+
+	if (!srv_shared_scan_min_size
+	    || m_prebuilt->select_lock_type != LOCK_NONE
+	    || m_prebuilt->trx->isolation_level < TRX_ISO_READ_COMMITTED
+	    || thd_sql_command(ha_thd()) != SQLCOM_SELECT
+	    || t->is_temporary()
+	    || ulonglong{t->stat_clustered_index_size} << srv_page_size_shift
+	    < srv_shared_scan_min_size) {
+		return;
+	}
+
+	if (!m_shared_scan_start) {
+		m_shared_scan_start = static_cast<uchar*>(
+			my_malloc(PSI_INSTRUMENT_ME, ref_length, MYF(0)));
+		if (!m_shared_scan_start) {
+			return;
+		}
+	}
+
+	t->shared_scan_mutex.wr_lock();
+	m_shared_scan_mid = t->n_shared_scans && t->shared_scan_pos;
+	if (m_shared_scan_mid) {
+		memcpy(m_shared_scan_start, t->shared_scan_pos, ref_length);
+	}
+	t->n_shared_scans++;
+	t->shared_scan_mutex.wr_unlock();
+
+	m_shared_scan = true;
+	m_shared_scan_wrapped = false;
+	m_shared_scan_rows = 0;
+}
+
+/** Stop taking part in shared scans. */
+void ha_innobase::shared_scan_end()
+{
+	if (!m_shared_scan) {
+		return;
+	}
+
+	dict_table_t*	t = m_prebuilt->table;
+	t->shared_scan_mutex.wr_lock();
+	ut_ad(t->n_shared_scans);
+	t->n_shared_scans--;
+	t->shared_scan_mutex.wr_unlock();
+
+	m_shared_scan = false;
+	m_shared_scan_mid = false;
+}
+
+/** Continue a shared scan after rnd_next() fetched a row.
+@param buf    the row that was fetched
+@param error  the result of fetching the row
+@return 0, HA_ERR_END_OF_FILE, or error number */
+int ha_innobase::shared_scan_next(uchar* buf, int error)
+{
+	ut_ad(m_shared_scan);
+
+	if (error == HA_ERR_END_OF_FILE && m_shared_scan_mid
+	    && !m_shared_scan_wrapped) {
+		m_shared_scan_wrapped = true;
+		error = index_first(buf);
+
+		if (error == HA_ERR_KEY_NOT_FOUND) {
+			error = HA_ERR_END_OF_FILE;
+		}
+	}
+
+	if (error) {
+		return error;
+	}
+
+	if (m_shared_scan_wrapped) {
+		position(buf);
+		return cmp_ref(ref, m_shared_scan_start) >= 0
+			? HA_ERR_END_OF_FILE : 0;
+	}
+
+	if (++m_shared_scan_rows % SHARED_SCAN_PUBLISH_ROWS) {
+		return 0;
+	}
+
+	position(buf);
+
+	dict_table_t*	t = m_prebuilt->table;
+	t->shared_scan_mutex.wr_lock();
+	if (!t->shared_scan_pos) {
+		t->shared_scan_pos = static_cast<byte*>(
+			ut_malloc_nokey(ref_length));
+	}
+	if (t->shared_scan_pos) {
+		memcpy(t->shared_scan_pos, ref, ref_length);
+	}
+	t->shared_scan_mutex.wr_unlock();
+
+	return 0;
+}
+
+/** Submit asynchronous reads of the first innodb_partition_read_ahead
+leaf pages that a scan of an index is going to read. ha_partition
+announces a scan to every partition before it reads from the first one,
+so that the reads for the later partitions overlap with the scan of the
+earlier ones.
+@param index  B-tree
+@param tuple  search key at the start of the scan, or nullptr */
+static void innobase_read_ahead_scan(dict_index_t *index,
+				     const dtuple_t *tuple)
+{
+	fil_space_t*	space = index->table->space;
+
+	if (!space || !index->is_btree() || index->is_corrupted()
+	    || index->page == FIL_NULL) {
+		return;
+	}
+
+	mtr_t		mtr;
+	btr_pcur_t	pcur;
+	dberr_t		err;
+
+	mtr.start();
+	mtr_sx_lock_index(index, &mtr);
+
+	const buf_block_t* root = btr_root_block_get(
+		index, RW_S_LATCH, &mtr, &err);
+
+	if (!root || !btr_page_get_level(root->page.frame)) {
+		/* The root page is the only leaf page. */
+		mtr.commit();
+		return;
+	}
+
+	if (tuple) {
+		pcur.latch_mode = BTR_SEARCH_LEAF;
+		pcur.search_mode = PAGE_CUR_LE;
+		pcur.pos_state = BTR_PCUR_IS_POSITIONED;
+		pcur.btr_cur.page_cur.index = index;
+		err = btr_cur_search_to_nth_level(1, tuple, RW_S_LATCH,
+						  &pcur.btr_cur, &mtr);
+	} else {
+		mtr.rollback_to_savepoint(1);
+		err = btr_pcur_open_level(&pcur, 1, &mtr, index);
+	}
+
+	if (err == DB_SUCCESS) {
+		const ulint	zip_size = space->zip_size();
+		mem_heap_t*	heap = nullptr;
+		rec_offs*	offsets = nullptr;
+		uint		n = srv_partition_read_ahead;
+
+		do {
+			if (!btr_pcur_is_on_user_rec(&pcur)) {
+				continue;
+			}
+			const rec_t* rec = btr_pcur_get_rec(&pcur);
+			offsets = rec_get_offsets(rec, index, offsets, 0,
+						  ULINT_UNDEFINED, &heap);
+			const page_id_t id{
+				space->id,
+				btr_node_ptr_get_child_page_no(rec, offsets)};
+			if (space->acquire()) {
+				buf_read_page_background(space, id, zip_size);
+			}
+			n--;
+		} while (n && btr_pcur_move_to_next_user_rec(&pcur, &mtr));
+
+		if (heap) {
+			mem_heap_free(heap);
+		}
+	}
+
+	mtr.commit();
+}
+
+/** Announce a table scan of a partition.
+@param use_parallel  whether ha_partition is going to read other
+partitions before this one
+@return 0 */
+int ha_innobase::pre_rnd_next(bool use_parallel)
+{
+	if (use_parallel && srv_partition_read_ahead && m_start_of_scan) {
+		innobase_read_ahead_scan(m_prebuilt->index, nullptr);
+	}
+	return 0;
+}
+
+/** Announce an index scan of a partition from the smallest key.
+@param use_parallel  whether ha_partition is going to read other
+partitions before this one
+@return 0 */
+int ha_innobase::pre_index_first(bool use_parallel)
+{
+	if (use_parallel && srv_partition_read_ahead
+	    && m_prebuilt->index_usable) {
+		innobase_read_ahead_scan(m_prebuilt->index, nullptr);
+	}
+	return 0;
+}
+
+/** Announce a range scan of a partition. Lookups of a single key
+read too few pages to be worth a read-ahead.
+@param start_key     start of the range, or nullptr
+@param use_parallel  whether ha_partition is going to read other
+partitions before this one
+@return 0 */
+int ha_innobase::pre_read_range_first(const key_range *start_key,
+				      const key_range *, bool eq_range,
+				      bool, bool use_parallel)
+{
+	dict_index_t*	index = m_prebuilt->index;
+
+	if (!use_parallel || !srv_partition_read_ahead || eq_range
+	    || !m_prebuilt->index_usable || dict_index_is_spatial(index)) {
+		return 0;
+	}
+
+	if (!start_key) {
+		innobase_read_ahead_scan(index, nullptr);
+		return 0;
+	}
+
+	const KEY*	key = table->key_info + active_index;
+	mem_heap_t*	heap = mem_heap_create(
+		key->ext_key_parts * sizeof(dfield_t) + sizeof(dtuple_t));
+	dtuple_t*	tuple = dtuple_create(heap, key->ext_key_parts);
+
+	dict_index_copy_types(tuple, index, key->ext_key_parts);
+	row_sel_convert_mysql_key_to_innobase(
+		tuple, m_prebuilt->srch_key_val2, m_prebuilt->srch_key_val_len,
+		index, start_key->key, start_key->length);
+	innobase_read_ahead_scan(index, tuple->n_fields ? tuple : nullptr);
+	mem_heap_free(heap);
+	return 0;
+}
+
+/** Start reading a random sample of the leaf pages of the clustered
+index, as many as fraction of the leaf pages.
+@param fraction  the fraction of the table to read; adjusted to
+the fraction of the leaf pages that will be read
+@return 0, HA_ERR_WRONG_COMMAND if the table cannot be sampled,
+or error number */
+int ha_innobase::sample_init(double *fraction)
+{
+	dict_table_t*	ib_table = m_prebuilt->table;
+	dict_index_t*	index = dict_table_get_first_index(ib_table);
+
+	if (!index || !index->is_btree() || !ib_table->stat_initialized) {
+		return HA_ERR_WRONG_COMMAND;
+	}
+
+	ib_table->stats_shared_lock();
+	const ulint n_leaf_pages = index->stat_n_leaf_pages;
+	ib_table->stats_shared_unlock();
+
+	const ulint n_pages = std::max<ulint>(
+		1, ulint(ceil(double(n_leaf_pages) * *fraction)));
+
+	/* A page that was already read is skipped and another one is
+	picked. For more than half of the leaf pages, that would take
+	many retries, and reading the whole index is not much slower.
+	A single leaf page is read completely. */
+	if (2 * n_pages > n_leaf_pages && n_leaf_pages > 1) {
+		return HA_ERR_WRONG_COMMAND;
+	}
+
+	if (int err = ha_rnd_init(true)) {
+		return err;
+	}
+
+	m_sample_pages = n_pages;
+	m_sample_tries = 4 * n_pages + 16;
+	m_sample_seen.clear();
+	m_sample_recs = 0;
+	*fraction = n_leaf_pages > 1
+		? double(n_pages) / double(n_leaf_pages) : 1;
+	return 0;
+}
+
+/** Read the next row of the sample. The pages are sampled without
+replacement. For every sampled page the cursor is positioned on its
+first user record, and as many rows as the page holds are read from
+there with the normal consistent read, so that the rows are converted
+and checked for visibility as in a table scan.
+@param buf  buffer for the row
+@return 0, HA_ERR_END_OF_FILE, or error number */
+int ha_innobase::sample_next(uchar *buf)
+{
+	DBUG_ENTER("sample_next");
+
+	if (m_sample_recs) {
+		m_sample_recs--;
+		int error = general_fetch(buf, ROW_SEL_NEXT, 0);
+		if (error != HA_ERR_END_OF_FILE) {
+			DBUG_RETURN(error);
+		}
+		m_sample_recs = 0;
+	}
+
+	dict_index_t*	index = m_prebuilt->index;
+	ut_ad(index->is_primary());
+	const ulint	n_uniq = dict_index_get_n_unique(index);
+	mem_heap_t*	heap = nullptr;
+	rec_offs*	offsets = nullptr;
+
+	while (m_sample_pages && m_sample_tries) {
+		m_sample_tries--;
+
+		btr_cur_t	cursor;
+		mtr_t		mtr;
+		cursor.page_cur.index = index;
+		mtr.start();
+
+		if (cursor.open_random_leaf(offsets, heap, mtr)
+		    != DB_SUCCESS) {
+			mtr.commit();
+			break;
+		}
+
+		if (!m_sample_seen.insert(btr_cur_get_block(&cursor)
+					  ->page.id().page_no()).second) {
+			mtr.commit();
+			continue;
+		}
+		m_sample_pages--;
+
+		const rec_t*	rec = page_rec_get_next_const(
+			cursor.page_cur.rec);
+		if (rec && rec_is_metadata(rec, *index)) {
+			rec = page_rec_get_next_const(rec);
+		}
+		if (!rec || page_rec_is_supremum(rec)) {
+			mtr.commit();
+			continue;
+		}
+
+		if (!heap) {
+			heap = mem_heap_create(256);
+		}
+
+		dtuple_t*	tuple = m_prebuilt->search_tuple;
+		dtuple_set_n_fields(tuple, n_uniq);
+		dict_index_copy_types(tuple, index, n_uniq);
+		rec_copy_prefix_to_dtuple(tuple, rec, index,
+					  index->n_core_fields, n_uniq, heap);
+		tuple->info_bits = 0;
+		m_sample_recs = page_get_n_recs(btr_cur_get_page(&cursor));
+		mtr.commit();
+
+		if (m_prebuilt->sql_stat_start) {
+			build_template(false);
+		}
+
+		dberr_t	ret = row_search_mvcc(buf, PAGE_CUR_GE, m_prebuilt,
+					      0, 0);
+		dtuple_set_n_fields(tuple, 0);
+		mem_heap_empty(heap);
+		offsets = nullptr;
+
+		switch (ret) {
+		case DB_SUCCESS:
+			table->status = 0;
+			m_sample_recs--;
+			mem_heap_free(heap);
+			DBUG_RETURN(0);
+		case DB_RECORD_NOT_FOUND:
+		case DB_END_OF_INDEX:
+			m_sample_recs = 0;
+			continue;
+		default:
+			table->status = STATUS_NOT_FOUND;
+			mem_heap_free(heap);
+			DBUG_RETURN(convert_error_code_to_mysql(
+					    ret, m_prebuilt->table->flags,
+					    m_user_thd));
+		}
+	}
+
+	if (heap) {
+		mem_heap_free(heap);
+	}
+
+	table->status = STATUS_NOT_FOUND;
+	DBUG_RETURN(HA_ERR_END_OF_FILE);
+}
+
+/** End reading a sample started by sample_init().
+@return 0 or error number */
+int ha_innobase::sample_end()
+{
+	m_sample_seen.clear();
+	return ha_rnd_end();
+}
+
 /**********************************************************************//**
 Fetches a row from the table based on a row reference.
 @return 0, HA_ERR_KEY_NOT_FOUND, or error code */
@@ -9592,6 +10128,7 @@ ha_innobase::ft_init_ext(
 	fts_hdl->could_you = const_cast<_ft_vft_ext*>(&ft_vft_ext_result);
 	fts_hdl->ft_prebuilt = m_prebuilt;
 	fts_hdl->ft_result = result;
+	fts_hdl->ft_limit = HA_POS_ERROR;
 
 	/* FIXME: Re-evaluate the condition when Bug 14469540 is resolved */
 	m_prebuilt->in_fts_query = true;
@@ -9599,6 +10136,26 @@ ha_innobase::ft_init_ext(
 	return(reinterpret_cast<FT_INFO*>(fts_hdl));
 }
 
+/** Initialize FT index scan of which only the documents of the highest
+rank are read
+@param flags  search mode
+@param keynr  index number
+@param key    search string
+@param limit  number of documents that are read
+@return FT_INFO structure if successful or NULL */
+FT_INFO*
+ha_innobase::ft_init_ext_with_limit(uint flags, uint keynr, String* key,
+				    ha_rows limit)
+{
+	FT_INFO* fts_hdl = ft_init_ext(flags, keynr, key);
+
+	if (fts_hdl) {
+		reinterpret_cast<NEW_FT_INFO*>(fts_hdl)->ft_limit = limit;
+	}
+
+	return(fts_hdl);
+}
+
 /*****************************************************************//**
 Set up search tuple for a query through FTS_DOC_ID_INDEX on
 supplied Doc ID. This is used by MySQL to retrieve the documents
@@ -9680,6 +10237,8 @@ ha_innobase::ft_read(
 	fts_result_t*	result;
 
 	result = reinterpret_cast<NEW_FT_INFO*>(ft_handler)->ft_result;
+	const ha_rows	limit = reinterpret_cast<NEW_FT_INFO*>(
+		ft_handler)->ft_limit;
 
 	if (result->current == NULL) {
 		/* This is the case where the FTS query did not
@@ -9689,7 +10248,10 @@ ha_innobase::ft_read(
 			need to sort the document ids on their rank
 			calculation. */
 
-			fts_query_sort_result_on_rank(result);
+			fts_query_sort_result_on_rank(
+				result,
+				limit < ULINT_UNDEFINED
+				? ulint(limit) : ULINT_UNDEFINED);
 
 			result->current = const_cast<ib_rbt_node_t*>(
 				rbt_first(result->rankings_by_rank));
@@ -9758,6 +10320,21 @@ ha_innobase::ft_read(
 			table->status = 0;
 			break;
 		case DB_RECORD_NOT_FOUND:
+			if (rbt_size(result->rankings_by_rank)
+			    < rbt_size(result->rankings_by_id)) {
+				/* A document of the highest rank is not
+				visible. Sort all documents and continue
+				after it, so that enough rows are returned. */
+				fts_ranking_t	last = *ranking;
+				ib_rbt_bound_t	parent;
+
+				fts_query_sort_result_on_rank(result);
+				ut_a(!rbt_search(result->rankings_by_rank,
+						 &parent, &last));
+				result->current = const_cast<ib_rbt_node_t*>(
+					parent.last);
+			}
+
 			result->current = const_cast<ib_rbt_node_t*>(
 				rbt_next(result->rankings_by_rank,
 					 result->current));
@@ -14192,74 +14769,41 @@ ha_innobase::rename_table(
 	DBUG_RETURN(convert_error_code_to_mysql(error, 0, NULL));
 }
 
-/*********************************************************************//**
-Estimates the number of index records in a range.
-@return estimated number of rows */
-
-ha_rows
-ha_innobase::records_in_range(
-/*==========================*/
-	uint			keynr,		/*!< in: index number */
-	const key_range		*min_key,	/*!< in: start key value of the
-						range, may also be 0 */
-	const key_range		*max_key,	/*!< in: range end key val, may
-						also be 0 */
-        page_range              *pages)
-{
-	KEY*		key;
-	dict_index_t*	index;
-	dtuple_t*	range_start;
-	dtuple_t*	range_end;
-	ha_rows		n_rows = HA_POS_ERROR;
+/** Estimate the number of index records in a range.
+@param prebuilt     prebuilt struct of the table
+@param index        index
+@param key          MariaDB definition of the index
+@param range_start  search tuple for min_key, with its fields allocated
+@param range_end    search tuple for max_key, with its fields allocated
+@param min_key      start key value of the range, or nullptr
+@param max_key      end key value of the range, or nullptr
+@param pages        hint and result: the first and last page of the range
+@return estimated number of rows
+@retval HA_POS_ERROR if the search mode is not supported */
+static ha_rows innobase_records_in_range(row_prebuilt_t *prebuilt,
+                                         dict_index_t *index, const KEY *key,
+                                         dtuple_t *range_start,
+                                         dtuple_t *range_end,
+                                         const key_range *min_key,
+                                         const key_range *max_key,
+                                         page_range *pages)
+{
+	ha_rows		n_rows;
 	page_cur_mode_t	mode1;
 	page_cur_mode_t	mode2;
-	mem_heap_t*	heap;
-
-	DBUG_ENTER("records_in_range");
-
-	ut_ad(m_prebuilt->trx == thd_to_trx(ha_thd()));
-
-	m_prebuilt->trx->op_info = "estimating records in index range";
-
-	active_index = keynr;
-
-	key = table->key_info + active_index;
-
-	index = innobase_get_index(keynr);
-
-	/* There exists possibility of not being able to find requested
-	index due to inconsistency between MySQL and InoDB dictionary info.
-	Necessary message should have been printed in innobase_get_index() */
-	if (!index || !m_prebuilt->table->space) {
-		goto func_exit;
-	}
-	if (index->is_corrupted()) {
-		n_rows = HA_ERR_INDEX_CORRUPT;
-		goto func_exit;
-	}
-	if (!row_merge_is_index_usable(m_prebuilt->trx, index)) {
-		n_rows = HA_ERR_TABLE_DEF_CHANGED;
-		goto func_exit;
-	}
-
-	heap = mem_heap_create(2 * (key->ext_key_parts * sizeof(dfield_t)
-				    + sizeof(dtuple_t)));
-
-	range_start = dtuple_create(heap, key->ext_key_parts);
-
-	range_end = dtuple_create(heap, key->ext_key_parts);
 
 	if (!min_key) {
 		mode1 = PAGE_CUR_GE;
 		dtuple_set_n_fields(range_start, 0);
 	} else if (convert_search_mode_to_innobase(min_key->flag, mode1)) {
-		goto unsupported;
+		return HA_POS_ERROR;
 	} else {
+		dtuple_set_n_fields(range_start, key->ext_key_parts);
 		dict_index_copy_types(range_start, index, key->ext_key_parts);
 		row_sel_convert_mysql_key_to_innobase(
 			range_start,
-			m_prebuilt->srch_key_val1,
-			m_prebuilt->srch_key_val_len,
+			prebuilt->srch_key_val1,
+			prebuilt->srch_key_val_len,
 			index, min_key->key, min_key->length);
 		DBUG_ASSERT(range_start->n_fields > 0);
 	}
@@ -14268,13 +14812,14 @@ ha_innobase::records_in_range(
 		mode2 = PAGE_CUR_GE;
 		dtuple_set_n_fields(range_end, 0);
 	} else if (convert_search_mode_to_innobase(max_key->flag, mode2)) {
-		goto unsupported;
+		return HA_POS_ERROR;
 	} else {
+		dtuple_set_n_fields(range_end, key->ext_key_parts);
 		dict_index_copy_types(range_end, index, key->ext_key_parts);
 		row_sel_convert_mysql_key_to_innobase(
 			range_end,
-			m_prebuilt->srch_key_val2,
-			m_prebuilt->srch_key_val_len,
+			prebuilt->srch_key_val2,
+			prebuilt->srch_key_val_len,
 			index, max_key->key, max_key->length);
 		DBUG_ASSERT(range_end->n_fields > 0);
 	}
@@ -14294,7 +14839,7 @@ ha_innobase::records_in_range(
 	DBUG_EXECUTE_IF(
 		"print_btr_estimate_n_rows_in_range_return_value",
 		push_warning_printf(
-			ha_thd(), Sql_condition::WARN_LEVEL_WARN,
+			prebuilt->trx->mysql_thd, Sql_condition::WARN_LEVEL_WARN,
 			ER_NO_DEFAULT,
 			"btr_estimate_n_rows_in_range(): %lld",
                         (longlong) n_rows);
@@ -14310,13 +14855,126 @@ ha_innobase::records_in_range(
 		n_rows = 1;
 	}
 
-unsupported:
+	return n_rows;
+}
+
+/*********************************************************************//**
+Estimates the number of index records in a range.
+@return estimated number of rows */
+
+ha_rows
+ha_innobase::records_in_range(
+/*==========================*/
+	uint			keynr,		/*!< in: index number */
+	const key_range		*min_key,	/*!< in: start key value of the
+						range, may also be 0 */
+	const key_range		*max_key,	/*!< in: range end key val, may
+						also be 0 */
+        page_range              *pages)
+{
+	KEY*		key;
+	dict_index_t*	index;
+	ha_rows		n_rows = HA_POS_ERROR;
+	mem_heap_t*	heap;
+
+	DBUG_ENTER("records_in_range");
+
+	ut_ad(m_prebuilt->trx == thd_to_trx(ha_thd()));
+
+	m_prebuilt->trx->op_info = "estimating records in index range";
+
+	active_index = keynr;
+
+	key = table->key_info + active_index;
+
+	index = innobase_get_index(keynr);
+
+	/* There exists possibility of not being able to find requested
+	index due to inconsistency between MySQL and InoDB dictionary info.
+	Necessary message should have been printed in innobase_get_index() */
+	if (!index || !m_prebuilt->table->space) {
+		goto func_exit;
+	}
+	if (index->is_corrupted()) {
+		n_rows = HA_ERR_INDEX_CORRUPT;
+		goto func_exit;
+	}
+	if (!row_merge_is_index_usable(m_prebuilt->trx, index)) {
+		n_rows = HA_ERR_TABLE_DEF_CHANGED;
+		goto func_exit;
+	}
+
+	heap = mem_heap_create(2 * (key->ext_key_parts * sizeof(dfield_t)
+				    + sizeof(dtuple_t)));
+
+	n_rows = innobase_records_in_range(
+		m_prebuilt, index, key,
+		dtuple_create(heap, key->ext_key_parts),
+		dtuple_create(heap, key->ext_key_parts),
+		min_key, max_key, pages);
+
 	mem_heap_free(heap);
 func_exit:
 	m_prebuilt->trx->op_info = "";
 	DBUG_RETURN((ha_rows) n_rows);
 }
 
+/*********************************************************************//**
+Estimates the number of index records in several ranges of an index.
+The dictionary lookup and the checks of the index, as well as the
+search tuples, are shared by all the ranges. */
+
+void
+ha_innobase::records_in_ranges(
+/*===========================*/
+	uint			keynr,		/*!< in: index number */
+	uint			n_ranges,	/*!< in: number of ranges */
+	key_range* const*	min_keys,	/*!< in: start key values
+						of the ranges, may be 0 */
+	key_range* const*	max_keys,	/*!< in: end key values
+						of the ranges, may be 0 */
+	page_range*		pages,		/*!< in/out: page ranges */
+	ha_rows*		rows)		/*!< out: estimates */
+{
+	DBUG_ENTER("records_in_ranges");
+
+	ut_ad(m_prebuilt->trx == thd_to_trx(ha_thd()));
+
+	dict_index_t*	index = innobase_get_index(keynr);
+
+	if (!index || !m_prebuilt->table->space || index->is_corrupted()
+	    || !row_merge_is_index_usable(m_prebuilt->trx, index)) {
+		/* Let records_in_range() report the problem. */
+		handler::records_in_ranges(keynr, n_ranges, min_keys,
+					   max_keys, pages, rows);
+		DBUG_VOID_RETURN;
+	}
+
+	m_prebuilt->trx->op_info = "estimating records in index range";
+
+	active_index = keynr;
+
+	const KEY*	key = table->key_info + keynr;
+	mem_heap_t*	heap = mem_heap_create(
+		2 * (key->ext_key_parts * sizeof(dfield_t)
+		     + sizeof(dtuple_t)));
+	dtuple_t*	range_start = dtuple_create(heap, key->ext_key_parts);
+	dtuple_t*	range_end = dtuple_create(heap, key->ext_key_parts);
+
+	for (uint i = 0; i < n_ranges; i++) {
+		rows[i] = innobase_records_in_range(
+			m_prebuilt, index, key, range_start, range_end,
+			min_keys[i], max_keys[i], &pages[i]);
+		if (rows[i] == HA_POS_ERROR) {
+			break;
+		}
+	}
+
+	mem_heap_free(heap);
+	m_prebuilt->trx->op_info = "";
+	DBUG_VOID_RETURN;
+}
+
 /*********************************************************************//**
 Gives an UPPER BOUND to the number of rows in a table. This is used in
 filesort.cc.
@@ -15689,6 +16347,10 @@ ha_innobase::extra(
 		(void)check_trx_exists(ha_thd());
 		m_prebuilt->keep_other_fields_on_keyread = 1;
 		break;
+	case HA_EXTRA_NO_CACHE:
+		row_prebuilt_set_fetch_cache_size(m_prebuilt,
+						  MYSQL_FETCH_CACHE_SIZE);
+		break;
 	case HA_EXTRA_INSERT_WITH_UPDATE:
 		trx = check_trx_exists(ha_thd());
 		trx->duplicates |= TRX_DUP_IGNORE;
@@ -15766,6 +16428,25 @@ ha_innobase::extra(
 	return(0);
 }
 
+/** Tells something additional to the handler, with an argument.
+@param operation  HA_EXTRA_CACHE or some other flag
+@param arg        for HA_EXTRA_CACHE, the size of the read buffer that
+the SQL layer allows for a table scan
+@return 0 or error number */
+int ha_innobase::extra_opt(ha_extra_function operation, ulong arg)
+{
+	if (operation != HA_EXTRA_CACHE) {
+		return extra(operation);
+	}
+
+	/* Let a sequential scan prefetch as many rows under one page
+	latch as fit in the read buffer, instead of the default
+	MYSQL_FETCH_CACHE_SIZE rows per batch. */
+	row_prebuilt_set_fetch_cache_size(
+		m_prebuilt, arg / (m_prebuilt->mysql_row_len + 8));
+	return 0;
+}
+
 /**
 MySQL calls this method at the end of each statement */
 int
@@ -15786,6 +16467,7 @@ ha_innobase::reset()
 	m_prebuilt->autoinc_last_value = 0;
 
 	m_prebuilt->skip_locked = false;
+	row_prebuilt_set_fetch_cache_size(m_prebuilt, MYSQL_FETCH_CACHE_SIZE);
 	return(0);
 }
 
@@ -16501,7 +17183,13 @@ ha_innobase::store_lock(
 			    || sql_command == SQLCOM_CREATE_TABLE))
 		    || (trx->isolation_level == TRX_ISO_REPEATABLE_READ
 		        && sql_command == SQLCOM_ALTER_TABLE
-		        && lock_type == TL_READ)) {
+		        && lock_type == TL_READ)
+		    || (trx->isolation_level == TRX_ISO_REPEATABLE_READ
+			&& lock_type == TL_READ
+			&& (sql_command == SQLCOM_INSERT_SELECT
+			    || sql_command == SQLCOM_REPLACE_SELECT
+			    || sql_command == SQLCOM_CREATE_TABLE)
+			&& THDVAR(thd, insert_select_consistent_read))) {
 
 			/* If the transaction isolation level is
 			READ UNCOMMITTED or READ COMMITTED and we are executing
@@ -16509,7 +17197,15 @@ ha_innobase::store_lock(
 			or UPDATE ... = (SELECT ...) or CREATE  ...
 			SELECT... without FOR UPDATE or IN SHARE
 			MODE in select, then we use consistent read
-			for select. */
+			for select.
+
+			At REPEATABLE READ the same is done for
+			INSERT...SELECT, REPLACE...SELECT and CREATE...SELECT
+			if innodb_insert_select_consistent_read is set.
+			TL_READ means that the binlog does not require a
+			locking read: it is disabled or in ROW format. This
+			allows refreshing summary tables without blocking
+			the writers of the tables they are built from. */
 
 			m_prebuilt->select_lock_type = LOCK_NONE;
 			m_prebuilt->stored_select_lock_type = LOCK_NONE;
@@ -17593,6 +18289,17 @@ innodb_cmp_per_index_update(THD*, st_mysql_sys_var*, void*, const void* save)
 	srv_cmp_per_index_enabled = !!(*(my_bool*) save);
 }
 
+/** Update innodb_latch_stats_enabled. The statistics are reset whenever
+the collection is enabled. */
+static void innodb_latch_stats_enabled_update(THD*, st_mysql_sys_var*,
+                                              void*, const void *save)
+{
+  const my_bool enable= *static_cast<const my_bool*>(save);
+  if (!latch_stats.enabled && enable)
+    latch_stats.reset();
+  latch_stats.enabled= enable;
+}
+
 /****************************************************************//**
 Update the system variable innodb_old_blocks_pct using the "saved"
 value. This function is registered as a callback with MySQL. */
@@ -19083,6 +19790,13 @@ static MYSQL_SYSVAR_DOUBLE(adaptive_flushing_lwm,
   "Percentage of log capacity below which no adaptive flushing happens",
   NULL, NULL, 10.0, 0.0, 70.0, 0);
 
+static MYSQL_SYSVAR_DOUBLE(log_throttle_lwm, srv_log_throttle_lwm,
+  PLUGIN_VAR_RQCMDARG,
+  "Percentage of the maximum checkpoint age above which writes are delayed"
+  " in proportion to the checkpoint age while the checkpoint falls behind"
+  " the redo log generation; 0 disables the delay",
+  NULL, NULL, 0.0, 0.0, 99.999, 0);
+
 static MYSQL_SYSVAR_BOOL(adaptive_flushing, srv_adaptive_flushing,
   PLUGIN_VAR_NOCMDARG,
   "Attempt flushing dirty pages to avoid IO bursts at checkpoints",
@@ -19154,6 +19868,21 @@ static MYSQL_SYSVAR_BOOL(stats_auto_recalc, srv_stats_auto_recalc,
   " new statistics)",
   NULL, NULL, TRUE);
 
+static MYSQL_SYSVAR_UINT(stats_auto_recalc_threads,
+  srv_stats_auto_recalc_threads,
+  PLUGIN_VAR_RQCMDARG,
+  "Number of tables whose persistent statistics may be recalculated"
+  " automatically at the same time",
+  NULL, NULL, 1, 1, DICT_STATS_MAX_THREADS, 0);
+
+static MYSQL_SYSVAR_UINT(stats_auto_recalc_time_budget,
+  srv_stats_auto_recalc_time_budget,
+  PLUGIN_VAR_RQCMDARG,
+  "Maximum time in milliseconds to spend sampling the leaf pages of a"
+  " table in automatic recalculation of persistent statistics"
+  " (0 = unlimited)",
+  NULL, NULL, 0, 0, 3600000, 0);
+
 static MYSQL_SYSVAR_ULONGLONG(stats_persistent_sample_pages,
   srv_stats_persistent_sample_pages,
   PLUGIN_VAR_RQCMDARG,
@@ -19184,6 +19913,12 @@ static MYSQL_SYSVAR_ULONG(adaptive_hash_index_parts, btr_ahi_parts,
   PLUGIN_VAR_OPCMDARG | PLUGIN_VAR_READONLY,
   "Number of InnoDB Adaptive Hash Index Partitions (default 8)",
   NULL, NULL, 8, 1, 512, 0);
+
+static MYSQL_SYSVAR_BOOL(adaptive_hash_index_tuning, btr_search_tuning,
+  PLUGIN_VAR_OPCMDARG,
+  "Disable the InnoDB adaptive hash index for indexes where it has"
+  " few hits compared to its maintenance (disabled by default)",
+  NULL, NULL, FALSE);
 #endif /* BTR_CUR_HASH_ADAPT */
 
 static MYSQL_SYSVAR_UINT(compression_level, page_zip_level,
@@ -19206,6 +19941,25 @@ static MYSQL_SYSVAR_SIZE_T(buffer_pool_chunk_size, srv_buf_pool_chunk_unit,
   NULL, NULL,
   0, 0, SIZE_T_MAX, 1024 * 1024);
 
+/** Update the system variable innodb_buffer_pool_compressed_tier_size.
+@param[in]	save	immediate result from check function */
+static void
+innodb_buffer_pool_compressed_tier_size_update(THD*, st_mysql_sys_var*,
+					       void*, const void* save)
+{
+	srv_buf_pool_tier_size = *static_cast<const ulonglong*>(save);
+	buf_tier.resize(size_t(srv_buf_pool_tier_size));
+}
+
+static MYSQL_SYSVAR_ULONGLONG(buffer_pool_compressed_tier_size,
+  srv_buf_pool_tier_size,
+  PLUGIN_VAR_RQCMDARG,
+  "Maximum memory for compressed copies of clean pages that were evicted"
+  " from the buffer pool, so that they can be read back without I/O"
+  " (0 disables the compressed tier)",
+  NULL, innodb_buffer_pool_compressed_tier_size_update,
+  0, 0, LLONG_MAX, 1024*1024L);
+
 static MYSQL_SYSVAR_STR(buffer_pool_filename, srv_buf_dump_filename,
   PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
   "Filename to/from which to dump/load the InnoDB buffer pool",
@@ -19275,6 +20029,13 @@ static MYSQL_SYSVAR_BOOL(deadlock_detect, innodb_deadlock_detect,
   " and we rely on innodb_lock_wait_timeout in case of deadlock",
   NULL, NULL, TRUE);
 
+static MYSQL_SYSVAR_UINT(deadlock_detect_delay, innodb_deadlock_detect_delay,
+  PLUGIN_VAR_RQCMDARG,
+  "Number of milliseconds that a lock wait lasts before it is checked for"
+  " a deadlock (0=check immediately); waits that end sooner skip deadlock"
+  " detection",
+  NULL, NULL, 0, 0, 100000, 0);
+
 static MYSQL_SYSVAR_ENUM(deadlock_report, innodb_deadlock_report,
   PLUGIN_VAR_RQCMDARG,
   "How to report deadlocks (if innodb_deadlock_detect=ON)",
@@ -19409,11 +20170,69 @@ static MYSQL_SYSVAR_UINT(write_io_threads, srv_n_write_io_threads,
   "Number of background write I/O threads in InnoDB",
   NULL, innodb_write_io_threads_update, 4, 2, 64, 0);
 
+static void innodb_read_ahead_io_pct_update(THD* thd, st_mysql_sys_var*,
+                                            void*, const void* save)
+{
+  srv_read_ahead_io_pct = *static_cast<const uint*>(save);
+  innodb_update_io_thread_count(thd, srv_n_read_io_threads, srv_n_write_io_threads);
+}
+static void innodb_flush_io_pct_update(THD* thd, st_mysql_sys_var*,
+                                       void*, const void* save)
+{
+  srv_flush_io_pct = *static_cast<const uint*>(save);
+  innodb_update_io_thread_count(thd, srv_n_read_io_threads, srv_n_write_io_threads);
+}
+
+static MYSQL_SYSVAR_UINT(read_ahead_io_pct, srv_read_ahead_io_pct,
+  PLUGIN_VAR_RQCMDARG,
+  "Percentage of the asynchronous read slots (innodb_read_io_threads*256)"
+  " that read-ahead and buffer pool load may use; the rest are reserved"
+  " for other reads",
+  NULL, innodb_read_ahead_io_pct_update, 50, 1, 100, 0);
+
+static MYSQL_SYSVAR_UINT(flush_io_pct, srv_flush_io_pct,
+  PLUGIN_VAR_RQCMDARG,
+  "Percentage of the asynchronous write slots (innodb_write_io_threads*256)"
+  " that page writes may use; lower values limit the device queue depth"
+  " that page flushing takes from reads",
+  NULL, innodb_flush_io_pct_update, 100, 1, 100, 0);
+
+static MYSQL_SYSVAR_UINT(page_cleaner_threads, srv_n_page_cleaner_threads,
+  PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
+  "Number of threads that write out dirty pages on behalf of"
+  " the page cleaner, including the page cleaner itself",
+  NULL, NULL, 1, 1, 64, 0);
+
+static MYSQL_SYSVAR_UINT(recovery_apply_threads, srv_n_recovery_apply_threads,
+  PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
+  "Maximum number of threads that apply redo log records to pages"
+  " during crash recovery (0=innodb_read_io_threads)",
+  NULL, NULL, 0, 0, 256, 0);
+
+static MYSQL_SYSVAR_UINT(import_threads, srv_import_threads,
+  PLUGIN_VAR_RQCMDARG,
+  "Number of threads that convert the pages of a tablespace"
+  " in ALTER TABLE...IMPORT TABLESPACE",
+  NULL, NULL, 4, 1, 256, 0);
+
 static MYSQL_SYSVAR_ULONG(force_recovery, srv_force_recovery,
   PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
   "Helps to save your data in case the disk image of the database becomes corrupt. Value 5 can return bogus data, and 6 can permanently corrupt data",
   NULL, NULL, 0, 0, 6, 0);
 
+static MYSQL_SYSVAR_UINT(partition_read_ahead, srv_partition_read_ahead,
+  PLUGIN_VAR_RQCMDARG,
+  "Number of leaf pages that are read ahead in each partition when a scan"
+  " of a partitioned table starts (0=disable)",
+  NULL, NULL, 0, 0, 4096, 0);
+
+static MYSQL_SYSVAR_ULONGLONG(shared_scan_min_size, srv_shared_scan_min_size,
+  PLUGIN_VAR_RQCMDARG,
+  "Minimum size in bytes of the clustered index of a table for which a full"
+  " table scan starts at the position of a concurrent scan of the same table"
+  " and wraps around to the first record (0=disable)",
+  NULL, NULL, 0, 0, ~0ULL, 0);
+
 static MYSQL_SYSVAR_ULONG(page_size, srv_page_size,
   PLUGIN_VAR_OPCMDARG | PLUGIN_VAR_READONLY,
   "Page size to use for all InnoDB tablespaces",
@@ -19472,6 +20291,20 @@ static MYSQL_SYSVAR_UINT(log_spin_wait_delay, mtr_t::spin_wait_delay,
   nullptr, innodb_log_spin_wait_delay_update,
   0, 0, 6000, 0);
 
+static MYSQL_SYSVAR_BOOL(track_changed_pages, srv_track_changed_pages,
+  PLUGIN_VAR_OPCMDARG | PLUGIN_VAR_READONLY,
+  "Record the identifiers of written pages in ib_changed_pages,"
+  " so that incremental backups only need to read the changed pages",
+  nullptr, nullptr, FALSE);
+
+static MYSQL_SYSVAR_ULONGLONG(track_changed_pages_file_size,
+  srv_track_changed_pages_file_size,
+  PLUGIN_VAR_RQCMDARG,
+  "Size of ib_changed_pages after which it is renamed to"
+  " ib_changed_pages.1 and a new file is started",
+  nullptr, nullptr,
+  128 << 20, 1 << 20, std::numeric_limits<ulonglong>::max(), 4096);
+
 static MYSQL_SYSVAR_UINT(old_blocks_pct, innobase_old_blocks_pct,
   PLUGIN_VAR_RQCMDARG,
   "Percentage of the buffer pool to reserve for 'old' blocks",
@@ -19499,6 +20332,12 @@ static MYSQL_SYSVAR_UINT(spin_wait_delay, srv_spin_wait_delay,
   "Maximum delay between polling for a spin lock (4 by default)",
   NULL, NULL, 4, 0, 6000, 0);
 
+static MYSQL_SYSVAR_BOOL(latch_stats_enabled, latch_stats.enabled,
+  PLUGIN_VAR_OPCMDARG,
+  "Collect contention statistics of InnoDB latches for"
+  " INFORMATION_SCHEMA.INNODB_LATCH_STATS (disabled by default)",
+  NULL, innodb_latch_stats_enabled_update, FALSE);
+
 static my_bool innodb_prefix_index_cluster_optimization;
 
 static MYSQL_SYSVAR_BOOL(prefix_index_cluster_optimization,
@@ -19563,6 +20402,11 @@ static MYSQL_SYSVAR_BOOL(undo_log_truncate, srv_undo_log_truncate,
   "Enable or Disable Truncate of UNDO tablespace",
   NULL, innodb_undo_log_truncate_update, FALSE);
 
+static MYSQL_SYSVAR_BOOL(undo_log_shrink, srv_undo_log_shrink,
+  PLUGIN_VAR_OPCMDARG,
+  "Discard the unused end of UNDO tablespaces while purge is running",
+  NULL, NULL, FALSE);
+
 static MYSQL_SYSVAR_LONG(autoinc_lock_mode, innobase_autoinc_lock_mode,
   PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
   "The AUTOINC lock modes supported by InnoDB:"
@@ -19611,6 +20455,13 @@ static MYSQL_SYSVAR_BOOL(numa_interleave, srv_numa_interleave,
   PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
   "Use NUMA interleave memory policy to allocate InnoDB buffer pool",
   NULL, NULL, FALSE);
+
+static MYSQL_SYSVAR_BOOL(numa_bind, srv_numa_bind,
+  PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
+  "Bind InnoDB buffer pool chunks to NUMA nodes in a round-robin fashion,"
+  " and prefer free pages of the local node. Ignored if"
+  " innodb_numa_interleave=ON",
+  NULL, NULL, FALSE);
 #endif /* HAVE_LIBNUMA */
 
 static MYSQL_SYSVAR_ENUM(stats_method, srv_innodb_stats_method,
@@ -19773,6 +20624,13 @@ static MYSQL_SYSVAR_BOOL(alter_copy_bulk, innodb_alter_copy_bulk,
   PLUGIN_VAR_NOCMDARG,
   "Allow bulk insert operation for copy alter operation", NULL, NULL, TRUE);
 
+static MYSQL_SYSVAR_BOOL(bulk_insert_non_empty, innodb_bulk_insert_non_empty,
+  PLUGIN_VAR_NOCMDARG,
+  "Lock the table exclusively for a multi-row INSERT into a non-empty table"
+  " and insert the entries of non-unique secondary indexes in sorted order"
+  " at the end of the statement",
+  NULL, NULL, FALSE);
+
 const char *page_compression_algorithms[]= { "none", "zlib", "lz4", "lzo", "lzma", "bzip2", "snappy", 0 };
 static TYPELIB page_compression_algorithms_typelib=
 		CREATE_TYPELIB_FOR(page_compression_algorithms);
@@ -19858,6 +20716,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(autoextend_increment),
   MYSQL_SYSVAR(buffer_pool_size),
   MYSQL_SYSVAR(buffer_pool_chunk_size),
+  MYSQL_SYSVAR(buffer_pool_compressed_tier_size),
   MYSQL_SYSVAR(buffer_pool_filename),
   MYSQL_SYSVAR(buffer_pool_dump_now),
   MYSQL_SYSVAR(buffer_pool_dump_at_shutdown),
@@ -19885,6 +20744,11 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(fast_shutdown),
   MYSQL_SYSVAR(read_io_threads),
   MYSQL_SYSVAR(write_io_threads),
+  MYSQL_SYSVAR(read_ahead_io_pct),
+  MYSQL_SYSVAR(flush_io_pct),
+  MYSQL_SYSVAR(page_cleaner_threads),
+  MYSQL_SYSVAR(recovery_apply_threads),
+  MYSQL_SYSVAR(import_threads),
   MYSQL_SYSVAR(file_per_table),
   MYSQL_SYSVAR(flush_log_at_timeout),
   MYSQL_SYSVAR(flush_log_at_trx_commit),
@@ -19901,8 +20765,11 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(ft_sort_pll_degree),
   MYSQL_SYSVAR(lock_wait_timeout),
   MYSQL_SYSVAR(deadlock_detect),
+  MYSQL_SYSVAR(deadlock_detect_delay),
   MYSQL_SYSVAR(deadlock_report),
   MYSQL_SYSVAR(page_size),
+  MYSQL_SYSVAR(partition_read_ahead),
+  MYSQL_SYSVAR(shared_scan_min_size),
   MYSQL_SYSVAR(log_buffer_size),
 #ifdef HAVE_INNODB_MMAP
   MYSQL_SYSVAR(log_file_mmap),
@@ -19917,9 +20784,12 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(log_write_ahead_size),
   MYSQL_SYSVAR(log_spin_wait_delay),
   MYSQL_SYSVAR(log_group_home_dir),
+  MYSQL_SYSVAR(track_changed_pages),
+  MYSQL_SYSVAR(track_changed_pages_file_size),
   MYSQL_SYSVAR(max_dirty_pages_pct),
   MYSQL_SYSVAR(max_dirty_pages_pct_lwm),
   MYSQL_SYSVAR(adaptive_flushing_lwm),
+  MYSQL_SYSVAR(log_throttle_lwm),
   MYSQL_SYSVAR(adaptive_flushing),
   MYSQL_SYSVAR(flush_sync),
   MYSQL_SYSVAR(flushing_avg_loops),
@@ -19937,16 +20807,20 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(ft_user_stopword_table),
   MYSQL_SYSVAR(disable_sort_file_cache),
   MYSQL_SYSVAR(snapshot_isolation),
+  MYSQL_SYSVAR(insert_select_consistent_read),
   MYSQL_SYSVAR(stats_on_metadata),
   MYSQL_SYSVAR(stats_transient_sample_pages),
   MYSQL_SYSVAR(stats_persistent),
   MYSQL_SYSVAR(stats_persistent_sample_pages),
   MYSQL_SYSVAR(stats_auto_recalc),
+  MYSQL_SYSVAR(stats_auto_recalc_threads),
+  MYSQL_SYSVAR(stats_auto_recalc_time_budget),
   MYSQL_SYSVAR(stats_modified_counter),
   MYSQL_SYSVAR(stats_traditional),
 #ifdef BTR_CUR_HASH_ADAPT
   MYSQL_SYSVAR(adaptive_hash_index),
   MYSQL_SYSVAR(adaptive_hash_index_parts),
+  MYSQL_SYSVAR(adaptive_hash_index_tuning),
 #endif /* BTR_CUR_HASH_ADAPT */
   MYSQL_SYSVAR(stats_method),
   MYSQL_SYSVAR(status_file),
@@ -19955,6 +20829,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(online_alter_log_max_size),
   MYSQL_SYSVAR(sync_spin_loops),
   MYSQL_SYSVAR(spin_wait_delay),
+  MYSQL_SYSVAR(latch_stats_enabled),
   MYSQL_SYSVAR(table_locks),
   MYSQL_SYSVAR(prefix_index_cluster_optimization),
   MYSQL_SYSVAR(tmpdir),
@@ -19962,6 +20837,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(use_native_aio),
 #ifdef HAVE_LIBNUMA
   MYSQL_SYSVAR(numa_interleave),
+  MYSQL_SYSVAR(numa_bind),
 #endif /* HAVE_LIBNUMA */
   MYSQL_SYSVAR(random_read_ahead),
   MYSQL_SYSVAR(read_ahead_threshold),
@@ -19988,6 +20864,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(max_undo_log_size),
   MYSQL_SYSVAR(purge_rseg_truncate_frequency),
   MYSQL_SYSVAR(undo_log_truncate),
+  MYSQL_SYSVAR(undo_log_shrink),
   MYSQL_SYSVAR(undo_directory),
   MYSQL_SYSVAR(undo_tablespaces),
   MYSQL_SYSVAR(compression_failure_threshold_pct),
@@ -20009,6 +20886,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
           defined(INNODB_ENABLE_XAP_UNLOCK_UNMODIFIED_FOR_PRIMARY) */
   MYSQL_SYSVAR(force_primary_key),
   MYSQL_SYSVAR(alter_copy_bulk),
+  MYSQL_SYSVAR(bulk_insert_non_empty),
   MYSQL_SYSVAR(fatal_semaphore_wait_threshold),
   /* Table page compression feature */
   MYSQL_SYSVAR(compression_default),
@@ -20073,7 +20951,12 @@ i_s_innodb_sys_foreign,
 i_s_innodb_sys_foreign_cols,
 i_s_innodb_sys_tablespaces,
 i_s_innodb_sys_virtual,
-i_s_innodb_tablespaces_encryption
+i_s_innodb_tablespaces_encryption,
+i_s_innodb_latch_stats,
+i_s_innodb_buffer_index_stats
+#ifdef BTR_CUR_HASH_ADAPT
+, i_s_innodb_adaptive_hash_index_stats
+#endif /* BTR_CUR_HASH_ADAPT */
 maria_declare_plugin_end;
 
 /** Adjust some InnoDB startup parameters based on the data directory */
@@ -22,6 +22,7 @@ this program; if not, write to the Free Software Foundation, Inc.,
 #endif /* WITH_WSREP */
 
 #include "table.h"
+#include <unordered_set>
 
 /* The InnoDB handler: the interface between MySQL and InnoDB. */
 
@@ -103,8 +104,13 @@ class ha_innobase final : public handler
 	IO_AND_CPU_COST scan_time() override;
         double rnd_pos_time(ha_rows rows) override;
 #endif
+	void start_bulk_insert(ha_rows rows, uint flags) override;
+
 	int write_row(const uchar * buf) override;
 
+	int write_rows(const uchar *rows, ha_rows n, ha_rows *written)
+		override;
+
 	int update_row(const uchar * old_data, const uchar * new_data) override;
 
 	int delete_row(const uchar * buf) override;
@@ -151,9 +157,26 @@ class ha_innobase final : public handler
 
 	int rnd_pos(uchar * buf, uchar *pos) override;
 
+	int pre_rnd_next(bool use_parallel) override;
+
+	int pre_index_first(bool use_parallel) override;
+
+	int pre_read_range_first(const key_range *start_key,
+				 const key_range *end_key,
+				 bool eq_range, bool sorted,
+				 bool use_parallel) override;
+
+	int sample_init(double *fraction) override;
+
+	int sample_next(uchar *buf) override;
+
+	int sample_end() override;
+
 	int ft_init() override;
 	void ft_end() override { rnd_end(); }
 	FT_INFO *ft_init_ext(uint flags, uint inx, String* key) override;
+	FT_INFO *ft_init_ext_with_limit(uint flags, uint inx, String* key,
+					ha_rows limit) override;
 	int ft_read(uchar* buf) override;
 
 	void position(const uchar *record) override;
@@ -168,6 +191,8 @@ class ha_innobase final : public handler
 
 	int extra(ha_extra_function operation) override;
 
+	int extra_opt(ha_extra_function operation, ulong arg) override;
+
 	int reset() override;
 
 	int external_lock(THD *thd, int lock_type) override;
@@ -180,6 +205,14 @@ class ha_innobase final : public handler
                 const key_range*        max_key,
                 page_range*             pages) override;
 
+	void records_in_ranges(
+		uint			inx,
+		uint			n_ranges,
+		key_range* const*	min_keys,
+		key_range* const*	max_keys,
+		page_range*		pages,
+		ha_rows*		rows) override;
+
 	ha_rows estimate_rows_upper_bound() override;
 
 	void update_create_info(HA_CREATE_INFO* create_info) override;
@@ -460,6 +493,9 @@ class ha_innobase final : public handler
 	void update_thd();
 
 	int general_fetch(uchar* buf, uint direction, uint match_mode);
+	void shared_scan_begin();
+	void shared_scan_end();
+	int shared_scan_next(uchar* buf, int error);
 	int change_active_index(uint keynr);
 	/* @return true if it's necessary to switch current statement log
 	format from STATEMENT to ROW if binary log format is MIXED and
@@ -510,6 +546,24 @@ class ha_innobase final : public handler
 	not yet fetched any row, else false */
 	bool			m_start_of_scan;
 
+	/** whether the current table scan takes part in shared scans
+	(innodb_shared_scan_min_size) */
+	bool			m_shared_scan;
+
+	/** whether the shared scan started from the position of another
+	scan in m_shared_scan_start, rather than from the first record */
+	bool			m_shared_scan_mid;
+
+	/** whether the shared scan reached the end of the index and
+	continues from the first record up to m_shared_scan_start */
+	bool			m_shared_scan_wrapped;
+
+	/** number of rows read by the shared scan */
+	ulint			m_shared_scan_rows;
+
+	/** the start position of a shared scan, ref_length bytes */
+	uchar*			m_shared_scan_start;
+
 	/*!< match mode of the latest search: ROW_SEL_EXACT,
 	ROW_SEL_EXACT_PREFIX, or undefined */
 	uint			m_last_match_mode;
@@ -520,6 +574,20 @@ class ha_innobase final : public handler
 	/** If true, disable the Rowid Filter. It is disabled when
 	the enigne is intialized for making rnd_pos() calls */
 	bool                    m_disable_rowid_filter;
+
+	/** number of random leaf pages still to be read by sample_next() */
+	ulint			m_sample_pages;
+
+	/** number of random leaf pages that sample_next() may still pick,
+	including those that were already read and are skipped */
+	ulint			m_sample_tries;
+
+	/** page numbers of the leaf pages read by sample_next() */
+	std::unordered_set<uint32_t>	m_sample_seen;
+
+	/** number of records still to be read by sample_next()
+	starting from the current sampled page */
+	ulint			m_sample_recs;
 };
 
 
@@ -578,6 +646,8 @@ typedef struct new_ft_info
 	struct _ft_vft_ext	*could_you;
 	row_prebuilt_t*		ft_prebuilt;
 	fts_result_t*		ft_result;
+	/** number of documents of the highest rank that are read */
+	ha_rows			ft_limit;
 } NEW_FT_INFO;
 
 /**
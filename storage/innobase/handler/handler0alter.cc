@@ -11441,6 +11441,18 @@ ha_innobase::commit_inplace_alter_table(
 				continue;
 			}
 
+			/* Drain the logs of the non-unique indexes
+			concurrently. Any failure will be reported
+			by the loop below. */
+			ulint err_index;
+			if (row_log_apply_parallel(m_prebuilt->trx,
+						   ctx->add_index,
+						   ctx->num_to_add_index,
+						   &err_index)) {
+				m_prebuilt->trx->error_key_num
+					= ctx->add_key_numbers[err_index];
+			}
+
 			for (ulint i = 0; i < ctx->num_to_add_index; i++) {
 				dict_index_t *index= ctx->add_index[i];
 
@@ -50,6 +50,8 @@ Created July 18, 2007 Vasil Dimov
 #include "fts0opt.h"
 #include "fts0priv.h"
 #include "btr0btr.h"
+#include "btr0sea.h"
+#include "buf0stats.h"
 #include "page0zip.h"
 #include "fil0fil.h"
 #include "fil0crypt.h"
@@ -6563,3 +6565,430 @@ struct st_maria_plugin	i_s_innodb_tablespaces_encryption =
 	i_s_version, nullptr, nullptr, PACKAGE_VERSION,
 	MariaDB_PLUGIN_MATURITY_STABLE
 };
+
+namespace Show {
+/**  LATCH_STATS  ****************************************************/
+/* Fields of the dynamic table INFORMATION_SCHEMA.INNODB_LATCH_STATS */
+static ST_FIELD_INFO innodb_latch_stats_fields_info[]=
+{
+#define LATCH_STATS_NAME	0
+  Column("NAME", Varchar(64), NOT_NULL),
+
+#define LATCH_STATS_WAITS	1
+  Column("WAITS", ULonglong(), NOT_NULL),
+
+#define LATCH_STATS_SPIN_ROUNDS	2
+  Column("SPIN_ROUNDS", ULonglong(), NOT_NULL),
+
+#define LATCH_STATS_SLEEPS	3
+  Column("SLEEPS", ULonglong(), NOT_NULL),
+
+#define LATCH_STATS_WAIT_TIME	4
+  Column("WAIT_TIME", ULonglong(), NOT_NULL),
+
+  CEnd()
+};
+} // namespace Show
+
+/** Fill INFORMATION_SCHEMA.INNODB_LATCH_STATS with one row per latch class.
+@return 0 on success */
+static int i_s_latch_stats_fill(THD *thd, TABLE_LIST *tables, Item *)
+{
+  DBUG_ENTER("i_s_latch_stats_fill");
+
+  /* deny access to user without PROCESS_ACL privilege */
+  if (check_global_access(thd, PROCESS_ACL))
+    DBUG_RETURN(0);
+
+  Field **fields= tables->table->field;
+
+  for (int i= 0; i < latch_stats_t::N_CLASSES; i++)
+  {
+    const auto latch= static_cast<latch_stats_t::latch_class>(i);
+    const latch_stats_t::counters &c= latch_stats.get(latch);
+    OK(field_store_string(fields[LATCH_STATS_NAME], latch_stats.name(latch)));
+    OK(fields[LATCH_STATS_WAITS]->store(c.waits, true));
+    OK(fields[LATCH_STATS_SPIN_ROUNDS]->store(c.spin_rounds, true));
+    OK(fields[LATCH_STATS_SLEEPS]->store(c.sleeps, true));
+    OK(fields[LATCH_STATS_WAIT_TIME]->store(c.wait_time / 1000, true));
+    OK(schema_table_store_record(thd, tables->table));
+  }
+
+  DBUG_RETURN(0);
+}
+
+/** Bind the dynamic table INFORMATION_SCHEMA.INNODB_LATCH_STATS
+@return 0 on success */
+static int innodb_latch_stats_init(void *p)
+{
+  DBUG_ENTER("innodb_latch_stats_init");
+  ST_SCHEMA_TABLE *schema= static_cast<ST_SCHEMA_TABLE*>(p);
+  schema->fields_info= Show::innodb_latch_stats_fields_info;
+  schema->fill_table= i_s_latch_stats_fill;
+  DBUG_RETURN(0);
+}
+
+struct st_maria_plugin	i_s_innodb_latch_stats =
+{
+	/* the plugin type (a MYSQL_XXX_PLUGIN value) */
+	/* int */
+	MYSQL_INFORMATION_SCHEMA_PLUGIN,
+
+	/* pointer to type-specific plugin descriptor */
+	/* void* */
+	&i_s_info,
+
+	/* plugin name */
+	/* const char* */
+	"INNODB_LATCH_STATS",
+
+	/* plugin author (for SHOW PLUGINS) */
+	/* const char* */
+	plugin_author,
+
+	/* general descriptive text (for SHOW PLUGINS) */
+	/* const char* */
+	"InnoDB latch contention statistics",
+
+	/* the plugin license (PLUGIN_LICENSE_XXX) */
+	/* int */
+	PLUGIN_LICENSE_GPL,
+
+	/* the function to invoke when plugin is loaded */
+	/* int (*)(void*); */
+	innodb_latch_stats_init,
+
+	/* the function to invoke when plugin is unloaded */
+	/* int (*)(void*); */
+	i_s_common_deinit,
+
+	i_s_version, nullptr, nullptr, PACKAGE_VERSION,
+	MariaDB_PLUGIN_MATURITY_STABLE
+};
+
+namespace Show {
+/**  BUFFER_INDEX_STATS  *********************************************/
+/* Fields of the dynamic table INFORMATION_SCHEMA.INNODB_BUFFER_INDEX_STATS */
+static ST_FIELD_INFO innodb_buffer_index_stats_fields_info[]=
+{
+#define BUF_IDX_STATS_SPACE		0
+  Column("SPACE", ULong(), NULLABLE),
+
+#define BUF_IDX_STATS_INDEX_ID		1
+  Column("INDEX_ID", ULonglong(), NOT_NULL),
+
+#define BUF_IDX_STATS_DATABASE_NAME	2
+  Column("DATABASE_NAME", Varchar(NAME_CHAR_LEN), NULLABLE),
+
+#define BUF_IDX_STATS_TABLE_NAME	3
+  Column("TABLE_NAME", Varchar(NAME_CHAR_LEN), NULLABLE),
+
+#define BUF_IDX_STATS_INDEX_NAME	4
+  Column("INDEX_NAME", Varchar(NAME_CHAR_LEN), NULLABLE),
+
+#define BUF_IDX_STATS_PAGES_RESIDENT	5
+  Column("PAGES_RESIDENT", ULonglong(), NOT_NULL),
+
+#define BUF_IDX_STATS_PAGES_READ	6
+  Column("PAGES_READ", ULonglong(), NOT_NULL),
+
+#define BUF_IDX_STATS_PAGES_WRITTEN	7
+  Column("PAGES_WRITTEN", ULonglong(), NOT_NULL),
+
+#define BUF_IDX_STATS_AHI_HITS		8
+  Column("AHI_HITS", ULonglong(), NOT_NULL),
+
+  CEnd()
+};
+} // namespace Show
+
+/** Populate information_schema.innodb_buffer_index_stats with a slot.
+@param thd            connection
+@param s              slot of buf_index_stats
+@param untracked      whether s is buf_index_stats_t::UNTRACKED
+@param table_to_fill  INFORMATION_SCHEMA.INNODB_BUFFER_INDEX_STATS
+@return 0 on success */
+static int i_s_buffer_index_stats_fill_slot(THD *thd,
+                                            const buf_index_stats_t::slot &s,
+                                            bool untracked,
+                                            TABLE *table_to_fill)
+{
+  DBUG_ENTER("i_s_buffer_index_stats_fill_slot");
+  Field **fields= table_to_fill->field;
+  const int64_t resident= s.resident;
+
+  if (untracked)
+    fields[BUF_IDX_STATS_SPACE]->set_null();
+  else
+  {
+    fields[BUF_IDX_STATS_SPACE]->set_notnull();
+    OK(fields[BUF_IDX_STATS_SPACE]->store(s.space_id, true));
+  }
+  OK(fields[BUF_IDX_STATS_INDEX_ID]->store(longlong(s.index_id), true));
+
+  const dict_index_t *index= s.index_id
+    ? dict_index_get_if_in_cache_low(s.index_id) : nullptr;
+  if (index && index->table->space_id == s.space_id)
+  {
+    char db_utf8[MAX_DB_UTF8_LEN];
+    char table_utf8[MAX_TABLE_UTF8_LEN];
+    dict_fs2utf8(index->table->name.m_name, db_utf8, sizeof db_utf8,
+                 table_utf8, sizeof table_utf8);
+    OK(field_store_string(fields[BUF_IDX_STATS_DATABASE_NAME], db_utf8));
+    OK(field_store_string(fields[BUF_IDX_STATS_TABLE_NAME], table_utf8));
+    OK(field_store_string(fields[BUF_IDX_STATS_INDEX_NAME], index->name));
+  }
+  else
+  {
+    fields[BUF_IDX_STATS_DATABASE_NAME]->set_null();
+    fields[BUF_IDX_STATS_TABLE_NAME]->set_null();
+    fields[BUF_IDX_STATS_INDEX_NAME]->set_null();
+  }
+
+  OK(fields[BUF_IDX_STATS_PAGES_RESIDENT]->store(resident > 0 ? resident : 0,
+                                                 true));
+  OK(fields[BUF_IDX_STATS_PAGES_READ]->store(s.reads, true));
+  OK(fields[BUF_IDX_STATS_PAGES_WRITTEN]->store(s.writes, true));
+  OK(fields[BUF_IDX_STATS_AHI_HITS]->store(s.ahi_hits, true));
+  OK(schema_table_store_record(thd, table_to_fill));
+  DBUG_RETURN(0);
+}
+
+/** Fill INFORMATION_SCHEMA.INNODB_BUFFER_INDEX_STATS from buf_index_stats.
+Pages that do not belong to any index are reported with INDEX_ID=0, and
+pages that did not fit in buf_index_stats with SPACE=NULL.
+@return 0 on success */
+static int i_s_buffer_index_stats_fill(THD *thd, TABLE_LIST *tables, Item *)
+{
+  DBUG_ENTER("i_s_buffer_index_stats_fill");
+  RETURN_IF_INNODB_NOT_STARTED(tables->schema_table_name.str);
+
+  /* deny access to user without PROCESS_ACL privilege */
+  if (check_global_access(thd, PROCESS_ACL))
+    DBUG_RETURN(0);
+
+  int err= 0;
+  dict_sys.freeze(SRW_LOCK_CALL);
+
+  for (uint32_t i= 0; i < buf_index_stats_t::N_SLOTS && !err; i++)
+    if (const buf_index_stats_t::slot *s= buf_index_stats.get(i))
+      if (s->resident > 0 || s->reads || s->writes || s->ahi_hits)
+        err= i_s_buffer_index_stats_fill_slot(thd, *s,
+                                              i == buf_index_stats_t::UNTRACKED,
+                                              tables->table);
+
+  dict_sys.unfreeze();
+  DBUG_RETURN(err);
+}
+
+/** Bind the dynamic table INFORMATION_SCHEMA.INNODB_BUFFER_INDEX_STATS
+@return 0 on success */
+static int innodb_buffer_index_stats_init(void *p)
+{
+  DBUG_ENTER("innodb_buffer_index_stats_init");
+  ST_SCHEMA_TABLE *schema= static_cast<ST_SCHEMA_TABLE*>(p);
+  schema->fields_info= Show::innodb_buffer_index_stats_fields_info;
+  schema->fill_table= i_s_buffer_index_stats_fill;
+  DBUG_RETURN(0);
+}
+
+struct st_maria_plugin	i_s_innodb_buffer_index_stats =
+{
+	/* the plugin type (a MYSQL_XXX_PLUGIN value) */
+	/* int */
+	MYSQL_INFORMATION_SCHEMA_PLUGIN,
+
+	/* pointer to type-specific plugin descriptor */
+	/* void* */
+	&i_s_info,
+
+	/* plugin name */
+	/* const char* */
+	"INNODB_BUFFER_INDEX_STATS",
+
+	/* plugin author (for SHOW PLUGINS) */
+	/* const char* */
+	plugin_author,
+
+	/* general descriptive text (for SHOW PLUGINS) */
+	/* const char* */
+	"InnoDB buffer pool residency and I/O per index",
+
+	/* the plugin license (PLUGIN_LICENSE_XXX) */
+	/* int */
+	PLUGIN_LICENSE_GPL,
+
+	/* the function to invoke when plugin is loaded */
+	/* int (*)(void*); */
+	innodb_buffer_index_stats_init,
+
+	/* the function to invoke when plugin is unloaded */
+	/* int (*)(void*); */
+	i_s_common_deinit,
+
+	i_s_version, nullptr, nullptr, PACKAGE_VERSION,
+	MariaDB_PLUGIN_MATURITY_STABLE
+};
+
+#ifdef BTR_CUR_HASH_ADAPT
+namespace Show {
+/**  ADAPTIVE_HASH_INDEX_STATS  *************************************/
+/* Fields of the dynamic table
+INFORMATION_SCHEMA.INNODB_ADAPTIVE_HASH_INDEX_STATS */
+static ST_FIELD_INFO innodb_ahi_stats_fields_info[]=
+{
+#define AHI_STATS_DATABASE_NAME	0
+  Column("DATABASE_NAME", Varchar(NAME_CHAR_LEN), NOT_NULL),
+
+#define AHI_STATS_TABLE_NAME	1
+  Column("TABLE_NAME", Varchar(NAME_CHAR_LEN), NOT_NULL),
+
+#define AHI_STATS_INDEX_NAME	2
+  Column("INDEX_NAME", Varchar(NAME_CHAR_LEN), NOT_NULL),
+
+#define AHI_STATS_INDEX_ID	3
+  Column("INDEX_ID", ULonglong(), NOT_NULL),
+
+#define AHI_STATS_ENABLED	4
+  Column("ENABLED", SLong(1), NOT_NULL),
+
+#define AHI_STATS_HASHED_PAGES	5
+  Column("HASHED_PAGES", ULonglong(), NOT_NULL),
+
+#define AHI_STATS_HITS		6
+  Column("HITS", ULonglong(), NOT_NULL),
+
+#define AHI_STATS_MISSES	7
+  Column("MISSES", ULonglong(), NOT_NULL),
+
+#define AHI_STATS_MAINTENANCE	8
+  Column("MAINTENANCE", ULonglong(), NOT_NULL),
+
+#define AHI_STATS_TUNED_OFF	9
+  Column("TUNED_OFF", ULonglong(), NOT_NULL),
+
+  CEnd()
+};
+} // namespace Show
+
+/** Populate information_schema.innodb_adaptive_hash_index_stats
+with an index.
+@param thd            connection
+@param index          index that has been used with the adaptive hash index
+@param table_to_fill  INFORMATION_SCHEMA.INNODB_ADAPTIVE_HASH_INDEX_STATS
+@return 0 on success */
+static int i_s_ahi_stats_fill_index(THD *thd, dict_index_t *index,
+                                    TABLE *table_to_fill)
+{
+  DBUG_ENTER("i_s_ahi_stats_fill_index");
+  Field **fields= table_to_fill->field;
+  const btr_search_t *info= index->search_info;
+  char db_utf8[MAX_DB_UTF8_LEN];
+  char table_utf8[MAX_TABLE_UTF8_LEN];
+
+  dict_fs2utf8(index->table->name.m_name, db_utf8, sizeof db_utf8,
+               table_utf8, sizeof table_utf8);
+
+  OK(field_store_string(fields[AHI_STATS_DATABASE_NAME], db_utf8));
+  OK(field_store_string(fields[AHI_STATS_TABLE_NAME], table_utf8));
+  OK(field_store_string(fields[AHI_STATS_INDEX_NAME], index->name));
+  OK(fields[AHI_STATS_INDEX_ID]->store(longlong(index->id), true));
+  OK(fields[AHI_STATS_ENABLED]->store(btr_search_enabled && !info->tune_off,
+                                      true));
+  OK(fields[AHI_STATS_HASHED_PAGES]->store(index->n_ahi_pages(), true));
+  OK(fields[AHI_STATS_HITS]->store(info->n_hits, true));
+  OK(fields[AHI_STATS_MISSES]->store(info->n_misses, true));
+  OK(fields[AHI_STATS_MAINTENANCE]->store(info->n_maintenance, true));
+  OK(fields[AHI_STATS_TUNED_OFF]->store(info->n_tuned_off, true));
+  OK(schema_table_store_record(thd, table_to_fill));
+  DBUG_RETURN(0);
+}
+
+/** Fill INFORMATION_SCHEMA.INNODB_ADAPTIVE_HASH_INDEX_STATS with the
+indexes of the cached tables that have used the adaptive hash index.
+@return 0 on success */
+static int i_s_ahi_stats_fill(THD *thd, TABLE_LIST *tables, Item *)
+{
+  DBUG_ENTER("i_s_ahi_stats_fill");
+  RETURN_IF_INNODB_NOT_STARTED(tables->schema_table_name.str);
+
+  /* deny access to user without PROCESS_ACL privilege */
+  if (check_global_access(thd, PROCESS_ACL))
+    DBUG_RETURN(0);
+
+  int err= 0;
+  dict_sys.freeze(SRW_LOCK_CALL);
+
+  for (auto list : {&dict_sys.table_LRU, &dict_sys.table_non_LRU})
+  {
+    for (dict_table_t *table= UT_LIST_GET_FIRST(*list); table && !err;
+         table= UT_LIST_GET_NEXT(table_LRU, table))
+    {
+      if (table->is_temporary())
+        continue;
+      for (dict_index_t *index= dict_table_get_first_index(table);
+           index && !err; index= dict_table_get_next_index(index))
+      {
+        const btr_search_t *info= index->search_info;
+        if (index->is_btree() && !index->is_corrupted() &&
+            (info->n_hits || info->n_misses || info->n_maintenance ||
+             info->ref_count))
+          err= i_s_ahi_stats_fill_index(thd, index, tables->table);
+      }
+    }
+  }
+
+  dict_sys.unfreeze();
+  DBUG_RETURN(err);
+}
+
+/** Bind the dynamic table
+INFORMATION_SCHEMA.INNODB_ADAPTIVE_HASH_INDEX_STATS
+@return 0 on success */
+static int innodb_ahi_stats_init(void *p)
+{
+  DBUG_ENTER("innodb_ahi_stats_init");
+  ST_SCHEMA_TABLE *schema= static_cast<ST_SCHEMA_TABLE*>(p);
+  schema->fields_info= Show::innodb_ahi_stats_fields_info;
+  schema->fill_table= i_s_ahi_stats_fill;
+  DBUG_RETURN(0);
+}
+
+struct st_maria_plugin	i_s_innodb_adaptive_hash_index_stats =
+{
+	/* the plugin type (a MYSQL_XXX_PLUGIN value) */
+	/* int */
+	MYSQL_INFORMATION_SCHEMA_PLUGIN,
+
+	/* pointer to type-specific plugin descriptor */
+	/* void* */
+	&i_s_info,
+
+	/* plugin name */
+	/* const char* */
+	"INNODB_ADAPTIVE_HASH_INDEX_STATS",
+
+	/* plugin author (for SHOW PLUGINS) */
+	/* const char* */
+	plugin_author,
+
+	/* general descriptive text (for SHOW PLUGINS) */
+	/* const char* */
+	"InnoDB adaptive hash index statistics per index",
+
+	/* the plugin license (PLUGIN_LICENSE_XXX) */
+	/* int */
+	PLUGIN_LICENSE_GPL,
+
+	/* the function to invoke when plugin is loaded */
+	/* int (*)(void*); */
+	innodb_ahi_stats_init,
+
+	/* the function to invoke when plugin is unloaded */
+	/* int (*)(void*); */
+	i_s_common_deinit,
+
+	i_s_version, nullptr, nullptr, PACKAGE_VERSION,
+	MariaDB_PLUGIN_MATURITY_STABLE
+};
+#endif /* BTR_CUR_HASH_ADAPT */
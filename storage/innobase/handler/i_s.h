@@ -61,6 +61,11 @@ extern struct st_maria_plugin	i_s_innodb_sys_foreign_cols;
 extern struct st_maria_plugin	i_s_innodb_sys_tablespaces;
 extern struct st_maria_plugin	i_s_innodb_sys_virtual;
 extern struct st_maria_plugin	i_s_innodb_tablespaces_encryption;
+extern struct st_maria_plugin	i_s_innodb_latch_stats;
+extern struct st_maria_plugin	i_s_innodb_buffer_index_stats;
+#ifdef BTR_CUR_HASH_ADAPT
+extern struct st_maria_plugin	i_s_innodb_adaptive_hash_index_stats;
+#endif /* BTR_CUR_HASH_ADAPT */
 
 /** The latest successfully looked up innodb_fts_aux_table */
 extern table_id_t innodb_ft_aux_table_id;
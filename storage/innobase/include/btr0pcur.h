@@ -456,4 +456,13 @@ btr_pcur_open_on_user_rec(
   return btr_pcur_move_to_next_on_page(cursor) ? DB_SUCCESS : DB_CORRUPTION;
 }
 
+/** Open a cursor at the first page in a tree level.
+The caller must hold an SX-latch on index->lock, and no page latches.
+@param pcur   persistent cursor
+@param level  level to search for (0=leaf)
+@param mtr    mini-transaction
+@param index  index tree */
+dberr_t btr_pcur_open_level(btr_pcur_t *pcur, ulint level, mtr_t *mtr,
+                            dict_index_t *index);
+
 #include "btr0pcur.inl"
@@ -217,6 +217,21 @@ struct btr_search_t{
 				the same prefix should be indexed in the
 				hash index */
 	/*---------------------- @} */
+	/** @{ innodb_adaptive_hash_index_tuning; not protected by any
+	latch either, so these are approximate */
+	ulint	n_hits;		/*!< number of successful hash searches */
+	ulint	n_misses;	/*!< number of failed hash searches */
+	ulint	n_maintenance;	/*!< number of hash index maintenance
+				operations: search info updates, page hash
+				index builds, and updates on insert or delete */
+	ulint	n_tuned_off;	/*!< number of times hashing was disabled
+				because it did not pay off */
+	ulint	tune_cost;	/*!< misses and maintenance operations
+				in the current tuning window */
+	ulint	tune_hits;	/*!< hits in the current tuning window */
+	ulint	tune_off;	/*!< if nonzero, hashing is disabled for
+				the index for this many more searches */
+	/** @} */
 #ifdef UNIV_SEARCH_PERF_STAT
 	ulint	n_hash_succ;	/*!< number of successful hash searches thus
 				far */
@@ -281,7 +296,7 @@ struct btr_search_sys_t
     {
       mem_heap_free(heap);
       heap= nullptr;
-      ut_free(table.array);
+      table.free();
     }
 
     void free()
@@ -392,6 +407,19 @@ pattern */
 the hash index */
 #define BTR_SEARCH_ON_HASH_LIMIT	3
 
+/** Number of misses and maintenance operations after which
+innodb_adaptive_hash_index_tuning checks if the hash index of an index
+paid off */
+#define BTR_SEARCH_TUNE_WINDOW		8192
+
+/** Hashing is disabled for an index if there were less hits than this
+in a tuning window */
+#define BTR_SEARCH_TUNE_MIN_HITS	(BTR_SEARCH_TUNE_WINDOW / 2)
+
+/** Number of searches after which hashing is tried again for an index
+for which innodb_adaptive_hash_index_tuning disabled it */
+#define BTR_SEARCH_TUNE_OFF		65536
+
 /** We do this many searches before trying to keep the search latch
 over calls from MySQL. If we notice someone waiting for the latch, we
 again set this much timeout. This is to reduce contention. */
@@ -68,6 +68,12 @@ btr_search_info_update(
 	btr_search_t*	info;
 	info = btr_search_get_info(index);
 
+	if (ulint off = info->tune_off) {
+		/* innodb_adaptive_hash_index_tuning disabled hashing */
+		info->tune_off = btr_search_tuning ? off - 1 : 0;
+		return;
+	}
+
 	info->hash_analysis++;
 
 	if (info->hash_analysis < BTR_SEARCH_HASH_ANALYSIS) {
@@ -43,6 +43,10 @@ extern char	btr_search_enabled;
 
 /** Number of adaptive hash index partition. */
 extern ulong	btr_ahi_parts;
+
+/** innodb_adaptive_hash_index_tuning: whether the adaptive hash index
+is disabled for indexes where it does not pay off */
+extern my_bool	btr_search_tuning;
 #endif /* BTR_CUR_HASH_ADAPT */
 
 /** The size of a reference to data stored on a different page.
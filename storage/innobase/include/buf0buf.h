@@ -581,6 +581,10 @@ class buf_page_t
 					and bytes allocated for recv_sys.pages,
 					the field is protected by
 					recv_sys_t::mutex. */
+  /** buf_index_stats slot; assigned when the page is added to
+  buf_pool.page_hash, and modified while holding an exclusive latch
+  or a read-fix on the page */
+  uint32_t stats_slot;
   buf_page_t() : id_{0}
   {
     static_assert(NOT_USED == 0, "compatibility");
@@ -597,7 +601,7 @@ class buf_page_t
     in_page_hash(b.in_page_hash), in_free_list(b.in_free_list),
 #endif /* UNIV_DEBUG */
     list(b.list), LRU(b.LRU), old(b.old), freed_page_clock(b.freed_page_clock),
-    access_time(b.access_time)
+    access_time(b.access_time), stats_slot(b.stats_slot)
   {
     lock.init();
   }
@@ -741,6 +745,12 @@ class buf_page_t
   @return whether a page write was initiated and buf_pool.mutex released */
   bool flush(fil_space_t *space);
 
+  /** Prepare and submit the write of a page that flush() write-fixed.
+  @param space       tablespace
+  @param lsn         FIL_PAGE_LSN
+  @param s           state() before the page was write-fixed */
+  void submit_write(fil_space_t *space, lsn_t lsn, uint32_t s);
+
   /** Notify that a page in a temporary tablespace has been modified. */
   void set_temp_modified()
   {
@@ -1157,6 +1167,10 @@ class buf_pool_t
     ut_new_pfx_t mem_pfx;
     /** array of buffer control blocks */
     buf_block_t *blocks;
+#ifdef HAVE_LIBNUMA
+    /** NUMA node that mem is bound to, or -1 if innodb_numa_bind=OFF */
+    int numa_node;
+#endif /* HAVE_LIBNUMA */
 
     /** Map of first page frame address to chunks[] */
     using map= std::map<const void*, chunk_t*, std::less<const void*>,
@@ -1345,6 +1359,15 @@ class buf_pool_t
   inline buf_block_t *block_from_ahi(const byte *ptr) const;
 #endif /* BTR_CUR_HASH_ADAPT */
 
+#ifdef HAVE_LIBNUMA
+  /** Determine the NUMA node that a page frame was bound to.
+  The caller must hold mutex and ensure that !resize_in_progress().
+  @param bpage  block descriptor
+  @return the NUMA node of bpage->frame
+  @retval -1 if the memory was not bound (innodb_numa_bind=OFF) */
+  int numa_node(const buf_page_t &bpage) const;
+#endif /* HAVE_LIBNUMA */
+
   /**
   @return the smallest oldest_modification lsn for any page
   @retval empty_lsn if all modified persistent pages have been flushed */
@@ -1512,13 +1535,23 @@ class buf_pool_t
     Atomic_relaxed<ulint> n_cells;
     /** the hash table, with pad(n_cells) elements, aligned to L1 cache size */
     hash_chain *array;
+    /** size of the array allocation, in bytes */
+    size_t size;
 
     /** Create the hash table.
     @param n  the lower bound of n_cells */
     void create(ulint n);
 
     /** Free the hash table. */
-    void free() { aligned_free(array); array= nullptr; }
+    void free()
+    {
+      if (array)
+      {
+        latch_stats.remove(array);
+        my_large_free(array, size);
+      }
+      array= nullptr;
+    }
 
     /** @return the index of an array element */
     ulint calc_hash(ulint fold) const { return calc_hash(fold, n_cells); }
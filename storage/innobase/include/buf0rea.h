@@ -52,6 +52,19 @@ void buf_read_page_background(fil_space_t *space, const page_id_t page_id,
                               ulint zip_size)
   MY_ATTRIBUTE((nonnull));
 
+/** Read a run of consecutive pages asynchronously for buffer pool load.
+Pages that already are in buf_pool are skipped, and the rest are submitted
+in as few IORequest::READ_BATCH as possible.
+@param space     tablespace; the caller keeps holding its reference
+@param first     first page to read
+@param end       end of the run, at most buf_pool_t::READ_AHEAD_PAGES
+                 pages after first
+@param zip_size  ROW_FORMAT=COMPRESSED page size, or 0
+@return number of pages that were submitted for reading */
+ulint buf_read_pages_background(fil_space_t *space, const page_id_t first,
+                                const page_id_t end, ulint zip_size)
+  MY_ATTRIBUTE((nonnull));
+
 /** Applies a random read-ahead in buf_pool if there are at least a threshold
 value of accessed pages from the random read-ahead area. Does not read any
 page, not even the one at the position (space, offset), if the read-ahead
@@ -86,6 +99,11 @@ latches!
 @return number of page read requests issued */
 ulint buf_read_ahead_linear(const page_id_t page_id);
 
+/** Complete an IORequest::READ_BATCH of read-ahead.
+@param request  the completed request
+@param io_error error code from the read, or 0 */
+void buf_read_batch_complete(const IORequest &request, int io_error);
+
 /** Schedule a page for recovery.
 @param space    tablespace
 @param page_id  page identifier
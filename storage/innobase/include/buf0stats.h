@@ -0,0 +1,137 @@
+/*****************************************************************************
+
+Copyright (c) 2026, MariaDB plc
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; version 2 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1335 USA
+
+*****************************************************************************/
+
+/**************************************************//**
+@file include/buf0stats.h
+Per-index buffer pool statistics
+
+Every page in buf_pool.page_hash is attributed to a slot, which is
+identified by the tablespace and the PAGE_INDEX_ID of the page. Pages that
+do not belong to any index (or that have not been read yet) are attributed
+to the slot of index_id 0 of their tablespace. The counters of a slot are
+updated when a page enters or leaves buf_pool, is read, written, or found
+by the adaptive hash index, so that reading them does not need to look at
+the buffer pool at all.
+*******************************************************/
+
+#pragma once
+
+#include "buf0types.h"
+#include "dict0types.h"
+#include "srw_lock.h"
+#include "my_counter.h"
+
+class buf_page_t;
+
+/** Per-index buffer pool statistics */
+class buf_index_stats_t
+{
+public:
+  /** number of slots; must be a power of 2 */
+  static constexpr uint32_t N_SLOTS= 16384;
+  /** the slot of pages that could not be attributed to anything */
+  static constexpr uint32_t UNTRACKED= 0;
+
+  /** Counters of one (tablespace, index) */
+  struct alignas(CPU_LEVEL1_DCACHE_LINESIZE) slot
+  {
+    /** whether space_id and index_id are valid */
+    std::atomic<bool> used;
+    /** tablespace identifier */
+    uint32_t space_id;
+    /** index identifier; 0 for pages that do not belong to an index */
+    index_id_t index_id;
+    /** number of pages in buf_pool.page_hash */
+    Atomic_counter<int64_t> resident;
+    /** number of pages read from the data file */
+    Atomic_counter<uint64_t> reads;
+    /** number of pages written to the data file */
+    Atomic_counter<uint64_t> writes;
+    /** number of successful adaptive hash index searches */
+    Atomic_counter<uint64_t> ahi_hits;
+  };
+
+private:
+  /** maximum number of slots that lookup() probes */
+  static constexpr uint32_t MAX_PROBES= 32;
+
+  /** protects the assignment of slot::used */
+  srw_mutex mutex;
+  /** the slots; slots[UNTRACKED] collects the pages of the (tablespace,
+  index) that did not find a free slot */
+  slot slots[N_SLOTS];
+
+  /** Find or assign the slot of an index.
+  @param space_id  tablespace identifier
+  @param index_id  index identifier
+  @return slot number, or UNTRACKED if the table is full */
+  uint32_t lookup(uint32_t space_id, index_id_t index_id);
+
+  /** Move a page to another slot.
+  @param bpage  page in buf_pool.page_hash
+  @param s      the new slot */
+  void move(buf_page_t &bpage, uint32_t s);
+
+public:
+  /** Reset all counters on startup */
+  void create();
+  /** Free the resources on shutdown */
+  void close() { mutex.destroy(); }
+
+  /** Account for a page that was added to buf_pool.page_hash.
+  @param bpage  page whose id() has been assigned */
+  void add(buf_page_t &bpage);
+  /** Account for a copy of a page that was removed from buf_pool.page_hash
+  and is being added back, keeping its slot.
+  @param bpage  copy of the removed page */
+  void readd(const buf_page_t &bpage);
+  /** Account for a page that is being removed from buf_pool.page_hash.
+  @param bpage  page in buf_pool.page_hash */
+  void remove(const buf_page_t &bpage);
+  /** Attribute a page to an index, after PAGE_INDEX_ID was read or written.
+  @param bpage     page in buf_pool.page_hash
+  @param index_id  PAGE_INDEX_ID of the page */
+  void assign(buf_page_t &bpage, index_id_t index_id);
+  /** Attribute a page to no index, when it is being reinitialized.
+  @param bpage     page in buf_pool.page_hash */
+  void reinit(buf_page_t &bpage) { assign(bpage, 0); }
+
+  /** Account for a page that was read from the data file.
+  @param bpage  page in buf_pool.page_hash
+  @param frame  the page as it was read, possibly ROW_FORMAT=COMPRESSED */
+  void read(buf_page_t &bpage, const byte *frame);
+  /** Account for a page that was written to the data file.
+  @param bpage  page in buf_pool.page_hash */
+  void write(const buf_page_t &bpage);
+  /** Account for a successful adaptive hash index search.
+  @param bpage  page in buf_pool.page_hash */
+  void ahi_hit(const buf_page_t &bpage);
+
+  /** Get a slot.
+  @param s  slot number
+  @return the slot if it is in use
+  @retval nullptr if s is not in use */
+  const slot *get(uint32_t s) const
+  {
+    ut_ad(s < N_SLOTS);
+    return slots[s].used.load(std::memory_order_acquire) ? &slots[s] : nullptr;
+  }
+};
+
+/** Per-index buffer pool statistics */
+extern buf_index_stats_t buf_index_stats;
@@ -0,0 +1,150 @@
+/*****************************************************************************
+
+Copyright (c) 2024, MariaDB plc
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; version 2 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1335 USA
+
+*****************************************************************************/
+
+/**************************************************//**
+@file include/buf0tier.h
+Compressed tier of the buffer pool
+
+Clean pages that are evicted from buf_pool are kept in compressed form,
+so that reading them again only costs a decompression instead of an I/O.
+The copies are exactly what is in the data file, and they are discarded
+whenever the page is (re)created or its tablespace is freed.
+*******************************************************/
+
+#pragma once
+
+#include "buf0types.h"
+#include "srw_lock.h"
+#include "ut0lst.h"
+#include <unordered_map>
+
+/** innodb_buffer_pool_compressed_tier_size; 0 disables the tier */
+extern ulonglong srv_buf_pool_tier_size;
+
+/** The compressed tier of the buffer pool */
+class buf_tier_t
+{
+  /** A copy of an evicted page */
+  struct entry
+  {
+    /** how data is stored */
+    enum format : uint8_t
+    {
+      /** uncompressed, waiting in the pending list */
+      PENDING,
+      /** uncompressed, being compressed */
+      RAW,
+      /** LZ4 compressed */
+      LZ4,
+      /** zlib compressed */
+      ZLIB
+    };
+
+    /** the page identifier */
+    page_id_t id;
+    /** sequence number of the insert() */
+    uint64_t seq;
+    /** the page contents */
+    byte *data;
+    /** length of data in bytes */
+    uint32_t len;
+    /** how data is stored */
+    format algo;
+    /** eviction order, least recently inserted first */
+    UT_LIST_NODE_T(entry) lru;
+    /** uncompressed entries waiting for compress() */
+    UT_LIST_NODE_T(entry) queue;
+  };
+
+  /** protects all members except max_size */
+  srw_mutex mutex;
+  /** entries by page_id_t::raw() */
+  std::unordered_map<uint64_t, entry*> map;
+  /** all entries, least recently inserted first */
+  UT_LIST_BASE_NODE_T(entry) lru;
+  /** entries that are waiting for compress() */
+  UT_LIST_BASE_NODE_T(entry) pending;
+  /** last assigned entry::seq */
+  uint64_t seq;
+  /** whether the compression task has been submitted */
+  bool task_submitted;
+  /** memory used by the entries, in bytes */
+  size_t size;
+  /** maximum size; 0 if the tier is disabled */
+  Atomic_relaxed<size_t> max_size;
+
+  /** Remove and free an entry.
+  @param e  entry */
+  void remove(entry *e);
+  /** Evict entries until size fits in the limit */
+  void shrink();
+public:
+  /** number of pages that were found in the tier */
+  size_t n_hits;
+
+  /** Initialise the tier on startup */
+  void create();
+  /** Free the tier on shutdown */
+  void close();
+
+  /** @return whether the tier is enabled */
+  bool enabled() const { return max_size; }
+
+  /** Change the maximum size.
+  @param max  innodb_buffer_pool_compressed_tier_size; 0=disable */
+  void resize(size_t max);
+
+  /** Copy a clean page that is being evicted from buf_pool.
+  The caller must hold buf_pool.mutex and the page_hash latch,
+  so that the page cannot be concurrently read or created.
+  @param id     page identifier
+  @param frame  uncompressed page frame */
+  void insert(const page_id_t id, const byte *frame);
+
+  /** Remove a copy of a page that is being read into buf_pool.
+  @param id     page identifier
+  @param frame  where to decompress the page, or nullptr to discard it
+  @return whether the page was copied to frame */
+  bool take(const page_id_t id, byte *frame);
+
+  /** Discard a copy of a page if it exists.
+  @param id     page identifier */
+  void discard(const page_id_t id)
+  { if (UNIV_UNLIKELY(enabled())) take(id, nullptr); }
+
+  /** Discard all copies of pages of a tablespace.
+  @param space_id  tablespace identifier */
+  void discard_space(uint32_t space_id);
+
+  /** Compress the pending entries; invoked in a tpool task */
+  void compress();
+
+  /** @return number of pages in the tier */
+  size_t pages()
+  {
+    mutex.wr_lock();
+    const size_t n= map.size();
+    mutex.wr_unlock();
+    return n;
+  }
+  /** @return memory used by the tier, in bytes */
+  size_t bytes() const { return size; }
+};
+
+/** The compressed tier of the buffer pool */
+extern buf_tier_t buf_tier;
@@ -0,0 +1,133 @@
+/*****************************************************************************
+
+Copyright (c) 2026, MariaDB plc
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; version 2 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1335 USA
+
+*****************************************************************************/
+
+/**************************************************//**
+@file include/buf0track.h
+Changed page tracking for incremental backups
+
+With innodb_track_changed_pages=ON, the identifiers of the pages that are
+written to the data files are collected in memory and appended to the
+file ib_changed_pages in the redo log directory, before each checkpoint
+is written. An incremental mariabackup reads the file in order to copy
+only the pages that were written after its base backup.
+
+Each record of the file covers the pages that were written since the
+previous record was collected. All numbers are big-endian.
+  start_lsn (8 bytes)      end_lsn of the previous record
+  end_lsn (8 bytes)        log_sys.get_lsn() when the record was collected;
+                           no page of the record was modified after it
+  checkpoint_lsn (8 bytes) the checkpoint that was written after it
+  n (4 bytes)              number of pages
+  n times space_id (4 bytes), page_no (4 bytes), in ascending order;
+                           page_no=FIL_NULL stands for all pages
+  checksum (4 bytes)       CRC-32C of the above
+
+Pages that were written but not recorded before the server was killed
+are found by crash recovery, which adds every page that it parses redo
+log records for. When the file size exceeds
+innodb_track_changed_pages_file_size, it is renamed to ib_changed_pages.1
+and a new file is started.
+*******************************************************/
+
+#pragma once
+
+#include "buf0types.h"
+#include "fil0fil.h"
+#include "log0types.h"
+#include "srw_lock.h"
+#include <vector>
+
+/** Whether changed page tracking is enabled (innodb_track_changed_pages) */
+extern my_bool srv_track_changed_pages;
+/** Size at which ib_changed_pages is rotated */
+extern ulonglong srv_track_changed_pages_file_size;
+
+/** Changed page tracking */
+class buf_track_t
+{
+  /** protects pending and last */
+  srw_mutex mutex;
+  /** pages that were written since the last record */
+  std::vector<uint64_t> pending;
+  /** size of pending after the last removal of duplicates */
+  size_t pending_unique;
+  /** the most recently added page */
+  uint64_t last;
+  /** the file, or -1 */
+  File fd;
+  /** size of the file */
+  my_off_t size;
+  /** end_lsn of the last record */
+  lsn_t start_lsn;
+
+  /** Sort pending and remove the duplicates */
+  void unique();
+  /** Start a new file after renaming the current one.
+  @return whether the new file was created */
+  bool rotate();
+
+public:
+  /** name of the file */
+  static constexpr const char *FILE_NAME= "ib_changed_pages";
+  /** name of the previous file */
+  static constexpr const char *OLD_FILE_NAME= "ib_changed_pages.1";
+
+  /** Initialize on startup */
+  void create();
+  /** Open the file after the checkpoint has been recovered */
+  void open();
+  /** Close the file on shutdown */
+  void close();
+
+  /** Add a page that was written to the data file.
+  @param id  page identifier */
+  void add(page_id_t id)
+  {
+    if (!srv_track_changed_pages)
+      return;
+    mutex.wr_lock();
+    if (last != id.raw())
+    {
+      last= id.raw();
+      pending.push_back(last);
+      if (pending.size() >= 2 * pending_unique + 4096)
+        unique();
+    }
+    mutex.wr_unlock();
+  }
+  /** Add all pages of a tablespace, which were written bypassing the
+  buffer pool.
+  @param space_id  tablespace identifier */
+  void add_space(uint32_t space_id) { add(page_id_t{space_id, FIL_NULL}); }
+
+  /** Append a record before a checkpoint is written.
+  @param checkpoint_lsn  the checkpoint that is going to be written */
+  void checkpoint(lsn_t checkpoint_lsn);
+
+  /** Read the pages that were written after a backup.
+  @param from_lsn  the end LSN of the base backup
+  @param to_lsn    the checkpoint LSN at the start of the new backup
+  @param pages     the pages that may have been written after from_lsn,
+                   in ascending order; page_no=FIL_NULL for all pages
+  @return whether the files cover all page writes between the LSN */
+  static bool read(lsn_t from_lsn, lsn_t to_lsn,
+                   std::vector<page_id_t> &pages);
+};
+
+/** Changed page tracking */
+extern buf_track_t buf_track;
@@ -2412,6 +2412,15 @@ struct dict_table_t {
 
   /** Mutex protecting autoinc and freed_indexes. */
   srw_spin_mutex autoinc_mutex;
+
+  /** Mutex protecting n_shared_scans and shared_scan_pos */
+  srw_spin_mutex shared_scan_mutex;
+  /** Number of full table scans that are taking part in shared scans
+  (innodb_shared_scan_min_size) */
+  ulint n_shared_scans;
+  /** The position most recently reached by a shared scan, in the
+  format of handler::ref, or nullptr */
+  byte *shared_scan_pos;
 private:
 #ifdef UNIV_DEBUG
   typedef srw_lock_debug lock_latch_type;
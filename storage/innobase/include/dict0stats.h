@@ -132,10 +132,14 @@ dberr_t
 dict_stats_update(
 /*==============*/
 	dict_table_t*		table,	/*!< in/out: table */
-	dict_stats_upd_option_t	stats_upd_option);
+	dict_stats_upd_option_t	stats_upd_option,
 					/*!< in: whether to (re) calc
 					the stats or to fetch them from
 					the persistent storage */
+	ulonglong		deadline = 0);
+					/*!< in: microsecond_interval_timer()
+					after which to stop sampling leaf
+					pages, or 0 for no limit */
 
 /** Execute DELETE FROM mysql.innodb_table_stats
 @param database_name  database name
@@ -33,6 +33,9 @@ Created Apr 26, 2012 Vasil Dimov
 extern mysql_pfs_key_t	recalc_pool_mutex_key;
 #endif /* HAVE_PSI_INTERFACE */
 
+/** Maximum value of innodb_stats_auto_recalc_threads */
+#define DICT_STATS_MAX_THREADS	64
+
 /** Delete a table from the auto recalc pool, and ensure that
 no statistics are being updated on it. */
 void dict_stats_recalc_pool_del(table_id_t id, bool have_mdl_exclusive);
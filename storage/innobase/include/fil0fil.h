@@ -909,10 +909,10 @@ struct fil_space_t final
     freed_ranges.add_range(range);
   }
 
-  /** Clear the freed range in temporary tablespace
+  /** Clear the freed range in temporary or undo tablespace
   which are in shrinking ranges.
   @param threshold  to be truncated value*/
-  inline void clear_freed_ranges(uint32_t threshold);
+  void clear_freed_ranges(uint32_t threshold);
 
   /** Set the tablespace size in pages */
   void set_sizes(uint32_t s)
@@ -1026,6 +1026,9 @@ struct fil_node_t final
   unsigned punch_hole:2;
   /** whether this file could use atomic write */
   unsigned atomic_write:1;
+  /** whether atomic_write requires page writes to be submitted
+  with RWF_ATOMIC (tpool::aio_opcode::AIO_PWRITE_ATOMIC) */
+  unsigned untorn_write:1;
   /** whether the file actually is a raw device or disk partition */
   unsigned is_raw_disk:1;
   /** whether the tablespace discovery is being deferred during crash
@@ -562,6 +562,12 @@ void fsp_system_tablespace_truncate(bool shutdown);
 /** Truncate the temporary tablespace */
 void fsp_shrink_temp_space();
 
+/** Discard the unused extents at the end of an undo tablespace,
+while the tablespace remains in use.
+@param space   undo tablespace
+@return whether the tablespace was shrunk */
+bool fsp_shrink_undo_space(fil_space_t *space);
+
 #ifndef UNIV_DEBUG
 # define fsp_init_file_page(space, block, mtr) fsp_init_file_page(block, mtr)
 #endif
@@ -551,8 +551,11 @@ FTS Query sort result, returned by fts_query() on fts_ranking_t::rank. */
 void
 fts_query_sort_result_on_rank(
 /*==========================*/
-	fts_result_t*	result);		/*!< out: result instance
+	fts_result_t*	result,			/*!< out: result instance
 						to sort.*/
+	ulint		limit = ULINT_UNDEFINED);/*!< in: number of
+						documents of the highest
+						rank to keep */
 
 /******************************************************************//**
 FTS Query free result, returned by fts_query(). */
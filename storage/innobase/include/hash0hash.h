@@ -171,20 +171,28 @@ struct hash_table_t
   ulint n_cells;
   /** the hash array */
   hash_cell_t *array;
+  /** size of the array allocation, in bytes */
+  size_t size;
 
   /** Create the hash table.
   @param n  the lower bound of n_cells */
   void create(ulint n)
   {
     n_cells= ut_find_prime(n);
-    array= static_cast<hash_cell_t*>(ut_zalloc_nokey(n_cells * sizeof *array));
+    size= n_cells * sizeof *array;
+    array= reinterpret_cast<hash_cell_t*>(my_large_malloc(&size, MYF(0)));
   }
 
   /** Clear the hash table. */
   void clear() { memset(array, 0, n_cells * sizeof *array); }
 
   /** Free the hash table. */
-  void free() { ut_free(array); array= nullptr; }
+  void free()
+  {
+    if (array)
+      my_large_free(array, size);
+    array= nullptr;
+  }
 
   ulint calc_hash(ulint fold) const { return ut_hash_ulint(fold, n_cells); }
 };
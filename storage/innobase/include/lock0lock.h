@@ -43,6 +43,8 @@ class ReadView;
 
 /** The value of innodb_deadlock_detect */
 extern my_bool innodb_deadlock_detect;
+/** The value of innodb_deadlock_detect_delay, in milliseconds */
+extern uint innodb_deadlock_detect_delay;
 /** The value of innodb_deadlock_report */
 extern ulong innodb_deadlock_report;
 
@@ -670,6 +672,8 @@ class lock_sys_t
     in any hash chain, lock_t::is_waiting() entries must not precede
     granted locks */
     hash_cell_t *array;
+    /** size of the array allocation, in bytes */
+    size_t size;
 
     /** Create the hash table.
     @param n  the lower bound of n_cells */
@@ -680,7 +684,15 @@ class lock_sys_t
     void resize(ulint n);
 
     /** Free the hash table. */
-    void free() { aligned_free(array); array= nullptr; }
+    void free()
+    {
+      if (array)
+      {
+        latch_stats.remove(array);
+        my_large_free(array, size);
+      }
+      array= nullptr;
+    }
 
     /** @return the index of an array element */
     inline ulint calc_hash(ulint fold) const;
@@ -183,8 +183,6 @@ struct log_t
   /** The log sequence number of the last change of durable InnoDB files;
   protected by lock_lsn() or lsn_lock or latch.wr_lock() */
   std::atomic<lsn_t> lsn;
-  /** the first guaranteed-durable log sequence number */
-  std::atomic<lsn_t> flushed_to_disk_lsn;
 public:
   /** number of append_prepare_wait(); protected by lock_lsn() or lsn_lock */
   size_t waits;
@@ -192,6 +190,14 @@ struct log_t
   unsigned buf_size;
   /** log file size in bytes, including the header */
   lsn_t file_size;
+private:
+  /** the first guaranteed-durable log sequence number.
+  This is polled by log_write_up_to() on every durable commit, while
+  the above fields on the same cache line as buf_free are written by
+  every append_prepare(). Keep them apart to avoid false sharing. */
+  alignas(CPU_LEVEL1_DCACHE_LINESIZE)
+  std::atomic<lsn_t> flushed_to_disk_lsn;
+public:
 
 #ifdef LOG_LATCH_DEBUG
   typedef srw_lock_debug log_rwlock;
@@ -326,6 +332,24 @@ struct log_t
   byte *checkpoint_buf;
 	/* @} */
 
+  /** Redo log admission throttling; updated by log_throttle_update() @{ */
+  /** smoothed rate of redo log generation, in bytes per second */
+  Atomic_relaxed<lsn_t> generation_rate;
+  /** smoothed rate of advancing last_checkpoint_lsn, in bytes per second */
+  Atomic_relaxed<lsn_t> checkpoint_rate;
+  /** predicted number of seconds until the checkpoint age reaches
+  max_checkpoint_age and sync flushing starts,
+  or -1 if the checkpoint is keeping up with the redo log generation */
+  Atomic_relaxed<int64_t> time_to_sync_flush;
+  /** checkpoint age above which log_free_check() delays its caller,
+  or 0 if it does not */
+  Atomic_relaxed<lsn_t> throttle_age;
+  /** max_checkpoint_age - throttle_age, at least 1 */
+  Atomic_relaxed<lsn_t> throttle_span;
+  /** number of log_free_check() calls that were delayed */
+  Atomic_counter<size_t> throttle_waits;
+  /* @} */
+
 private:
   /** A lock when the spin-only lock_lsn() is not being used */
   log_lsn_lock lsn_lock;
@@ -572,5 +596,9 @@ NOTE that this function may only be called while not holding
 any synchronization objects except dict_sys.latch. */
 void log_free_check();
 
+/** Update the redo log generation and checkpoint rates and decide whether
+log_free_check() must delay its callers. Invoked once per second. */
+void log_throttle_update();
+
 /** Release the latches that protect log resizing. */
 void log_resize_release();
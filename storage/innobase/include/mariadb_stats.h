@@ -116,6 +116,17 @@ inline void mariadb_increment_pages_read_time(ulonglong start_time)
   stats->pages_read_time+= (end_time - start_time);
 }
 
+/*
+  Call this only if start_time != 0; see lock_wait()
+*/
+
+inline void mariadb_increment_lock_wait_time(ha_handler_stats *stats,
+                                             ulonglong start_time)
+{
+  DBUG_ASSERT(start_time);
+  stats->lock_wait_time+= mariadb_measure() - start_time;
+}
+
 
 /*
   Helper class to set mariadb_stats temporarly for one call in handler.cc
@@ -90,8 +90,11 @@ struct mtr_t {
 
   /** Commit a mini-transaction that is shrinking a tablespace.
   @param space   tablespace that is being shrunk
-  @param size    new size in pages */
-  ATTRIBUTE_COLD void commit_shrink(fil_space_t &space, uint32_t size);
+  @param size    new size in pages
+  @param reinit  false if only the unused end of an undo tablespace
+                 is being discarded, without reinitializing it */
+  ATTRIBUTE_COLD void commit_shrink(fil_space_t &space, uint32_t size,
+                                    bool reinit= true);
 
   /** Commit a mini-transaction that is deleting or renaming a file.
   @param space           tablespace that is being renamed or deleted
@@ -190,6 +190,11 @@ class IORequest
     READ_MAYBE_PARTIAL= READ_SYNC | 4,
     /** Read for doublewrite buffer recovery */
     DBLWR_RECOVER= READ_SYNC | 8,
+    /** Asynchronous read-ahead of a page */
+    READ_AHEAD= READ_ASYNC | 64,
+    /** Asynchronous read of consecutive pages for read-ahead;
+    slot points to buf_read_batch */
+    READ_BATCH= READ_AHEAD | 32,
     /** Synchronous write */
     WRITE_SYNC= 16,
     /** Asynchronous write */
@@ -218,6 +223,7 @@ class IORequest
   bool is_write() const { return (type & WRITE_SYNC) != 0; }
   bool is_async() const { return (type & (READ_SYNC ^ READ_ASYNC)) != 0; }
   bool is_doublewritten() const { return (type & 4) != 0; }
+  bool is_read_ahead() const { return (type & READ_AHEAD) == READ_AHEAD; }
 
   /** Create a write request for the doublewrite buffer. */
   IORequest doublewritten() const
@@ -1027,6 +1033,11 @@ size_t os_aio_pending_reads_approx();
 /** @return number of pending writes */
 size_t os_aio_pending_writes();
 
+/** Set the maximum number of concurrently executing read completion
+callbacks, which also apply redo log records during crash recovery.
+@param n  maximum number of callbacks */
+void os_aio_set_read_concurrency(uint n);
+
 /** Wait until there are no pending asynchronous writes.
 @param declare  whether the wait will be declared in tpool */
 void os_aio_wait_until_no_pending_writes(bool declare);
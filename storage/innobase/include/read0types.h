@@ -31,6 +31,8 @@ Created 2/16/1997 Heikki Tuuri
 #include "srw_lock.h"
 #include <algorithm>
 
+struct row_vers_cache_t;
+
 /**
   Read view lists the trx ids of those transactions for which a consistent read
   should not see the modifications to the database.
@@ -182,13 +184,27 @@ class ReadView: public ReadViewBase
   */
   trx_id_t m_creator_trx_id;
 
+  /**
+    Old versions of records that were built for this view, or nullptr.
+    Used exclusively by the read view owner thread.
+  */
+  row_vers_cache_t *m_vers_cache;
+
+  /** Free m_vers_cache. */
+  void free_vers_cache();
+
 public:
   ReadView()
   {
     memset(reinterpret_cast<void*>(this), 0, sizeof *this);
     m_mutex.init();
   }
-  ~ReadView() { m_mutex.destroy(); }
+  ~ReadView()
+  {
+    if (m_vers_cache)
+      free_vers_cache();
+    m_mutex.destroy();
+  }
 
 
   /**
@@ -209,7 +225,12 @@ class ReadView: public ReadViewBase
     View becomes not visible to purge thread. Intended to be called by the
     ReadView owner thread.
   */
-  void close() { m_open.store(false, std::memory_order_relaxed); }
+  void close()
+  {
+    m_open.store(false, std::memory_order_relaxed);
+    if (m_vers_cache)
+      free_vers_cache();
+  }
 
 
   /** Returns true if view is open. */
@@ -251,6 +272,26 @@ class ReadView: public ReadViewBase
   bool changes_visible(trx_id_t id) const
   { return id == m_creator_trx_id || ReadViewBase::changes_visible(id); }
 
+
+  /**
+    @return old versions of records that were built for this view
+    @retval nullptr if none have been cached
+    Intended to be called by the ReadView owner thread.
+  */
+  row_vers_cache_t *vers_cache() const { return m_vers_cache; }
+
+
+  /**
+    Attaches a cache of old versions, which will be freed by close().
+    Intended to be called by the ReadView owner thread.
+  */
+  void set_vers_cache(row_vers_cache_t *cache)
+  {
+    ut_ad(is_open());
+    ut_ad(!m_vers_cache);
+    m_vers_cache= cache;
+  }
+
   /**
     A wrapper around ReadViewBase::append().
     Intended to be called by the purge coordinator task.
@@ -217,6 +217,18 @@ row_log_apply(
 	ut_stage_alter_t*	stage)
 	MY_ATTRIBUTE((warn_unused_result));
 
+/** Apply the online logs of completed non-unique secondary indexes
+concurrently, one thread pool task per index, for as long as that keeps
+reducing the amount of log that remains to be applied.
+@param trx        transaction (for checking if the operation was interrupted)
+@param indexes    indexes that are being created
+@param n_indexes  number of indexes
+@param err_index  index of the failed index in indexes[], on error
+@return DB_SUCCESS, or error code on failure */
+dberr_t row_log_apply_parallel(const trx_t *trx, dict_index_t **indexes,
+                               ulint n_indexes, ulint *err_index)
+  MY_ATTRIBUTE((nonnull, warn_unused_result));
+
 /** Get the n_core_fields of online log for the index
 @param	 index	index whose n_core_fields of log to be accessed
 @return number of n_core_fields */
@@ -446,13 +446,29 @@ class row_merge_bulk_t
   ut_new_pfx_t m_crypt_pfx;
   /** Block for encryption */
   row_merge_block_t *m_crypt_block= nullptr;
+  /** Whether only the entries of non-unique secondary indexes are
+  buffered, to be inserted into the non-empty indexes in sorted order
+  instead of being loaded by BtrBulk */
+  const bool m_non_empty;
 public:
   /** Constructor.
   Create all merge files, merge buffer for all the table indexes
   expect fts indexes.
   Create a merge block which is used to write IO operation
-  @param table  table which undergoes bulk insert operation */
-  row_merge_bulk_t(dict_table_t *table);
+  @param table      table which undergoes bulk insert operation
+  @param non_empty  whether the table may be non-empty, and only
+                    the entries of non_empty_buffered() indexes
+                    will be buffered */
+  row_merge_bulk_t(dict_table_t *table, bool non_empty= false);
+
+  /** @return whether a bulk insert into a non-empty table buffers
+  the entries of an index
+  @param index  index of the table */
+  static bool non_empty_buffered(const dict_index_t &index)
+  {
+    return index.is_btree() && !index.is_clust() && !index.is_unique() &&
+      index.online_status == ONLINE_INDEX_COMPLETE;
+  }
 
   /** Destructor.
   Remove all merge files, merge buffer for all table indexes. */
@@ -185,6 +185,13 @@ row_create_prebuilt(
 					the MySQL format */
 /** Free a prebuilt struct for a TABLE handle. */
 void row_prebuilt_free(row_prebuilt_t *prebuilt);
+/** Set the number of rows that a scan may prefetch to fetch_cache
+while holding the page latch.
+@param prebuilt  prebuilt struct
+@param n_rows    number of rows; clamped to
+[MYSQL_FETCH_CACHE_SIZE, MYSQL_FETCH_CACHE_MAX] */
+void row_prebuilt_set_fetch_cache_size(row_prebuilt_t *prebuilt,
+				       ulint n_rows);
 /*********************************************************************//**
 Updates the transaction pointers in query graphs stored in the prebuilt
 struct. */
@@ -441,6 +448,12 @@ struct mysql_row_templ_t {
 };
 
 #define MYSQL_FETCH_CACHE_SIZE		8
+/* Maximum number of rows in fetch_cache, when the SQL layer has
+granted a larger read buffer with HA_EXTRA_CACHE */
+#define MYSQL_FETCH_CACHE_MAX		64
+/* A long scan keeps doubling the number of rows in fetch_cache,
+until the rows would take more than this many bytes */
+#define MYSQL_FETCH_CACHE_GROW_BYTES	(128 * 1024)
 /* After fetching this many rows, we start caching them in fetch_cache */
 #define MYSQL_FETCH_CACHE_THRESHOLD	4
 
@@ -616,7 +629,7 @@ struct row_prebuilt_t {
 	ulint		n_rows_fetched;	/*!< number of rows fetched after
 					positioning the current cursor */
 	ulint		fetch_direction;/*!< ROW_SEL_NEXT or ROW_SEL_PREV */
-	byte*		fetch_cache[MYSQL_FETCH_CACHE_SIZE];
+	byte*		fetch_cache[MYSQL_FETCH_CACHE_MAX];
 					/*!< a cache for fetched rows if we
 					fetch many rows from the same cursor:
 					it saves CPU time to fetch them in a
@@ -634,6 +647,9 @@ struct row_prebuilt_t {
 					fetched row in fetch_cache */
 	ulint		n_fetch_cached;	/*!< number of not yet fetched rows
 					in fetch_cache */
+	ulint		fetch_cache_size;/*!< number of rows that are
+					fetched to fetch_cache in one batch,
+					at most MYSQL_FETCH_CACHE_MAX */
 	mem_heap_t*	blob_heap;	/*!< in SELECTS BLOB fields are copied
 					to this heap */
 	mem_heap_t*	old_vers_heap;	/*!< memory heap where a previous
@@ -37,6 +37,12 @@ Created 2/6/1997 Heikki Tuuri
 
 // Forward declaration
 class ReadView;
+struct row_vers_cache_t;
+
+/** Free the cache of old versions that
+row_vers_build_for_consistent_read() built for a read view.
+@param cache  ReadView::vers_cache() */
+void row_vers_cache_free(row_vers_cache_t *cache);
 
 /** Determine if an active transaction has inserted or modified a secondary
 index record.
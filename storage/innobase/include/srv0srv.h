@@ -179,6 +179,8 @@ use simulated aio.
 Currently we support native aio on windows and linux */
 extern my_bool	srv_use_native_aio;
 extern my_bool	srv_numa_interleave;
+/** innodb_numa_bind: whether to bind buffer pool chunks to NUMA nodes */
+extern my_bool	srv_numa_bind;
 
 /* Use atomic writes i.e disable doublewrite buffer */
 extern my_bool srv_use_atomic_writes;
@@ -209,6 +211,10 @@ extern uint	srv_n_fil_crypt_threads_started;
 /** Enable or Disable Truncate of UNDO tablespace. */
 extern my_bool	srv_undo_log_truncate;
 
+/** innodb_undo_log_shrink: whether to discard the unused end
+of UNDO tablespaces while purge is running */
+extern my_bool	srv_undo_log_shrink;
+
 /** Default size of UNDO tablespace (10MiB for innodb_page_size=16k) */
 constexpr uint32_t SRV_UNDO_TABLESPACE_SIZE_IN_PAGES= (10U << 20) /
   UNIV_PAGE_SIZE_DEF;
@@ -249,6 +255,20 @@ extern my_bool	srv_random_read_ahead;
 extern ulong	srv_read_ahead_threshold;
 extern uint	srv_n_read_io_threads;
 extern uint	srv_n_write_io_threads;
+/** innodb_read_ahead_io_pct */
+extern uint	srv_read_ahead_io_pct;
+/** innodb_flush_io_pct */
+extern uint	srv_flush_io_pct;
+/** innodb_page_cleaner_threads */
+extern uint	srv_n_page_cleaner_threads;
+/** innodb_recovery_apply_threads */
+extern uint	srv_n_recovery_apply_threads;
+/** innodb_import_threads */
+extern uint	srv_import_threads;
+/** innodb_partition_read_ahead */
+extern uint	srv_partition_read_ahead;
+/** innodb_shared_scan_min_size */
+extern ulonglong	srv_shared_scan_min_size;
 
 /* Number of IO operations per second the server can do */
 extern ulong    srv_io_capacity;
@@ -270,6 +290,7 @@ extern double	srv_max_buf_pool_modified_pct;
 extern double	srv_max_dirty_pages_pct_lwm;
 
 extern double	srv_adaptive_flushing_lwm;
+extern double	srv_log_throttle_lwm;
 extern ulong	srv_flushing_avg_loops;
 
 extern ulong	srv_force_recovery;
@@ -286,6 +307,10 @@ extern unsigned long long	srv_stats_transient_sample_pages;
 extern my_bool			srv_stats_persistent;
 extern unsigned long long	srv_stats_persistent_sample_pages;
 extern my_bool			srv_stats_auto_recalc;
+/** innodb_stats_auto_recalc_threads */
+extern uint			srv_stats_auto_recalc_threads;
+/** innodb_stats_auto_recalc_time_budget, in milliseconds */
+extern uint			srv_stats_auto_recalc_time_budget;
 extern my_bool			srv_stats_include_delete_marked;
 extern unsigned long long	srv_stats_modified_counter;
 extern my_bool			srv_stats_sample_traditional;
@@ -295,6 +320,7 @@ extern ulong	srv_checksum_algorithm;
 extern my_bool	srv_force_primary_key;
 
 extern my_bool	innodb_alter_copy_bulk;
+extern my_bool	innodb_bulk_insert_non_empty;
 extern ulong	srv_max_purge_lag;
 extern ulong	srv_max_purge_lag_delay;
 
@@ -589,8 +615,16 @@ struct export_var_t{
 #endif /* UNIV_DEBUG */
 	/** buf_pool.stat.n_page_gets (a sharded counter) */
 	ulint innodb_buffer_pool_read_requests;
+	/** buf_tier.bytes() */
+	ulint innodb_buffer_pool_tier_bytes;
+	/** buf_tier.pages() */
+	ulint innodb_buffer_pool_tier_pages;
 	ulint innodb_checkpoint_age;
 	ulint innodb_checkpoint_max_age;
+	/** log_sys.checkpoint_rate */
+	lsn_t innodb_checkpoint_rate;
+	/** log_sys.time_to_sync_flush */
+	int64_t innodb_checkpoint_time_to_sync_flush;
 	ulint innodb_data_pending_reads;	/*!< Pending reads */
 	ulint innodb_data_pending_writes;	/*!< Pending writes */
 	ulint innodb_data_read;			/*!< Data bytes read */
@@ -603,6 +637,8 @@ struct export_var_t{
 	lsn_t innodb_lsn_current;
 	lsn_t innodb_lsn_flushed;
 	lsn_t innodb_lsn_last_checkpoint;
+	/** log_sys.generation_rate */
+	lsn_t innodb_log_generation_rate;
 	trx_id_t innodb_max_trx_id;
 #ifdef BTR_CUR_HASH_ADAPT
 	ulint innodb_mem_adaptive_hash;
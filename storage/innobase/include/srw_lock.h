@@ -19,6 +19,7 @@ this program; if not, write to the Free Software Foundation, Inc.,
 #pragma once
 #include "univ.i"
 #include "rw_lock.h"
+#include "my_atomic_wrapper.h"
 
 #if defined __linux__
 /* futex(2): FUTEX_WAIT_PRIVATE, FUTEX_WAKE_PRIVATE */
@@ -623,3 +624,117 @@ class srw_lock_debug : private srw_lock
   bool have_any() const noexcept;
 };
 #endif
+
+/** Contention statistics of the latches, by latch class.
+Only the waiting code paths of the latches are instrumented; an
+uncontended acquisition remains a single atomic operation. */
+class latch_stats_t
+{
+public:
+  /** Latch classes, in INFORMATION_SCHEMA.INNODB_LATCH_STATS order */
+  enum latch_class
+  {
+    /** lock_sys.latch */
+    LOCK_SYS= 0,
+    /** the lock_sys_t::hash_latch of lock_sys.rec_hash and friends */
+    LOCK_SYS_HASH,
+    /** log_sys.latch */
+    LOG_SYS,
+    /** dict_sys.latch */
+    DICT_SYS,
+    /** the page_hash_latch of buf_pool.page_hash */
+    BUF_POOL_PAGE_HASH,
+    /** any other latch, such as an index tree or buffer page latch */
+    OTHER,
+    N_CLASSES
+  };
+
+  /** Statistics of a latch class */
+  struct alignas(CPU_LEVEL1_DCACHE_LINESIZE) counters
+  {
+    /** number of acquisitions that had to wait */
+    Atomic_counter<ulonglong> waits;
+    /** number of spin loop rounds */
+    Atomic_counter<ulonglong> spin_rounds;
+    /** number of times a thread was suspended */
+    Atomic_counter<ulonglong> sleeps;
+    /** total waiting time, in nanoseconds */
+    Atomic_counter<ulonglong> wait_time;
+  };
+
+  /** innodb_latch_stats_enabled: whether statistics are being collected */
+  my_bool enabled;
+
+private:
+  /** Maximum number of registered memory ranges */
+  static constexpr size_t N_RANGES= 16;
+  /** A memory range that contains latches of a class */
+  struct range
+  {
+    Atomic_relaxed<const char*> begin;
+    Atomic_relaxed<const char*> end;
+    Atomic_relaxed<latch_class> latch;
+  };
+  /** the registered memory ranges; vacant if begin==nullptr */
+  range ranges[N_RANGES];
+  /** the statistics */
+  counters stats[N_CLASSES];
+
+  /** @return the class of a latch */
+  latch_class classify(const void *latch) const noexcept;
+public:
+  /** Register the memory range of latches of a class.
+  @param latch  the latch class
+  @param begin  start of the object or array that contains latches
+  @param size   size of the object or array, in bytes */
+  void add(latch_class latch, const void *begin, size_t size) noexcept;
+  /** Unregister a memory range that was registered by add().
+  @param begin  start of the range */
+  void remove(const void *begin) noexcept;
+
+  /** Account for a contended acquisition of a latch.
+  @param latch   the latch
+  @param spins   number of spin loop rounds
+  @param sleeps  number of times the thread was suspended
+  @param ns      waiting time, in nanoseconds */
+  void record(const void *latch, uint32_t spins, uint32_t sleeps,
+              ulonglong ns) noexcept;
+
+  /** Reset all statistics */
+  void reset() noexcept;
+
+  /** @return the statistics of a latch class */
+  const counters &get(latch_class latch) const noexcept
+  { return stats[latch]; }
+  /** @return the name of a latch class */
+  static const char *name(latch_class latch) noexcept;
+};
+
+/** Latch contention statistics */
+extern latch_stats_t latch_stats;
+
+/** Accounting of a contended latch acquisition, to be allocated when
+entering a waiting code path */
+class latch_wait
+{
+  /** the latch being waited for */
+  const void *const latch;
+  /** my_interval_timer() at the start, or 0 if the statistics are off */
+  const ulonglong start;
+  /** number of spin loop rounds */
+  uint32_t spins= 0;
+  /** number of times the thread was suspended */
+  uint32_t sleeps= 0;
+public:
+  latch_wait(const void *latch) noexcept :
+    latch(latch), start(latch_stats.enabled ? my_interval_timer() : 0) {}
+  ~latch_wait() noexcept
+  {
+    if (UNIV_UNLIKELY(start != 0))
+      latch_stats.record(latch, spins, sleeps, my_interval_timer() - start);
+  }
+  /** Note a spin loop round */
+  void spin() noexcept { spins++; }
+  /** Note that the thread is about to be suspended */
+  void sleep() noexcept { sleeps++; }
+};
@@ -30,6 +30,7 @@ Created 3/26/1996 Heikki Tuuri
 #include "que0types.h"
 #include "srw_lock.h"
 
+#include <bitset>
 #include <queue>
 #include <unordered_map>
 
@@ -192,6 +193,12 @@ class purge_sys_t
 	que_t*		query;		/*!< The query graph which will do the
 					parallelized purge operation */
 
+  /** number of purge tasks that were used for the latest batch */
+  size_t n_active_tasks{0};
+  /** number of times that the undo log records of a table were
+  distributed among multiple purge tasks in a batch */
+  size_t n_split_tables{0};
+
 	/** Iterator to the undo log records of committed transactions */
 	struct iterator
 	{
@@ -281,6 +288,12 @@ class purge_sys_t
     uint32_t last;
   } truncate_undo_space;
 
+  /** innodb_undo_log_shrink=ON state: the undo tablespaces, relative from
+  srv_undo_space_id_start, that may have a free tail to discard, because
+  undo segments were freed in them since fsp_shrink_undo_space() last
+  found nothing to do; only modified by purge_coordinator_callback() */
+  std::bitset<TRX_SYS_MAX_UNDO_SPACES> shrink_undo_space;
+
   /** Create the instance */
   void create();
 
@@ -78,6 +78,13 @@ trx_undo_rec_get_row_ref(
 	mem_heap_t*	heap)	/*!< in: memory heap from which the memory
 				needed is allocated */
 	MY_ATTRIBUTE((nonnull));
+/** Skip a row reference from an undo log record.
+@param ptr    part of an undo log record, at the start of the row reference
+@param index  clustered index
+@return pointer to remaining part of undo record */
+const byte *trx_undo_rec_skip_row_ref(const byte *ptr,
+                                      const dict_index_t *index)
+  MY_ATTRIBUTE((nonnull, warn_unused_result));
 /**********************************************************************//**
 Reads from an undo log update record the system field values of the old
 version.
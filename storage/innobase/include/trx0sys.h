@@ -885,6 +885,14 @@ class trx_sys_t
   alignas(CPU_LEVEL1_DCACHE_LINESIZE)
   std::atomic<trx_id_t> m_rw_trx_hash_version;
 
+  /**
+    Incremented after every change of rw_trx_hash that may affect an MVCC
+    snapshot: register_rw(), assign_new_trx_no() and deregister_rw().
+
+    @sa get_rw_trx_hash_changes()
+  */
+  std::atomic<uint64_t> m_rw_trx_hash_changes;
+
 
   bool m_initialised;
 
@@ -894,6 +902,22 @@ class trx_sys_t
   /** List of all transactions. */
   thread_safe_trx_ilist_t trx_list;
 
+  /**
+    The most recent MVCC snapshot, which ReadViewBase::snapshot() may copy
+    instead of iterating rw_trx_hash, as long as get_rw_trx_hash_changes()
+    matches version.
+  */
+  struct snapshot_cache_t
+  {
+    /** protects version and view */
+    srw_spin_lock_low latch;
+    /** get_rw_trx_hash_changes() when view was created, or ~0 */
+    uint64_t version;
+    /** the snapshot */
+    ReadViewBase view;
+  };
+  alignas(CPU_LEVEL1_DCACHE_LINESIZE) snapshot_cache_t snapshot_cache;
+
   /** Temporary rollback segments */
   trx_rseg_t temp_rsegs[TRX_SYS_N_RSEGS];
 
@@ -1075,6 +1099,17 @@ class trx_sys_t
   {
     m_max_trx_id= value;
     m_rw_trx_hash_version.store(value, std::memory_order_relaxed);
+    m_rw_trx_hash_changes.fetch_add(1, std::memory_order_release);
+  }
+
+
+  /**
+    @return the number of changes of rw_trx_hash that may have affected
+    an MVCC snapshot; must issue ACQUIRE memory barrier
+  */
+  uint64_t get_rw_trx_hash_changes() const
+  {
+    return m_rw_trx_hash_changes.load(std::memory_order_acquire);
   }
 
 
@@ -1149,6 +1184,7 @@ class trx_sys_t
   void deregister_rw(trx_t *trx)
   {
     rw_trx_hash.erase(trx);
+    m_rw_trx_hash_changes.fetch_add(1, std::memory_order_release);
   }
 
 
@@ -1275,6 +1311,7 @@ class trx_sys_t
   void refresh_rw_trx_hash_version()
   {
     m_rw_trx_hash_version.fetch_add(1, std::memory_order_release);
+    m_rw_trx_hash_changes.fetch_add(1, std::memory_order_release);
   }
 
 
@@ -361,6 +361,20 @@ struct trx_lock_t
   void set_wsrep_victim() { was_chosen_as_deadlock_victim= true; }
 #endif /* defined(UNIV_DEBUG) || !defined(DBUG_OFF) */
 
+  /** The record lock that was most recently granted in lock_rec_lock(),
+  for looking up locks that are already held without latching the lock
+  queue. Set by the thread that is executing the transaction, and reset
+  when the lock is removed from trx_locks. */
+  Atomic_relaxed<const lock_t*> rec_last;
+
+  /** Reset rec_last if it points to a record lock that is being removed.
+  @param lock  record lock that is being removed from trx_locks */
+  void forget_rec(const lock_t *lock)
+  {
+    if (rec_last == lock)
+      rec_last= nullptr;
+  }
+
   /** Next available rec_pool[] entry */
   byte rec_cached;
   /** Next available table_pool[] entry */
@@ -425,6 +439,10 @@ class trx_mod_table_time_t
   /** First modification of a system versioned column
   (NONE= no versioning, BULK= the table was dropped) */
   undo_no_t first_versioned= NONE;
+  /** trx_t::undo_no when bulk_store started to buffer the entries of
+  non-unique secondary indexes for an insert into a non-empty table
+  (NONE= not buffering) */
+  undo_no_t bulk_non_empty= NONE;
 #ifdef UNIV_DEBUG
   /** Whether the modified table is a FTS auxiliary table */
   bool fts_aux_table= false;
@@ -482,6 +500,30 @@ class trx_mod_table_time_t
   /** @return whether an insert is covered by TRX_UNDO_EMPTY record */
   bool is_bulk_insert() const { return first & BULK; }
 
+  /** Start buffering the entries of non-unique secondary indexes
+  for an insert into a possibly non-empty table.
+  @param table  table that was locked exclusively
+  @param rows   number of modified rows so far */
+  void start_bulk_insert_non_empty(dict_table_t *table, undo_no_t rows)
+  {
+    ut_ad(!bulk_store);
+    ut_ad(!is_bulk_insert());
+    bulk_non_empty= rows;
+    bulk_store= new row_merge_bulk_t(table, true);
+  }
+
+  /** @return whether secondary index entries are being buffered
+  for an insert into a non-empty table */
+  bool is_bulk_insert_non_empty() const { return bulk_non_empty != NONE; }
+
+  /** @return the first undo record whose secondary index entries
+  are being buffered for an insert into a non-empty table */
+  undo_no_t get_bulk_non_empty() const
+  {
+    ut_ad(is_bulk_insert_non_empty());
+    return bulk_non_empty;
+  }
+
   /** Invoked after partial rollback
   @param limit	number of surviving modified rows (trx_t::undo_no)
   @return	whether this should be erased from trx_t::mod_tables */
@@ -525,7 +567,7 @@ class trx_mod_table_time_t
   /** @return whether the buffer storage exist */
   bool bulk_buffer_exist() const
   {
-    return bulk_store && is_bulk_insert();
+    return bulk_store && (is_bulk_insert() || is_bulk_insert_non_empty());
   }
 
   /** Free bulk insert operation */
@@ -533,6 +575,7 @@ class trx_mod_table_time_t
   {
     delete bulk_store;
     bulk_store= nullptr;
+    bulk_non_empty= NONE;
   }
 };
 
@@ -794,6 +837,9 @@ struct trx_t : ilist_node<>
 
   /** whether an insert into an empty table is active */
   unsigned bulk_insert:1;
+  /** whether an insert into a non-empty table is buffering the entries
+  of non-unique secondary indexes (innodb_bulk_insert_non_empty) */
+  unsigned bulk_insert_non_empty:1;
 	/*------------------------------*/
 	/* MySQL has a transaction coordinator to coordinate two phase
 	commit between multiple storage engines and the binary log. When
@@ -1158,13 +1204,15 @@ struct trx_t : ilist_node<>
   if the table has bulk buffer exist in the transaction */
   trx_mod_table_time_t *check_bulk_buffer(dict_table_t *table)
   {
-    if (UNIV_LIKELY(!bulk_insert))
+    if (UNIV_LIKELY(!bulk_insert && !bulk_insert_non_empty))
       return nullptr;
-    ut_ad(table->skip_alter_undo || !check_unique_secondary);
-    ut_ad(table->skip_alter_undo || !check_foreigns);
     auto it= mod_tables.find(table);
     if (it == mod_tables.end() || !it->second.bulk_buffer_exist())
       return nullptr;
+    ut_ad(table->skip_alter_undo || it->second.is_bulk_insert_non_empty() ||
+          !check_unique_secondary);
+    ut_ad(table->skip_alter_undo || it->second.is_bulk_insert_non_empty() ||
+          !check_foreigns);
     return &it->second;
   }
 
@@ -1173,9 +1221,16 @@ struct trx_t : ilist_node<>
   @return DB_SUCCESS or error code */
   dberr_t bulk_insert_apply()
   {
-    return UNIV_UNLIKELY(bulk_insert) ? bulk_insert_apply_low(): DB_SUCCESS;
+    return UNIV_UNLIKELY(bulk_insert || bulk_insert_non_empty)
+      ? bulk_insert_apply_low() : DB_SUCCESS;
   }
 
+  /** Before a partial rollback, insert the buffered secondary index
+  entries of those rows of an insert into a non-empty table that
+  will not be rolled back.
+  @param savept  the savepoint to roll back to */
+  void bulk_insert_non_empty_rollback(trx_savept_t *savept);
+
 private:
   /** Apply the buffered bulk inserts. */
   dberr_t bulk_insert_apply_low();
@@ -29,6 +29,7 @@ Created 2012/04/12 by Sunny Bains
 #define ut0counter_h
 
 #include "univ.i"
+#include "my_counter.h"
 #include "my_rdtsc.h"
 
 /** Atomic which occupies whole CPU cache line.
@@ -64,9 +65,10 @@ struct ib_counter_t {
 	@param[in]	index	a reasonably thread-unique identifier */
 	void inc(size_t index) { add(index, 1); }
 
-	/** Add to the counter.
+	/** Add to the counter, using the same per-thread slot as
+	Sharded_counter.
 	@param[in]	n	amount to be added */
-	void add(Type n) { add(size_t(my_pseudo_random()), n); }
+	void add(Type n) { add(size_t(my_counter_shard_index()), n); }
 
 	/** Add to the counter.
 	@param[in]	index	a reasonably thread-unique identifier
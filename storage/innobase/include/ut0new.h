@@ -843,6 +843,7 @@ constexpr const char* const auto_event_names[] =
   "buf0dump",
   "buf0lru",
   "buf0rea",
+  "buf0tier",
   "dict0dict",
   "dict0mem",
   "dict0stats",
@@ -877,6 +878,7 @@ constexpr const char* const auto_event_names[] =
   "row0merge",
   "row0mysql",
   "row0sel",
+  "row0vers",
   "srv0start",
   "trx0i_s",
   "trx0i_s",
@@ -47,6 +47,7 @@ Created 5/7/1996 Heikki Tuuri
 #include "que0que.h"
 #include "scope.h"
 #include "buf0buf.h"
+#include "mariadb_stats.h"
 #include <debug_sync.h>
 #include <mysql/service_thd_mdl.h>
 
@@ -58,6 +59,8 @@ Created 5/7/1996 Heikki Tuuri
 
 /** The value of innodb_deadlock_detect */
 my_bool innodb_deadlock_detect;
+/** The value of innodb_deadlock_detect_delay */
+uint innodb_deadlock_detect_delay;
 /** The value of innodb_deadlock_report */
 ulong innodb_deadlock_report;
 
@@ -99,11 +102,11 @@ struct TableLockGetNode
 void lock_sys_t::hash_table::create(ulint n)
 {
   n_cells= ut_find_prime(n);
-  const size_t size= MY_ALIGN(pad(n_cells) * sizeof *array,
-                              CPU_LEVEL1_DCACHE_LINESIZE);
-  void *v= aligned_malloc(size, CPU_LEVEL1_DCACHE_LINESIZE);
-  memset_aligned<CPU_LEVEL1_DCACHE_LINESIZE>(v, 0, size);
-  array= static_cast<hash_cell_t*>(v);
+  size= MY_ALIGN(pad(n_cells) * sizeof *array, CPU_LEVEL1_DCACHE_LINESIZE);
+  /* The zero-filled mapping is page aligned, and it will be backed by
+  huge pages if possible. */
+  array= reinterpret_cast<hash_cell_t*>(my_large_malloc(&size, MYF(0)));
+  latch_stats.add(latch_stats_t::LOCK_SYS_HASH, array, size);
 }
 
 /** Resize the hash table.
@@ -112,11 +115,10 @@ void lock_sys_t::hash_table::resize(ulint n)
 {
   ut_ad(lock_sys.is_writer());
   ulint new_n_cells= ut_find_prime(n);
-  const size_t size= MY_ALIGN(pad(new_n_cells) * sizeof *array,
-                              CPU_LEVEL1_DCACHE_LINESIZE);
-  void *v= aligned_malloc(size, CPU_LEVEL1_DCACHE_LINESIZE);
-  memset_aligned<CPU_LEVEL1_DCACHE_LINESIZE>(v, 0, size);
-  hash_cell_t *new_array= static_cast<hash_cell_t*>(v);
+  size_t new_size= MY_ALIGN(pad(new_n_cells) * sizeof *array,
+                            CPU_LEVEL1_DCACHE_LINESIZE);
+  hash_cell_t *new_array=
+    reinterpret_cast<hash_cell_t*>(my_large_malloc(&new_size, MYF(0)));
 
   for (auto i= pad(n_cells); i--; )
   {
@@ -151,17 +153,24 @@ void lock_sys_t::hash_table::resize(ulint n)
     }
   }
 
-  aligned_free(array);
+  latch_stats.remove(array);
+  my_large_free(array, size);
   array= new_array;
+  size= new_size;
   n_cells= new_n_cells;
+  latch_stats.add(latch_stats_t::LOCK_SYS_HASH, array, size);
 }
 
 #ifdef SUX_LOCK_GENERIC
 void lock_sys_t::hash_latch::wait()
 {
+  latch_wait w{this};
   pthread_mutex_lock(&lock_sys.hash_mutex);
   while (!write_trylock())
+  {
+    w.sleep();
     pthread_cond_wait(&lock_sys.hash_cond, &lock_sys.hash_mutex);
+  }
   pthread_mutex_unlock(&lock_sys.hash_mutex);
 }
 
@@ -419,6 +428,7 @@ void lock_sys_t::create(ulint n_cells)
   m_initialised= true;
 
   latch.SRW_LOCK_INIT(lock_latch_key);
+  latch_stats.add(latch_stats_t::LOCK_SYS, &latch, sizeof latch);
 #ifdef __aarch64__
   mysql_mutex_init(lock_wait_mutex_key, &wait_mutex, MY_MUTEX_INIT_FAST);
 #else
@@ -505,6 +515,7 @@ void lock_sys_t::close()
   pthread_cond_destroy(&hash_cond);
 #endif
 
+  latch_stats.remove(&latch);
   latch.destroy();
   mysql_mutex_destroy(&wait_mutex);
 
@@ -995,6 +1006,26 @@ lock_rec_get_prev(
 
 /*============= FUNCTIONS FOR ANALYZING RECORD LOCK QUEUE ================*/
 
+/** Check if a granted explicit record lock of a transaction is stronger
+or equal to precise_mode, without looking at the lock bitmap.
+@param lock          record lock
+@param precise_mode  LOCK_S or LOCK_X possibly ORed to LOCK_GAP or
+                     LOCK_REC_NOT_GAP
+@param heap_no       heap number of the record
+@param trx           transaction
+@return whether lock covers the request */
+static inline bool lock_rec_covers(const lock_t *lock, ulint precise_mode,
+                                   ulint heap_no, const trx_t *trx)
+{
+  return lock->trx == trx &&
+    !(lock->type_mode & (LOCK_WAIT | LOCK_INSERT_INTENTION)) &&
+    (!((LOCK_REC_NOT_GAP | LOCK_GAP) & lock->type_mode) ||
+     heap_no == PAGE_HEAP_NO_SUPREMUM ||
+     ((LOCK_REC_NOT_GAP | LOCK_GAP) & precise_mode & lock->type_mode)) &&
+    lock_mode_stronger_or_eq(lock->mode(), static_cast<lock_mode>
+                             (precise_mode & LOCK_MODE_MASK));
+}
+
 /*********************************************************************//**
 Checks if a transaction has a GRANTED explicit lock on rec stronger or equal
 to precise_mode.
@@ -1019,13 +1050,7 @@ lock_rec_has_expl(
 
   for (lock_t *lock= lock_sys_t::get_first(cell, id, heap_no); lock;
        lock= lock_rec_get_next(heap_no, lock))
-    if (lock->trx == trx &&
-	!(lock->type_mode & (LOCK_WAIT | LOCK_INSERT_INTENTION)) &&
-	(!((LOCK_REC_NOT_GAP | LOCK_GAP) & lock->type_mode) ||
-	 heap_no == PAGE_HEAP_NO_SUPREMUM ||
-	 ((LOCK_REC_NOT_GAP | LOCK_GAP) & precise_mode & lock->type_mode)) &&
-	lock_mode_stronger_or_eq(lock->mode(), static_cast<lock_mode>
-				 (precise_mode & LOCK_MODE_MASK)))
+    if (lock_rec_covers(lock, precise_mode, heap_no, trx))
       return lock;
 
   return nullptr;
@@ -1783,6 +1808,26 @@ lock_rec_lock(
          index->table->name.m_name + strlen(index->table->name.m_name) + 1));
   MONITOR_ATOMIC_INC(MONITOR_NUM_RECLOCK_REQ);
   const page_id_t id{block->page.id()};
+
+  /* If the record lock that was most recently granted to us already
+  covers the request, there is nothing to check in the lock queue.
+  Other threads may only modify the bitmap of our granted lock while
+  holding trx->mutex, or while holding an exclusive latch on the page,
+  which our caller has latched. */
+  ut_ad(block->page.lock.have_any());
+  if (const lock_t *lock= trx->lock.rec_last)
+  {
+    trx->mutex_lock();
+    const bool held= lock == trx->lock.rec_last &&
+      lock->un_member.rec_lock.page_id == id &&
+      lock_rec_covers(lock, mode, heap_no, trx) &&
+      lock_rec_get_n_bits(lock) > heap_no &&
+      lock_rec_get_nth_bit(lock, heap_no);
+    trx->mutex_unlock();
+    if (held)
+      return DB_SUCCESS;
+  }
+
   LockGuard g{lock_sys.rec_hash, id};
 
   if (lock_t *lock= lock_sys_t::get_first(g.cell(), id))
@@ -1834,6 +1879,8 @@ lock_rec_lock(
         lock_reuse_for_next_key_lock(held_lock, mode, g.cell(), id,
                                      block->page.frame, heap_no, index, trx);
       }
+      else
+        trx->lock.rec_last= held_lock;
     }
     else if (!impl)
     {
@@ -1846,6 +1893,7 @@ lock_rec_lock(
         lock_rec_set_nth_bit(lock, heap_no);
         err= DB_SUCCESS_LOCKED_REC;
       }
+      trx->lock.rec_last= lock;
     }
     trx->mutex_unlock();
     return err;
@@ -1853,8 +1901,9 @@ lock_rec_lock(
 
   /* Simplified and faster path for the most common cases */
   if (!impl)
-    lock_rec_create_low(nullptr, mode, id, block->page.frame, heap_no, index,
-                        trx, false);
+    trx->lock.rec_last=
+      lock_rec_create_low(nullptr, mode, id, block->page.frame, heap_no, index,
+                          trx, false);
 
   return DB_SUCCESS_LOCKED_REC;
 }
@@ -2102,6 +2151,19 @@ dberr_t lock_wait(que_thr_t *thr)
   const bool no_timeout= innodb_lock_wait_timeout >= 100000000 ||
     ((type_mode & LOCK_TABLE) &&
      wait_lock->un_member.tab_lock.table->id <= DICT_FIELDS_ID);
+  /* With innodb_deadlock_detect_delay, most lock waits on hot rows
+  will end before anyone walks the waits-for graph. A deadlock will be
+  detected by the first participant whose delay expires. */
+  const uint detect_delay= innodb_deadlock_detect_delay;
+  bool detect_pending= detect_delay && innodb_deadlock_detect &&
+    (no_timeout || detect_delay < innodb_lock_wait_timeout * 1000ULL);
+  timespec detect_time;
+  set_timespec_time_nsec(detect_time, (suspend_time.val +
+                                       detect_delay * 1000ULL) * 1000);
+  /* Attribute the wait to the table whose handler call we are in,
+  for ANALYZE and the slow query log */
+  ha_handler_stats *const stats= mariadb_stats;
+  const ulonglong stats_start= stats && stats->active ? mariadb_measure() : 0;
   thd_wait_begin(trx->mysql_thd, (type_mode & LOCK_TABLE)
                  ? THD_WAIT_TABLE_LOCK : THD_WAIT_ROW_LOCK);
 
@@ -2131,7 +2193,8 @@ dberr_t lock_wait(que_thr_t *thr)
       goto abort_wait;
     }
 
-    wait_lock= Deadlock::check_and_resolve(trx, wait_lock);
+    if (!detect_delay)
+      wait_lock= Deadlock::check_and_resolve(trx, wait_lock);
 
     if (wait_lock == reinterpret_cast<lock_t*>(-1))
     {
@@ -2180,7 +2243,20 @@ dberr_t lock_wait(que_thr_t *thr)
 
     DEBUG_SYNC_C("lock_wait_before_suspend");
 
-    if (no_timeout)
+    if (detect_pending)
+    {
+      if (my_cond_timedwait(&trx->lock.cond, &lock_sys.wait_mutex.m_mutex,
+                            &detect_time))
+      {
+        detect_pending= false;
+        if (trx->lock.wait_lock && trx->error_state == DB_SUCCESS &&
+            Deadlock::check_and_resolve(trx, trx->lock.wait_lock) ==
+            reinterpret_cast<lock_t*>(-1))
+          trx->error_state= DB_DEADLOCK;
+      }
+      err= 0;
+    }
+    else if (no_timeout)
     {
       my_cond_wait(&trx->lock.cond, &lock_sys.wait_mutex.m_mutex);
       err= 0;
@@ -2247,6 +2323,8 @@ dberr_t lock_wait(que_thr_t *thr)
       }
     });
   thd_wait_end(trx->mysql_thd);
+  if (stats_start)
+    mariadb_increment_lock_wait_time(stats, stats_start);
 
 #ifdef UNIV_DEBUG
   switch (trx->error_state) {
@@ -2366,6 +2444,7 @@ static void lock_rec_dequeue_from_page(lock_t *in_lock, bool owns_wait_mutex)
 
 	HASH_DELETE(lock_t, hash, &lock_hash, rec_fold, in_lock);
 	UT_LIST_REMOVE(in_lock->trx->lock.trx_locks, in_lock);
+	in_lock->trx->lock.forget_rec(in_lock);
 
 	MONITOR_INC(MONITOR_RECLOCK_REMOVED);
 	MONITOR_DEC(MONITOR_NUM_RECLOCK);
@@ -2431,6 +2510,7 @@ void lock_rec_discard(lock_sys_t::hash_table &lock_hash, lock_t *in_lock)
     ut_d(old_locks=)
     in_lock->index->table->n_rec_locks--;
     UT_LIST_REMOVE(trx->lock.trx_locks, in_lock);
+    trx->lock.forget_rec(in_lock);
   }
   ut_ad(old_locks);
   MONITOR_INC(MONITOR_RECLOCK_REMOVED);
@@ -103,12 +103,19 @@ void log_t::create()
   max_buf_free= 1;
 
   latch.SRW_LOCK_INIT(log_latch_key);
+  latch_stats.add(latch_stats_t::LOG_SYS, &latch, sizeof latch);
   lsn_lock.init();
 
   last_checkpoint_lsn= FIRST_LSN;
   log_capacity= 0;
   max_modified_age_async= 0;
   max_checkpoint_age= 0;
+  generation_rate= 0;
+  checkpoint_rate= 0;
+  time_to_sync_flush= -1;
+  throttle_age= 0;
+  throttle_span= 1;
+  throttle_waits= 0;
   next_checkpoint_lsn= 0;
   checkpoint_pending= false;
 
@@ -1291,6 +1298,24 @@ ATTRIBUTE_COLD static void log_checkpoint_margin()
   }
 }
 
+/** Maximum delay of log_throttle(), in microseconds */
+static constexpr unsigned LOG_THROTTLE_MAX_DELAY= 10000;
+
+/** Delay the caller in proportion to how far the checkpoint age has
+advanced from log_sys.throttle_age towards log_sys.max_checkpoint_age.
+@param throttle_age  log_sys.throttle_age */
+ATTRIBUTE_COLD static void log_throttle(lsn_t throttle_age)
+{
+  const lsn_t age= log_sys.get_lsn() - log_sys.last_checkpoint_lsn;
+  if (age <= throttle_age)
+    return;
+  const lsn_t span= log_sys.throttle_span;
+  const lsn_t excess= std::min(age - throttle_age, span);
+  log_sys.throttle_waits++;
+  std::this_thread::sleep_for(std::chrono::microseconds
+                              (LOG_THROTTLE_MAX_DELAY * excess / span));
+}
+
 /** Wait for a log checkpoint if needed.
 NOTE that this function may only be called while not holding
 any synchronization objects except dict_sys.latch. */
@@ -1302,6 +1327,62 @@ void log_free_check()
     ut_ad(!recv_no_log_write);
     log_checkpoint_margin();
   }
+  else if (const lsn_t throttle_age= log_sys.throttle_age)
+    log_throttle(throttle_age);
+}
+
+/** Update the redo log generation and checkpoint rates and decide whether
+log_free_check() must delay its callers. Invoked once per second. */
+void log_throttle_update()
+{
+  static lsn_t prev_lsn, prev_checkpoint;
+  static ulonglong prev_time;
+
+  log_sys.latch.rd_lock(SRW_LOCK_CALL);
+  const lsn_t lsn= log_sys.get_lsn();
+  const lsn_t checkpoint= log_sys.last_checkpoint_lsn;
+  const lsn_t max_age= log_sys.max_checkpoint_age;
+  log_sys.latch.rd_unlock();
+  const ulonglong now= my_interval_timer();
+
+  if (prev_time && now > prev_time)
+  {
+    const double seconds= double(now - prev_time) / 1e9;
+    /* The checkpoint advances in steps; an exponential moving average
+    over a few seconds smooths them out. */
+    log_sys.generation_rate=
+      (3 * log_sys.generation_rate + lsn_t(double(lsn - prev_lsn) /
+                                           seconds)) / 4;
+    log_sys.checkpoint_rate=
+      (3 * log_sys.checkpoint_rate + lsn_t(double(checkpoint -
+                                                  prev_checkpoint) /
+                                           seconds)) / 4;
+  }
+  prev_time= now;
+  prev_lsn= lsn;
+  prev_checkpoint= checkpoint;
+
+  const lsn_t age= lsn - checkpoint;
+  const lsn_t generation_rate= log_sys.generation_rate;
+  const lsn_t checkpoint_rate= log_sys.checkpoint_rate;
+  int64_t time_to_sync_flush= -1;
+  if (age >= max_age)
+    time_to_sync_flush= 0;
+  else if (generation_rate > checkpoint_rate)
+    time_to_sync_flush=
+      int64_t((max_age - age) / (generation_rate - checkpoint_rate));
+  log_sys.time_to_sync_flush= time_to_sync_flush;
+
+  /* Only delay the writes while the checkpoint is falling behind. Once
+  the page cleaner keeps up, the checkpoint age cannot grow any further. */
+  lsn_t throttle_age= 0;
+  if (srv_log_throttle_lwm > 0.0 && time_to_sync_flush >= 0)
+  {
+    throttle_age= std::max<lsn_t>(lsn_t(srv_log_throttle_lwm *
+                                        double(max_age) / 100), 1);
+    log_sys.throttle_span= std::max<lsn_t>(max_age - throttle_age, 1);
+  }
+  log_sys.throttle_age= throttle_age;
 }
 
 extern void buf_resize_shutdown();
@@ -1519,6 +1600,7 @@ void log_t::close()
   ut_ad(!buf);
   ut_ad(!flush_buf);
 
+  latch_stats.remove(&latch);
   latch.destroy();
   lsn_lock.destroy();
 
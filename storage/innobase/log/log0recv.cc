@@ -50,6 +50,7 @@ Created 9/20/1997 Heikki Tuuri
 #include "trx0rec.h"
 #include "fil0fil.h"
 #include "buf0rea.h"
+#include "buf0track.h"
 #include "srv0srv.h"
 #include "srv0start.h"
 #include "fil0pagecompress.h"
@@ -2715,14 +2716,28 @@ recv_sys_t::parse_mtr_result recv_sys_t::parse(source &l, bool if_exists)
           }
           else if (srv_is_undo_tablespace(space_id))
 	  {
-	    if (page_no != SRV_UNDO_TABLESPACE_SIZE_IN_PAGES)
+            trunc &t=
+              truncated_undo_spaces[space_id - srv_undo_space_id_start];
+	    if (page_no == SRV_UNDO_TABLESPACE_SIZE_IN_PAGES)
+	    {
+              /* The entire undo tablespace will be reinitialized by
+              innodb_undo_log_truncate=ON. Discard old log for all
+	      pages. */
+	      trim({space_id, 0}, start_lsn);
+	      t= { start_lsn, page_no};
+	    }
+	    else if (page_no < SRV_UNDO_TABLESPACE_SIZE_IN_PAGES)
               goto record_corrupted;
-            /* The entire undo tablespace will be reinitialized by
-            innodb_undo_log_truncate=ON. Discard old log for all
-	    pages. */
-	    trim({space_id, 0}, start_lsn);
-	    truncated_undo_spaces[space_id - srv_undo_space_id_start]=
-              { start_lsn, page_no};
+	    else
+	    {
+              /* The unused end of the undo tablespace was discarded
+              by innodb_undo_log_shrink=ON. Discard old log for the
+              pages beyond the end, unless the tablespace was
+              reinitialized earlier. */
+              trim({space_id, page_no}, start_lsn);
+              if (t.pages != SRV_UNDO_TABLESPACE_SIZE_IN_PAGES)
+                t= { start_lsn, page_no};
+	    }
 	  }
 	  else if (space_id != 0) goto record_corrupted;
 	  else
@@ -2864,6 +2879,7 @@ recv_sys_t::parse_mtr_result recv_sys_t::parse(source &l, bool if_exists)
           else if (!deferred_spaces.find(space_id))
             continue;
         }
+        buf_track.add(id);
         if (!mlog_init.will_avoid_read(id, start_lsn))
         {
           if (pages_it == pages.end() || pages_it->first != id)
@@ -3828,6 +3844,24 @@ static void log_sort_flush_list()
   mysql_mutex_unlock(&buf_pool.flush_list_mutex);
 }
 
+/** Allow innodb_recovery_apply_threads read completion callbacks,
+which invoke recv_recover_page(), to run concurrently while in scope */
+struct recv_apply_concurrency
+{
+  const bool raised;
+  recv_apply_concurrency() :
+    raised(srv_n_recovery_apply_threads > srv_n_read_io_threads)
+  {
+    if (raised)
+      os_aio_set_read_concurrency(srv_n_recovery_apply_threads);
+  }
+  ~recv_apply_concurrency()
+  {
+    if (raised)
+      os_aio_set_read_concurrency(srv_n_read_io_threads);
+  }
+};
+
 /** Apply buffered log to persistent data pages.
 @param last_batch     whether it is possible to write more redo log */
 void recv_sys_t::apply(bool last_batch)
@@ -3870,11 +3904,14 @@ void recv_sys_t::apply(bool last_batch)
     if (t.lsn)
     {
       /* The entire undo tablespace will be reinitialized by
-      innodb_undo_log_truncate=ON. Discard old log for all pages.
+      innodb_undo_log_truncate=ON. Discard old log for all pages,
+      or only for the pages that innodb_undo_log_shrink=ON discarded.
       Even though we recv_sys_t::parse() already invoked trim(),
       this will be needed in case recovery consists of multiple batches
       (there was an invocation with !last_batch). */
-      trim({id + srv_undo_space_id_start, 0}, t.lsn);
+      trim({id + srv_undo_space_id_start,
+            t.pages == SRV_UNDO_TABLESPACE_SIZE_IN_PAGES ? 0 : t.pages},
+           t.lsn);
       if (fil_space_t *space = fil_space_get(id + srv_undo_space_id_start))
       {
         ut_ad(UT_LIST_GET_LEN(space->chain) == 1);
@@ -3898,6 +3935,8 @@ void recv_sys_t::apply(bool last_batch)
 
     fil_system.extend_to_recv_size();
 
+    const recv_apply_concurrency concurrency;
+
     fil_space_t *space= nullptr;
     uint32_t space_id= ~0;
     buf_block_t *free_block= nullptr;
@@ -556,8 +556,10 @@ inline void fil_space_t::set_create_lsn(lsn_t lsn)
 
 /** Commit a mini-transaction that is shrinking a tablespace.
 @param space   tablespace that is being shrunk
-@param size    new size in pages */
-void mtr_t::commit_shrink(fil_space_t &space, uint32_t size)
+@param size    new size in pages
+@param reinit  false if only the unused end of an undo tablespace
+               is being discarded, without reinitializing it */
+void mtr_t::commit_shrink(fil_space_t &space, uint32_t size, bool reinit)
 {
   ut_ad(is_active());
   ut_ad(!high_level_read_only);
@@ -584,12 +586,15 @@ void mtr_t::commit_shrink(fil_space_t &space, uint32_t size)
 
   if (space.id == TRX_SYS_SPACE)
     srv_sys_space.set_last_file_size(file->size);
-  else
+  else if (reinit)
     space.set_create_lsn(m_commit_lsn);
 
   mysql_mutex_unlock(&fil_system.mutex);
 
-  space.clear_freed_ranges();
+  if (reinit)
+    space.clear_freed_ranges();
+  else
+    space.clear_freed_ranges(size);
 
   /* Durably write the reduced FSP_SIZE before truncating the data file. */
   log_write_and_flush();
@@ -598,7 +603,10 @@ void mtr_t::commit_shrink(fil_space_t &space, uint32_t size)
   os_file_truncate(file->name, file->handle,
                    os_offset_t{file->size} << srv_page_size_shift, true);
 
-  space.clear_freed_ranges();
+  if (reinit)
+    space.clear_freed_ranges();
+  else
+    space.clear_freed_ranges(size);
 
   const page_id_t high{space.id, size};
   size_t modified= 0;
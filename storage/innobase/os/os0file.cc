@@ -153,8 +153,68 @@ class io_slots
 	}
 };
 
+/* Each class of asynchronous I/O has its own slots, so that it cannot
+run out of slots because of the other classes. Synchronous reads, which
+is how threads normally read pages, never wait for any slot. */
+
+/** Asynchronous reads that are not read-ahead (crash recovery) */
 static io_slots *read_slots;
+/** Read-ahead, buffer pool load and prefetch of sibling pages,
+at most innodb_read_ahead_io_pct of the read slots */
+static io_slots *read_ahead_slots;
+/** Page writes, at most innodb_flush_io_pct of the write slots */
 static io_slots *write_slots;
+/** Doublewrite batches */
+static io_slots *dblwr_slots;
+
+/** Number of doublewrite batches that can be in flight,
+one per buf_dblwr_t::slots[] */
+constexpr int OS_AIO_N_DBLWR_IOS= 2;
+
+/** Number of slots for each class of asynchronous I/O */
+struct os_aio_limits
+{
+  int read, read_ahead, write;
+
+  os_aio_limits(ulint n_reader_threads, ulint n_writer_threads)
+  {
+    const int max_read= int(n_reader_threads *
+                            OS_AIO_N_PENDING_IOS_PER_THREAD);
+    const int max_write= int(n_writer_threads *
+                             OS_AIO_N_PENDING_IOS_PER_THREAD);
+    read_ahead= std::max(1, int(max_read * srv_read_ahead_io_pct / 100));
+    read= std::max(1, max_read - read_ahead);
+    write= std::max(1, int(max_write * srv_flush_io_pct / 100));
+  }
+
+  /** @return the number of events for configure_aio() */
+  int events() const
+  { return read + read_ahead + write + OS_AIO_N_DBLWR_IOS; }
+};
+
+/** @return the slots for an asynchronous I/O request */
+static io_slots *os_aio_slots(const IORequest &type)
+{
+  if (type.is_read())
+    return type.is_read_ahead() ? read_ahead_slots : read_slots;
+  return type.type == IORequest::DBLWR_BATCH ? dblwr_slots : write_slots;
+}
+
+/** Add the statistics of some slots.
+@param slots  I/O slots
+@param stats  statistics to add to */
+static void os_aio_slots_stats(io_slots *slots,
+                               innodb_async_io_stats_t *stats)
+{
+  tpool::group_stats s;
+  slots->task_group().get_stats(&s);
+  stats->pending_ops+= slots->pending_io_count();
+  stats->slot_wait_time_sec+= slots->wait_time().count();
+  stats->completion_stats.tasks_running+= s.tasks_running;
+  stats->completion_stats.queue_size+= s.queue_size;
+  stats->completion_stats.total_tasks_executed+= s.total_tasks_executed;
+  stats->completion_stats.total_tasks_enqueued+= s.total_tasks_enqueued;
+}
 
 /**
   Statistics for asynchronous I/O
@@ -163,11 +223,17 @@ static io_slots *write_slots;
 */
 void innodb_io_slots_stats(tpool::aio_opcode op, innodb_async_io_stats_t *stats)
 {
-   io_slots *slots= op == tpool::aio_opcode::AIO_PREAD? read_slots : write_slots;
-
-   stats->pending_ops = slots->pending_io_count();
-   stats->slot_wait_time_sec= slots->wait_time().count();
-   slots->task_group().get_stats(&stats->completion_stats);
+   *stats= innodb_async_io_stats_t{};
+   if (op == tpool::aio_opcode::AIO_PREAD)
+   {
+     os_aio_slots_stats(read_slots, stats);
+     os_aio_slots_stats(read_ahead_slots, stats);
+   }
+   else
+   {
+     os_aio_slots_stats(write_slots, stats);
+     os_aio_slots_stats(dblwr_slots, stats);
+   }
 }
 
 /** Number of retries for partial I/O's */
@@ -3133,20 +3199,22 @@ static void read_io_callback(void *c)
 {
   tpool::aiocb *cb= static_cast<tpool::aiocb*>(c);
   ut_ad(cb->m_opcode == tpool::aio_opcode::AIO_PREAD);
-  ut_ad(read_slots->contains(cb));
   const IORequest &request= *static_cast<const IORequest*>
     (static_cast<const void*>(cb->m_userdata));
+  io_slots *slots= os_aio_slots(request);
+  ut_ad(slots->contains(cb));
   request.read_complete(cb->m_err);
-  read_slots->release(cb);
+  slots->release(cb);
 }
 
 static void write_io_callback(void *c)
 {
   tpool::aiocb *cb= static_cast<tpool::aiocb*>(c);
-  ut_ad(cb->m_opcode == tpool::aio_opcode::AIO_PWRITE);
-  ut_ad(write_slots->contains(cb));
+  ut_ad(cb->m_opcode != tpool::aio_opcode::AIO_PREAD);
   const IORequest &request= *static_cast<const IORequest*>
     (static_cast<const void*>(cb->m_userdata));
+  io_slots *slots= os_aio_slots(request);
+  ut_ad(slots->contains(cb));
 
   if (UNIV_UNLIKELY(cb->m_err != 0))
     ib::info () << "IO Error: " << cb->m_err
@@ -3156,7 +3224,7 @@ static void write_io_callback(void *c)
                 << cb->m_ret_len;
 
   request.write_complete(cb->m_err);
-  write_slots->release(cb);
+  slots->release(cb);
 }
 
 #ifdef LINUX_NATIVE_AIO
@@ -3287,11 +3355,8 @@ static bool is_linux_native_aio_supported()
 
 int os_aio_init()
 {
-  int max_write_events= int(srv_n_write_io_threads *
-                            OS_AIO_N_PENDING_IOS_PER_THREAD);
-  int max_read_events= int(srv_n_read_io_threads *
-                           OS_AIO_N_PENDING_IOS_PER_THREAD);
-  int max_events= max_read_events + max_write_events;
+  const os_aio_limits limits{srv_n_read_io_threads, srv_n_write_io_threads};
+  int max_events= limits.events();
   int ret;
 #if LINUX_NATIVE_AIO
   if (srv_use_native_aio && !is_linux_native_aio_supported())
@@ -3324,8 +3389,10 @@ int os_aio_init()
 
   if (!ret)
   {
-    read_slots= new io_slots(max_read_events, srv_n_read_io_threads);
-    write_slots= new io_slots(max_write_events, srv_n_write_io_threads);
+    read_slots= new io_slots(limits.read, srv_n_read_io_threads);
+    read_ahead_slots= new io_slots(limits.read_ahead, srv_n_read_io_threads);
+    write_slots= new io_slots(limits.write, srv_n_write_io_threads);
+    dblwr_slots= new io_slots(OS_AIO_N_DBLWR_IOS, OS_AIO_N_DBLWR_IOS);
   }
   return ret;
 }
@@ -3344,6 +3411,9 @@ and user and system wide max-aio limitation, this can fail.
 Otherwise, we just resize the slots, and allow for
 more concurrent threads via thread_group setting.
 
+This is also invoked when innodb_read_ahead_io_pct or
+innodb_flush_io_pct are changed.
+
 @param[in] n_reader_threads - max number of concurrently
   executing read callbacks
 @param[in] n_writer_thread - max number of cuncurrently
@@ -3354,15 +3424,17 @@ int os_aio_resize(ulint n_reader_threads, ulint n_writer_threads)
 {
   /* Lock the slots, and wait until all current IOs finish.*/
   std::unique_lock<std::mutex> lk_read(read_slots->mutex()),
-    lk_write(write_slots->mutex());
+    lk_read_ahead(read_ahead_slots->mutex()),
+    lk_write(write_slots->mutex()), lk_dblwr(dblwr_slots->mutex());
 
   read_slots->wait(lk_read);
+  read_ahead_slots->wait(lk_read_ahead);
   write_slots->wait(lk_write);
+  dblwr_slots->wait(lk_dblwr);
 
   /* Now, all IOs have finished and no new ones can start, due to locks. */
-  int max_read_events= int(n_reader_threads * OS_AIO_N_PENDING_IOS_PER_THREAD);
-  int max_write_events= int(n_writer_threads * OS_AIO_N_PENDING_IOS_PER_THREAD);
-  int events= max_read_events + max_write_events;
+  const os_aio_limits limits{n_reader_threads, n_writer_threads};
+  int events= limits.events();
 
   /** Do the Linux AIO dance (this will try to create a new
   io context with changed max_events ,etc*/
@@ -3374,13 +3446,17 @@ int os_aio_resize(ulint n_reader_threads, ulint n_writer_threads)
     /** Do the best effort. We can't change the parallel io number,
     but we still can adjust the number of concurrent completion handlers.*/
     read_slots->task_group().set_max_tasks(static_cast<int>(n_reader_threads));
+    read_ahead_slots->task_group().
+      set_max_tasks(static_cast<int>(n_reader_threads));
     write_slots->task_group().set_max_tasks(static_cast<int>(n_writer_threads));
   }
   else
   {
     /* Allocation succeeded, resize the slots*/
-    read_slots->resize(max_read_events, static_cast<int>(n_reader_threads));
-    write_slots->resize(max_write_events, static_cast<int>(n_writer_threads));
+    read_slots->resize(limits.read, static_cast<int>(n_reader_threads));
+    read_ahead_slots->resize(limits.read_ahead,
+                             static_cast<int>(n_reader_threads));
+    write_slots->resize(limits.write, static_cast<int>(n_writer_threads));
   }
   return ret;
 }
@@ -3388,21 +3464,27 @@ int os_aio_resize(ulint n_reader_threads, ulint n_writer_threads)
 void os_aio_free()
 {
   delete read_slots;
+  delete read_ahead_slots;
   delete write_slots;
+  delete dblwr_slots;
   read_slots= nullptr;
+  read_ahead_slots= nullptr;
   write_slots= nullptr;
+  dblwr_slots= nullptr;
   srv_thread_pool->disable_aio();
 }
 
 /** Wait until there are no pending asynchronous writes. */
 static void os_aio_wait_until_no_pending_writes_low(bool declare)
 {
-  const bool notify_wait= declare && write_slots->pending_io_count();
+  const bool notify_wait= declare &&
+    (write_slots->pending_io_count() || dblwr_slots->pending_io_count());
 
   if (notify_wait)
     tpool::tpool_wait_begin();
 
    write_slots->wait();
+   dblwr_slots->wait();
 
    if (notify_wait)
      tpool::tpool_wait_end();
@@ -3419,33 +3501,44 @@ void os_aio_wait_until_no_pending_writes(bool declare)
 /** @return number of pending reads */
 size_t os_aio_pending_reads()
 {
-  std::lock_guard<std::mutex> lock(read_slots->mutex());
-  return read_slots->pending_io_count();
+  std::lock_guard<std::mutex> lock(read_slots->mutex()),
+    lock_ahead(read_ahead_slots->mutex());
+  return read_slots->pending_io_count() +
+    read_ahead_slots->pending_io_count();
 }
 
 /** @return approximate number of pending reads */
 size_t os_aio_pending_reads_approx()
 {
-  return read_slots->pending_io_count();
+  return read_slots->pending_io_count() +
+    read_ahead_slots->pending_io_count();
+}
+
+void os_aio_set_read_concurrency(uint n)
+{
+  read_slots->task_group().set_max_tasks(n);
+  read_ahead_slots->task_group().set_max_tasks(n);
 }
 
 /** @return number of pending writes */
 size_t os_aio_pending_writes()
 {
-  std::lock_guard<std::mutex> lock(write_slots->mutex());
-  return write_slots->pending_io_count();
+  std::lock_guard<std::mutex> lock(write_slots->mutex()),
+    lock_dblwr(dblwr_slots->mutex());
+  return write_slots->pending_io_count() + dblwr_slots->pending_io_count();
 }
 
 /** Wait until all pending asynchronous reads have completed.
 @param declare  whether the wait will be declared in tpool */
 void os_aio_wait_until_no_pending_reads(bool declare)
 {
-  const bool notify_wait= declare && read_slots->pending_io_count();
+  const bool notify_wait= declare && os_aio_pending_reads_approx();
 
   if (notify_wait)
     tpool::tpool_wait_begin();
 
   read_slots->wait();
+  read_ahead_slots->wait();
 
   if (notify_wait)
     tpool::tpool_wait_end();
@@ -3522,16 +3615,19 @@ dberr_t os_aio(const IORequest &type, void *buf, os_offset_t offset, size_t n)
 	tpool::callback_func callback;
 	tpool::aio_opcode opcode;
 
+	slots = os_aio_slots(type);
+
 	if (type.is_read()) {
 		++os_n_file_reads;
-		slots = read_slots;
 		callback = read_io_callback;
 		opcode = tpool::aio_opcode::AIO_PREAD;
 	} else {
 		++os_n_file_writes;
-		slots = write_slots;
 		callback = write_io_callback;
-		opcode = tpool::aio_opcode::AIO_PWRITE;
+		opcode = type.node->untorn_write
+			&& n == type.node->space->physical_size()
+			? tpool::aio_opcode::AIO_PWRITE_ATOMIC
+			: tpool::aio_opcode::AIO_PWRITE;
 	}
 
 	compile_time_assert(sizeof(IORequest) <= tpool::MAX_AIO_USERDATA_LEN);
@@ -3845,6 +3941,15 @@ void fil_node_t::find_metadata(IF_WIN(,bool create)) noexcept
   atomic_write= srv_use_atomic_writes &&
     IF_WIN(srv_page_size == block_size,
            my_test_if_atomic_write(file, space->physical_size()));
+#ifdef __linux__
+  /* page_compressed writes are not of the page size, unless the
+  storage is thinly provisioned */
+  untorn_write= srv_use_atomic_writes && !atomic_write &&
+    (!space->is_compressed() || punch_hole == 2) &&
+    my_test_if_untorn_write(file, space->physical_size());
+  if (untorn_write)
+    atomic_write= true;
+#endif
 }
 
 /** Read the first page of a data file.
@@ -1713,6 +1713,74 @@ page_zip_fields_decode(
 	return(index);
 }
 
+/** The dummy index that page_zip_fields_decode() last returned in a
+thread. All pages of an index, or all leaf pages of it, carry the same
+index information, so a thread that decompresses many pages of an
+index only has to create the dummy index once. */
+class page_zip_fields_cache
+{
+	/** the dummy index, or nullptr */
+	dict_index_t*	m_index = nullptr;
+	/** copy of the index information, allocated from m_index->heap */
+	const byte*	m_buf;
+	/** length of m_buf */
+	ulint		m_len;
+	/** the trx_id_col of a leaf page, or ULINT_UNDEFINED */
+	ulint		m_trx_id_col;
+	/** whether m_index was decoded for a leaf page */
+	bool		m_leaf;
+	/** whether m_index was decoded for a spatial index */
+	bool		m_spatial;
+public:
+	~page_zip_fields_cache() { page_zip_fields_free(m_index); }
+
+	/** Look up or decode the index information.
+	@param buf         index information
+	@param end         end of buf
+	@param trx_id_col  NULL for non-leaf pages; for leaf pages, pointer
+	to where to store the position of the trx_id column
+	@param is_spatial  whether the index is spatial
+	@return dummy index describing the page, valid until the next call
+	@retval NULL on error */
+	dict_index_t* get(const byte* buf, const byte* end,
+			  ulint* trx_id_col, bool is_spatial)
+	{
+		const ulint len = ulint(end - buf);
+
+		if (m_index && len == m_len && !trx_id_col == !m_leaf
+		    && is_spatial == m_spatial && !memcmp(buf, m_buf, len)) {
+			if (trx_id_col) {
+				*trx_id_col = m_trx_id_col;
+			}
+			return m_index;
+		}
+
+		ulint		col = ULINT_UNDEFINED;
+		dict_index_t*	index = page_zip_fields_decode(
+			buf, end, trx_id_col ? &col : NULL, is_spatial);
+		if (!index) {
+			return NULL;
+		}
+
+		page_zip_fields_free(m_index);
+		m_index = index;
+		m_buf = static_cast<const byte*>(
+			mem_heap_dup(index->heap, buf, len));
+		m_len = len;
+		m_trx_id_col = col;
+		m_leaf = trx_id_col != NULL;
+		m_spatial = is_spatial;
+
+		if (trx_id_col) {
+			*trx_id_col = col;
+		}
+		return index;
+	}
+};
+
+/** The dummy index of the latest page_zip_decompress_low() */
+static thread_local page_zip_fields_cache page_zip_fields;
+
 /**********************************************************************//**
 Populate the sparse page directory from the dense directory.
 @return TRUE on success, FALSE on failure */
@@ -3087,7 +3155,7 @@ page_zip_decompress_low(
 		goto zlib_error;
 	}
 
-	index = page_zip_fields_decode(
+	index = page_zip_fields.get(
 		page + PAGE_ZIP_START, d_stream.next_out,
 		page_is_leaf(page) ? &trx_id_col : NULL,
 		fil_page_get_type(page) == FIL_PAGE_RTREE);
@@ -3141,7 +3209,6 @@ page_zip_decompress_low(
 		if (UNIV_UNLIKELY(!page_zip_set_extra_bytes(page_zip,
 							    page, 0))) {
 err_exit:
-			page_zip_fields_free(index);
 			mem_heap_free(heap);
 			return(FALSE);
 		}
@@ -3164,7 +3231,6 @@ page_zip_decompress_low(
 	ut_a(page_is_comp(page));
 	MEM_CHECK_DEFINED(page, srv_page_size);
 
-	page_zip_fields_free(index);
 	mem_heap_free(heap);
 
 	return(TRUE);
@@ -29,6 +29,7 @@ Created 2/16/1997 Heikki Tuuri
 #include "srv0srv.h"
 #include "trx0sys.h"
 #include "trx0purge.h"
+#include "row0vers.h"
 
 /*
 -------------------------------------------------------------------------------
@@ -172,22 +173,46 @@ For details see: row_undo_mod_sec_is_unsafe() and row_purge_poss_sec()
 */
 inline void ReadViewBase::snapshot(trx_t *trx)
 {
-  trx_sys.snapshot_ids(trx, &m_ids, &m_low_limit_id, &m_low_limit_no);
-  if (m_ids.empty())
+  trx_sys_t::snapshot_cache_t &cache= trx_sys.snapshot_cache;
+  const uint64_t changes= trx_sys.get_rw_trx_hash_changes();
+
+  /* If no transaction was registered, committed or deregistered since
+  the cached snapshot was taken, it is equivalent to a new one. */
+  cache.latch.rd_lock();
+  if (cache.version == changes)
   {
-    m_up_limit_id= m_low_limit_id;
+    *this= cache.view;
+    cache.latch.rd_unlock();
     return;
   }
+  cache.latch.rd_unlock();
+
+  trx_sys.snapshot_ids(trx, &m_ids, &m_low_limit_id, &m_low_limit_no);
+  if (m_ids.empty())
+    m_up_limit_id= m_low_limit_id;
+  else
+  {
+    std::sort(m_ids.begin(), m_ids.end());
+    m_up_limit_id= m_ids.front();
+    ut_ad(m_up_limit_id <= m_low_limit_id);
 
-  std::sort(m_ids.begin(), m_ids.end());
-  m_up_limit_id= m_ids.front();
-  ut_ad(m_up_limit_id <= m_low_limit_id);
+    if (m_low_limit_no == m_low_limit_id &&
+        m_low_limit_id == m_up_limit_id + m_ids.size())
+    {
+      m_ids.clear();
+      m_low_limit_id= m_low_limit_no= m_up_limit_id;
+    }
+  }
 
-  if (m_low_limit_no == m_low_limit_id &&
-      m_low_limit_id == m_up_limit_id + m_ids.size())
+  /* Only publish the snapshot if rw_trx_hash did not change while
+  it was being iterated. */
+  std::atomic_thread_fence(std::memory_order_acquire);
+  if (changes == trx_sys.get_rw_trx_hash_changes() &&
+      cache.latch.wr_lock_try())
   {
-    m_ids.clear();
-    m_low_limit_id= m_low_limit_no= m_up_limit_id;
+    cache.view= *this;
+    cache.version= changes;
+    cache.latch.wr_unlock();
   }
 }
 
@@ -248,6 +273,14 @@ void ReadView::open(trx_t *trx)
 }
 
 
+/** Free m_vers_cache. */
+void ReadView::free_vers_cache()
+{
+  row_vers_cache_free(m_vers_cache);
+  m_vers_cache= nullptr;
+}
+
+
 /**
   Clones the oldest view and stores it in view.
 
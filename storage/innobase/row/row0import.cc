@@ -30,6 +30,8 @@ Created 2012-02-08 by Sunny Bains.
 # include "btr0sea.h"
 #endif
 #include "buf0flu.h"
+#include "buf0tier.h"
+#include "buf0track.h"
 #include "que0que.h"
 #include "dict0boot.h"
 #include "dict0load.h"
@@ -294,6 +296,8 @@ struct fil_iterator_t {
 	fil_space_crypt_t *crypt_data;		/*!< Crypt data (if encrypted) */
 	byte*           crypt_io_buffer;        /*!< IO buffer when encrypted */
 	byte*           crypt_tmp_buffer;       /*!< Temporary buffer for crypt use */
+	uint32_t	actual_space_id;	/*!< FIL_PAGE_SPACE_ID of
+						page 0 */
 };
 
 /** Use the page cursor to iterate over records in a block. */
@@ -467,6 +471,19 @@ class AbstractCallback
 		m_xdes_page_no(UINT32_MAX),
 		m_space_flags(UINT32_MAX) UNIV_NOTHROW { }
 
+	/** Create a callback for another part of the same file.
+	@param c callback that has been initialized by init() */
+	AbstractCallback(const AbstractCallback& c)
+		:
+		m_zip_size(c.m_zip_size),
+		m_file(c.m_file),
+		m_filepath(c.m_filepath),
+		m_trx(c.m_trx),
+		m_space(c.m_space),
+		m_xdes(),
+		m_xdes_page_no(UINT32_MAX),
+		m_space_flags(c.m_space_flags) UNIV_NOTHROW { }
+
 	/** Free any extent descriptor instance */
 	virtual ~AbstractCallback()
 	{
@@ -703,12 +720,10 @@ AbstractCallback::init(
 }
 
 /**
-TODO: This can be made parallel trivially by chunking up the file
-and creating a callback per thread.. Main benefit will be to use
-multiple CPUs for checksums and compressed tables. We have to do
-compressed tables block by block right now. Secondly we need to
-decompress/compress and copy too much of data. These are
-CPU intensive.
+TODO: We have to do compressed tables block by block right now.
+Secondly we need to decompress/compress and copy too much of data.
+These are CPU intensive. PageConverter::run() invokes this for
+parts of the file in multiple threads.
 
 Iterate over all the pages in the tablespace.
 @param iter - Tablespace iterator
@@ -941,9 +956,31 @@ class PageConverter : public AbstractCallback {
 		m_rec_iter(),
 		m_offsets_(), m_offsets(m_offsets_),
 		m_heap(0),
-		m_cluster_index(dict_table_get_first_index(cfg->m_table))
+		m_cluster_index(dict_table_get_first_index(cfg->m_table)),
+		m_stats()
+	{
+		rec_offs_init(m_offsets_);
+	}
+
+	/** Create a converter for another part of the same file,
+	which collects its statistics separately until add_stats().
+	@param c converter that has been initialized by init() */
+	PageConverter(const PageConverter& c)
+		:
+		AbstractCallback(c),
+		m_cfg(c.m_cfg),
+		m_index(c.m_cfg->m_indexes),
+		m_rec_iter(),
+		m_offsets_(), m_offsets(m_offsets_),
+		m_heap(0),
+		m_cluster_index(c.m_cluster_index),
+		m_stats(UT_NEW_ARRAY_NOKEY(row_stats_t, c.m_cfg->m_n_indexes))
 	{
 		rec_offs_init(m_offsets_);
+		if (m_stats) {
+			memset(m_stats, 0x0,
+			       sizeof *m_stats * m_cfg->m_n_indexes);
+		}
 	}
 
 	~PageConverter() UNIV_NOTHROW override
@@ -951,14 +988,35 @@ class PageConverter : public AbstractCallback {
 		if (m_heap != 0) {
 			mem_heap_free(m_heap);
 		}
+
+		UT_DELETE_ARRAY(m_stats);
 	}
 
+	/** Convert all pages, in parts of innodb_import_threads.
+	@param iter	Tablespace iterator
+	@param block	Block to use for IO
+	@retval DB_SUCCESS or error code */
 	dberr_t run(const fil_iterator_t& iter,
-		    buf_block_t* block) UNIV_NOTHROW override
+		    buf_block_t* block) UNIV_NOTHROW override;
+
+	/** Add the statistics that were collected by a converter
+	that was created by the copy constructor. */
+	void add_stats() const UNIV_NOTHROW
 	{
-		return fil_iterate(iter, block, *this);
+		for (ulint i = 0; i < m_cfg->m_n_indexes; ++i) {
+			row_stats_t&	s = m_cfg->m_indexes[i].m_stats;
+
+			s.m_n_deleted += m_stats[i].m_n_deleted;
+			s.m_n_purged += m_stats[i].m_n_purged;
+			s.m_n_rows += m_stats[i].m_n_rows;
+			s.m_n_purge_failed += m_stats[i].m_n_purge_failed;
+		}
 	}
 
+	/** @return whether the statistics of a copy could not be
+	allocated */
+	bool is_oom() const { return !m_stats; }
+
 	/** Called for each block as it is read from the file.
 	@param block block to convert, it is not from the buffer pool.
 	@retval DB_SUCCESS or error code. */
@@ -1029,6 +1087,14 @@ class PageConverter : public AbstractCallback {
 		rec_t*			rec,
 		const rec_offs*		offsets) UNIV_NOTHROW;
 
+	/** @return the statistics of the current index */
+	row_stats_t& stats() UNIV_NOTHROW
+	{
+		return m_stats
+			? m_stats[m_index - m_cfg->m_indexes]
+			: m_index->m_stats;
+	}
+
 	/** Find an index with the matching id.
 	@return row_index_t* instance or 0 */
 	row_index_t* find_index(index_id_t id) UNIV_NOTHROW
@@ -1065,6 +1131,10 @@ class PageConverter : public AbstractCallback {
 
 	/** Cluster index instance */
 	dict_index_t*		m_cluster_index;
+
+	/** Statistics of each index of m_cfg, or nullptr if they are
+	collected in m_cfg directly */
+	row_stats_t*		m_stats;
 };
 
 /**
@@ -1824,11 +1894,11 @@ inline bool PageConverter::purge() UNIV_NOTHROW
 	/* We can't have a page that is empty and not root. */
 	if (m_rec_iter.remove(m_offsets)) {
 
-		++m_index->m_stats.m_n_purged;
+		++stats().m_n_purged;
 
 		return(true);
 	} else {
-		++m_index->m_stats.m_n_purge_failed;
+		++stats().m_n_purge_failed;
 	}
 
 	return(false);
@@ -1945,7 +2015,7 @@ PageConverter::update_records(
 		optimistic delete. */
 
 		if (deleted) {
-			++m_index->m_stats.m_n_deleted;
+			++stats().m_n_deleted;
 			/* A successful purge will move the cursor to the
 			next record. */
 
@@ -1953,7 +2023,7 @@ PageConverter::update_records(
 				continue;
 			}
 		} else {
-			++m_index->m_stats.m_n_rows;
+			++stats().m_n_rows;
 		}
 
 		if (!m_rec_iter.next()) {
@@ -2194,6 +2264,9 @@ dberr_t PageConverter::operator()(buf_block_t* block) UNIV_NOTHROW
     mysql_mutex_unlock(&buf_pool.mutex);
   }
 
+  /* Also discard any copy that was made when an old page was evicted. */
+  buf_tier.discard(block->page.id());
+
   uint16_t page_type;
 
   if (dberr_t err= update_page(block, page_type))
@@ -4126,7 +4199,7 @@ static dberr_t fil_iterate(
 		return DB_OUT_OF_MEMORY;
 	}
 
-	uint32_t actual_space_id = 0;
+	uint32_t actual_space_id = iter.actual_space_id;
 	const bool full_crc32 = fil_space_t::full_crc32(
 		callback.get_space_flags());
 
@@ -4427,6 +4500,175 @@ static dberr_t fil_iterate(
 	return err;
 }
 
+/** Parts of a tablespace file that are being converted in parallel */
+struct import_parts_t
+{
+  /** Constructor
+  @param iter       iterator over the whole file
+  @param part_size  size of a part in bytes */
+  import_parts_t(const fil_iterator_t &iter, os_offset_t part_size) :
+    end(iter.end), part_size(part_size), next(iter.start + part_size),
+    error(DB_SUCCESS) {}
+
+  /** end of the file */
+  const os_offset_t end;
+  /** size of a part, covered by one extent descriptor page */
+  const os_offset_t part_size;
+  /** start of the next part to be converted */
+  std::atomic<os_offset_t> next;
+  /** the first error */
+  std::atomic<dberr_t> error;
+
+  /** Note an error, so that no further parts will be converted.
+  @param err  error code */
+  void set_error(dberr_t err)
+  {
+    dberr_t e= DB_SUCCESS;
+    error.compare_exchange_strong(e, err);
+  }
+
+  /** Convert parts until all parts are done or an error occurs.
+  @param it         iterator whose buffers to use
+  @param block      block to use for IO
+  @param converter  converter to use */
+  void convert(const fil_iterator_t &it, buf_block_t *block,
+               PageConverter &converter)
+  {
+    fil_iterator_t iter{it};
+    while (error == DB_SUCCESS)
+    {
+      iter.start= next.fetch_add(part_size);
+      if (iter.start >= end)
+        break;
+      iter.end= std::min(iter.start + part_size, end);
+      if (dberr_t err= fil_iterate(iter, block, converter))
+        set_error(err);
+    }
+  }
+};
+
+/** A helper thread of PageConverter::run() */
+struct import_worker_t
+{
+  /** Constructor
+  @param parts      the parts to convert
+  @param iter       iterator over the whole file
+  @param converter  the converter that was initialized by init() */
+  import_worker_t(import_parts_t &parts, const fil_iterator_t &iter,
+                  const PageConverter &converter) :
+    parts(parts), iter(iter), converter(converter),
+    block(static_cast<buf_block_t*>(ut_zalloc_nokey(sizeof *block))),
+    task(convert, this)
+  {
+    const size_t buf_size= (1 + iter.n_io_buffers) * srv_page_size;
+    this->iter.io_buffer= static_cast<byte*>
+      (aligned_malloc(buf_size, srv_page_size));
+    if (iter.crypt_data)
+    {
+      this->iter.crypt_io_buffer= static_cast<byte*>
+        (aligned_malloc(buf_size, srv_page_size));
+      this->iter.crypt_tmp_buffer= static_cast<byte*>
+        (aligned_malloc(buf_size, CPU_LEVEL1_DCACHE_LINESIZE));
+    }
+
+    if (!block)
+      return;
+    block->page.init(buf_page_t::UNFIXED + 1,
+                     page_id_t{converter.get_space_id(), 0});
+    if (ulint zip_size= converter.get_zip_size())
+    {
+      page_zip_set_size(&block->page.zip, zip_size);
+      block->page.frame= this->iter.io_buffer;
+      block->page.zip.data= block->page.frame + srv_page_size;
+    }
+  }
+
+  ~import_worker_t()
+  {
+    ut_free(block);
+    aligned_free(iter.crypt_tmp_buffer);
+    aligned_free(iter.crypt_io_buffer);
+    aligned_free(iter.io_buffer);
+  }
+
+  /** @return whether all memory was allocated */
+  bool is_ok() const
+  {
+    return block && iter.io_buffer && !converter.is_oom() &&
+      (!iter.crypt_data || (iter.crypt_io_buffer && iter.crypt_tmp_buffer));
+  }
+
+  /** Task callback
+  @param arg  import_worker_t */
+  static void convert(void *arg)
+  {
+    import_worker_t *w= static_cast<import_worker_t*>(arg);
+    w->parts.convert(w->iter, w->block, w->converter);
+  }
+
+  /** the parts to convert */
+  import_parts_t &parts;
+  /** iterator with the buffers of this thread */
+  fil_iterator_t iter;
+  /** converter of this thread */
+  PageConverter converter;
+  /** block to use for IO */
+  buf_block_t *block;
+  /** the task */
+  tpool::waitable_task task;
+};
+
+dberr_t PageConverter::run(const fil_iterator_t &iter, buf_block_t *block)
+  UNIV_NOTHROW
+{
+  /* Each part starts with an extent descriptor page, which is read by
+  set_current_xdes() before any page that is covered by it. */
+  const os_offset_t part_size= os_offset_t{physical_size()} *
+    physical_size();
+  const os_offset_t n_parts= (iter.end - iter.start + part_size - 1) /
+    part_size;
+  const ulint n_threads= ulint(std::min<os_offset_t>(srv_import_threads,
+                                                     n_parts));
+
+  if (n_threads <= 1)
+    return fil_iterate(iter, block, *this);
+
+  import_parts_t parts{iter, part_size};
+  std::vector<import_worker_t*> workers;
+  workers.reserve(n_threads - 1);
+
+  for (ulint i= 1; i < n_threads; i++)
+  {
+    import_worker_t *w= UT_NEW_NOKEY(import_worker_t(parts, iter, *this));
+    if (!w)
+      break;
+    if (!w->is_ok())
+    {
+      UT_DELETE(w);
+      break;
+    }
+    workers.push_back(w);
+    srv_thread_pool->submit_task(&w->task);
+  }
+
+  /* The first part, which contains the FSP_HDR page, must be converted
+  by this, because init() read the extent descriptor of page 0. */
+  fil_iterator_t first{iter};
+  first.end= std::min(iter.start + part_size, iter.end);
+  if (dberr_t err= fil_iterate(first, block, *this))
+    parts.set_error(err);
+  parts.convert(iter, block, *this);
+
+  for (import_worker_t *w : workers)
+  {
+    w->task.wait();
+    w->converter.add_stats();
+    UT_DELETE(w);
+  }
+
+  return parts.error;
+}
+
 /**
 Iterate over all or some pages in the tablespace.
 @param dir_path      the path to data dir storing the tablespace
@@ -4532,6 +4774,8 @@ fil_tablespace_iterate(
 		iter.filepath = filepath;
 		iter.file_size = file_size;
 		iter.n_io_buffers = n_io_buffers;
+		iter.actual_space_id = mach_read_from_4(
+			page + FIL_PAGE_SPACE_ID);
 
 		size_t buf_size = (1 + iter.n_io_buffers) * srv_page_size;
 
@@ -4868,6 +5112,9 @@ row_import_for_mysql(
 
 	PageConverter	converter(&cfg, table->space_id, trx);
 
+	/* The pages are written bypassing the buffer pool. */
+	buf_track.add_space(table->space_id);
+
 	/* Set the IO buffer size in pages. */
 
 	err = fil_tablespace_iterate(
@@ -2708,6 +2708,8 @@ row_ins_clust_index_entry_low(
 	    && !trx->dict_operation
 	    && block->page.id().page_no() == index->page
 	    && !index->table->is_native_online_ddl()
+	    /* not buffering for innodb_bulk_insert_non_empty */
+	    && !trx->check_bulk_buffer(index->table)
 	    && (!dict_table_is_partition(index->table)
 	        || thd_sql_command(trx->mysql_thd) == SQLCOM_INSERT)) {
 
@@ -3388,13 +3390,23 @@ row_ins_index_entry(
 
 	if (index->is_btree()) {
 		if (auto t= trx->check_bulk_buffer(index->table)) {
-			/* MDEV-25036 FIXME:
-			row_ins_check_foreign_constraint() check
-			should be done before buffering the insert
-			operation. */
-			ut_ad(index->table->skip_alter_undo
-			      || !trx->check_foreigns);
-			return t->bulk_insert_buffered(*entry, *index, trx);
+			if (!t->is_bulk_insert_non_empty()) {
+				/* MDEV-25036 FIXME:
+				row_ins_check_foreign_constraint() check
+				should be done before buffering the insert
+				operation. */
+				ut_ad(index->table->skip_alter_undo
+				      || !trx->check_foreigns);
+				return t->bulk_insert_buffered(
+					*entry, *index, trx);
+			}
+			/* The table has no FOREIGN KEY constraints,
+			and the exclusive table lock prevents any
+			locking conflicts with other transactions. */
+			if (row_merge_bulk_t::non_empty_buffered(*index)) {
+				return t->bulk_insert_buffered(
+					*entry, *index, trx);
+			}
 		}
 	}
 
@@ -3751,6 +3751,117 @@ row_log_apply(
 	DBUG_RETURN(error);
 }
 
+/** Estimate how much of the online log of an index has not been applied.
+@param index   secondary index that is (or was) being created
+@return number of bytes that remain to be applied */
+static ulint row_log_pending(dict_index_t *index)
+{
+  ulint pending= 0;
+  index->lock.s_lock(SRW_LOCK_CALL);
+  if (row_log_t *log= index->online_log)
+  {
+    mysql_mutex_lock(&log->mutex);
+    if (log->tail.blocks > log->head.blocks)
+      pending= (log->tail.blocks - log->head.blocks) * srv_sort_buf_size;
+    pending+= log->tail.bytes;
+    mysql_mutex_unlock(&log->mutex);
+  }
+  index->lock.s_unlock();
+  return pending;
+}
+
+/** Work item of row_log_apply_parallel() */
+struct row_log_apply_task_t
+{
+  /** transaction for checking if the operation was interrupted */
+  const trx_t *trx;
+  /** secondary index */
+  dict_index_t *index;
+  /** outcome of row_log_apply() */
+  dberr_t error;
+};
+
+/** Apply the online log of an index in a thread pool task.
+@param arg  row_log_apply_task_t */
+static void row_log_apply_task(void *arg)
+{
+  row_log_apply_task_t *t= static_cast<row_log_apply_task_t*>(arg);
+  t->error= row_log_apply(t->trx, t->index, nullptr, nullptr);
+}
+
+dberr_t row_log_apply_parallel(const trx_t *trx, dict_index_t **indexes,
+                               ulint n_indexes, ulint *err_index)
+{
+  row_log_apply_task_t *work= static_cast<row_log_apply_task_t*>
+    (ut_malloc_nokey(n_indexes * sizeof *work));
+  tpool::waitable_task **tasks= static_cast<tpool::waitable_task**>
+    (ut_zalloc_nokey(n_indexes * sizeof *tasks));
+  if (!work || !tasks)
+  {
+    ut_free(work);
+    ut_free(tasks);
+    return DB_SUCCESS;
+  }
+
+  dberr_t error= DB_SUCCESS;
+  ulint pending= ULINT_MAX;
+
+  for (;;)
+  {
+    ulint n_tasks= 0;
+    ulint applying= 0;
+    for (ulint i= 0; i < n_indexes; i++)
+    {
+      dict_index_t *index= indexes[i];
+      if (index->is_unique() || (index->type & (DICT_FTS | DICT_SPATIAL)) ||
+          index->online_status != ONLINE_INDEX_COMPLETE ||
+          index->is_corrupted())
+        continue;
+      if (const ulint p= row_log_pending(index))
+      {
+        applying+= p;
+        work[n_tasks]= {trx, index, DB_SUCCESS};
+        n_tasks++;
+      }
+    }
+
+    /* Stop once the logs are nearly exhausted, or when the concurrent
+    DML is generating more log than the previous round managed to apply. */
+    if (n_tasks < 2 || applying < srv_sort_buf_size || applying >= pending)
+      break;
+    pending= applying;
+
+    for (ulint i= 0; i < n_tasks; i++)
+    {
+      tasks[i]= new tpool::waitable_task(row_log_apply_task, &work[i]);
+      srv_thread_pool->submit_task(tasks[i]);
+    }
+
+    for (ulint i= 0; i < n_tasks; i++)
+    {
+      tasks[i]->wait();
+      delete tasks[i];
+      tasks[i]= nullptr;
+      if (work[i].error == DB_SUCCESS || error != DB_SUCCESS)
+        continue;
+      error= work[i].error;
+      dict_index_t *index= work[i].index;
+      for (*err_index= 0; indexes[*err_index] != index; ++*err_index);
+      index->lock.x_lock(SRW_LOCK_CALL);
+      if (index->online_log)
+        index->online_log->error= error;
+      index->lock.x_unlock();
+    }
+
+    if (error != DB_SUCCESS)
+      break;
+  }
+
+  ut_free(tasks);
+  ut_free(work);
+  return error;
+}
+
 unsigned row_log_get_n_core_fields(const dict_index_t *index)
 {
   ut_ad(index->online_log);
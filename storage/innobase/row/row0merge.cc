@@ -61,40 +61,41 @@ Completed by Sunny Bains and Marko Makela
 /* Whether to disable file system cache */
 char	srv_disable_sort_file_cache;
 
-/** Class that caches spatial index row tuples made from a single cluster
-index page scan, and then insert into corresponding index tree */
+/** Class that caches spatial index row tuples made from a clustered
+index scan, and then inserts a batch of them into the index tree in
+the order of the Hilbert curve, so that consecutive inserts go to
+neighbouring leaf pages and the leaves are filled up one after another */
 class spatial_index_info {
 public:
   /** constructor
   @param index	spatial index to be created */
-  spatial_index_info(dict_index_t *index) : index(index)
+  spatial_index_info(dict_index_t *index) :
+    m_heap(mem_heap_create(1024)), index(index)
   {
     ut_ad(index->is_spatial());
   }
 
+  ~spatial_index_info() { mem_heap_free(m_heap); }
+
   /** Caches an index row into index tuple vector
   @param[in]	row	table row
   @param[in]	ext	externally stored column prefixes, or NULL */
-  void add(const dtuple_t *row, const row_ext_t *ext, mem_heap_t *heap)
+  void add(const dtuple_t *row, const row_ext_t *ext)
   {
-    dtuple_t *dtuple= row_build_index_entry(row, ext, index, heap);
+    dtuple_t *dtuple= row_build_index_entry(row, ext, index, m_heap);
     ut_ad(dtuple);
     ut_ad(dtuple->n_fields == index->n_fields);
-    if (ext)
-    {
-      /* Replace any references to ext, because ext will be allocated
-      from row_heap. */
-      for (ulint i= 1; i < dtuple->n_fields; i++)
-      {
-        dfield_t &dfield= dtuple->fields[i];
-        if (dfield.data >= ext->buf &&
-            dfield.data <= &ext->buf[ext->n_ext * ext->max_len])
-          dfield_dup(&dfield, heap);
-      }
-    }
+    /* The MBR was computed in m_heap. The other fields may point to
+    the clustered index page, to row_heap or to ext; copy them so that
+    the tuple can be kept until its batch is inserted. */
+    for (ulint i= 1; i < dtuple->n_fields; i++)
+      dfield_dup(&dtuple->fields[i], m_heap);
     m_dtuple_vec.push_back(dtuple);
   }
 
+  /** @return whether the cached rows fill a batch */
+  bool full() const { return mem_heap_get_size(m_heap) >= srv_sort_buf_size; }
+
 	/** Insert spatial index rows cached in vector into spatial index
 	@param[in]	trx_id		transaction id
 	@param[in]	pcur		cluster index scanning cursor
@@ -122,6 +123,8 @@ class spatial_index_info {
 		DBUG_EXECUTE_IF("row_merge_instrument_log_check_flush",
 				log_sys.set_check_for_checkpoint(););
 
+		sort();
+
 		for (idx_tuple_vec::iterator it = m_dtuple_vec.begin();
 		     it != m_dtuple_vec.end();
 		     ++it) {
@@ -226,11 +229,88 @@ class spatial_index_info {
 		}
 
 		m_dtuple_vec.clear();
+		mem_heap_empty(m_heap);
 
 		return(error);
 	}
 
 private:
+  /** Map a point of a 2^16 by 2^16 grid to its distance along the
+  Hilbert curve that fills the grid */
+  static uint32_t hilbert_distance(uint32_t x, uint32_t y)
+  {
+    uint32_t d= 0;
+    for (uint32_t s= 1U << 15; s; s>>= 1)
+    {
+      const uint32_t rx= (x & s) != 0, ry= (y & s) != 0;
+      d+= s * s * ((3 * rx) ^ ry);
+      if (!ry)
+      {
+        if (rx)
+        {
+          x= s - 1 - (x & (s - 1));
+          y= s - 1 - (y & (s - 1));
+        }
+        std::swap(x, y);
+      }
+    }
+    return d;
+  }
+
+  /** Sort the cached rows by the Hilbert curve distance of the centre
+  of their MBR in the bounding box of the batch */
+  void sort()
+  {
+    const size_t n= m_dtuple_vec.size();
+    if (n < 2)
+      return;
+
+    std::vector<std::pair<uint32_t, dtuple_t*>,
+                ut_allocator<std::pair<uint32_t, dtuple_t*> > > keys;
+    keys.reserve(n);
+
+    double xmin= DBL_MAX, xmax= -DBL_MAX, ymin= DBL_MAX, ymax= -DBL_MAX;
+    for (const dtuple_t *dtuple : m_dtuple_vec)
+    {
+      rtr_mbr_t mbr;
+      rtr_get_mbr_from_tuple(dtuple, &mbr);
+      const double x= (mbr.xmin + mbr.xmax) / 2, y= (mbr.ymin + mbr.ymax) / 2;
+      xmin= std::min(xmin, x);
+      xmax= std::max(xmax, x);
+      ymin= std::min(ymin, y);
+      ymax= std::max(ymax, y);
+    }
+
+    /* Scale the centres to the grid; a degenerate or non-finite extent
+    collapses that axis to 0. */
+    const double xscale= xmax > xmin && std::isfinite(xmax - xmin)
+      ? 65535.0 / (xmax - xmin) : 0;
+    const double yscale= ymax > ymin && std::isfinite(ymax - ymin)
+      ? 65535.0 / (ymax - ymin) : 0;
+
+    for (dtuple_t *dtuple : m_dtuple_vec)
+    {
+      rtr_mbr_t mbr;
+      rtr_get_mbr_from_tuple(dtuple, &mbr);
+      const double x= ((mbr.xmin + mbr.xmax) / 2 - xmin) * xscale;
+      const double y= ((mbr.ymin + mbr.ymax) / 2 - ymin) * yscale;
+      keys.emplace_back(hilbert_distance(x >= 0 && x <= 65535 ? uint32_t(x) : 0,
+                                         y >= 0 && y <= 65535 ? uint32_t(y) : 0),
+                        dtuple);
+    }
+
+    std::stable_sort(keys.begin(), keys.end(),
+                     [](const std::pair<uint32_t, dtuple_t*> &a,
+                        const std::pair<uint32_t, dtuple_t*> &b)
+                     { return a.first < b.first; });
+
+    for (size_t i= 0; i < n; i++)
+      m_dtuple_vec[i]= keys[i].second;
+  }
+
+  /** memory heap for the cached rows */
+  mem_heap_t *const m_heap;
+
   /** Cache index rows made from a cluster index scan. Usually
   for rows on single cluster index page */
   typedef std::vector<dtuple_t*, ut_allocator<dtuple_t*> > idx_tuple_vec;
@@ -265,6 +345,9 @@ and then stage->inc() will be called for each record that is processed.
 				the given blob file. It is
 				applicable only for bulk insert
 				operation
+@param[in]	thr		query thread for inserting into a
+				non-empty secondary index when
+				btr_bulk is nullptr
 @return DB_SUCCESS or error number */
 static	MY_ATTRIBUTE((warn_unused_result))
 dberr_t
@@ -281,7 +364,8 @@ row_merge_insert_index_tuples(
 	row_merge_block_t*	crypt_block,
 	ulint			space,
 	ut_stage_alter_t*	stage= nullptr,
-	merge_file_t*		blob_file= nullptr);
+	merge_file_t*		blob_file= nullptr,
+	que_thr_t*		thr= nullptr);
 
 /** Encode an index record.
 @return size of the record */
@@ -1691,6 +1775,101 @@ row_merge_file_create_if_needed(
 	return(file->fd != OS_FILE_CLOSED);
 }
 
+/** Sorts and writes a full sort buffer of a non-unique secondary index
+in the background, while row_merge_read_clustered_index() keeps filling
+another buffer. Sorting does not need to report duplicates, and each
+index has its own output file, so runs of several indexes are generated
+in parallel with the clustered index scan. */
+class row_merge_bg_write_t
+{
+  /** the buffer that is being written, or an empty spare buffer */
+  row_merge_buf_t *m_buf;
+  /** output file */
+  merge_file_t *m_file= nullptr;
+  /** output buffer of srv_sort_buf_size bytes */
+  row_merge_block_t *const m_block;
+  /** encryption buffer of srv_sort_buf_size bytes, or nullptr */
+  row_merge_block_t *const m_crypt_block;
+  /** tablespace identifier for encryption */
+  const ulint m_space;
+  /** status of the last write */
+  dberr_t m_err= DB_SUCCESS;
+  /** the sorting and writing task */
+  tpool::waitable_task m_task;
+
+  static void run(void *arg)
+  { static_cast<row_merge_bg_write_t*>(arg)->write(); }
+
+  void write()
+  {
+    row_merge_buf_sort(m_buf, nullptr);
+    row_merge_buf_write(m_buf,
+#ifndef DBUG_OFF
+                        m_file,
+#endif
+                        m_block);
+    if (!row_merge_write(m_file->fd, m_file->offset++, m_block,
+                         m_crypt_block, m_space))
+      m_err= DB_TEMP_FILE_WRITE_FAIL;
+    MEM_UNDEFINED(m_block, srv_sort_buf_size);
+    m_buf= row_merge_buf_empty(m_buf);
+  }
+
+  row_merge_bg_write_t(dict_index_t *index, row_merge_block_t *block,
+                       row_merge_block_t *crypt_block, ulint space) :
+    m_buf(row_merge_buf_create(index)), m_block(block),
+    m_crypt_block(crypt_block), m_space(space), m_task(run, this) {}
+public:
+  ~row_merge_bg_write_t()
+  {
+    m_task.wait();
+    row_merge_buf_free(m_buf);
+    aligned_free(m_crypt_block);
+    aligned_free(m_block);
+  }
+
+  /** Create a background writer.
+  @param index    non-unique secondary index
+  @param encrypt  whether the temporary files are encrypted
+  @param space    tablespace identifier for encryption
+  @return background writer
+  @retval nullptr if out of memory */
+  static row_merge_bg_write_t *create(dict_index_t *index, bool encrypt,
+                                      ulint space)
+  {
+    auto block= static_cast<row_merge_block_t*>
+      (aligned_malloc(srv_sort_buf_size, srv_page_size));
+    auto crypt_block= block && encrypt
+      ? static_cast<row_merge_block_t*>
+      (aligned_malloc(srv_sort_buf_size, srv_page_size))
+      : nullptr;
+    if (!block || (encrypt && !crypt_block))
+    {
+      aligned_free(block);
+      return nullptr;
+    }
+    return UT_NEW_NOKEY(row_merge_bg_write_t(index, block, crypt_block,
+                                             space));
+  }
+
+  /** Wait for the previous write to complete.
+  @return error code */
+  dberr_t wait() { m_task.wait(); return m_err; }
+
+  /** Start sorting and writing a full buffer.
+  @param buf   full sort buffer; replaced with an empty one
+  @param file  output file */
+  void submit(row_merge_buf_t *&buf, merge_file_t *file)
+  {
+    ut_ad(!m_buf->n_tuples);
+    ut_ad(m_buf->index == buf->index);
+    ut_ad(m_err == DB_SUCCESS);
+    std::swap(buf, m_buf);
+    m_file= file;
+    srv_thread_pool->submit_task(&m_task);
+  }
+};
+
 /** Copy the merge data tuple from another merge data tuple.
 @param[in]	mtuple		source merge data tuple
 @param[in,out]	prev_mtuple	destination merge data tuple
@@ -1741,6 +1920,8 @@ row_mtuple_cmp(
 @param[in,out]	pcur		cluster index cursor
 @param[in,out]	started		whether mtr is active
 @param[in,out]	mtr		mini-transaction
+@param[in]	all		whether to insert also the batches
+				that are not full yet
 @return DB_SUCCESS or error number */
 static
 dberr_t
@@ -1751,14 +1932,16 @@ row_merge_spatial_rows(
 	mem_heap_t*		heap,
 	btr_pcur_t*		pcur,
 	bool&			started,
-	mtr_t*			mtr)
+	mtr_t*			mtr,
+	bool			all)
 {
   if (!sp_tuples)
     return DB_SUCCESS;
 
   for (ulint j= 0; j < num_spatial; j++)
-    if (dberr_t err= sp_tuples[j]->insert(trx_id, pcur, started, heap, mtr))
-      return err;
+    if (all || sp_tuples[j]->full())
+      if (dberr_t err= sp_tuples[j]->insert(trx_id, pcur, started, heap, mtr))
+        return err;
 
   mem_heap_empty(heap);
   return DB_SUCCESS;
@@ -1861,6 +2044,8 @@ row_merge_read_clustered_index(
 	mem_heap_t*		row_heap = NULL;/* Heap memory to create
 						clustered index tuples */
 	row_merge_buf_t**	merge_buf;	/* Temporary list for records*/
+	row_merge_bg_write_t**	bg_write;	/* Background writers of
+						merge_buf, or nullptr */
 	mem_heap_t*		v_heap = NULL;	/* Heap memory to process large
 						data for virtual column */
 	btr_pcur_t		pcur;		/* Cursor on the clustered
@@ -1915,6 +2100,8 @@ row_merge_read_clustered_index(
 
 	merge_buf = static_cast<row_merge_buf_t**>(
 		ut_malloc_nokey(n_index * sizeof *merge_buf));
+	bg_write = static_cast<row_merge_bg_write_t**>(
+		ut_zalloc_nokey(n_index * sizeof *bg_write));
 
 	row_merge_dup_t	clust_dup = {index[0], table, col_map, 0};
 	dfield_t*	prev_fields = nullptr;
@@ -1957,6 +2144,11 @@ row_merge_read_clustered_index(
 		} else {
 			if (dict_index_is_spatial(index[i])) {
 				num_spatial++;
+			} else if (!(index[i]->type
+				     & (DICT_CLUSTERED | DICT_UNIQUE))) {
+				bg_write[i] = row_merge_bg_write_t::create(
+					index[i], crypt_block != NULL,
+					new_table->space_id);
 			}
 
 			merge_buf[i] = row_merge_buf_create(index[i]);
@@ -2145,10 +2337,12 @@ row_merge_read_clustered_index(
 				}
 			}
 
-			/* Insert the cached spatial index rows. */
+			/* Insert the cached spatial index rows
+			once a batch is full. */
 			err = row_merge_spatial_rows(
 				trx->id, sp_tuples, num_spatial,
-				row_heap, &pcur, mtr_started, &mtr);
+				row_heap, &pcur, mtr_started, &mtr,
+				false);
 
 			if (err != DB_SUCCESS) {
 				goto func_exit;
@@ -2178,6 +2372,16 @@ row_merge_read_clustered_index(
 					row = NULL;
 					mtr.commit();
 					mtr_started = false;
+					/* Insert the rest of the cached
+					spatial index rows. */
+					err = row_merge_spatial_rows(
+						trx->id, sp_tuples,
+						num_spatial, row_heap,
+						&pcur, mtr_started, &mtr,
+						true);
+					if (err != DB_SUCCESS) {
+						goto func_exit;
+					}
 					mem_heap_free(row_heap);
 					row_heap = NULL;
 					ut_free(nonnull);
@@ -2520,7 +2724,7 @@ row_merge_read_clustered_index(
 					break;
 				}
 
-				sp_tuples[s_idx_cnt]->add(row, ext, buf->heap);
+				sp_tuples[s_idx_cnt]->add(row, ext);
 				s_idx_cnt++;
 
 				continue;
@@ -2611,6 +2815,31 @@ row_merge_read_clustered_index(
 				}
 			}
 
+			if (row_merge_bg_write_t* w = bg_write[i]) {
+				/* Wait for the previous run of this index
+				to be written. */
+				err = w->wait();
+				if (err != DB_SUCCESS) {
+					trx->error_key_num = i;
+					break;
+				}
+
+				if (row) {
+					if (!row_merge_file_create_if_needed(
+						    file, tmpfd,
+						    buf->n_tuples, path)) {
+						err = DB_OUT_OF_MEMORY;
+						trx->error_key_num = i;
+						break;
+					}
+
+					ut_ad(file->n_rec > 0);
+					w->submit(merge_buf[i], file);
+					buf = merge_buf[i];
+					goto add_again;
+				}
+			}
+
 			/* The buffer must be sufficiently large
 			to hold at least one record. It may only
 			be empty when we reach the end of the
@@ -2633,23 +2862,6 @@ row_merge_read_clustered_index(
 					/* Temporary File is not used.
 					so insert sorted block to the index */
 					if (row != NULL) {
-						/* We have to do insert the
-						cached spatial index rows, since
-						after the mtr_commit, the cluster
-						index page could be updated, then
-						the data in cached rows become
-						invalid. */
-						err = row_merge_spatial_rows(
-							trx->id, sp_tuples,
-							num_spatial,
-							row_heap,
-							&pcur, mtr_started,
-							&mtr);
-
-						if (err != DB_SUCCESS) {
-							goto func_exit;
-						}
-
 						/* We are not at the end of
 						the scan yet. We must
 						mtr.commit() in order to be
@@ -2859,7 +3071,7 @@ row_merge_read_clustered_index(
 			}
 			merge_buf[i] = row_merge_buf_empty(buf);
 			buf = merge_buf[i];
-
+add_again:
 			if (UNIV_LIKELY(row != NULL)) {
 				/* Try writing the record again, now
 				that the buffer has been written out
@@ -2995,11 +3207,13 @@ row_merge_read_clustered_index(
 	DEBUG_FTS_SORT_PRINT("FTS_SORT: Complete Tokenization\n");
 #endif
 	for (ulint i = 0; i < n_index; i++) {
+		UT_DELETE(bg_write[i]);
 		row_merge_buf_free(merge_buf[i]);
 	}
 
 	row_fts_free_pll_merge_buf(psort_info);
 
+	ut_free(bg_write);
 	ut_free(merge_buf);
 	ut_free(pcur.old_rec_buf);
 
@@ -3677,7 +3891,8 @@ row_merge_insert_index_tuples(
 	row_merge_block_t*	crypt_block,
 	ulint			space,
 	ut_stage_alter_t*	stage,
-	merge_file_t*		blob_file)
+	merge_file_t*		blob_file,
+	que_thr_t*		thr)
 {
 	const byte*		b;
 	mem_heap_t*		heap;
@@ -3700,6 +3915,7 @@ row_merge_insert_index_tuples(
 	ut_ad(!srv_read_only_mode);
 	ut_ad(!(index->type & DICT_FTS));
 	ut_ad(!dict_index_is_spatial(index));
+	ut_ad(!btr_bulk == !!thr);
 
 	if (stage != NULL) {
 		stage->begin_phase_insert();
@@ -3820,7 +4036,12 @@ row_merge_insert_index_tuples(
 		}
 
 		ut_ad(dtuple_validate(dtuple));
-		error = btr_bulk->insert(dtuple);
+		/* The caller of row_merge_bulk_t::write_to_index()
+		holds an exclusive lock on the table, so that the
+		insert into a non-empty index cannot wait for locks. */
+		error = btr_bulk
+			? btr_bulk->insert(dtuple)
+			: row_ins_sec_index_entry(index, dtuple, thr, false);
 
 		if (error != DB_SUCCESS) {
 			goto err_exit;
@@ -4931,6 +5152,18 @@ row_merge_build_indexes(
 		}
 	}
 
+	if (online && old_table == new_table && n_indexes > 1) {
+		/* The logs of the indexes that were completed first
+		kept growing while the subsequent indexes were being
+		built. Catch up on them concurrently, so that fewer
+		changes will remain to be applied by
+		commit_inplace_alter_table() under exclusive MDL. */
+		error = row_log_apply_parallel(trx, indexes, n_indexes, &i);
+		if (error != DB_SUCCESS) {
+			trx->error_key_num = key_numbers[i];
+		}
+	}
+
 func_exit:
 
 	DBUG_EXECUTE_IF(
@@ -5030,7 +5263,8 @@ dberr_t row_merge_bulk_t::alloc_block()
   return DB_SUCCESS;
 }
 
-row_merge_bulk_t::row_merge_bulk_t(dict_table_t *table)
+row_merge_bulk_t::row_merge_bulk_t(dict_table_t *table, bool non_empty) :
+  m_non_empty(non_empty)
 {
   ulint n_index= 0;
   for (dict_index_t *index= UT_LIST_GET_FIRST(table->indexes);
@@ -5237,6 +5471,19 @@ dberr_t row_merge_bulk_t::write_to_index(ulint index_no, trx_t *trx)
   dict_table_t *table= index->table;
   BtrBulk btr_bulk(index, trx);
   row_merge_dup_t dup = {index, nullptr, nullptr, 0};
+  BtrBulk *bulk= &btr_bulk;
+  que_thr_t *thr= nullptr;
+
+  if (m_non_empty)
+  {
+    if (!buf.n_tuples && (!file || file->fd == OS_FILE_CLOSED))
+      return DB_SUCCESS;
+    ut_ad(non_empty_buffered(*index));
+    /* Insert the sorted entries into the existing index tree. */
+    bulk= nullptr;
+    thr= pars_complete_graph_for_exec(nullptr, trx, mem_heap_create(256),
+                                      nullptr);
+  }
 
   if (buf.n_tuples)
   {
@@ -5262,8 +5509,9 @@ dberr_t row_merge_bulk_t::write_to_index(ulint index_no, trx_t *trx)
       /* Data got fit in merge buffer. */
       err= row_merge_insert_index_tuples(
             index, table, OS_FILE_CLOSED, nullptr,
-            &buf, &btr_bulk, 0, 0, 0, nullptr, table->space_id, nullptr,
-            m_blob_file.fd == OS_FILE_CLOSED ? nullptr : &m_blob_file);
+            &buf, bulk, 0, 0, 0, nullptr, table->space_id, nullptr,
+            m_blob_file.fd == OS_FILE_CLOSED ? nullptr : &m_blob_file,
+            thr);
       goto func_exit;
     }
   }
@@ -5276,10 +5524,12 @@ dberr_t row_merge_bulk_t::write_to_index(ulint index_no, trx_t *trx)
 
   err= row_merge_insert_index_tuples(
         index, table, file->fd, m_block, nullptr,
-        &btr_bulk, 0, 0, 0, m_crypt_block, table->space_id,
-        nullptr, &m_blob_file);
+        bulk, 0, 0, 0, m_crypt_block, table->space_id,
+        nullptr, &m_blob_file, thr);
 
 func_exit:
+  if (thr)
+    que_graph_free(thr->graph);
   if (err != DB_SUCCESS)
     trx->error_info= index;
   else if (index->is_primary() && table->persistent_autoinc)
@@ -5323,8 +5573,7 @@ dberr_t trx_mod_table_time_t::write_bulk(dict_table_t *table, trx_t *trx)
   if (!bulk_store)
     return DB_SUCCESS;
   dberr_t err= bulk_store->write_to_table(table, trx);
-  delete bulk_store;
-  bulk_store= nullptr;
+  clear_bulk_buffer();
   return err;
 }
 
@@ -5341,16 +5590,24 @@ void trx_t::bulk_rollback_low()
       t.second.bulk_store= nullptr;
       t.second.end_bulk_insert();
     }
+    else if (t.second.is_bulk_insert_non_empty())
+    {
+      if (t.second.get_bulk_non_empty() < low_limit)
+        low_limit= t.second.get_bulk_non_empty();
+      t.second.clear_bulk_buffer();
+    }
   }
+  bulk_insert_non_empty= false;
   trx_savept_t bulk_save{low_limit};
   rollback(&bulk_save);
 }
 
 dberr_t trx_t::bulk_insert_apply_low()
 {
-  ut_ad(bulk_insert);
+  ut_ad(bulk_insert || bulk_insert_non_empty);
+  bulk_insert_non_empty= false;
   for (auto& t : mod_tables)
-    if (t.second.is_bulk_insert())
+    if (t.second.is_bulk_insert() || t.second.is_bulk_insert_non_empty())
       if (dberr_t err= t.second.write_bulk(t.first, this))
       {
         bulk_rollback_low();
@@ -5358,3 +5615,22 @@ dberr_t trx_t::bulk_insert_apply_low()
       }
   return DB_SUCCESS;
 }
+
+void trx_t::bulk_insert_non_empty_rollback(trx_savept_t *savept)
+{
+  ut_ad(bulk_insert_non_empty);
+  bulk_insert_non_empty= false;
+  for (auto& t : mod_tables)
+  {
+    if (!t.second.is_bulk_insert_non_empty())
+      continue;
+    const undo_no_t start= t.second.get_bulk_non_empty();
+    if (start >= savept->least_undo_no)
+      /* All buffered rows will be rolled back. */
+      t.second.clear_bulk_buffer();
+    else if (t.second.write_bulk(t.first, this) != DB_SUCCESS)
+      /* The secondary indexes would lack some of the surviving rows.
+      Roll back all rows whose entries were buffered. */
+      savept->least_undo_no= start;
+  }
+}
@@ -906,6 +906,7 @@ row_create_prebuilt(
 	prebuilt->fts_doc_id = 0;
 
 	prebuilt->mysql_row_len = mysql_row_len;
+	prebuilt->fetch_cache_size = MYSQL_FETCH_CACHE_SIZE;
 
 	prebuilt->fts_doc_id_in_read_set = 0;
 	prebuilt->blob_heap = NULL;
@@ -913,6 +914,58 @@ row_create_prebuilt(
 	DBUG_RETURN(prebuilt);
 }
 
+/** Free the fetch_cache of a prebuilt struct.
+@param prebuilt  prebuilt struct */
+static void row_prebuilt_free_fetch_cache(row_prebuilt_t *prebuilt)
+{
+	byte*	base = prebuilt->fetch_cache[0] - 4;
+	byte*	ptr = base;
+
+	for (ulint i = 0; i < prebuilt->fetch_cache_size; i++) {
+		ulint	magic1 = mach_read_from_4(ptr);
+		ut_a(magic1 == ROW_PREBUILT_FETCH_MAGIC_N);
+		ptr += 4;
+
+		byte*	row = ptr;
+		ut_a(row == prebuilt->fetch_cache[i]);
+		ptr += prebuilt->mysql_row_len;
+
+		ulint	magic2 = mach_read_from_4(ptr);
+		ut_a(magic2 == ROW_PREBUILT_FETCH_MAGIC_N);
+		ptr += 4;
+		prebuilt->fetch_cache[i] = NULL;
+	}
+
+	ut_free(base);
+}
+
+/** Set the number of rows that a scan may prefetch to fetch_cache
+while holding the page latch.
+@param prebuilt  prebuilt struct
+@param n_rows    number of rows; clamped to
+[MYSQL_FETCH_CACHE_SIZE, MYSQL_FETCH_CACHE_MAX] */
+void row_prebuilt_set_fetch_cache_size(row_prebuilt_t *prebuilt,
+				       ulint n_rows)
+{
+	n_rows = std::min<ulint>(std::max<ulint>(n_rows,
+						 MYSQL_FETCH_CACHE_SIZE),
+				 MYSQL_FETCH_CACHE_MAX);
+
+	if (n_rows == prebuilt->fetch_cache_size
+	    || prebuilt->n_fetch_cached) {
+		/* Do not discard rows that are waiting to be returned. */
+		return;
+	}
+
+	if (prebuilt->fetch_cache[0] != NULL) {
+		/* The cache will be allocated again on demand. */
+		row_prebuilt_free_fetch_cache(prebuilt);
+	}
+
+	prebuilt->fetch_cache_first = 0;
+	prebuilt->fetch_cache_size = n_rows;
+}
+
 /** Free a prebuilt struct for a TABLE handle. */
 void row_prebuilt_free(row_prebuilt_t *prebuilt)
 {
@@ -950,24 +1003,7 @@ void row_prebuilt_free(row_prebuilt_t *prebuilt)
 	}
 
 	if (prebuilt->fetch_cache[0] != NULL) {
-		byte*	base = prebuilt->fetch_cache[0] - 4;
-		byte*	ptr = base;
-
-		for (ulint i = 0; i < MYSQL_FETCH_CACHE_SIZE; i++) {
-			ulint	magic1 = mach_read_from_4(ptr);
-			ut_a(magic1 == ROW_PREBUILT_FETCH_MAGIC_N);
-			ptr += 4;
-
-			byte*	row = ptr;
-			ut_a(row == prebuilt->fetch_cache[i]);
-			ptr += prebuilt->mysql_row_len;
-
-			ulint	magic2 = mach_read_from_4(ptr);
-			ut_a(magic2 == ROW_PREBUILT_FETCH_MAGIC_N);
-			ptr += 4;
-		}
-
-		ut_free(base);
+		row_prebuilt_free_fetch_cache(prebuilt);
 	}
 
 	if (prebuilt->rtr_info) {
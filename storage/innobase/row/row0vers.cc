@@ -42,6 +42,8 @@ Created 2/6/1997 Heikki Tuuri
 #include "lock0lock.h"
 #include "row0mysql.h"
 
+#include <unordered_map>
+
 /** Check whether all non-virtual index fields are equal.
 @param[in]	index	the secondary index
 @param[in]	a	first index entry to compare
@@ -689,6 +691,177 @@ bool dtuple_vcol_data_missing(const dtuple_t &tuple,
   return false;
 }
 
+/** Old versions of clustered index records that
+row_vers_build_for_consistent_read() built for a read view, keyed by
+the DB_ROLL_PTR of the newest version that the view did not see.
+A version that was built once can be returned again without applying
+the same undo log records, also when the record was modified further
+after the version was cached. The undo log records that the view may
+need cannot be purged while the view is open. However, when an active
+transaction is rolled back fully or to a savepoint, its undo log is
+truncated and the same DB_ROLL_PTR may be written again for another
+record. Therefore, the PRIMARY KEY of the record is stored along with
+the version and compared on lookup. For the same record, a reused
+DB_ROLL_PTR leads to the same older versions, because the rolled back
+changes were undone before the record was modified again. */
+struct row_vers_cache_t
+{
+  /** Maximum size of the cached records, in bytes */
+  static constexpr size_t MAX_SIZE= 1U << 20;
+  /** Undo log records that must have been applied to build a version
+  before it is cached */
+  static constexpr ulint MIN_STEPS= 2;
+
+  /** A cached version */
+  struct entry
+  {
+    /** dict_index_t::id */
+    index_id_t index_id;
+    /** dict_table_t::def_trx_id, to detect instant ALTER TABLE */
+    trx_id_t def_trx_id;
+    /** the PRIMARY KEY fields of the record, each preceded by
+    a 4-byte length, followed by the copy of the version, starting
+    from the header */
+    byte *buf;
+    /** length of the PRIMARY KEY fields in buf */
+    ulint pk_size;
+    /** rec_offs_extra_size(), or ULINT_UNDEFINED if the record
+    did not exist in the view */
+    ulint extra_size;
+    /** rec_offs_size() */
+    ulint size;
+
+    /** @return the copy of the version, starting from the header
+    @retval nullptr if the record did not exist in the view */
+    const byte *rec_buf() const
+    { return extra_size == ULINT_UNDEFINED ? nullptr : buf + pk_size; }
+  };
+
+  ~row_vers_cache_t() { clear(); }
+
+  /** Look up a version.
+  @param roll_ptr  DB_ROLL_PTR of a version that is not visible
+  @param index     clustered index
+  @param rec       the version whose DB_ROLL_PTR is roll_ptr
+  @param offsets   rec_get_offsets(rec, index)
+  @return the version that was built from roll_ptr
+  @retval nullptr  if not found */
+  const entry *find(roll_ptr_t roll_ptr, const dict_index_t &index,
+                    const rec_t *rec, const rec_offs *offsets) const
+  {
+    const auto i= map.find(roll_ptr);
+    if (i == map.end() || i->second.index_id != index.id ||
+        i->second.def_trx_id != index.table->def_trx_id ||
+        !pk_equal(i->second.buf, index, rec, offsets))
+      return nullptr;
+    return &i->second;
+  }
+
+  /** Add a version.
+  @param roll_ptr  DB_ROLL_PTR of the newest version that is not visible
+  @param index     clustered index
+  @param pk_rec    a version of the record whose PRIMARY KEY to store
+  @param pk_offsets rec_get_offsets(pk_rec, index)
+  @param rec       the version that the view sees, or nullptr
+  @param offsets   rec_get_offsets(rec, index) */
+  void add(roll_ptr_t roll_ptr, const dict_index_t &index,
+           const rec_t *pk_rec, const rec_offs *pk_offsets,
+           const rec_t *rec, const rec_offs *offsets)
+  {
+    entry e{index.id, index.table->def_trx_id, nullptr,
+            pk_copy(nullptr, index, pk_rec, pk_offsets),
+            ULINT_UNDEFINED, 0};
+    if (rec)
+    {
+      e.extra_size= rec_offs_extra_size(offsets);
+      e.size= rec_offs_size(offsets);
+    }
+    if (size + e.pk_size + e.size + sizeof e > MAX_SIZE)
+      clear();
+    e.buf= static_cast<byte*>(ut_malloc_nokey(e.pk_size + e.size));
+    if (!e.buf)
+      return;
+    pk_copy(e.buf, index, pk_rec, pk_offsets);
+    if (rec)
+      memcpy(e.buf + e.pk_size, rec - e.extra_size, e.size);
+    auto i= map.emplace(roll_ptr, e);
+    if (!i.second)
+    {
+      ut_free(e.buf);
+      return;
+    }
+    size+= e.pk_size + e.size + sizeof e;
+  }
+
+  /** Discard all cached versions */
+  void clear()
+  {
+    for (auto &e : map)
+      ut_free(e.second.buf);
+    map.clear();
+    size= 0;
+  }
+
+private:
+  /** Copy the PRIMARY KEY fields of a record.
+  @param buf     the output buffer, or nullptr to only compute the size
+  @param index   clustered index
+  @param rec     clustered index record
+  @param offsets rec_get_offsets(rec, index)
+  @return the length of the copy */
+  static ulint pk_copy(byte *buf, const dict_index_t &index,
+                       const rec_t *rec, const rec_offs *offsets)
+  {
+    ulint total= 0;
+    for (ulint i= 0, n= dict_index_get_n_unique(&index); i < n; i++)
+    {
+      ulint len;
+      const byte *f= rec_get_nth_field(rec, offsets, i, &len);
+      ut_ad(len != UNIV_SQL_NULL);
+      if (buf)
+      {
+        mach_write_to_4(buf + total, len);
+        memcpy(buf + total + 4, f, len);
+      }
+      total+= 4 + len;
+    }
+    return total;
+  }
+
+  /** Compare the PRIMARY KEY fields of a record to a copy.
+  @param buf     the output of pk_copy()
+  @param index   clustered index
+  @param rec     clustered index record
+  @param offsets rec_get_offsets(rec, index)
+  @return whether the PRIMARY KEY fields are equal */
+  static bool pk_equal(const byte *buf, const dict_index_t &index,
+                       const rec_t *rec, const rec_offs *offsets)
+  {
+    for (ulint i= 0, n= dict_index_get_n_unique(&index); i < n; i++)
+    {
+      ulint len;
+      const byte *f= rec_get_nth_field(rec, offsets, i, &len);
+      if (mach_read_from_4(buf) != len || memcmp(buf + 4, f, len))
+        return false;
+      buf+= 4 + len;
+    }
+    return true;
+  }
+
+  /** the cached versions */
+  std::unordered_map<roll_ptr_t, entry> map;
+  /** approximate memory usage of the cached versions, in bytes */
+  size_t size= 0;
+};
+
+/** Free the cache of old versions that
+row_vers_build_for_consistent_read() built for a read view.
+@param cache  ReadView::vers_cache() */
+void row_vers_cache_free(row_vers_cache_t *cache)
+{
+  delete cache;
+}
+
 /*****************************************************************//**
 Constructs the version of a clustered index record which a consistent
 read should see. We assume that the trx id stored in rec is such that
@@ -726,6 +899,10 @@ row_vers_build_for_consistent_read(
 	mem_heap_t*	heap		= NULL;
 	byte*		buf;
 	dberr_t		err;
+	/* Virtual column values are not cached. */
+	row_vers_cache_t* cache		= vrow ? NULL : view->vers_cache();
+	roll_ptr_t	roll_ptr;
+	ulint		n_steps		= 0;
 
 	ut_ad(index->is_primary());
 	ut_ad(mtr->memo_contains_page_flagged(rec, MTR_MEMO_PAGE_X_FIX
@@ -734,6 +911,7 @@ row_vers_build_for_consistent_read(
 	ut_ad(rec_offs_validate(rec, index, *offsets));
 
 	trx_id = row_get_rec_trx_id(rec, index, *offsets);
+	roll_ptr = row_get_rec_roll_ptr(rec, index, *offsets);
 
 	ut_ad(!view->changes_visible(trx_id));
 
@@ -744,6 +922,31 @@ row_vers_build_for_consistent_read(
 	for (;;) {
 		mem_heap_t*	prev_heap = heap;
 
+		if (const row_vers_cache_t::entry* e = cache
+		    ? cache->find(row_get_rec_roll_ptr(version, index,
+						       *offsets),
+				  *index, version, *offsets)
+		    : NULL) {
+			/* This version was built before. */
+			if (!e->rec_buf()) {
+				*old_vers = NULL;
+			} else {
+				buf = static_cast<byte*>(
+					mem_heap_alloc(in_heap, e->size));
+				memcpy(buf, e->rec_buf(), e->size);
+				*old_vers = buf + e->extra_size;
+				*offsets = rec_get_offsets(
+					*old_vers, index, *offsets,
+					index->n_core_fields,
+					ULINT_UNDEFINED, offset_heap);
+			}
+
+			err = DB_SUCCESS;
+			break;
+		}
+
+		n_steps++;
+
 		heap = mem_heap_create(1024);
 
 		if (vrow) {
@@ -803,7 +1006,30 @@ row_vers_build_for_consistent_read(
 		version = prev_version;
 	}
 
-	mem_heap_free(heap);
+	if (vrow || err != DB_SUCCESS || n_steps < row_vers_cache_t::MIN_STEPS) {
+	} else {
+		if (!cache) {
+			cache = new row_vers_cache_t;
+			view->set_vers_cache(cache);
+		}
+
+		/* The caller still holds the latch on rec. */
+		mem_heap_t*	pk_heap = NULL;
+		rec_offs	pk_offsets_[REC_OFFS_NORMAL_SIZE];
+		rec_offs_init(pk_offsets_);
+		const rec_offs*	pk_offsets = rec_get_offsets(
+			rec, index, pk_offsets_, index->n_core_fields,
+			dict_index_get_n_unique(index), &pk_heap);
+		cache->add(roll_ptr, *index, rec, pk_offsets,
+			   *old_vers, *offsets);
+		if (pk_heap) {
+			mem_heap_free(pk_heap);
+		}
+	}
+
+	if (heap) {
+		mem_heap_free(heap);
+	}
 
 	return(err);
 }
@@ -46,6 +46,7 @@ Created 10/8/1995 Heikki Tuuri
 #include "btr0sea.h"
 #include "buf0flu.h"
 #include "buf0lru.h"
+#include "buf0tier.h"
 #include "dict0boot.h"
 #include "dict0load.h"
 #include "lock0lock.h"
@@ -111,6 +112,10 @@ it, truncate action is completed but no new tablespace is marked
 for truncate (action is never aborted). */
 my_bool	srv_undo_log_truncate;
 
+/** Whether to discard the unused end of UNDO tablespaces while
+purge is running (innodb_undo_log_shrink) */
+my_bool	srv_undo_log_shrink;
+
 /** Maximum size of undo tablespace. */
 unsigned long long	srv_max_undo_log_size;
 
@@ -136,6 +141,8 @@ use simulated aio we build below with threads.
 Currently we support native aio on windows and linux */
 my_bool	srv_use_native_aio;
 my_bool	srv_numa_interleave;
+/** innodb_numa_bind: whether to bind buffer pool chunks to NUMA nodes */
+my_bool	srv_numa_bind;
 /** copy of innodb_use_atomic_writes; @see innodb_init_params() */
 my_bool	srv_use_atomic_writes;
 /** innodb_compression_algorithm; used with page compression */
@@ -202,6 +209,20 @@ ulong	srv_checksum_algorithm;
 uint	srv_n_read_io_threads;
 /** innodb_write_io_threads */
 uint	srv_n_write_io_threads;
+/** innodb_read_ahead_io_pct */
+uint	srv_read_ahead_io_pct= 50;
+/** innodb_flush_io_pct */
+uint	srv_flush_io_pct= 100;
+/** innodb_page_cleaner_threads */
+uint	srv_n_page_cleaner_threads= 1;
+/** innodb_recovery_apply_threads */
+uint	srv_n_recovery_apply_threads;
+/** innodb_import_threads */
+uint	srv_import_threads= 4;
+/** innodb_partition_read_ahead */
+uint	srv_partition_read_ahead;
+/** innodb_shared_scan_min_size */
+ulonglong	srv_shared_scan_min_size;
 
 /** innodb_random_read_ahead */
 my_bool	srv_random_read_ahead;
@@ -232,6 +253,11 @@ double	srv_max_dirty_pages_pct_lwm;
 which adaptive flushing, if enabled, will kick in. */
 double	srv_adaptive_flushing_lwm;
 
+/** innodb_log_throttle_lwm; the percentage of max_checkpoint_age above
+which log_free_check() delays writes while the checkpoint falls behind,
+or 0 to never delay them. */
+double	srv_log_throttle_lwm;
+
 /** innodb_flushing_avg_loops; number of iterations over which
 adaptive flushing is averaged */
 ulong	srv_flushing_avg_loops;
@@ -291,6 +317,10 @@ my_bool		srv_stats_include_delete_marked;
 unsigned long long	srv_stats_persistent_sample_pages;
 /** innodb_stats_auto_recalc */
 my_bool		srv_stats_auto_recalc;
+/** innodb_stats_auto_recalc_threads */
+uint		srv_stats_auto_recalc_threads;
+/** innodb_stats_auto_recalc_time_budget */
+uint		srv_stats_auto_recalc_time_budget;
 
 /** innodb_stats_modified_counter; The number of rows modified before
 we calculate new statistics (default 0 = current limits) */
@@ -327,6 +357,11 @@ my_bool	srv_force_primary_key;
 inside InnoDB alter for copy algorithm; */
 my_bool innodb_alter_copy_bulk;
 
+/** innodb_bulk_insert_non_empty; Whether a multi-row INSERT into
+a table that can be locked exclusively buffers and sorts the entries
+of non-unique secondary indexes until the end of the statement */
+my_bool innodb_bulk_insert_non_empty;
+
 /** Key version to encrypt the temporary tablespace */
 my_bool innodb_encrypt_temporary_tables;
 
@@ -877,6 +912,8 @@ srv_export_innodb_status(void)
 
 	export_vars.innodb_buffer_pool_read_requests
 		= buf_pool.stat.n_page_gets;
+	export_vars.innodb_buffer_pool_tier_bytes = buf_tier.bytes();
+	export_vars.innodb_buffer_pool_tier_pages = buf_tier.pages();
 
 	export_vars.innodb_buffer_pool_bytes_data =
 		buf_pool.stat.LRU_bytes
@@ -964,6 +1001,10 @@ srv_export_innodb_status(void)
 	export_vars.innodb_checkpoint_age = static_cast<ulint>(
 		export_vars.innodb_lsn_current
 		- export_vars.innodb_lsn_last_checkpoint);
+	export_vars.innodb_checkpoint_rate = log_sys.checkpoint_rate;
+	export_vars.innodb_checkpoint_time_to_sync_flush =
+		log_sys.time_to_sync_flush;
+	export_vars.innodb_log_generation_rate = log_sys.generation_rate;
 }
 
 struct srv_monitor_state_t
@@ -1293,6 +1334,7 @@ void srv_master_callback(void*)
   srv_sync_log_buffer_in_background();
   MONITOR_INC_TIME_IN_MICRO_SECS(MONITOR_SRV_LOG_FLUSH_MICROSECOND,
 				 counter_time);
+  log_throttle_update();
 
   if (srv_check_activity(&old_activity_count))
     srv_master_do_active_tasks(counter_time);
@@ -1419,7 +1461,15 @@ inline void purge_coordinator_state::do_purge()
       break;
     }
 
-    ulint n_pages_handled= trx_purge(n_threads, history_size);
+    /* Use one purge task per innodb_purge_batch_size transactions in the
+    history, but not more than innodb_purge_threads or the number of CPUs,
+    so that a short history will not be spread too thin. */
+    const size_t n_tasks= std::max<size_t>
+      (1, std::min<size_t>({history_size / srv_purge_batch_size + 1,
+                            n_threads, size_t(my_getncpus())}));
+    purge_sys.n_active_tasks= n_tasks;
+
+    ulint n_pages_handled= trx_purge(n_tasks, history_size);
     if (!trx_sys.history_exists())
       goto no_history;
     if (purge_sys.truncating_tablespace() ||
@@ -68,6 +68,7 @@ Created 2/16/1996 Heikki Tuuri
 #include "trx0rseg.h"
 #include "buf0flu.h"
 #include "buf0rea.h"
+#include "buf0track.h"
 #include "dict0boot.h"
 #include "dict0load.h"
 #include "dict0stats_bg.h"
@@ -1457,6 +1458,10 @@ dberr_t srv_start(bool create_new_db)
 		}
 
 		srv_undo_space_id_start = 1;
+
+		if (srv_operation == SRV_OPERATION_NORMAL) {
+			buf_track.open();
+		}
 	}
 
 	/* Open data files in the system tablespace: we keep
@@ -1566,6 +1571,11 @@ dberr_t srv_start(bool create_new_db)
 
 		recv_sys.dblwr.pages.clear();
 
+		if (err == DB_SUCCESS && !srv_read_only_mode
+		    && srv_operation == SRV_OPERATION_NORMAL) {
+			buf_track.open();
+		}
+
 		bool must_upgrade_ibuf = false;
 
 		switch (srv_operation) {
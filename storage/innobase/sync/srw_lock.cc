@@ -146,15 +146,18 @@ static inline void srw_pause(unsigned delay) noexcept
 #ifndef PTHREAD_ADAPTIVE_MUTEX_INITIALIZER_NP
 template<> void pthread_mutex_wrapper<true>::wr_wait() noexcept
 {
+  latch_wait w{this};
   const unsigned delay= srw_pause_delay();
 
   for (auto spin= srv_n_spin_wait_rounds; spin; spin--)
   {
+    w.spin();
     srw_pause(delay);
     if (wr_lock_try())
       return;
   }
 
+  w.sleep();
   pthread_mutex_lock(&lock);
 }
 #endif
@@ -272,6 +275,7 @@ template void ssux_lock_impl<true>::wake() noexcept;
 template<bool spinloop>
 void srw_mutex_impl<spinloop>::wait_and_lock() noexcept
 {
+  latch_wait w{this};
   uint32_t lk= WAITER + lock.fetch_add(WAITER, std::memory_order_relaxed);
 
   if (spinloop)
@@ -301,6 +305,7 @@ void srw_mutex_impl<spinloop>::wait_and_lock() noexcept
       }
       if (!--spin)
         break;
+      w.spin();
       srw_pause(delay);
     }
   }
@@ -310,6 +315,7 @@ void srw_mutex_impl<spinloop>::wait_and_lock() noexcept
     DBUG_ASSERT(~HOLDER & lk);
     if (lk & HOLDER)
     {
+      w.sleep();
       wait(lk);
 #if defined __i386__||defined __x86_64__||defined _M_IX86||defined _M_X64
 reload:
@@ -348,6 +354,7 @@ void ssux_lock_impl<spinloop>::wr_wait(uint32_t lk) noexcept
   DBUG_ASSERT(writer.is_locked());
   DBUG_ASSERT(lk);
   DBUG_ASSERT(lk < WRITER);
+  latch_wait w{this};
 
   if (spinloop)
   {
@@ -355,6 +362,7 @@ void ssux_lock_impl<spinloop>::wr_wait(uint32_t lk) noexcept
 
     for (auto spin= srv_n_spin_wait_rounds; spin; spin--)
     {
+      w.spin();
       srw_pause(delay);
       lk= readers.load(std::memory_order_acquire);
       if (lk == WRITER)
@@ -368,6 +376,7 @@ void ssux_lock_impl<spinloop>::wr_wait(uint32_t lk) noexcept
   do
   {
     DBUG_ASSERT(lk > WRITER);
+    w.sleep();
     wait(lk);
     lk= readers.load(std::memory_order_acquire);
   }
@@ -380,12 +389,14 @@ template void ssux_lock_impl<false>::wr_wait(uint32_t) noexcept;
 template<bool spinloop>
 void ssux_lock_impl<spinloop>::rd_wait() noexcept
 {
+  latch_wait w{this};
   const unsigned delay= srw_pause_delay();
 
   if (spinloop)
   {
     for (auto spin= srv_n_spin_wait_rounds; spin; spin--)
     {
+      w.spin();
       srw_pause(delay);
       if (rd_lock_try())
         return;
@@ -400,7 +411,10 @@ void ssux_lock_impl<spinloop>::rd_wait() noexcept
   for (;;)
   {
     if (UNIV_LIKELY(writer.HOLDER & wl))
+    {
+      w.sleep();
       writer.wait(wl);
+    }
     uint32_t lk= rd_lock_try_low();
     if (!lk)
       break;
@@ -413,6 +427,7 @@ void ssux_lock_impl<spinloop>::rd_wait() noexcept
       lots of non-productive context switching until the wr_lock()
       is finally woken up. */
       writer.wake_all();
+    w.spin();
     srw_pause(delay);
     wl= writer.lock.load(std::memory_order_acquire);
     ut_ad(wl);
@@ -435,29 +450,35 @@ template void ssux_lock_impl<false>::rd_wait() noexcept;
 #if defined _WIN32 || defined SUX_LOCK_GENERIC
 template<> void srw_lock_<true>::rd_wait() noexcept
 {
+  latch_wait w{this};
   const unsigned delay= srw_pause_delay();
 
   for (auto spin= srv_n_spin_wait_rounds; spin; spin--)
   {
+    w.spin();
     srw_pause(delay);
     if (rd_lock_try())
       return;
   }
 
+  w.sleep();
   IF_WIN(AcquireSRWLockShared(&lk), rw_rdlock(&lk));
 }
 
 template<> void srw_lock_<true>::wr_wait() noexcept
 {
+  latch_wait w{this};
   const unsigned delay= srw_pause_delay();
 
   for (auto spin= srv_n_spin_wait_rounds; spin; spin--)
   {
+    w.spin();
     srw_pause(delay);
     if (wr_lock_try())
       return;
   }
 
+  w.sleep();
   IF_WIN(AcquireSRWLockExclusive(&lk), rw_wrlock(&lk));
 }
 #endif
@@ -743,3 +764,74 @@ bool srw_lock_debug::have_any() const noexcept
   return have_wr() || have_rd();
 }
 #endif
+
+latch_stats_t latch_stats;
+
+const char *latch_stats_t::name(latch_class latch) noexcept
+{
+  static const char *const names[N_CLASSES]=
+  {
+    "lock_sys.latch",
+    "lock_sys.hash_latch",
+    "log_sys.latch",
+    "dict_sys.latch",
+    "buf_pool.page_hash",
+    "other"
+  };
+  return names[latch];
+}
+
+void latch_stats_t::add(latch_class latch, const void *begin, size_t size)
+  noexcept
+{
+  ut_ad(latch < OTHER);
+  for (range &r : ranges)
+  {
+    if (r.begin)
+      continue;
+    r.latch= latch;
+    r.end= static_cast<const char*>(begin) + size;
+    r.begin= static_cast<const char*>(begin);
+    return;
+  }
+  ut_ad("too many latch ranges" == 0);
+}
+
+void latch_stats_t::remove(const void *begin) noexcept
+{
+  for (range &r : ranges)
+    if (r.begin == begin)
+      r.begin= nullptr;
+}
+
+latch_stats_t::latch_class latch_stats_t::classify(const void *latch) const
+  noexcept
+{
+  const char *l= static_cast<const char*>(latch);
+  for (const range &r : ranges)
+    if (const char *begin= r.begin)
+      if (l >= begin && l < r.end)
+        return r.latch;
+  return OTHER;
+}
+
+void latch_stats_t::record(const void *latch, uint32_t spins,
+                           uint32_t sleeps, ulonglong ns) noexcept
+{
+  counters &c= stats[classify(latch)];
+  c.waits++;
+  c.spin_rounds+= spins;
+  c.sleeps+= sleeps;
+  c.wait_time+= ns;
+}
+
+void latch_stats_t::reset() noexcept
+{
+  for (counters &c : stats)
+  {
+    c.waits= 0;
+    c.spin_rounds= 0;
+    c.sleeps= 0;
+    c.wait_time= 0;
+  }
+}
@@ -40,6 +40,7 @@ Created 3/26/1996 Heikki Tuuri
 #include "trx0trx.h"
 #include "dict0load.h"
 #include <mysql/service_thd_mdl.h>
+#include <unordered_set>
 #include <mysql/service_wsrep.h>
 #include "log.h"
 
@@ -109,6 +110,7 @@ void purge_sys_t::create()
   mysql_mutex_init(purge_sys_pq_mutex_key, &pq_mutex, nullptr);
   truncate_undo_space.current= nullptr;
   truncate_undo_space.last= 0;
+  shrink_undo_space.set();
   m_initialized= true;
 }
 
@@ -484,6 +486,9 @@ inline dberr_t purge_sys_t::iterator::free_history_rseg(trx_rseg_t &rseg) const
       rseg.curr_size-= seg_size;
       DBUG_EXECUTE_IF("undo_segment_leak", goto skip_purge_free;);
       trx_purge_free_segment(rseg_hdr, b, mtr);
+      if (srv_is_undo_tablespace(rseg.space->id))
+        purge_sys.shrink_undo_space.set(rseg.space->id -
+                                        srv_undo_space_id_start);
       break;
     case TRX_UNDO_CACHED:
       /* rseg.undo_cached must point to this page */
@@ -643,6 +648,22 @@ TRANSACTIONAL_TARGET void trx_purge_truncate_history()
   if (head.free_history() != DB_SUCCESS)
     return;
 
+  /* Do not latch and traverse an undo tablespace unless undo segments
+  were freed in it, or the previous shrink may have left more to do. */
+  if (srv_undo_log_shrink &&
+      (srv_shutdown_state == SRV_SHUTDOWN_NONE || !srv_fast_shutdown))
+    for (uint32_t i= 0; i < srv_undo_tablespaces_active; i++)
+      if (purge_sys.shrink_undo_space.test(i))
+        if (fil_space_t *space= fil_space_get(srv_undo_space_id_start + i))
+          if (space != purge_sys.truncate_undo_space.current)
+          {
+            if (!fsp_shrink_undo_space(space))
+              purge_sys.shrink_undo_space.reset(i);
+            else
+              /* No mutex; this is only updated by the purge coordinator. */
+              export_vars.innodb_undo_truncations++;
+          }
+
   while (fil_space_t *space= purge_sys.truncating_tablespace())
   {
     for (auto &rseg : trx_sys.rseg_array)
@@ -1202,13 +1223,122 @@ dict_table_t *purge_sys_t::close_and_reopen(table_id_t id, THD *thd,
   return table;
 }
 
+/** Tables that got more than their share of the undo log records in
+the previous purge batch. The records of these tables are distributed
+among all purge tasks. Only accessed by the purge coordinator. */
+static std::unordered_set<table_id_t> purge_hot_tables;
+
+/** Check if the undo log records of a table can be distributed among
+multiple purge tasks. trx_purge_rec_partition() folds the bytes of the
+PRIMARY KEY, so this is only possible if equal keys are stored with equal
+bytes. That is not the case for character strings, whose collation may
+treat different strings (such as 'a' and 'A ') as equal, nor for
+floating point numbers (0 and -0).
+@param table  table
+@return whether the records can be partitioned */
+static bool trx_purge_table_can_split(const dict_table_t &table)
+{
+  const dict_index_t *index= dict_table_get_first_index(&table);
+  for (unsigned i= 0, n= dict_index_get_n_unique(index); i < n; i++)
+  {
+    const dict_col_t *col= dict_index_get_nth_col(index, i);
+    switch (col->mtype) {
+    case DATA_FLOAT:
+    case DATA_DOUBLE:
+    case DATA_DECIMAL:
+      return false;
+    default:
+      if (dtype_is_non_binary_string_type(col->mtype, col->prtype))
+        return false;
+    }
+  }
+  return true;
+}
+
+/** Determine the partition of an undo log record of a table whose records
+are distributed among multiple purge tasks. All records for a PRIMARY KEY
+map to the same partition, so that they will be purged in order.
+@param undo_rec  undo log record
+@param table     the table of the record
+@param n_parts   number of partitions
+@return partition number */
+static unsigned trx_purge_rec_partition(const trx_undo_rec_t *undo_rec,
+                                        const dict_table_t &table,
+                                        unsigned n_parts)
+{
+  byte type, cmpl_info, info_bits;
+  bool updated_extern;
+  undo_no_t undo_no;
+  table_id_t table_id;
+  trx_id_t trx_id;
+  roll_ptr_t roll_ptr;
+
+  const byte *ptr= trx_undo_rec_get_pars(undo_rec, &type, &cmpl_info,
+                                         &updated_extern, &undo_no,
+                                         &table_id);
+  switch (type) {
+  case TRX_UNDO_UPD_EXIST_REC:
+  case TRX_UNDO_UPD_DEL_REC:
+  case TRX_UNDO_DEL_MARK_REC:
+    ptr= trx_undo_update_rec_get_sys_cols(ptr, &trx_id, &roll_ptr,
+                                          &info_bits);
+    /* fall through */
+  case TRX_UNDO_INSERT_REC:
+    break;
+  default:
+    /* The record does not refer to a row. */
+    return 0;
+  }
+
+  const dict_index_t *index= dict_table_get_first_index(&table);
+  if (index->is_corrupted())
+    return 0;
+  const byte *end= trx_undo_rec_skip_row_ref(ptr, index);
+  return unsigned(ut_fold_binary(ptr, ulint(end - ptr)) % n_parts);
+}
+
+/** Assign the next purge node to a table, and open the table.
+@param thd           purge coordinator thread handle
+@param mdl_context   metadata lock acquisition context
+@param table_id      table identifier
+@param thr           the previously assigned purge node
+@param n_work_items  number of work items
+@return the purge node */
+static purge_node_t *trx_purge_node_assign(THD *thd, MDL_context *mdl_context,
+                                           table_id_t table_id,
+                                           que_thr_t *&thr,
+                                           ulint *n_work_items)
+{
+  if (!thr || !(thr= UT_LIST_GET_NEXT(thrs, thr)))
+    thr= UT_LIST_GET_FIRST(purge_sys.query->thrs);
+  ++*n_work_items;
+  purge_node_t *node= static_cast<purge_node_t *>(thr->child);
+  ut_a(que_node_get_type(node) == QUE_NODE_PURGE);
+  ut_ad(!node->in_progress);
+
+  /* After wrapping around, another partition of the same table may
+  already have been assigned to this node. */
+  if (node->tables.find(table_id) == node->tables.end())
+  {
+    std::pair<dict_table_t *, MDL_ticket *> p;
+    p.first= trx_purge_table_open(table_id, mdl_context, &p.second);
+    if (p.first == reinterpret_cast<dict_table_t *>(-1))
+      p.first= purge_sys.close_and_reopen(table_id, thd, &p.second);
+    node->tables.emplace(table_id, p);
+  }
+
+  return node;
+}
+
 /** Run a purge batch.
-@param n_purge_threads	number of purge threads
 @param thd              purge coordinator thread handle
-@param n_work_items     number of work items (currently tables) to process
+@param n_work_items     number of work items (tables or partitions of
+                        tables) to process
+@param n_tasks          number of purge tasks
 @return new purge_sys.head */
 static purge_sys_t::iterator trx_purge_attach_undo_recs(THD *thd,
-                                                        ulint *n_work_items)
+                                                        ulint *n_work_items,
+                                                        unsigned n_tasks)
 {
   que_thr_t *thr;
   purge_sys_t::iterator head= purge_sys.tail;
@@ -1217,7 +1347,18 @@ static purge_sys_t::iterator trx_purge_attach_undo_recs(THD *thd,
   to a per purge node vector. */
   thr= nullptr;
 
-  std::unordered_map<table_id_t, purge_node_t *>
+  /** The purge nodes of a table */
+  struct table_nodes
+  {
+    /** number of undo log records */
+    size_t n_recs;
+    /** number of partitions; 0 if no node has been assigned yet */
+    unsigned n_parts;
+    /** the purge node of each partition */
+    purge_node_t *node[innodb_purge_threads_MAX];
+  };
+
+  std::unordered_map<table_id_t, table_nodes>
     table_id_map(TRX_PURGE_TABLE_BUCKETS);
   purge_sys.m_active= true;
 
@@ -1249,38 +1390,54 @@ static purge_sys_t::iterator trx_purge_attach_undo_recs(THD *thd,
 
     table_id_t table_id= trx_undo_rec_get_table_id(purge_rec.undo_rec);
 
-    purge_node_t *&table_node= table_id_map[table_id];
-    if (table_node)
-      ut_ad(!table_node->in_progress);
-    if (!table_node)
+    table_nodes &t= table_id_map[table_id];
+    t.n_recs++;
+    if (!t.n_parts)
     {
-      std::pair<dict_table_t *, MDL_ticket *> p;
-      p.first= trx_purge_table_open(table_id, mdl_context, &p.second);
-      if (p.first == reinterpret_cast<dict_table_t *>(-1))
-        p.first= purge_sys.close_and_reopen(table_id, thd, &p.second);
-
-      if (!thr || !(thr= UT_LIST_GET_NEXT(thrs, thr)))
-        thr= UT_LIST_GET_FIRST(purge_sys.query->thrs);
-      ++*n_work_items;
-      table_node= static_cast<purge_node_t *>(thr->child);
-
-      ut_a(que_node_get_type(table_node) == QUE_NODE_PURGE);
-      ut_d(auto pair=) table_node->tables.emplace(table_id, p);
-      ut_ad(pair.second);
-      if (p.first)
-        goto enqueue;
+      t.node[0]= trx_purge_node_assign(thd, mdl_context, table_id, thr,
+                                       n_work_items);
+      const dict_table_t *table= t.node[0]->tables[table_id].first;
+      t.n_parts= n_tasks > 1 && purge_hot_tables.count(table_id) &&
+        table && trx_purge_table_can_split(*table) ? n_tasks : 1;
+      if (t.n_parts > 1)
+        purge_sys.n_split_tables++;
     }
-    else if (table_node->tables[table_id].first)
+
+    purge_node_t *node= t.node[0];
+    if (const dict_table_t *table= node->tables[table_id].first)
     {
-    enqueue:
-      table_node->undo_recs.push(purge_rec);
-      ut_ad(!table_node->in_progress);
+      if (t.n_parts > 1)
+        if (unsigned part= trx_purge_rec_partition(purge_rec.undo_rec,
+                                                   *table, t.n_parts))
+        {
+          if (!t.node[part])
+            t.node[part]= trx_purge_node_assign(thd, mdl_context, table_id,
+                                                thr, n_work_items);
+          node= t.node[part];
+          if (!node->tables[table_id].first)
+            goto next;
+        }
+      node->undo_recs.push(purge_rec);
+      ut_ad(!node->in_progress);
     }
 
+  next:
     if (purge_sys.n_pages_handled() >= max_pages)
       break;
   }
 
+  /* Remember the tables that got more than their share of this batch. */
+  purge_hot_tables.clear();
+  if (n_tasks > 1)
+  {
+    size_t n_recs= 0;
+    for (const auto &t : table_id_map)
+      n_recs+= t.second.n_recs;
+    for (const auto &t : table_id_map)
+      if (t.second.n_recs > n_tasks && t.second.n_recs * n_tasks > n_recs)
+        purge_hot_tables.emplace(t.first);
+  }
+
   purge_sys.m_active= false;
 
 #ifdef UNIV_DEBUG
@@ -1373,7 +1530,8 @@ TRANSACTIONAL_TARGET ulint trx_purge(ulint n_tasks, ulint history_size)
 
   /* Fetch the UNDO recs that need to be purged. */
   ulint n_work= 0;
-  const purge_sys_t::iterator head= trx_purge_attach_undo_recs(thd, &n_work);
+  const purge_sys_t::iterator head=
+    trx_purge_attach_undo_recs(thd, &n_work, unsigned(n_tasks));
   const size_t n_pages= purge_sys.n_pages_handled();
 
   {
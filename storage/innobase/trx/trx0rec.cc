@@ -605,8 +605,8 @@ trx_undo_rec_get_row_ref(
 @param ptr    part of an update undo log record
 @param index  clustered index
 @return pointer to remaining part of undo record */
-static const byte *trx_undo_rec_skip_row_ref(const byte *ptr,
-                                             const dict_index_t *index)
+const byte *trx_undo_rec_skip_row_ref(const byte *ptr,
+                                      const dict_index_t *index)
 {
 	ut_ad(index->is_primary());
 
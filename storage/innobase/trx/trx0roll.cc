@@ -180,6 +180,8 @@ dberr_t trx_t::rollback(trx_savept_t *savept)
   if (!savept && is_wsrep() && wsrep_thd_is_SR(mysql_thd))
     wsrep_handle_SR_rollback(nullptr, mysql_thd);
 #endif /* WITH_WSREP */
+  if (savept && bulk_insert_non_empty && savept->least_undo_no < undo_no)
+    bulk_insert_non_empty_rollback(savept);
   rollback_low(savept);
   return error_state;
 }
@@ -146,6 +146,8 @@ void trx_sys_t::create()
   m_initialised= true;
   trx_list.create();
   rw_trx_hash.init();
+  snapshot_cache.latch.init();
+  snapshot_cache.version= ~uint64_t{0};
   for (auto &rseg : temp_rsegs)
     rseg.init(nullptr, FIL_NULL);
   for (auto &rseg : rseg_array)
@@ -325,6 +327,7 @@ trx_sys_t::close()
 	}
 
 	rw_trx_hash.destroy();
+	snapshot_cache.latch.destroy();
 
 	/* There can't be any active transactions. */
 	for (auto& rseg : temp_rsegs) rseg.destroy();
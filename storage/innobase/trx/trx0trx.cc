@@ -142,6 +142,8 @@ trx_init(
 
 	trx->bulk_insert = false;
 
+	trx->bulk_insert_non_empty = false;
+
 	trx->apply_online_log = false;
 
 	ut_d(trx->start_file = 0);
@@ -156,6 +158,8 @@ trx_init(
 
 	trx->lock.rec_cached = 0;
 
+	trx->lock.rec_last = nullptr;
+
 	trx->lock.table_cached = 0;
 #ifdef WITH_WSREP
 	ut_ad(!trx->wsrep);
@@ -1526,7 +1530,7 @@ void trx_t::commit_cleanup()
   ut_ad(!dict_operation);
   ut_ad(!was_dict_operation);
 
-  if (is_bulk_insert())
+  if (is_bulk_insert() || bulk_insert_non_empty)
     for (auto &t : mod_tables)
       delete t.second.bulk_store;
 
@@ -1803,6 +1807,12 @@ trx_mark_sql_stat_end(
 			return;
 		}
 
+		if (trx->bulk_insert_non_empty) {
+			/* Insert the buffered secondary index entries
+			of an INSERT into a non-empty table. */
+			trx->error_state = trx->bulk_insert_apply();
+		}
+
 		trx->last_sql_stat_start.least_undo_no = trx->undo_no;
 		trx->end_bulk_insert();
 		return;
@@ -0,0 +1,114 @@
+/* Copyright (c) 2026, MariaDB Corporation.
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1335  USA */
+
+/* Micro-benchmarks for srw_mutex, srw_lock and ssux_lock contention */
+
+#include <thread>
+#include "bench.h"
+#include "my_sys.h"
+#include "srw_lock.h"
+
+ulong srv_n_spin_wait_rounds= 30;
+uint srv_spin_wait_delay= 4;
+
+constexpr unsigned MAX_THREADS= 64;
+/** In the read-mostly workload, one of this many acquisitions is exclusive */
+constexpr unsigned WRITE_RATIO= 16;
+
+/** Shared data protected by the lock being measured */
+static ulonglong protected_counter;
+
+template<typename L> struct lock_arg
+{
+  L lock;
+  unsigned n_threads;
+};
+
+template<typename L>
+static void lock_thread(lock_arg<L> *a, ulonglong iterations)
+{
+  for (ulonglong i= iterations; i--; )
+  {
+    a->lock.wr_lock();
+    protected_counter++;
+    a->lock.wr_unlock();
+  }
+}
+
+template<typename L>
+static void rd_lock_thread(lock_arg<L> *a, ulonglong iterations)
+{
+  ulonglong sum= 0;
+  for (ulonglong i= iterations; i--; )
+  {
+    if (i % WRITE_RATIO)
+    {
+      a->lock.rd_lock();
+      sum+= protected_counter;
+      a->lock.rd_unlock();
+    }
+    else
+    {
+      a->lock.wr_lock();
+      protected_counter++;
+      a->lock.wr_unlock();
+    }
+  }
+  bench_sink+= sum;
+}
+
+/** Run a workload concurrently; iterations are split among the threads */
+template<typename L, void (*f)(lock_arg<L>*, ulonglong)>
+static void bench_lock(void *arg, ulonglong iterations)
+{
+  lock_arg<L> *a= static_cast<lock_arg<L>*>(arg);
+  std::thread t[MAX_THREADS];
+  const ulonglong n= iterations / a->n_threads + 1;
+  for (unsigned i= a->n_threads; i--; )
+    t[i]= std::thread(f, a, n);
+  for (unsigned i= a->n_threads; i--; )
+    t[i].join();
+}
+
+template<typename L, void (*f)(lock_arg<L>*, ulonglong)>
+static void run(const char *name, unsigned n_threads)
+{
+  static lock_arg<L> a;
+  a.lock.init();
+  a.n_threads= n_threads;
+  bench_run(name, n_threads, 0, bench_lock<L, f>, &a);
+  a.lock.destroy();
+}
+
+int main(int argc, char **argv)
+{
+  static const unsigned thread_counts[]= {1, 4, 16, 64};
+
+  MY_INIT(argv[0]);
+  bench_init(argc, argv);
+
+  for (unsigned n : thread_counts)
+  {
+    typedef ssux_lock_impl<false> ssux_lock;
+    run<srw_mutex, lock_thread<srw_mutex>>("srw_mutex", n);
+    run<srw_lock_low, lock_thread<srw_lock_low>>("srw_lock", n);
+    run<srw_lock_low, rd_lock_thread<srw_lock_low>>("srw_lock_read_mostly", n);
+    run<ssux_lock, lock_thread<ssux_lock>>("ssux_lock", n);
+    run<ssux_lock, rd_lock_thread<ssux_lock>>("ssux_lock_read_mostly", n);
+  }
+
+  my_end(0);
+  return 0;
+}
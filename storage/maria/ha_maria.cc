@@ -58,6 +58,7 @@ C_MODE_END
 #define THD_TRN (TRN*) thd_get_ha_data(thd, maria_hton)
 
 ulong pagecache_division_limit, pagecache_age_threshold, pagecache_file_hash_size;
+ulong pagecache_segments;
 ulonglong pagecache_buffer_size;
 const char *zerofill_error_msg=
   "Table is probably from another system and must be zerofilled or repaired ('REPAIR TABLE table_name') to be usable on this system";
@@ -234,6 +235,15 @@ static MYSQL_SYSVAR_ULONG(pagecache_file_hash_size, pagecache_file_hash_size,
        "value is probably 1/10 of number of possible open Aria files", 0,0,
        512, 128, 16384, 1);
 
+static MYSQL_SYSVAR_ULONG(pagecache_segments, pagecache_segments,
+       PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
+       "Number of parts the page cache is split into. aria_pagecache_buffer_size "
+       "is divided evenly between them. The first part is used for normal "
+       "tables and the others, chosen round-robin, for internal temporary "
+       "tables so that these do not all contend on the same page cache lock. "
+       "The Aria_pagecache status variables only cover the first part", 0, 0,
+       1, 1, 64, 1);
+
 static MYSQL_SYSVAR_SET(recover_options, maria_recover_options, PLUGIN_VAR_OPCMDARG,
        "Specifies how corrupted tables should be automatically repaired",
        NULL, NULL, HA_RECOVER_BACKUP|HA_RECOVER_QUICK, &maria_recover_typelib);
@@ -324,7 +334,8 @@ static PSI_thread_info all_aria_threads[]=
 {
   { &key_thread_checkpoint, "checkpoint_bg", PSI_FLAG_GLOBAL},
   { &key_thread_soft_sync, "soft_sync_bg", PSI_FLAG_GLOBAL},
-  { &key_thread_find_all_keys, "find_all_keys", 0}
+  { &key_thread_find_all_keys, "find_all_keys", 0},
+  { &key_thread_recovery_preload, "recovery_preload", 0}
 };
 
 static PSI_file_info all_aria_files[]=
@@ -1676,9 +1687,9 @@ int ha_maria::repair(THD *thd, HA_CHECK *param, bool do_optimize)
       local_testflag |= T_STATISTICS;
       param->testflag |= T_STATISTICS;           // We get this for free
       statistics_done= 1;
-      /* TODO: Remove BLOCK_RECORD test when parallel works with blocks */
       if (THDVAR(thd,repair_threads) > 1 &&
-          share->data_file_type != BLOCK_RECORD)
+          maria_test_if_parallel_rep(param, file,
+                                     MY_TEST(param->testflag & T_QUICK)))
       {
         char buf[40];
         /* TODO: respect maria_repair_threads variable */
@@ -3925,9 +3936,16 @@ static int ha_maria_init(void *p)
     ((force_start_after_recovery_failures != 0 && !aria_readonly) &&
      mark_recovery_start(log_dir)) ||
     !init_pagecache(maria_pagecache,
-                    (size_t) pagecache_buffer_size, pagecache_division_limit,
+                    (size_t) (pagecache_buffer_size / pagecache_segments),
+                    pagecache_division_limit,
                     pagecache_age_threshold, maria_block_size, pagecache_file_hash_size,
                     0) ||
+    multi_pagecache_init_tmp(pagecache_segments - 1,
+                             (size_t) (pagecache_buffer_size /
+                                       pagecache_segments),
+                             pagecache_division_limit,
+                             pagecache_age_threshold, maria_block_size,
+                             pagecache_file_hash_size) ||
     !init_pagecache(maria_log_pagecache,
                     TRANSLOG_PAGECACHE_SIZE, 0, 0,
                     TRANSLOG_PAGE_SIZE, 0, 0) ||
@@ -4050,6 +4068,7 @@ static struct st_mysql_sys_var *system_variables[]= {
   MYSQL_SYSVAR(pagecache_buffer_size),
   MYSQL_SYSVAR(pagecache_division_limit),
   MYSQL_SYSVAR(pagecache_file_hash_size),
+  MYSQL_SYSVAR(pagecache_segments),
   MYSQL_SYSVAR(recover_options),
   MYSQL_SYSVAR(repair_threads),
   MYSQL_SYSVAR(sort_buffer_size),
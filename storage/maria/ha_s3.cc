@@ -81,6 +81,7 @@ static PAGECACHE s3_pagecache;
 static ulong s3_block_size, s3_protocol_version, s3_provider;
 static ulong s3_pagecache_division_limit, s3_pagecache_age_threshold;
 static ulong s3_pagecache_file_hash_size;
+static ulong s3_read_ahead_threads, s3_read_ahead_blocks;
 static ulonglong s3_pagecache_buffer_size;
 static char *s3_bucket, *s3_access_key=0, *s3_secret_key=0, *s3_region;
 static char *s3_host_name;
@@ -250,6 +251,18 @@ static MYSQL_SYSVAR_ENUM(provider, s3_provider,
                          "\"Default\", \"Amazon\", or \"Huawei\"",
                          NULL, NULL, 0, &s3_provider_typelib);
 
+static MYSQL_SYSVAR_ULONG(read_ahead_threads, s3_read_ahead_threads,
+       PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
+       "Number of threads that read S3 blocks ahead of scans that read "
+       "a table or index in order. 0 disables read ahead",
+       0, 0, 4, 0, 64, 1);
+
+static MYSQL_SYSVAR_ULONG(read_ahead_blocks, s3_read_ahead_blocks,
+       PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
+       "Number of blocks a scan can have read ahead. Each of them uses "
+       "s3_block_size bytes of memory until the scan uses it",
+       0, 0, 4, 1, 64, 1);
+
 ha_create_table_option s3_table_option_list[]=
 {
   /*
@@ -772,6 +785,7 @@ static int s3_hton_panic(handlerton *hton, ha_panic_function flag)
   if (flag == HA_PANIC_CLOSE && s3_hton)
   {
     end_pagecache(&s3_pagecache, TRUE);
+    s3_read_ahead_end();
     s3_deinit_library();
     my_free(s3_access_key);
     my_free(s3_secret_key);
@@ -1095,12 +1109,16 @@ static int ha_s3_init(void *p)
   s3_init_library();
   if (s3_debug)
     ms3_debug(1);
+  if (s3_read_ahead_init(s3_read_ahead_threads, s3_read_ahead_blocks))
+    sql_print_warning("S3: Could not start read ahead threads. "
+                      "Read ahead is disabled");
 
   struct s3_func s3f_real =
   {
     ms3_set_option, s3_free, ms3_deinit, s3_unique_file_number,
     read_index_header, s3_check_frm_version, s3_info_copy,
-    set_database_and_table_from_path, s3_open_connection
+    set_database_and_table_from_path, s3_open_connection,
+    s3_free_read_ahead
   };
   s3f= s3f_real;
 
@@ -1124,6 +1142,7 @@ static SHOW_VAR status_variables[]= {
    (char*) &s3_pagecache.global_cache_r_requests, SHOW_LONGLONG},
   {"pagecache_reads",
    (char*) &s3_pagecache.global_cache_read, SHOW_LONGLONG},
+  {"read_ahead_hits", (char*) &s3_read_ahead_hits, SHOW_LONGLONG},
   {NullS, NullS, SHOW_LONG}
 };
 
@@ -1148,6 +1167,8 @@ static struct st_mysql_sys_var* system_variables[]= {
   MYSQL_SYSVAR(replicate_alter_as_create_select),
   MYSQL_SYSVAR(no_content_type),
   MYSQL_SYSVAR(provider),
+  MYSQL_SYSVAR(read_ahead_threads),
+  MYSQL_SYSVAR(read_ahead_blocks),
   NULL
 };
 
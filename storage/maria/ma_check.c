@@ -4318,6 +4318,14 @@ int maria_repair_by_sort(HA_CHECK *param, register MARIA_HA *info,
       copies its write buffer to the read buffer for the other threads
       and wakes them.
 
+    Block records
+
+      Only quick repair is possible, see maria_test_if_parallel_rep().
+      Block records are read through the page cache, so instead of
+      sharing a read buffer every thread scans the data file with a
+      handler of its own. The threads read the same pages at about the
+      same time, so most pages are read from disk only once.
+
   RESULT
     0	ok
     <>0	Error
@@ -4345,7 +4353,11 @@ int maria_repair_parallel(HA_CHECK *param, register MARIA_HA *info,
   myf sync_dir= ((share->now_transactional && !share->temporary) ?
                  MY_SYNC_DIR : 0);
   my_bool reenable_logging= 0;
+  my_bool block_record= share->data_file_type == BLOCK_RECORD;
+  enum pagecache_page_type save_page_type= share->page_type;
+  uint scans_inited= 0;
   DBUG_ENTER("maria_repair_parallel");
+  DBUG_ASSERT(maria_test_if_parallel_rep(param, info, rep_quick));
 
   got_error= 1;
   new_file= -1;
@@ -4408,7 +4420,8 @@ int maria_repair_parallel(HA_CHECK *param, register MARIA_HA *info,
 			 share->base.max_key_block_length)))
     goto err;
 
-  if (init_io_cache(&param->read_cache, info->dfile.file,
+  if (!block_record &&
+      init_io_cache(&param->read_cache, info->dfile.file,
                     (uint) param->read_buffer_length,
                     READ_CACHE, share->pack.header_length, 1, MYF(MY_WME)))
     goto err;
@@ -4586,6 +4599,37 @@ int maria_repair_parallel(HA_CHECK *param, register MARIA_HA *info,
   if (!maria_ftparser_alloc_param(info))
     goto err;
 
+  if (block_record)
+  {
+    /*
+      Every thread scans the data file with a handler of its own. The
+      first thread uses the handler of the table that is repaired.
+    */
+    share->state.state.data_file_length= sort_info.filelength;
+    for (i=0 ; i < sort_info.total_keys ; i++)
+    {
+      MARIA_HA *scan_info= info;
+      if (i && (!(scan_info= maria_open(share->open_file_name.str, O_RDONLY,
+                                        HA_OPEN_FOR_REPAIR, 0)) ||
+                scan_info->s != share))
+      {
+        _ma_check_print_error(param, "Can't open table for parallel repair; "
+                              "error: %d", my_errno);
+        if (scan_info)
+          maria_close(scan_info);
+        goto err;
+      }
+      if (maria_scan_init(scan_info))
+      {
+        if (scan_info != info)
+          maria_close(scan_info);
+        goto err;
+      }
+      sort_param[i].scan_info= scan_info;
+      scans_inited++;
+    }
+  }
+
   sort_info.got_error=0;
   mysql_mutex_lock(&sort_info.mutex);
 
@@ -4595,7 +4639,7 @@ int maria_repair_parallel(HA_CHECK *param, register MARIA_HA *info,
     the cache lock, the writer copies the write cache contents to the
     read caches.
   */
-  if (i > 1)
+  if (i > 1 && !block_record)
   {
     if (rep_quick)
       init_io_cache_share(&param->read_cache, &io_share, NULL, i);
@@ -4616,6 +4660,9 @@ int maria_repair_parallel(HA_CHECK *param, register MARIA_HA *info,
     that two threads does not use the same THD at once.
   */
   param->malloc_flags= 0;
+  /* See the comment about the page type in sort_get_next_record() */
+  if (block_record)
+    share->page_type= PAGECACHE_READ_UNKNOWN_PAGE;
   for (i=0 ; i < sort_info.total_keys ; i++)
   {
     /*
@@ -4665,6 +4712,7 @@ int maria_repair_parallel(HA_CHECK *param, register MARIA_HA *info,
   while (sort_info.threads_running)
     mysql_cond_wait(&sort_info.cond, &sort_info.mutex);
   mysql_mutex_unlock(&sort_info.mutex);
+  share->page_type= save_page_type;
 
   if ((got_error= _ma_thr_write_keys(sort_param)))
   {
@@ -4765,6 +4813,13 @@ int maria_repair_parallel(HA_CHECK *param, register MARIA_HA *info,
     *info->state= *info->state_start= share->state.state;
 
 err:
+  /* Free the handlers used for scanning block records */
+  for (i=0 ; i < scans_inited ; i++)
+  {
+    maria_scan_end(sort_param[i].scan_info);
+    if (sort_param[i].scan_info != info)
+      maria_close(sort_param[i].scan_info);
+  }
   _ma_reset_state(info);
 
   /*
@@ -4990,6 +5045,13 @@ static int sort_get_next_record(MARIA_SORT_PARAM *sort_param)
   switch (sort_info->org_data_file_type) {
   case BLOCK_RECORD:
   {
+    /*
+      In parallel repair every thread scans the table with its own
+      handler. The page type and data file length are then set by
+      maria_repair_parallel() and only the master updates the shared
+      progress and trid information.
+    */
+    MARIA_HA *scan_info= sort_param->scan_info ? sort_param->scan_info : info;
     for (;;)
     {
       int flag;
@@ -5002,7 +5064,8 @@ static int sort_get_next_record(MARIA_SORT_PARAM *sort_param)
         UNKNOWN.
       */
       enum pagecache_page_type save_page_type= share->page_type;
-      share->page_type= PAGECACHE_READ_UNKNOWN_PAGE;
+      if (!sort_param->scan_info)
+        share->page_type= PAGECACHE_READ_UNKNOWN_PAGE;
       if (info != sort_info->new_info)
       {
         /* Safe scanning */
@@ -5015,46 +5078,51 @@ static int sort_get_next_record(MARIA_SORT_PARAM *sort_param)
           Scan on clean table.
           It requires a reliable data_file_length so we set it.
         */
-        share->state.state.data_file_length= sort_info->filelength;
-        info->cur_row.trid= 0;
-        flag= _ma_scan_block_record(info, sort_param->record,
-                                    info->cur_row.nextpos, 1);
-        set_if_bigger(param->max_found_trid, info->cur_row.trid);
-        if (info->cur_row.trid > param->max_trid)
+        if (!sort_param->scan_info)
+          share->state.state.data_file_length= sort_info->filelength;
+        scan_info->cur_row.trid= 0;
+        flag= _ma_scan_block_record(scan_info, sort_param->record,
+                                    scan_info->cur_row.nextpos, 1);
+        if (sort_param->master)
+          set_if_bigger(param->max_found_trid, scan_info->cur_row.trid);
+        if (scan_info->cur_row.trid > param->max_trid)
         {
-          _ma_check_print_not_visible_error(param, info->cur_row.trid);
+          _ma_check_print_not_visible_error(param, scan_info->cur_row.trid);
           flag= HA_ERR_ROW_NOT_VISIBLE;
         }
       }
-      param->progress= (ma_recordpos_to_page(info->cur_row.lastpos)*
-                        share->block_size);
+      if (sort_param->master)
+        param->progress= (ma_recordpos_to_page(scan_info->cur_row.lastpos)*
+                          share->block_size);
 
-      share->page_type= save_page_type;
+      if (!sort_param->scan_info)
+        share->page_type= save_page_type;
       if (!flag)
       {
 	if (sort_param->calc_checksum)
         {
           ha_checksum checksum;
-          checksum= (*share->calc_check_checksum)(info, sort_param->record);
+          checksum= (*share->calc_check_checksum)(scan_info,
+                                                  sort_param->record);
           if (share->calc_checksum &&
-              info->cur_row.checksum != (checksum & 255))
+              scan_info->cur_row.checksum != (checksum & 255))
           {
             if (param->testflag & T_VERBOSE)
             {
               _ma_check_print_info(param,
                                    "Found record with wrong checksum at %s",
-                                   record_pos_to_txt(info,
-                                                     info->cur_row.lastpos,
+                                   record_pos_to_txt(scan_info,
+                                                     scan_info->cur_row.lastpos,
                                                      llbuff));
 
             }
             continue;
           }
-          info->cur_row.checksum= checksum;
+          scan_info->cur_row.checksum= checksum;
 	  param->glob_crc+= checksum;
         }
         sort_param->start_recpos= sort_param->current_filepos=
-          info->cur_row.lastpos;
+          scan_info->cur_row.lastpos;
         DBUG_RETURN(0);
       }
       if (flag == HA_ERR_END_OF_FILE)
@@ -6655,6 +6723,29 @@ my_bool maria_test_if_sort_rep(MARIA_HA *info, ha_rows rows,
 }
 
 
+/*
+  Return TRUE if we can use maria_repair_parallel
+
+  Block records are not read through a shared read cache; every repair
+  thread scans the data file with a handler of its own. This only works
+  when the data file is left as it is and no rows have to be removed
+  while the indexes are created.
+*/
+
+my_bool maria_test_if_parallel_rep(HA_CHECK *param, MARIA_HA *info,
+                                   my_bool rep_quick)
+{
+  MARIA_SHARE *share= info->s;
+
+  if (share->data_file_type == BLOCK_RECORD)
+    return (rep_quick && !share->internal_table &&
+            !(param->testflag & T_FORCE_UNIQUENESS));
+  /* Unpacking to block records is done with a new handler */
+  return !((param->testflag & T_UNPACK) &&
+           share->state.header.org_data_file_type == BLOCK_RECORD);
+}
+
+
 /**
    @brief Create a new handle for manipulation the new record file
 
@@ -258,6 +258,8 @@ int maria_close(register MARIA_HA *info)
 
   delete_dynamic(&info->pinned_pages);
 #ifdef WITH_S3_STORAGE_ENGINE
+  if (info->s3_read_ahead)
+    s3f.free_read_ahead(info);
   if (info->s3)
     s3f.deinit(info->s3);
 #endif /* WITH_S3_STORAGE_ENGINE */
@@ -8172,6 +8172,17 @@ my_bool translog_flush(TRANSLOG_ADDRESS lsn)
       DBUG_RETURN(0);
     }
     log_descriptor.next_pass_max_lsn= LSN_IMPOSSIBLE;
+    /*
+      The pass we waited for often took our LSN along (it was written
+      before the pass closed the current buffer). Then all waiting
+      goals are reached, as ours was the biggest one, and a new pass
+      would only sync() what was written by others after our LSN.
+    */
+    if (cmp_translog_addr(log_descriptor.flushed, lsn) >= 0)
+    {
+      mysql_mutex_unlock(&log_descriptor.log_flush_lock);
+      DBUG_RETURN(0);
+    }
   }
   log_descriptor.flush_in_progress= 1;
   flush_horizon= log_descriptor.previous_flush_horizon;
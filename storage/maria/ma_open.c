@@ -332,9 +332,12 @@ MARIA_HA *maria_open(const char *name, int mode, uint open_flags,
     share= &share_buff;
     bzero((uchar*) &share_buff,sizeof(share_buff));
     share_buff.state.key_root=key_root;
-    share_buff.pagecache= multi_pagecache_search((uchar*) name_buff,
-						 (uint) strlen(name_buff),
-                                                 maria_pagecache);
+    if (internal_table)
+      share_buff.pagecache= multi_pagecache_next_tmp(maria_pagecache);
+    else
+      share_buff.pagecache= multi_pagecache_search((uchar*) name_buff,
+                                                   (uint) strlen(name_buff),
+                                                   maria_pagecache);
 
     if (!s3)
     {
@@ -355,6 +355,12 @@ extern my_bool multi_pagecache_set(const uchar *key, uint length,
 				   PAGECACHE *pagecache);
 extern void multi_pagecache_change(PAGECACHE *old_data,
 				   PAGECACHE *new_data);
+extern my_bool multi_pagecache_init_tmp(uint count, size_t use_mem,
+                                        uint division_limit,
+                                        uint age_threshold, uint block_size,
+                                        uint changed_blocks_hash_size);
+extern void multi_pagecache_end_tmp(void);
+extern PAGECACHE *multi_pagecache_next_tmp(PAGECACHE *def);
 #ifndef DBUG_OFF
 void pagecache_file_no_dirty_page(PAGECACHE *pagecache, PAGECACHE_FILE *file);
 #else
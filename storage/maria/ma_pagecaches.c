@@ -102,3 +102,89 @@ void multi_pagecache_change(PAGECACHE *old_data,
 {
   safe_hash_change(&pagecache_hash, (uchar*) old_data, (uchar*) new_data);
 }
+
+
+/*****************************************************************************
+  Page cache segments for internal temporary tables
+
+  Internal temporary tables are never logged nor checkpointed, so they do
+  not have to share maria_pagecache with the other tables. Giving them a
+  few extra page caches of their own, handed out round-robin when a table
+  is opened, spreads their cache_lock contention over several mutexes.
+*****************************************************************************/
+
+PAGECACHE *maria_tmp_pagecaches;
+uint maria_tmp_pagecache_count;
+static volatile int32 maria_tmp_pagecache_next;
+
+/*
+  Create the page caches used by internal temporary tables
+
+  SYNOPSIS
+    multi_pagecache_init_tmp()
+    count			Number of page caches to create
+    use_mem			Memory to use for each page cache
+    others			As for init_pagecache()
+
+  RETURN
+    0  ok (also if count is 0)
+    1  error
+*/
+
+my_bool multi_pagecache_init_tmp(uint count, size_t use_mem,
+                                 uint division_limit, uint age_threshold,
+                                 uint block_size,
+                                 uint changed_blocks_hash_size)
+{
+  uint i;
+  DBUG_ENTER("multi_pagecache_init_tmp");
+
+  if (!count)
+    DBUG_RETURN(0);
+  if (!(maria_tmp_pagecaches= (PAGECACHE*)
+        my_malloc(PSI_INSTRUMENT_ME, sizeof(PAGECACHE) * count,
+                  MYF(MY_WME | MY_ZEROFILL))))
+    DBUG_RETURN(1);
+  for (i= 0; i < count; i++)
+  {
+    if (!init_pagecache(maria_tmp_pagecaches + i, use_mem, division_limit,
+                        age_threshold, block_size, changed_blocks_hash_size,
+                        0))
+    {
+      maria_tmp_pagecache_count= i;
+      multi_pagecache_end_tmp();
+      DBUG_RETURN(1);
+    }
+  }
+  maria_tmp_pagecache_count= count;
+  DBUG_RETURN(0);
+}
+
+
+void multi_pagecache_end_tmp(void)
+{
+  uint i;
+  for (i= 0; i < maria_tmp_pagecache_count; i++)
+    end_pagecache(maria_tmp_pagecaches + i, TRUE);
+  my_free(maria_tmp_pagecaches);
+  maria_tmp_pagecaches= 0;
+  maria_tmp_pagecache_count= 0;
+}
+
+
+/*
+  Get the page cache to use for a new internal temporary table
+
+  RETURN
+    def if there are no temporary table page caches
+*/
+
+PAGECACHE *multi_pagecache_next_tmp(PAGECACHE *def)
+{
+  uint32 next;
+  if (!maria_tmp_pagecache_count)
+    return def;
+  next= (uint32) my_atomic_add32_explicit(&maria_tmp_pagecache_next, 1,
+                                          MY_MEMORY_ORDER_RELAXED);
+  return maria_tmp_pagecaches + next % maria_tmp_pagecache_count;
+}
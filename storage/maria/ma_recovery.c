@@ -133,6 +133,7 @@ static void new_transaction(uint16 sid, TrID long_id, LSN undo_lsn,
 static int new_table(uint16 sid, const char *name, LSN lsn_of_file_id);
 static int new_page(uint32 fileid, pgcache_page_no_t pageid, LSN rec_lsn,
                     struct st_dirty_page *dirty_page);
+static void preload_dirty_pages();
 static int close_all_tables(my_bool force_end_newline);
 static my_bool close_one_table(const char *name, TRANSLOG_ADDRESS addr);
 static void print_redo_phase_progress(TRANSLOG_ADDRESS addr);
@@ -345,6 +346,8 @@ int maria_apply_log(LSN from_lsn, LSN end_redo_lsn, LSN end_undo_lsn,
         trnman_destroy();
         goto err;
       }
+      if (apply == MARIA_LOG_APPLY)
+        preload_dirty_pages();
     }
   }
 
@@ -3482,6 +3485,166 @@ static int new_page(uint32 fileid, pgcache_page_no_t pageid, LSN rec_lsn,
 }
 
 
+/*
+  Reading of the dirty pages of the checkpoint into the page cache.
+
+  The REDO phase is single-threaded and, for a big dirty pages list, spends
+  most of its time waiting for the synchronous reads of those pages. As we
+  know them before the REDO phase starts, a few threads read them in
+  parallel first, after which the REDO phase finds them in the page cache.
+  Nothing is changed in the pages here, so the order of the reads does not
+  matter and all errors are left for the REDO phase to find.
+*/
+
+#define PRELOAD_THREADS 4
+#define PRELOAD_PAGES_PER_THREAD 128
+
+struct st_preload_page
+{
+  MARIA_HA *info;
+  PAGECACHE_FILE *file;
+  pgcache_page_no_t page;
+};
+
+static struct st_preload_page *preload_pages;
+static uint32 preload_count;
+static int32 volatile preload_next;
+
+
+static int cmp_preload_page(const void *a, const void *b)
+{
+  const struct st_preload_page *pa= (const struct st_preload_page *) a;
+  const struct st_preload_page *pb= (const struct st_preload_page *) b;
+  if (pa->file != pb->file)
+    return pa->file < pb->file ? -1 : 1;
+  return pa->page < pb->page ? -1 : (pa->page > pb->page ? 1 : 0);
+}
+
+
+static void preload_pages_exec(uchar *buff)
+{
+  for (;;)
+  {
+    uint32 i= (uint32) my_atomic_add32(&preload_next, 1);
+    struct st_preload_page *page;
+    PAGECACHE *pagecache;
+    if (i >= preload_count)
+      break;
+    page= preload_pages + i;
+    pagecache= page->info->s->pagecache;
+    if (!pagecache_read(pagecache, page->file, page->page, 0, buff,
+                        PAGECACHE_PLAIN_PAGE, PAGECACHE_LOCK_LEFT_UNLOCKED,
+                        0))
+    {
+      /* Don't leave a block in error; REDO phase will read it again */
+      pagecache_delete(pagecache, page->file, page->page,
+                       PAGECACHE_LOCK_WRITE, FALSE);
+    }
+  }
+}
+
+
+static pthread_handler_t preload_pages_thread(void *arg)
+{
+  uchar *buff= (uchar*) arg;
+  if (!my_thread_init())
+  {
+    preload_pages_exec(buff);
+    my_thread_end();
+  }
+  return 0;
+}
+
+
+static void preload_dirty_pages()
+{
+  ulong i;
+  uint threads, started;
+  size_t buff_size= maria_pagecache->block_size;
+  uchar *buffs;
+  pthread_t thr[PRELOAD_THREADS];
+  DBUG_ENTER("preload_dirty_pages");
+
+  preload_count= 0;
+  if (!all_dirty_pages.records || maria_pagecache->blocks < 2 ||
+      !(preload_pages= (struct st_preload_page *)
+        my_malloc(PSI_INSTRUMENT_ME, all_dirty_pages.records *
+                  sizeof(*preload_pages), MYF(0))))
+    DBUG_VOID_RETURN;
+
+  for (i= 0; i < all_dirty_pages.records; i++)
+  {
+    struct st_dirty_page *dirty_page= dirty_pages_pool + i;
+    uint32 fileid= (uint32) (dirty_page->file_and_page_id >> 40);
+    pgcache_page_no_t page= (dirty_page->file_and_page_id &
+                             ((1ULL << 40) - 1));
+    my_bool is_index= MY_TEST(fileid >> 16);
+    MARIA_HA *info= all_tables[fileid & 0xFFFF].info;
+    MARIA_SHARE *share;
+    my_off_t file_length;
+
+    if (info == NULL)
+      continue;
+    share= info->s;
+    if (share->data_file_type != BLOCK_RECORD)
+      continue;
+    if (is_index)
+      file_length= share->state.state.key_file_length;
+    else
+    {
+      /* Bitmap pages are handled by ma_bitmap.c */
+      if (page % share->bitmap.pages_covered == 0)
+        continue;
+      file_length= share->state.state.data_file_length;
+    }
+    /* A page past the end of the file is created by the REDO phase */
+    if ((page + 1) * share->block_size > file_length)
+      continue;
+    preload_pages[preload_count].info= info;
+    preload_pages[preload_count].file= is_index ? &share->kfile : &info->dfile;
+    preload_pages[preload_count].page= page;
+    preload_count++;
+  }
+  /*
+    Fill at most half of the cache, so that the first pages read are not
+    pushed out again before the REDO phase gets to them.
+  */
+  set_if_smaller(preload_count, (uint32) (maria_pagecache->blocks / 2));
+  if (!preload_count)
+    goto end;
+  /* Read the pages of each file in order */
+  my_qsort(preload_pages, preload_count, sizeof(*preload_pages),
+           cmp_preload_page);
+
+  threads= (preload_count + PRELOAD_PAGES_PER_THREAD - 1) /
+    PRELOAD_PAGES_PER_THREAD;
+  set_if_smaller(threads, PRELOAD_THREADS);
+  if (!(buffs= (uchar*) my_malloc(PSI_INSTRUMENT_ME, threads * buff_size,
+                                  MYF(0))))
+    goto end;
+  tprint(tracef, "Reading %u dirty pages with %u threads\n",
+         (uint) preload_count, threads);
+  preload_next= 0;
+  /* The first part is done by this thread, when the others are started */
+  for (started= 0; started < threads - 1; started++)
+  {
+    if (mysql_thread_create(key_thread_recovery_preload, &thr[started], NULL,
+                            preload_pages_thread,
+                            (void*) (buffs + (started + 1) * buff_size)))
+      break;
+  }
+  preload_pages_exec(buffs);
+  while (started--)
+    pthread_join(thr[started], NULL);
+  my_free(buffs);
+
+end:
+  my_free(preload_pages);
+  preload_pages= NULL;
+  DBUG_VOID_RETURN;
+}
+
+
 static int close_all_tables(my_bool force_end_newline)
 {
   int error= 0;
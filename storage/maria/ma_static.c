@@ -141,7 +141,7 @@ PSI_rwlock_key key_KEYINFO_root_lock, key_SHARE_mmap_lock,
                key_TRANSLOG_DESCRIPTOR_open_files_lock;
 
 PSI_thread_key key_thread_checkpoint, key_thread_find_all_keys,
-               key_thread_soft_sync;
+               key_thread_soft_sync, key_thread_recovery_preload;
 
 PSI_file_key key_file_translog, key_file_kfile, key_file_dfile,
              key_file_control, key_file_tmp;
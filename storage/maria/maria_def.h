@@ -183,6 +183,7 @@ struct st_maria_decode_tree     /* Decode huff-table */
 
 
 typedef struct s3_info S3_INFO;
+typedef struct s3_read_ahead S3_READ_AHEAD;
 
 extern ulong maria_block_size, maria_checkpoint_frequency;
 extern ulong maria_concurrent_insert;
@@ -306,6 +307,8 @@ void maria_disable_indexes_for_rebuild(MARIA_HA *info, ha_rows rows,
                                        my_bool all_keys);
 my_bool maria_test_if_sort_rep(MARIA_HA *info, ha_rows rows, ulonglong key_map,
                                my_bool force);
+my_bool maria_test_if_parallel_rep(HA_CHECK *param, MARIA_HA *info,
+                                   my_bool rep_quick);
 
 int maria_init_bulk_insert(MARIA_HA *info, size_t cache_size, ha_rows rows);
 void maria_flush_bulk_insert(MARIA_HA *info, uint inx);
@@ -397,6 +400,7 @@ typedef struct st_maria_sort_param
   uchar *record;
   MY_TMPDIR *tmpdir;
   HA_CHECK *check_param;
+  MARIA_HA *scan_info;            /* For parallel repair of block records */
 
   /* 
     The next two are used to collect statistics, see maria_update_key_parts for
@@ -945,6 +949,7 @@ struct st_maria_handler
   MARIA_STATUS_INFO *state_start;       /* State at start of transaction */
   MARIA_USED_TABLES *used_tables;
   struct ms3_st *s3;
+  S3_READ_AHEAD *s3_read_ahead;         /* Blocks read ahead from s3 */
   void **stack_end_ptr;
   MARIA_ROW cur_row;                    /* The active row that we just read */
   MARIA_ROW new_row;			/* Storage for a row during update */
@@ -1306,7 +1311,7 @@ extern PSI_rwlock_key key_KEYINFO_root_lock, key_SHARE_mmap_lock,
                       key_TRANSLOG_DESCRIPTOR_open_files_lock;
 
 extern PSI_thread_key key_thread_checkpoint, key_thread_find_all_keys,
-                      key_thread_soft_sync;
+                      key_thread_soft_sync, key_thread_recovery_preload;
 
 extern PSI_file_key key_file_translog, key_file_kfile, key_file_dfile,
                     key_file_control, key_file_tmp;
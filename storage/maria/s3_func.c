@@ -155,6 +155,7 @@ ms3_st *s3_open_connection(S3_INFO *s3)
                     "Can't open connection to S3, error: %d %s", MYF(0),
                     errno, ms3_error(errno));
     my_errno= HA_ERR_NO_SUCH_TABLE;
+    return 0;
   }
 
   /* Provider specific overrides */
@@ -1002,6 +1003,66 @@ int s3_put_object(ms3_st *s3_client, const char *aws_bucket,
 }
 
 
+/**
+   Uncompress a block read from s3 with compression
+
+   In case of error the block is freed and my_error() is called
+*/
+
+static int s3_unpack_block(S3_BLOCK *block, const char *name)
+{
+  ulong length;
+  uchar *data;
+
+  /* If not compressed */
+  if (!block->str[0])
+  {
+    block->length-= COMPRESS_HEADER;
+    block->str+=    COMPRESS_HEADER;
+
+    /* Simple check to ensure that it's a correct block */
+    if (block->length % 1024)
+    {
+      s3_free(block);
+      my_printf_error(HA_ERR_NOT_A_TABLE,
+                      "Block '%s' is not compressed", MYF(0), name);
+      return HA_ERR_NOT_A_TABLE;
+    }
+    return 0;
+  }
+
+  if (((uchar*)block->str)[0] > 1)
+  {
+    s3_free(block);
+    my_printf_error(HA_ERR_NOT_A_TABLE,
+                    "Block '%s' is not compressed", MYF(0), name);
+    return HA_ERR_NOT_A_TABLE;
+  }
+
+  length= uint3korr(block->str+1);
+
+  if (!(data= (uchar*) my_malloc(PSI_NOT_INSTRUMENTED,
+                                 length, MYF(MY_WME | MY_THREAD_SPECIFIC))))
+  {
+    s3_free(block);
+    return EE_OUTOFMEMORY;
+  }
+  if (uncompress(data, &length, block->str + COMPRESS_HEADER,
+                 block->length - COMPRESS_HEADER))
+  {
+    my_printf_error(ER_NET_UNCOMPRESS_ERROR,
+                    "Got error uncompressing s3 packet", MYF(0));
+    s3_free(block);
+    my_free(data);
+    return ER_NET_UNCOMPRESS_ERROR;
+  }
+  s3_free(block);
+  block->str= block->alloc_ptr= data;
+  block->length= length;
+  return 0;
+}
+
+
 /**
    Read an object for index or data information
 
@@ -1016,7 +1077,6 @@ int s3_get_object(ms3_st *s3_client, const char *aws_bucket,
 {
   uint8_t error;
   int result= 0;
-  uchar *data;
   DBUG_ENTER("s3_get_object");
   DBUG_PRINT("enter", ("name: %s  compression: %d", name, compression));
 
@@ -1027,55 +1087,7 @@ int s3_get_object(ms3_st *s3_client, const char *aws_bucket,
   {
     block->str= block->alloc_ptr;
     if (compression)
-    {
-      ulong length;
-
-      /* If not compressed */
-      if (!block->str[0])
-      {
-        block->length-= COMPRESS_HEADER;
-        block->str+=    COMPRESS_HEADER;
-
-        /* Simple check to ensure that it's a correct block */
-        if (block->length % 1024)
-        {
-          s3_free(block);
-          my_printf_error(HA_ERR_NOT_A_TABLE,
-                          "Block '%s' is not compressed", MYF(0), name);
-          DBUG_RETURN(HA_ERR_NOT_A_TABLE);
-        }
-        DBUG_RETURN(0);
-      }
-
-      if (((uchar*)block->str)[0] > 1)
-      {
-        s3_free(block);
-        my_printf_error(HA_ERR_NOT_A_TABLE,
-                        "Block '%s' is not compressed", MYF(0), name);
-        DBUG_RETURN(HA_ERR_NOT_A_TABLE);
-      }
-
-      length= uint3korr(block->str+1);
-
-      if (!(data= (uchar*) my_malloc(PSI_NOT_INSTRUMENTED,
-                                     length, MYF(MY_WME | MY_THREAD_SPECIFIC))))
-      {
-        s3_free(block);
-        DBUG_RETURN(EE_OUTOFMEMORY);
-      }
-      if (uncompress(data, &length, block->str + COMPRESS_HEADER,
-                     block->length - COMPRESS_HEADER))
-      {
-        my_printf_error(ER_NET_UNCOMPRESS_ERROR,
-                        "Got error uncompressing s3 packet", MYF(0));
-        s3_free(block);
-        my_free(data);
-        DBUG_RETURN(ER_NET_UNCOMPRESS_ERROR);
-      }
-      s3_free(block);
-      block->str= block->alloc_ptr= data;
-      block->length= length;
-    }
+      DBUG_RETURN(s3_unpack_block(block, name));
     DBUG_RETURN(0);
   }
 
@@ -1611,6 +1623,378 @@ my_bool s3_block_read(struct st_pagecache *pagecache,
 }
 #endif
 
+/******************************************************************************
+ Read ahead of big blocks
+
+ When a handler reads the blocks of a file in order, the following blocks
+ are fetched by a pool of threads while the handler works on the current
+ one. This way a scan is limited by the network bandwidth rather than by
+ the latency of one GET per block.
+
+ The blocks are handed over to the page cache when it asks for them, so
+ read ahead uses no page cache memory for blocks that are never used.
+ Blocks are fetched without uncompressing them, as the memory for the
+ uncompressed block must be allocated by the thread that uses it.
+******************************************************************************/
+
+enum s3_read_ahead_state
+{
+  S3_BLOCK_FREE= 0, S3_BLOCK_QUEUED, S3_BLOCK_READING, S3_BLOCK_READ
+};
+
+typedef struct st_s3_read_ahead_block
+{
+  struct st_s3_read_ahead_block *next;          /* Next in read queue */
+  S3_INFO *s3;
+  S3_BLOCK block;
+  ulong block_number;
+  int error;
+  enum s3_read_ahead_state state;
+  my_bool datafile;
+  char aws_path[AWS_PATH_LENGTH];
+} S3_READ_AHEAD_BLOCK;
+
+/* Read ahead state of one handler, stored in MARIA_HA->s3_read_ahead */
+
+struct s3_read_ahead
+{
+  ulong last_block[2];                  /* Last block read from index, data */
+  uint in_order[2];                     /* Blocks read in order */
+  S3_READ_AHEAD_BLOCK block[1];         /* read_ahead_blocks elements */
+};
+
+static mysql_mutex_t read_ahead_lock;
+static mysql_cond_t read_ahead_queued, read_ahead_done;
+static S3_READ_AHEAD_BLOCK *read_ahead_queue, **read_ahead_queue_end;
+static pthread_t *read_ahead_thread_ids;
+static uint read_ahead_threads, read_ahead_blocks;
+static my_bool read_ahead_stop;
+ulonglong s3_read_ahead_hits;
+
+/*
+  Blocks are only read ahead after this many blocks have been read in
+  order, so that a single lookup doesn't start reading the whole file
+*/
+#define S3_READ_AHEAD_MIN_IN_ORDER 2
+
+
+static void s3_block_path(char *to, S3_INFO *s3, my_bool datafile,
+                          ulong block_number)
+{
+  char *end;
+  end= strxnmov(to, AWS_PATH_LENGTH-12, s3->database.str, "/",
+                s3->table.str, datafile ? "/data/" : "/index/", "000000",
+                NullS);
+  fix_suffix(end, block_number);
+}
+
+
+/* Check if a connection opened for 'a' can be used for 'b' */
+
+static my_bool s3_same_connection(S3_INFO *a, S3_INFO *b)
+{
+  return (!strcmp(a->access_key.str, b->access_key.str) &&
+          !strcmp(a->secret_key.str, b->secret_key.str) &&
+          !strcmp(a->region.str, b->region.str) &&
+          !strcmp(a->host_name.str, b->host_name.str) &&
+          a->port == b->port && a->use_http == b->use_http &&
+          a->ssl_no_verify == b->ssl_no_verify &&
+          a->no_content_type == b->no_content_type &&
+          a->protocol_version == b->protocol_version &&
+          a->provider == b->provider);
+}
+
+
+static void *s3_read_ahead_thread(void *arg __attribute__((unused)))
+{
+  ms3_st *client= 0;
+  S3_INFO *client_info= 0;
+  my_thread_init();
+
+  mysql_mutex_lock(&read_ahead_lock);
+  while (!read_ahead_stop)
+  {
+    S3_READ_AHEAD_BLOCK *ra;
+    if (!(ra= read_ahead_queue))
+    {
+      mysql_cond_wait(&read_ahead_queued, &read_ahead_lock);
+      continue;
+    }
+    if (!(read_ahead_queue= ra->next))
+      read_ahead_queue_end= &read_ahead_queue;
+    ra->state= S3_BLOCK_READING;
+    mysql_mutex_unlock(&read_ahead_lock);
+
+    /* Keep the connection as long as tables use the same S3 settings */
+    if (client && !s3_same_connection(client_info, ra->s3))
+    {
+      s3_deinit(client);
+      my_free(client_info);
+      client= 0;
+    }
+    if (!client && (client_info= s3_info_copy(ra->s3)) &&
+        !(client= s3_open_connection(client_info)))
+    {
+      my_free(client_info);
+      client_info= 0;
+    }
+    ra->error= (client ?
+                s3_get_object(client, ra->s3->bucket.str, ra->aws_path,
+                              &ra->block, 0, 0) :
+                EE_READ);
+
+    mysql_mutex_lock(&read_ahead_lock);
+    ra->state= S3_BLOCK_READ;
+    mysql_cond_broadcast(&read_ahead_done);
+  }
+  mysql_mutex_unlock(&read_ahead_lock);
+
+  if (client)
+  {
+    s3_deinit(client);
+    my_free(client_info);
+  }
+  my_thread_end();
+  return 0;
+}
+
+
+/**
+   Start the threads that read blocks ahead
+
+   @param threads  Number of threads. 0 disables read ahead
+   @param blocks   Max number of blocks read ahead for one handler
+*/
+
+my_bool s3_read_ahead_init(uint threads, uint blocks)
+{
+  uint i;
+  if (!threads || !blocks)
+    return 0;
+
+  if (!(read_ahead_thread_ids= (pthread_t*)
+        my_malloc(PSI_NOT_INSTRUMENTED, sizeof(pthread_t) * threads,
+                  MYF(MY_WME))))
+    return 1;
+  mysql_mutex_init(0, &read_ahead_lock, MY_MUTEX_INIT_FAST);
+  mysql_cond_init(0, &read_ahead_queued, 0);
+  mysql_cond_init(0, &read_ahead_done, 0);
+  read_ahead_queue= 0;
+  read_ahead_queue_end= &read_ahead_queue;
+  read_ahead_stop= 0;
+  read_ahead_blocks= blocks;
+
+  for (i= 0; i < threads; i++)
+  {
+    if (mysql_thread_create(0, read_ahead_thread_ids + i, NULL,
+                            s3_read_ahead_thread, NULL))
+      break;
+  }
+  read_ahead_threads= i;
+  if (!i)
+  {
+    s3_read_ahead_end();
+    return 1;
+  }
+  return 0;
+}
+
+
+/**
+   Stop the read ahead threads. All tables must have been closed
+*/
+
+void s3_read_ahead_end()
+{
+  uint i;
+  if (!read_ahead_thread_ids)
+    return;
+
+  mysql_mutex_lock(&read_ahead_lock);
+  DBUG_ASSERT(!read_ahead_queue);
+  read_ahead_stop= 1;
+  mysql_cond_broadcast(&read_ahead_queued);
+  mysql_mutex_unlock(&read_ahead_lock);
+  for (i= 0; i < read_ahead_threads; i++)
+    pthread_join(read_ahead_thread_ids[i], NULL);
+
+  my_free(read_ahead_thread_ids);
+  read_ahead_thread_ids= 0;
+  read_ahead_threads= 0;
+  mysql_cond_destroy(&read_ahead_done);
+  mysql_cond_destroy(&read_ahead_queued);
+  mysql_mutex_destroy(&read_ahead_lock);
+}
+
+
+static void s3_unqueue_block(S3_READ_AHEAD_BLOCK *ra)
+{
+  S3_READ_AHEAD_BLOCK **pos;
+  mysql_mutex_assert_owner(&read_ahead_lock);
+  DBUG_ASSERT(ra->state == S3_BLOCK_QUEUED);
+
+  for (pos= &read_ahead_queue; *pos != ra; pos= &(*pos)->next)
+    ;
+  if (!(*pos= ra->next))
+    read_ahead_queue_end= pos;
+  ra->state= S3_BLOCK_FREE;
+}
+
+
+/* Forget a block that is queued or has been read */
+
+static void s3_discard_block(S3_READ_AHEAD_BLOCK *ra)
+{
+  if (ra->state == S3_BLOCK_QUEUED)
+    s3_unqueue_block(ra);
+  else if (ra->state == S3_BLOCK_READ)
+  {
+    if (!ra->error)
+      s3_free(&ra->block);
+    ra->state= S3_BLOCK_FREE;
+  }
+}
+
+
+/**
+   Free the read ahead state of a handler, when the handler is closed
+*/
+
+void s3_free_read_ahead(MARIA_HA *info)
+{
+  S3_READ_AHEAD *read_ahead= info->s3_read_ahead;
+  S3_READ_AHEAD_BLOCK *ra, *end;
+
+  mysql_mutex_lock(&read_ahead_lock);
+  for (ra= read_ahead->block, end= ra + read_ahead_blocks; ra < end; ra++)
+  {
+    while (ra->state == S3_BLOCK_READING)
+      mysql_cond_wait(&read_ahead_done, &read_ahead_lock);
+    s3_discard_block(ra);
+  }
+  mysql_mutex_unlock(&read_ahead_lock);
+  my_free(read_ahead);
+  info->s3_read_ahead= 0;
+}
+
+
+/*
+  Get a block from the blocks read ahead for a handler, and start reading
+  the blocks after it if the handler reads the file in order
+
+  @return 0  The block was not read ahead. Caller has to read it
+  @return 1  The block was read ahead and is returned in 'block'
+*/
+
+static my_bool s3_read_ahead_block(MARIA_HA *info,
+                                   struct st_pagecache *pagecache,
+                                   struct st_pagecache_file *file,
+                                   my_bool datafile, ulong block_number,
+                                   S3_BLOCK *block)
+{
+  MARIA_SHARE *share= info->s;
+  S3_READ_AHEAD *read_ahead= info->s3_read_ahead;
+  S3_READ_AHEAD_BLOCK *ra, *end, *found= 0, *free_block;
+  ulong first= block_number + 1, last= block_number + read_ahead_blocks;
+  ulong next;
+  uint file_nr= datafile ? 1 : 0;
+  my_bool queued= 0;
+
+  if (!read_ahead)
+  {
+    if (!(read_ahead= (S3_READ_AHEAD*)
+          my_malloc(PSI_NOT_INSTRUMENTED,
+                    sizeof(S3_READ_AHEAD) +
+                    sizeof(S3_READ_AHEAD_BLOCK) * (read_ahead_blocks - 1),
+                    MYF(MY_ZEROFILL))))
+      return 0;
+    info->s3_read_ahead= read_ahead;
+  }
+  end= read_ahead->block + read_ahead_blocks;
+
+  mysql_mutex_lock(&read_ahead_lock);
+  for (ra= read_ahead->block; ra < end; ra++)
+  {
+    if (ra->state == S3_BLOCK_FREE || ra->datafile != datafile)
+      continue;
+    if (ra->block_number == block_number)
+      found= ra;
+    else if (ra->block_number < first || ra->block_number > last)
+      s3_discard_block(ra);                     /* Not going to be used */
+  }
+
+  if (found)
+  {
+    if (found->state == S3_BLOCK_QUEUED)
+    {
+      /* Not started yet; faster that the caller reads it at once */
+      s3_unqueue_block(found);
+      found= 0;
+    }
+    else
+    {
+      while (found->state == S3_BLOCK_READING)
+        mysql_cond_wait(&read_ahead_done, &read_ahead_lock);
+      found->state= S3_BLOCK_FREE;
+      if (found->error)
+        found= 0;               /* Read it again to get the error message */
+      else
+      {
+        *block= found->block;
+        s3_read_ahead_hits++;
+      }
+    }
+  }
+
+  if (block_number == read_ahead->last_block[file_nr] + 1)
+    read_ahead->in_order[file_nr]++;
+  else
+    read_ahead->in_order[file_nr]= 0;
+  read_ahead->last_block[file_nr]= block_number;
+
+  if (read_ahead->in_order[file_nr] >= S3_READ_AHEAD_MIN_IN_ORDER)
+  {
+    my_off_t file_length= (datafile ? share->state.state.data_file_length :
+                           share->state.state.key_file_length);
+    my_off_t start= (my_off_t) file->head_blocks << pagecache->shift;
+    ulong blocks= 0;
+    if (file_length > start)
+      blocks= (ulong) ((file_length - start + file->big_block_size - 1) /
+                       file->big_block_size);
+    set_if_smaller(last, blocks);
+
+    free_block= read_ahead->block;
+    for (next= first; next <= last; next++)
+    {
+      for (ra= read_ahead->block; ra < end; ra++)
+      {
+        if (ra->state != S3_BLOCK_FREE && ra->datafile == datafile &&
+            ra->block_number == next)
+          break;
+      }
+      if (ra != end)
+        continue;                               /* Already read ahead */
+      while (free_block < end && free_block->state != S3_BLOCK_FREE)
+        free_block++;
+      if (free_block == end)
+        break;
+      free_block->s3= share->s3_path;
+      free_block->datafile= datafile;
+      free_block->block_number= next;
+      free_block->next= 0;
+      s3_block_path(free_block->aws_path, share->s3_path, datafile, next);
+      free_block->state= S3_BLOCK_QUEUED;
+      *read_ahead_queue_end= free_block;
+      read_ahead_queue_end= &free_block->next;
+      queued= 1;
+    }
+    if (queued)
+      mysql_cond_broadcast(&read_ahead_queued);
+  }
+  mysql_mutex_unlock(&read_ahead_lock);
+  return found != 0;
+}
+
 
 /**
    Read a block from S3 to page cache
@@ -1626,8 +2010,6 @@ my_bool s3_block_read(struct st_pagecache *pagecache,
   my_bool datafile= file->file != share->kfile.file;
   MARIA_HA *info= (MARIA_HA*) my_thread_var->keycache_file;
   ms3_st *client= info->s3;
-  const char *path_suffix= datafile ? "/data/" : "/index/";
-  char *end;
   S3_INFO *s3= share->s3_path;
   ulong block_number;
   DBUG_ENTER("s3_block_read");
@@ -1640,9 +2022,16 @@ my_bool s3_block_read(struct st_pagecache *pagecache,
   block_number= (((args->pageno - file->head_blocks) << pagecache->shift) /
                  file->big_block_size) + 1;
 
-  end= strxnmov(aws_path, sizeof(aws_path)-12, s3->database.str, "/",
-                s3->table.str, path_suffix, "000000", NullS);
-  fix_suffix(end, block_number);
+  s3_block_path(aws_path, s3, datafile, block_number);
+
+  if (read_ahead_threads &&
+      s3_read_ahead_block(info, pagecache, file, datafile, block_number,
+                          block))
+  {
+    if (share->base.compression_algorithm)
+      DBUG_RETURN(s3_unpack_block(block, aws_path) != 0);
+    DBUG_RETURN(0);
+  }
 
   DBUG_RETURN(s3_get_object(client, s3->bucket.str, aws_path, block,
                             share->base.compression_algorithm, 1));
@@ -35,6 +35,7 @@ extern struct s3_func {
   S3_INFO *(*info_copy)(S3_INFO *);
   my_bool (*set_database_and_table_from_path)(S3_INFO *, const char *);
   ms3_st *(*open_connection)(S3_INFO *);
+  void (*free_read_ahead)(MARIA_HA *);
 } s3f;
 
 extern TYPELIB s3_protocol_typelib;
@@ -140,6 +141,10 @@ my_bool s3_block_read(struct st_pagecache *pagecache,
                       PAGECACHE_IO_HOOK_ARGS *args,
                       struct st_pagecache_file *file,
                       S3_BLOCK *block);
+my_bool s3_read_ahead_init(uint threads, uint blocks);
+void s3_read_ahead_end(void);
+void s3_free_read_ahead(MARIA_HA *info);
+extern ulonglong s3_read_ahead_hits;
 C_MODE_END
 #else
 
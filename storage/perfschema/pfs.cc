@@ -5032,6 +5032,9 @@ pfs_get_thread_statement_locker_v1(PSI_statement_locker_state *state,
       pfs->m_event.m_timer_start= 0;
       pfs->m_event.m_timer_end= 0;
       pfs->m_lock_time= 0;
+      pfs->m_cpu_time= my_getcputime();
+      pfs->m_memory_allocated= pfs_thread->m_thd ?
+        pfs_thread->m_thd->status_var.memory_allocated : 0;
       pfs->m_current_schema_name_length= 0;
       pfs->m_sqltext_length= 0;
       pfs->m_sqltext_truncated= false;
@@ -5445,6 +5448,7 @@ void pfs_end_statement_v1(PSI_statement_locker *locker, void *stmt_da)
    Capture statement stats by digest.
   */
   const sql_digest_storage *digest_storage= NULL;
+  PFS_statements_digest_stat *digest_entry= NULL;
   PFS_statement_stat *digest_stat= NULL;
   PFS_program *pfs_program= NULL;
   PFS_prepared_stmt *pfs_prepared_stmt= NULL;
@@ -5464,9 +5468,11 @@ void pfs_end_statement_v1(PSI_statement_locker *locker, void *stmt_da)
       if (digest_storage != NULL)
       {
         /* Populate PFS_statements_digest_stat with computed digest information.*/
-        digest_stat= find_or_create_digest(thread, digest_storage,
-                                           state->m_schema_name,
-                                           state->m_schema_name_length);
+        digest_entry= find_or_create_digest(thread, digest_storage,
+                                            state->m_schema_name,
+                                            state->m_schema_name_length);
+        if (digest_entry != NULL)
+          digest_stat= & digest_entry->m_stat;
       }
     }
 
@@ -5510,6 +5516,18 @@ void pfs_end_statement_v1(PSI_statement_locker *locker, void *stmt_da)
       pfs->m_event.m_timer_end= timer_end;
       pfs->m_event.m_end_event_id= thread->m_event_id;
 
+      /*
+        The statement is executed by this OS thread from start to end,
+        also with the thread pool, so the thread CPU time is the one of
+        the statement.
+      */
+      ulonglong cpu_time= my_getcputime();
+      pfs->m_cpu_time= cpu_time > pfs->m_cpu_time ? cpu_time - pfs->m_cpu_time : 0;
+      ulonglong memory_allocated= thread->m_thd ?
+        thread->m_thd->status_var.memory_allocated : 0;
+      pfs->m_memory_allocated= memory_allocated >= pfs->m_memory_allocated ?
+        memory_allocated - pfs->m_memory_allocated : memory_allocated;
+
       if (digest_storage != NULL)
       {
         /*
@@ -5549,9 +5567,11 @@ void pfs_end_statement_v1(PSI_statement_locker *locker, void *stmt_da)
         if (digest_storage != NULL)
         {
           /* Populate statements_digest_stat with computed digest information. */
-          digest_stat= find_or_create_digest(thread, digest_storage,
-                                             state->m_schema_name,
-                                             state->m_schema_name_length);
+          digest_entry= find_or_create_digest(thread, digest_storage,
+                                              state->m_schema_name,
+                                              state->m_schema_name_length);
+          if (digest_entry != NULL)
+            digest_stat= & digest_entry->m_stat;
         }
       }
     }
@@ -5598,6 +5618,7 @@ void pfs_end_statement_v1(PSI_statement_locker *locker, void *stmt_da)
     if (flags & STATE_FLAG_TIMED)
     {
       digest_stat->aggregate_value(wait_time);
+      digest_entry->m_histogram.aggregate_value(wait_time);
     }
     else
     {
@@ -199,7 +199,7 @@ static LF_PINS* get_digest_hash_pins(PFS_thread *thread)
   return thread->m_digest_hash_pins;
 }
 
-PFS_statement_stat*
+PFS_statements_digest_stat*
 find_or_create_digest(PFS_thread *thread,
                       const sql_digest_storage *digest_storage,
                       const char *schema_name,
@@ -256,7 +256,7 @@ find_or_create_digest(PFS_thread *thread,
     pfs= *entry;
     pfs->m_last_seen= now;
     lf_hash_search_unpin(pins);
-    return & pfs->m_stat;
+    return pfs;
   }
 
   lf_hash_search_unpin(pins);
@@ -270,7 +270,7 @@ find_or_create_digest(PFS_thread *thread,
     if (pfs->m_first_seen == 0)
       pfs->m_first_seen= now;
     pfs->m_last_seen= now;
-    return & pfs->m_stat;
+    return pfs;
   }
 
   while (++attempts <= digest_max)
@@ -306,7 +306,7 @@ find_or_create_digest(PFS_thread *thread,
         if (likely(res == 0))
         {
           pfs->m_lock.dirty_to_allocated(& dirty_state);
-          return & pfs->m_stat;
+          return pfs;
         }
 
         pfs->m_lock.dirty_to_free(& dirty_state);
@@ -337,7 +337,7 @@ find_or_create_digest(PFS_thread *thread,
   if (pfs->m_first_seen == 0)
     pfs->m_first_seen= now;
   pfs->m_last_seen= now;
-  return & pfs->m_stat;
+  return pfs;
 }
 
 void purge_digest(PFS_thread* thread, PFS_digest_key *hash_key)
@@ -368,6 +368,7 @@ void PFS_statements_digest_stat::reset_data(unsigned char *token_array, size_t l
   m_lock.set_dirty(& dirty_state);
   m_digest_storage.reset(token_array, length);
   m_stat.reset();
+  m_histogram.reset();
   m_first_seen= 0;
   m_last_seen= 0;
   m_lock.dirty_to_free(& dirty_state);
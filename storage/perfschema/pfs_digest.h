@@ -63,6 +63,9 @@ struct PFS_ALIGNED PFS_statements_digest_stat
   /** Statement stat. */
   PFS_statement_stat m_stat;
 
+  /** Statement latency histogram, for the QUANTILE columns. */
+  PFS_histogram m_histogram;
+
   /** First and last seen timestamps.*/
   ulonglong m_first_seen;
   ulonglong m_last_seen;
@@ -78,10 +81,11 @@ void cleanup_digest();
 
 int init_digest_hash(const PFS_global_param *param);
 void cleanup_digest_hash(void);
-PFS_statement_stat* find_or_create_digest(PFS_thread *thread,
-                                          const sql_digest_storage *digest_storage,
-                                          const char *schema_name,
-                                          uint schema_name_length);
+PFS_statements_digest_stat*
+find_or_create_digest(PFS_thread *thread,
+                      const sql_digest_storage *digest_storage,
+                      const char *schema_name,
+                      uint schema_name_length);
 
 void reset_esms_by_digest();
 
@@ -55,6 +55,16 @@ struct PFS_events_statements
 
   /** Locked time. */
   ulonglong m_lock_time;
+  /**
+    CPU time of the thread, in 100 nanoseconds.
+    The value at the start of the statement until it ends.
+  */
+  ulonglong m_cpu_time;
+  /**
+    Bytes of memory allocated by the session.
+    The value at the start of the statement until it ends.
+  */
+  ulonglong m_memory_allocated;
 
   /** Diagnostics area, message text. */
   char m_message_text[MYSQL_ERRMSG_SIZE+1];
@@ -25,6 +25,7 @@
 
 #include <algorithm>
 #include "sql_const.h"
+#include "my_bit.h"
 /* memcpy */
 #include "string.h"
 
@@ -519,6 +520,78 @@ struct PFS_statement_stat
   }
 };
 
+/**
+  Log-bucketed latency histogram.
+  Each power of two is split in @c SUB_BUCKETS linear sub-buckets,
+  so that the relative error of a quantile is bounded by 1/SUB_BUCKETS,
+  independently of the latency range.
+  Values are expressed in timer units, like @c PFS_single_stat.
+*/
+struct PFS_histogram
+{
+  static const uint SUB_BUCKETS_BITS= 2;
+  static const uint SUB_BUCKETS= 1U << SUB_BUCKETS_BITS;
+  /** Highest power of two with its own buckets, larger values saturate. */
+  static const uint MAX_POWER= 47;
+  static const uint BUCKETS= (MAX_POWER - SUB_BUCKETS_BITS + 2) * SUB_BUCKETS;
+
+  ulonglong m_buckets[BUCKETS];
+
+  inline void reset()
+  {
+    memset(m_buckets, 0, sizeof(m_buckets));
+  }
+
+  static inline uint bucket_index(ulonglong value)
+  {
+    if (value < SUB_BUCKETS)
+      return (uint) value;
+    uint power= my_bit_log2_uint64(value);
+    if (power > MAX_POWER)
+      return BUCKETS - 1;
+    uint shift= power - SUB_BUCKETS_BITS;
+    return (shift + 1) * SUB_BUCKETS +
+           (uint) ((value >> shift) & (SUB_BUCKETS - 1));
+  }
+
+  /** Exclusive upper bound of the values counted in a bucket. */
+  static inline ulonglong bucket_limit(uint index)
+  {
+    if (index < SUB_BUCKETS)
+      return index + 1;
+    uint shift= index / SUB_BUCKETS - 1;
+    return (ulonglong) (SUB_BUCKETS + index % SUB_BUCKETS + 1) << shift;
+  }
+
+  inline void aggregate_value(ulonglong value)
+  {
+    m_buckets[bucket_index(value)]++;
+  }
+
+  /**
+    Estimate a quantile.
+    @param quantile requested quantile, in per mille
+    @return upper bound of the bucket holding the quantile
+  */
+  ulonglong get_quantile(uint quantile) const
+  {
+    ulonglong count= 0;
+    for (uint i= 0; i < BUCKETS; i++)
+      count+= m_buckets[i];
+    if (count == 0)
+      return 0;
+    ulonglong rank= (count * quantile + 999) / 1000;
+    ulonglong seen= 0;
+    for (uint i= 0; i < BUCKETS; i++)
+    {
+      seen+= m_buckets[i];
+      if (seen >= rank)
+        return bucket_limit(i);
+    }
+    return bucket_limit(BUCKETS - 1);
+  }
+};
+
 /** Statistics for transaction usage. */
 struct PFS_transaction_stat
 {
@@ -86,7 +86,10 @@ table_esms_by_digest::m_share=
                       "SUM_NO_INDEX_USED BIGINT unsigned not null comment 'Sum of the NO_INDEX_USED column in the events_statements_current table.',"
                       "SUM_NO_GOOD_INDEX_USED BIGINT unsigned not null comment 'Sum of the NO_GOOD_INDEX_USED column in the events_statements_current table.',"
                       "FIRST_SEEN TIMESTAMP(0) NOT NULL default 0 comment 'Time at which the digest was first seen.',"
-                      "LAST_SEEN TIMESTAMP(0) NOT NULL default 0 comment 'Time at which the digest was most recently seen.')") },
+                      "LAST_SEEN TIMESTAMP(0) NOT NULL default 0 comment 'Time at which the digest was most recently seen.',"
+                      "QUANTILE_50 BIGINT unsigned not null comment 'Statement latency median, in picoseconds.',"
+                      "QUANTILE_95 BIGINT unsigned not null comment 'Statement latency 95th percentile, in picoseconds.',"
+                      "QUANTILE_99 BIGINT unsigned not null comment 'Statement latency 99th percentile, in picoseconds.')") },
   false, /* m_perpetual */
   false, /* m_optional */
   &m_share_state
@@ -185,6 +188,18 @@ void table_esms_by_digest::make_row(PFS_statements_digest_stat* digest_stat)
   time_normalizer *normalizer= time_normalizer::get(statement_timer);
   m_row.m_stat.set(normalizer, & digest_stat->m_stat);
 
+  /*
+    The histogram gives the upper bound of the bucket holding a quantile,
+    never report more than the largest latency actually seen.
+  */
+  ulonglong max_wait= m_row.m_stat.m_timer1_row.m_max;
+  m_row.m_quantile_50= std::min(max_wait, normalizer->wait_to_pico(
+    digest_stat->m_histogram.get_quantile(500)));
+  m_row.m_quantile_95= std::min(max_wait, normalizer->wait_to_pico(
+    digest_stat->m_histogram.get_quantile(950)));
+  m_row.m_quantile_99= std::min(max_wait, normalizer->wait_to_pico(
+    digest_stat->m_histogram.get_quantile(990)));
+
   m_row_exists= true;
 }
 
@@ -221,6 +236,15 @@ ::read_row_values(TABLE *table, unsigned char *buf, Field **fields,
       case 28: /* LAST_SEEN */
         set_field_timestamp(f, m_row.m_last_seen);
         break;
+      case 29: /* QUANTILE_50 */
+        set_field_ulonglong(f, m_row.m_quantile_50);
+        break;
+      case 30: /* QUANTILE_95 */
+        set_field_ulonglong(f, m_row.m_quantile_95);
+        break;
+      case 31: /* QUANTILE_99 */
+        set_field_ulonglong(f, m_row.m_quantile_99);
+        break;
       default: /* 3, ... COUNT/SUM/MIN/AVG/MAX */
         m_row.m_stat.set_field(f->field_index - 3, f);
         break;
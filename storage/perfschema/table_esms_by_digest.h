@@ -52,6 +52,10 @@ struct row_esms_by_digest
   ulonglong m_first_seen;
   /** Column LAST_SEEN. */
   ulonglong m_last_seen;
+  /** Columns QUANTILE_50, QUANTILE_95, QUANTILE_99. */
+  ulonglong m_quantile_50;
+  ulonglong m_quantile_95;
+  ulonglong m_quantile_99;
 };
 
 /** Table PERFORMANCE_SCHEMA.EVENTS_STATEMENTS_SUMMARY_BY_DIGEST. */
@@ -96,7 +96,9 @@ table_events_statements_current::m_share=
                       "NO_GOOD_INDEX_USED BIGINT unsigned not null comment '0 if a good index was found for the statement, 1 if no good index was found. See the Range checked for each record description in the EXPLAIN article.',"
                       "NESTING_EVENT_ID BIGINT unsigned comment 'NULL for top level statements. The parent statement event id for nested statements (stored programs).',"
                       "NESTING_EVENT_TYPE ENUM('TRANSACTION', 'STATEMENT', 'STAGE', 'WAIT') comment 'NULL for top level statements. The parent statement event type for nested statements (stored programs).',"
-                      "NESTING_EVENT_LEVEL INT comment '0 for top level statements. The parent statement level plus 1 for nested statements (stored programs).')") },
+                      "NESTING_EVENT_LEVEL INT comment '0 for top level statements. The parent statement level plus 1 for nested statements (stored programs).',"
+                      "CPU_TIME BIGINT unsigned comment 'CPU time of the thread executing the statement, in picoseconds. NULL until the statement has ended.',"
+                      "MEMORY_ALLOCATED BIGINT unsigned comment 'Bytes of memory allocated by the statement, freed memory is not subtracted. NULL until the statement has ended.')") },
   false, /* m_perpetual */
   false, /* m_optional */
   &m_share_state
@@ -161,7 +163,9 @@ table_events_statements_history::m_share=
                       "NO_GOOD_INDEX_USED BIGINT unsigned not null comment '0 if a good index was found for the statement, 1 if no good index was found. See the Range checked for each record description in the EXPLAIN article.',"
                       "NESTING_EVENT_ID BIGINT unsigned comment 'NULL for top level statements. The parent statement event id for nested statements (stored programs).',"
                       "NESTING_EVENT_TYPE ENUM('TRANSACTION', 'STATEMENT', 'STAGE', 'WAIT') comment 'NULL for top level statements. The parent statement event type for nested statements (stored programs).',"
-                      "NESTING_EVENT_LEVEL INT comment '0 for top level statements. The parent statement level plus 1 for nested statements (stored programs).')") },
+                      "NESTING_EVENT_LEVEL INT comment '0 for top level statements. The parent statement level plus 1 for nested statements (stored programs).',"
+                      "CPU_TIME BIGINT unsigned comment 'CPU time of the thread executing the statement, in picoseconds. NULL until the statement has ended.',"
+                      "MEMORY_ALLOCATED BIGINT unsigned comment 'Bytes of memory allocated by the statement, freed memory is not subtracted. NULL until the statement has ended.')") },
   false, /* m_perpetual */
   false, /* m_optional */
   &m_share_state
@@ -226,7 +230,9 @@ table_events_statements_history_long::m_share=
                       "NO_GOOD_INDEX_USED BIGINT unsigned not null comment '0 if a good index was found for the statement, 1 if no good index was found. See the Range checked for each record description in the EXPLAIN article.',"
                       "NESTING_EVENT_ID BIGINT unsigned comment 'NULL for top level statements. The parent statement event id for nested statements (stored programs).',"
                       "NESTING_EVENT_TYPE ENUM('TRANSACTION', 'STATEMENT', 'STAGE', 'WAIT') comment 'NULL for top level statements. The parent statement event type for nested statements (stored programs).',"
-                      "NESTING_EVENT_LEVEL INT comment '0 for top level statements. The parent statement level plus 1 for nested statements (stored programs).')") },
+                      "NESTING_EVENT_LEVEL INT comment '0 for top level statements. The parent statement level plus 1 for nested statements (stored programs).',"
+                      "CPU_TIME BIGINT unsigned comment 'CPU time of the thread executing the statement, in picoseconds. NULL until the statement has ended.',"
+                      "MEMORY_ALLOCATED BIGINT unsigned comment 'Bytes of memory allocated by the statement, freed memory is not subtracted. NULL until the statement has ended.')") },
   false, /* m_perpetual */
   false, /* m_optional */
   &m_share_state
@@ -274,6 +280,8 @@ void table_events_statements_common::make_row_part_1(PFS_events_statements *stat
   m_normalizer->to_pico(statement->m_event.m_timer_start, timer_end,
                       & m_row.m_timer_start, & m_row.m_timer_end, & m_row.m_timer_wait);
   m_row.m_lock_time= statement->m_lock_time * MICROSEC_TO_PICOSEC;
+  m_row.m_cpu_time= statement->m_cpu_time * 100000;
+  m_row.m_memory_allocated= statement->m_memory_allocated;
 
   m_row.m_name= klass->m_name;
   m_row.m_name_length= klass->m_name_length;
@@ -586,6 +594,18 @@ int table_events_statements_common::read_row_values(TABLE *table,
       case 40: /* NESTING_EVENT_LEVEL */
           set_field_ulong(f, m_row.m_nesting_event_level);
         break;
+      case 41: /* CPU_TIME */
+        if (m_row.m_end_event_id != 0)
+          set_field_ulonglong(f, m_row.m_cpu_time);
+        else
+          f->set_null();
+        break;
+      case 42: /* MEMORY_ALLOCATED */
+        if (m_row.m_end_event_id != 0)
+          set_field_ulonglong(f, m_row.m_memory_allocated);
+        else
+          f->set_null();
+        break;
       default:
         assert(false);
       }
@@ -34,6 +34,7 @@
 #include <queue>
 #include <set>
 #include <string>
+#include <thread>
 #include <vector>
 
 /* MySQL includes */
@@ -1095,6 +1096,13 @@ static MYSQL_THDVAR_ULONG(bulk_load_size, PLUGIN_VAR_RQCMDARG,
                           /*min*/ 1,
                           /*max*/ RDB_MAX_BULK_LOAD_SIZE, 0);
 
+static MYSQL_THDVAR_UINT(
+    bulk_load_threads, PLUGIN_VAR_RQCMDARG,
+    "Number of threads that merge the sorted keys of different indexes into "
+    "SST files at the end of an unsorted bulk load. Each thread uses its own "
+    "rocksdb_merge_combine_read_size",
+    nullptr, nullptr, /* default */ 1, /* min */ 1, /* max */ 128, 0);
+
 static MYSQL_THDVAR_ULONGLONG(
     merge_buf_size, PLUGIN_VAR_RQCMDARG,
     "Size to allocate for merge sort buffers written out to disk "
@@ -1667,6 +1675,13 @@ static MYSQL_THDVAR_UINT(force_index_records_in_range, PLUGIN_VAR_RQCMDARG,
                          nullptr, nullptr, 0,
                          /* min */ 0, /* max */ INT_MAX, 0);
 
+static MYSQL_THDVAR_UINT(mrr_batch_size, PLUGIN_VAR_RQCMDARG,
+                         "Number of primary key lookups of a Multi-Range-Read "
+                         "that are read with one MultiGet() call. "
+                         "0 disables the use of MultiGet()",
+                         nullptr, nullptr, 100,
+                         /* min */ 0, /* max */ 64 * 1024, 0);
+
 static MYSQL_SYSVAR_UINT(
     debug_optimizer_n_rows, rocksdb_debug_optimizer_n_rows,
     PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY | PLUGIN_VAR_NOSYSVAR,
@@ -1999,6 +2014,7 @@ static struct st_mysql_sys_var *rocksdb_system_variables[] = {
     MYSQL_SYSVAR(read_free_rpl),
 #endif    
     MYSQL_SYSVAR(bulk_load_size),
+    MYSQL_SYSVAR(bulk_load_threads),
     MYSQL_SYSVAR(merge_buf_size),
     MYSQL_SYSVAR(enable_bulk_load_api),
     MYSQL_SYSVAR(tmpdir),
@@ -2086,6 +2102,7 @@ static struct st_mysql_sys_var *rocksdb_system_variables[] = {
 
     MYSQL_SYSVAR(records_in_range),
     MYSQL_SYSVAR(force_index_records_in_range),
+    MYSQL_SYSVAR(mrr_batch_size),
     MYSQL_SYSVAR(debug_optimizer_n_rows),
     MYSQL_SYSVAR(force_compute_memtable_stats),
     MYSQL_SYSVAR(force_compute_memtable_stats_cachetime),
@@ -2709,8 +2726,15 @@ class Rdb_transaction {
         purge_all_jemalloc_arenas();
       });
 
-      rocksdb::Slice merge_key;
-      rocksdb::Slice merge_val;
+      struct Rdb_bulk_load_merge {
+        Rdb_index_merge *rdb_merge;
+        std::shared_ptr<Rdb_sst_info> sst_info;
+        Rdb_sst_info::Rdb_sst_commit_info commit_info;
+        int rc;
+      };
+      std::vector<Rdb_bulk_load_merge> merges;
+      merges.reserve(m_key_merge.size());
+
       for (auto it = m_key_merge.begin(); it != m_key_merge.end(); it++) {
         GL_INDEX_ID index_id = it->first;
         std::shared_ptr<const Rdb_key_def> keydef =
@@ -2747,40 +2771,72 @@ class Rdb_transaction {
         // "./database/table"
         std::replace(table_name.begin(), table_name.end(), '.', '/');
         table_name = "./" + table_name;
-        auto sst_info = std::make_shared<Rdb_sst_info>(
+        merges.emplace_back();
+        Rdb_bulk_load_merge &merge = merges.back();
+        merge.rdb_merge = &rdb_merge;
+        merge.sst_info = std::make_shared<Rdb_sst_info>(
             rdb, table_name, index_name, rdb_merge.get_cf(),
             *rocksdb_db_options, THDVAR(get_thd(), trace_sst_api));
+        // Errors are reported to the client by this thread after the merge
+        merge.sst_info->defer_client_error();
+        merge.rc = 0;
+      }
+
+      // The indexes are independent of each other, so that their SST files
+      // can be written by several threads
+      std::atomic<size_t> next_merge(0);
+      auto merge_to_sst = [&merges, &next_merge, print_client_error]() {
+        rocksdb::Slice merge_key;
+        rocksdb::Slice merge_val;
+        for (size_t i; (i = next_merge.fetch_add(1)) < merges.size();) {
+          Rdb_bulk_load_merge &merge = merges[i];
+          int rc = 0;
+          int rc2;
+          while ((rc2 = merge.rdb_merge->next(&merge_key, &merge_val)) == 0) {
+            if ((rc2 = merge.sst_info->put(merge_key, merge_val)) != 0) {
+              rc = rc2;
+
+              // Don't return yet - make sure we finish the sst_info
+              break;
+            }
+          }
 
-        while ((rc2 = rdb_merge.next(&merge_key, &merge_val)) == 0) {
-          if ((rc2 = sst_info->put(merge_key, merge_val)) != 0) {
+          // -1 => no more items
+          if (rc2 != -1 && rc != 0) {
             rc = rc2;
-
-            // Don't return yet - make sure we finish the sst_info
-            break;
           }
-        }
 
-        // -1 => no more items
-        if (rc2 != -1 && rc != 0) {
-          rc = rc2;
+          rc2 = merge.sst_info->finish(&merge.commit_info, print_client_error);
+          if (rc2 != 0 && rc == 0) {
+            // Only set the error from sst_info->finish if finish failed and
+            // we didn't fail before. In other words, we don't have finish's
+            // success mask earlier failures
+            rc = rc2;
+          }
+          merge.rc = rc;
         }
+      };
 
-        Rdb_sst_info::Rdb_sst_commit_info commit_info;
-        rc2 = sst_info->finish(&commit_info, print_client_error);
-        if (rc2 != 0 && rc == 0) {
-          // Only set the error from sst_info->finish if finish failed and we
-          // didn't fail before. In other words, we don't have finish's
-          // success mask earlier failures
-          rc = rc2;
-        }
+      std::vector<std::thread> threads;
+      const size_t n_threads =
+          std::min<size_t>(THDVAR(get_thd(), bulk_load_threads), merges.size());
+      for (size_t i = 1; i < n_threads; i++) {
+        threads.emplace_back(merge_to_sst);
+      }
+      merge_to_sst();
+      for (auto &thread : threads) {
+        thread.join();
+      }
 
-        if (rc) {
-          return rc;
+      for (auto &merge : merges) {
+        if (merge.rc) {
+          merge.sst_info->report_deferred_client_error();
+          return merge.rc;
         }
 
-        if (commit_info.has_work()) {
-          sst_commit_list.emplace_back(std::move(commit_info));
-          DBUG_ASSERT(!commit_info.has_work());
+        if (merge.commit_info.has_work()) {
+          sst_commit_list.emplace_back(std::move(merge.commit_info));
+          DBUG_ASSERT(!merge.commit_info.has_work());
         }
       }
     }
@@ -2963,6 +3019,10 @@ class Rdb_transaction {
   virtual rocksdb::Status get(rocksdb::ColumnFamilyHandle *const column_family,
                               const rocksdb::Slice &key,
                               rocksdb::PinnableSlice *const value) const = 0;
+  virtual void multi_get(rocksdb::ColumnFamilyHandle *const column_family,
+                         const size_t num_keys, const rocksdb::Slice *keys,
+                         rocksdb::PinnableSlice *values,
+                         rocksdb::Status *statuses) const = 0;
   virtual rocksdb::Status get_for_update(
       rocksdb::ColumnFamilyHandle *const column_family,
       const rocksdb::Slice &key, rocksdb::PinnableSlice *const value,
@@ -3374,6 +3434,18 @@ class Rdb_transaction_impl : public Rdb_transaction {
     return m_rocksdb_tx->Get(m_read_opts, column_family, key, value);
   }
 
+  void multi_get(rocksdb::ColumnFamilyHandle *const column_family,
+                 const size_t num_keys, const rocksdb::Slice *keys,
+                 rocksdb::PinnableSlice *values,
+                 rocksdb::Status *statuses) const override {
+    for (size_t i = 0; i < num_keys; i++) {
+      values[i].Reset();
+      global_stats.queries[QUERIES_POINT].inc();
+    }
+    m_rocksdb_tx->MultiGet(m_read_opts, column_family, num_keys, keys, values,
+                           statuses);
+  }
+
   rocksdb::Status get_for_update(
       rocksdb::ColumnFamilyHandle *const column_family,
       const rocksdb::Slice &key, rocksdb::PinnableSlice *const value,
@@ -3663,6 +3735,17 @@ class Rdb_writebatch_impl : public Rdb_transaction {
                                       value);
   }
 
+  void multi_get(rocksdb::ColumnFamilyHandle *const column_family,
+                 const size_t num_keys, const rocksdb::Slice *keys,
+                 rocksdb::PinnableSlice *values,
+                 rocksdb::Status *statuses) const override {
+    for (size_t i = 0; i < num_keys; i++) {
+      values[i].Reset();
+    }
+    m_batch->MultiGetFromBatchAndDB(rdb, m_read_opts, column_family, num_keys,
+                                    keys, values, statuses, false);
+  }
+
   rocksdb::Status get_for_update(
       rocksdb::ColumnFamilyHandle *const column_family,
       const rocksdb::Slice &key, rocksdb::PinnableSlice *const value,
@@ -6353,7 +6436,11 @@ ha_rocksdb::ha_rocksdb(my_core::handlerton *const hton,
       m_dup_pk_found(false),
       m_in_rpl_delete_rows(false),
       m_in_rpl_update_rows(false),
-      m_force_skip_unique_check(false) {}
+      m_force_skip_unique_check(false),
+      m_mrr_multi_get(false),
+      m_mrr_end_of_ranges(false),
+      m_mrr_batch_size(0),
+      m_mrr_read_index(0) {}
 
 
 const std::string &ha_rocksdb::get_table_basename() const {
@@ -12069,6 +12156,216 @@ ha_rows ha_rocksdb::records_in_range(uint inx, const key_range *const min_key,
   DBUG_RETURN(ret);
 }
 
+/*
+  Multi-Range-Read with MultiGet()
+
+  Point lookups on the full primary key, from IN lists and from Batched Key
+  Access joins, are collected in batches of rocksdb_mrr_batch_size keys.
+  Each batch is read with one MultiGet() call, so that RocksDB can read the
+  data blocks of the batch in parallel and look up each block in the block
+  cache only once. The rows are returned in the order of the ranges. Any
+  other scan uses the default implementation, which reads the ranges one by
+  one.
+*/
+bool ha_rocksdb::mrr_can_use_multi_get(uint keyno, uint mrr_mode) {
+  THD *const thd = ha_thd();
+  return keyno == table->s->primary_key &&
+         !(mrr_mode & HA_MRR_USE_DEFAULT_IMPL) &&
+         (thd->variables.optimizer_switch & OPTIMIZER_SWITCH_MRR) &&
+         THDVAR(thd, mrr_batch_size) > 0;
+}
+
+ha_rows ha_rocksdb::multi_range_read_info_const(uint keyno, RANGE_SEQ_IF *seq,
+                                                void *seq_init_param,
+                                                uint n_ranges, uint *bufsz,
+                                                uint *flags, ha_rows limit,
+                                                Cost_estimate *cost) {
+  DBUG_ENTER_FUNC();
+
+  const uint mrr_mode = *flags;
+  const ha_rows rows = handler::multi_range_read_info_const(
+      keyno, seq, seq_init_param, n_ranges, bufsz, flags, limit, cost);
+
+  if (rows == HA_POS_ERROR || !mrr_can_use_multi_get(keyno, mrr_mode)) {
+    DBUG_RETURN(rows);
+  }
+
+  // Every range must be an equality on the full primary key
+  const uint key_parts = m_pk_descr->get_key_parts();
+  KEY_MULTI_RANGE range;
+  range_seq_t seq_it = seq->init(seq_init_param, n_ranges, mrr_mode);
+  while (!seq->next(seq_it, &range)) {
+    if ((range.range_flag & (EQ_RANGE | NULL_RANGE)) != EQ_RANGE ||
+        !is_using_full_key(range.start_key.keypart_map, key_parts)) {
+      DBUG_RETURN(rows);
+    }
+  }
+
+  *flags &= ~HA_MRR_USE_DEFAULT_IMPL;
+  DBUG_RETURN(rows);
+}
+
+ha_rows ha_rocksdb::multi_range_read_info(uint keyno, uint n_ranges, uint keys,
+                                          uint key_parts, uint *bufsz,
+                                          uint *flags, Cost_estimate *cost) {
+  DBUG_ENTER_FUNC();
+
+  const uint mrr_mode = *flags;
+  const ha_rows res = handler::multi_range_read_info(
+      keyno, n_ranges, keys, key_parts, bufsz, flags, cost);
+
+  // Batched Key Access looks up key_parts key parts of each key
+  if (mrr_can_use_multi_get(keyno, mrr_mode) &&
+      key_parts == m_pk_descr->get_key_parts()) {
+    *flags &= ~HA_MRR_USE_DEFAULT_IMPL;
+  }
+
+  DBUG_RETURN(res);
+}
+
+int ha_rocksdb::multi_range_read_init(RANGE_SEQ_IF *seq, void *seq_init_param,
+                                      uint n_ranges, uint mode,
+                                      HANDLER_BUFFER *buf) {
+  DBUG_ENTER_FUNC();
+
+  // Locking reads take the row locks one by one in get_row_by_rowid()
+  m_mrr_multi_get = !(mode & HA_MRR_USE_DEFAULT_IMPL) &&
+                    active_index == table->s->primary_key &&
+                    m_lock_rows == RDB_LOCK_NONE;
+  if (!m_mrr_multi_get) {
+    DBUG_RETURN(
+        handler::multi_range_read_init(seq, seq_init_param, n_ranges, mode,
+                                       buf));
+  }
+
+  mrr_iter = seq->init(seq_init_param, n_ranges, mode);
+  mrr_funcs = *seq;
+  m_mrr_end_of_ranges = false;
+  m_mrr_keys.clear();
+  m_mrr_read_index = 0;
+
+  const uint batch_size = THDVAR(ha_thd(), mrr_batch_size);
+  if (m_mrr_batch_size != batch_size) {
+    m_mrr_values.reset(new rocksdb::PinnableSlice[batch_size]);
+    m_mrr_statuses.resize(batch_size);
+    m_mrr_batch_size = batch_size;
+  }
+
+  DBUG_RETURN(HA_EXIT_SUCCESS);
+}
+
+/**
+  Read the records of the next batch of ranges.
+
+  @return
+    HA_EXIT_SUCCESS      OK
+    HA_ERR_END_OF_FILE   No more ranges
+*/
+int ha_rocksdb::mrr_fill_buffer() {
+  const Rdb_key_def &kd = *m_pk_descr;
+  KEY_MULTI_RANGE range;
+
+  m_mrr_key_buffer.clear();
+  m_mrr_key_ends.clear();
+  m_mrr_keys.clear();
+  m_mrr_range_ids.clear();
+  m_mrr_read_index = 0;
+
+  while (m_mrr_range_ids.size() < m_mrr_batch_size) {
+    if (mrr_funcs.next(mrr_iter, &range)) {
+      m_mrr_end_of_ranges = true;
+      break;
+    }
+    DBUG_ASSERT(range.range_flag & EQ_RANGE);
+    DBUG_ASSERT(is_using_full_key(range.start_key.keypart_map,
+                                  kd.get_key_parts()));
+
+    const uint size = kd.pack_index_tuple(
+        table, m_pack_buffer, m_pk_packed_tuple, m_record_buffer,
+        range.start_key.key, range.start_key.keypart_map);
+    m_mrr_key_buffer.append(reinterpret_cast<const char *>(m_pk_packed_tuple),
+                            size);
+    m_mrr_key_ends.push_back(m_mrr_key_buffer.size());
+    m_mrr_range_ids.push_back(range.ptr);
+  }
+
+  const size_t n_keys = m_mrr_range_ids.size();
+  if (n_keys == 0) {
+    return HA_ERR_END_OF_FILE;
+  }
+
+  // The slices are made after m_mrr_key_buffer is no longer reallocated
+  size_t start = 0;
+  for (const size_t end : m_mrr_key_ends) {
+    m_mrr_keys.emplace_back(m_mrr_key_buffer.data() + start, end - start);
+    start = end;
+  }
+
+  Rdb_transaction *const tx = get_or_create_tx(table->in_use);
+  DBUG_ASSERT(tx != nullptr);
+
+  tx->acquire_snapshot(true);
+  tx->multi_get(kd.get_cf(), n_keys, m_mrr_keys.data(), m_mrr_values.get(),
+                m_mrr_statuses.data());
+
+  return HA_EXIT_SUCCESS;
+}
+
+int ha_rocksdb::multi_range_read_next(range_id_t *range_info) {
+  DBUG_ENTER_FUNC();
+
+  if (!m_mrr_multi_get) {
+    DBUG_RETURN(handler::multi_range_read_next(range_info));
+  }
+
+  Rdb_transaction *const tx = get_or_create_tx(table->in_use);
+  DBUG_ASSERT(tx != nullptr);
+
+  int rc;
+  for (;;) {
+    if (m_mrr_read_index == m_mrr_keys.size()) {
+      THD *const thd = ha_thd();
+      if (thd && thd->killed) {
+        DBUG_RETURN(HA_ERR_QUERY_INTERRUPTED);
+      }
+      if (m_mrr_end_of_ranges || (rc = mrr_fill_buffer())) {
+        table->status = STATUS_NOT_FOUND;
+        DBUG_RETURN(HA_ERR_END_OF_FILE);
+      }
+    }
+
+    const size_t i = m_mrr_read_index++;
+    const rocksdb::Status &s = m_mrr_statuses[i];
+    if (s.IsNotFound()) {
+      continue;
+    }
+    if (!s.ok()) {
+      DBUG_RETURN(tx->set_status_error(table->in_use, s, *m_pk_descr,
+                                       m_tbl_def, m_table_handler));
+    }
+
+    const rocksdb::Slice &key = m_mrr_keys[i];
+    const rocksdb::PinnableSlice &value = m_mrr_values[i];
+
+    // If we found the record, but it's expired, pretend we didn't find it
+    if (m_pk_descr->has_ttl() &&
+        should_hide_ttl_rec(*m_pk_descr, value, tx->m_snapshot_timestamp)) {
+      continue;
+    }
+
+    m_last_rowkey.copy(key.data(), key.size(), &my_charset_bin);
+    rc = convert_record_from_storage_format(&key, &value, table->record[0]);
+    if (rc) {
+      DBUG_RETURN(rc);
+    }
+
+    table->status = 0;
+    update_row_stats(ROWS_READ);
+    *range_info = m_mrr_range_ids[i];
+    DBUG_RETURN(HA_EXIT_SUCCESS);
+  }
+}
+
 void ha_rocksdb::update_create_info(HA_CREATE_INFO *const create_info) {
   DBUG_ENTER_FUNC();
 
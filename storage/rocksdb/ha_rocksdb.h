@@ -898,6 +898,8 @@ class ha_rocksdb : public my_core::handler {
 
     /* Free blob data */
     m_retrieved_record.Reset();
+    m_mrr_values.reset();
+    m_mrr_batch_size = 0;
 
     DBUG_RETURN(HA_EXIT_SUCCESS);
   }
@@ -911,6 +913,18 @@ class ha_rocksdb : public my_core::handler {
                            page_range *pages) override
       MY_ATTRIBUTE((__warn_unused_result__));
 
+  ha_rows multi_range_read_info_const(uint keyno, RANGE_SEQ_IF *seq,
+                                      void *seq_init_param, uint n_ranges,
+                                      uint *bufsz, uint *flags, ha_rows limit,
+                                      Cost_estimate *cost) override;
+  ha_rows multi_range_read_info(uint keyno, uint n_ranges, uint keys,
+                                uint key_parts, uint *bufsz, uint *flags,
+                                Cost_estimate *cost) override;
+  int multi_range_read_init(RANGE_SEQ_IF *seq, void *seq_init_param,
+                            uint n_ranges, uint mode,
+                            HANDLER_BUFFER *buf) override;
+  int multi_range_read_next(range_id_t *range_info) override;
+
   int delete_table(Rdb_tbl_def *const tbl);
   int delete_table(const char *const from) override
       MY_ATTRIBUTE((__warn_unused_result__));
@@ -993,6 +1007,24 @@ class ha_rocksdb : public my_core::handler {
   bool m_in_rpl_update_rows;
 
   bool m_force_skip_unique_check;
+
+  /*
+    Multi-Range-Read with MultiGet(): the primary key values of a batch of
+    ranges, and the records that were read for them
+  */
+  bool m_mrr_multi_get;
+  bool m_mrr_end_of_ranges;
+  uint m_mrr_batch_size;
+  std::string m_mrr_key_buffer;
+  std::vector<size_t> m_mrr_key_ends;
+  std::vector<rocksdb::Slice> m_mrr_keys;
+  std::vector<range_id_t> m_mrr_range_ids;
+  std::unique_ptr<rocksdb::PinnableSlice[]> m_mrr_values;
+  std::vector<rocksdb::Status> m_mrr_statuses;
+  size_t m_mrr_read_index;
+
+  bool mrr_can_use_multi_get(uint keyno, uint mrr_mode);
+  int mrr_fill_buffer() MY_ATTRIBUTE((__warn_unused_result__));
 };
 
 /*
@@ -325,7 +325,8 @@ Rdb_sst_info::Rdb_sst_info(rocksdb::DB *const db, const std::string &tablename,
       m_done(false),
       m_sst_file(nullptr),
       m_tracing(tracing),
-      m_print_client_error(true) {
+      m_print_client_error(true),
+      m_defer_client_error(false) {
   m_prefix = db->GetName() + "/";
 
   std::string normalized_table;
@@ -504,6 +505,14 @@ void Rdb_sst_info::set_error_msg(const std::string &sst_file_name,
                                  const rocksdb::Status &s) {
   if (!m_print_client_error) return;
 
+  if (m_defer_client_error) {
+    if (m_deferred_error.ok()) {
+      m_deferred_error = s;
+      m_deferred_error_sst_file_name = sst_file_name;
+    }
+    return;
+  }
+
   report_error_msg(s, sst_file_name.c_str());
 }
 
@@ -136,6 +136,11 @@ class Rdb_sst_info {
   const bool m_tracing;
   bool m_print_client_error;
 
+  // Whether errors are saved in m_deferred_error instead of being reported
+  bool m_defer_client_error;
+  rocksdb::Status m_deferred_error;
+  std::string m_deferred_error_sst_file_name;
+
   int open_new_sst_file();
   void close_curr_sst_file();
   void commit_sst_file(Rdb_sst_file_ordered *sst_file);
@@ -232,6 +237,19 @@ class Rdb_sst_info {
 
   bool is_done() const { return m_done; }
 
+  /*
+    Save the first error instead of reporting it to the client, for a
+    thread that does not serve the client connection
+  */
+  void defer_client_error() { m_defer_client_error = true; }
+  void report_deferred_client_error() {
+    if (!m_deferred_error.ok()) {
+      report_error_msg(m_deferred_error,
+                       m_deferred_error_sst_file_name.c_str());
+      m_deferred_error = rocksdb::Status::OK();
+    }
+  }
+
   bool have_background_error() { return m_background_error != 0; }
 
   int get_and_reset_background_error() {
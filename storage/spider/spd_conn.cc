@@ -344,12 +344,11 @@ void spider_free_conn_from_trx(
           } else {
             if (ip_port_conn)
             { /* exists */
+              pthread_mutex_lock(&ip_port_conn->mutex);
+              ip_port_conn->released_count++;
               if (ip_port_conn->waiting_count)
-              {
-                pthread_mutex_lock(&ip_port_conn->mutex);
-                pthread_cond_signal(&ip_port_conn->cond);
-                pthread_mutex_unlock(&ip_port_conn->mutex);
-              }
+                pthread_cond_broadcast(&ip_port_conn->cond);
+              pthread_mutex_unlock(&ip_port_conn->mutex);
             }
             if (spider_open_connections.array.max_element > old_elements)
             {
@@ -815,6 +814,10 @@ int spider_free_conn(
     pthread_mutex_lock(&ip_port_conn->mutex);
     if (ip_port_conn->ip_port_count > 0)
       ip_port_conn->ip_port_count--;
+    /* a waiter may create a new connection now */
+    ip_port_conn->released_count++;
+    if (ip_port_conn->waiting_count)
+      pthread_cond_broadcast(&ip_port_conn->cond);
     pthread_mutex_unlock(&ip_port_conn->mutex);
   }
   if (conn->conn_holder_for_direct_join)
@@ -3805,7 +3808,7 @@ SPIDER_CONN* spider_get_conn_from_idle_connection(
   SPIDER_CONN *conn = NULL;
   uint spider_max_connections = spider_param_max_connections();
   struct timespec abstime;
-  ulonglong start, inter_val = 0;
+  ulonglong start;
   longlong last_ntime = 0;
   ulonglong wait_time = (ulonglong)spider_param_conn_wait_timeout()*1000*1000*1000; // default 10s
 
@@ -3830,30 +3833,18 @@ SPIDER_CONN* spider_get_conn_from_idle_connection(
     ip_port_count >= spider_max_connections &&
     spider_max_connections > 0
   ) { /* no idle conn && enable connection pool, wait */
+    /*
+      Look again each time a connection to the data node is returned to
+      the pool or closed. released_count is read before the pool is
+      searched, so that a release in between does not make us wait.
+    */
+    ulong released_count = ip_port_conn->released_count;
+    ++ip_port_conn->waiting_count;
     pthread_mutex_unlock(&ip_port_conn->mutex);
     start = my_hrtime().val;
     while(1)
     {
-      int error;
-      inter_val = my_hrtime().val - start; // us
-      last_ntime = wait_time - inter_val*1000; // *1000, to ns
-      if(last_ntime <= 0)
-      {/* wait timeout */
-        *error_num = ER_SPIDER_CON_COUNT_ERROR;
-        DBUG_RETURN(NULL);
-      }
-      set_timespec_nsec(abstime, last_ntime);
-      pthread_mutex_lock(&ip_port_conn->mutex);
-      ++ip_port_conn->waiting_count;
-      error = pthread_cond_timedwait(&ip_port_conn->cond, &ip_port_conn->mutex, &abstime);
-      --ip_port_conn->waiting_count;
-      pthread_mutex_unlock(&ip_port_conn->mutex);
-      if (error == ETIMEDOUT || error == ETIME || error != 0 )
-      {
-        *error_num = ER_SPIDER_CON_COUNT_ERROR;
-        DBUG_RETURN(NULL);
-      }
-
+      int error = 0;
       pthread_mutex_lock(&spider_conn_mutex);
       if ((conn = (SPIDER_CONN*) my_hash_search_using_hash_value(
         &spider_open_connections, share->conn_keys_hash_value[link_idx],
@@ -3861,38 +3852,60 @@ SPIDER_CONN* spider_get_conn_from_idle_connection(
         share->conn_keys_lengths[link_idx])))
       {
         /* get conn from spider_open_connections, then delete conn in spider_open_connections */
-        my_hash_delete(&spider_open_connections, (uchar*) conn);  
+        my_hash_delete(&spider_open_connections, (uchar*) conn);
         pthread_mutex_unlock(&spider_conn_mutex);
-        DBUG_PRINT("info",("spider get global conn"));
-        if (spider)
+        pthread_mutex_lock(&ip_port_conn->mutex);
+        break;
+      }
+      pthread_mutex_unlock(&spider_conn_mutex);
+
+      pthread_mutex_lock(&ip_port_conn->mutex);
+      if (ip_port_conn->ip_port_count < spider_max_connections)
+        break; /* a connection was closed, create a new one */
+      if (released_count == ip_port_conn->released_count)
+      {
+        last_ntime = wait_time - (my_hrtime().val - start)*1000; // to ns
+        if (last_ntime <= 0)
+          error = ETIMEDOUT;
+        else
         {
-          spider->conns[base_link_idx] = conn;
-          if (spider_bit_is_set(spider->conn_can_fo, base_link_idx))
-            conn->use_for_active_standby = TRUE;
+          set_timespec_nsec(abstime, last_ntime);
+          DEBUG_SYNC(current_thd, "spider_conn_wait");
+          error = pthread_cond_timedwait(&ip_port_conn->cond,
+            &ip_port_conn->mutex, &abstime);
         }
-        DBUG_RETURN(conn);
       }
-      else
-      {
-        pthread_mutex_unlock(&spider_conn_mutex);
+      released_count = ip_port_conn->released_count;
+      if (error)
+      { /* wait timeout */
+        --ip_port_conn->waiting_count;
+        pthread_mutex_unlock(&ip_port_conn->mutex);
+        *error_num = ER_SPIDER_CON_COUNT_ERROR;
+        DBUG_RETURN(NULL);
       }
+      pthread_mutex_unlock(&ip_port_conn->mutex);
     }
+    --ip_port_conn->waiting_count;
   }
-  else
+  if (ip_port_conn)
+    pthread_mutex_unlock(&ip_port_conn->mutex);
+
+  if (conn)
+  {
+    DBUG_PRINT("info",("spider get global conn"));
+  } else
   { /* create conn */
-    if (ip_port_conn)
-      pthread_mutex_unlock(&ip_port_conn->mutex);
     DBUG_PRINT("info",("spider create new conn"));
     if (!(conn= spider_create_conn(share, spider, link_idx, base_link_idx,
                                    error_num)))
       DBUG_RETURN(conn);
     *conn->conn_key = *conn_key;
-    if (spider)
-    {
-      spider->conns[base_link_idx] = conn;
-      if (spider_bit_is_set(spider->conn_can_fo, base_link_idx))
-        conn->use_for_active_standby = TRUE;
-    }
+  }
+  if (spider)
+  {
+    spider->conns[base_link_idx] = conn;
+    if (spider_bit_is_set(spider->conn_can_fo, base_link_idx))
+      conn->use_for_active_standby = TRUE;
   }
 
   DBUG_RETURN(conn);
@@ -2193,9 +2193,31 @@ int spider_db_fetch_for_item_sum_func(
         row->next();
       }
       break;
+    case Item_sum::AVG_FUNC:
+      {
+        /* The sum and the count of spider_db_mbase_util::open_item_sum_func() */
+        Item_sum_avg *item_sum_avg = (Item_sum_avg *) item_sum;
+        my_decimal decimal_value, *sum_decimal = NULL;
+        double sum_real = 0;
+        bool sum_is_null = row->is_null();
+        if (item_sum_avg->result_type() == DECIMAL_RESULT)
+          sum_decimal = row->val_decimal(&decimal_value,
+            share->access_charset);
+        else
+          sum_real = row->val_real();
+        row->next();
+        if (row->is_null())
+          DBUG_RETURN(ER_SPIDER_UNKNOWN_NUM);
+        ulonglong count = (ulonglong) row->val_int();
+        if (item_sum_avg->result_type() == DECIMAL_RESULT)
+          item_sum_avg->direct_add(sum_decimal, count);
+        else
+          item_sum_avg->direct_add(sum_real, sum_is_null, count);
+        row->next();
+      }
+      break;
     case Item_sum::COUNT_DISTINCT_FUNC:
     case Item_sum::SUM_DISTINCT_FUNC:
-    case Item_sum::AVG_FUNC:
     case Item_sum::AVG_DISTINCT_FUNC:
     case Item_sum::STD_FUNC:
     case Item_sum::VARIANCE_FUNC:
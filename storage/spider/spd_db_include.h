@@ -167,6 +167,10 @@ typedef st_spider_result SPIDER_RESULT;
 #define SPIDER_SQL_LCL_NAME_QUOTE_LEN (sizeof(SPIDER_SQL_LCL_NAME_QUOTE_STR) - 1)
 #define SPIDER_SQL_MIN_STR "min"
 #define SPIDER_SQL_MIN_LEN (sizeof(SPIDER_SQL_MIN_STR) - 1)
+#define SPIDER_SQL_AVG_SUM_STR "sum("
+#define SPIDER_SQL_AVG_SUM_LEN (sizeof(SPIDER_SQL_AVG_SUM_STR) - 1)
+#define SPIDER_SQL_AVG_COUNT_STR "),count("
+#define SPIDER_SQL_AVG_COUNT_LEN (sizeof(SPIDER_SQL_AVG_COUNT_STR) - 1)
 
 #define SPIDER_SQL_LOP_CHK_PRM_PRF_STR "spider_lc_"
 #define SPIDER_SQL_LOP_CHK_PRM_PRF_LEN (sizeof(SPIDER_SQL_LOP_CHK_PRM_PRF_STR) - 1)
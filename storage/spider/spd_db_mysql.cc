@@ -6164,9 +6164,45 @@ int spider_db_mbase_util::open_item_sum_func(
         }
       }
       break;
+    case Item_sum::AVG_FUNC:
+      if (!use_fields)
+      {
+        /*
+          Direct aggregate: select the sum and the count, which
+          spider_db_fetch_for_item_sum_func() passes to
+          Item_sum_avg::direct_add()
+        */
+        Item *item = item_sum->get_args()[0];
+        if (str)
+        {
+          if (str->reserve(SPIDER_SQL_AVG_SUM_LEN))
+            DBUG_RETURN(HA_ERR_OUT_OF_MEM);
+          str->q_append(SPIDER_SQL_AVG_SUM_STR, SPIDER_SQL_AVG_SUM_LEN);
+        }
+        if ((error_num = spider_db_print_item_type(item, NULL, spider, str,
+          alias, alias_length, dbton_id, use_fields, fields)))
+          DBUG_RETURN(error_num);
+        if (str)
+        {
+          if (str->reserve(SPIDER_SQL_AVG_COUNT_LEN))
+            DBUG_RETURN(HA_ERR_OUT_OF_MEM);
+          str->q_append(SPIDER_SQL_AVG_COUNT_STR, SPIDER_SQL_AVG_COUNT_LEN);
+        }
+        if ((error_num = spider_db_print_item_type(item, NULL, spider, str,
+          alias, alias_length, dbton_id, use_fields, fields)))
+          DBUG_RETURN(error_num);
+        if (str)
+        {
+          if (str->reserve(SPIDER_SQL_CLOSE_PAREN_LEN))
+            DBUG_RETURN(HA_ERR_OUT_OF_MEM);
+          str->q_append(SPIDER_SQL_CLOSE_PAREN_STR,
+            SPIDER_SQL_CLOSE_PAREN_LEN);
+        }
+        break;
+      }
+      /* fall through */
     case Item_sum::COUNT_DISTINCT_FUNC:
     case Item_sum::SUM_DISTINCT_FUNC:
-    case Item_sum::AVG_FUNC:
     case Item_sum::AVG_DISTINCT_FUNC:
       {
         if (!use_fields)
@@ -1614,6 +1614,8 @@ typedef struct st_spider_ip_port_conn {
   long               remote_port;
   ulong              ip_port_count;
   volatile ulong     waiting_count;
+  /* connections returned to the pool or closed, protected by mutex */
+  ulong              released_count;
   pthread_mutex_t    mutex;
   pthread_cond_t     cond;
   ulonglong          conn_id; /* each conn has it's own conn_id */
@@ -186,4 +186,16 @@ my_strcoll_mb7_bin_8bytes(const uchar *a, const uchar *b)
   return an == bn ? 0 : an < bn ? -1 : +1;
 }
 
+
+/*
+  Check if the string has at least eight bytes and they are all 7bit ASCII.
+  In a multi-byte character set with mbminlen==1, such bytes at a character
+  boundary are eight single byte characters.
+*/
+static inline int
+my_ascii_8bytes_found(const uchar *s, const uchar *e)
+{
+  return e - s >= 8 && (uint8korr(s) & 0x8080808080808080ULL) == 0;
+}
+
 #endif /* CTYPE_ASCII_INCLUDED */
@@ -17,6 +17,7 @@
 #include "strings_def.h"
 #include <m_ctype.h>
 #include "ctype-mb.h"
+#include "ctype-ascii.h"
 
 #ifdef USE_MB
 
@@ -238,6 +239,12 @@ size_t my_numchars_mb(CHARSET_INFO *cs __attribute__((unused)),
   while (pos < end) 
   {
     uint mb_len;
+    if (my_ascii_8bytes_found((const uchar *) pos, (const uchar *) end))
+    {
+      pos+= 8;
+      count+= 8;
+      continue;
+    }
     pos+= (mb_len= my_ismbchar(cs,pos,end)) ? mb_len : 1;
     count++;
   }
@@ -253,6 +260,13 @@ size_t my_charpos_mb(CHARSET_INFO *cs __attribute__((unused)),
   while (length && pos < end)
   {
     uint mb_len;
+    if (length >= 8 &&
+        my_ascii_8bytes_found((const uchar *) pos, (const uchar *) end))
+    {
+      pos+= 8;
+      length-= 8;
+      continue;
+    }
     pos+= (mb_len= my_ismbchar(cs, pos, end)) ? mb_len : 1;
     length--;
   }
@@ -184,6 +184,16 @@ MY_FUNCTION_NAME(well_formed_char_length)(CHARSET_INFO *cs __attribute__((unused
   int chlen;
   for ( ; nchars ; nchars--, b+= chlen)
   {
+#if defined(OPTIMIZE_ASCII) && OPTIMIZE_ASCII
+    if (nchars >= 8 && my_ascii_8bytes_found((const uchar *) b,
+                                             (const uchar *) e))
+    {
+      /* Eight ASCII characters, the loop adds the last one */
+      chlen= 8;
+      nchars-= 7;
+      continue;
+    }
+#endif
     if ((chlen= CHARLEN(cs, (uchar*) b, (uchar*) e)) <= 0)
     {
       status->m_well_formed_error_pos= b < e ? b : NULL;
@@ -626,6 +626,48 @@ MY_FUNCTION_NAME(strnncollsp_nchars_multilevel)(CHARSET_INFO *cs,
     N/A
 */
 
+#if MY_UCA_ASCII_OPTIMIZE && !MY_UCA_COMPILE_CONTRACTIONS
+/*
+  Fast path for the ASCII prefix of a string in hash_sort*():
+  add the weights of the leading ASCII characters with exactly one
+  weight, without going through the scanner.
+
+  Stops before a non-ASCII character, an expansion, or a character
+  whose weight is "stop_weight" (the space weight in PAD SPACE
+  collations, so the scanner can combine and skip trailing spaces).
+
+  Returns the number of bytes handled.
+*/
+static inline size_t
+MY_FUNCTION_NAME(hash_sort_ascii_prefix)(const MY_UCA_WEIGHT_LEVEL *level,
+                                         const uchar *s, size_t slen,
+                                         int stop_weight,
+                                         ulong *nr1, ulong *nr2)
+{
+  const uint16 *weights0= level->weights[0];
+  uint lengths0= level->lengths[0];
+  const uchar *s0= s, *se= s + slen;
+  register ulong m1= *nr1, m2= *nr2;
+
+  for ( ; s < se && *s <= 0x7F; s++)
+  {
+    const uint16 *weight= weights0 + (((uint) *s) * lengths0);
+    int s_res;
+    if (!(s_res= *weight))
+      continue;           /* Ignorable */
+    if (weight[1] || s_res == stop_weight)
+      break;              /* Expansion or space */
+    /* See comment in hash_sort() why we can't use MY_HASH_ADD_16() */
+    MY_HASH_ADD(m1, m2, s_res >> 8);
+    MY_HASH_ADD(m1, m2, s_res & 0xFF);
+  }
+  *nr1= m1;
+  *nr2= m2;
+  return (size_t) (s - s0);
+}
+#endif
+
+
 static void
 MY_FUNCTION_NAME(hash_sort)(CHARSET_INFO *cs,
                             const uchar *s, size_t slen,
@@ -635,7 +677,20 @@ MY_FUNCTION_NAME(hash_sort)(CHARSET_INFO *cs,
   my_uca_scanner scanner;
   my_uca_scanner_param param;
   int space_weight= my_space_weight(&cs->uca->level[0]);
-  register ulong m1= *nr1, m2= *nr2;
+  register ulong m1, m2;
+
+#if MY_UCA_ASCII_OPTIMIZE && !MY_UCA_COMPILE_CONTRACTIONS
+  {
+    size_t done= MY_FUNCTION_NAME(hash_sort_ascii_prefix)(&cs->uca->level[0],
+                                                          s, slen,
+                                                          space_weight,
+                                                          nr1, nr2);
+    s+= done;
+    slen-= done;
+  }
+#endif
+  m1= *nr1;
+  m2= *nr2;
 
   my_uca_scanner_param_init(&param, cs, &cs->uca->level[0]);
   my_uca_scanner_init_any(&scanner, s, slen);
@@ -690,7 +745,20 @@ MY_FUNCTION_NAME(hash_sort_nopad)(CHARSET_INFO *cs,
   int   s_res;
   my_uca_scanner scanner;
   my_uca_scanner_param param;
-  register ulong m1= *nr1, m2= *nr2;
+  register ulong m1, m2;
+
+#if MY_UCA_ASCII_OPTIMIZE && !MY_UCA_COMPILE_CONTRACTIONS
+  {
+    /* Weights are never 0 here, so no character stops the fast path */
+    size_t done= MY_FUNCTION_NAME(hash_sort_ascii_prefix)(&cs->uca->level[0],
+                                                          s, slen, 0,
+                                                          nr1, nr2);
+    s+= done;
+    slen-= done;
+  }
+#endif
+  m1= *nr1;
+  m2= *nr2;
 
   my_uca_scanner_param_init(&param, cs, &cs->uca->level[0]);
   my_uca_scanner_init_any(&scanner, s, slen);
@@ -22,6 +22,7 @@
 #include "strings_def.h"
 #include <m_ctype.h>
 #include "ctype-mb.h"
+#include "ctype-ascii.h"
 
 #ifndef EILSEQ
 #define EILSEQ ENOENT
@@ -673,10 +674,12 @@ int my_charlen_utf8mb3(CHARSET_INFO *cs __attribute__((unused)),
 #define MY_FUNCTION_NAME(x)       my_ ## x ## _utf8mb3
 #define CHARLEN(cs,str,end)       my_charlen_utf8mb3(cs,str,end)
 #define DEFINE_WELL_FORMED_CHAR_LENGTH_USING_CHARLEN
+#define OPTIMIZE_ASCII            1
 #include "ctype-mb.inl"
 #undef MY_FUNCTION_NAME
 #undef CHARLEN
 #undef DEFINE_WELL_FORMED_CHAR_LENGTH_USING_CHARLEN
+#undef OPTIMIZE_ASCII
 /* my_well_formed_char_length_utf8mb3 */
 
 
@@ -3026,10 +3029,12 @@ my_charlen_utf8mb4(CHARSET_INFO *cs __attribute__((unused)),
 #define MY_FUNCTION_NAME(x)       my_ ## x ## _utf8mb4
 #define CHARLEN(cs,str,end)       my_charlen_utf8mb4(cs,str,end)
 #define DEFINE_WELL_FORMED_CHAR_LENGTH_USING_CHARLEN
+#define OPTIMIZE_ASCII            1
 #include "ctype-mb.inl"
 #undef MY_FUNCTION_NAME
 #undef CHARLEN
 #undef DEFINE_WELL_FORMED_CHAR_LENGTH_USING_CHARLEN
+#undef OPTIMIZE_ASCII
 /* my_well_formed_char_length_utf8mb4 */
 
 
@@ -127,6 +127,8 @@ typedef longlong      dec2;
 #define DIG_BASE     1000000000
 #define DIG_MAX      (DIG_BASE-1)
 #define DIG_BASE2    ((dec2)DIG_BASE * (dec2)DIG_BASE)
+/* Max digits of a decimal2scaled_longlong() result */
+#define SCALED_LONGLONG_DIGITS 18
 static const dec1 powers10[DIG_PER_DEC1+1]={
   1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
 static const int dig2bytes[DIG_PER_DEC1+1]={0, 1, 1, 2, 2, 3, 3, 4, 4, 4};
@@ -1205,6 +1207,98 @@ int decimal2longlong(const decimal_t *from, longlong *to)
   return E_DEC_OK;
 }
 
+/*
+  Convert decimal to an integer scaled by 10^scale, e.g. 123.45 with
+  scale 2 to 12345
+
+  SYNOPSIS
+    decimal2scaled_longlong()
+      from    - value to convert
+      scale   - number of fractional digits, has to be from->frac
+      to      - result
+
+  NOTE
+    Only values with at most SCALED_LONGLONG_DIGITS significant digits
+    are converted, so that the sum of two results can not overflow.
+
+  RETURN VALUE
+    E_DEC_OK
+    E_DEC_OVERFLOW  the value has another scale or too many digits;
+                    'to' is not changed
+*/
+
+int decimal2scaled_longlong(const decimal_t *from, decimal_digits_t scale,
+                            longlong *to)
+{
+  decimal_digits_t intg;
+  dec1 *buf;
+  ulonglong x= 0;
+  int frac, rem;
+
+  if (from->frac != scale)
+    return E_DEC_OVERFLOW;
+  buf= remove_leading_zeroes(from, &intg);
+  if (intg + scale > SCALED_LONGLONG_DIGITS)
+    return E_DEC_OVERFLOW;
+
+  for (frac= ROUND_UP(intg) + scale / DIG_PER_DEC1; frac > 0; frac--)
+    x= x * DIG_BASE + *buf++;
+  if ((rem= scale % DIG_PER_DEC1))
+    x= x * powers10[rem] + *buf / powers10[DIG_PER_DEC1 - rem];
+
+  *to= from->sign ? -(longlong) x : (longlong) x;
+  return E_DEC_OK;
+}
+
+/*
+  Convert an integer scaled by 10^scale to decimal, e.g. 12345 with
+  scale 2 to 123.45. The reverse of decimal2scaled_longlong().
+
+  SYNOPSIS
+    scaled_longlong2decimal()
+      from    - value to convert
+      scale   - number of fractional digits, at most
+                SCALED_LONGLONG_DIGITS
+      to      - result
+
+  RETURN VALUE
+    E_DEC_OK/E_DEC_OVERFLOW
+*/
+
+int scaled_longlong2decimal(longlong from, decimal_digits_t scale,
+                            decimal_t *to)
+{
+  ulonglong x, p, fracpart;
+  my_bool sign= from < 0;
+  int error, frac0= ROUND_UP(scale), rem= scale % DIG_PER_DEC1;
+  dec1 *buf, *stop;
+
+  DBUG_ASSERT(scale <= SCALED_LONGLONG_DIGITS);
+  x= sign ? - (ulonglong) from : (ulonglong) from;
+  p= scale > DIG_PER_DEC1 ?
+     (ulonglong) DIG_BASE * powers10[scale - DIG_PER_DEC1] :
+     (ulonglong) powers10[scale];
+  fracpart= x % p;
+
+  if ((error= ull2dec(x / p, to)))
+    return error;
+  if (unlikely(ROUND_UP(to->intg) + frac0 > to->len))
+    return E_DEC_OVERFLOW;
+
+  to->sign= sign;
+  to->frac= scale;
+  stop= to->buf + ROUND_UP(to->intg);
+  buf= stop + frac0;
+  if (rem)
+  {
+    *--buf= (dec1) (fracpart % powers10[rem]) * powers10[DIG_PER_DEC1 - rem];
+    fracpart/= powers10[rem];
+  }
+  for ( ; buf > stop; fracpart/= DIG_BASE)
+    *--buf= (dec1) (fracpart % DIG_BASE);
+  return E_DEC_OK;
+}
+
 /*
   Convert decimal to its binary fixed-length representation
   two representations of the same length can be compared with memcmp
@@ -2738,6 +2832,25 @@ void test_d2ll(const char *s, const char *orig, int ex)
   }
 }
 
+void test_d2sll(const char *s, int scale, const char *orig, int ex)
+{
+  char s1[100], *end;
+  longlong x= 0;
+  int res;
+
+  end= strend(s);
+  string2decimal(s, &a, &end);
+  res=decimal2scaled_longlong(&a, scale, &x);
+  longlong10_to_str(x,s1,-10);
+  printf("%-40s => res=%d    %s    ", s, res, s1);
+  if (res == E_DEC_OK)
+    scaled_longlong2decimal(x, scale, &b);
+  else
+    decimal_make_zero(&b);
+  print_decimal(&b, orig, res, ex);
+  printf("\n");
+}
+
 void test_da(const char *s1, const char *s2, const char *orig, int ex)
 {
   char s[100], *end;
@@ -2989,6 +3102,18 @@ int main()
   test_d2ll("-9223372036854775808", "-9223372036854775808", 0);
   test_d2ll("9223372036854775808", "9223372036854775807", 2);
 
+  printf("==== decimal2scaled_longlong ====\n");
+  test_d2sll("123.45", 2, "123.45", 0);
+  test_d2sll("-123.45", 2, "-123.45", 0);
+  test_d2sll("0.05", 2, "0.05", 0);
+  test_d2sll("0000000000000123.45", 2, "123.45", 0);
+  test_d2sll("123456789.123456789", 9, "123456789.123456789", 0);
+  test_d2sll("1234567890.123456789", 9, "0", 2);
+  test_d2sll("0.123456789012345678", 18, "0.123456789012345678", 0);
+  test_d2sll("-999999999999999.999", 3, "-999999999999999.999", 0);
+  test_d2sll("9999999999999999.999", 3, "0", 2);
+  test_d2sll("123.4", 2, "0", 2);
+
   printf("==== do_add ====\n");
   test_da(".00012345000098765" ,"123.45", "123.45012345000098765", 0);
   test_da(".1" ,".45", "0.55", 0);
@@ -366,11 +366,43 @@ int json_read_string_const_chr(json_string_t *js)
 }
 
 
+/*
+  Skip the characters of a string constant that need no handling:
+  ASCII characters other than the quote, the backslash and controls.
+  Only used for ASCII-compatible character sets, where such a byte is
+  always a complete character. The bytes are tested eight at a time,
+  the last ones and the word with the ending character one by one.
+*/
+
+#define JSON_WORD_BYTES(c) (((ulonglong) (c)) * 0x0101010101010101ULL)
+#define JSON_WORD_HAS_LESS(x, c) \
+  (((x) - JSON_WORD_BYTES(c)) & ~(x) & JSON_WORD_BYTES(0x80))
+#define JSON_WORD_HAS_BYTE(x, c) JSON_WORD_HAS_LESS((x) ^ JSON_WORD_BYTES(c), 1)
+
+static const uchar *skip_plain_str_chars(const uchar *str, const uchar *end)
+{
+  for (; str + 8 <= end; str+= 8)
+  {
+    ulonglong x;
+    memcpy(&x, str, 8);
+    if ((x & JSON_WORD_BYTES(0x80)) || JSON_WORD_HAS_LESS(x, 0x20) ||
+        JSON_WORD_HAS_BYTE(x, '"') || JSON_WORD_HAS_BYTE(x, '\\'))
+      break;
+  }
+  while (str < end && *str < 128 && json_instr_chr_map[*str] <= S_ETC)
+    str++;
+  return str;
+}
+
+
 static int skip_str_constant(json_engine_t *j)
 {
   int t, c_len;
+  const my_bool ascii_based= !(j->s.cs->state & MY_CS_NONASCII);
   for (;;)
   {
+    if (ascii_based)
+      j->s.c_str= skip_plain_str_chars(j->s.c_str, j->s.str_end);
     if ((c_len= json_next_char(&j->s)) > 0)
     {
       j->s.c_str+= c_len;
@@ -1401,8 +1433,51 @@ static int handle_match(json_engine_t *je, json_path_t *p,
   Check if the name of the current JSON key matches
   the step of the path.
 */
+/*
+  Compare the key name with k byte by byte, when they are in the same
+  ASCII-compatible character set. To be sure that's the same as
+  comparing the characters, only ASCII characters other than the quote
+  and the backslash decide a mismatch.
+
+  RETURN
+    1   match, the key name is read
+    0   no match
+   -1   can't tell, compare characters
+*/
+
+static int key_bytes_match(json_engine_t *je, const json_string_t *k)
+{
+  const uchar *key= je->s.c_str, *end= je->s.str_end;
+  const uchar *c;
+
+  for (c= k->c_str; c < k->str_end; c++, key++)
+  {
+    if (*c == '\\' || *c < 0x20 || key == end)
+      return -1;
+    if (*key != *c)
+      return (*key < 128 && json_instr_chr_map[*key] <= S_ETC) ? 0 : -1;
+  }
+  if (key == end)
+    return -1;
+  if (*key == '"')
+  {
+    je->s.c_str= key;
+    json_read_keyname_chr(je);
+    return 1;
+  }
+  return (*key < 128 && json_instr_chr_map[*key] <= S_ETC) ? 0 : -1;
+}
+
+
 int json_key_matches(json_engine_t *je, json_string_t *k)
 {
+  if (je->s.wc == k->wc && !(je->s.cs->state & MY_CS_NONASCII))
+  {
+    int res= key_bytes_match(je, k);
+    if (res >= 0)
+      return res;
+  }
+
   while (json_read_keyname_chr(je) == 0)
   {
     if (json_read_string_const_chr(k) ||
@@ -1800,36 +1875,10 @@ int json_get_path_start(json_engine_t *je, CHARSET_INFO *i_cs,
 }
 
 
-int json_get_path_next(json_engine_t *je, json_path_t *p)
-{
-  if (p->last_step < p->steps)
-  {
-    if (json_read_value(je))
-      return 1;
-
-    p->last_step= p->steps;
-    p->steps[0].type= JSON_PATH_ARRAY_WILD;
-    p->steps[0].n_item= 0;
-    return 0;
-  }
-  else
-  {
-    if (json_value_scalar(je))
-    {
-      if (p->last_step->type & JSON_PATH_ARRAY)
-        p->last_step->n_item++;
-    }
-    else
-    {
-      p->last_step++;
-      p->last_step->type= (enum json_path_step_types) je->value_type;
-      p->last_step->n_item= 0;
-    }
-
-    if (json_scan_next(je))
-      return 1;
-  }
+/* Scan to the next value for json_get_path_next() and set its path */
 
+static int get_path_next_value(json_engine_t *je, json_path_t *p)
+{
   do
   {
     switch (je->state)
@@ -1864,6 +1913,53 @@ int json_get_path_next(json_engine_t *je, json_path_t *p)
 }
 
 
+int json_get_path_next(json_engine_t *je, json_path_t *p)
+{
+  if (p->last_step < p->steps)
+  {
+    if (json_read_value(je))
+      return 1;
+
+    p->last_step= p->steps;
+    p->steps[0].type= JSON_PATH_ARRAY_WILD;
+    p->steps[0].n_item= 0;
+    return 0;
+  }
+  else
+  {
+    if (json_value_scalar(je))
+    {
+      if (p->last_step->type & JSON_PATH_ARRAY)
+        p->last_step->n_item++;
+    }
+    else
+    {
+      p->last_step++;
+      p->last_step->type= (enum json_path_step_types) je->value_type;
+      p->last_step->n_item= 0;
+    }
+
+    if (json_scan_next(je))
+      return 1;
+  }
+
+  return get_path_next_value(je, p);
+}
+
+
+int json_skip_path_next(json_engine_t *je, json_path_t *p)
+{
+  DBUG_ASSERT(p->last_step >= p->steps);
+  if (!json_value_scalar(je) && json_skip_level(je))
+    return 1;
+  if (p->last_step->type & JSON_PATH_ARRAY)
+    p->last_step->n_item++;
+  if (json_scan_next(je))
+    return 1;
+  return get_path_next_value(je, p);
+}
+
+
 static enum json_types smart_read_value(json_engine_t *je,
                                         const char **value, int *value_len)
 {
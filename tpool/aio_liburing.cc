@@ -111,8 +111,14 @@ class aio_uring final : public tpool::aio
       io_uring_prep_readv(sqe, cb->m_fh, static_cast<struct iovec *>(cb), 1,
                           cb->m_offset);
     else
+    {
       io_uring_prep_writev(sqe, cb->m_fh, static_cast<struct iovec *>(cb), 1,
                            cb->m_offset);
+#ifdef RWF_ATOMIC
+      if (cb->m_opcode == tpool::aio_opcode::AIO_PWRITE_ATOMIC)
+        sqe->rw_flags= RWF_ATOMIC;
+#endif
+    }
     io_uring_sqe_set_data(sqe, cb);
 
     return io_uring_submit(&uring_) == 1 ? 0 : -1;
@@ -163,6 +163,10 @@ class aio_linux final : public aio
                   cb->m_offset);
     if (cb->m_opcode != aio_opcode::AIO_PREAD)
       cb->aio_lio_opcode= IO_CMD_PWRITE;
+#ifdef RWF_ATOMIC
+    if (cb->m_opcode == aio_opcode::AIO_PWRITE_ATOMIC)
+      cb->aio_rw_flags= RWF_ATOMIC;
+#endif
     iocb *icb= static_cast<iocb*>(cb);
     int ret= io_submit(m_io_ctx, 1, &icb);
     if (ret == 1)
@@ -132,7 +132,9 @@ class waitable_task :public task
 enum class aio_opcode
 {
   AIO_PREAD,
-  AIO_PWRITE
+  AIO_PWRITE,
+  /** AIO_PWRITE that must not be torn (RWF_ATOMIC) */
+  AIO_PWRITE_ATOMIC
 };
 constexpr size_t MAX_AIO_USERDATA_LEN= 4 * sizeof(void*);
 
@@ -291,6 +293,45 @@ class thread_pool
   virtual void wait_end() {};
   virtual ~thread_pool() {}
 };
+
+/**
+  Completion counter for a group of overlapping asynchronous IOs.
+
+  The caller creates the batch with a continuation task, calls add()
+  before each submit_io(), and finally calls submit(). The aiocb callback
+  of every IO in the batch must call complete(). Once the last IO has
+  completed (and submit() was called), the continuation is submitted to
+  the thread pool. Thus, code that needs several reads before it can go
+  on does not have to block a worker thread while the reads are in flight,
+  and does not need to count the completions itself.
+
+  The batch must stay alive until the continuation is executed;
+  it may be reused after that.
+*/
+class aio_batch
+{
+  std::atomic<unsigned int> m_pending;
+  thread_pool *m_pool;
+  task *m_continuation;
+public:
+  aio_batch(thread_pool *pool, task *continuation) :
+    m_pending(1), m_pool(pool), m_continuation(continuation)
+  {}
+  /** Account for one more IO, must be called before it is submitted */
+  void add() { m_pending.fetch_add(1, std::memory_order_relaxed); }
+  /** Mark one IO as completed, called from the aiocb callback */
+  void complete()
+  {
+    if (m_pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+      m_pending.store(1, std::memory_order_relaxed);
+      m_pool->submit_task(m_continuation);
+    }
+  }
+  /** No more IOs will be added; the continuation may run now */
+  void submit() { complete(); }
+};
+
 const int DEFAULT_MIN_POOL_THREADS= 1;
 const int DEFAULT_MAX_POOL_THREADS= 500;
 extern thread_pool *
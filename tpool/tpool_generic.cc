@@ -34,6 +34,9 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02111 - 1301 USA*/
 #include <thr_timer.h>
 #include <stdlib.h>
 #include "aligned.h"
+#ifdef __linux__
+#include <sys/uio.h> /* pwritev2(), RWF_ATOMIC */
+#endif
 
 namespace tpool
 {
@@ -71,6 +74,16 @@ void aio::synchronous(aiocb *cb)
   case aio_opcode::AIO_PWRITE:
     ret_len= pwrite(cb->m_fh, cb->m_buffer, cb->m_len, cb->m_offset);
     break;
+  case aio_opcode::AIO_PWRITE_ATOMIC:
+#ifdef RWF_ATOMIC
+    {
+      iovec iov{cb->m_buffer, cb->m_len};
+      ret_len= pwritev2(cb->m_fh, &iov, 1, cb->m_offset, RWF_ATOMIC);
+    }
+#else
+    ret_len= pwrite(cb->m_fh, cb->m_buffer, cb->m_len, cb->m_offset);
+#endif
+    break;
   default:
     abort();
   }
@@ -292,6 +305,7 @@ class thread_pool_generic : public thread_pool
   bool add_thread();
   bool wake(worker_wake_reason reason, task *t = nullptr);
   void maybe_wake_or_create_thread();
+  bool concurrency_reached();
   bool too_many_active_threads();
   bool get_task(worker_data *thread_var, task **t);
   bool wait_for_tasks(std::unique_lock<std::mutex> &lk,
@@ -527,23 +541,32 @@ bool thread_pool_generic::get_task(worker_data *thread_var, task **t)
   DBUG_ASSERT(!thread_var->is_waiting());
   thread_var->m_state = worker_data::NONE;
 
-  while (m_task_queue.empty())
+  while (!thread_var->m_task && m_task_queue.empty())
   {
     if (m_in_shutdown)
       return false;
 
     if (!wait_for_tasks(lk, thread_var))
       return false;
-    if (m_task_queue.empty())
+    if (!thread_var->m_task && m_task_queue.empty())
     {
       m_spurious_wakeups++;
       continue;
     }
   }
 
-  /* Dequeue from the task queue.*/
-  *t= m_task_queue.front();
-  m_task_queue.pop();
+  if (thread_var->m_task)
+  {
+    /* Task was handed over by submit_task(), it never was in the queue.*/
+    *t= thread_var->m_task;
+    thread_var->m_task= nullptr;
+  }
+  else
+  {
+    /* Dequeue from the task queue.*/
+    *t= m_task_queue.front();
+    m_task_queue.pop();
+  }
   m_tasks_dequeued++;
   thread_var->m_state |= worker_data::EXECUTING_TASK;
   thread_var->m_task_start_time = m_timestamp;
@@ -788,7 +811,7 @@ bool thread_pool_generic::add_thread()
 }
 
 /** Wake a standby thread, and hand the given task over to this thread. */
-bool thread_pool_generic::wake(worker_wake_reason reason, task *)
+bool thread_pool_generic::wake(worker_wake_reason reason, task *t)
 {
   assert(reason != WAKE_REASON_NONE);
 
@@ -798,7 +821,9 @@ bool thread_pool_generic::wake(worker_wake_reason reason, task *)
   m_standby_threads.pop_back();
   m_active_threads.push_back(var);
   assert(var->m_wake_reason == WAKE_REASON_NONE);
+  assert(!var->m_task);
   var->m_wake_reason= reason;
+  var->m_task= t;
   var->m_cv.notify_one();
   m_wakeups++;
   return true;
@@ -844,8 +869,7 @@ void thread_pool_generic::maybe_wake_or_create_thread()
 {
   if (m_task_queue.empty())
     return;
-  DBUG_ASSERT(m_active_threads.size() >= static_cast<size_t>(m_long_tasks_count + m_waiting_task_count));
-  if (m_active_threads.size() - m_long_tasks_count - m_waiting_task_count > m_concurrency)
+  if (concurrency_reached())
     return;
   if (!m_standby_threads.empty())
   {
@@ -857,6 +881,16 @@ void thread_pool_generic::maybe_wake_or_create_thread()
   }
 }
 
+/**
+  Check whether enough threads are busy executing (not waiting, not
+  long-running) tasks, so that no other thread needs to be woken up.
+*/
+bool thread_pool_generic::concurrency_reached()
+{
+  DBUG_ASSERT(m_active_threads.size() >= static_cast<size_t>(m_long_tasks_count + m_waiting_task_count));
+  return m_active_threads.size() - m_long_tasks_count - m_waiting_task_count > m_concurrency;
+}
+
 bool thread_pool_generic::too_many_active_threads()
 {
   return m_active_threads.size() - m_long_tasks_count - m_waiting_task_count >
@@ -885,6 +919,17 @@ void thread_pool_generic::submit_task(task* task)
     return;
   task->add_ref();
   m_tasks_enqueued++;
+  if (m_task_queue.empty() && !m_standby_threads.empty() &&
+      !concurrency_reached())
+  {
+    /*
+      Nothing is queued ahead of this task, so hand it over to the standby
+      thread that is woken anyway. The worker does not have to race the
+      other workers (and submitters) for the queue once it wakes up.
+    */
+    wake(WAKE_REASON_TASK, task);
+    return;
+  }
   m_task_queue.push(task);
   maybe_wake_or_create_thread();
 }
@@ -0,0 +1,110 @@
+/* Copyright (c) 2026, MariaDB Corporation.
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1335  USA */
+
+#include "bench.h"
+#include <my_sys.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BENCH_MAX_REPEAT 100
+
+volatile ulonglong bench_sink;
+
+/** Minimum duration of one measured run, in nanoseconds */
+static ulonglong bench_time= 200000000ULL;
+static uint bench_repeat= 5;
+static const char *bench_filter;
+
+void bench_init(int argc, char **argv)
+{
+  int i;
+  for (i= 1; i < argc; i++)
+  {
+    if (!strncmp(argv[i], "--time=", 7))
+      bench_time= strtoull(argv[i] + 7, NULL, 10) * 1000000ULL;
+    else if (!strncmp(argv[i], "--repeat=", 9))
+      bench_repeat= (uint) atoi(argv[i] + 9);
+    else if (!strncmp(argv[i], "--filter=", 9))
+      bench_filter= argv[i] + 9;
+    else
+    {
+      fprintf(stderr, "Usage: %s [--time=ms] [--repeat=n] [--filter=name]\n",
+              argv[0]);
+      exit(1);
+    }
+  }
+  if (!bench_time)
+    bench_time= 1;
+  bench_repeat= MY_MAX(1, MY_MIN(bench_repeat, BENCH_MAX_REPEAT));
+}
+
+
+int bench_selected(const char *name)
+{
+  return !bench_filter || strstr(name, bench_filter) != NULL;
+}
+
+
+static ulonglong bench_once(bench_func func, void *arg, ulonglong iterations)
+{
+  ulonglong start= my_interval_timer();
+  func(arg, iterations);
+  return my_interval_timer() - start;
+}
+
+
+static int cmp_double(const void *a, const void *b)
+{
+  double x= *(const double*) a, y= *(const double*) b;
+  return x < y ? -1 : x > y;
+}
+
+
+void bench_run(const char *name, ulonglong param, size_t bytes,
+               bench_func func, void *arg)
+{
+  double ns_per_op[BENCH_MAX_REPEAT];
+  ulonglong iterations= 1, elapsed;
+  double median;
+  uint i;
+
+  if (!bench_selected(name))
+    return;
+
+  /* Warm up, then grow the run until it lasts at least bench_time. */
+  func(arg, 1);
+  while ((elapsed= bench_once(func, arg, iterations)) < bench_time)
+  {
+    ulonglong next= elapsed
+      ? (ulonglong) ((double) iterations * bench_time / elapsed * 1.1)
+      : iterations * 100;
+    iterations= MY_MAX(next, iterations * 2);
+  }
+
+  ns_per_op[0]= (double) elapsed / iterations;
+  for (i= 1; i < bench_repeat; i++)
+    ns_per_op[i]= (double) bench_once(func, arg, iterations) / iterations;
+  qsort(ns_per_op, bench_repeat, sizeof *ns_per_op, cmp_double);
+  median= ns_per_op[bench_repeat / 2];
+
+  printf("{\"benchmark\":\"%s\",\"arg\":%llu,\"iterations\":%llu,"
+         "\"ns_per_op\":%.1f,\"min_ns_per_op\":%.1f",
+         name, param, iterations, median, ns_per_op[0]);
+  if (bytes)
+    printf(",\"mb_per_s\":%.1f", bytes * 1000.0 / median);
+  printf("}\n");
+  fflush(stdout);
+}
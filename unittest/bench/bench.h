@@ -0,0 +1,79 @@
+/* Copyright (c) 2026, MariaDB Corporation.
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1335  USA */
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include "my_global.h"
+
+/**
+  @file
+  Minimal micro-benchmark harness.
+
+  A benchmark is a function that performs a given number of iterations
+  of the operation being measured. bench_run() calibrates the number of
+  iterations until one run lasts at least --time milliseconds, then
+  repeats the run --repeat times and prints one JSON object per line:
+
+  {"benchmark":"crc32c","arg":16384,"iterations":81920,
+   "ns_per_op":912.4,"min_ns_per_op":905.1,"mb_per_s":17956.3}
+
+  The output of two builds can be compared line by line.
+*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+  Run @c iterations iterations of a benchmark.
+  @param arg   the argument passed to bench_run()
+  @param iterations number of operations to perform
+*/
+typedef void (*bench_func)(void *arg, ulonglong iterations);
+
+/**
+  A sink for computed values, to keep the compiler from optimizing
+  the measured code away.
+*/
+extern volatile ulonglong bench_sink;
+
+/**
+  Parse the command line arguments.
+  Recognized options are --time=<milliseconds>, --repeat=<count>
+  and --filter=<substring of benchmark name>.
+*/
+void bench_init(int argc, char **argv);
+
+/**
+  Measure and report a benchmark.
+  @param name  name of the benchmark
+  @param param benchmark parameter reported in the "arg" field,
+               e.g. a buffer size or a number of threads
+  @param bytes bytes processed by one operation, or 0
+  @param func  the benchmark function
+  @param arg   argument for func
+*/
+void bench_run(const char *name, ulonglong param, size_t bytes,
+               bench_func func, void *arg);
+
+/** @return whether a benchmark is selected by --filter */
+int bench_selected(const char *name);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BENCH_H */
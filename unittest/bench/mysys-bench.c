@@ -0,0 +1,188 @@
+/* Copyright (c) 2026, MariaDB Corporation.
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1335  USA */
+
+/* Micro-benchmarks for CRC-32, lf_hash and MEM_ROOT */
+
+#include <my_global.h>
+#include <my_sys.h>
+#include <lf.h>
+#include "bench.h"
+
+#define BUF_SIZE 65536
+#define LF_HASH_KEYS 65536
+#define MAX_THREADS 64
+
+static uchar buf[BUF_SIZE];
+
+typedef struct
+{
+  size_t size;
+} crc_arg;
+
+static void bench_crc32(void *arg, ulonglong iterations)
+{
+  size_t size= ((crc_arg*) arg)->size;
+  uint32 crc= 0;
+  while (iterations--)
+    crc= my_checksum(crc, buf, size);
+  bench_sink+= crc;
+}
+
+static void bench_crc32c(void *arg, ulonglong iterations)
+{
+  size_t size= ((crc_arg*) arg)->size;
+  uint32 crc= 0;
+  while (iterations--)
+    crc= my_crc32c(crc, buf, size);
+  bench_sink+= crc;
+}
+
+
+static LF_HASH lf_hash;
+
+static void bench_lf_hash_insert_delete(void *arg, ulonglong iterations)
+{
+  LF_PINS *pins= lf_hash_get_pins(&lf_hash);
+  uint32 key= 0;
+  (void) arg;
+  while (iterations--)
+  {
+    /* Keys above LF_HASH_KEYS are not preloaded. */
+    uint32 k= LF_HASH_KEYS + (key++ % LF_HASH_KEYS);
+    lf_hash_insert(&lf_hash, pins, &k);
+    lf_hash_delete(&lf_hash, pins, &k, sizeof k);
+  }
+  lf_hash_put_pins(pins);
+}
+
+typedef struct
+{
+  ulonglong iterations;
+  uint seed;
+} lf_thread_arg;
+
+static void *lf_hash_search_thread(void *arg)
+{
+  lf_thread_arg *a= (lf_thread_arg*) arg;
+  LF_PINS *pins= lf_hash_get_pins(&lf_hash);
+  uint32 key= a->seed, found= 0;
+  ulonglong i;
+  for (i= a->iterations; i--; )
+  {
+    uint32 k;
+    key= key * 1103515245 + 12345;
+    k= key % LF_HASH_KEYS;
+    if (lf_hash_search(&lf_hash, pins, &k, sizeof k))
+      found++;
+    lf_hash_search_unpin(pins);
+  }
+  lf_hash_put_pins(pins);
+  bench_sink+= found;
+  return NULL;
+}
+
+/** Search the hash concurrently; iterations are split among the threads */
+static void bench_lf_hash_search(void *arg, ulonglong iterations)
+{
+  uint n_threads= *(uint*) arg, i;
+  pthread_t threads[MAX_THREADS];
+  lf_thread_arg args[MAX_THREADS];
+
+  for (i= 0; i < n_threads; i++)
+  {
+    args[i].iterations= iterations / n_threads + 1;
+    args[i].seed= i;
+    pthread_create(&threads[i], NULL, lf_hash_search_thread, &args[i]);
+  }
+  for (i= 0; i < n_threads; i++)
+    pthread_join(threads[i], NULL);
+}
+
+
+typedef struct
+{
+  size_t size;
+} mem_root_arg;
+
+/** Allocate from a MEM_ROOT, freeing it every 1000 allocations */
+static void bench_mem_root(void *arg, ulonglong iterations)
+{
+  size_t size= ((mem_root_arg*) arg)->size;
+  MEM_ROOT root;
+  init_alloc_root(PSI_NOT_INSTRUMENTED, &root, 8192, 0, MYF(0));
+  while (iterations)
+  {
+    uint i;
+    for (i= 0; i < 1000 && iterations; i++, iterations--)
+      bench_sink+= (size_t) alloc_root(&root, size);
+    free_root(&root, MYF(MY_MARK_BLOCKS_FREE));
+  }
+  free_root(&root, MYF(0));
+}
+
+
+int main(int argc, char **argv)
+{
+  static const size_t crc_sizes[]= {64, 4096, 16384, BUF_SIZE};
+  static const size_t alloc_sizes[]= {16, 128, 1024};
+  static const uint thread_counts[]= {1, 4, 16};
+  uint i;
+
+  MY_INIT(argv[0]);
+  bench_init(argc, argv);
+
+  for (i= 0; i < sizeof buf; i++)
+    buf[i]= (uchar) (i * 7 + 3);
+
+  for (i= 0; i < array_elements(crc_sizes); i++)
+  {
+    crc_arg arg;
+    arg.size= crc_sizes[i];
+    bench_run("crc32", arg.size, arg.size, bench_crc32, &arg);
+    bench_run("crc32c", arg.size, arg.size, bench_crc32c, &arg);
+  }
+
+  if (bench_selected("lf_hash"))
+  {
+    LF_PINS *pins;
+    uint32 k;
+    lf_hash_init(&lf_hash, sizeof(uint32), LF_HASH_UNIQUE, 0, sizeof(uint32),
+                 0, &my_charset_bin);
+    pins= lf_hash_get_pins(&lf_hash);
+    for (k= 0; k < LF_HASH_KEYS; k++)
+      lf_hash_insert(&lf_hash, pins, &k);
+    lf_hash_put_pins(pins);
+
+    bench_run("lf_hash_insert_delete", LF_HASH_KEYS, 0,
+              bench_lf_hash_insert_delete, NULL);
+    for (i= 0; i < array_elements(thread_counts); i++)
+    {
+      uint n_threads= thread_counts[i];
+      bench_run("lf_hash_search", n_threads, 0, bench_lf_hash_search,
+                &n_threads);
+    }
+    lf_hash_destroy(&lf_hash);
+  }
+
+  for (i= 0; i < array_elements(alloc_sizes); i++)
+  {
+    mem_root_arg arg;
+    arg.size= alloc_sizes[i];
+    bench_run("mem_root_alloc", arg.size, 0, bench_mem_root, &arg);
+  }
+
+  my_end(0);
+  return 0;
+}
@@ -0,0 +1,186 @@
+/* Copyright (c) 2026, MariaDB Corporation.
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1335  USA */
+
+/* Micro-benchmarks for collations, decimal arithmetic and json_lib */
+
+#include <my_global.h>
+#include <my_sys.h>
+#include <m_string.h>
+#include <decimal.h>
+#include <json_lib.h>
+#include "bench.h"
+
+/** Two strings which differ only at the end, mixing ASCII and multi-byte */
+static const char str1[]=
+  "Lorem ipsum dolor sit amet, Grüße aus Köln, Ούτε ένα, "
+  "съешь же ещё этих мягких французских булок. 0123456789 end-A";
+static const char str2[]=
+  "Lorem ipsum dolor sit amet, Grüße aus Köln, Ούτε ένα, "
+  "съешь же ещё этих мягких французских булок. 0123456789 end-B";
+
+static void bench_strnncollsp(void *arg, ulonglong iterations)
+{
+  CHARSET_INFO *cs= (CHARSET_INFO*) arg;
+  int res= 0;
+  while (iterations--)
+    res+= my_ci_strnncollsp(cs, (const uchar*) str1, sizeof str1 - 1,
+                            (const uchar*) str2, sizeof str2 - 1);
+  bench_sink+= res;
+}
+
+static void bench_hash_sort(void *arg, ulonglong iterations)
+{
+  CHARSET_INFO *cs= (CHARSET_INFO*) arg;
+  ulong nr1= 1, nr2= 4;
+  while (iterations--)
+    my_ci_hash_sort(cs, (const uchar*) str1, sizeof str1 - 1, &nr1, &nr2);
+  bench_sink+= nr1;
+}
+
+
+typedef int (*decimal_op)(const decimal_t*, const decimal_t*, decimal_t*);
+
+typedef struct
+{
+  decimal_op op;
+  decimal_t a, b;
+  decimal_digit_t buf_a[9], buf_b[9];
+} decimal_arg;
+
+static void bench_decimal(void *arg, ulonglong iterations)
+{
+  decimal_arg *d= (decimal_arg*) arg;
+  decimal_digit_t buf[18];
+  decimal_t res;
+  int err= 0;
+  res.buf= buf;
+  res.len= array_elements(buf);
+  while (iterations--)
+    err|= d->op(&d->a, &d->b, &res);
+  bench_sink+= err + res.buf[0];
+}
+
+static int decimal_div4(const decimal_t *a, const decimal_t *b, decimal_t *to)
+{
+  return decimal_div(a, b, to, 4);
+}
+
+static void decimal_arg_init(decimal_arg *d, decimal_op op,
+                             const char *a, const char *b)
+{
+  char *end;
+  d->op= op;
+  d->a.buf= d->buf_a;
+  d->a.len= array_elements(d->buf_a);
+  d->b.buf= d->buf_b;
+  d->b.len= array_elements(d->buf_b);
+  end= (char*) a + strlen(a);
+  string2decimal(a, &d->a, &end);
+  end= (char*) b + strlen(b);
+  string2decimal(b, &d->b, &end);
+}
+
+
+static char json_doc[8192];
+static size_t json_doc_length;
+
+static void json_doc_init()
+{
+  char *p= json_doc, *end= json_doc + sizeof json_doc - 128;
+  uint i;
+  p+= sprintf(p, "{\"items\": [");
+  for (i= 0; p < end; i++)
+    p+= sprintf(p, "%s{\"id\": %u, \"name\": \"item-%u\", \"price\": %u.%02u,"
+                " \"tags\": [\"a\", \"b\"], \"stock\": %s}",
+                i ? ", " : "", i, i, i * 3, i % 100,
+                i & 1 ? "true" : "null");
+  p+= sprintf(p, "]}");
+  json_doc_length= (size_t) (p - json_doc);
+}
+
+static void bench_json_valid(void *arg, ulonglong iterations)
+{
+  int res= 0;
+  (void) arg;
+  while (iterations--)
+    res+= json_valid(json_doc, json_doc_length, &my_charset_utf8mb4_bin);
+  bench_sink+= res;
+}
+
+static void bench_json_scan(void *arg, ulonglong iterations)
+{
+  ulonglong keys= 0;
+  (void) arg;
+  while (iterations--)
+  {
+    json_engine_t je;
+    json_scan_start(&je, &my_charset_utf8mb4_bin, (const uchar*) json_doc,
+                    (const uchar*) json_doc + json_doc_length);
+    do
+    {
+      if (je.state == JST_KEY)
+      {
+        while (json_read_keyname_chr(&je) == 0)
+          keys+= je.s.c_next;
+      }
+    } while (json_scan_next(&je) == 0);
+  }
+  bench_sink+= keys;
+}
+
+
+int main(int argc, char **argv)
+{
+  static const char *collations[]=
+  {
+    "utf8mb4_bin", "utf8mb4_general_ci", "utf8mb4_unicode_ci",
+    "utf8mb4_unicode_520_ci", "utf8mb4_uca1400_ai_ci"
+  };
+  char name[64];
+  decimal_arg d;
+  uint i;
+
+  MY_INIT(argv[0]);
+  bench_init(argc, argv);
+
+  for (i= 0; i < array_elements(collations); i++)
+  {
+    CHARSET_INFO *cs= get_charset_by_name(collations[i], MYF(0));
+    if (!cs)
+      continue;
+    my_snprintf(name, sizeof name, "strnncollsp_%s", collations[i]);
+    bench_run(name, sizeof str1 - 1, sizeof str1 - 1, bench_strnncollsp,
+              (void*) cs);
+    my_snprintf(name, sizeof name, "hash_sort_%s", collations[i]);
+    bench_run(name, sizeof str1 - 1, sizeof str1 - 1, bench_hash_sort,
+              (void*) cs);
+  }
+
+  decimal_arg_init(&d, decimal_add, "123456789012.345678", "98765432.123456789");
+  bench_run("decimal_add", 18, 0, bench_decimal, &d);
+  decimal_arg_init(&d, decimal_mul, "123456789012.345678", "98765432.123456789");
+  bench_run("decimal_mul", 18, 0, bench_decimal, &d);
+  decimal_arg_init(&d, decimal_div4, "123456789012.345678", "98765432.123456789");
+  bench_run("decimal_div", 18, 0, bench_decimal, &d);
+
+  json_doc_init();
+  bench_run("json_valid", json_doc_length, json_doc_length,
+            bench_json_valid, NULL);
+  bench_run("json_scan", json_doc_length, json_doc_length,
+            bench_json_scan, NULL);
+
+  my_end(0);
+  return 0;
+}
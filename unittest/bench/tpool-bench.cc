@@ -0,0 +1,79 @@
+/* Copyright (c) 2026, MariaDB Corporation.
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1335  USA */
+
+/* Micro-benchmark for tpool task submission and execution */
+
+#include <my_global.h>
+#include <my_sys.h>
+#include <thr_timer.h>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include "tpool.h"
+#include "bench.h"
+
+static std::atomic<ulonglong> executed;
+
+static void noop_task(void *)
+{
+  executed.fetch_add(1, std::memory_order_relaxed);
+}
+
+struct tpool_arg
+{
+  tpool::thread_pool *pool;
+  tpool::task *task;
+};
+
+/** Submit tasks and wait until all of them have been executed */
+static void bench_submit(void *arg, ulonglong iterations)
+{
+  tpool_arg *a= static_cast<tpool_arg*>(arg);
+  const ulonglong target= executed.load() + iterations;
+  for (ulonglong i= iterations; i--; )
+    a->pool->submit_task(a->task);
+  while (executed.load() < target)
+    std::this_thread::yield();
+}
+
+int main(int argc, char **argv)
+{
+  static const int pool_sizes[]= {1, 4, 16};
+
+  MY_INIT(argv[0]);
+  bench_init(argc, argv);
+  /* The pool maintenance timer */
+  init_thr_timer(16);
+
+  for (int size : pool_sizes)
+  {
+    if (!bench_selected("tpool"))
+      break;
+    std::unique_ptr<tpool::thread_pool>
+      pool(tpool::create_thread_pool_generic(1, size));
+    tpool::task task(noop_task, nullptr);
+    tpool::task_group group(1);
+    tpool::task grouped(noop_task, nullptr, &group);
+    tpool_arg arg{pool.get(), &task};
+    bench_run("tpool_submit", size, 0, bench_submit, &arg);
+    /* Tasks of a group with concurrency 1 are executed one at a time. */
+    arg.task= &grouped;
+    bench_run("tpool_submit_group", size, 0, bench_submit, &arg);
+  }
+
+  end_thr_timer();
+  my_end(0);
+  return 0;
+}
@@ -171,16 +171,121 @@ test_search()
 }
 
 
+static const uchar *kj0= (const uchar *) "{\"k10\":1, \"k\\u0031\":2, \"k\":3,"
+                                         " \"k1\":4, \"k1\" :5, \"K1\":6}";
+static const uchar *kp0= (const uchar *) "$.k1";
+/*
+  Test matching of key names to the path.
+*/
+static void
+test_key_matches()
+{
+  json_engine_t je;
+  json_path_t p;
+  json_path_step_t *cur_step;
+  int n_matches= 0, values= 0;
+  int array_counters[JSON_DEPTH_LIMIT];
+
+  if (json_scan_start(&je, ci, s_e(kj0)) ||
+      json_path_setup(&p, ci, s_e(kp0)))
+    return;
+
+  cur_step= p.steps;
+  while (json_find_path(&je, &p, &cur_step, array_counters) == 0)
+  {
+    if (json_read_value(&je))
+      break;
+    n_matches++;
+    values= values * 10 + je.value[0] - '0';
+    if (json_scan_next(&je))
+      break;
+  }
+
+  ok(!je.s.error && n_matches == 3 && values == 245, "key matches");
+}
+
+
+/*
+  Test json_get_path_next() and json_skip_path_next() to list the paths.
+*/
+static void
+test_get_path()
+{
+  json_engine_t je;
+  json_path_t p;
+  int n_paths= 0, skip= 0, last_depth= 0, last_item= 0;
+
+  json_get_path_start(&je, ci, s_e(js3), &p);
+  while ((skip ? json_skip_path_next(&je, &p) :
+                 json_get_path_next(&je, &p)) == 0)
+  {
+    n_paths++;
+    last_depth= (int) (p.last_step - p.steps);
+    last_item= p.last_step->n_item;
+    /* Skip the insides of "key1" */
+    skip= p.last_step - p.steps == 1 && je.value_type == JSON_VALUE_OBJECT;
+  }
+  ok(!je.s.error && n_paths == 5 && last_depth == 2 && last_item == 1,
+     "skip path");
+}
+
+
+/*
+  Read a string value, return its length or -1 on error.
+*/
+static int string_value_len(const uchar *j, int *escaped, int *error)
+{
+  json_engine_t je;
+  *escaped= 0;
+  if (json_scan_start(&je, ci, s_e(j)) || json_read_value(&je))
+  {
+    *error= je.s.error;
+    return -1;
+  }
+  *error= 0;
+  *escaped= je.value_escaped;
+  return je.value_type == JSON_VALUE_STRING ? je.value_len : -1;
+}
+
+
+static const uchar *sj0= (const uchar *) "\"0123456789abcdef0123456789\"";
+static const uchar *sj1= (const uchar *) "\"0123456789abcdef\\n01234567\"";
+static const uchar *sj2= (const uchar *) "\"0123456789\xc3\xa4" "bcdef01\"";
+static const uchar *sj3= (const uchar *) "\"0123456789abcdef\t0123\"";
+static const uchar *sj4= (const uchar *) "\"0123456789abcdef0123";
+/*
+  Test reading of string constants that are longer than a few bytes.
+*/
+static void
+test_long_strings()
+{
+  int escaped, error;
+  ok(string_value_len(sj0, &escaped, &error) == 26 && !escaped,
+     "long string");
+  ok(string_value_len(sj1, &escaped, &error) == 26 && escaped,
+     "long string with escape");
+  ok(string_value_len(sj2, &escaped, &error) == 19 && !escaped,
+     "long string with multibyte character");
+  ok(string_value_len(sj3, &escaped, &error) == -1 &&
+     error == JE_NOT_JSON_CHR, "long string with control character");
+  ok(string_value_len(sj4, &escaped, &error) == -1 && error == JE_EOS,
+     "unterminated long string");
+}
+
+
 int main()
 {
   ci= &my_charset_utf8mb3_general_ci;
 
-  plan(6);
+  plan(13);
   diag("Testing json_lib functions.");
 
   test_json_parsing();
   test_path_parsing();
   test_search();
+  test_key_matches();
+  test_get_path();
+  test_long_strings();
 
   return exit_status();
 }
@@ -63,19 +63,40 @@ static uint crc32(uint32 crc, const void *buf, size_t len)
 static uint crc32c(uint32 crc, const void *buf, size_t len)
 { return crc_(crc, buf, len, tab_castagnoli); }
 
-static char buf[16384];
+static char buf[65536 + 1];
 
 typedef uint (*check)(uint32, const void*, size_t);
 
 static size_t test_buf(check c1, check c2)
 {
   size_t s;
-  for (s= sizeof buf; s; s--)
+  for (s= 16384; s; s--)
     if (c1(0, buf, s) != c2(0, buf, s))
       break;
   return s;
 }
 
+/** Compare two implementations on a large buffer at offsets 0 and 1 */
+static my_bool test_large(check c1, check c2, size_t len)
+{
+  return c1(0, buf, len) == c2(0, buf, len) &&
+    c1(0, buf + 1, len) == c2(0, buf + 1, len);
+}
+
+/** Report the throughput of an implementation on len byte buffers */
+static void bench(const char *name, check c, size_t len)
+{
+  const size_t total= 64 << 20;
+  size_t i;
+  uint32 crc= 0;
+  ulonglong start= my_interval_timer(), ns;
+  for (i= 0; i < total / len; i++)
+    crc= c(crc, buf, len);
+  ns= my_interval_timer() - start;
+  diag("%-8s %6zu bytes: %8.3f GB/s (%08x)", name, len,
+       ns ? (double) total / (double) ns : 0.0, crc);
+}
+
 #define DO_TEST_CRC32(crc,str,len)                      \
   ok(crc32(crc,str,len) == my_checksum(crc, str, len),  \
      "crc32(%u,'%.*s')", crc, (int) len, str)
@@ -94,11 +115,12 @@ static const char STR[]=
 
 int main(int argc __attribute__((unused)),char *argv[])
 {
+  size_t i;
   MY_INIT(argv[0]);
   init_lookup(tab_3309, 0xedb88320);
   init_lookup(tab_castagnoli, 0x82f63b78);
 
-  plan(36);
+  plan(40);
   printf("%s\n",my_crc32c_implementation());
   DO_TEST_CRC32(0,STR,0);
   DO_TEST_CRC32(1,STR,0);
@@ -140,6 +162,21 @@ int main(int argc __attribute__((unused)),char *argv[])
   ok(0 == test_buf(my_checksum, crc32), "crc32 with various lengths");
   ok(0 == test_buf(my_crc32c, crc32c), "crc32c with various lengths");
 
+  /* Page checksums and binlog events are computed on large buffers */
+  for (i= 0; i < sizeof buf; i++)
+    buf[i]= (char) (i * 7 + (i >> 8));
+  ok(test_large(my_checksum, crc32, 16384), "crc32 of 16KiB");
+  ok(test_large(my_checksum, crc32, 65536), "crc32 of 64KiB");
+  ok(test_large(my_crc32c, crc32c, 16384), "crc32c of 16KiB");
+  ok(test_large(my_crc32c, crc32c, 65536), "crc32c of 64KiB");
+
+  for (i= 16384; i <= 65536; i*= 4)
+  {
+    bench("crc32", my_checksum, i);
+    bench("crc32c", my_crc32c, i);
+    bench("table", crc32c, i);
+  }
+
   my_end(0);
   return exit_status();
 }
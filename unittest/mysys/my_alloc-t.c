@@ -0,0 +1,86 @@
+/* Copyright (c) 2026, MariaDB
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1335  USA */
+
+#include <my_global.h>
+#include <my_sys.h>
+#include "tap.h"
+
+static void fill_root(MEM_ROOT *root)
+{
+  int i;
+  for (i= 0; i < 10; i++)
+    alloc_root(root, 800);
+}
+
+int main(int argc __attribute__((unused)),char *argv[])
+{
+  MEM_ROOT root;
+  ROOT_BLOCK_CACHE cache;
+  size_t kept, cached;
+  MY_INIT(argv[0]);
+
+  plan(9);
+
+  init_alloc_root(PSI_NOT_INSTRUMENTED, &root, 1024, 0, MYF(0));
+
+  fill_root(&root);
+  kept= free_root_retain(&root, 0);
+  ok(kept == 0 && !root.free && !root.used, "Nothing retained.");
+
+  fill_root(&root);
+  kept= free_root_retain(&root, SIZE_T_MAX);
+#ifdef HAVE_valgrind
+  ok(kept == 0, "Nothing retained with valgrind.");
+  ok(!root.used, "Used list is empty.");
+  skip(1, "No blocks retained with valgrind");
+#else
+  ok(kept > 0, "Blocks retained.");
+  ok(!root.used, "Used list is empty.");
+  ok(root.free != NULL, "Retained blocks are free.");
+#endif
+
+  ok(alloc_root(&root, 800) != NULL, "Allocation after retain.");
+
+  kept= free_root_retain(&root, 1);
+  ok(kept == 0 && !root.free, "Blocks larger than retain_size freed.");
+
+  free_root(&root, MYF(0));
+
+  bzero(&cache, sizeof(cache));
+  cache.max_size= 1024*1024;
+  set_root_block_cache(&cache);
+  init_alloc_root(PSI_NOT_INSTRUMENTED, &root, 1024, 0,
+                  MYF(MY_THREAD_SPECIFIC));
+  fill_root(&root);
+  free_root(&root, MYF(0));
+  cached= cache.size;
+#if defined(HAVE_valgrind) && defined(EXTRA_DEBUG)
+  skip(2, "No block cache with valgrind");
+#else
+  ok(cached > 0, "Blocks of thread specific root cached.");
+
+  init_alloc_root(PSI_NOT_INSTRUMENTED, &root, 1024, 0,
+                  MYF(MY_THREAD_SPECIFIC));
+  fill_root(&root);
+  ok(cache.size < cached, "Cached blocks reused.");
+  free_root(&root, MYF(0));
+#endif
+  set_root_block_cache(0);
+  free_root_block_cache(&cache);
+  ok(cache.size == 0, "Block cache freed.");
+
+  my_end(0);
+  return exit_status();
+}
@@ -0,0 +1,136 @@
+/*
+   Copyright (c) 2024, MariaDB plc
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1335  USA
+*/
+
+/*
+  Compares all dot product kernels of the MHNSW index, that the CPU
+  supports, with the non-SIMD variant, and prints how fast they are.
+*/
+
+#include <my_global.h>
+#include <my_sys.h>
+#include <my_bit.h>
+#include <tap.h>
+#include <cstdint>
+#include "vector_dot_product.h"
+
+static constexpr size_t max_len= 1536;
+static constexpr size_t bench_loops= 20000;
+static const size_t lens[]= { 1, 7, 8, 16, 33, 100, 1000, max_len };
+
+alignas(64) static int16_t a16[max_len], b16[max_len];
+alignas(64) static int8_t a8[max_len], b8[max_len];
+
+template <typename T> struct Variant
+{
+  const char *name;
+  float (*func)(const T *, const T *, size_t);
+  bool supported;
+};
+
+static volatile float sink;
+
+template <typename T>
+static void test_variants(const char *type, const T *a, const T *b,
+                          Variant<T> *variants, size_t n)
+{
+  for (size_t v= 0; v < n; v++)
+  {
+    if (!variants[v].supported)
+    {
+      skip(array_elements(lens), "%s %s is not supported", variants[v].name,
+           type);
+      continue;
+    }
+    for (size_t l= 0; l < array_elements(lens); l++)
+    {
+      size_t len= lens[l];
+      /*
+        the tail after len must be zero for SIMD variants,
+        so use the first len coordinates of zero-padded copies
+      */
+      alignas(64) T x[max_len], y[max_len];
+      memset(x, 0, sizeof(x));
+      memset(y, 0, sizeof(y));
+      memcpy(x, a, len*sizeof(T));
+      memcpy(y, b, len*sizeof(T));
+      double abs_sum= 0;
+      for (size_t i= 0; i < len; i++)
+        abs_sum+= std::abs(double(x[i]) * y[i]);
+      float expected= dot_product_default(x, y, len);
+      float res= variants[v].func(x, y, len);
+      ok(std::abs(double(res) - expected) <= abs_sum * 1e-6 + 1,
+         "%s %s len=%zu: %g == %g", variants[v].name, type, len,
+         (double)res, (double)expected);
+    }
+
+    ulonglong start= my_interval_timer();
+    float sum= 0;
+    for (size_t i= 0; i < bench_loops; i++)
+      sum+= variants[v].func(a, b, max_len);
+    sink= sum;
+    diag("%-8s %s len=%zu: %llu ns per call", variants[v].name, type, max_len,
+         (my_interval_timer() - start) / bench_loops);
+  }
+}
+
+int main(int argc __attribute__((unused)), char **argv)
+{
+  MY_INIT(argv[0]);
+
+  for (size_t i= 0; i < max_len; i++)
+  {
+    a16[i]= (int16_t)(rand() % 65535 - 32767);
+    b16[i]= (int16_t)(rand() % 65535 - 32767);
+    a8[i]= (int8_t)(rand() % 255 - 127);
+    b8[i]= (int8_t)(rand() % 255 - 127);
+  }
+
+  Variant<int16_t> v16[]= {
+    { "default", dot_product_default, true },
+#ifdef AVX2_IMPLEMENTATION
+    { "avx2", dot_product_avx2, (bool)__builtin_cpu_supports("avx2") },
+#endif
+#ifdef AVX512_IMPLEMENTATION
+    { "avx512", dot_product_avx512, __builtin_cpu_supports("avx512f") &&
+                                    __builtin_cpu_supports("avx512bw") },
+#endif
+#ifdef NEON_IMPLEMENTATION
+    { "neon", dot_product_neon, true },
+#endif
+  };
+  Variant<int8_t> v8[]= {
+    { "default", dot_product_default, true },
+#ifdef AVX2_IMPLEMENTATION
+    { "avx2", dot_product_avx2, (bool)__builtin_cpu_supports("avx2") },
+#endif
+#ifdef AVX512_IMPLEMENTATION
+    { "avx512", dot_product_avx512, __builtin_cpu_supports("avx512f") &&
+                                    __builtin_cpu_supports("avx512bw") },
+#endif
+#ifdef NEON_IMPLEMENTATION
+    { "neon", dot_product_neon, true },
+#endif
+  };
+
+  plan((array_elements(v16) + array_elements(v8)) * array_elements(lens));
+
+  test_variants("int16", a16, b16, v16, array_elements(v16));
+  test_variants("int8", a8, b8, v8, array_elements(v8));
+
+  my_end(0);
+  return exit_status();
+}
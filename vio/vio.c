@@ -235,6 +235,40 @@ my_bool vio_reset(Vio* vio, enum enum_vio_type type,
 }
 
 
+/**
+  Switch a plain socket-based Vio to buffered reads.
+
+  @remark Used once the connection handshake is over, when the client said it
+          would send several packets without waiting for the replies, so that
+          they can be taken from one recv() instead of two per packet. SSL
+          and other transports that already cache input are left as they are.
+
+  @param vio    A VIO object.
+
+  @return TRUE if reads from the Vio are now buffered.
+*/
+
+my_bool vio_enable_buffered_read(Vio *vio)
+{
+  DBUG_ENTER("vio_enable_buffered_read");
+#ifdef HAVE_VIO_READ_BUFF
+  if (vio->read == vio_read_buff)
+    DBUG_RETURN(TRUE);
+  if ((vio->type == VIO_TYPE_TCPIP || vio->type == VIO_TYPE_SOCKET) &&
+      vio->read == vio_read &&
+      (vio->read_buffer= (char*) my_malloc(key_memory_vio_read_buffer,
+                                           VIO_READ_BUFFER_SIZE, MYF(0))))
+  {
+    vio->read_pos= vio->read_end= vio->read_buffer;
+    vio->read= vio_read_buff;
+    vio->has_data= vio_buff_has_data;
+    DBUG_RETURN(TRUE);
+  }
+#endif
+  DBUG_RETURN(FALSE);
+}
+
+
 /* Create a new VIO for socket or TCP/IP connection. */
 
 Vio *mysql_socket_vio_new(MYSQL_SOCKET mysql_socket, enum enum_vio_type type, uint flags)
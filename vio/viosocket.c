@@ -286,6 +286,61 @@ size_t vio_write(Vio *vio, const uchar* buf, size_t size)
   DBUG_RETURN(ret);
 }
 
+/**
+  Write the concatenation of two buffers, with a single system call if the
+  transport allows it.
+
+  SSL connections and named pipes only get the first non-empty buffer
+  written, so that the caller has to loop just as it does with vio_write().
+
+  @return number of bytes written, or -1 on error.
+*/
+
+size_t vio_write_gather(Vio *vio, const uchar *buf1, size_t size1,
+                        const uchar *buf2, size_t size2)
+{
+#ifndef _WIN32
+  if (vio->write == vio_write && size1 && size2)
+  {
+    ssize_t ret;
+    int flags= 0;
+    struct iovec iov[2];
+    struct msghdr msg;
+    DBUG_ENTER("vio_write_gather");
+    DBUG_PRINT("enter", ("sd: %d  size: %zu + %zu",
+                         (int)mysql_socket_getfd(vio->mysql_socket),
+                         size1, size2));
+
+    iov[0].iov_base= (void *) buf1;
+    iov[0].iov_len= size1;
+    iov[1].iov_base= (void *) buf2;
+    iov[1].iov_len= size2;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov= iov;
+    msg.msg_iovlen= 2;
+
+    /* If timeout is enabled, do not block. */
+    if (vio->write_timeout >= 0)
+      flags= VIO_DONTWAIT;
+
+    while ((ret= mysql_socket_sendmsg(vio->mysql_socket, &msg, flags)) == -1)
+    {
+      int error= socket_errno;
+      /* The operation would block? */
+      if (error != SOCKET_EAGAIN && error != SOCKET_EWOULDBLOCK)
+        break;
+
+      /* Wait for the output buffer to become writable.*/
+      if ((ret= vio_socket_io_wait(vio, VIO_IO_EVENT_WRITE)))
+        break;
+    }
+    DBUG_PRINT("exit", ("%d", (int) ret));
+    DBUG_RETURN(ret);
+  }
+#endif
+  return size1 ? vio->write(vio, buf1, size1) : vio->write(vio, buf2, size2);
+}
+
 int vio_socket_shutdown(Vio *vio, int how)
 {
   int ret;
@@ -510,7 +510,8 @@ new_VioSSLAcceptorFd(const char *key_file, const char *cert_file,
 		     const char *ca_file, const char *ca_path,
 		     const char *cipher, enum enum_ssl_init_error* error,
                      const char *crl_file, const char *crl_path,
-                     ulonglong tls_version)
+                     ulonglong tls_version, uint session_cache_size,
+                     my_bool ktls)
 {
   struct st_VioSSLFd *ssl_fd;
   int verify= SSL_VERIFY_PEER | SSL_VERIFY_CLIENT_ONCE;
@@ -521,8 +522,31 @@ new_VioSSLAcceptorFd(const char *key_file, const char *cert_file,
   {
     return 0;
   }
-  /* Set max number of cached sessions, returns the previous size */
-  SSL_CTX_sess_set_cache_size(ssl_fd->ssl_context, 128);
+  if (session_cache_size)
+  {
+    /* Set max number of cached sessions, returns the previous size */
+    SSL_CTX_sess_set_cache_size(ssl_fd->ssl_context, session_cache_size);
+  }
+  else
+  {
+    /* No resumption, neither from the cache nor from a session ticket */
+    SSL_CTX_set_session_cache_mode(ssl_fd->ssl_context, SSL_SESS_CACHE_OFF);
+#ifdef SSL_OP_NO_TICKET
+    SSL_CTX_set_options(ssl_fd->ssl_context, SSL_OP_NO_TICKET);
+#endif
+  }
+
+  /*
+    Let the kernel encrypt and decrypt the records of established
+    connections, if both the TLS library and the kernel support it for
+    the negotiated cipher. SSL_read()/SSL_write() keep working as usual.
+  */
+#ifdef SSL_OP_ENABLE_KTLS
+  if (ktls)
+    SSL_CTX_set_options(ssl_fd->ssl_context, SSL_OP_ENABLE_KTLS);
+#else
+  (void) ktls;
+#endif
 
   SSL_CTX_set_verify(ssl_fd->ssl_context, verify, NULL);
 